@@ -0,0 +1,66 @@
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/object_pool.h"
+#include "common/scoped_timer.h"
+#include "common/worker_pool.h"
+#include "storage/record_buffer.h"
+#include "test_util/multithread_test_util.h"
+
+namespace noisepage {
+
+/**
+ * Measures how handing out and taking back buffer segments scales with the number of threads. This is the allocation
+ * pattern of the undo and redo buffers of transactions.
+ */
+class ObjectPoolBenchmark : public benchmark::Fixture {
+ public:
+  const uint32_t num_allocations_ = 10000000;
+  // Number of segments a thread holds on to before giving them back, about what a small transaction uses
+  const uint32_t batch_size_ = 4;
+  storage::RecordBufferSegmentPool buffer_pool_{1000000, 10000};
+};
+
+/**
+ * Get and release buffer segments in small batches, the number of threads is given by the benchmark argument.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ObjectPoolBenchmark, GetRelease)(benchmark::State &state) {
+  const auto num_threads = static_cast<uint32_t>(state.range(0));
+  common::WorkerPool thread_pool(num_threads, {});
+  thread_pool.Startup();
+
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    auto workload = [&](uint32_t) {
+      std::vector<storage::RecordBufferSegment *> segments(batch_size_);
+      for (uint32_t i = 0; i < num_allocations_ / num_threads / batch_size_; i++) {
+        for (auto &segment : segments) segment = buffer_pool_.Get();
+        for (auto *segment : segments) buffer_pool_.Release(segment);
+      }
+    };
+
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, workload);
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * (num_allocations_ / num_threads / batch_size_) * batch_size_ *
+                          num_threads);
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(ObjectPoolBenchmark, GetRelease)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->MinTime(2);
+// clang-format on
+
+}  // namespace noisepage
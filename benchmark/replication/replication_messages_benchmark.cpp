@@ -17,6 +17,13 @@ class ReplicationMessagesBenchmark : public benchmark::Fixture {
     }
   }
   char RandomChar() { return static_cast<char>(std::rand() % (CHAR_MAX - CHAR_MIN + 1) + CHAR_MIN); }
+
+  /** @return The wire format that the benchmark is parameterized with, labeling the benchmark with it. */
+  static replication::ReplicationMessageFormat Format(benchmark::State *state) {
+    const auto format = static_cast<replication::ReplicationMessageFormat>(state->range(0));
+    state->SetLabel(format == replication::ReplicationMessageFormat::BINARY ? "binary" : "msgpack");
+    return format;
+  }
 };
 
 // Serialize
@@ -26,12 +33,14 @@ BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, NotifyOATMsgSerialization)(benc
   replication::NotifyOATMsg msg(replication::ReplicationMessageMetadata(replication::msg_id_t(666)),
                                 replication::record_batch_id_t(42), transaction::timestamp_t(999));
 
+  const auto format = Format(&state);
+
   // NOLINTNEXTLINE
   for (auto _ : state) {
     uint64_t elapsed_ms;
     {
       common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
-      msg.Serialize();
+      msg.Serialize(format);
     }
     state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
   }
@@ -46,16 +55,19 @@ BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, RecordsBatchMsgSerialization)(b
   replication::RecordsBatchMsg msg(replication::ReplicationMessageMetadata(replication::msg_id_t(666)),
                                    replication::record_batch_id_t(42), &buffer);
 
+  const auto format = Format(&state);
+
   // NOLINTNEXTLINE
   for (auto _ : state) {
     uint64_t elapsed_ms;
     {
       common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
-      msg.Serialize();
+      msg.Serialize(format);
     }
     state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
   }
   state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * common::Constants::LOG_BUFFER_SIZE);
   unlink(noisepage::BenchmarkConfig::logfile_path.data());
 }
 
@@ -64,12 +76,14 @@ BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, TxnAppliedMsgSerialization)(ben
   replication::TxnAppliedMsg msg(replication::ReplicationMessageMetadata(replication::msg_id_t(666)),
                                  transaction::timestamp_t(42));
 
+  const auto format = Format(&state);
+
   // NOLINTNEXTLINE
   for (auto _ : state) {
     uint64_t elapsed_ms;
     {
       common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
-      msg.Serialize();
+      msg.Serialize(format);
     }
     state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
   }
@@ -82,7 +96,7 @@ BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, TxnAppliedMsgSerialization)(ben
 BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, NotifyOATMsgDeserialization)(benchmark::State &state) {
   replication::NotifyOATMsg msg(replication::ReplicationMessageMetadata(replication::msg_id_t(666)),
                                 replication::record_batch_id_t(42), transaction::timestamp_t(999));
-  std::string serialized_msg = msg.Serialize();
+  std::string serialized_msg = msg.Serialize(Format(&state));
 
   // NOLINTNEXTLINE
   for (auto _ : state) {
@@ -103,7 +117,7 @@ BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, RecordsBatchMsgDeserialization)
   FillBuffer(&buffer);
   replication::RecordsBatchMsg msg(replication::ReplicationMessageMetadata(replication::msg_id_t(666)),
                                    replication::record_batch_id_t(42), &buffer);
-  std::string serialized_msg = msg.Serialize();
+  std::string serialized_msg = msg.Serialize(Format(&state));
 
   // NOLINTNEXTLINE
   for (auto _ : state) {
@@ -115,6 +129,7 @@ BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, RecordsBatchMsgDeserialization)
     state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
   }
   state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * common::Constants::LOG_BUFFER_SIZE);
   unlink(noisepage::BenchmarkConfig::logfile_path.data());
 }
 
@@ -122,7 +137,7 @@ BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, RecordsBatchMsgDeserialization)
 BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, TxnAppliedMsgDeserialization)(benchmark::State &state) {
   replication::TxnAppliedMsg msg(replication::ReplicationMessageMetadata(replication::msg_id_t(666)),
                                  transaction::timestamp_t(42));
-  std::string serialized_msg = msg.Serialize();
+  std::string serialized_msg = msg.Serialize(Format(&state));
 
   // NOLINTNEXTLINE
   for (auto _ : state) {
@@ -139,13 +154,31 @@ BENCHMARK_DEFINE_F(ReplicationMessagesBenchmark, TxnAppliedMsgDeserialization)(b
 // ----------------------------------------------------------------------------
 // BENCHMARK REGISTRATION
 // ----------------------------------------------------------------------------
+// Run every benchmark against the legacy msgpack format and the binary format, so that the speedup can be read off.
+static void WireFormats(benchmark::internal::Benchmark *b) {
+  b->Arg(static_cast<int64_t>(replication::ReplicationMessageFormat::MSGPACK));
+  b->Arg(static_cast<int64_t>(replication::ReplicationMessageFormat::BINARY));
+}
+
 // clang-format off
-BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, NotifyOATMsgSerialization)->Unit(benchmark::kNanosecond);
-BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, RecordsBatchMsgSerialization)->Unit(benchmark::kNanosecond);
-BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, TxnAppliedMsgSerialization)->Unit(benchmark::kNanosecond);
-BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, NotifyOATMsgDeserialization)->Unit(benchmark::kNanosecond);
-BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, RecordsBatchMsgDeserialization)->Unit(benchmark::kNanosecond);
-BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, TxnAppliedMsgDeserialization)->Unit(benchmark::kNanosecond);
+BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, NotifyOATMsgSerialization)
+    ->Unit(benchmark::kNanosecond)
+    ->Apply(WireFormats);
+BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, RecordsBatchMsgSerialization)
+    ->Unit(benchmark::kNanosecond)
+    ->Apply(WireFormats);
+BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, TxnAppliedMsgSerialization)
+    ->Unit(benchmark::kNanosecond)
+    ->Apply(WireFormats);
+BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, NotifyOATMsgDeserialization)
+    ->Unit(benchmark::kNanosecond)
+    ->Apply(WireFormats);
+BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, RecordsBatchMsgDeserialization)
+    ->Unit(benchmark::kNanosecond)
+    ->Apply(WireFormats);
+BENCHMARK_REGISTER_F(ReplicationMessagesBenchmark, TxnAppliedMsgDeserialization)
+    ->Unit(benchmark::kNanosecond)
+    ->Apply(WireFormats);
 // clang-format on
 
 }  // namespace noisepage
@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 #include "benchmark/benchmark.h"
 #include "benchmark_util/benchmark_config.h"
+#include "common/constants.h"
 #include "common/scoped_timer.h"
 #include "storage/index/bplustree.h"
 #include "storage/storage_defs.h"
@@ -139,6 +141,53 @@ BENCHMARK_DEFINE_F(BPlusTreeBenchmark, RandomInsertRandomRead)(benchmark::State
   }
 }
 
+/**
+ * Looks up the same keys as RandomInsertRandomRead, a vector of keys at a time, the way an index join probes the index.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BPlusTreeBenchmark, RandomInsertRandomBatchRead)(benchmark::State &state) {
+  common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
+  thread_pool.Startup();
+
+  {
+    auto tree = std::make_unique<storage::index::BPlusTree<int64_t, int64_t>>();
+    for (uint32_t i = 0; i < num_keys_; i++) {
+      storage::index::BPlusTree<int64_t, int64_t>::KeyElementPair p1;
+      p1.first = key_permutation_[i];
+      p1.second = key_permutation_[i];
+      tree->Insert(p1, predicate_);
+    }
+
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+      auto workload = [&](uint32_t id) {
+        uint32_t start_key = num_keys_ / BenchmarkConfig::num_threads * id;
+        uint32_t end_key = start_key + num_keys_ / BenchmarkConfig::num_threads;
+
+        std::vector<int64_t> keys;
+        keys.reserve(common::Constants::K_DEFAULT_VECTOR_SIZE);
+        uint64_t num_found = 0;
+
+        for (uint32_t i = start_key; i < end_key; i += common::Constants::K_DEFAULT_VECTOR_SIZE) {
+          const uint32_t batch_end = std::min(end_key, i + common::Constants::K_DEFAULT_VECTOR_SIZE);
+          keys.assign(key_permutation_.begin() + i, key_permutation_.begin() + batch_end);
+          tree->FindValuesOfKeys(keys, [&num_found](const uint32_t, const int64_t) { num_found++; });
+        }
+        benchmark::DoNotOptimize(num_found);
+      };
+
+      uint64_t elapsed_ms;
+      {
+        common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+        MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, BenchmarkConfig::num_threads, workload);
+      }
+      state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_keys_);
+  }
+}
+
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(BPlusTreeBenchmark, RandomInsertSequentialRead)(benchmark::State &state) {
   common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
@@ -262,6 +311,68 @@ BENCHMARK_DEFINE_F(BPlusTreeBenchmark, SequentialInsertSequentialRead)(benchmark
   }
 }
 
+/**
+ * Random point lookups in a tree built from random inserts, with the number of threads given by the benchmark argument
+ * @param fixture benchmark fixture with the keys to insert
+ * @param state benchmark state
+ * @param optimistic_reads true to read with optimistic lock coupling, false to latch every node on the path
+ */
+static void RandomReadScaling(BPlusTreeBenchmark *fixture, benchmark::State *state, const bool optimistic_reads) {
+  const auto num_threads = static_cast<uint32_t>(state->range(0));
+  common::WorkerPool thread_pool(num_threads, {});
+  thread_pool.Startup();
+
+  auto tree = std::make_unique<storage::index::BPlusTree<int64_t, int64_t>>();
+  tree->SetOptimisticReads(optimistic_reads);
+  for (uint32_t i = 0; i < fixture->num_keys_; i++) {
+    storage::index::BPlusTree<int64_t, int64_t>::KeyElementPair p1;
+    p1.first = fixture->key_permutation_[i];
+    p1.second = fixture->key_permutation_[i];
+    tree->Insert(p1, fixture->predicate_);
+  }
+
+  // NOLINTNEXTLINE
+  for (auto _ : *state) {
+    auto workload = [&](uint32_t id) {
+      uint32_t start_key = fixture->num_keys_ / num_threads * id;
+      uint32_t end_key = start_key + fixture->num_keys_ / num_threads;
+
+      std::vector<int64_t> values;
+      values.reserve(1);
+
+      for (uint32_t i = start_key; i < end_key; i++) {
+        tree->FindValueOfKey(fixture->key_permutation_[i], &values);
+        values.clear();
+      }
+    };
+
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, workload);
+    }
+    state->SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+
+  state->SetItemsProcessed(state->iterations() * (fixture->num_keys_ / num_threads) * num_threads);
+}
+
+/**
+ * Random lookups that do not latch inner nodes, they validate node versions instead
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BPlusTreeBenchmark, OptimisticRandomRead)(benchmark::State &state) {
+  RandomReadScaling(this, &state, true);
+}
+
+/**
+ * Random lookups that take the root latch and a shared latch on every node on their path, for comparison
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BPlusTreeBenchmark, LatchedRandomRead)(benchmark::State &state) {
+  RandomReadScaling(this, &state, false);
+}
+
 // ----------------------------------------------------------------------------
 // BENCHMARK REGISTRATION
 // ----------------------------------------------------------------------------
@@ -278,6 +389,10 @@ BENCHMARK_REGISTER_F(BPlusTreeBenchmark, RandomInsertRandomRead)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(3);
+BENCHMARK_REGISTER_F(BPlusTreeBenchmark, RandomInsertRandomBatchRead)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
 BENCHMARK_REGISTER_F(BPlusTreeBenchmark, RandomInsertSequentialRead)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
@@ -290,6 +405,18 @@ BENCHMARK_REGISTER_F(BPlusTreeBenchmark, SequentialInsertSequentialRead)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(3);
+BENCHMARK_REGISTER_F(BPlusTreeBenchmark, OptimisticRandomRead)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->MinTime(3);
+BENCHMARK_REGISTER_F(BPlusTreeBenchmark, LatchedRandomRead)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->MinTime(3);
 // clang-format on
 
 }  // namespace noisepage
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -11,9 +12,9 @@ namespace noisepage {
 class GarbageCollectorBenchmark : public benchmark::Fixture {
  public:
   void StartGC(transaction::TimestampManager *const timestamp_manager,
-               transaction::TransactionManager *const txn_manager) {
+               transaction::TransactionManager *const txn_manager, const uint32_t num_workers = 1) {
     gc_ = new storage::GarbageCollector(common::ManagedPointer(timestamp_manager), DISABLED,
-                                        common::ManagedPointer(txn_manager), DISABLED);
+                                        common::ManagedPointer(txn_manager), DISABLED, num_workers);
     run_gc_ = true;
     gc_thread_ = std::thread([this] { GCThreadLoop(); });
   }
@@ -33,6 +34,8 @@ class GarbageCollectorBenchmark : public benchmark::Fixture {
   const uint32_t num_concurrent_txns_ = 4;
   const uint32_t initial_table_size_ = 100000;
   const uint32_t num_txns_ = 100000;
+  // Largest number of transactions waiting to be unlinked that the GC thread saw during a run
+  uint32_t max_unlink_backlog_ = 0;
   storage::BlockStore block_store_{1000, 1000};
   storage::RecordBufferSegmentPool buffer_pool_{1000000, 1000000};
   std::default_random_engine generator_;
@@ -44,9 +47,11 @@ class GarbageCollectorBenchmark : public benchmark::Fixture {
   const std::chrono::milliseconds gc_period_{10};
 
   void GCThreadLoop() {
+    max_unlink_backlog_ = 0;
     while (run_gc_) {
       std::this_thread::sleep_for(gc_period_);
       gc_->PerformGarbageCollection();
+      max_unlink_backlog_ = std::max(max_unlink_backlog_, gc_->GetUnlinkBacklog());
     }
   }
 };
@@ -91,6 +96,46 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, UnlinkTime)(benchmark::State &stat
   state.SetItemsProcessed(state.iterations() * num_txns_);
 }
 
+// Same as UnlinkTime, but the GC truncates the version chains on the number of workers given by the benchmark argument
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, ParallelUnlinkTime)(benchmark::State &state) {
+  const auto num_workers = static_cast<uint32_t>(state.range(0));
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    // generate our table and instantiate GC
+    LargeDataTableBenchmarkObject tested({8, 8, 8}, initial_table_size_, txn_length_, update_select_ratio_,
+                                         &block_store_, &buffer_pool_, &generator_, true);
+    gc_ = new storage::GarbageCollector(common::ManagedPointer(tested.GetTimestampManager()), DISABLED,
+                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED, num_workers);
+
+    // clean up insert txn
+    gc_->PerformGarbageCollection();
+    gc_->PerformGarbageCollection();
+
+    // run all txns
+    tested.SimulateOltp(num_txns_, num_concurrent_txns_);
+
+    // time just the unlinking process, verify nothing deallocated
+    uint64_t elapsed_ms;
+    std::pair<uint32_t, uint32_t> result;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      result = gc_->PerformGarbageCollection();
+    }
+    EXPECT_EQ(result.first, 0);
+    EXPECT_EQ(result.second, num_txns_);
+
+    // run another GC pass to perform deallocation, verify nothing unlinked
+    result = gc_->PerformGarbageCollection();
+    EXPECT_EQ(result.second, 0);
+
+    delete gc_;
+
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_txns_);
+}
+
 // Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC and profile how long
 // the deallocation stage takes for those txns
 // NOLINTNEXTLINE
@@ -137,24 +182,34 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, ReclaimTime)(benchmark::State &sta
  */
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, HighContention)(benchmark::State &state) {
+  const auto num_workers = static_cast<uint32_t>(state.range(0));
   uint64_t lag_count = 0;
+  uint32_t max_unlink_backlog = 0;
   // NOLINTNEXTLINE
   for (auto _ : state) {
     LargeDataTableBenchmarkObject tested({8, 8, 8}, 100, txn_length_, update_select_ratio_, &block_store_,
                                          &buffer_pool_, &generator_, true);
-    StartGC(tested.GetTimestampManager(), tested.GetTxnManager());
+    StartGC(tested.GetTimestampManager(), tested.GetTxnManager(), num_workers);
     uint64_t elapsed_ms;
     {
       common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
       tested.SimulateOltp(num_txns_, num_concurrent_txns_);
     }
     lag_count += EndGC();
+    max_unlink_backlog = std::max(max_unlink_backlog, max_unlink_backlog_);
     state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
   }
   state.SetItemsProcessed(state.iterations() * num_txns_ - lag_count);
+  state.counters["max_unlink_backlog"] = max_unlink_backlog;
 }
 
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, UnlinkTime)->Unit(benchmark::kMillisecond)->UseManualTime()->MinTime(1);
+BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ParallelUnlinkTime)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->MinTime(1);
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ReclaimTime)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
@@ -162,5 +217,7 @@ BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ReclaimTime)
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, HighContention)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
     ->MinTime(2);
 }  // namespace noisepage
@@ -27,8 +27,10 @@ class RecoveryBenchmark : public benchmark::Fixture {
    * Runs the recovery benchmark with the provided config
    * @param state benchmark state
    * @param config config to use for test object
+   * @param replay_threads number of workers replaying transactions in parallel, 0 to replay serially
    */
-  void RunBenchmark(benchmark::State *state, const LargeSqlTableTestConfiguration &config) {
+  void RunBenchmark(benchmark::State *state, const LargeSqlTableTestConfiguration &config,
+                    const uint32_t replay_threads = 0) {
     // NOLINTNEXTLINE
     for (auto _ : *state) {
       // Blow away log file after every benchmark iteration
@@ -75,6 +77,7 @@ class RecoveryBenchmark : public benchmark::Fixture {
                                                 recovery_catalog, recovery_txn_manager,
                                                 recovery_deferred_action_manager, recovery_replication_manager,
                                                 recovery_thread_registry, recovery_block_store);
+      recovery_manager.SetReplayThreads(replay_threads);
 
       uint64_t elapsed_ms;
       {
@@ -129,6 +132,62 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, HighStress)(benchmark::State &state) {
   RunBenchmark(&state, config);
 }
 
+/**
+ * Run a read-write workload (5 statements per txn, 50% inserts, 50% select), replaying the log in parallel.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(RecoveryBenchmark, ParallelReadWriteWorkload)(benchmark::State &state) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(1)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(initial_table_size_)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.5, 0.0, 0.5, 0.0})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+
+  RunBenchmark(&state, config, BenchmarkConfig::num_threads);
+}
+
+/**
+ * Update-heavy workload over several tables (5 statements per txn, 10% inserts, 70% updates, 10% selects, 10% deletes),
+ * replaying the log in parallel. Conflicting transactions force smaller replay rounds.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(RecoveryBenchmark, ParallelUpdateWorkload)(benchmark::State &state) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(4)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(initial_table_size_ / 4)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.1, 0.7, 0.1, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+
+  RunBenchmark(&state, config, BenchmarkConfig::num_threads);
+}
+
+/**
+ * High-stress workload, blast a narrow table with inserts (5 statements per txn, 100% inserts), replaying the log in
+ * parallel.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(RecoveryBenchmark, ParallelHighStress)(benchmark::State &state) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(1)
+                                              .SetMaxColumns(1)
+                                              .SetInitialTableSize(initial_table_size_)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({1.0, 0.0, 0.0, 0.0})
+                                              .SetVarlenAllowed(false)
+                                              .Build();
+
+  RunBenchmark(&state, config, BenchmarkConfig::num_threads);
+}
+
 /**
  * Similar to high-stress workload, blast a narrow table with inserts (1 statements per txn, 100% inserts), but also
  * recovery indexes built on the table
@@ -256,6 +315,18 @@ BENCHMARK_REGISTER_F(RecoveryBenchmark, HighStress)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(10);
+BENCHMARK_REGISTER_F(RecoveryBenchmark, ParallelReadWriteWorkload)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(10);
+BENCHMARK_REGISTER_F(RecoveryBenchmark, ParallelUpdateWorkload)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(10);
+BENCHMARK_REGISTER_F(RecoveryBenchmark, ParallelHighStress)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(10);
 BENCHMARK_REGISTER_F(RecoveryBenchmark, IndexRecovery)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
@@ -0,0 +1,82 @@
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/scoped_timer.h"
+#include "common/worker_pool.h"
+#include "storage/garbage_collector_thread.h"
+#include "storage/record_buffer.h"
+#include "test_util/multithread_test_util.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage {
+
+/**
+ * Measures how beginning and committing transactions scales with the number of threads, while the GC polls for the
+ * oldest running transaction in the background.
+ */
+class TimestampManagerBenchmark : public benchmark::Fixture {
+ public:
+  const uint32_t num_txns_ = 1000000;
+  storage::RecordBufferSegmentPool buffer_pool_{1000000, 1000000};
+  const std::chrono::microseconds gc_period_{1000};
+};
+
+/**
+ * Begin and commit empty transactions, the number of threads is given by the benchmark argument.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TimestampManagerBenchmark, BeginCommit)(benchmark::State &state) {
+  const auto num_threads = static_cast<uint32_t>(state.range(0));
+  common::WorkerPool thread_pool(num_threads, {});
+  thread_pool.Startup();
+
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    transaction::TimestampManager timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool_),
+                                                true,
+                                                false,
+                                                DISABLED};
+    storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                                 DISABLED};
+    auto *gc_thread = new storage::GarbageCollectorThread(common::ManagedPointer(&gc), gc_period_, nullptr);
+
+    auto workload = [&](uint32_t) {
+      for (uint32_t i = 0; i < num_txns_ / num_threads; i++) {
+        auto *txn = txn_manager.BeginTransaction();
+        txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      }
+    };
+
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, workload);
+    }
+    // Stopping the GC thread cleans up the committed transactions
+    delete gc_thread;
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * (num_txns_ / num_threads) * num_threads);
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(TimestampManagerBenchmark, BeginCommit)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->MinTime(2);
+// clang-format on
+
+}  // namespace noisepage
@@ -0,0 +1,118 @@
+#include "common/numa_util.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace noisepage::common {
+
+#if defined(__linux__)
+
+namespace {
+
+// Policy of mbind(2) that places pages on the given node, and on other nodes once the given node is out of memory
+constexpr int MPOL_PREFERRED_POLICY = 1;
+
+// Parse a list of ids as found in sysfs for both nodes and CPUs, e.g., "0-7,16-23"
+std::vector<uint32_t> ParseIdList(const std::string &list) {
+  std::vector<uint32_t> ids;
+  std::istringstream ranges(list);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    if (range.empty()) continue;
+    const auto dash = range.find('-');
+    const auto first = std::stoul(range.substr(0, dash));
+    const auto last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+    for (auto id = first; id <= last; id++) ids.push_back(static_cast<uint32_t>(id));
+  }
+  return ids;
+}
+
+// CPUs of each node id, read from the given directory. Node ids need not be contiguous, so the ids of nodes that are
+// not online get no CPUs. Empty if the kernel does not expose any nodes.
+std::vector<cpu_set_t> ReadNodeCpus(const std::string &node_dir) {
+  std::ifstream online(node_dir + "/online");
+  std::string nodes;
+  if (!std::getline(online, nodes)) return {};
+  // Resizing zeroes the CPU sets of the new node ids
+  std::vector<cpu_set_t> node_cpus;
+  for (const uint32_t node : ParseIdList(nodes)) {
+    if (node >= NumaUtil::MAX_NODES) continue;
+    if (node >= node_cpus.size()) node_cpus.resize(node + 1);
+    std::ifstream in(node_dir + "/node" + std::to_string(node) + "/cpulist");
+    std::string cpus;
+    std::getline(in, cpus);
+    for (const uint32_t cpu : ParseIdList(cpus)) {
+      if (cpu < CPU_SETSIZE) CPU_SET(cpu, &node_cpus[node]);
+    }
+  }
+  return node_cpus;
+}
+
+// CPUs of each node id, read from sysfs on first use
+std::vector<cpu_set_t> &NodeCpus() {
+  static std::vector<cpu_set_t> node_cpus = ReadNodeCpus(NumaUtil::SYSFS_NODE_DIR);
+  return node_cpus;
+}
+
+// CPUs the thread could run on before it was pinned, valid if the thread is pinned
+thread_local cpu_set_t unpinned_cpus;
+thread_local bool pinned = false;
+
+}  // namespace
+
+uint32_t NumaUtil::NumNodes() { return NodeCpus().empty() ? 1 : static_cast<uint32_t>(NodeCpus().size()); }
+
+uint32_t NumaUtil::CurrentNode() {
+  unsigned cpu, node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return 0;
+  return node < NumNodes() ? node : 0;
+}
+
+void NumaUtil::BindToNode(void *const ptr, const std::size_t size, const uint32_t node) {
+  if (NumNodes() <= 1 || node >= NumNodes()) return;
+  // Placement is only a hint, memory on the wrong node is still correct, so failures are ignored
+  const uint64_t node_mask = uint64_t{1} << node;
+  syscall(SYS_mbind, ptr, size, MPOL_PREFERRED_POLICY, &node_mask, MAX_NODES + 1, 0);
+}
+
+void NumaUtil::LoadTopology(const std::string &node_dir) { NodeCpus() = ReadNodeCpus(node_dir); }
+
+bool NumaUtil::PinThreadToNode(const uint32_t node) {
+  if (NumNodes() <= 1 || node >= NumNodes() || CPU_COUNT(&NodeCpus()[node]) == 0) return false;
+  if (!pinned && sched_getaffinity(0, sizeof(cpu_set_t), &unpinned_cpus) != 0) return false;
+  if (sched_setaffinity(0, sizeof(cpu_set_t), &NodeCpus()[node]) != 0) return false;
+  pinned = true;
+  return true;
+}
+
+void NumaUtil::UnpinThread() {
+  if (!pinned) return;
+  sched_setaffinity(0, sizeof(cpu_set_t), &unpinned_cpus);
+  pinned = false;
+}
+
+#else
+
+uint32_t NumaUtil::NumNodes() { return 1; }
+
+uint32_t NumaUtil::CurrentNode() { return 0; }
+
+void NumaUtil::BindToNode(void *const, const std::size_t, const uint32_t) {}
+
+void NumaUtil::LoadTopology(const std::string &) {}
+
+bool NumaUtil::PinThreadToNode(const uint32_t) { return false; }
+
+void NumaUtil::UnpinThread() {}
+
+#endif
+
+}  // namespace noisepage::common
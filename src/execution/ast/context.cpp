@@ -22,13 +22,14 @@
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/join_hash_table.h"
 #include "execution/sql/join_hash_table_vector_probe.h"
+#include "execution/sql/row_buffer.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql/value.h"
-#include "self_driving/modeling/operating_unit.h"
-// #include "execution/util/csv_reader.h" Fix later.
+#include "execution/util/csv_reader.h"
 #include "execution/util/execution_common.h"
+#include "self_driving/modeling/operating_unit.h"
 
 namespace noisepage::execution::ast {
 
@@ -11,13 +11,14 @@
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/join_hash_table.h"
 #include "execution/sql/join_hash_table_vector_probe.h"
+#include "execution/sql/row_buffer.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql/value.h"
 #include "execution/sql/vector_projection_iterator.h"
+#include "execution/util/csv_reader.h"
 #include "self_driving/modeling/operating_unit.h"
-// #include "execution/util/csv_reader.h" Fix later.
 
 namespace noisepage::execution::ast {
 
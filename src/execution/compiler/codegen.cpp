@@ -6,6 +6,7 @@
 #include "execution/ast/context.h"
 #include "execution/ast/type.h"
 #include "execution/compiler/executable_query_builder.h"
+#include "execution/sql/filter_manager.h"
 #include "spdlog/fmt/fmt.h"
 #include "storage/index/index_defs.h"
 
@@ -644,6 +645,12 @@ ast::Expr *CodeGen::TableIterClose(ast::Expr *table_iter) {
   return call;
 }
 
+ast::Expr *CodeGen::TableIterSkipBlocks(ast::Expr *table_iter, ast::Expr *filter_manager) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::TableIterSkipBlocks, {table_iter, filter_manager});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::IterateTableParallel(catalog::table_oid_t table_oid, ast::Identifier col_oids,
                                          ast::Expr *query_state, ast::Expr *exec_ctx, ast::Identifier worker_name) {
   ast::Expr *call =
@@ -679,6 +686,13 @@ ast::Expr *CodeGen::VPIAdvance(ast::Expr *vpi, bool filtered) {
   return call;
 }
 
+ast::Expr *CodeGen::VPIReset(ast::Expr *vpi, bool filtered) {
+  ast::Builtin builtin = filtered ? ast::Builtin::VPIResetFiltered : ast::Builtin::VPIReset;
+  ast::Expr *call = CallBuiltin(builtin, {vpi});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::VPIMatch(ast::Expr *vpi, ast::Expr *cond) {
   ast::Expr *call = CallBuiltin(ast::Builtin::VPIMatch, {vpi, cond});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -798,6 +812,12 @@ ast::Expr *CodeGen::FilterManagerInit(ast::Expr *filter_manager, ast::Expr *exec
   return call;
 }
 
+ast::Expr *CodeGen::FilterManagerInit(ast::Expr *filter_manager, ast::Expr *exec_ctx, ast::Expr *context) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::FilterManagerInit, {filter_manager, exec_ctx, context});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::FilterManagerFree(ast::Expr *filter_manager) {
   ast::Expr *call = CallBuiltin(ast::Builtin::FilterManagerFree, {filter_manager});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -816,6 +836,39 @@ ast::Expr *CodeGen::FilterManagerInsert(ast::Expr *filter_manager,
   return call;
 }
 
+ast::Expr *CodeGen::FilterManagerInsertZoneMapTerm(ast::Expr *filter_manager, parser::ExpressionType comp_type,
+                                                   uint32_t col_idx, int64_t value) {
+  sql::FilterManager::ZoneMapComparison comparison;
+  switch (comp_type) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      comparison = sql::FilterManager::ZoneMapComparison::Equal;
+      break;
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+      comparison = sql::FilterManager::ZoneMapComparison::NotEqual;
+      break;
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      comparison = sql::FilterManager::ZoneMapComparison::LessThan;
+      break;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      comparison = sql::FilterManager::ZoneMapComparison::LessThanEqual;
+      break;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      comparison = sql::FilterManager::ZoneMapComparison::GreaterThan;
+      break;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      comparison = sql::FilterManager::ZoneMapComparison::GreaterThanEqual;
+      break;
+    default:
+      throw NOT_IMPLEMENTED_EXCEPTION(fmt::format("CodeGen: Zone map comparison type {} not supported.",
+                                                  parser::ExpressionTypeToString(comp_type)));
+  }
+  ast::Expr *call = CallBuiltin(ast::Builtin::FilterManagerInsertZoneMapTerm,
+                                {filter_manager, ConstU32(col_idx), ConstU32(static_cast<uint32_t>(comparison)),
+                                 Const64(value)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::FilterManagerRunFilters(ast::Expr *filter_manager, ast::Expr *vpi, ast::Expr *exec_ctx) {
   ast::Expr *call = CallBuiltin(ast::Builtin::FilterManagerRunFilters, {filter_manager, vpi, exec_ctx});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -940,12 +993,54 @@ ast::Expr *CodeGen::JoinHashTableBuildParallel(ast::Expr *join_hash_table, ast::
   return call;
 }
 
+ast::Expr *CodeGen::JoinHashTableBuildBloomFilter(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableBuildBloomFilter, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableProbeBloomFilter(ast::Expr *join_hash_table, ast::Expr *vector_projection,
+                                                  ast::Expr *tid_list, ast::Identifier key_cols) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::JoinHashTableProbeBloomFilter, {join_hash_table, vector_projection, tid_list,
+                                                                MakeExpr(key_cols)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::JoinHashTableLookup(ast::Expr *join_hash_table, ast::Expr *entry_iter, ast::Expr *hash_val) {
   ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableLookup, {join_hash_table, entry_iter, hash_val});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
   return call;
 }
 
+ast::Expr *CodeGen::JoinHashTableEnableSpilling(ast::Expr *join_hash_table, ast::Identifier probe_row_type_name) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::JoinHashTableEnableSpilling, {join_hash_table, SizeOf(probe_row_type_name)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableIsPartitionSpilled(ast::Expr *join_hash_table, ast::Expr *hash_val) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableIsPartitionSpilled, {join_hash_table, hash_val});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableDeferProbe(ast::Expr *join_hash_table, ast::Expr *hash_val, ast::Expr *probe_row) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableDeferProbe, {join_hash_table, hash_val, probe_row});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableProbeSpilled(ast::Expr *join_hash_table, ast::Expr *query_state,
+                                              ast::Expr *pipeline_state, ast::Identifier probe_fn) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableProbeSpilled,
+                                {join_hash_table, query_state, pipeline_state, MakeExpr(probe_fn)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::JoinHashTableFree(ast::Expr *join_hash_table) {
   ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableFree, {join_hash_table});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -1032,6 +1127,14 @@ ast::Expr *CodeGen::AggHashTableMovePartitions(ast::Expr *agg_ht, ast::Expr *tls
   return call;
 }
 
+ast::Expr *CodeGen::AggHashTableEnableSpilling(ast::Expr *agg_ht, ast::Expr *query_state,
+                                               ast::Identifier merge_partitions_fn_name) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::AggHashTableEnableSpilling, {agg_ht, query_state, MakeExpr(merge_partitions_fn_name)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::AggHashTableParallelScan(ast::Expr *agg_ht, ast::Expr *query_state,
                                              ast::Expr *thread_state_container, ast::Identifier worker_fn) {
   ast::Expr *call = CallBuiltin(ast::Builtin::AggHashTableParallelPartitionedScan,
@@ -1241,6 +1344,78 @@ ast::Expr *CodeGen::SorterIterClose(ast::Expr *iter) {
   return call;
 }
 
+// ---------------------------------------------------------
+// Row buffers
+// ---------------------------------------------------------
+
+ast::Expr *CodeGen::RowBufferInit(ast::Expr *buffer, ast::Expr *exec_ctx, ast::Identifier row_type_name) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferInit, {buffer, exec_ctx, SizeOf(row_type_name)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::RowBufferInsert(ast::Expr *buffer, ast::Identifier row_type_name) {
+  // @rowBufferInsert(buffer)
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferInsert, {buffer});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Uint8)->PointerTo());
+  // @ptrCast(row_type, @rowBufferInsert())
+  return PtrCast(row_type_name, call);
+}
+
+ast::Expr *CodeGen::RowBufferFinish(ast::Expr *buffer) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferFinish, {buffer});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::RowBufferFree(ast::Expr *buffer) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferFree, {buffer});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::RowBufferIterInit(ast::Expr *iter, ast::Expr *buffer) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferIterInit, {iter, buffer});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::RowBufferIterHasNext(ast::Expr *iter) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferIterHasNext, {iter});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::RowBufferIterNext(ast::Expr *iter) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferIterNext, {iter});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::RowBufferIterGetRow(ast::Expr *iter, ast::Identifier row_type_name) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferIterGetRow, {iter});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Uint8)->PointerTo());
+  return PtrCast(row_type_name, call);
+}
+
+ast::Expr *CodeGen::RowBufferIterMark(ast::Expr *iter) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferIterMark, {iter});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::RowBufferIterRewind(ast::Expr *iter) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferIterRewind, {iter});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::RowBufferIterClose(ast::Expr *iter) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::RowBufferIterClose, {iter});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 // ---------------------------------------------------------
 // SQL functions
 // ---------------------------------------------------------
@@ -1259,9 +1434,11 @@ ast::Expr *CodeGen::NotLike(ast::Expr *str, ast::Expr *pattern) {
 // CSV
 // ---------------------------------------------------------
 
-ast::Expr *CodeGen::CSVReaderInit(ast::Expr *reader, std::string_view file_name) {
-  ast::Expr *call = CallBuiltin(ast::Builtin::CSVReaderInit, {reader, ConstString(file_name)});
-  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+ast::Expr *CodeGen::CSVReaderInit(ast::Expr *exec_ctx, std::string_view file_name, char delimiter, char quote,
+                                  char escape) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::CSVReaderInit, {exec_ctx, ConstString(file_name), Const8(delimiter),
+                                                              Const8(quote), Const8(escape)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::CSVReader)->PointerTo());
   return call;
 }
 
@@ -1283,8 +1460,11 @@ ast::Expr *CodeGen::CSVReaderGetRecordNumber(ast::Expr *reader) {
   return call;
 }
 
-ast::Expr *CodeGen::CSVReaderClose(ast::Expr *reader) {
-  ast::Expr *call = CallBuiltin(ast::Builtin::CSVReaderClose, {reader});
+ast::Expr *CodeGen::IterateCSVParallel(std::string_view file_name, char delimiter, char quote, char escape,
+                                       ast::Expr *query_state, ast::Expr *exec_ctx, ast::Identifier worker_name) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::CSVScanParallel,
+                                {ConstString(file_name), Const8(delimiter), Const8(quote), Const8(escape), query_state,
+                                 exec_ctx, Const32(0), MakeExpr(worker_name)});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
   return call;
 }
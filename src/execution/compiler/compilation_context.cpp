@@ -33,9 +33,11 @@
 #include "execution/compiler/operator/ind_cte_scan_leader_translator.h"
 #include "execution/compiler/operator/index_create_translator.h"
 #include "execution/compiler/operator/index_join_translator.h"
+#include "execution/compiler/operator/index_only_scan_translator.h"
 #include "execution/compiler/operator/index_scan_translator.h"
 #include "execution/compiler/operator/insert_translator.h"
 #include "execution/compiler/operator/limit_translator.h"
+#include "execution/compiler/operator/merge_join_translator.h"
 #include "execution/compiler/operator/nested_loop_join_translator.h"
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/operator/output_translator.h"
@@ -66,6 +68,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/plan_meta_data.h"
@@ -261,6 +264,11 @@ void CompilationContext::Prepare(const planner::AbstractPlanNode &plan, Pipeline
       translator = std::make_unique<LimitTranslator>(limit, this, pipeline);
       break;
     }
+    case planner::PlanNodeType::MERGEJOIN: {
+      const auto &merge_join = dynamic_cast<const planner::MergeJoinPlanNode &>(plan);
+      translator = std::make_unique<MergeJoinTranslator>(merge_join, this, pipeline);
+      break;
+    }
     case planner::PlanNodeType::NESTLOOP: {
       const auto &nested_loop = dynamic_cast<const planner::NestedLoopJoinPlanNode &>(plan);
       translator = std::make_unique<NestedLoopJoinTranslator>(nested_loop, this, pipeline);
@@ -298,7 +306,11 @@ void CompilationContext::Prepare(const planner::AbstractPlanNode &plan, Pipeline
     }
     case planner::PlanNodeType::INDEXSCAN: {
       const auto &index_scan = dynamic_cast<const planner::IndexScanPlanNode &>(plan);
-      translator = std::make_unique<IndexScanTranslator>(index_scan, this, pipeline);
+      if (index_scan.IsIndexOnly()) {
+        translator = std::make_unique<IndexOnlyScanTranslator>(index_scan, this, pipeline);
+      } else {
+        translator = std::make_unique<IndexScanTranslator>(index_scan, this, pipeline);
+      }
       break;
     }
     case planner::PlanNodeType::INDEXNLJOIN: {
@@ -21,12 +21,10 @@ constexpr const char FIELD_PREFIX[] = "field";
 CSVScanTranslator::CSVScanTranslator(const planner::CSVScanPlanNode &plan, CompilationContext *compilation_context,
                                      Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY),
-      base_row_type_(GetCodeGen()->MakeFreshIdentifier("CSVRow")) {
-  // CSV scans are serial, for now.
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
-  // Declare state.
-  base_row_ = compilation_context->GetQueryState()->DeclareStateEntry(GetCodeGen(), "csvRow",
-                                                                      GetCodeGen()->MakeExpr(base_row_type_));
+      base_row_type_(GetCodeGen()->MakeFreshIdentifier("CSVRow")),
+      base_row_var_(GetCodeGen()->MakeFreshIdentifier("csvRow")),
+      reader_var_(GetCodeGen()->MakeFreshIdentifier("csvReader")) {
+  pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel);
 }
 
 void CSVScanTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
@@ -49,7 +47,7 @@ void CSVScanTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *
 ast::Expr *CSVScanTranslator::GetField(uint32_t field_index) const {
   auto *codegen = GetCodeGen();
   ast::Identifier field_name = codegen->MakeIdentifier(FIELD_PREFIX + std::to_string(field_index));
-  return codegen->AccessStructMember(base_row_.Get(codegen), field_name);
+  return codegen->AccessStructMember(codegen->MakeExpr(base_row_var_), field_name);
 }
 
 ast::Expr *CSVScanTranslator::GetFieldPtr(uint32_t field_index) const {
@@ -57,30 +55,46 @@ ast::Expr *CSVScanTranslator::GetFieldPtr(uint32_t field_index) const {
 }
 
 void CSVScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
-  UNREACHABLE("CSV support disabled because <charconv> missing on CI.");
-#if 0
   auto *codegen = GetCodeGen();
-  auto reader_var_base = codegen->MakeFreshIdentifier("csvReaderBase");
-  auto reader_var = codegen->MakeFreshIdentifier("csvReader");
-  function->Append(codegen->DeclareVarNoInit(reader_var_base, ast::BuiltinType::CSVReader));
-  function->Append(codegen->DeclareVarWithInit(reader_var, codegen->AddressOf(reader_var_base)));
-  function->Append(
-      codegen->DeclareVarWithInit(codegen->MakeFreshIdentifier("isValid"),
-                                  codegen->CSVReaderInit(codegen->MakeExpr(reader_var), GetCSVPlan().GetFileName())));
-  Loop scan_loop(function, codegen->CSVReaderAdvance(codegen->MakeExpr(reader_var)));
+  const auto &plan = GetCSVPlan();
+
+  // In a parallel pipeline, the reader over a chunk of the file is a parameter of the work function.
+  const bool declare_local_reader = !GetPipeline()->IsParallel() || !GetPipeline()->IsDriver(this);
+  if (declare_local_reader) {
+    // var csvReader = @csvReaderInit(execCtx, file_name, delimiter, quote, escape)
+    function->Append(codegen->DeclareVarWithInit(
+        reader_var_, codegen->CSVReaderInit(GetExecutionContext(), plan.GetFileName(), plan.GetDelimiterChar(),
+                                            plan.GetQuoteChar(), plan.GetEscapeChar())));
+  }
+
+  // The row is local to the work function, so that each thread reads into its own.
+  function->Append(codegen->DeclareVarNoInit(base_row_var_, codegen->MakeExpr(base_row_type_)));
+
+  Loop scan_loop(function, codegen->CSVReaderAdvance(codegen->MakeExpr(reader_var_)));
   {
     // Read fields.
     const auto output_schema = GetPlan().GetOutputSchema();
     for (uint32_t i = 0; i < output_schema->NumColumns(); i++) {
       ast::Expr *field_ptr = GetFieldPtr(i);
-      function->Append(codegen->CSVReaderGetField(codegen->MakeExpr(reader_var), i, field_ptr));
+      function->Append(codegen->CSVReaderGetField(codegen->MakeExpr(reader_var_), i, field_ptr));
     }
     // Done.
     context->Push(function);
   }
   scan_loop.EndLoop();
-  function->Append(codegen->CSVReaderClose(codegen->MakeExpr(reader_var)));
-#endif
+}
+
+util::RegionVector<ast::FieldDecl *> CSVScanTranslator::GetWorkerParams() const {
+  auto *codegen = GetCodeGen();
+  auto *reader_type = codegen->PointerType(ast::BuiltinType::CSVReader);
+  return codegen->MakeFieldList({codegen->MakeField(reader_var_, reader_type)});
+}
+
+void CSVScanTranslator::LaunchWork(FunctionBuilder *function, ast::Identifier work_func) const {
+  const auto &plan = GetCSVPlan();
+  function->Append(GetCodeGen()->IterateCSVParallel(plan.GetFileName(), plan.GetDelimiterChar(), plan.GetQuoteChar(),
+                                                    plan.GetEscapeChar(), GetQueryStatePtr(), GetExecutionContext(),
+                                                    work_func));
 }
 
 ast::Expr *CSVScanTranslator::GetTableColumn(catalog::col_oid_t col_oid) const {
@@ -261,7 +261,7 @@ ast::FunctionDecl *HashAggregationTranslator::GenerateKeyCheckFunction() {
 }
 
 void HashAggregationTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
-  if (build_pipeline_.IsParallel()) {
+  if (build_pipeline_.IsParallel() || IsSerialBuildSpillable()) {
     decls->push_back(GeneratePartialKeyCheckFunction());
     decls->push_back(GenerateMergeOverflowPartitionsFunction());
   }
@@ -282,7 +282,12 @@ void HashAggregationTranslator::TearDownAggregationHashTable(FunctionBuilder *fu
 }
 
 void HashAggregationTranslator::InitializeQueryState(FunctionBuilder *function) const {
-  InitializeAggregationHashTable(function, global_agg_ht_.GetPtr(GetCodeGen()));
+  auto *codegen = GetCodeGen();
+  InitializeAggregationHashTable(function, global_agg_ht_.GetPtr(codegen));
+  if (IsSerialBuildSpillable()) {
+    function->Append(
+        codegen->AggHashTableEnableSpilling(global_agg_ht_.GetPtr(codegen), GetQueryStatePtr(), merge_partitions_fn_));
+  }
   for (auto &p : distinct_filters_) {
     p.second.Initialize(GetCodeGen(), function, GetExecutionContext());
   }
@@ -5,8 +5,11 @@
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/work_context.h"
 #include "execution/sql/join_hash_table.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/derived_value_expression.h"
 #include "planner/plannodes/hash_join_plan_node.h"
 #include "planner/plannodes/output_schema.h"
 
@@ -27,6 +30,7 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
       probe_row_var_(GetCodeGen()->MakeFreshIdentifier("probeRow")),
       probe_row_type_(GetCodeGen()->MakeFreshIdentifier("ProbeRow")),
       join_consumer_(GetCodeGen()->MakeFreshIdentifier("joinConsumer")),
+      probe_spilled_fn_(GetCodeGen()->MakeFreshIdentifier("probeSpilled")),
       left_pipeline_(this, Pipeline::Parallelism::Parallel) {
   NOISEPAGE_ASSERT(!plan.GetLeftHashKeys().empty(), "Hash-join must have join keys from left input");
   NOISEPAGE_ASSERT(!plan.GetRightHashKeys().empty(), "Hash-join must have join keys from right input");
@@ -56,6 +60,8 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
     local_join_ht_ = left_pipeline_.DeclarePipelineStateEntry("joinHashTable", join_ht_type);
   }
 
+  build_bloom_filter_ = PushDownBloomFilter();
+
   num_build_rows_ = CounterDeclare("num_build_rows", &left_pipeline_);
   num_probe_rows_ = CounterDeclare("num_probe_rows", pipeline);
   num_match_rows_ = CounterDeclare("num_match_rows", pipeline);
@@ -68,6 +74,60 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
   }
 }
 
+bool HashJoinTranslator::CanSpillBuild() const {
+  switch (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType()) {
+    case planner::LogicalJoinType::INNER:
+    case planner::LogicalJoinType::LEFT_SEMI:
+    case planner::LogicalJoinType::RIGHT_SEMI:
+    case planner::LogicalJoinType::RIGHT_ANTI:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool HashJoinTranslator::PushDownBloomFilter() {
+  const auto &join_plan = GetPlanAs<planner::HashJoinPlanNode>();
+  if (!join_plan.IsBloomFilterPushdown()) {
+    return false;
+  }
+
+  // Dropping probe tuples is only safe when unmatched probe tuples never produce output.
+  switch (join_plan.GetLogicalJoinType()) {
+    case planner::LogicalJoinType::INNER:
+    case planner::LogicalJoinType::LEFT:
+    case planner::LogicalJoinType::LEFT_SEMI:
+      break;
+    default:
+      return false;
+  }
+
+  // The bloom filter is applied by the probe-side scan, before any other operator sees the tuples.
+  const auto &probe_plan = *join_plan.GetChild(1);
+  if (probe_plan.GetPlanNodeType() != planner::PlanNodeType::SEQSCAN) {
+    return false;
+  }
+
+  // Every probe key must directly reference a column produced by the scan.
+  std::vector<catalog::col_oid_t> key_col_oids;
+  const auto *probe_schema = probe_plan.GetOutputSchema().Get();
+  for (const auto &key : join_plan.GetRightHashKeys()) {
+    if (key->GetExpressionType() != parser::ExpressionType::VALUE_TUPLE) {
+      return false;
+    }
+    const auto dve = key.CastManagedPointerTo<parser::DerivedValueExpression>();
+    const auto col_expr = probe_schema->GetColumn(dve->GetValueIdx()).GetExpr();
+    if (col_expr->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+      return false;
+    }
+    key_col_oids.push_back(col_expr.CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid());
+  }
+
+  auto *scan_translator = static_cast<SeqScanTranslator *>(GetCompilationContext()->LookupTranslator(probe_plan));
+  scan_translator->RegisterBloomFilter(global_join_ht_, key_col_oids);
+  return true;
+}
+
 void HashJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
   auto *codegen = GetCodeGen();
 
@@ -81,8 +141,9 @@ void HashJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl
   struct_decl_ = struct_decl;
   decls->push_back(struct_decl);
 
-  /* Probe row declaration - only for left outer joins */
-  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
+  /* Probe row declaration - only for left outer joins and joins whose probes can be deferred */
+  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT ||
+      CanSpillBuild()) {
     // TODO(abalakum): support mini-runners for this struct as well
     fields = codegen->MakeEmptyFieldList();
     GetAllChildOutputFields(1, row_attr_prefix, &fields);
@@ -112,6 +173,29 @@ void HashJoinTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionD
     join_consumer_flag_ = false;
     decls->push_back(function.Finish());
   }
+
+  if (CanSpillBuild()) {
+    auto cc = GetCompilationContext();
+    auto *pipeline = GetPipeline();
+    // Probe a table over a spilled partition with a deferred probe row, as PerformPipelineWork
+    // would have if the partition were in memory.
+    WorkContext ctx(cc, *pipeline);
+    ctx.SetSource(this);
+    auto *codegen = GetCodeGen();
+    auto join_ht = codegen->MakeFreshIdentifier("joinHashTable");
+    util::RegionVector<ast::FieldDecl *> params = pipeline->PipelineParams();
+    params.push_back(codegen->MakeField(join_ht, codegen->PointerType(ast::BuiltinType::JoinHashTable)));
+    params.push_back(codegen->MakeField(probe_row_var_, codegen->PointerType(probe_row_type_)));
+    join_consumer_flag_ = true;
+    FunctionBuilder function(codegen, probe_spilled_fn_, std::move(params), codegen->Nil());
+    {
+      // The hash of the probe row is recomputed from its keys.
+      auto hash_val = HashKeys(&ctx, &function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+      LookupMatches(&ctx, &function, codegen->MakeExpr(join_ht), codegen->MakeExpr(hash_val));
+    }
+    join_consumer_flag_ = false;
+    decls->push_back(function.Finish());
+  }
 }
 
 ast::FunctionDecl *HashJoinTranslator::GenerateStartHookFunction() const {
@@ -162,6 +246,12 @@ void HashJoinTranslator::InitializeJoinHashTable(FunctionBuilder *function, ast:
   function->Append(GetCodeGen()->JoinHashTableInit(jht_ptr, GetExecutionContext(), build_row_type_));
 }
 
+void HashJoinTranslator::EnableSpilling(FunctionBuilder *function, ast::Expr *jht_ptr) const {
+  if (CanSpillBuild()) {
+    function->Append(GetCodeGen()->JoinHashTableEnableSpilling(jht_ptr, probe_row_type_));
+  }
+}
+
 void HashJoinTranslator::TearDownJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const {
   function->Append(GetCodeGen()->JoinHashTableFree(jht_ptr));
 }
@@ -169,6 +259,7 @@ void HashJoinTranslator::TearDownJoinHashTable(FunctionBuilder *function, ast::E
 void HashJoinTranslator::InitializeQueryState(FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
   InitializeJoinHashTable(function, global_join_ht_.GetPtr(codegen));
+  EnableSpilling(function, global_join_ht_.GetPtr(codegen));
 }
 
 void HashJoinTranslator::TearDownQueryState(FunctionBuilder *function) const {
@@ -178,6 +269,7 @@ void HashJoinTranslator::TearDownQueryState(FunctionBuilder *function) const {
 void HashJoinTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   if (IsLeftPipeline(pipeline) && left_pipeline_.IsParallel()) {
     InitializeJoinHashTable(function, local_join_ht_.GetPtr(GetCodeGen()));
+    EnableSpilling(function, local_join_ht_.GetPtr(GetCodeGen()));
   }
 
   InitializeCounters(pipeline, function);
@@ -220,7 +312,7 @@ void HashJoinTranslator::EndParallelPipelineWork(const Pipeline &pipeline, Funct
   RecordCounters(pipeline, function);
 }
 
-ast::Expr *HashJoinTranslator::HashKeys(
+ast::Identifier HashJoinTranslator::HashKeys(
     WorkContext *ctx, FunctionBuilder *function,
     const std::vector<common::ManagedPointer<parser::AbstractExpression>> &hash_keys) const {
   auto *codegen = GetCodeGen();
@@ -234,7 +326,7 @@ ast::Expr *HashJoinTranslator::HashKeys(
   ast::Identifier hash_val_name = codegen->MakeFreshIdentifier("hashVal");
   function->Append(codegen->DeclareVarWithInit(hash_val_name, codegen->Hash(key_values)));
 
-  return codegen->MakeExpr(hash_val_name);
+  return hash_val_name;
 }
 
 ast::Expr *HashJoinTranslator::GetRowAttribute(ast::Expr *row, uint32_t attr_idx) const {
@@ -278,8 +370,9 @@ void HashJoinTranslator::InsertIntoJoinHashTable(WorkContext *ctx, FunctionBuild
   auto hash_val = HashKeys(ctx, function, GetPlanAs<planner::HashJoinPlanNode>().GetLeftHashKeys());
 
   // var buildRow = @joinHTInsert(...)
+  auto hash_val_expr = codegen->MakeExpr(hash_val);
   function->Append(codegen->DeclareVarWithInit(
-      build_row_var_, codegen->JoinHashTableInsert(join_ht.GetPtr(codegen), hash_val, build_row_type_)));
+      build_row_var_, codegen->JoinHashTableInsert(join_ht.GetPtr(codegen), hash_val_expr, build_row_type_)));
 
   // Fill row.
   FillBuildRow(ctx, function, codegen->MakeExpr(build_row_var_));
@@ -290,6 +383,38 @@ void HashJoinTranslator::InsertIntoJoinHashTable(WorkContext *ctx, FunctionBuild
 void HashJoinTranslator::ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
 
+  auto hash_val = HashKeys(ctx, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+
+  CounterAdd(function, num_probe_rows_, 1);
+
+  if (!CanSpillBuild()) {
+    LookupMatches(ctx, function, global_join_ht_.GetPtr(codegen), codegen->MakeExpr(hash_val));
+    return;
+  }
+
+  // If the partition of the probe was spilled, defer the probe until the partition is loaded.
+  // if (@joinHTIsPartitionSpilled(jht, hashVal))
+  auto is_spilled_call =
+      codegen->JoinHashTableIsPartitionSpilled(global_join_ht_.GetPtr(codegen), codegen->MakeExpr(hash_val));
+  If is_spilled(function, is_spilled_call);
+  {
+    // var probeRow : ProbeRow
+    function->Append(codegen->DeclareVarNoInit(probe_row_var_, codegen->MakeExpr(probe_row_type_)));
+    // Fill row.
+    FillProbeRow(ctx, function, codegen->MakeExpr(probe_row_var_));
+    // @joinHTDeferProbe(jht, hashVal, &probeRow)
+    function->Append(codegen->JoinHashTableDeferProbe(global_join_ht_.GetPtr(codegen), codegen->MakeExpr(hash_val),
+                                                      codegen->AddressOf(codegen->MakeExpr(probe_row_var_))));
+  }
+  is_spilled.Else();
+  { LookupMatches(ctx, function, global_join_ht_.GetPtr(codegen), codegen->MakeExpr(hash_val)); }
+  is_spilled.EndIf();
+}
+
+void HashJoinTranslator::LookupMatches(WorkContext *ctx, FunctionBuilder *function, ast::Expr *join_ht,
+                                       ast::Expr *hash_val) const {
+  auto *codegen = GetCodeGen();
+
   // var entryIterBase: HashTableEntryIterator
   auto iter_name_base = codegen->MakeFreshIdentifier("entryIterBase");
   function->Append(codegen->DeclareVarNoInit(iter_name_base, ast::BuiltinType::HashTableEntryIterator));
@@ -299,16 +424,12 @@ void HashJoinTranslator::ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *f
   function->Append(codegen->DeclareVarWithInit(iter_name, codegen->AddressOf(codegen->MakeExpr(iter_name_base))));
 
   auto entry_iter = codegen->MakeExpr(iter_name);
-  auto hash_val = HashKeys(ctx, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
 
   // Probe matches.
   const auto &join_plan = GetPlanAs<planner::HashJoinPlanNode>();
-  auto lookup_call =
-      codegen->MakeStmt(codegen->JoinHashTableLookup(global_join_ht_.GetPtr(codegen), entry_iter, hash_val));
+  auto lookup_call = codegen->MakeStmt(codegen->JoinHashTableLookup(join_ht, entry_iter, hash_val));
   auto has_next_call = codegen->HTEntryIterHasNext(entry_iter);
 
-  CounterAdd(function, num_probe_rows_, 1);
-
   // The probe depends on the join type
   if (join_plan.RequiresRightMark()) {
     // First declare the right mark.
@@ -503,6 +624,9 @@ void HashJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBu
       auto *tls = GetThreadStateContainer();
       auto *offset = local_join_ht_.OffsetFromState(codegen);
       function->Append(codegen->JoinHashTableBuildParallel(jht, tls, offset));
+      if (build_bloom_filter_) {
+        function->Append(codegen->JoinHashTableBuildBloomFilter(global_join_ht_.GetPtr(codegen)));
+      }
 
       if (IsPipelineMetricsEnabled()) {
         auto *exec_ctx = GetExecutionContext();
@@ -510,6 +634,9 @@ void HashJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBu
       }
     } else {
       function->Append(codegen->JoinHashTableBuild(jht));
+      if (build_bloom_filter_) {
+        function->Append(codegen->JoinHashTableBuildBloomFilter(global_join_ht_.GetPtr(codegen)));
+      }
       RecordCounters(pipeline, function);
     }
   } else {
@@ -517,6 +644,13 @@ void HashJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBu
       CollectUnmatchedLeftRows(function);
     }
 
+    if (CanSpillBuild()) {
+      // @joinHTProbeSpilled(jht, queryState, pipelineState, probeSpilled)
+      auto pipeline_state = codegen->MakeExpr(GetPipeline()->GetPipelineStateVar());
+      function->Append(codegen->JoinHashTableProbeSpilled(global_join_ht_.GetPtr(codegen), GetQueryStatePtr(),
+                                                          pipeline_state, probe_spilled_fn_));
+    }
+
     if (!pipeline.IsParallel()) {
       RecordCounters(pipeline, function);
     }
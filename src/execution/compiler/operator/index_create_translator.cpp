@@ -51,6 +51,18 @@ IndexCreateTranslator::IndexCreateTranslator(const planner::CreateIndexPlanNode
   ast::Expr *tuple_slot_type = codegen_->BuiltinType(ast::BuiltinType::TupleSlot);
   local_tuple_slot_ = pipeline->DeclarePipelineStateEntry("local_tuple_slot", tuple_slot_type);
 
+  // An empty index is bulk loaded if it can be. The models of the CREATE_INDEX operating units describe inserting tuple
+  // by tuple, so bulk loading is left out while pipeline metrics are collected.
+  const auto index = codegen_->GetCatalogAccessor()->GetIndex(index_oid_);
+  bulk_load_ = index->SupportsBulkLoad() && index->GetSize() == 0 && !IsPipelineMetricsEnabled();
+  if (bulk_load_) {
+    ast::Expr *sorter_type = codegen_->BuiltinType(ast::BuiltinType::Sorter);
+    global_sorter_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen_, "bulk_load_sorter", sorter_type);
+    if (pipeline->IsParallel()) {
+      local_sorter_ = pipeline->DeclarePipelineStateEntry("local_bulk_load_sorter", sorter_type);
+    }
+  }
+
   num_inserts_ = CounterDeclare("num_inserts", pipeline);
 
   if (GetPipeline()->IsParallel() && IsPipelineMetricsEnabled()) {
@@ -92,12 +104,31 @@ void IndexCreateTranslator::TearDownStorageInterface(FunctionBuilder *function,
 void IndexCreateTranslator::InitializeQueryState(FunctionBuilder *function) const {
   // Set up global col oid array
   SetGlobalOids(function, global_col_oids_.Get(codegen_));
+  if (bulk_load_) {
+    InitializeSorter(function, global_sorter_.GetPtr(codegen_));
+  }
+}
+
+void IndexCreateTranslator::TearDownQueryState(FunctionBuilder *function) const {
+  if (bulk_load_) {
+    function->Append(codegen_->SorterFree(global_sorter_.GetPtr(codegen_)));
+  }
 }
 
 void IndexCreateTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   // Thread local member
   InitializeStorageInterface(function, local_storage_interface_.GetPtr(codegen_));
   DeclareIndexPR(function);
+  if (bulk_load_ && pipeline.IsParallel()) {
+    InitializeSorter(function, local_sorter_.GetPtr(codegen_));
+  }
+}
+
+void IndexCreateTranslator::InitializeSorter(FunctionBuilder *function, ast::Expr *sorter_ptr) const {
+  // @sorterInitForIndex(&sorter, execCtx, index_oid)
+  ast::Expr *index_oid_expr = codegen_->Const32(index_oid_.UnderlyingValue());
+  function->Append(
+      codegen_->CallBuiltin(ast::Builtin::SorterInitForIndex, {sorter_ptr, GetExecutionContext(), index_oid_expr}));
 }
 
 void IndexCreateTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipeline,
@@ -109,6 +140,9 @@ void IndexCreateTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pi
 
 void IndexCreateTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   TearDownStorageInterface(function, local_storage_interface_.GetPtr(codegen_));
+  if (bulk_load_ && pipeline.IsParallel()) {
+    function->Append(codegen_->SorterFree(local_sorter_.GetPtr(codegen_)));
+  }
 }
 
 util::RegionVector<ast::FieldDecl *> IndexCreateTranslator::GetWorkerParams() const {
@@ -186,6 +220,27 @@ void IndexCreateTranslator::PerformPipelineWork(WorkContext *context, FunctionBu
   }
 }
 
+void IndexCreateTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (!bulk_load_) return;
+
+  // Sort the entries of all threads into the global sorter
+  ast::Expr *sorter_ptr = global_sorter_.GetPtr(codegen_);
+  if (pipeline.IsParallel()) {
+    ast::Expr *offset = local_sorter_.OffsetFromState(codegen_);
+    function->Append(codegen_->SortParallel(sorter_ptr, GetThreadStateContainer(), offset));
+  } else {
+    function->Append(codegen_->SorterSort(sorter_ptr));
+  }
+
+  // if (!@indexBulkLoad(&local_storage_interface, &bulk_load_sorter)) { Abort(); }
+  auto *bulk_load_call =
+      codegen_->CallBuiltin(ast::Builtin::IndexBulkLoad, {local_storage_interface_.GetPtr(codegen_), sorter_ptr});
+  auto *cond = codegen_->UnaryOp(parsing::Token::Type::BANG, bulk_load_call);
+  If success(function, cond);
+  { function->Append(codegen_->AbortTxn(GetExecutionContext())); }
+  success.EndIf();
+}
+
 void IndexCreateTranslator::SetGlobalOids(FunctionBuilder *function, ast::Expr *global_col_oids) const {
   for (uint64_t i = 0; i < all_oids_.size(); i++) {
     // col_oids_var_[i] = col_oid
@@ -291,6 +346,15 @@ void IndexCreateTranslator::IndexInsert(WorkContext *ctx, FunctionBuilder *funct
     function->Append(codegen_->MakeStmt(set_key_call));
   }
 
+  if (bulk_load_) {
+    // @indexBulkLoadInsert(&local_storage_interface, &sorter, &local_tuple_slot)
+    const auto &sorter = GetPipeline()->IsParallel() ? local_sorter_ : global_sorter_;
+    function->Append(codegen_->CallBuiltin(
+        ast::Builtin::IndexBulkLoadInsert,
+        {local_storage_interface_.GetPtr(codegen_), sorter.GetPtr(codegen_), local_tuple_slot_.GetPtr(codegen_)}));
+    return;
+  }
+
   // if (!@IndexInsertWithSlot(&local_storage_interface, &local_tuple_slot, unique)) { Abort(); }
   auto *index_insert_call = codegen_->CallBuiltin(
       ast::Builtin::IndexInsertWithSlot, {local_storage_interface_.GetPtr(codegen_), local_tuple_slot_.GetPtr(codegen_),
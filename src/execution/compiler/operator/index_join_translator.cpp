@@ -9,6 +9,7 @@
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
 #include "execution/compiler/operator/operator_translator.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/work_context.h"
 #include "planner/plannodes/index_join_plan_node.h"
 #include "storage/index/index.h"
@@ -43,6 +44,18 @@ IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlanNode &plan,
   }
 
   compilation_context->Prepare(*GetPlan().GetChild(0), pipeline);
+
+  // Exact lookups directly on top of a sequential scan probe the index with all tuples of a batch of the scan at once
+  const auto &child_plan = *GetPlan().GetChild(0);
+  if (plan.GetScanType() == planner::IndexScanType::Exact &&
+      child_plan.GetPlanNodeType() == planner::PlanNodeType::SEQSCAN) {
+    batched_probes_ = true;
+    ast::Expr *iter_type = GetCodeGen()->BuiltinType(ast::BuiltinType::IndexIterator);
+    local_index_iter_ = pipeline->DeclarePipelineStateEntry("indexIterator", iter_type);
+    auto *scan_translator = static_cast<SeqScanTranslator *>(compilation_context->LookupTranslator(child_plan));
+    scan_translator->RegisterIndexJoin(this);
+  }
+
   index_size_ = CounterDeclare("index_size", pipeline);
   num_scans_index_ = CounterDeclare("num_scans_index", pipeline);
   num_loops_ = CounterDeclare("num_loops", pipeline);
@@ -52,30 +65,79 @@ void IndexJoinTranslator::InitializePipelineState(const Pipeline &pipeline, Func
   CounterSet(function, index_size_, 0);
   CounterSet(function, num_scans_index_, 0);
   CounterSet(function, num_loops_, 0);
+
+  if (batched_probes_) {
+    // var col_oids: [num_cols]uint32
+    // col_oids[i] = ...
+    SetOids(function);
+    // @indexIteratorInit(&pipelineState.indexIterator, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
+    DeclareIterator(function);
+  }
+}
+
+void IndexJoinTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (batched_probes_) {
+    // @indexIteratorFree(&pipelineState.indexIterator)
+    FreeIterator(function);
+  }
+}
+
+void IndexJoinTranslator::ProbeBatch(WorkContext *context, FunctionBuilder *function, ast::Expr *vpi,
+                                     bool filtered) const {
+  auto *codegen = GetCodeGen();
+  const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
+
+  // for (; @vpiHasNext(vpi); @vpiAdvance(vpi)) {
+  Loop vpi_loop(function, nullptr, codegen->VPIHasNext(vpi, filtered),
+                codegen->MakeStmt(codegen->VPIAdvance(vpi, filtered)));
+  {
+    // var lo_index_pr = @indexIteratorGetLoPR(&pipelineState.indexIterator)
+    ast::Expr *lo_pr_call = codegen->CallBuiltin(ast::Builtin::IndexIteratorGetLoPR, {GetIteratorPtr()});
+    function->Append(codegen->DeclareVar(lo_index_pr_, nullptr, lo_pr_call));
+    // @prSet(lo_index_pr, ...)
+    FillKey(context, function, lo_index_pr_, op.GetLoIndexColumns());
+    // @indexIteratorAddBatchKey(&pipelineState.indexIterator)
+    function->Append(
+        codegen->MakeStmt(codegen->CallBuiltin(ast::Builtin::IndexIteratorAddBatchKey, {GetIteratorPtr()})));
+  }
+  vpi_loop.EndLoop();
+
+  // The scan iterates the batch again to push its tuples to this join
+  // @vpiReset(vpi)
+  function->Append(codegen->MakeStmt(codegen->VPIReset(vpi, filtered)));
+  // @indexIteratorScanKeyBatch(&pipelineState.indexIterator)
+  function->Append(
+      codegen->MakeStmt(codegen->CallBuiltin(ast::Builtin::IndexIteratorScanKeyBatch, {GetIteratorPtr()})));
 }
 
 void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
   const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
-  // var col_oids: [num_cols]uint32
-  // col_oids[i] = ...
-  SetOids(function);
-  // var index_iter : IndexIterator
-  // @indexIteratorInit(&index_iter, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
-  DeclareIterator(function);
-  // var lo_index_pr = @indexIteratorGetLoPR(&index_iter)
-  // var hi_index_pr = @indexIteratorGetHiPR(&index_iter)
-  DeclareIndexPR(function);
-  // @prSet(lo_index_pr, ...)
-  FillKey(context, function, lo_index_pr_, op.GetLoIndexColumns());
-  // @prSet(hi_index_pr, ...)
-  FillKey(context, function, hi_index_pr_, op.GetHiIndexColumns());
-
-  // @indexIteratorScanKey(&index_iter)
-  ast::Expr *scan_call = GetCodeGen()->IndexIteratorScan(index_iter_, op.GetScanType(), 0);
+  ast::Expr *scan_call;
+  if (batched_probes_) {
+    // The keys of the tuple were already looked up with the rest of its batch
+    // @indexIteratorNextBatchKey(&pipelineState.indexIterator)
+    scan_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorNextBatchKey, {GetIteratorPtr()});
+  } else {
+    // var col_oids: [num_cols]uint32
+    // col_oids[i] = ...
+    SetOids(function);
+    // var index_iter : IndexIterator
+    // @indexIteratorInit(&index_iter, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
+    DeclareIterator(function);
+    // var lo_index_pr = @indexIteratorGetLoPR(&index_iter)
+    // var hi_index_pr = @indexIteratorGetHiPR(&index_iter)
+    DeclareIndexPR(function);
+    // @prSet(lo_index_pr, ...)
+    FillKey(context, function, lo_index_pr_, op.GetLoIndexColumns());
+    // @prSet(hi_index_pr, ...)
+    FillKey(context, function, hi_index_pr_, op.GetHiIndexColumns());
+
+    // @indexIteratorScanKey(&index_iter)
+    scan_call = GetCodeGen()->IndexIteratorScan(GetIteratorPtr(), op.GetScanType(), 0);
+  }
   ast::Stmt *loop_init = GetCodeGen()->MakeStmt(scan_call);
   // @indexIteratorAdvance(&index_iter)
-  ast::Expr *advance_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {GetCodeGen()->AddressOf(index_iter_)});
+  ast::Expr *advance_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {GetIteratorPtr()});
 
   CounterAdd(function, num_loops_, 1);
 
@@ -104,9 +166,11 @@ void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
   loop.EndLoop();
 
   CounterSetExpr(function, index_size_,
-                 GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {GetCodeGen()->AddressOf(index_iter_)}));
-  // @indexIteratorFree(&index_iter_)
-  FreeIterator(function);
+                 GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {GetIteratorPtr()}));
+  if (!batched_probes_) {
+    // @indexIteratorFree(&index_iter_)
+    FreeIterator(function);
+  }
 }
 
 void IndexJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
@@ -160,15 +224,17 @@ void IndexJoinTranslator::SetOids(FunctionBuilder *builder) const {
 }
 
 void IndexJoinTranslator::DeclareIterator(FunctionBuilder *builder) const {
-  // var index_iter : IndexIterator
-  ast::Expr *iter_type = GetCodeGen()->BuiltinType(ast::BuiltinType::IndexIterator);
-  builder->Append(GetCodeGen()->DeclareVar(index_iter_, iter_type, nullptr));
+  if (!batched_probes_) {
+    // var index_iter : IndexIterator
+    ast::Expr *iter_type = GetCodeGen()->BuiltinType(ast::BuiltinType::IndexIterator);
+    builder->Append(GetCodeGen()->DeclareVar(index_iter_, iter_type, nullptr));
+  }
   // @indexIteratorInit(&index_iter, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
   const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
   uint32_t num_attrs = std::max(op.GetLoIndexColumns().size(), op.GetHiIndexColumns().size());
 
   ast::Expr *init_call = GetCodeGen()->IndexIteratorInit(
-      index_iter_, GetCompilationContext()->GetExecutionContextPtrFromQueryState(), num_attrs,
+      GetIteratorPtr(), GetCompilationContext()->GetExecutionContextPtrFromQueryState(), num_attrs,
       op.GetTableOid().UnderlyingValue(), op.GetIndexOid().UnderlyingValue(), col_oids_);
   builder->Append(GetCodeGen()->MakeStmt(init_call));
 }
@@ -177,9 +243,9 @@ void IndexJoinTranslator::DeclareIndexPR(noisepage::execution::compiler::Functio
   // var lo_pr = @indexIteratorGetLoPR(&index_iter)
   // var hi_pr = @indexIteratorGetHiPR(&index_iter)
   ast::Expr *lo_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetLoPR, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetLoPR, {GetIteratorPtr()});
   ast::Expr *hi_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetHiPR, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetHiPR, {GetIteratorPtr()});
   builder->Append(GetCodeGen()->DeclareVar(lo_index_pr_, nullptr, lo_pr_call));
   builder->Append(GetCodeGen()->DeclareVar(hi_index_pr_, nullptr, hi_pr_call));
 }
@@ -187,14 +253,14 @@ void IndexJoinTranslator::DeclareIndexPR(noisepage::execution::compiler::Functio
 void IndexJoinTranslator::DeclareTablePR(noisepage::execution::compiler::FunctionBuilder *builder) const {
   // var table_pr = @indexIteratorGetTablePR(&index_iter)
   ast::Expr *get_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {GetIteratorPtr()});
   builder->Append(GetCodeGen()->DeclareVar(table_pr_, nullptr, get_pr_call));
 }
 
 void IndexJoinTranslator::DeclareSlot(noisepage::execution::compiler::FunctionBuilder *builder) const {
   // var slot = @indexIteratorGetSlot(&index_iter)
   ast::Expr *get_slot_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {GetIteratorPtr()});
   builder->Append(GetCodeGen()->DeclareVar(slot_, nullptr, get_slot_call));
 }
 
@@ -218,10 +284,15 @@ ast::Expr *IndexJoinTranslator::GetSlotAddress() const {
   return GetCodeGen()->AddressOf(slot_);
 }
 
+ast::Expr *IndexJoinTranslator::GetIteratorPtr() const {
+  // &pipelineState.indexIterator or &index_iter
+  return batched_probes_ ? local_index_iter_.GetPtr(GetCodeGen()) : GetCodeGen()->AddressOf(index_iter_);
+}
+
 void IndexJoinTranslator::FreeIterator(FunctionBuilder *builder) const {
   // @indexIteratorFree(&index_iter_)
   ast::Expr *free_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorFree, {GetCodeGen()->AddressOf(index_iter_)});
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorFree, {GetIteratorPtr()});
   builder->Append(GetCodeGen()->MakeStmt(free_call));
 }
 
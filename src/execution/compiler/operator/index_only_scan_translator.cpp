@@ -0,0 +1,30 @@
+#include "execution/compiler/operator/index_only_scan_translator.h"
+
+#include "execution/compiler/codegen.h"
+#include "execution/compiler/function_builder.h"
+#include "planner/plannodes/index_scan_plan_node.h"
+
+namespace noisepage::execution::compiler {
+
+IndexOnlyScanTranslator::IndexOnlyScanTranslator(const planner::IndexScanPlanNode &plan,
+                                                 CompilationContext *compilation_context, Pipeline *pipeline)
+    : IndexScanTranslator(plan, compilation_context, pipeline) {
+  NOISEPAGE_ASSERT(plan.IsIndexOnly(), "Index scan must be index-only.");
+}
+
+void IndexOnlyScanTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  IndexScanTranslator::InitializePipelineState(pipeline, function);
+  // @indexIteratorEnableIndexOnly(&pipelineState.indexIterator)
+  ast::Expr *enable_call =
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorEnableIndexOnly, {index_iter_.GetPtr(GetCodeGen())});
+  function->Append(GetCodeGen()->MakeStmt(enable_call));
+}
+
+void IndexOnlyScanTranslator::DeclareTablePR(FunctionBuilder *builder) const {
+  // var table_pr = @indexIteratorGetIndexOnlyPR(&pipelineState.indexIterator)
+  ast::Expr *get_pr_call =
+      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetIndexOnlyPR, {index_iter_.GetPtr(GetCodeGen())});
+  builder->Append(GetCodeGen()->DeclareVar(table_pr_, nullptr, get_pr_call));
+}
+
+}  // namespace noisepage::execution::compiler
@@ -19,6 +19,7 @@ namespace noisepage::execution::compiler {
 IndexScanTranslator::IndexScanTranslator(const planner::IndexScanPlanNode &plan,
                                          CompilationContext *compilation_context, Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::IDX_SCAN),
+      table_pr_(GetCodeGen()->MakeFreshIdentifier("table_pr")),
       input_oids_(plan.GetColumnOids()),
       table_schema_(GetCodeGen()->GetCatalogAccessor()->GetSchema(plan.GetTableOid())),
       table_pm_(GetCodeGen()->GetCatalogAccessor()->GetTable(plan.GetTableOid())->ProjectionMapForOids(input_oids_)),
@@ -28,7 +29,6 @@ IndexScanTranslator::IndexScanTranslator(const planner::IndexScanPlanNode &plan,
       index_pr_(GetCodeGen()->MakeFreshIdentifier("index_pr")),
       lo_index_pr_(GetCodeGen()->MakeFreshIdentifier("lo_index_pr")),
       hi_index_pr_(GetCodeGen()->MakeFreshIdentifier("hi_index_pr")),
-      table_pr_(GetCodeGen()->MakeFreshIdentifier("table_pr")),
       slot_(GetCodeGen()->MakeFreshIdentifier("slot")) {
   pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
   if (plan.GetScanPredicate() != nullptr) {
@@ -0,0 +1,278 @@
+#include "execution/compiler/operator/merge_join_translator.h"
+
+#include "execution/compiler/compilation_context.h"
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/if.h"
+#include "execution/compiler/loop.h"
+#include "execution/compiler/work_context.h"
+#include "planner/plannodes/merge_join_plan_node.h"
+#include "planner/plannodes/output_schema.h"
+
+namespace noisepage::execution::compiler {
+
+namespace {
+const char *row_attr_prefix = "attr";
+const char *key_attr_prefix = "key";
+}  // namespace
+
+MergeJoinTranslator::MergeJoinTranslator(const planner::MergeJoinPlanNode &plan,
+                                         CompilationContext *compilation_context, Pipeline *pipeline)
+    : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY),
+      merge_row_var_(GetCodeGen()->MakeFreshIdentifier("mergeRow")),
+      merge_row_type_(GetCodeGen()->MakeFreshIdentifier("MergeRow")),
+      merge_key_var_(GetCodeGen()->MakeFreshIdentifier("mergeKey")),
+      merge_key_type_(GetCodeGen()->MakeFreshIdentifier("MergeKey")),
+      lhs_row_(GetCodeGen()->MakeIdentifier("lhs")),
+      rhs_row_(GetCodeGen()->MakeIdentifier("rhs")),
+      merge_compare_func_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("MergeCompare"))),
+      left_pipeline_(this, Pipeline::Parallelism::Serial),
+      in_compare_func_(false) {
+  NOISEPAGE_ASSERT(plan.GetChildrenSize() == 2, "Merge join expected to have two children.");
+  NOISEPAGE_ASSERT(!plan.GetLeftMergeKeys().empty(), "Merge join must have join keys from left input");
+  NOISEPAGE_ASSERT(plan.GetLeftMergeKeys().size() == plan.GetRightMergeKeys().size(),
+                   "Merge join must have the same number of left and right join keys");
+  NOISEPAGE_ASSERT(plan.GetJoinPredicate() != nullptr, "Merge join must have a join predicate!");
+
+  // Both inputs must be consumed in key order, so neither side can run in parallel.
+  pipeline->UpdateParallelism(Pipeline::Parallelism::Serial);
+
+  // Right pipeline begins after the left input has been buffered.
+  pipeline->LinkSourcePipeline(&left_pipeline_);
+  // Register left and right child in their appropriate pipelines.
+  compilation_context->Prepare(*plan.GetChild(0), &left_pipeline_);
+  compilation_context->Prepare(*plan.GetChild(1), pipeline);
+
+  // Prepare join predicate, left, and right merge keys.
+  compilation_context->Prepare(*plan.GetJoinPredicate());
+  for (const auto left_merge_key : plan.GetLeftMergeKeys()) {
+    compilation_context->Prepare(*left_merge_key);
+  }
+  for (const auto right_merge_key : plan.GetRightMergeKeys()) {
+    compilation_context->Prepare(*right_merge_key);
+  }
+
+  // The left input is buffered in a RowBuffer, which spills to disk if the query goes over its
+  // memory budget. The merge cursor can rewind to the start of a group of equal keys.
+  auto *codegen = GetCodeGen();
+  ast::Expr *buffer_type = codegen->BuiltinType(ast::BuiltinType::RowBuffer);
+  global_buffer_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen, "mergeBuffer", buffer_type);
+
+  ast::Expr *cursor_type = codegen->BuiltinType(ast::BuiltinType::RowBufferIterator);
+  cursor_ = pipeline->DeclarePipelineStateEntry("mergeCursor", cursor_type);
+}
+
+void MergeJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
+  auto *codegen = GetCodeGen();
+
+  // Buffered left row.
+  auto fields = codegen->MakeEmptyFieldList();
+  GetAllChildOutputFields(0, row_attr_prefix, &fields);
+  decls->push_back(codegen->DeclareStruct(merge_row_type_, std::move(fields)));
+
+  // Merge keys of the current right tuple.
+  fields = codegen->MakeEmptyFieldList();
+  uint32_t key_idx = 0;
+  for (const auto &right_merge_key : GetMergeJoinPlan().GetRightMergeKeys()) {
+    auto field_name = codegen->MakeIdentifier(key_attr_prefix + std::to_string(key_idx++));
+    auto type = codegen->TplType(sql::GetTypeId(right_merge_key->GetReturnValueType()));
+    fields.push_back(codegen->MakeField(field_name, type));
+  }
+  decls->push_back(codegen->DeclareStruct(merge_key_type_, std::move(fields)));
+}
+
+void MergeJoinTranslator::GenerateKeyComparison(FunctionBuilder *function) {
+  auto *codegen = GetCodeGen();
+  WorkContext context(GetCompilationContext(), left_pipeline_);
+  context.SetExpressionCacheEnable(false);
+  const auto &left_merge_keys = GetMergeJoinPlan().GetLeftMergeKeys();
+  for (uint32_t key_idx = 0; key_idx < left_merge_keys.size(); key_idx++) {
+    int32_t ret_value = -1;
+    for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+      in_compare_func_ = true;
+      ast::Expr *lhs = context.DeriveValue(*left_merge_keys[key_idx], this);
+      ast::Expr *rhs = GetKeyAttribute(codegen->MakeExpr(rhs_row_), key_idx);
+      If check_comparison(function, codegen->Compare(tok, lhs, rhs));
+      {
+        function->Append(codegen->Return(codegen->Const32(ret_value)));
+      }
+      check_comparison.EndIf();
+      ret_value = -ret_value;
+    }
+  }
+  in_compare_func_ = false;
+}
+
+void MergeJoinTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
+  auto *codegen = GetCodeGen();
+
+  // Row-to-key comparison, used to merge the right input against the buffer.
+  auto params = codegen->MakeFieldList({
+      codegen->MakeField(lhs_row_, codegen->PointerType(merge_row_type_)),
+      codegen->MakeField(rhs_row_, codegen->PointerType(merge_key_type_)),
+  });
+  FunctionBuilder builder(codegen, merge_compare_func_, std::move(params), codegen->Int32Type());
+  {
+    GenerateKeyComparison(&builder);
+  }
+  decls->push_back(builder.Finish(codegen->Const32(0)));
+}
+
+void MergeJoinTranslator::InitializeQueryState(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  function->Append(codegen->RowBufferInit(global_buffer_.GetPtr(codegen), GetExecutionContext(), merge_row_type_));
+}
+
+void MergeJoinTranslator::TearDownQueryState(FunctionBuilder *function) const {
+  function->Append(GetCodeGen()->RowBufferFree(global_buffer_.GetPtr(GetCodeGen())));
+}
+
+void MergeJoinTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsRightPipeline(pipeline)) {
+    auto *codegen = GetCodeGen();
+    function->Append(codegen->RowBufferIterInit(cursor_.GetPtr(codegen), global_buffer_.GetPtr(codegen)));
+  }
+}
+
+void MergeJoinTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsRightPipeline(pipeline)) {
+    function->Append(GetCodeGen()->RowBufferIterClose(cursor_.GetPtr(GetCodeGen())));
+  }
+}
+
+ast::Expr *MergeJoinTranslator::GetRowAttribute(ast::Expr *row, uint32_t attr_idx) const {
+  auto *codegen = GetCodeGen();
+  auto attr_name = codegen->MakeIdentifier(row_attr_prefix + std::to_string(attr_idx));
+  return codegen->AccessStructMember(row, attr_name);
+}
+
+ast::Expr *MergeJoinTranslator::GetKeyAttribute(ast::Expr *key, uint32_t key_idx) const {
+  auto *codegen = GetCodeGen();
+  auto key_name = codegen->MakeIdentifier(key_attr_prefix + std::to_string(key_idx));
+  return codegen->AccessStructMember(key, key_name);
+}
+
+void MergeJoinTranslator::InsertIntoBuffer(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+
+  // Rows with a NULL key never satisfy an equi-join, so they aren't buffered.
+  ast::Expr *has_null_key = nullptr;
+  for (const auto left_merge_key : GetMergeJoinPlan().GetLeftMergeKeys()) {
+    ast::Expr *is_null = codegen->CallBuiltin(ast::Builtin::IsValNull, {ctx->DeriveValue(*left_merge_key, this)});
+    has_null_key =
+        has_null_key == nullptr ? is_null : codegen->BinaryOp(parsing::Token::Type::OR, has_null_key, is_null);
+  }
+
+  If check_keys(function, codegen->UnaryOp(parsing::Token::Type::BANG, has_null_key));
+  {
+    // var mergeRow = @ptrCast(*MergeRow, @rowBufferInsert(mergeBuffer))
+    ast::Expr *insert_call = codegen->RowBufferInsert(global_buffer_.GetPtr(codegen), merge_row_type_);
+    function->Append(codegen->DeclareVarWithInit(merge_row_var_, insert_call));
+
+    // mergeRow.attr = ...
+    const auto child_schema = GetPlan().GetChild(0)->GetOutputSchema();
+    for (uint32_t attr_idx = 0; attr_idx < child_schema->GetColumns().size(); attr_idx++) {
+      ast::Expr *lhs = GetRowAttribute(codegen->MakeExpr(merge_row_var_), attr_idx);
+      ast::Expr *rhs = GetChildOutput(ctx, 0, attr_idx);
+      function->Append(codegen->Assign(lhs, rhs));
+    }
+  }
+  check_keys.EndIf();
+}
+
+void MergeJoinTranslator::MergeWithBuffer(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  const auto &right_merge_keys = GetMergeJoinPlan().GetRightMergeKeys();
+
+  // var mergeKey: MergeKey
+  function->Append(codegen->DeclareVarNoInit(merge_key_var_, codegen->MakeExpr(merge_key_type_)));
+
+  // mergeKey.key = ...
+  ast::Expr *has_null_key = nullptr;
+  for (uint32_t key_idx = 0; key_idx < right_merge_keys.size(); key_idx++) {
+    ast::Expr *lhs = GetKeyAttribute(codegen->MakeExpr(merge_key_var_), key_idx);
+    ast::Expr *rhs = ctx->DeriveValue(*right_merge_keys[key_idx], this);
+    function->Append(codegen->Assign(lhs, rhs));
+
+    ast::Expr *key = GetKeyAttribute(codegen->MakeExpr(merge_key_var_), key_idx);
+    ast::Expr *is_null = codegen->CallBuiltin(ast::Builtin::IsValNull, {key});
+    has_null_key =
+        has_null_key == nullptr ? is_null : codegen->BinaryOp(parsing::Token::Type::OR, has_null_key, is_null);
+  }
+
+  // MergeCompare(@ptrCast(*MergeRow, @rowBufferIterGetRow(mergeCursor)), &mergeKey)
+  const auto compare_to_key = [&]() {
+    ast::Expr *row = codegen->RowBufferIterGetRow(cursor_.GetPtr(codegen), merge_row_type_);
+    return codegen->Call(merge_compare_func_, {row, codegen->AddressOf(codegen->MakeExpr(merge_key_var_))});
+  };
+
+  // Right tuples with a NULL key never match. They also mustn't move the cursor.
+  If check_keys(function, codegen->UnaryOp(parsing::Token::Type::BANG, has_null_key));
+  {
+    // The mark is at the start of the group the previous right tuple matched, or would have
+    // matched. Right keys never decrease, so no buffered row before the mark can match this tuple.
+    function->Append(codegen->RowBufferIterRewind(cursor_.GetPtr(codegen)));
+
+    // Advance the cursor past all buffered rows with smaller keys.
+    auto *advance_cond = codegen->BinaryOp(
+        parsing::Token::Type::AND, codegen->RowBufferIterHasNext(cursor_.GetPtr(codegen)),
+        codegen->Compare(parsing::Token::Type::LESS, compare_to_key(), codegen->Const32(0)));
+    Loop advance_loop(function, advance_cond);
+    {
+      function->Append(codegen->RowBufferIterNext(cursor_.GetPtr(codegen)));
+    }
+    advance_loop.EndLoop();
+
+    // Mark the start of the group of buffered rows with an equal key, so that the next right tuple,
+    // which may have the same key, can rewind to it. Then join with every row of the group.
+    function->Append(codegen->RowBufferIterMark(cursor_.GetPtr(codegen)));
+
+    auto *group_cond = codegen->BinaryOp(
+        parsing::Token::Type::AND, codegen->RowBufferIterHasNext(cursor_.GetPtr(codegen)),
+        codegen->Compare(parsing::Token::Type::EQUAL, compare_to_key(), codegen->Const32(0)));
+    Loop group_loop(function, nullptr, group_cond,
+                    codegen->MakeStmt(codegen->RowBufferIterNext(cursor_.GetPtr(codegen))));
+    {
+      // var mergeRow = @ptrCast(*MergeRow, @rowBufferIterGetRow(mergeCursor))
+      auto row = codegen->RowBufferIterGetRow(cursor_.GetPtr(codegen), merge_row_type_);
+      function->Append(codegen->DeclareVarWithInit(merge_row_var_, row));
+
+      If check_predicate(function, ctx->DeriveValue(*GetMergeJoinPlan().GetJoinPredicate(), this));
+      {
+        // Valid tuple. Push to next operator in pipeline.
+        ctx->Push(function);
+      }
+      check_predicate.EndIf();
+    }
+    group_loop.EndLoop();
+  }
+  check_keys.EndIf();
+}
+
+void MergeJoinTranslator::PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const {
+  if (IsLeftPipeline(ctx->GetPipeline())) {
+    InsertIntoBuffer(ctx, function);
+  } else {
+    NOISEPAGE_ASSERT(IsRightPipeline(ctx->GetPipeline()), "Pipeline is unknown to join translator");
+    MergeWithBuffer(ctx, function);
+  }
+}
+
+void MergeJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsLeftPipeline(pipeline)) {
+    function->Append(GetCodeGen()->RowBufferFinish(global_buffer_.GetPtr(GetCodeGen())));
+  }
+}
+
+ast::Expr *MergeJoinTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const {
+  // In the right pipeline, attributes of the left child are read from the buffered row. When
+  // generating the comparison function, they are read from the function's row parameter.
+  if (IsRightPipeline(context->GetPipeline()) && child_idx == 0) {
+    return GetRowAttribute(GetCodeGen()->MakeExpr(merge_row_var_), attr_idx);
+  }
+  if (IsLeftPipeline(context->GetPipeline()) && in_compare_func_) {
+    return GetRowAttribute(GetCodeGen()->MakeExpr(lhs_row_), attr_idx);
+  }
+  return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
+}
+
+}  // namespace noisepage::execution::compiler
@@ -1,5 +1,7 @@
 #include "execution/compiler/operator/seq_scan_translator.h"
 
+#include <algorithm>
+
 #include "catalog/catalog_accessor.h"
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
@@ -9,9 +11,11 @@
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
 #include "execution/compiler/operator/cte_scan_translator.h"
+#include "execution/compiler/operator/index_join_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/work_context.h"
 #include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
 #include "parser/expression_util.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "storage/sql_table.h"
@@ -31,9 +35,7 @@ SeqScanTranslator::SeqScanTranslator(const planner::SeqScanPlanNode &plan, Compi
   // If there's a predicate, prepare the expression and register a filter manager.
   if (HasPredicate()) {
     compilation_context->Prepare(*plan.GetScanPredicate());
-
-    ast::Expr *fm_type = GetCodeGen()->BuiltinType(ast::BuiltinType::FilterManager);
-    local_filter_manager_ = pipeline->DeclarePipelineStateEntry("filterManager", fm_type);
+    DeclareFilterManager();
   }
 
   tvi_base_ =
@@ -48,6 +50,30 @@ bool SeqScanTranslator::HasPredicate() const {
   return GetPlanAs<planner::SeqScanPlanNode>().GetScanPredicate() != nullptr;
 }
 
+void SeqScanTranslator::DeclareFilterManager() {
+  if (local_filter_manager_.IsValid()) {
+    return;
+  }
+  ast::Expr *fm_type = GetCodeGen()->BuiltinType(ast::BuiltinType::FilterManager);
+  local_filter_manager_ = GetPipeline()->DeclarePipelineStateEntry("filterManager", fm_type);
+}
+
+void SeqScanTranslator::RegisterBloomFilter(const StateDescriptor::Entry &join_hash_table,
+                                            const std::vector<catalog::col_oid_t> &key_col_oids) {
+  NOISEPAGE_ASSERT(!key_col_oids.empty(), "Bloom filter must be probed with at least one key column");
+  BloomFilterProbe bloom_filter{join_hash_table, {}};
+  for (const auto col_oid : key_col_oids) {
+    bloom_filter.key_col_idxs_.push_back(GetColOidIndex(col_oid));
+  }
+  bloom_filters_.emplace_back(std::move(bloom_filter));
+  DeclareFilterManager();
+}
+
+void SeqScanTranslator::RegisterIndexJoin(const IndexJoinTranslator *index_join) {
+  NOISEPAGE_ASSERT(index_join_ == nullptr, "A scan is consumed by at most one index join");
+  index_join_ = index_join;
+}
+
 catalog::Schema SeqScanTranslator::GetPlanSchema() const {
   return GetCodeGen()->GetCatalogAccessor()->GetSchema(GetPlanAs<planner::SeqScanPlanNode>().GetTableOid());
 }
@@ -91,9 +117,67 @@ void SeqScanTranslator::GenerateGenericTerm(FunctionBuilder *function,
   check_filtered.EndIf();
 }
 
+void SeqScanTranslator::AddZoneMapTerm(common::ManagedPointer<parser::AbstractExpression> predicate,
+                                       const parser::ExpressionType cmp_type, const uint32_t col_idx,
+                                       std::vector<ZoneMapTerm> *curr_zone_map_terms) const {
+  // Zone maps hold the bounds of columns read as integers, so only integer, date and timestamp columns compared with
+  // a non-null constant of the same kind can be answered from them
+  if (catalog::IsTempOid(GetTableOid())) {
+    return;
+  }
+  switch (cmp_type) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      break;
+    default:
+      return;
+  }
+  const auto cve = predicate->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
+  const auto constant = predicate->GetChild(1).CastManagedPointerTo<parser::ConstantValueExpression>();
+  if (constant->IsNull()) {
+    return;
+  }
+  const auto col_type = GetPlanSchema().GetColumn(cve->GetColumnOid()).Type();
+  const auto const_type = constant->GetReturnValueType();
+  int64_t value;
+  switch (col_type) {
+    case sql::SqlTypeId::TinyInt:
+    case sql::SqlTypeId::SmallInt:
+    case sql::SqlTypeId::Integer:
+    case sql::SqlTypeId::BigInt:
+      if (const_type != sql::SqlTypeId::TinyInt && const_type != sql::SqlTypeId::SmallInt &&
+          const_type != sql::SqlTypeId::Integer && const_type != sql::SqlTypeId::BigInt) {
+        return;
+      }
+      value = constant->Peek<int64_t>();
+      break;
+    case sql::SqlTypeId::Date:
+      if (const_type != sql::SqlTypeId::Date) return;
+      value = constant->Peek<sql::Date>().ToNative();
+      break;
+    case sql::SqlTypeId::Timestamp:
+      if (const_type != sql::SqlTypeId::Timestamp) return;
+      value = static_cast<int64_t>(constant->Peek<sql::Timestamp>().ToNative());
+      break;
+    default:
+      return;
+  }
+  curr_zone_map_terms->push_back({cmp_type, col_idx, value});
+}
+
+bool SeqScanTranslator::HasZoneMapTerms() const {
+  return std::any_of(zone_map_terms_.begin(), zone_map_terms_.end(),
+                     [](const auto &clause_terms) { return !clause_terms.empty(); });
+}
+
 void SeqScanTranslator::GenerateFilterClauseFunctions(util::RegionVector<ast::FunctionDecl *> *decls,
                                                       common::ManagedPointer<parser::AbstractExpression> predicate,
                                                       std::vector<ast::Identifier> *curr_clause,
+                                                      std::vector<ZoneMapTerm> *curr_zone_map_terms,
                                                       bool seen_conjunction) {
   // The top-most disjunctions in the tree form separate clauses in the filter manager.
   // For a SQL statement like "SELECT * FROM tbl WHERE a=1 OR b=2 OR c=3;", its predicate is an AbstractExpression
@@ -103,18 +187,21 @@ void SeqScanTranslator::GenerateFilterClauseFunctions(util::RegionVector<ast::Fu
   if (!seen_conjunction && predicate->GetExpressionType() == parser::ExpressionType::CONJUNCTION_OR) {
     for (size_t idx = 0; idx < predicate->GetChildrenSize() - 1; ++idx) {
       std::vector<ast::Identifier> next_clause;
-      GenerateFilterClauseFunctions(decls, predicate->GetChild(idx), &next_clause, false);
+      std::vector<ZoneMapTerm> next_zone_map_terms;
+      GenerateFilterClauseFunctions(decls, predicate->GetChild(idx), &next_clause, &next_zone_map_terms, false);
       filters_.emplace_back(std::move(next_clause));
+      zone_map_terms_.emplace_back(std::move(next_zone_map_terms));
     }
     // Last predicate is handled separately to keep api unitform
-    GenerateFilterClauseFunctions(decls, predicate->GetChild(predicate->GetChildrenSize() - 1), curr_clause, false);
+    GenerateFilterClauseFunctions(decls, predicate->GetChild(predicate->GetChildrenSize() - 1), curr_clause,
+                                  curr_zone_map_terms, false);
     return;
   }
 
   // Consecutive conjunctions are part of the same clause.
   if (predicate->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
     for (const auto &child : predicate->GetChildren()) {
-      GenerateFilterClauseFunctions(decls, child, curr_clause, true);
+      GenerateFilterClauseFunctions(decls, child, curr_clause, curr_zone_map_terms, true);
     }
     return;
   }
@@ -141,6 +228,7 @@ void SeqScanTranslator::GenerateFilterClauseFunctions(util::RegionVector<ast::Fu
       auto const_val = translator->DeriveValue(nullptr, nullptr);
       auto cmp_type = predicate->GetExpressionType();
       cmp_type = cmp_type == parser::ExpressionType::COMPARE_IN ? parser::ExpressionType::COMPARE_EQUAL : cmp_type;
+      AddZoneMapTerm(predicate, cmp_type, col_index, curr_zone_map_terms);
       builder.Append(codegen->VPIFilter(exec_ctx,     // The execution context
                                         vector_proj,  // The vector projection
                                         cmp_type,     // Comparison type
@@ -207,12 +295,71 @@ void SeqScanTranslator::GenerateFilterClauseFunctions(util::RegionVector<ast::Fu
   decls->push_back(builder.Finish());
 }
 
+ast::Identifier SeqScanTranslator::GenerateBloomFilterTerm(util::RegionVector<ast::FunctionDecl *> *decls,
+                                                           const BloomFilterProbe &bloom_filter) {
+  // Signature: (execCtx: *ExecutionContext, vp: *VectorProjection, tids: *TupleIdList, ctx: *uint8) -> nil
+  auto *codegen = GetCodeGen();
+  auto fn_name = codegen->MakeFreshIdentifier(GetPipeline()->CreatePipelineFunctionName("BloomFilterClause"));
+  util::RegionVector<ast::FieldDecl *> params = codegen->MakeFieldList({
+      codegen->MakeField(codegen->MakeIdentifier("execCtx"), codegen->PointerType(ast::BuiltinType::ExecutionContext)),
+      codegen->MakeField(codegen->MakeIdentifier("vp"), codegen->PointerType(ast::BuiltinType::VectorProjection)),
+      codegen->MakeField(codegen->MakeIdentifier("tids"), codegen->PointerType(ast::BuiltinType::TupleIdList)),
+      codegen->MakeField(codegen->MakeIdentifier("context"), codegen->PointerType(ast::BuiltinType::Uint8)),
+  });
+  FunctionBuilder builder(codegen, fn_name, std::move(params), codegen->Nil());
+  {
+    ast::Expr *vector_proj = builder.GetParameterByPosition(1);
+    ast::Expr *tid_list = builder.GetParameterByPosition(2);
+    ast::Expr *context = builder.GetParameterByPosition(3);
+
+    // The filter manager's context is the query state, where the join hash table lives.
+    // var queryState = @ptrCast(*QueryState, context)
+    auto *query_state = GetCompilationContext()->GetQueryState();
+    auto query_state_var = GetCompilationContext()->QueryParams()[0]->Name();
+    builder.Append(codegen->DeclareVarWithInit(query_state_var, codegen->PtrCast(query_state->GetTypeName(), context)));
+
+    // var keyCols: [num_keys]uint32
+    const auto &key_col_idxs = bloom_filter.key_col_idxs_;
+    auto key_cols = codegen->MakeFreshIdentifier("keyCols");
+    builder.Append(
+        codegen->DeclareVarNoInit(key_cols, codegen->ArrayType(key_col_idxs.size(), ast::BuiltinType::Kind::Uint32)));
+    for (uint32_t i = 0; i < key_col_idxs.size(); i++) {
+      builder.Append(codegen->Assign(codegen->ArrayAccess(key_cols, i), codegen->Const32(key_col_idxs[i])));
+    }
+
+    // @joinHTProbeBloomFilter(&queryState.joinHashTable, vp, tids, keyCols)
+    builder.Append(codegen->JoinHashTableProbeBloomFilter(bloom_filter.join_hash_table_.GetPtr(codegen), vector_proj,
+                                                          tid_list, key_cols));
+  }
+  decls->push_back(builder.Finish());
+  return fn_name;
+}
+
 void SeqScanTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
   if (HasPredicate()) {
     std::vector<ast::Identifier> curr_clause;
+    std::vector<ZoneMapTerm> curr_zone_map_terms;
     auto root_expr = GetPlanAs<planner::SeqScanPlanNode>().GetScanPredicate();
-    GenerateFilterClauseFunctions(decls, root_expr, &curr_clause, false);
+    GenerateFilterClauseFunctions(decls, root_expr, &curr_clause, &curr_zone_map_terms, false);
     filters_.emplace_back(std::move(curr_clause));
+    zone_map_terms_.emplace_back(std::move(curr_zone_map_terms));
+  }
+
+  if (!bloom_filters_.empty()) {
+    std::vector<ast::Identifier> bloom_terms;
+    for (const auto &bloom_filter : bloom_filters_) {
+      bloom_terms.push_back(GenerateBloomFilterTerm(decls, bloom_filter));
+    }
+    // The filter manager evaluates a disjunction of conjunctive clauses. Bloom filters must hold for
+    // every surviving tuple, so their terms are conjoined onto each clause.
+    if (filters_.empty()) {
+      filters_.emplace_back(std::move(bloom_terms));
+      zone_map_terms_.emplace_back();
+    } else {
+      for (auto &clause : filters_) {
+        clause.insert(clause.end(), bloom_terms.begin(), bloom_terms.end());
+      }
+    }
   }
 }
 
@@ -232,8 +379,13 @@ void SeqScanTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast
     }
     vpi_loop.EndLoop();
   };
+  // The index join on top of this scan looks up the keys of all tuples in the batch before they are pushed to it
+  if (index_join_ != nullptr) {
+    index_join_->ProbeBatch(ctx, function, vpi, UsesFilterManager());
+  }
+
   // TODO(Amadou): What if the predicate doesn't filter out anything?
-  gen_vpi_loop(HasPredicate());
+  gen_vpi_loop(UsesFilterManager());
 
   // var vpi_num_tuples = @tableIterGetNumTuples(tvi)
   ast::Identifier vpi_num_tuples = codegen->MakeFreshIdentifier("vpi_num_tuples");
@@ -244,6 +396,10 @@ void SeqScanTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast
 
 void SeqScanTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
+  // @tableIterSkipBlocks(tvi, &pipelineState.filterManager)
+  if (HasZoneMapTerms()) {
+    function->Append(codegen->TableIterSkipBlocks(codegen->MakeExpr(tvi_var_), local_filter_manager_.GetPtr(codegen)));
+  }
   // for (@tableIterAdvance(tvi))
   Loop tvi_loop(function, codegen->TableIterAdvance(codegen->MakeExpr(tvi_var_)));
   {
@@ -251,8 +407,8 @@ void SeqScanTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function) c
     auto vpi = codegen->MakeExpr(vpi_var_);
     function->Append(codegen->DeclareVarWithInit(vpi_var_, codegen->TableIterGetVPI(codegen->MakeExpr(tvi_var_))));
 
-    // if (predicate)
-    if (HasPredicate()) {
+    // if (predicate or bloom filters)
+    if (UsesFilterManager()) {
       auto filter_manager = local_filter_manager_.GetPtr(codegen);
       function->Append(codegen->FilterManagerRunFilters(filter_manager, vpi, GetExecutionContext()));
     }
@@ -266,10 +422,21 @@ void SeqScanTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function) c
 
 void SeqScanTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
-  if (HasPredicate()) {
-    function->Append(codegen->FilterManagerInit(local_filter_manager_.GetPtr(codegen), GetExecutionContext()));
-    for (const auto &clause : filters_) {
-      function->Append(codegen->FilterManagerInsert(local_filter_manager_.GetPtr(codegen), clause));
+  if (UsesFilterManager()) {
+    if (bloom_filters_.empty()) {
+      function->Append(codegen->FilterManagerInit(local_filter_manager_.GetPtr(codegen), GetExecutionContext()));
+    } else {
+      // Bloom filter terms find their join hash tables through the query state.
+      function->Append(codegen->FilterManagerInit(local_filter_manager_.GetPtr(codegen), GetExecutionContext(),
+                                                  GetQueryStatePtr()));
+    }
+    for (uint32_t i = 0; i < filters_.size(); i++) {
+      function->Append(codegen->FilterManagerInsert(local_filter_manager_.GetPtr(codegen), filters_[i]));
+      // The zone map terms go into the clause that was just inserted
+      for (const auto &term : zone_map_terms_[i]) {
+        function->Append(codegen->FilterManagerInsertZoneMapTerm(local_filter_manager_.GetPtr(codegen),
+                                                                 term.comp_type_, term.col_idx_, term.value_));
+      }
     }
   }
 
@@ -279,7 +446,7 @@ void SeqScanTranslator::InitializePipelineState(const Pipeline &pipeline, Functi
 void SeqScanTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
 
-  if (HasPredicate()) {
+  if (UsesFilterManager()) {
     auto filter_manager = local_filter_manager_.GetPtr(GetCodeGen());
     function->Append(GetCodeGen()->FilterManagerFree(filter_manager));
   }
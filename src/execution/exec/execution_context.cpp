@@ -9,6 +9,7 @@
 #include "replication/primary_replication_manager.h"
 #include "self_driving/modeling/operating_unit.h"
 #include "self_driving/modeling/operating_unit_util.h"
+#include "spdlog/fmt/fmt.h"
 #include "storage/recovery/recovery_manager.h"
 #include "transaction/transaction_context.h"
 
@@ -26,6 +27,18 @@ OutputBuffer *ExecutionContext::OutputBufferNew() {
   return buffer;
 }
 
+util::CSVMappedFile *ExecutionContext::MapCSVFile(std::string_view file_name) {
+  auto file = std::make_unique<util::CSVMappedFile>(file_name);
+  if (!file->Initialize()) {
+    return nullptr;
+  }
+  return csv_files_.emplace_back(std::move(file)).get();
+}
+
+util::CSVReader *ExecutionContext::RetainCSVReader(std::unique_ptr<util::CSVReader> reader) {
+  return csv_readers_.emplace_back(std::move(reader)).get();
+}
+
 uint32_t ExecutionContext::ComputeTupleSize(const planner::OutputSchema *schema) {
   uint32_t tuple_size = 0;
   for (const auto &col : schema->GetColumns()) {
@@ -236,4 +249,13 @@ void ExecutionContext::InvokeHook(size_t hook_index, void *tls, void *arg) {
 
 void ExecutionContext::InitHooks(size_t num_hooks) { hooks_.resize(num_hooks); }
 
+void ExecutionContext::CheckMemoryBudget(const char *operator_name) const {
+  if (IsOverMemoryBudget()) {
+    throw EXECUTION_EXCEPTION(fmt::format("{} exceeded the query memory budget of {} bytes ({} bytes allocated).",
+                                          operator_name, exec_settings_.GetQueryMemoryBudget(),
+                                          mem_tracker_->GetTotalAllocatedSize()),
+                              common::ErrorCode::ERRCODE_OUT_OF_MEMORY);
+  }
+}
+
 }  // namespace noisepage::execution::exec
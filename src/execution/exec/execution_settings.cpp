@@ -10,6 +10,8 @@ void ExecutionSettings::UpdateFromSettingsManager(common::ManagedPointer<setting
     number_of_parallel_execution_threads_ = settings->GetInt(settings::Param::num_parallel_execution_threads);
     is_counters_enabled_ = settings->GetBool(settings::Param::counters_enable);
     is_pipeline_metrics_enabled_ = settings->GetBool(settings::Param::pipeline_metrics_enable);
+    query_memory_budget_ = static_cast<uint64_t>(settings->GetInt64(settings::Param::query_memory_budget));
+    spill_file_directory_ = settings->GetString(settings::Param::spill_file_directory);
   }
 }
 
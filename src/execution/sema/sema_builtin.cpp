@@ -415,6 +415,24 @@ void Sema::CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builti
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::AggHashTableEnableSpilling: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is an opaque query state pointer
+      if (!args[1]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
+      // Third argument is the merging function
+      if (!args[2]->GetType()->IsFunctionType()) {
+        ReportIncorrectCallArg(call, 2, "function");
+        return;
+      }
+
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::AggHashTableParallelPartitionedScan: {
       if (!CheckArgCount(call, 4)) {
         return;
@@ -760,7 +778,11 @@ void Sema::CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin buil
   }
 
   switch (builtin) {
-    case ast::Builtin::JoinHashTableBuild: {
+    case ast::Builtin::JoinHashTableBuild:
+    case ast::Builtin::JoinHashTableBuildBloomFilter: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
       break;
     }
     case ast::Builtin::JoinHashTableBuildParallel: {
@@ -790,6 +812,46 @@ void Sema::CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin buil
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinJoinHashTableProbeBloomFilter(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 4)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // First argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  // Second argument is the vector projection to probe
+  const auto vector_proj_kind = ast::BuiltinType::VectorProjection;
+  if (!IsPointerToSpecificBuiltin(args[1]->GetType(), vector_proj_kind)) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(vector_proj_kind)->PointerTo());
+    return;
+  }
+
+  // Third argument is the list of TIDs to filter
+  const auto tid_list_kind = ast::BuiltinType::TupleIdList;
+  if (!IsPointerToSpecificBuiltin(args[2]->GetType(), tid_list_kind)) {
+    ReportIncorrectCallArg(call, 2, GetBuiltinType(tid_list_kind)->PointerTo());
+    return;
+  }
+
+  // Fourth argument is a fixed-length uint32 array of key column indexes
+  auto *arr_type = args[3]->GetType()->SafeAs<ast::ArrayType>();
+  if (arr_type == nullptr || !arr_type->GetElementType()->IsSpecificBuiltin(ast::BuiltinType::Uint32) ||
+      !arr_type->HasKnownLength()) {
+    ReportIncorrectCallArg(call, 3, "Fourth argument should be a fixed length uint32 array");
+    return;
+  }
+
+  // This call returns nothing
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinJoinHashTableLookup(ast::CallExpr *call) {
   if (!CheckArgCount(call, 3)) {
     return;
@@ -820,6 +882,89 @@ void Sema::CheckBuiltinJoinHashTableLookup(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::HashTableEntryIterator));
 }
 
+void Sema::CheckBuiltinJoinHashTableSpillCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // First argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableEnableSpilling: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is the size of the probe-side tuples
+      if (!args[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsPartitionSpilled: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::JoinHashTableDeferProbe: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      // Third argument is a pointer to the probe-side tuple
+      if (!args[2]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableProbeSpilled: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // Second and third arguments are opaque query and pipeline state pointers
+      if (!args[1]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
+      if (!args[2]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
+      // Fourth argument is the function joining a deferred probe with its partition
+      if (!args[3]->GetType()->IsFunctionType()) {
+        ReportIncorrectCallArg(call, 3, "function");
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table spill call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinJoinHashTableFree(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -1323,6 +1468,19 @@ void Sema::CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin)
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::TableIterSkipBlocks: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // The second argument is the filter manager whose zone map terms decide which blocks are skipped
+      const auto fm_kind = ast::BuiltinType::FilterManager;
+      if (!IsPointerToSpecificBuiltin(call_args[1]->GetType(), fm_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(fm_kind)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     default: {
       UNREACHABLE("Impossible table iteration call");
     }
@@ -1646,7 +1804,7 @@ void Sema::CheckBuiltinFilterManagerCall(ast::CallExpr *const call, const ast::B
   const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
   switch (builtin) {
     case ast::Builtin::FilterManagerInit: {
-      if (!CheckArgCount(call, 2)) {
+      if (!CheckArgCountAtLeast(call, 2) || (call->NumArgs() > 2 && !CheckArgCount(call, 3))) {
         return;
       }
       // The second argument must be a pointer to the execution context.
@@ -1654,6 +1812,11 @@ void Sema::CheckBuiltinFilterManagerCall(ast::CallExpr *const call, const ast::B
         ReportIncorrectCallArg(call, 1, GetBuiltinType(exec_ctx_kind)->PointerTo());
         return;
       }
+      // The optional third argument is an opaque context pointer handed to every filter clause.
+      if (call->NumArgs() == 3 && !call->Arguments()[2]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
@@ -1678,6 +1841,20 @@ void Sema::CheckBuiltinFilterManagerCall(ast::CallExpr *const call, const ast::B
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::FilterManagerInsertZoneMapTerm: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // The column index, the comparison and the constant are all integers
+      for (uint32_t arg_idx = 1; arg_idx < call->NumArgs(); arg_idx++) {
+        if (!call->Arguments()[arg_idx]->GetType()->IsIntegerType()) {
+          ReportIncorrectCallArg(call, arg_idx, "(*FilterManager, uint32, uint32, int64)->nil");
+          return;
+        }
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::FilterManagerRunFilters: {
       if (!CheckArgCount(call, 3)) {
         return;
@@ -1963,7 +2140,6 @@ void Sema::CheckResultBufferCall(ast::CallExpr *call, ast::Builtin builtin) {
   }
 }
 
-/*
 void Sema::CheckCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCountAtLeast(call, 1)) {
     return;
@@ -1971,33 +2147,49 @@ void Sema::CheckCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin) {
 
   const auto &call_args = call->Arguments();
 
-  // First argument must be a *CSVReader.
   const auto csv_reader = ast::BuiltinType::CSVReader;
-  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), csv_reader)) {
-    ReportIncorrectCallArg(call, 0, GetBuiltinType(csv_reader));
-    return;
-  }
-
   switch (builtin) {
     case ast::Builtin::CSVReaderInit: {
-      if (!CheckArgCount(call, 2)) {
+      if (!CheckArgCount(call, 5)) {
         return;
       }
 
-      // Second argument is either a raw string, or a string representing the
-      // name of the CSV file to read. At this stage, we don't care. It just
-      // needs to be a string.
-      if (!call_args[1]->GetType()->IsStringType()) {
-        ReportIncorrectCallArg(call, 1, GetBuiltinType(csv_reader));
+      // First argument must be a pointer to the execution context, which owns the reader.
+      const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
+      if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), exec_ctx_kind)) {
+        ReportIncorrectCallArg(call, 0, GetBuiltinType(exec_ctx_kind)->PointerTo());
         return;
       }
 
-      // Third, fourth, and fifth must be characters.
+      // Second argument is a string literal with the name of the CSV file to read.
+      if (!call_args[1]->IsStringLiteral()) {
+        ReportIncorrectCallArg(call, 1, ast::StringType::Get(GetContext()));
+        return;
+      }
 
-      // Returns boolean indicating if initialization succeeded.
-      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
-      break;
+      // Third, fourth, and fifth are the delimiter, quote, and escape characters, as integer literals.
+      for (uint32_t i = 2; i < 5; i++) {
+        if (!call_args[i]->IsIntegerLiteral()) {
+          ReportIncorrectCallArg(call, i, "Delimiter, quote, and escape characters should be integer literals.");
+          return;
+        }
+      }
+
+      // Returns the reader.
+      call->SetType(GetBuiltinType(csv_reader)->PointerTo());
+      return;
     }
+    default:
+      break;
+  }
+
+  // First argument must be a *CSVReader.
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), csv_reader)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(csv_reader)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
     case ast::Builtin::CSVReaderAdvance: {
       // Returns a boolean indicating if there's more data.
       call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
@@ -2011,7 +2203,6 @@ void Sema::CheckCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin) {
       if (!call_args[1]->GetType()->IsIntegerType()) {
         ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
       }
-      // Second argument must be the index, third is a pointer to a SQL string.
       const auto string_kind = ast::BuiltinType::StringVal;
       if (!IsPointerToSpecificBuiltin(call_args[2]->GetType(), string_kind)) {
         ReportIncorrectCallArg(call, 2, GetBuiltinType(string_kind)->PointerTo());
@@ -2025,16 +2216,72 @@ void Sema::CheckCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin) {
       call->SetType(GetBuiltinType(ast::BuiltinType::Uint32));
       break;
     }
-    case ast::Builtin::CSVReaderClose: {
-      // Returns nothing.
-      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
-      break;
-    }
     default:
-      UNREACHABLE("Impossible math trig function call");
+      UNREACHABLE("Impossible CSV reader call");
   }
 }
- */
+
+void Sema::CheckCSVScanParCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 8)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // The first argument is a string literal with the name of the CSV file to read.
+  if (!call_args[0]->IsStringLiteral()) {
+    ReportIncorrectCallArg(call, 0, ast::StringType::Get(GetContext()));
+    return;
+  }
+
+  // The second, third, and fourth arguments are the delimiter, quote, and escape characters, as integer literals.
+  for (uint32_t i = 1; i < 4; i++) {
+    if (!call_args[i]->IsIntegerLiteral()) {
+      ReportIncorrectCallArg(call, i, "Delimiter, quote, and escape characters should be integer literals.");
+      return;
+    }
+  }
+
+  // The fifth argument is an opaque query state. For now, check it's a pointer.
+  const auto void_kind = ast::BuiltinType::Nil;
+  if (!call_args[4]->GetType()->IsPointerType()) {
+    ReportIncorrectCallArg(call, 4, GetBuiltinType(void_kind)->PointerTo());
+    return;
+  }
+
+  // The sixth argument must be a pointer to the execution context.
+  const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
+  if (!IsPointerToSpecificBuiltin(call_args[5]->GetType(), exec_ctx_kind)) {
+    ReportIncorrectCallArg(call, 5, GetBuiltinType(exec_ctx_kind)->PointerTo());
+    return;
+  }
+
+  // The seventh argument is the override for number of threads
+  if (!call_args[6]->GetType()->IsIntegerType()) {
+    ReportIncorrectCallArg(call, 6, "Seventh argument should be an integer type.");
+    return;
+  }
+
+  // The eighth argument is the scanner function.
+  auto *scan_fn_type = call_args[7]->GetType()->SafeAs<ast::FunctionType>();
+  if (scan_fn_type == nullptr) {
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelCSVScanFunction, call_args[7]->GetType());
+    return;
+  }
+  // Check the type of the scanner function parameters. See CSVScanner::ScanFn.
+  const auto csv_reader_kind = ast::BuiltinType::CSVReader;
+  const auto &params = scan_fn_type->GetParams();
+  if (params.size() != 3                                                   // Scan function has 3 arguments.
+      || !params[0].type_->IsPointerType()                                 // QueryState, must contain execCtx.
+      || !params[1].type_->IsPointerType()                                 // Thread state.
+      || !IsPointerToSpecificBuiltin(params[2].type_, csv_reader_kind)) {  // CSVReader.
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelCSVScanFunction, call_args[7]->GetType());
+    return;
+  }
+
+  // This builtin does not return a value.
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
 
 void Sema::CheckBuiltinSizeOfCall(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
@@ -2153,6 +2400,37 @@ void Sema::CheckBuiltinSorterInit(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinSorterInitForIndex(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 3)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // First argument must be a pointer to a Sorter
+  const auto sorter_kind = ast::BuiltinType::Sorter;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), sorter_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(sorter_kind)->PointerTo());
+    return;
+  }
+
+  // Second argument must be a pointer to a ExecutionContext
+  const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
+  if (!IsPointerToSpecificBuiltin(args[1]->GetType(), exec_ctx_kind)) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(exec_ctx_kind)->PointerTo());
+    return;
+  }
+
+  // Third and last argument must be the oid of the index whose entries are sorted
+  if (!args[2]->GetType()->IsIntegerType()) {
+    ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Int32));
+    return;
+  }
+
+  // This call returns nothing
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinSorterGetTupleCount(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -2351,6 +2629,112 @@ void Sema::CheckBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin)
   }
 }
 
+void Sema::CheckBuiltinRowBufferCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // First argument must be a pointer to a RowBuffer
+  const auto buffer_kind = ast::BuiltinType::RowBuffer;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), buffer_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(buffer_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::RowBufferInit: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+
+      // Second argument must be a pointer to a ExecutionContext
+      const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), exec_ctx_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(exec_ctx_kind)->PointerTo());
+        return;
+      }
+
+      // Third and last argument must be a 32-bit number representing the row size
+      const auto uint_kind = ast::BuiltinType::Uint32;
+      if (!args[2]->GetType()->IsSpecificBuiltin(uint_kind)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(uint_kind));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::RowBufferInsert: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    case ast::Builtin::RowBufferFinish:
+    case ast::Builtin::RowBufferFree: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible row buffer call");
+    }
+  }
+}
+
+void Sema::CheckBuiltinRowBufferIterCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  const auto iter_kind = ast::BuiltinType::RowBufferIterator;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), iter_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(iter_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::RowBufferIterInit: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+
+      // The second argument is the row buffer to iterate over
+      const auto buffer_kind = ast::BuiltinType::RowBuffer;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), buffer_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(buffer_kind)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::RowBufferIterHasNext: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::RowBufferIterGetRow: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    case ast::Builtin::RowBufferIterNext:
+    case ast::Builtin::RowBufferIterMark:
+    case ast::Builtin::RowBufferIterRewind:
+    case ast::Builtin::RowBufferIterClose: {
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible row buffer iteration call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinIndexIteratorInit(execution::ast::CallExpr *call, ast::Builtin builtin) {
   // First argument must be a pointer to a IndexIterator
   const auto index_kind = ast::BuiltinType::IndexIterator;
@@ -2426,7 +2810,11 @@ void Sema::CheckBuiltinIndexIteratorScan(execution::ast::CallExpr *call, ast::Bu
   }
 
   switch (builtin) {
+    case ast::Builtin::IndexIteratorEnableIndexOnly:
     case ast::Builtin::IndexIteratorScanKey:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorScanKeyBatch:
+    case ast::Builtin::IndexIteratorNextBatchKey:
     case ast::Builtin::IndexIteratorScanDescending: {
       if (!CheckArgCount(call, 1)) return;
       break;
@@ -2497,6 +2885,7 @@ void Sema::CheckBuiltinIndexIteratorPRCall(ast::CallExpr *call, ast::Builtin bui
     case ast::Builtin::IndexIteratorGetLoPR:
     case ast::Builtin::IndexIteratorGetHiPR:
     case ast::Builtin::IndexIteratorGetTablePR:
+    case ast::Builtin::IndexIteratorGetIndexOnlyPR:
       call->SetType(GetBuiltinType(ast::BuiltinType::ProjectedRow)->PointerTo());
       break;
     case ast::Builtin::IndexIteratorGetSlot:
@@ -3058,6 +3447,38 @@ void Sema::CheckBuiltinStorageInterfaceCall(ast::CallExpr *call, ast::Builtin bu
       call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
       break;
     }
+    case ast::Builtin::IndexBulkLoadInsert: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is a sorter
+      auto sorter_type = ast::BuiltinType::Sorter;
+      if (!IsPointerToSpecificBuiltin(call_args[1]->GetType(), sorter_type)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(sorter_type)->PointerTo());
+        return;
+      }
+      // Third argument is a tuple slot
+      auto tuple_slot_type = ast::BuiltinType::TupleSlot;
+      if (!IsPointerToSpecificBuiltin(call_args[2]->GetType(), tuple_slot_type)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(tuple_slot_type)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::IndexBulkLoad: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a sorter
+      auto sorter_type = ast::BuiltinType::Sorter;
+      if (!IsPointerToSpecificBuiltin(call_args[1]->GetType(), sorter_type)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(sorter_type)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
     case ast::Builtin::IndexDelete: {
       if (!CheckArgCount(call, 2)) {
         return;
@@ -3600,7 +4021,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPINumTuples:
     case ast::Builtin::TableIterGetVPI:
-    case ast::Builtin::TableIterClose: {
+    case ast::Builtin::TableIterClose:
+    case ast::Builtin::TableIterSkipBlocks: {
       CheckBuiltinTableIterCall(call, builtin);
       break;
     }
@@ -3691,6 +4113,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     }
     case ast::Builtin::FilterManagerInit:
     case ast::Builtin::FilterManagerInsertFilter:
+    case ast::Builtin::FilterManagerInsertZoneMapTerm:
     case ast::Builtin::FilterManagerRunFilters:
     case ast::Builtin::FilterManagerFree: {
       CheckBuiltinFilterManagerCall(call, builtin);
@@ -3715,6 +4138,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::AggHashTableLookup:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
+    case ast::Builtin::AggHashTableEnableSpilling:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
     case ast::Builtin::AggHashTableFree: {
       CheckBuiltinAggHashTableCall(call, builtin);
@@ -3758,14 +4182,26 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::JoinHashTableBuild:
-    case ast::Builtin::JoinHashTableBuildParallel: {
+    case ast::Builtin::JoinHashTableBuildParallel:
+    case ast::Builtin::JoinHashTableBuildBloomFilter: {
       CheckBuiltinJoinHashTableBuild(call, builtin);
       break;
     }
+    case ast::Builtin::JoinHashTableProbeBloomFilter: {
+      CheckBuiltinJoinHashTableProbeBloomFilter(call);
+      break;
+    }
     case ast::Builtin::JoinHashTableLookup: {
       CheckBuiltinJoinHashTableLookup(call);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableSpilling:
+    case ast::Builtin::JoinHashTableIsPartitionSpilled:
+    case ast::Builtin::JoinHashTableDeferProbe:
+    case ast::Builtin::JoinHashTableProbeSpilled: {
+      CheckBuiltinJoinHashTableSpillCall(call, builtin);
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       CheckBuiltinJoinHashTableFree(call);
       break;
@@ -3787,6 +4223,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSorterInit(call);
       break;
     }
+    case ast::Builtin::SorterInitForIndex: {
+      CheckBuiltinSorterInitForIndex(call);
+      break;
+    }
     case ast::Builtin::SorterGetTupleCount: {
       CheckBuiltinSorterGetTupleCount(call);
       break;
@@ -3816,6 +4256,23 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSorterIterCall(call, builtin);
       break;
     }
+    case ast::Builtin::RowBufferInit:
+    case ast::Builtin::RowBufferInsert:
+    case ast::Builtin::RowBufferFinish:
+    case ast::Builtin::RowBufferFree: {
+      CheckBuiltinRowBufferCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::RowBufferIterInit:
+    case ast::Builtin::RowBufferIterHasNext:
+    case ast::Builtin::RowBufferIterNext:
+    case ast::Builtin::RowBufferIterGetRow:
+    case ast::Builtin::RowBufferIterMark:
+    case ast::Builtin::RowBufferIterRewind:
+    case ast::Builtin::RowBufferIterClose: {
+      CheckBuiltinRowBufferIterCall(call, builtin);
+      break;
+    }
     case ast::Builtin::ResultBufferNew:
     case ast::Builtin::ResultBufferAllocOutRow:
     case ast::Builtin::ResultBufferFinalize:
@@ -3831,7 +4288,11 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinIndexIteratorGetSize(call);
       break;
     }
+    case ast::Builtin::IndexIteratorEnableIndexOnly:
     case ast::Builtin::IndexIteratorScanKey:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorScanKeyBatch:
+    case ast::Builtin::IndexIteratorNextBatchKey:
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitDescending: {
@@ -3846,7 +4307,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorGetLoPR:
     case ast::Builtin::IndexIteratorGetHiPR:
     case ast::Builtin::IndexIteratorGetSlot:
-    case ast::Builtin::IndexIteratorGetTablePR: {
+    case ast::Builtin::IndexIteratorGetTablePR:
+    case ast::Builtin::IndexIteratorGetIndexOnlyPR: {
       CheckBuiltinIndexIteratorPRCall(call, builtin);
       break;
     }
@@ -3854,16 +4316,17 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinIndexIteratorFree(call);
       break;
     }
-      /*
     case ast::Builtin::CSVReaderInit:
     case ast::Builtin::CSVReaderAdvance:
     case ast::Builtin::CSVReaderGetField:
-    case ast::Builtin::CSVReaderGetRecordNumber:
-    case ast::Builtin::CSVReaderClose: {
+    case ast::Builtin::CSVReaderGetRecordNumber: {
       CheckCSVReaderCall(call, builtin);
       break;
     }
-       */
+    case ast::Builtin::CSVScanParallel: {
+      CheckCSVScanParCall(call);
+      break;
+    }
     case ast::Builtin::PRSetBool:
     case ast::Builtin::PRSetTinyInt:
     case ast::Builtin::PRSetSmallInt:
@@ -3918,6 +4381,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexInsert:
     case ast::Builtin::IndexInsertUnique:
     case ast::Builtin::IndexInsertWithSlot:
+    case ast::Builtin::IndexBulkLoadInsert:
+    case ast::Builtin::IndexBulkLoad:
     case ast::Builtin::IndexDelete:
     case ast::Builtin::StorageInterfaceFree: {
       CheckBuiltinStorageInterfaceCall(call, builtin);
@@ -4,8 +4,9 @@
 #include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <memory>
-#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -167,7 +168,10 @@ AggregationHashTable::AggregationHashTable(const exec::ExecutionSettings &exec_s
       partition_tails_(nullptr),
       partition_estimates_(nullptr),
       partition_tables_(nullptr),
-      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)) {
+      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)),
+      spill_check_pending_(false),
+      merge_query_state_(nullptr),
+      is_partition_table_(false) {
   hash_table_.SetSize(initial_size, memory_->GetTracker());
   max_fill_ = std::llround(hash_table_.GetCapacity() * hash_table_.GetLoadFactor());
 
@@ -240,12 +244,26 @@ HashTableEntry *AggregationHashTable::AllocateEntryInternal(const hash_t hash) {
   return entry;
 }
 
-byte *AggregationHashTable::AllocInputTuple(const hash_t hash) {
+byte *AggregationHashTable::AllocInputTuple(const hash_t hash) { return AllocInputTupleInternal(hash, false); }
+
+byte *AggregationHashTable::AllocInputTupleInternal(const hash_t hash, const bool partitioned) {
   stats_.num_inserts_++;
 
-  // Grow if need be
+  // Grow if need be. A serial build over the memory budget spills all its
+  // aggregates to disk instead. This is safe since callers hold no references
+  // to existing aggregates while allocating a new one. Partitioned builds spill
+  // their overflow partitions instead, see SpillIfOverMemoryBudget().
   if (NeedsToGrow()) {
-    Grow();
+    if (!partitioned && !is_partition_table_ && exec_ctx_->IsOverMemoryBudget()) {
+      // Spilled aggregates can only be combined with a merging function.
+      if (merge_partition_fn_ == nullptr) {
+        exec_ctx_->CheckMemoryBudget("Hash aggregation");
+      }
+      FlushToOverflowPartitions();
+      SpillOverflowPartitions();
+    } else {
+      Grow();
+    }
   }
 
   // Allocate an entry
@@ -297,10 +315,109 @@ void AggregationHashTable::FlushToOverflowPartitions() {
 
   // Update stats
   stats_.num_flushes_++;
+  spill_check_pending_ = true;
+}
+
+void AggregationHashTable::SpillIfOverMemoryBudget() {
+  spill_check_pending_ = false;
+  if (exec_ctx_->IsOverMemoryBudget()) {
+    SpillOverflowPartitions();
+  }
+}
+
+void AggregationHashTable::SpillOverflowPartitions() {
+  NOISEPAGE_ASSERT(hash_table_.IsEmpty(), "All entries must be flushed to the overflow partitions before spilling");
+  NOISEPAGE_ASSERT(owned_entries_.empty(), "Only tables that own all their entries can spill them");
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  // Each table appends all its spills to a single file.
+  if (spilled_partitions_.empty()) {
+    auto file = std::make_unique<SpillFile>(exec_settings_.GetSpillFileDirectory(), entries_.ElementSize());
+    spilled_partitions_.push_back(SpilledPartitions{std::move(file), {0}});
+  }
+
+  // Write out each partition in order. Entries are written whole, so that
+  // their hash value is preserved when they're read back.
+  SpilledPartitions &spilled = spilled_partitions_.back();
+  for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+    for (const HashTableEntry *entry = partition_heads_[part_idx]; entry != nullptr; entry = entry->next_) {
+      spilled.file_->Append(reinterpret_cast<const byte *>(entry));
+    }
+    spilled.offsets_.push_back(spilled.file_->GetTupleCount());
+    partition_heads_[part_idx] = partition_tails_[part_idx] = nullptr;
+  }
+
+  // All entries are on disk now. Release their memory, but keep the partition
+  // estimates so tables over the partitions are sized for all their entries.
+  const uint64_t num_spilled = entries_.size();
+  entries_ = decltype(entries_)(entries_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("Spilled {} aggregates to disk in {:.2f} ms", num_spilled, timer.GetElapsed());
+}
+
+bool AggregationHashTable::IsPartitionEmpty(const uint32_t partition_idx) const {
+  if (partition_heads_[partition_idx] != nullptr) {
+    return false;
+  }
+  for (const auto &spilled : spilled_partitions_) {
+    for (uint64_t i = partition_idx; i + 1 < spilled.offsets_.size(); i += DEFAULT_NUM_PARTITIONS) {
+      if (spilled.offsets_[i] != spilled.offsets_[i + 1]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+HashTableEntry *AggregationHashTable::ReadSpilledPartition(const uint32_t partition_idx,
+                                                           AggregationHashTable *target) const {
+  if (!HasSpilled()) {
+    return nullptr;
+  }
+
+  auto &entries = target->owned_entries_.emplace_back(entries_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+  HashTableEntry *head = nullptr;
+  for (const auto &spilled : spilled_partitions_) {
+    for (uint64_t i = partition_idx; i + 1 < spilled.offsets_.size(); i += DEFAULT_NUM_PARTITIONS) {
+      const uint64_t begin = spilled.offsets_[i], end = spilled.offsets_[i + 1];
+      if (begin == end) {
+        continue;
+      }
+      SpillFile::Reader reader(*spilled.file_, begin, end - begin);
+      for (const byte *tuple = reader.Next(); tuple != nullptr; tuple = reader.Next()) {
+        byte *copy = entries.Append();
+        std::memcpy(copy, tuple, entries.ElementSize());
+        auto *entry = reinterpret_cast<HashTableEntry *>(copy);
+        entry->next_ = head;
+        head = entry;
+      }
+    }
+  }
+  return head;
+}
+
+void AggregationHashTable::ReleaseTableOverPartition(const uint32_t partition_idx) {
+  partition_tables_[partition_idx]->~AggregationHashTable();
+  memory_->Deallocate(partition_tables_[partition_idx], sizeof(AggregationHashTable));
+  partition_tables_[partition_idx] = nullptr;
+}
+
+void AggregationHashTable::EnableSpilling(void *query_state, const MergePartitionFn merge_partition_fn) {
+  merge_query_state_ = query_state;
+  merge_partition_fn_ = merge_partition_fn;
 }
 
 byte *AggregationHashTable::AllocInputTuplePartitioned(hash_t hash) {
-  byte *ret = AllocInputTuple(hash);
+  // The caller no longer references entries flushed by its previous insertion,
+  // so they can be spilled now.
+  if (UNLIKELY(spill_check_pending_)) {
+    SpillIfOverMemoryBudget();
+  }
+
+  byte *ret = AllocInputTupleInternal(hash, true);
   if (NeedsToFlushToOverflowPartitions()) {
     FlushToOverflowPartitions();
   }
@@ -501,6 +618,11 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, c
     return;
   }
 
+  // Entries flushed while processing the previous batch can be spilled now.
+  if (partitioned_aggregation && spill_check_pending_) {
+    SpillIfOverMemoryBudget();
+  }
+
   // Initialize the batch state if need be. Note: this is only performed once.
   if (UNLIKELY(batch_state_ == nullptr)) {
     batch_state_ = memory_->MakeObject<BatchProcessState>(
@@ -527,7 +649,9 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, c
       FlushToOverflowPartitions();
     }
   } else {
+    // Aggregates of this batch are still referenced, so they can't be spilled.
     if (NeedsToGrow()) {
+      exec_ctx_->CheckMemoryBudget("Hash aggregation");
       Grow();
     }
   }
@@ -567,6 +691,13 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
     stats_.num_inserts_ += table->stats_.num_inserts_;
     table->FlushToOverflowPartitions();
 
+    // Take over the partitions the table spilled to disk.
+    for (auto &spilled : table->spilled_partitions_) {
+      spilled.file_->Finish();
+      spilled_partitions_.emplace_back(std::move(spilled));
+    }
+    table->spilled_partitions_.clear();
+
     // Now, move over their memory
     owned_entries_.emplace_back(std::move(table->entries_));
 
@@ -595,8 +726,7 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
 AggregationHashTable *AggregationHashTable::GetOrBuildTableOverPartition(void *query_state,
                                                                          const uint32_t partition_idx) {
   NOISEPAGE_ASSERT(partition_idx < DEFAULT_NUM_PARTITIONS, "Out-of-bounds partition access");
-  NOISEPAGE_ASSERT(partition_heads_[partition_idx] != nullptr,
-                   "Should not build aggregation table over empty partition!");
+  NOISEPAGE_ASSERT(!IsPartitionEmpty(partition_idx), "Should not build aggregation table over empty partition!");
   NOISEPAGE_ASSERT(merge_partition_fn_ != nullptr,
                    "Merging function was not provided! Did you forget to call TransferMemoryAndPartitions()?");
 
@@ -609,12 +739,14 @@ AggregationHashTable *AggregationHashTable::GetOrBuildTableOverPartition(void *q
   auto estimated_size = partition_estimates_[partition_idx]->Estimate();
   auto *agg_table = new (memory_->AllocateAligned(sizeof(AggregationHashTable), alignof(AggregationHashTable), false))
       AggregationHashTable(exec_settings_, exec_ctx_, payload_size_, estimated_size);
+  agg_table->is_partition_table_ = true;
 
   util::Timer<std::milli> timer;
   timer.Start();
 
-  // Build it
-  AHTOverflowPartitionIterator iter(partition_heads_ + partition_idx, partition_heads_ + partition_idx + 1);
+  // Build it from the partition's entries in memory and on disk
+  HashTableEntry *heads[] = {partition_heads_[partition_idx], ReadSpilledPartition(partition_idx, agg_table)};
+  AHTOverflowPartitionIterator iter(heads, heads + 2);
   merge_partition_fn_(query_state, agg_table, &iter);
 
   timer.Stop();
@@ -635,11 +767,15 @@ void AggregationHashTable::ExecutePartitionedScan(void *query_state, Aggregation
 
   // Determine the non-empty overflow partitions.
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (!IsPartitionEmpty(part_idx)) {
       // Get or build the table on the partition.
       auto agg_table_partition = GetOrBuildTableOverPartition(query_state, part_idx);
       // Scan the partition.
       scan_fn(query_state, nullptr, agg_table_partition);
+      // A spilled table doesn't fit in memory, so only keep one partition at a time.
+      if (HasSpilled()) {
+        ReleaseTableOverPartition(part_idx);
+      }
     }
   }
 }
@@ -662,7 +798,7 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t i = 0; i < DEFAULT_NUM_PARTITIONS; i++) {
-    if (partition_heads_[i] != nullptr) {
+    if (!IsPartitionEmpty(i)) {
       nonempty_parts.push_back(i);
     }
   }
@@ -675,6 +811,7 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
   size_t concurrent_estimate = std::min(num_threads, num_tasks);
   exec_ctx_->SetNumConcurrentEstimate(concurrent_estimate);
 
+  std::atomic<uint64_t> tuple_count{0};
   tbb::parallel_for_each(nonempty_parts, [&](const uint32_t part_idx) {
     // TODO(wz2): Resource trackers are started and stopped within scan_fn. It might be more correct
     // to start the trackers here manually -- or have TransferMemoryAndPartitions build all the tables
@@ -688,15 +825,17 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
 
     // Scan the partition
     scan_fn(query_state, thread_state, agg_table_partition);
+    tuple_count += agg_table_partition->GetTupleCount();
+
+    // A spilled table doesn't fit in memory, so release partitions once scanned
+    if (HasSpilled()) {
+      ReleaseTableOverPartition(part_idx);
+    }
   });
 
   exec_ctx_->SetNumConcurrentEstimate(0);
   timer.Stop();
 
-  const uint64_t tuple_count =
-      std::accumulate(nonempty_parts.begin(), nonempty_parts.end(), uint64_t{0},
-                      [&](const auto curr, const auto idx) { return curr + partition_tables_[idx]->GetTupleCount(); });
-
   UNUSED_ATTRIBUTE double tps = (tuple_count / timer.GetElapsed()) / 1000.0;
   EXECUTION_LOG_TRACE("Built and scanned {} tables totalling {} tuples in {:.2f} ms ({:.2f} mtps)",
                       nonempty_parts.size(), tuple_count, timer.GetElapsed(), tps);
@@ -710,7 +849,7 @@ void AggregationHashTable::BuildAllPartitions(void *query_state) {
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (!IsPartitionEmpty(part_idx)) {
       nonempty_parts.push_back(part_idx);
     }
   }
@@ -721,6 +860,8 @@ void AggregationHashTable::BuildAllPartitions(void *query_state) {
 }
 
 void AggregationHashTable::Repartition() {
+  NOISEPAGE_ASSERT(!HasSpilled(), "Cannot repartition a spilled table");
+
   // Find all non-empty partitions.
   std::vector<AggregationHashTable *> nonempty_tables;
   nonempty_tables.reserve(DEFAULT_NUM_PARTITIONS);
@@ -752,6 +893,8 @@ void AggregationHashTable::Repartition() {
 
 void AggregationHashTable::MergePartitions(AggregationHashTable *target, void *query_state,
                                            AggregationHashTable::MergePartitionFn merge_func) {
+  NOISEPAGE_ASSERT(!HasSpilled() && !target->HasSpilled(), "Cannot merge the partitions of spilled tables");
+
   if (target->partition_tables_ == nullptr) {
     target->partition_tables_ = memory_->AllocateArray<AggregationHashTable *>(DEFAULT_NUM_PARTITIONS, true);
   }
@@ -779,4 +922,45 @@ void AggregationHashTable::MergePartitions(AggregationHashTable *target, void *q
   target->owned_entries_.emplace_back(std::move(entries_));
 }
 
+//===----------------------------------------------------------------------===//
+//
+// Aggregation Hash Table Iterator
+//
+//===----------------------------------------------------------------------===//
+
+AHTIterator::AHTIterator(AggregationHashTable *agg_table) : agg_table_(agg_table), partition_idx_(0) {
+  if (!agg_table_->HasSpilled()) {
+    iter_.emplace(agg_table_->hash_table_);
+    return;
+  }
+
+  // Move the aggregates still in memory into the overflow partitions, where
+  // they're merged with the spilled aggregates one partition at a time.
+  agg_table_->FlushToOverflowPartitions();
+  for (auto &spilled : agg_table_->spilled_partitions_) {
+    spilled.file_->Finish();
+  }
+  NextPartition();
+}
+
+void AHTIterator::NextPartition() {
+  // Release the table over the partition that was just iterated.
+  if (iter_.has_value() && partition_idx_ < AggregationHashTable::DEFAULT_NUM_PARTITIONS) {
+    iter_.reset();
+    agg_table_->ReleaseTableOverPartition(partition_idx_++);
+  }
+
+  for (; partition_idx_ < AggregationHashTable::DEFAULT_NUM_PARTITIONS; partition_idx_++) {
+    if (!agg_table_->IsPartitionEmpty(partition_idx_)) {
+      auto *table = agg_table_->GetOrBuildTableOverPartition(agg_table_->merge_query_state_, partition_idx_);
+      iter_.emplace(table->hash_table_);
+      NOISEPAGE_ASSERT(iter_->HasNext(), "A non-empty partition must have aggregates");
+      return;
+    }
+  }
+
+  // All partitions have been iterated. The main table is empty.
+  iter_.emplace(agg_table_->hash_table_);
+}
+
 }  // namespace noisepage::execution::sql
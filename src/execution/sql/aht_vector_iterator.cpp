@@ -15,6 +15,8 @@ AHTVectorIterator::AHTVectorIterator(const AggregationHashTable &agg_hash_table,
       iter_(agg_hash_table.hash_table_, memory_),
       vector_projection_(std::make_unique<VectorProjection>()),
       vector_projection_iterator_(std::make_unique<VectorProjectionIterator>()) {
+  NOISEPAGE_ASSERT(!agg_hash_table.HasSpilled(), "Spilled aggregation tables must be iterated through AHTIterator");
+
   // First, initialize the vector projection.
   std::vector<TypeId> col_types;
   col_types.reserve(column_info.size());
@@ -0,0 +1,125 @@
+#include "execution/sql/csv_scanner.h"
+
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/thread_state_container.h"
+#include "execution/util/timer.h"
+#include "loggers/execution_logger.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+
+util::CSVMappedFile *MapFile(exec::ExecutionContext *exec_ctx, std::string_view file_name) {
+  auto *file = exec_ctx->MapCSVFile(file_name);
+  if (file == nullptr) {
+    throw EXECUTION_EXCEPTION(fmt::format("Could not open CSV file '{}'", file_name),
+                              common::ErrorCode::ERRCODE_IO_ERROR);
+  }
+  return file;
+}
+
+class ScanTask {
+ public:
+  ScanTask(const std::vector<util::CSVReader *> &readers, void *const query_state, exec::ExecutionContext *exec_ctx,
+           CSVScanner::ScanFn scanner)
+      : readers_(readers),
+        query_state_(query_state),
+        thread_state_container_(exec_ctx->GetThreadStateContainer()),
+        scanner_(scanner) {}
+
+  void operator()(const tbb::blocked_range<uint32_t> &chunk_range) const {
+    // Pull out the thread-local state
+    byte *const thread_state = thread_state_container_->AccessCurrentThreadState();
+    // Call scanning function on each chunk
+    for (uint32_t i = chunk_range.begin(); i < chunk_range.end(); i++) {
+      scanner_(query_state_, thread_state, readers_[i]);
+    }
+  }
+
+ private:
+  const std::vector<util::CSVReader *> &readers_;
+  void *const query_state_;
+  ThreadStateContainer *const thread_state_container_;
+  CSVScanner::ScanFn scanner_ = nullptr;
+};
+
+}  // namespace
+
+util::CSVReader *CSVScanner::Open(exec::ExecutionContext *exec_ctx, std::string_view file_name, const char delimiter,
+                                  const char quote, const char escape) {
+  const auto *file = MapFile(exec_ctx, file_name);
+  const char *data = file->GetData();
+  return exec_ctx->RetainCSVReader(std::make_unique<util::CSVReader>(
+      std::make_unique<util::CSVMappedChunk>(data, data + file->GetDataSize()), delimiter, quote, escape));
+}
+
+void CSVScanner::ParallelScan(std::string_view file_name, const char delimiter, const char quote, const char escape,
+                              void *const query_state, exec::ExecutionContext *exec_ctx,
+                              const uint32_t num_threads_override, const CSVScanner::ScanFn scan_fn) {
+  // Time
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  const auto *file = MapFile(exec_ctx, file_name);
+
+  size_t num_threads = std::max(exec_ctx->GetExecutionSettings().GetNumberOfParallelExecutionThreads(), 0);
+  if (num_threads_override != 0) {
+    num_threads = num_threads_override;
+  }
+
+  // Split the file into newline-aligned chunks, a few per thread, but none smaller than the minimum chunk size. The
+  // split tokenizes the file in parallel, so it runs on the threads of the scan.
+  tbb::task_arena limited_arena(num_threads);
+  const size_t max_chunks = std::max(file->GetDataSize() / K_MIN_CHUNK_SIZE, size_t{1});
+  std::vector<size_t> offsets;
+  limited_arena.execute([&] {
+    offsets = file->Split(std::min(num_threads * K_CHUNKS_PER_THREAD, max_chunks), delimiter, quote, escape);
+  });
+
+  // The readers are created up front, and are kept by the execution context after the scan
+  std::vector<util::CSVReader *> readers;
+  readers.reserve(offsets.size() - 1);
+  for (size_t i = 0; i + 1 < offsets.size(); i++) {
+    readers.push_back(exec_ctx->RetainCSVReader(std::make_unique<util::CSVReader>(
+        std::make_unique<util::CSVMappedChunk>(file->GetData() + offsets[i], file->GetData() + offsets[i + 1]),
+        delimiter, quote, escape)));
+  }
+
+  // Execute parallel scan
+  const auto num_tasks = static_cast<uint32_t>(readers.size());
+  size_t concurrent = std::min(num_threads, static_cast<size_t>(num_tasks));
+  exec_ctx->SetNumConcurrentEstimate(concurrent);
+
+  tbb::blocked_range<uint32_t> chunk_range(0, num_tasks, 1);
+  const bool is_static_partitioned = exec_ctx->GetExecutionSettings().GetIsStaticPartitionerEnabled();
+  limited_arena.execute([&chunk_range, &readers, &query_state, &exec_ctx, &scan_fn, is_static_partitioned] {
+    is_static_partitioned
+        ? tbb::parallel_for(chunk_range, ScanTask(readers, query_state, exec_ctx, scan_fn), tbb::static_partitioner())
+        : tbb::parallel_for(chunk_range, ScanTask(readers, query_state, exec_ctx, scan_fn));
+  });
+
+  exec_ctx->SetNumConcurrentEstimate(0);
+  timer.Stop();
+
+  auto *tsc = exec_ctx->GetThreadStateContainer();
+  auto *tls = tsc->AccessCurrentThreadState();
+  exec_ctx->InvokeHook(static_cast<uint32_t>(HookOffsets::EndHook), tls, nullptr);
+
+  UNUSED_ATTRIBUTE double mbps = file->GetDataSize() / static_cast<double>(common::Constants::MB) /
+                                 (timer.GetElapsed() / 1000.0);
+  EXECUTION_LOG_TRACE("Scanned CSV file '{}' in {} chunks ({} bytes) in {} ms ({:.3f} MB/s)", file_name, num_tasks,
+                      file->GetDataSize(), timer.GetElapsed(), mbps);
+}
+
+}  // namespace noisepage::execution::sql
@@ -143,6 +143,12 @@ void FilterManager::InsertClauseTerms(const std::vector<MatchFn> &terms) {
   for (auto term : terms) InsertClauseTerm(term);
 }
 
+void FilterManager::InsertClauseZoneMapTerm(const uint32_t col_idx, const ZoneMapComparison comparison,
+                                            const int64_t value) {
+  NOISEPAGE_ASSERT(!clauses_.empty(), "Inserting zone map term without clause");
+  clauses_.back()->AddZoneMapTerm({col_idx, comparison, value});
+}
+
 void FilterManager::RunFilters(exec::ExecutionContext *exec_ctx, VectorProjection *input_batch) {
   // Initialize the input, output, and temporary tuple ID lists for processing
   // this projection. This check just ensures they're all the same shape.
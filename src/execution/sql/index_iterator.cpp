@@ -1,8 +1,13 @@
 #include "execution/sql/index_iterator.h"
 
+#include <cstring>
+
 #include "catalog/catalog_accessor.h"
+#include "common/math_util.h"
 #include "execution/sql/value.h"
+#include "parser/expression/column_value_expression.h"
 #include "storage/sql_table.h"
+#include "storage/storage_util.h"
 
 namespace noisepage::execution::sql {
 
@@ -11,7 +16,8 @@ IndexIterator::IndexIterator(exec::ExecutionContext *exec_ctx, uint32_t num_attr
     : exec_ctx_(exec_ctx),
       num_attrs_(num_attrs),
       col_oids_(col_oids, col_oids + num_oids),
-      index_(exec_ctx_->GetAccessor()->GetIndex(catalog::index_oid_t(index_oid))),
+      index_oid_(index_oid),
+      index_(exec_ctx_->GetAccessor()->GetIndex(index_oid_)),
       table_(exec_ctx_->GetAccessor()->GetTable(catalog::table_oid_t(table_oid))) {}
 
 void IndexIterator::Init() {
@@ -31,29 +37,84 @@ void IndexIterator::Init() {
   hi_index_pr_ = index_pri.InitializeRow(hi_index_buffer_);
 }
 
+void IndexIterator::EnableIndexOnly() {
+  const auto &index_schema = exec_ctx_->GetAccessor()->GetIndexSchema(index_oid_);
+  const auto &key_oid_to_offset = index_->GetKeyOidToOffsetMap();
+  const auto projection_map = table_->ProjectionMapForOids(col_oids_);
+
+  key_attrs_.resize(col_oids_.size());
+  for (const auto &key_col : index_schema.GetColumns()) {
+    const auto expr = key_col.StoredExpression();
+    if (expr->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) continue;
+    const auto col_oid = expr.CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid();
+    const auto table_offset = projection_map.find(col_oid);
+    if (table_offset == projection_map.end()) continue;
+    key_attrs_[table_offset->second] = {key_oid_to_offset.at(key_col.Oid()),
+                                        storage::AttrSizeBytes(key_col.AttributeLength())};
+  }
+  index_only_ = true;
+}
+
 void IndexIterator::ScanKey() {
   // Scan the index
+  keys_.clear();
   tuples_.clear();
   curr_index_ = 0;
   index_->ScanKey(*exec_ctx_->GetTxn(), *index_pr_, &tuples_);
 }
 
+void IndexIterator::AddBatchKey() {
+  NOISEPAGE_ASSERT(!index_only_, "Index-only scans look up a single key");
+  // The PR only holds offsets relative to itself, so a plain copy of its bytes is a valid PR
+  const auto key_words = static_cast<uint32_t>(common::MathUtil::DivRoundUp(index_pr_->Size(), sizeof(uint64_t)));
+  batch_key_buffer_.resize((num_batch_keys_ + 1) * key_words);
+  std::memcpy(&batch_key_buffer_[num_batch_keys_ * key_words], index_pr_, index_pr_->Size());
+  num_batch_keys_++;
+}
+
+void IndexIterator::ScanKeyBatch() {
+  const auto key_words = static_cast<uint32_t>(common::MathUtil::DivRoundUp(index_pr_->Size(), sizeof(uint64_t)));
+  std::vector<const storage::ProjectedRow *> keys(num_batch_keys_);
+  for (uint32_t i = 0; i < num_batch_keys_; i++) {
+    keys[i] = reinterpret_cast<const storage::ProjectedRow *>(&batch_key_buffer_[i * key_words]);
+  }
+  index_->ScanKeyBatch(*exec_ctx_->GetTxn(), keys, &batch_tuples_);
+  num_batch_keys_ = 0;
+  batch_key_idx_ = 0;
+}
+
+void IndexIterator::NextBatchKey() {
+  NOISEPAGE_ASSERT(batch_key_idx_ < batch_tuples_.size(), "Moved past the last key of the batch");
+  tuples_.swap(batch_tuples_[batch_key_idx_++]);
+  curr_index_ = 0;
+}
+
 void IndexIterator::ScanAscending(storage::index::ScanType scan_type, uint32_t limit) {
   // Scan the index
+  keys_.clear();
   tuples_.clear();
   curr_index_ = 0;
+  if (index_only_) {
+    index_->ScanAscendingWithKeys(*exec_ctx_->GetTxn(), scan_type, num_attrs_, index_pr_, hi_index_pr_, limit,
+                                  &tuples_, &keys_);
+    return;
+  }
   index_->ScanAscending(*exec_ctx_->GetTxn(), scan_type, num_attrs_, index_pr_, hi_index_pr_, limit, &tuples_);
 }
 
 void IndexIterator::ScanDescending() {
+  NOISEPAGE_ASSERT(!index_only_, "Index-only scans do not return keys in descending order");
   // Scan the index
+  keys_.clear();
   tuples_.clear();
   curr_index_ = 0;
   index_->ScanDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_);
 }
 
 void IndexIterator::ScanLimitDescending(uint32_t limit) {
+  NOISEPAGE_ASSERT(!index_only_, "Index-only scans do not return keys in descending order");
   // Scan the index
+  keys_.clear();
   tuples_.clear();
   curr_index_ = 0;
   index_->ScanLimitDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_, limit);
@@ -72,6 +133,23 @@ storage::ProjectedRow *IndexIterator::TablePR() {
   return table_pr_;
 }
 
+storage::ProjectedRow *IndexIterator::IndexOnlyPR() {
+  NOISEPAGE_ASSERT(index_only_, "EnableIndexOnly() must come first");
+  const storage::TupleSlot slot = tuples_[curr_index_ - 1];
+  // A tuple in a block that is not all-visible may differ from its key, or not be visible to this transaction
+  if (!slot.GetBlock()->visibility_.AllVisible()) return TablePR();
+
+  const storage::ProjectedRow *key = index_pr_;
+  if (!keys_.empty()) {
+    key = reinterpret_cast<const storage::ProjectedRow *>(&keys_[(curr_index_ - 1) * index_->KeyScanWords()]);
+  }
+  for (uint16_t i = 0; i < key_attrs_.size(); i++) {
+    const auto &[key_offset, size] = key_attrs_[i];
+    storage::StorageUtil::CopyWithNullCheck(key->AccessWithNullCheck(key_offset), table_pr_, size, i);
+  }
+  return table_pr_;
+}
+
 IndexIterator::~IndexIterator() {
   // Free allocated buffers
   exec_ctx_->GetMemoryPool()->Deallocate(table_buffer_, table_pr_->Size());
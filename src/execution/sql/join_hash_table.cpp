@@ -1,20 +1,30 @@
 #include "execution/sql/join_hash_table.h"
 
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/MathExtras.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
 #include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <limits>
+#include <numeric>
 #include <utility>
 #include <vector>
 
+#include "common/math_util.h"
 #include "count/hll.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/memory_pool.h"
 #include "execution/sql/thread_state_container.h"
+#include "execution/sql/tuple_id_list.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_operations/unary_operation_executor.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/sql/vector_projection.h"
 #include "execution/util/cpu_info.h"
 #include "execution/util/memory.h"
 #include "execution/util/timer.h"
@@ -32,28 +42,173 @@ JoinHashTable::JoinHashTable(const exec::ExecutionSettings &exec_settings, exec:
       hll_estimator_(libcount::HLL::Create(DEFAULT_HLL_PRECISION)),
       built_(false),
       use_concise_ht_(use_concise_ht),
-      tracker_(exec_ctx->GetMemoryPool()->GetTracker()) {}
+      num_radix_bits_(0),
+      min_partitioned_build_size_(CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE)),
+      target_partition_size_(CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE)),
+      tracker_(exec_ctx->GetMemoryPool()->GetTracker()),
+      spill_enabled_(false),
+      probe_tuple_size_(0),
+      num_inserts_(0),
+      num_resident_partitions_(NUM_SPILL_PARTITIONS),
+      staged_entries_(HashTableEntry::ComputeEntrySize(tuple_size),
+                      MemoryPoolAllocator<byte>(exec_ctx->GetMemoryPool())),
+      spilled_build_(NUM_SPILL_PARTITIONS),
+      spilled_probes_(NUM_SPILL_PARTITIONS) {}
 
 // Needed because we forward-declared HLL from libcount
 JoinHashTable::~JoinHashTable() = default;
 
 byte *JoinHashTable::AllocInputTuple(const hash_t hash) {
+  // Periodically check the query's memory budget. All previously allocated tuples have been filled
+  // in by now, so they can be written to disk.
+  if (UNLIKELY(++num_inserts_ % MEMORY_BUDGET_CHECK_INTERVAL == 0)) {
+    EnforceMemoryBudget();
+  }
+
   // Add to unique_count estimation
   hll_estimator_->Update(hash);
 
-  // Allocate space for a new tuple
-  auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
+  // Allocate space for a new tuple, staging it if its partition was spilled.
+  auto *entry = reinterpret_cast<HashTableEntry *>(IsPartitionSpilled(hash) ? staged_entries_.Append()
+                                                                             : entries_.Append());
   entry->hash_ = hash;
   entry->next_ = nullptr;
   return entry->payload_;
 }
 
+void JoinHashTable::EnableSpilling(const uint32_t probe_tuple_size) {
+  NOISEPAGE_ASSERT(!UsingConciseHashTable(), "Concise join hash tables cannot spill");
+  spill_enabled_ = true;
+  probe_tuple_size_ = probe_tuple_size;
+}
+
+void JoinHashTable::EnforceMemoryBudget() {
+  FlushStagedTuples();
+
+  if (!exec_ctx_->IsOverMemoryBudget()) {
+    return;
+  }
+
+  // Without spilling, fail the query rather than exhaust the memory of the whole server.
+  if (!spill_enabled_) {
+    exec_ctx_->CheckMemoryBudget("Hash join build");
+  }
+
+  // Spill half the resident partitions. If that isn't enough, more are spilled on the next check.
+  if (num_resident_partitions_ > 0) {
+    SpillPartitions(num_resident_partitions_ / 2);
+  }
+}
+
+void JoinHashTable::FlushStagedTuples() {
+  for (const byte *entry : staged_entries_) {
+    AppendToSpilledPartition(reinterpret_cast<const HashTableEntry *>(entry));
+  }
+  staged_entries_.clear();
+}
+
+void JoinHashTable::SpillPartitions(const uint32_t num_resident_partitions) {
+  NOISEPAGE_ASSERT(num_resident_partitions < num_resident_partitions_, "Spilled partitions cannot be reloaded");
+  NOISEPAGE_ASSERT(!IsBuilt() && owned_.empty(), "Only tables that haven't been built can spill");
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  num_resident_partitions_ = num_resident_partitions;
+
+  // Write out the entries of the newly spilled partitions, and compact the rest into a new vector
+  // so the memory of the spilled entries is released.
+  decltype(entries_) resident(entries_.ElementSize(), MemoryPoolAllocator<byte>(exec_ctx_->GetMemoryPool()));
+  for (const byte *entry : entries_) {
+    const auto *hash_table_entry = reinterpret_cast<const HashTableEntry *>(entry);
+    if (IsPartitionSpilled(hash_table_entry->hash_)) {
+      AppendToSpilledPartition(hash_table_entry);
+    } else {
+      resident.push_back(entry);
+    }
+  }
+  const uint64_t num_spilled = entries_.size() - resident.size();
+  entries_ = std::move(resident);
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("JHT: spilled {} tuples to disk in {:.2f} ms, {} of {} partitions remain in memory",
+                      num_spilled, timer.GetElapsed(), num_resident_partitions_, NUM_SPILL_PARTITIONS);
+}
+
+void JoinHashTable::AppendToSpilledPartition(const HashTableEntry *entry) {
+  auto &files = spilled_build_[SpillPartitionIndex(entry->hash_)];
+  if (files.empty()) {
+    files.push_back(
+        std::make_unique<SpillFile>(exec_settings_.GetSpillFileDirectory(), entries_.ElementSize(), SPILL_BLOCK_SIZE));
+  }
+  files.back()->Append(reinterpret_cast<const byte *>(entry));
+}
+
+void JoinHashTable::FinishSpilledPartitions() {
+  FlushStagedTuples();
+  for (auto &files : spilled_build_) {
+    for (auto &file : files) {
+      file->Finish();
+    }
+  }
+}
+
+void JoinHashTable::DeferProbe(const hash_t hash, const byte *probe_tuple) {
+  NOISEPAGE_ASSERT(IsPartitionSpilled(hash), "Only probes of spilled partitions can be deferred");
+  std::lock_guard<std::mutex> guard(spilled_probes_latch_);
+  auto &file = spilled_probes_[SpillPartitionIndex(hash)];
+  if (file == nullptr) {
+    file = std::make_unique<SpillFile>(exec_settings_.GetSpillFileDirectory(), probe_tuple_size_, SPILL_BLOCK_SIZE);
+  }
+  file->Append(probe_tuple);
+}
+
+void JoinHashTable::ProbeSpilledPartitions(void *const query_state, void *const pipeline_state,
+                                           const ProbeSpilledFn probe_fn) {
+  NOISEPAGE_ASSERT(IsBuilt(), "Spilled partitions can only be probed after the table is built");
+
+  const uint32_t tuple_size = entries_.ElementSize() - HashTableEntry::ComputePayloadOffset();
+  for (uint32_t part_idx = num_resident_partitions_; part_idx < NUM_SPILL_PARTITIONS; part_idx++) {
+    // Partitions that no probe was deferred to produce no output.
+    std::unique_ptr<SpillFile> probes = std::move(spilled_probes_[part_idx]);
+    std::vector<std::unique_ptr<SpillFile>> build_files = std::move(spilled_build_[part_idx]);
+    if (probes == nullptr) {
+      continue;
+    }
+    probes->Finish();
+
+    // Load the partition into a table of its own. It's released before the next one is loaded.
+    JoinHashTable table(exec_settings_, exec_ctx_, tuple_size);
+    for (const auto &file : build_files) {
+      SpillFile::Reader reader(*file, SPILL_BLOCK_SIZE);
+      for (const byte *entry = reader.Next(); entry != nullptr; entry = reader.Next()) {
+        table.entries_.push_back(entry);
+      }
+    }
+    table.Build();
+
+    SpillFile::Reader reader(*probes, SPILL_BLOCK_SIZE);
+    for (const byte *probe_tuple = reader.Next(); probe_tuple != nullptr; probe_tuple = reader.Next()) {
+      probe_fn(query_state, pipeline_state, &table, probe_tuple);
+    }
+
+    EXECUTION_LOG_TRACE("JHT: joined {} deferred probes with {} tuples of spilled partition {}",
+                        probes->GetTupleCount(), table.GetTupleCount(), part_idx);
+  }
+}
+
 void JoinHashTable::BuildChainingHashTable() {
   // Perfectly size the generic hash table in preparation for bulk-load.
-  chaining_hash_table_.SetSize(GetTupleCount(), tracker_);
+  const uint64_t num_tuples = GetTupleCount();
+  chaining_hash_table_.SetSize(num_tuples, tracker_);
 
-  // Bulk-load the, now correctly sized, generic hash table using a non-concurrent algorithm.
-  chaining_hash_table_.InsertBatch<false>(&entries_);
+  if (ShouldPartitionBuild(num_tuples)) {
+    // The build doesn't fit in cache. Partition it so each partition's inserts stay in cache.
+    BuildPartitionedChainingHashTable({&entries_}, nullptr);
+  } else {
+    // Bulk-load the, now correctly sized, generic hash table using a non-concurrent algorithm.
+    chaining_hash_table_.InsertBatch<false>(&entries_);
+  }
 
 #ifndef NDEBUG
   const auto [min, max, avg] = chaining_hash_table_.GetChainLengthStats();
@@ -490,6 +645,171 @@ void JoinHashTable::BuildConciseHashTable() {
   }
 }
 
+namespace {
+
+// An entry shuffled during radix partitioning. The hash is carried alongside the entry pointer so
+// partitioning passes never have to dereference the (likely cache-cold) entry itself.
+struct RadixEntry {
+  hash_t hash_;
+  HashTableEntry *entry_;
+};
+
+// Pointers to the entries of a single buffered entry list clustered by radix partition. The
+// entries of partition 'p' are pointed to by the range [offsets_[p], offsets_[p + 1]) of 'entries_'.
+// The entries themselves are never moved.
+struct RadixPartitionedEntries {
+  explicit RadixPartitionedEntries(MemoryPool *memory) : entries_(memory), offsets_(memory) {}
+  MemPoolVector<HashTableEntry *> entries_;
+  MemPoolVector<uint64_t> offsets_;
+};
+
+// Cluster all entries in 'source' by their radix partition: the 'num_bits' bits of the entry's
+// bucket position (i.e., hash & mask) starting at bit 'shift'. Partitioning happens in passes over
+// at most 'bits_per_pass' bits each, least-significant digit first. Every pass is a stable scatter,
+// so entries are fully clustered after the last pass. Only pointers to the entries are shuffled.
+template <typename Allocator>
+void RadixPartition(util::ChunkedVector<Allocator> *source, const uint64_t mask, const uint32_t shift,
+                    const uint32_t num_bits, const uint32_t bits_per_pass, MemoryPool *memory,
+                    RadixPartitionedEntries *result) {
+  const auto partition_of = [=](const hash_t hash) { return (hash & mask) >> shift; };
+
+  // Gather the entries and build the histogram of final partition sizes.
+  MemPoolVector<RadixEntry> input(source->size(), memory), output(source->size(), memory);
+  result->offsets_.assign((uint64_t{1} << num_bits) + 1, 0);
+  uint64_t idx = 0;
+  for (byte *raw_entry : *source) {
+    auto *entry = reinterpret_cast<HashTableEntry *>(raw_entry);
+    input[idx++] = RadixEntry{entry->hash_, entry};
+    result->offsets_[partition_of(entry->hash_) + 1]++;
+  }
+  std::partial_sum(result->offsets_.begin(), result->offsets_.end(), result->offsets_.begin());
+
+  // Scatter.
+  std::vector<uint64_t> positions;
+  for (uint32_t consumed = 0; consumed < num_bits; consumed += bits_per_pass) {
+    const uint64_t digit_mask = (uint64_t{1} << std::min(bits_per_pass, num_bits - consumed)) - 1;
+    const auto digit_of = [&](const hash_t hash) { return (partition_of(hash) >> consumed) & digit_mask; };
+
+    positions.assign(digit_mask + 1, 0);
+    for (const auto &radix_entry : input) {
+      positions[digit_of(radix_entry.hash_)]++;
+    }
+    for (uint64_t i = 0, sum = 0; i < positions.size(); i++) {
+      sum += std::exchange(positions[i], sum);
+    }
+
+    if (consumed + bits_per_pass >= num_bits) {
+      // The last pass only needs to produce the entry pointers. Release the scatter buffer first.
+      output = MemPoolVector<RadixEntry>(memory);
+      result->entries_.resize(input.size());
+      for (const auto &radix_entry : input) {
+        result->entries_[positions[digit_of(radix_entry.hash_)]++] = radix_entry.entry_;
+      }
+    } else {
+      for (const auto &radix_entry : input) {
+        output[positions[digit_of(radix_entry.hash_)]++] = radix_entry;
+      }
+      input.swap(output);
+    }
+  }
+}
+
+}  // namespace
+
+bool JoinHashTable::ShouldPartitionBuild(const uint64_t num_tuples) const {
+  const uint64_t build_size = num_tuples * entries_.ElementSize() + chaining_hash_table_.GetTotalMemoryUsage();
+  return build_size > min_partitioned_build_size_;
+}
+
+void JoinHashTable::BuildPartitionedChainingHashTable(
+    const std::vector<util::ChunkedVector<MemoryPoolAllocator<byte>> *> &sources,
+    ThreadStateContainer *thread_state_container) {
+  NOISEPAGE_ASSERT(!UsingConciseHashTable(), "Only chaining tables can be built through partitioning");
+  MemoryPool *memory = exec_ctx_->GetMemoryPool();
+  const uint64_t entry_size = entries_.ElementSize();
+
+  uint64_t num_tuples = 0;
+  for (const auto *source : sources) {
+    num_tuples += source->size();
+  }
+
+  // Choose enough partitions so that the directory segment and tuples of each partition fit in L2,
+  // but never more partitions than directory slots.
+  const uint64_t capacity = chaining_hash_table_.GetCapacity();
+  const uint64_t build_size = num_tuples * entry_size + chaining_hash_table_.GetTotalMemoryUsage();
+  const uint64_t num_partitions_needed =
+      common::MathUtil::DivRoundUp(build_size, std::max(target_partition_size_, uint64_t{1}));
+  num_radix_bits_ = std::min({llvm::Log2_64_Ceil(std::max(num_partitions_needed, uint64_t{2})),
+                              llvm::Log2_64(capacity), MAX_RADIX_BITS});
+  const uint64_t num_partitions = uint64_t{1} << num_radix_bits_;
+
+  // The fan-out of a single pass is bounded by the number of TLB entries and L1 cache lines, since
+  // each partition written to in a pass needs both an active page and an active cache line.
+  const auto *cpu_info = CpuInfo::Instance();
+  const uint64_t max_fanout =
+      std::min<uint64_t>(cpu_info->GetTlbEntryCount(), cpu_info->GetCacheSize(CpuInfo::L1_CACHE) /
+                                                           std::max(cpu_info->GetCacheLineSize(CpuInfo::L1_CACHE), 1u));
+  const uint32_t bits_per_pass = std::max(llvm::Log2_64(std::max(max_fanout, uint64_t{2})), 1u);
+  const uint32_t shift = llvm::Log2_64(capacity) - num_radix_bits_;
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  // Phase 1: Cluster each source list by partition.
+  std::vector<RadixPartitionedEntries> partitioned_sources;
+  partitioned_sources.reserve(sources.size());
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    partitioned_sources.emplace_back(memory);
+  }
+  const auto partition_source = [&](const std::size_t idx) {
+    RadixPartition(sources[idx], capacity - 1, shift, num_radix_bits_, bits_per_pass, memory,
+                   &partitioned_sources[idx]);
+  };
+
+  // Phase 2: Insert each partition's tuples where they are buffered. Partitions map to disjoint
+  // ranges of the directory, so they can be inserted concurrently without atomics.
+  const auto build_partition = [&](const uint64_t part) {
+    uint64_t size = 0;
+    for (const auto &partitioned_source : partitioned_sources) {
+      const uint64_t begin = partitioned_source.offsets_[part], end = partitioned_source.offsets_[part + 1];
+      chaining_hash_table_.InsertBatch<false>(partitioned_source.entries_.data() + begin, end - begin);
+      size += end - begin;
+    }
+    return size;
+  };
+
+  if (thread_state_container == nullptr) {
+    for (std::size_t idx = 0; idx < sources.size(); idx++) {
+      partition_source(idx);
+    }
+    for (uint64_t part = 0; part < num_partitions; part++) {
+      build_partition(part);
+    }
+  } else {
+    tbb::parallel_for(std::size_t{0}, sources.size(), partition_source);
+
+    const auto num_threads = static_cast<std::size_t>(tbb::task_scheduler_init::default_num_threads());
+    exec_ctx_->SetNumConcurrentEstimate(std::min<std::size_t>(num_threads, num_partitions));
+    tbb::parallel_for(tbb::blocked_range<uint64_t>(0, num_partitions), [&](const auto &range) {
+      auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+      auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+      auto *tls = thread_state_container->AccessCurrentThreadState();
+      exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+      std::size_t size = 0;
+      for (uint64_t part = range.begin(); part != range.end(); part++) {
+        size += build_partition(part);
+      }
+      exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(size));
+    });
+    exec_ctx_->SetNumConcurrentEstimate(0);
+  }
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("JHT: partitioned {} tuples into {} partitions ({} bits, {} bits/pass) in {:.2f} ms",
+                      num_tuples, num_partitions, num_radix_bits_, bits_per_pass, timer.GetElapsed());
+}
+
 void JoinHashTable::Build() {
   if (IsBuilt()) {
     return;
@@ -497,6 +817,8 @@ void JoinHashTable::Build() {
 
   EXECUTION_LOG_DEBUG("Unique estimate: {}", hll_estimator_->Estimate());
 
+  FinishSpilledPartitions();
+
   util::Timer<> timer;
   timer.Start();
 
@@ -514,15 +836,30 @@ void JoinHashTable::Build() {
   built_ = true;
 }
 
-// TODO(pmenon): Vectorized bloom filter pre-filtering.
-// TODO(pmenon): Implement prefetching.
-
 void JoinHashTable::LookupBatchInChainingHashTable(const Vector &hashes, Vector *results) const {
   UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(
       exec_settings_, hashes,
       results, [&](const hash_t hash_val) noexcept { return chaining_hash_table_.FindChainHead(hash_val); });
 }
 
+void JoinHashTable::LookupBatchInPartitionedHashTable(const Vector &hashes, Vector *results) const {
+  // Partitioned tables are, by construction, larger than the cache, and probes don't arrive in
+  // partition order. Prefetch the directory slots of the whole batch before resolving any of them,
+  // and prefetch each chain head once found since the subsequent key check will read it.
+  VectorOps::ExecTyped<hash_t>(
+      hashes, [&](const hash_t hash_val, uint64_t, uint64_t) {
+        chaining_hash_table_.PrefetchChainHead<true>(hash_val);
+      });
+  UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(
+      exec_settings_, hashes, results, [&](const hash_t hash_val) noexcept {
+        const HashTableEntry *head = chaining_hash_table_.FindChainHead(hash_val);
+        if (head != nullptr) {
+          util::Memory::Prefetch<true, Locality::Low>(head);
+        }
+        return head;
+      });
+}
+
 void JoinHashTable::LookupBatchInConciseHashTable(const Vector &hashes, Vector *results) const {
   UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(
       exec_settings_, hashes, results, [&](const hash_t hash_val) noexcept {
@@ -535,11 +872,63 @@ void JoinHashTable::LookupBatch(const Vector &hashes, Vector *results) const {
   NOISEPAGE_ASSERT(IsBuilt(), "Cannot perform lookup before table is built!");
   if (UsingConciseHashTable()) {
     LookupBatchInConciseHashTable(hashes, results);
+  } else if (UsingPartitionedBuild()) {
+    LookupBatchInPartitionedHashTable(hashes, results);
   } else {
     LookupBatchInChainingHashTable(hashes, results);
   }
 }
 
+void JoinHashTable::BuildBloomFilter() {
+  NOISEPAGE_ASSERT(IsBuilt(), "Bloom filter must be built after the join hash table is built!");
+
+  // The tuples of spilled partitions aren't in memory, and their probes must not be discarded.
+  const uint64_t num_tuples = GetTupleCount();
+  if (HasBloomFilter() || HasSpilled() || num_tuples == 0) {
+    return;
+  }
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  const auto expected_num_elems = std::min(num_tuples, uint64_t{std::numeric_limits<uint32_t>::max()});
+  bloom_filter_.Init(exec_ctx_->GetMemoryPool(), static_cast<uint32_t>(expected_num_elems));
+
+  const auto add_entries = [this](const decltype(entries_) &entries) {
+    for (const byte *entry : entries) {
+      bloom_filter_.Add(reinterpret_cast<const HashTableEntry *>(entry)->hash_);
+    }
+  };
+
+  // If the table was built in parallel, all tuples live in the entry lists taken over from the
+  // thread-local tables. No lock is needed since the table is frozen at this point.
+  if (owned_.empty()) {
+    add_entries(entries_);
+  } else {
+    llvm::for_each(owned_, add_entries);
+  }
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("JHT: built bloom filter over {} tuples in {:.2f} ms. {}", num_tuples, timer.GetElapsed(),
+                      bloom_filter_.DebugString());
+}
+
+void JoinHashTable::ProbeBloomFilter(const VectorProjection &input, TupleIdList *tid_list, const uint32_t *key_cols,
+                                     const uint32_t num_key_cols) const {
+  NOISEPAGE_ASSERT(num_key_cols > 0, "Bloom filter probe must have at least one key column");
+  if (!HasBloomFilter()) {
+    return;
+  }
+
+  // Hash the join keys of the whole batch. The hashes match those computed by @hash() over the same
+  // keys on the build side, which is what the bloom filter was populated with.
+  Vector hashes(TypeId::Hash, true, false);
+  input.Hash(std::vector<uint32_t>(key_cols, key_cols + num_key_cols), &hashes);
+
+  const auto *RESTRICT raw_hashes = reinterpret_cast<const hash_t *>(hashes.GetData());
+  tid_list->Filter([&](const uint64_t i) { return bloom_filter_.Contains(raw_hashes[i]); });
+}
+
 template <bool Concurrent>
 void JoinHashTable::MergeIncomplete(JoinHashTable *source) {
   // TODO(pmenon): Support merging build of concise tables
@@ -563,8 +952,36 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
     hll_estimator_->Merge(jht->hll_estimator_.get());
   }
 
-  // Size the global hash table
+  // All tables must keep the same partitions in memory. Spill the partitions that any thread-local
+  // table spilled from all others, and take over the spilled partitions of every table.
+  for (const auto *jht : tl_join_tables) {
+    num_resident_partitions_ = std::min(num_resident_partitions_, jht->num_resident_partitions_);
+  }
+  if (HasSpilled()) {
+    for (auto *jht : tl_join_tables) {
+      jht->FlushStagedTuples();
+      if (jht->num_resident_partitions_ > num_resident_partitions_) {
+        jht->SpillPartitions(num_resident_partitions_);
+      }
+      jht->FinishSpilledPartitions();
+      for (uint32_t part_idx = 0; part_idx < NUM_SPILL_PARTITIONS; part_idx++) {
+        auto &files = jht->spilled_build_[part_idx];
+        std::move(files.begin(), files.end(), std::back_inserter(spilled_build_[part_idx]));
+        files.clear();
+      }
+    }
+  }
+
+  uint64_t num_tuples = 0;
+  for (const auto *jht : tl_join_tables) {
+    num_tuples += jht->entries_.size();
+  }
+
+  // Size the global hash table. The estimate covers spilled tuples, too.
   uint64_t num_elem_estimate = hll_estimator_->Estimate();
+  if (HasSpilled()) {
+    num_elem_estimate = std::min(num_elem_estimate, num_tuples);
+  }
   chaining_hash_table_.SetSize(num_elem_estimate, tracker_);
 
   // Resize the owned entries vector now to avoid resizing concurrently during
@@ -575,8 +992,23 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
   util::Timer<std::milli> timer;
   timer.Start();
 
-  const bool use_serial_build = num_elem_estimate < DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE;
-  if (use_serial_build) {
+  const bool use_partitioned_build = ShouldPartitionBuild(num_tuples);
+  const bool use_serial_build = !use_partitioned_build && num_elem_estimate < DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE;
+  if (use_partitioned_build) {
+    EXECUTION_LOG_TRACE("JHT: {} buffered elements exceed cache. Using partitioned parallel merge.", num_tuples);
+
+    std::vector<decltype(entries_) *> sources;
+    sources.reserve(tl_join_tables.size());
+    for (auto *jht : tl_join_tables) {
+      sources.push_back(&jht->entries_);
+    }
+    BuildPartitionedChainingHashTable(sources, thread_state_container);
+
+    // The tuples were inserted where they were buffered. Take ownership of the thread-local memory.
+    for (auto *source : sources) {
+      owned_.emplace_back(std::move(*source));
+    }
+  } else if (use_serial_build) {
     // TODO(pmenon): Switch to parallel-mode if estimate is wrong.
     EXECUTION_LOG_TRACE("JHT: Estimated {} elements < {} element parallel threshold. Using serial merge.",
                         num_elem_estimate, DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE);
@@ -614,7 +1046,8 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
 
   UNUSED_ATTRIBUTE const double tps = (chaining_hash_table_.GetElementCount() / timer.GetElapsed()) / 1000.0;
   EXECUTION_LOG_TRACE("JHT: {} merged {} JHTs. Estimated {}, actual {}. Time: {:.2f} ms ({:.2f} mtps)",
-                      use_serial_build ? "Serial" : "Parallel", tl_join_tables.size(), num_elem_estimate,
+                      use_partitioned_build ? "Partitioned" : use_serial_build ? "Serial" : "Parallel",
+                      tl_join_tables.size(), num_elem_estimate,
                       chaining_hash_table_.GetElementCount(), timer.GetElapsed(), tps);
 
   built_ = true;
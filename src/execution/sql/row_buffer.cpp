@@ -0,0 +1,98 @@
+#include "execution/sql/row_buffer.h"
+
+#include <utility>
+
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/util/timer.h"
+#include "loggers/execution_logger.h"
+
+namespace noisepage::execution::sql {
+
+//===----------------------------------------------------------------------===//
+//
+// Row Buffer
+//
+//===----------------------------------------------------------------------===//
+
+RowBuffer::RowBuffer(exec::ExecutionContext *exec_ctx, const uint32_t row_size)
+    : exec_ctx_(exec_ctx),
+      rows_(row_size, MemoryPoolAllocator<byte>(exec_ctx->GetMemoryPool())),
+      num_rows_(0),
+      finished_(false) {}
+
+RowBuffer::~RowBuffer() = default;
+
+byte *RowBuffer::AllocInputRow() {
+  NOISEPAGE_ASSERT(!finished_, "Cannot append to a finished row buffer");
+  // Periodically check whether the query has exceeded its memory budget. Once the buffer has
+  // spilled, the rows appended since the last check are written out instead.
+  if (UNLIKELY(num_rows_ % MEMORY_BUDGET_CHECK_INTERVAL == 0) && !rows_.empty() &&
+      (HasSpilled() || exec_ctx_->IsOverMemoryBudget())) {
+    SpillRows();
+  }
+  num_rows_++;
+  return rows_.Append();
+}
+
+void RowBuffer::SpillRows() {
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  const bool first_spill = !HasSpilled();
+  if (first_spill) {
+    spill_file_ = std::make_unique<SpillFile>(exec_ctx_->GetExecutionSettings().GetSpillFileDirectory(),
+                                              rows_.ElementSize());
+  }
+  for (const byte *row : rows_) {
+    spill_file_->Append(row);
+  }
+
+  if (first_spill) {
+    // Release the memory of all rows buffered so far. Later rows only need a chunk for staging.
+    const uint64_t num_spilled = rows_.size();
+    rows_ = util::ChunkedVector<MemoryPoolAllocator<byte>>(rows_.ElementSize(),
+                                                           MemoryPoolAllocator<byte>(exec_ctx_->GetMemoryPool()));
+    timer.Stop();
+    EXECUTION_LOG_DEBUG("Row buffer spilled {} rows in {} ms", num_spilled, timer.GetElapsed());
+  } else {
+    rows_.clear();
+  }
+}
+
+void RowBuffer::Finish() {
+  if (finished_) {
+    return;
+  }
+  if (HasSpilled()) {
+    SpillRows();
+    spill_file_->Finish();
+  }
+  finished_ = true;
+}
+
+//===----------------------------------------------------------------------===//
+//
+// Row Buffer Iterator
+//
+//===----------------------------------------------------------------------===//
+
+RowBufferIterator::RowBufferIterator(const RowBuffer &buffer) : buffer_(buffer), pos_(0), mark_(0), row_(nullptr) {
+  NOISEPAGE_ASSERT(buffer.finished_, "Row buffer must be finished before reading");
+  if (buffer.HasSpilled()) {
+    reader_ = std::make_unique<SpillFile::Reader>(*buffer.spill_file_);
+  }
+  row_ = FetchRow();
+}
+
+RowBufferIterator::~RowBufferIterator() = default;
+
+void RowBufferIterator::Rewind() {
+  pos_ = mark_;
+  if (reader_ != nullptr) {
+    reader_->Seek(pos_);
+  }
+  row_ = FetchRow();
+}
+
+}  // namespace noisepage::execution::sql
@@ -5,11 +5,14 @@
 #include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <cstring>
 #include <queue>
 #include <utility>
 #include <vector>
 
+#include "common/constants.h"
 #include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/stage_timer.h"
 #include "ips4o/ips4o.hpp"
@@ -32,17 +35,29 @@ Sorter::Sorter(exec::ExecutionContext *exec_ctx, ComparisonFunction cmp_fn, uint
       owned_tuples_(exec_ctx->GetMemoryPool()),
       cmp_fn_(cmp_fn),
       tuples_(exec_ctx->GetMemoryPool()),
+      num_spilled_tuples_(0),
       sorted_(false) {}
 
 Sorter::~Sorter() = default;
 
-byte *Sorter::AllocInputTuple() {
+byte *Sorter::AppendTuple() {
   byte *ret = tuple_storage_.Append();
   tuples_.push_back(ret);
   return ret;
 }
 
-byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTuple(); }
+byte *Sorter::AllocInputTuple() {
+  // Periodically check whether the query has exceeded its memory budget. If it has, move all
+  // buffered tuples to disk. The check happens before allocating so all buffered tuples are whole.
+  if (UNLIKELY(tuples_.size() % MEMORY_BUDGET_CHECK_INTERVAL == 0) && !tuples_.empty() &&
+      exec_ctx_->IsOverMemoryBudget()) {
+    SpillRun();
+  }
+  return AppendTuple();
+}
+
+// Top-K sorters only ever buffer K tuples, so they never spill.
+byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AppendTuple(); }
 
 void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
   // If the number of buffered tuples is less than top_k, we're done.
@@ -107,6 +122,88 @@ void Sorter::HeapSiftDown() {
   tuples_[idx] = top;
 }
 
+void Sorter::SpillRun() {
+  NOISEPAGE_ASSERT(!tuples_.empty(), "Cannot spill an empty run");
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+
+  auto run = std::make_unique<SpillFile>(exec_ctx_->GetExecutionSettings().GetSpillFileDirectory(),
+                                         tuple_storage_.ElementSize());
+  for (const byte *tuple : tuples_) {
+    run->Append(tuple);
+  }
+  run->Finish();
+
+  num_spilled_tuples_ += tuples_.size();
+  spilled_runs_.emplace_back(std::move(run));
+
+  // Release the memory of all buffered tuples.
+  tuples_.clear();
+  tuples_.shrink_to_fit();
+  tuple_storage_ = decltype(tuple_storage_)(tuple_storage_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("Spilled sorted run {} with {} tuples in {} ms", spilled_runs_.size(),
+                      spilled_runs_.back()->GetTupleCount(), timer.GetElapsed());
+}
+
+void Sorter::MergeSpilledRuns() {
+  // The final merge reads every remaining run plus the in-memory tuples. Each intermediate merge of
+  // 'fan_in' runs removes 'fan_in - 1' runs, so merge only as many runs as needed. Merged runs are
+  // appended to the back so that each pass consumes the oldest, shortest runs first.
+  const std::size_t max_runs = MAX_MERGE_FAN_IN - 1;
+  while (spilled_runs_.size() > max_runs) {
+    util::Timer<std::milli> timer;
+    timer.Start();
+
+    const std::size_t fan_in = std::min<std::size_t>(MAX_MERGE_FAN_IN, spilled_runs_.size() - max_runs + 1);
+    std::vector<std::unique_ptr<SpillFile::Reader>> readers;
+    std::vector<const byte *> heads;
+    readers.reserve(fan_in);
+    for (std::size_t i = 0; i < fan_in; i++) {
+      readers.emplace_back(std::make_unique<SpillFile::Reader>(*spilled_runs_[i]));
+      heads.push_back(readers.back()->Next());
+    }
+
+    // Min-heap of the non-exhausted runs, ordered by their head tuple.
+    const auto heap_cmp = [&](const std::size_t l, const std::size_t r) { return cmp_fn_(heads[l], heads[r]) > 0; };
+    std::vector<std::size_t> heap;
+    for (std::size_t i = 0; i < fan_in; i++) {
+      if (heads[i] != nullptr) {
+        heap.push_back(i);
+      }
+    }
+    std::make_heap(heap.begin(), heap.end(), heap_cmp);
+
+    auto merged = std::make_unique<SpillFile>(exec_ctx_->GetExecutionSettings().GetSpillFileDirectory(),
+                                              spilled_runs_.front()->GetTupleSize());
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), heap_cmp);
+      const std::size_t run = heap.back();
+      merged->Append(heads[run]);
+      if ((heads[run] = readers[run]->Next()) != nullptr) {
+        std::push_heap(heap.begin(), heap.end(), heap_cmp);
+      } else {
+        heap.pop_back();
+      }
+    }
+    merged->Finish();
+
+    // The readers reference the runs being replaced, so release them first.
+    readers.clear();
+    spilled_runs_.erase(spilled_runs_.begin(), spilled_runs_.begin() + fan_in);
+    spilled_runs_.emplace_back(std::move(merged));
+
+    timer.Stop();
+    EXECUTION_LOG_DEBUG("Merged {} spilled runs into a run of {} tuples in {} ms", fan_in,
+                        spilled_runs_.back()->GetTupleCount(), timer.GetElapsed());
+  }
+}
+
 void Sorter::Sort() {
   // Exit if the input tuples have already been sorted
   if (IsSorted()) {
@@ -114,7 +211,7 @@ void Sorter::Sort() {
   }
 
   // Exit if there are no input tuples
-  if (tuples_.empty()) {
+  if (IsEmpty()) {
     return;
   }
 
@@ -131,6 +228,12 @@ void Sorter::Sort() {
   UNUSED_ATTRIBUTE double tps = (tuples_.size() / timer.GetElapsed()) / 1000.0;
   EXECUTION_LOG_DEBUG("Sorted {} tuples in {} ms ({:.2f} mtps)", tuples_.size(), timer.GetElapsed(), tps);
 
+  // The in-memory tuples are merged with all spilled runs during iteration
+  if (HasSpilled()) {
+    EXECUTION_LOG_DEBUG("Sorter spilled {} tuples in {} runs", num_spilled_tuples_, spilled_runs_.size());
+    MergeSpilledRuns();
+  }
+
   // Mark complete
   sorted_ = true;
 }
@@ -171,6 +274,46 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
       std::accumulate(tl_sorters.begin(), tl_sorters.end(), uint64_t(0),
                       [](const auto partial, const auto *sorter) { return partial + sorter->GetTupleCount(); });
 
+  // If any thread-local sorter spilled, the tuples can't all be merged in memory. Instead, every
+  // thread-local sorter spills its remaining tuples as a final sorted run, and this sorter takes
+  // ownership of all runs. The runs are merged from disk during iteration.
+
+  if (std::any_of(tl_sorters.begin(), tl_sorters.end(), [](const Sorter *sorter) { return sorter->HasSpilled(); })) {
+    EXECUTION_LOG_DEBUG("Sorter contains {} elements, some of which spilled. Using external sort.", num_tuples);
+
+    {
+      size_t num_threads = tbb::task_scheduler_init::default_num_threads();
+      size_t num_tasks = tl_sorters.size();
+      exec_ctx_->SetNumConcurrentEstimate(std::min(num_threads, num_tasks));
+    }
+
+    tbb::parallel_for_each(tl_sorters, [thread_state_container, this](Sorter *sorter) {
+      auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLSortHook);
+      auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLSortHook);
+      auto *tls = thread_state_container->AccessCurrentThreadState();
+      exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+      if (!sorter->tuples_.empty()) {
+        sorter->SpillRun();
+      }
+
+      exec_ctx_->InvokeHook(post_hook, tls, nullptr);
+    });
+
+    exec_ctx_->SetNumConcurrentEstimate(0);
+
+    for (auto *tl_sorter : tl_sorters) {
+      std::move(tl_sorter->spilled_runs_.begin(), tl_sorter->spilled_runs_.end(), std::back_inserter(spilled_runs_));
+      num_spilled_tuples_ += tl_sorter->num_spilled_tuples_;
+      tl_sorter->spilled_runs_.clear();
+      tl_sorter->num_spilled_tuples_ = 0;
+    }
+    MergeSpilledRuns();
+
+    sorted_ = true;
+    return;
+  }
+
   // If the total number of tuples across **ALL** thread-local sorter instances is less than
   // kMinTuplesForParallelSort, we execute a single-threaded sort. Parallel sorting fewer than this
   // threshold is slower due to the overhead of statistics collection and spawning sort and merge
@@ -425,21 +568,156 @@ void Sorter::SortTopKParallel(ThreadStateContainer *thread_state_container, uint
   // Parallel sort
   SortParallel(thread_state_container, sorter_offset);
 
-  // Trim to top-K
+  // Trim to top-K. Top-K sorters never spill, so all tuples are in memory.
+  NOISEPAGE_ASSERT(!HasSpilled(), "Top-K sorters should never spill");
   if (top_k < GetTupleCount()) {
     tuples_.resize(top_k);
   }
 }
 
+//===----------------------------------------------------------------------===//
+//
+// Sorted Run Merger
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * Produces the tuples of a sorter that has spilled in sorted order by performing a k-way merge of
+ * all spilled runs and the sorter's sorted in-memory tuples. Runs are streamed from disk one block
+ * at a time. Rows read from disk are copied into a ring of output slots so that each returned row
+ * remains valid for the next common::Constants::K_DEFAULT_VECTOR_SIZE advancements, which allows
+ * vectorized iterators to gather a full vector of rows before using them.
+ */
+class SortedRunMerger {
+  using IteratorType = decltype(Sorter::tuples_)::const_iterator;
+
+ public:
+  explicit SortedRunMerger(const Sorter &sorter)
+      : cmp_fn_(sorter.cmp_fn_),
+        tuple_size_(sorter.spilled_runs_.front()->GetTupleSize()),
+        mem_iter_(sorter.tuples_.begin()),
+        mem_end_(sorter.tuples_.end()),
+        ring_(std::make_unique<byte[]>(tuple_size_ * common::Constants::K_DEFAULT_VECTOR_SIZE)),
+        ring_pos_(0),
+        current_(nullptr),
+        remaining_(sorter.GetTupleCount()) {
+    NOISEPAGE_ASSERT(sorter.IsSorted(), "Sorter must be sorted before iteration");
+
+    // Position each source at its first tuple.
+    readers_.reserve(sorter.spilled_runs_.size());
+    for (const auto &run : sorter.spilled_runs_) {
+      readers_.emplace_back(std::make_unique<SpillFile::Reader>(*run));
+      heads_.push_back(readers_.back()->Next());
+    }
+    heads_.push_back(mem_iter_ != mem_end_ ? *mem_iter_ : nullptr);
+
+    for (uint32_t source = 0; source < heads_.size(); source++) {
+      if (heads_[source] != nullptr) {
+        heap_.push_back(source);
+      }
+    }
+    std::make_heap(heap_.begin(), heap_.end(), HeapCompare{this});
+
+    Advance();
+  }
+
+  bool HasNext() const { return current_ != nullptr; }
+
+  void Next() {
+    remaining_--;
+    Advance();
+  }
+
+  const byte *GetRow() const { return current_; }
+
+  uint64_t NumRemaining() const { return remaining_; }
+
+ private:
+  // Orders sources such that the source with the smallest head tuple is at the top of the heap.
+  struct HeapCompare {
+    const SortedRunMerger *merger_;
+    bool operator()(const uint32_t l, const uint32_t r) const {
+      return merger_->cmp_fn_(merger_->heads_[l], merger_->heads_[r]) > 0;
+    }
+  };
+
+  // Pop the smallest tuple from all sources, making it the current row.
+  void Advance() {
+    if (heap_.empty()) {
+      current_ = nullptr;
+      return;
+    }
+
+    std::pop_heap(heap_.begin(), heap_.end(), HeapCompare{this});
+    const uint32_t source = heap_.back();
+    heap_.pop_back();
+
+    if (source == readers_.size()) {
+      // In-memory tuples are stable.
+      current_ = heads_[source];
+      ++mem_iter_;
+      heads_[source] = mem_iter_ != mem_end_ ? *mem_iter_ : nullptr;
+    } else {
+      // Tuples read from disk are only valid until the next read, so copy it out.
+      byte *slot = ring_.get() + ring_pos_ * tuple_size_;
+      std::memcpy(slot, heads_[source], tuple_size_);
+      ring_pos_ = (ring_pos_ + 1) % common::Constants::K_DEFAULT_VECTOR_SIZE;
+      current_ = slot;
+      heads_[source] = readers_[source]->Next();
+    }
+
+    if (heads_[source] != nullptr) {
+      heap_.push_back(source);
+      std::push_heap(heap_.begin(), heap_.end(), HeapCompare{this});
+    }
+  }
+
+ private:
+  // The comparison function
+  Sorter::ComparisonFunction cmp_fn_;
+  // The size of each tuple
+  std::size_t tuple_size_;
+  // Readers over each spilled run
+  std::vector<std::unique_ptr<SpillFile::Reader>> readers_;
+  // The current and ending position in the in-memory tuples
+  IteratorType mem_iter_, mem_end_;
+  // The head tuple of each source; the last source is the in-memory tuples. NULL if exhausted.
+  std::vector<const byte *> heads_;
+  // A min-heap of non-exhausted sources ordered by their head tuple
+  std::vector<uint32_t> heap_;
+  // The ring of output slots for rows read from disk, and the next slot to use
+  std::unique_ptr<byte[]> ring_;
+  uint32_t ring_pos_;
+  // The current row
+  const byte *current_;
+  // The number of rows remaining, including the current row
+  uint64_t remaining_;
+};
+
 //===----------------------------------------------------------------------===//
 //
 // Sorter Iterator
 //
 //===----------------------------------------------------------------------===//
 
-SorterIterator::SorterIterator(const Sorter &sorter) : iter_(sorter.tuples_.begin()), end_(sorter.tuples_.end()) {}
+SorterIterator::SorterIterator(const Sorter &sorter)
+    : iter_(sorter.tuples_.begin()),
+      end_(sorter.tuples_.end()),
+      merger_(sorter.HasSpilled() ? std::make_unique<SortedRunMerger>(sorter) : nullptr) {}
+
+SorterIterator::~SorterIterator() = default;
+
+uint64_t SorterIterator::NumRemaining() const {
+  return merger_ == nullptr ? std::distance(iter_, end_) : merger_->NumRemaining();
+}
 
 void SorterIterator::AdvanceBy(uint64_t n) {
+  if (merger_ != nullptr) {
+    for (; n > 0 && merger_->HasNext(); n--) {
+      merger_->Next();
+    }
+    return;
+  }
   if (n > NumRemaining()) {
     iter_ = end_;
     return;
@@ -447,4 +725,10 @@ void SorterIterator::AdvanceBy(uint64_t n) {
   iter_ += n;
 }
 
+bool SorterIterator::HasNextMerged() const { return merger_->HasNext(); }
+
+void SorterIterator::NextMerged() { merger_->Next(); }
+
+const byte *SorterIterator::GetRowMerged() const { return merger_->GetRow(); }
+
 }  // namespace noisepage::execution::sql
@@ -0,0 +1,121 @@
+#include "execution/sql/spill_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+
+// Round the block size down to a multiple of the tuple size, leaving room for at least one tuple.
+std::size_t ComputeBufferSize(const std::size_t tuple_size, const std::size_t block_size) {
+  return std::max(block_size / tuple_size, std::size_t{1}) * tuple_size;
+}
+
+[[noreturn]] void ThrowIOError(const char *action, const int saved_errno) {
+  const auto code =
+      saved_errno == ENOSPC ? common::ErrorCode::ERRCODE_DISK_FULL : common::ErrorCode::ERRCODE_IO_ERROR;
+  throw EXECUTION_EXCEPTION(fmt::format("Could not {} spill file: {}", action, std::strerror(saved_errno)), code);
+}
+
+}  // namespace
+
+//===----------------------------------------------------------------------===//
+//
+// Spill File
+//
+//===----------------------------------------------------------------------===//
+
+SpillFile::SpillFile(const std::string &directory, const std::size_t tuple_size, const std::size_t block_size)
+    : tuple_size_(tuple_size),
+      buffer_size_(ComputeBufferSize(tuple_size, block_size)),
+      buffer_(std::make_unique<byte[]>(buffer_size_)),
+      buffer_pos_(buffer_.get()),
+      buffer_end_(buffer_.get() + buffer_size_),
+      file_size_(0),
+      num_tuples_(0),
+      finished_(false) {
+  NOISEPAGE_ASSERT(tuple_size > 0, "Spilled tuples must have a non-zero size");
+  file_.CreateTemp(true, directory);
+  if (file_.HasError()) {
+    throw EXECUTION_EXCEPTION(fmt::format("Could not create spill file in '{}': {}", directory,
+                                          util::File::ErrorToString(file_.GetErrorIndicator())),
+                              common::ErrorCode::ERRCODE_IO_ERROR);
+  }
+}
+
+SpillFile::~SpillFile() = default;
+
+void SpillFile::FlushBuffer() {
+  const std::size_t len = buffer_pos_ - buffer_.get();
+  if (len == 0) {
+    return;
+  }
+  if (file_.WriteFull(buffer_.get(), len) != static_cast<int32_t>(len)) {
+    ThrowIOError("write", errno);
+  }
+  file_size_ += len;
+  buffer_pos_ = buffer_.get();
+}
+
+void SpillFile::Finish() {
+  if (finished_) {
+    return;
+  }
+  FlushBuffer();
+  buffer_.reset();
+  buffer_pos_ = buffer_end_ = nullptr;
+  finished_ = true;
+}
+
+//===----------------------------------------------------------------------===//
+//
+// Spill File Reader
+//
+//===----------------------------------------------------------------------===//
+
+SpillFile::Reader::Reader(const SpillFile &file, const std::size_t block_size)
+    : Reader(file, 0, file.num_tuples_, block_size) {}
+
+SpillFile::Reader::Reader(const SpillFile &file, const uint64_t first_tuple, const uint64_t num_tuples,
+                          const std::size_t block_size)
+    : file_(file),
+      buffer_size_(ComputeBufferSize(file.tuple_size_, std::min(block_size, num_tuples * file.tuple_size_))),
+      buffer_(std::make_unique<byte[]>(buffer_size_)),
+      buffer_pos_(buffer_.get()),
+      buffer_end_(buffer_.get()),
+      file_offset_(first_tuple * file.tuple_size_),
+      end_offset_((first_tuple + num_tuples) * file.tuple_size_) {
+  NOISEPAGE_ASSERT(file.finished_, "Spill file must be finished before reading");
+  NOISEPAGE_ASSERT(first_tuple + num_tuples <= file.num_tuples_, "Tuple range is outside the spill file");
+}
+
+void SpillFile::Reader::Seek(const uint64_t tuple_idx) {
+  const std::size_t offset = tuple_idx * file_.tuple_size_;
+  NOISEPAGE_ASSERT(offset <= end_offset_, "Cannot seek past the end of the reader's range");
+  // The buffer holds the tuples just before the file offset of the next unbuffered tuple.
+  const std::size_t buffer_start = file_offset_ - (buffer_end_ - buffer_.get());
+  if (offset >= buffer_start && offset < file_offset_) {
+    buffer_pos_ = buffer_.get() + (offset - buffer_start);
+    return;
+  }
+  file_offset_ = offset;
+  buffer_pos_ = buffer_end_ = buffer_.get();
+}
+
+void SpillFile::Reader::FillBuffer() {
+  const std::size_t len = std::min(buffer_size_, end_offset_ - file_offset_);
+  if (file_.file_.ReadFullFromPosition(file_offset_, buffer_.get(), len) != static_cast<int32_t>(len)) {
+    ThrowIOError("read", errno);
+  }
+  file_offset_ += len;
+  buffer_pos_ = buffer_.get();
+  buffer_end_ = buffer_.get() + len;
+}
+
+}  // namespace noisepage::execution::sql
@@ -5,6 +5,7 @@
 
 #include "catalog/catalog_accessor.h"
 #include "execution/exec/execution_context.h"
+#include "execution/sql/sorter.h"
 #include "execution/util/execution_common.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
@@ -98,4 +99,21 @@ bool StorageInterface::IndexInsertWithTuple(storage::TupleSlot table_tuple_slot,
   return curr_index_->Insert(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
 }
 
+void StorageInterface::IndexBulkLoadInsert(Sorter *sorter, storage::TupleSlot table_tuple_slot) {
+  NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
+  curr_index_->SetBulkLoadEntry(*index_pr_, table_tuple_slot, sorter->AllocInputTuple());
+}
+
+bool StorageInterface::IndexBulkLoad(const Sorter &sorter) {
+  NOISEPAGE_ASSERT(curr_index_ != nullptr, "Index must have been loaded");
+  SorterIterator iter(sorter);
+  bool started = false;
+  // Rows of a sorter that spilled stay valid for a few advances, so each entry lives until the next one is asked for
+  return curr_index_->BulkLoad(exec_ctx_->GetTxn(), [&]() -> const byte * {
+    if (started) iter.Next();
+    started = true;
+    return iter.HasNext() ? iter.GetRow() : nullptr;
+  });
+}
+
 }  // namespace noisepage::execution::sql
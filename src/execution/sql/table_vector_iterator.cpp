@@ -2,16 +2,22 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/task_arena.h>
+#include <tbb/task_group.h>
 #include <tbb/task_scheduler_init.h>
+#include <tbb/task_scheduler_observer.h>
 
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
+#include "common/numa_util.h"
 #include "execution/exec/execution_context.h"
 #include "execution/exec/execution_settings.h"
+#include "execution/sql/filter_manager.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/timer.h"
 #include "loggers/execution_logger.h"
@@ -77,6 +83,23 @@ bool TableVectorIterator::InitTempTable(common::ManagedPointer<storage::SqlTable
   return Init(cte_table, schema, 0, storage::DataTable::GetMaxBlocks());
 }
 
+void TableVectorIterator::SkipBlocks(const FilterManager *filter) {
+  NOISEPAGE_ASSERT(IsInitialized(), "Blocks can only be skipped once the iterator is initialized");
+  if (!filter->HasZoneMapTerms()) {
+    return;
+  }
+  block_filter_ = filter;
+  iter_->SetBlockFilter(&TableVectorIterator::BlockMayMatch, this);
+}
+
+bool TableVectorIterator::BlockMayMatch(const void *iter, storage::RawBlock *block) {
+  const auto *self = reinterpret_cast<const TableVectorIterator *>(iter);
+  const storage::DataTable &data_table = *self->table_->table_.data_table_;
+  const auto &col_ids = self->vector_projection_.ColumnIds();
+  return self->block_filter_->MayMatch(
+      [&](const uint32_t col_idx) -> const storage::ZoneMap & { return data_table.GetZoneMap(block, col_ids[col_idx]); });
+}
+
 bool TableVectorIterator::Advance() {
   // Cannot advance if not initialized.
   if (!IsInitialized()) {
@@ -134,6 +157,76 @@ class ScanTask {
   TableVectorIterator::ScanFn scanner_ = nullptr;
 };
 
+/** Pins the threads of an arena to the CPUs of a NUMA node while they work in the arena. */
+class NodePinningObserver : public tbb::task_scheduler_observer {
+ public:
+  NodePinningObserver(tbb::task_arena *arena, uint32_t node) : tbb::task_scheduler_observer(*arena), node_(node) {
+    observe(true);
+  }
+
+  ~NodePinningObserver() override { observe(false); }
+
+  void on_scheduler_entry(bool) override { common::NumaUtil::PinThreadToNode(node_); }
+
+  void on_scheduler_exit(bool) override { common::NumaUtil::UnpinThread(); }
+
+ private:
+  const uint32_t node_;
+};
+
+/**
+ * Split the blocks into ranges of at most @em min_grain_size consecutive blocks on the same NUMA node.
+ * @return The ranges of blocks of each node.
+ */
+std::vector<std::vector<tbb::blocked_range<uint32_t>>> BlockRangesByNode(const std::vector<storage::RawBlock *> &blocks,
+                                                                         const uint32_t min_grain_size) {
+  std::vector<std::vector<tbb::blocked_range<uint32_t>>> ranges(common::NumaUtil::NumNodes());
+  uint32_t range_start = 0;
+  for (uint32_t i = 1; i <= blocks.size(); i++) {
+    const uint32_t node = storage::BlockStore::NodeOf(blocks[range_start]);
+    if (i == blocks.size() || i - range_start == min_grain_size || storage::BlockStore::NodeOf(blocks[i]) != node) {
+      ranges[node].emplace_back(range_start, i);
+      range_start = i;
+    }
+  }
+  return ranges;
+}
+
+/**
+ * Scan the blocks of each NUMA node with threads pinned to that node. Each node gets its own arena with a share of the
+ * threads, and the nodes are scanned concurrently.
+ */
+void NumaLocalScan(const std::vector<std::vector<tbb::blocked_range<uint32_t>>> &node_ranges, const ScanTask &task,
+                   const size_t num_threads, const bool is_static_partitioned) {
+  struct NodeScan {
+    NodeScan(int concurrency, uint32_t node) : arena_(concurrency, 0), observer_(&arena_, node) {}
+    tbb::task_arena arena_;
+    NodePinningObserver observer_;
+    tbb::task_group group_;
+  };
+
+  const auto num_nodes = static_cast<size_t>(
+      std::count_if(node_ranges.begin(), node_ranges.end(), [](const auto &ranges) { return !ranges.empty(); }));
+  const auto threads_per_node = static_cast<int>(std::max<size_t>(num_threads / num_nodes, 1));
+  std::vector<std::unique_ptr<NodeScan>> scans;
+  for (uint32_t node = 0; node < node_ranges.size(); node++) {
+    if (node_ranges[node].empty()) continue;
+    auto &scan = *scans.emplace_back(std::make_unique<NodeScan>(threads_per_node, node));
+    const auto &ranges = node_ranges[node];
+    scan.arena_.execute([&scan, &ranges, &task, is_static_partitioned] {
+      scan.group_.run([&ranges, &task, is_static_partitioned] {
+        const auto scan_ranges = [&ranges, &task](const tbb::blocked_range<size_t> &indexes) {
+          for (size_t i = indexes.begin(); i < indexes.end(); i++) task(ranges[i]);
+        };
+        tbb::blocked_range<size_t> indexes(0, ranges.size(), 1);
+        is_static_partitioned ? tbb::parallel_for(indexes, scan_ranges, tbb::static_partitioner())
+                              : tbb::parallel_for(indexes, scan_ranges);
+      });
+    });
+  }
+  for (auto &scan : scans) scan->arena_.execute([&scan] { scan->group_.wait(); });
+}
+
 }  // namespace
 
 bool TableVectorIterator::ParallelScan(uint32_t table_oid, uint32_t *col_oids, uint32_t num_oids,
@@ -160,16 +253,27 @@ bool TableVectorIterator::ParallelScan(uint32_t table_oid, uint32_t *col_oids, u
   size_t concurrent = std::min(num_threads, num_tasks);
   exec_ctx->SetNumConcurrentEstimate(concurrent);
 
-  tbb::task_arena limited_arena(num_threads);
-  tbb::blocked_range<uint32_t> block_range(0, table->table_.data_table_->GetNumBlocks(), min_grain_size);
   const bool is_static_partitioned = exec_ctx->GetExecutionSettings().GetIsStaticPartitionerEnabled();
-  limited_arena.execute(
-      [&block_range, &table_oid, &col_oids, &num_oids, &query_state, &exec_ctx, &scan_fn, is_static_partitioned] {
-        is_static_partitioned
-            ? tbb::parallel_for(block_range, ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn),
-                                tbb::static_partitioner())
-            : tbb::parallel_for(block_range, ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn));
-      });
+  // With the blocks of the table on more than one NUMA node, every node's blocks are scanned by threads on that node
+  std::vector<std::vector<tbb::blocked_range<uint32_t>>> node_ranges;
+  if (common::NumaUtil::NumNodes() > 1) {
+    node_ranges = BlockRangesByNode(table->table_.data_table_->GetBlocks(), min_grain_size);
+  }
+  if (std::count_if(node_ranges.begin(), node_ranges.end(), [](const auto &ranges) { return !ranges.empty(); }) > 1) {
+    NumaLocalScan(node_ranges, ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn), num_threads,
+                  is_static_partitioned);
+  } else {
+    tbb::task_arena limited_arena(num_threads);
+    tbb::blocked_range<uint32_t> block_range(0, table->table_.data_table_->GetNumBlocks(), min_grain_size);
+    limited_arena.execute(
+        [&block_range, &table_oid, &col_oids, &num_oids, &query_state, &exec_ctx, &scan_fn, is_static_partitioned] {
+          is_static_partitioned
+              ? tbb::parallel_for(block_range, ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn),
+                                  tbb::static_partitioner())
+              : tbb::parallel_for(block_range,
+                                  ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn));
+        });
+  }
 
   exec_ctx->SetNumConcurrentEstimate(0);
   timer.Stop();
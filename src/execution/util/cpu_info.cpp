@@ -144,6 +144,12 @@ void CpuInfo::InitCpuInfo() {
       physical_cores.insert(core_id);
     } else if (name.startswith("flags")) {
       ParseCpuFlags(value);
+    } else if (name.startswith("TLB size")) {
+      // Only reported on some CPUs, e.g., "TLB size : 3072 4K pages".
+      uint32_t tlb_entries = 0;
+      if (!value.split(' ').first.getAsInteger(10, tlb_entries) && tlb_entries > 0) {
+        tlb_entries_ = tlb_entries;
+      }
     }
   }
 
@@ -198,6 +204,7 @@ std::string CpuInfo::PrettyPrintInfo() const {
   ss << "    L1: " << (cache_sizes_[L1_CACHE] / 1024.0) << " KB (" << cache_line_sizes_[L1_CACHE] << " byte line)" << std::endl;  // NOLINT
   ss << "    L2: " << (cache_sizes_[L2_CACHE] / 1024.0) << " KB (" << cache_line_sizes_[L2_CACHE] << " byte line)" << std::endl;  // NOLINT
   ss << "    L3: " << (cache_sizes_[L3_CACHE] / 1024.0) << " KB (" << cache_line_sizes_[L3_CACHE] << " byte line)" << std::endl;  // NOLINT
+  ss << "  TLB:        " << tlb_entries_ << " entries" << std::endl;
   // clang-format on
 
   ss << "Features: ";
@@ -1,9 +1,18 @@
-// #include "execution/util/csv_reader.h" Fix later.
-#if 0
-#include <immintrin.h>
+#include "execution/util/csv_reader.h"
 
+#include <fcntl.h>
+#include <immintrin.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
 #include <cstring>
 
+#include "common/math_util.h"
 #include "fast_float/fast_float.h"
 #include "loggers/execution_logger.h"
 
@@ -67,6 +76,199 @@ bool CSVFile::Fill() {
   return read_pos_ < end_pos_;
 }
 
+//===----------------------------------------------------------------------===//
+//
+// CSV Mapped File Source
+//
+//===----------------------------------------------------------------------===//
+
+CSVMappedFile::CSVMappedFile(std::string_view path) : path_(path) {}
+
+CSVMappedFile::~CSVMappedFile() {
+  if (data_ != nullptr) munmap(data_, mapping_size_);
+}
+
+bool CSVMappedFile::Initialize() {
+  const int fd = open(path_.c_str(), O_RDONLY);
+  if (fd == -1) {
+    EXECUTION_LOG_ERROR("Error opening CSV '{}': {}", path_, strerror(errno));
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    EXECUTION_LOG_ERROR("Error reading size of CSV '{}': {}", path_, strerror(errno));
+    close(fd);
+    return false;
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+
+  // Reserve room for the file, a new line and the tail padding in anonymous memory, which is zeroed, and then map the
+  // file over the start of it. The mapping is private and writable so that the new line can be added in place.
+
+  const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  mapping_size_ = common::MathUtil::AlignTo(size_ + 1 + NUM_EXTRA_PADDING_CHARS, page_size);
+  void *region = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (region == MAP_FAILED) {
+    EXECUTION_LOG_ERROR("Error mapping CSV '{}': {}", path_, strerror(errno));
+    close(fd);
+    return false;
+  }
+  if (size_ > 0 && mmap(region, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+    EXECUTION_LOG_ERROR("Error mapping CSV '{}': {}", path_, strerror(errno));
+    munmap(region, mapping_size_);
+    close(fd);
+    return false;
+  }
+  close(fd);
+
+  data_ = reinterpret_cast<char *>(region);
+
+  if (size_ > 0 && data_[size_ - 1] != '\n' && data_[size_ - 1] != '\r') data_[size_++] = '\n';
+
+  return true;
+}
+
+void CSVMappedFile::Consume(const std::size_t n) {
+  NOISEPAGE_ASSERT(read_pos_ + n <= size_, "Buffer overflow!");
+  read_pos_ += n;
+}
+
+namespace {
+
+/**
+ * Find the start of the first row after a position, assuming the position is in the middle of a quoted or an unquoted
+ * cell. The cells are tokenized the way CSVReader::TryParse() does, one character at a time.
+ * @return The start of the row, or @em end if no row ends before it.
+ */
+std::size_t FindRowStart(const char *const data, std::size_t pos, const std::size_t end, const bool quoted,
+                         const char delimiter, const char quote, const char escape) {
+  enum class State : uint8_t { CellStart, Unquoted, Quoted, AfterQuote };
+  State state = quoted ? State::Quoted : State::Unquoted;
+  for (; pos < end; pos++) {
+    const char c = data[pos];
+    if (state == State::Quoted) {
+      if (c == quote || c == escape) state = State::AfterQuote;
+      continue;
+    }
+    // A carriage return followed by a new line ends a single row
+    if (c == '\r' || c == '\n') return pos + (c == '\r' && pos + 1 < end && data[pos + 1] == '\n' ? 2 : 1);
+    if (state == State::AfterQuote) {
+      // Anything else than a delimiter after a quote is escaped, and the quoted cell goes on
+      state = c == delimiter ? State::CellStart : State::Quoted;
+    } else if (state == State::CellStart && c == quote) {
+      state = State::Quoted;
+    } else {
+      state = c == delimiter ? State::CellStart : State::Unquoted;
+    }
+  }
+  return end;
+}
+
+}  // namespace
+
+std::size_t CSVMappedFile::SkipRowsTo(const std::size_t row_start, const std::size_t target, const char delimiter,
+                                      const char quote, const char escape) const {
+  auto source = std::make_unique<CSVMappedChunk>(data_ + row_start, data_ + size_);
+  CSVMappedChunk *chunk = source.get();
+  CSVReader reader(std::move(source), delimiter, quote, escape);
+  while (chunk->GetBuffer() < data_ + target && reader.SkipRow()) {
+  }
+  return static_cast<std::size_t>(chunk->GetBuffer() - data_);
+}
+
+std::vector<std::size_t> CSVMappedFile::Split(const std::size_t num_chunks, const char delimiter, const char quote,
+                                              const char escape) const {
+  // Rows are found by the tokenizer that reads them, so that a range ends exactly where a reader over the whole file
+  // would end a row, whatever the quotes, escapes and line endings. Whether a new line ends a row depends on every
+  // character before it, which is only known once the ranges before are tokenized. Each range is therefore tokenized
+  // in parallel from two candidate row starts: the first row start after the tentative split point if the point falls
+  // into an unquoted cell, and the first one if it falls into a quoted cell. The range is tokenized from each candidate
+  // to the first row end at or after the next tentative split point.
+  struct Speculation {
+    std::size_t row_start_ = 0;
+    std::size_t row_end_ = 0;
+  };
+  const auto split_point = [&](const std::size_t i) { return i == num_chunks ? size_ : size_ / num_chunks * i; };
+  std::vector<std::array<Speculation, 2>> speculations(num_chunks);
+  const auto speculate = [&](const tbb::blocked_range<std::size_t> &range) {
+    for (std::size_t i = range.begin(); i < range.end(); i++) {
+      const std::size_t begin = split_point(i), target = split_point(i + 1);
+      for (const bool quoted : {false, true}) {
+        auto &speculation = speculations[i][quoted];
+        // The character before the split point may be the new line that ends the row before it
+        speculation.row_start_ =
+            begin == 0 ? 0 : FindRowStart(data_, begin - 1, target, quoted, delimiter, quote, escape);
+        if (quoted && speculation.row_start_ == speculations[i][false].row_start_) {
+          speculation.row_end_ = speculations[i][false].row_end_;
+        } else if (speculation.row_start_ < target) {
+          speculation.row_end_ = SkipRowsTo(speculation.row_start_, target, delimiter, quote, escape);
+        }
+      }
+    }
+  };
+  if (num_chunks > 1) tbb::parallel_for(tbb::blocked_range<std::size_t>(0, num_chunks - 1, 1), speculate);
+
+  // Follow the rows of a reader over the whole file from the start, through the candidates that turn out to be right.
+  // If neither candidate of a range is, e.g., because its split point falls between two escaped quotes, the range is
+  // tokenized again here.
+  std::vector<std::size_t> offsets{0};
+  for (std::size_t i = 0; i + 1 < num_chunks; i++) {
+    const std::size_t row_start = offsets.back(), target = split_point(i + 1);
+    std::size_t row_end = row_start;
+    if (row_start < target) {
+      const auto &speculation = speculations[i];
+      if (speculation[0].row_start_ == row_start) {
+        row_end = speculation[0].row_end_;
+      } else if (speculation[1].row_start_ == row_start) {
+        row_end = speculation[1].row_end_;
+      } else {
+        row_end = SkipRowsTo(row_start, target, delimiter, quote, escape);
+      }
+    }
+    if (row_end >= size_) break;
+    if (row_end != offsets.back()) offsets.push_back(row_end);
+  }
+
+  if (size_ != offsets.back()) offsets.push_back(size_);
+  return offsets;
+}
+
+//===----------------------------------------------------------------------===//
+//
+// CSV Stream Source
+//
+//===----------------------------------------------------------------------===//
+
+void CSVStream::Consume(const std::size_t n) {
+  NOISEPAGE_ASSERT(read_pos_ + n <= end_pos_, "Buffer overflow!");
+  read_pos_ += n;
+}
+
+void CSVStream::Append(const char *const data, const std::size_t len) {
+  // Move the incomplete row, if any, to the front of the buffer before appending the new chunk after it
+
+  if (read_pos_ > 0) {
+    std::memmove(&buffer_[0], &buffer_[read_pos_], end_pos_ - read_pos_);
+    end_pos_ -= read_pos_;
+    read_pos_ = 0;
+  }
+
+  // The padding after the data is always zeroed, as the reader looks at up to 16 bytes past the end of the data
+
+  buffer_.resize(end_pos_ + len + NUM_EXTRA_PADDING_CHARS);
+  std::memcpy(&buffer_[end_pos_], data, len);
+  end_pos_ += len;
+  std::memset(&buffer_[end_pos_], 0, NUM_EXTRA_PADDING_CHARS);
+}
+
+void CSVStream::Finish() {
+  if (end_pos_ > read_pos_ && buffer_[end_pos_ - 1] != '\n' && buffer_[end_pos_ - 1] != '\r') {
+    const char new_line = '\n';
+    Append(&new_line, 1);
+  }
+}
+
 //===----------------------------------------------------------------------===//
 //
 // CSV Reader
@@ -91,12 +293,28 @@ CSVReader::CSVReader(std::unique_ptr<CSVSource> source, char delimiter, char quo
   for (CSVCell &cell : row_.cells_) {
     cell.ptr_ = nullptr;
     cell.len_ = 0;
+    cell.escaped_ = false;
+    cell.quoted_ = false;
     cell.escape_char_ = escape_char_;
   }
 }
 
 bool CSVReader::Initialize() { return source_->Initialize(); }
 
+std::string_view CSVReader::GetRowCellString(const uint32_t idx) {
+  const CSVCell *cell = GetRowCell(idx);
+  if (!cell->escaped_) return std::string_view(cell->ptr_, cell->len_);
+
+  char *result = strings_.Allocate(cell->len_);
+  std::size_t new_len = 0;
+  for (std::size_t i = 0; i < cell->len_; i++) {
+    if (cell->ptr_[i] == escape_char_ && i + 1 < cell->len_) i++;
+    result[new_len++] = cell->ptr_[i];
+  }
+  return std::string_view(result, new_len);
+}
+
+template <bool RecordCells>
 CSVReader::ParseResult CSVReader::TryParse() {
   const auto check_quoted = [&](const char *buf) noexcept {
     const auto special = _mm_setr_epi8(quote_char_, escape_char_, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
@@ -131,15 +349,26 @@ CSVReader::ParseResult CSVReader::TryParse() {
   cell->ptr_ = cell_start;   \
   cell->len_ = ptr - cell_start - 1;
 
-#define NEXT_CELL()                          \
-  cell++;                                    \
-  if (++row_.count_ == row_.cells_.size()) { \
-    return ParseResult::NeedMoreCells;       \
+// When rows are only skipped, every cell is parsed into the first one
+#define NEXT_CELL()                            \
+  if constexpr (RecordCells) {                 \
+    cell++;                                    \
+    if (++row_.count_ == row_.cells_.size()) { \
+      return ParseResult::NeedMoreCells;       \
+    }                                          \
   }
 
+// A carriage return followed by a new line ends a single row
+#define FINISH_ROW()                                             \
+  row_.count_++;                                                 \
+  buf_ = ptr + 1;                                                \
+  if (*ptr == '\r' && buf_ < buf_end_ && *buf_ == '\n') buf_++; \
+  return ParseResult::Ok;
+
 cell_start:
   const char *cell_start = ptr;
   cell->escaped_ = false;
+  cell->quoted_ = false;
 
   // The first check we do is if we've reached the end of a line. This can be
   // caused by an empty last cell.
@@ -147,9 +376,7 @@ cell_start:
   RETURN_IF_AT_END();
   if (is_new_line(*ptr)) {
     FINISH_CELL();
-    row_.count_++;
-    buf_ = ptr + 1;
-    return ParseResult::Ok;
+    FINISH_ROW();
   }
 
   // If the first character in a cell is the quote character, it's deemed a
@@ -159,6 +386,7 @@ cell_start:
   // character followed by a delimiter character.
 
   if (*ptr == quote_char_) {
+    cell->quoted_ = true;
     cell_start = ++ptr;
   quoted_cell:
     while (true) {
@@ -180,9 +408,7 @@ cell_start:
     }
     if (is_new_line(*ptr)) {
       FINISH_QUOTED_CELL();
-      row_.count_++;
-      buf_ = ptr + 1;
-      return ParseResult::Ok;
+      FINISH_ROW();
     }
     cell->escaped_ = true;
     ptr++;
@@ -213,22 +439,29 @@ unquoted_cell:
   }
   if (is_new_line(*ptr)) {
     FINISH_CELL();
-    row_.count_++;
-    buf_ = ptr + 1;
-    return ParseResult::Ok;
+    FINISH_ROW();
   }
   cell->escaped_ = true;
   ptr++;
   goto unquoted_cell;
 }
 
-bool CSVReader::Advance() {
+bool CSVReader::Advance() { return ParseRow<true>(); }
+
+bool CSVReader::SkipRow() {
+  const bool skipped = ParseRow<false>();
+  row_.count_ = 0;
+  return skipped;
+}
+
+template <bool RecordCells>
+bool CSVReader::ParseRow() {
   do {
     row_.count_ = 0;
     buf_ = source_->GetBuffer();
     buf_end_ = buf_ + source_->GetSize();
     const char *start_pos = buf_;
-    switch (TryParse()) {
+    switch (TryParse<RecordCells>()) {
       case ParseResult::Ok:
         stats_.num_lines_++;
         stats_.bytes_read_ += buf_ - start_pos;
@@ -237,7 +470,7 @@ bool CSVReader::Advance() {
       case ParseResult::NeedMoreCells:
         row_.cells_.resize(row_.cells_.size() * 2);
         for (auto &cell : row_.cells_) cell.escape_char_ = escape_char_;
-        return Advance();
+        return ParseRow<RecordCells>();
       case ParseResult::NeedMoreData:
         break;
     }
@@ -249,4 +482,3 @@ bool CSVReader::Advance() {
 }
 
 }  // namespace noisepage::execution::util
-#endif
@@ -6,6 +6,7 @@
 
 #include <cerrno>
 #include <cstdint>
+#include <string>
 
 #include "execution/util/execution_common.h"
 
@@ -146,13 +147,17 @@ void File::Open(const std::string_view &path, uint32_t flags) { Initialize(path,
 
 void File::Create(const std::string_view &path) { Open(path, FLAG_CREATE_ALWAYS | FLAG_WRITE); }
 
-void File::CreateTemp(bool delete_on_close) {
+void File::CreateTemp(bool delete_on_close, std::string_view directory) {
   // Close the existing file if it's open
   Close();
 
   // Attempt to create a temporary file
-  char tmp[] = "/tmp/noisepage-tpl.XXXXXX";
-  int32_t fd = HANDLE_EINTR(mkstemp(tmp));
+  std::string tmp(directory);
+  if (tmp.empty() || tmp.back() != '/') {
+    tmp += '/';
+  }
+  tmp += "noisepage-tpl.XXXXXX";
+  int32_t fd = HANDLE_EINTR(mkstemp(tmp.data()));
 
   // Fail?
   if (fd == INVALID_DESCRIPTOR) {
@@ -162,7 +167,7 @@ void File::CreateTemp(bool delete_on_close) {
 
   // If we need to delete on close, unlink it now
   if (delete_on_close) {
-    unlink(tmp);
+    unlink(tmp.c_str());
   }
 
   // Done
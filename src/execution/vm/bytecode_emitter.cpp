@@ -338,21 +338,42 @@ void BytecodeEmitter::EmitAggHashTableMovePartitions(LocalVar agg_ht, LocalVar t
   EmitAll(Bytecode::AggregationHashTableTransferPartitions, agg_ht, tls, aht_offset, merge_part_fn);
 }
 
+void BytecodeEmitter::EmitAggHashTableEnableSpilling(LocalVar agg_ht, LocalVar query_state, FunctionId merge_part_fn) {
+  EmitAll(Bytecode::AggregationHashTableEnableSpilling, agg_ht, query_state, merge_part_fn);
+}
+
 void BytecodeEmitter::EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, LocalVar context, LocalVar tls,
                                                               FunctionId scan_part_fn) {
   EmitAll(Bytecode::AggregationHashTableParallelPartitionedScan, agg_ht, context, tls, scan_part_fn);
 }
 
+void BytecodeEmitter::EmitJoinHashTableProbeBloomFilter(LocalVar join_hash_table, LocalVar vector_projection,
+                                                        LocalVar tid_list, LocalVar key_cols, uint32_t num_key_cols) {
+  EmitAll(Bytecode::JoinHashTableProbeBloomFilter, join_hash_table, vector_projection, tid_list, key_cols,
+          num_key_cols);
+}
+
+void BytecodeEmitter::EmitJoinHashTableProbeSpilledPartitions(LocalVar join_hash_table, LocalVar query_state,
+                                                              LocalVar pipeline_state, FunctionId probe_fn) {
+  EmitAll(Bytecode::JoinHashTableProbeSpilledPartitions, join_hash_table, query_state, pipeline_state, probe_fn);
+}
+
 void BytecodeEmitter::EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar exec_ctx, FunctionId cmp_fn,
                                      LocalVar tuple_size) {
   EmitAll(bytecode, sorter, exec_ctx, cmp_fn, tuple_size);
 }
 
-#if 0
-void BytecodeEmitter::EmitCSVReaderInit(LocalVar reader, LocalVar file_name, uint32_t file_name_len) {
-  EmitAll(Bytecode::CSVReaderInit, reader, file_name, file_name_len);
+void BytecodeEmitter::EmitCSVReaderInit(LocalVar reader, LocalVar exec_ctx, LocalVar file_name,
+                                        uint32_t file_name_len, int8_t delimiter, int8_t quote, int8_t escape) {
+  EmitAll(Bytecode::CSVReaderInit, reader, exec_ctx, file_name, file_name_len, delimiter, quote, escape);
+}
+
+void BytecodeEmitter::EmitParallelCSVScan(LocalVar file_name, uint32_t file_name_len, int8_t delimiter,
+                                          int8_t quote, int8_t escape, LocalVar query_state, LocalVar exec_ctx,
+                                          LocalVar num_threads_override, FunctionId scan_fn) {
+  EmitAll(Bytecode::ParallelScanCSV, file_name, file_name_len, delimiter, quote, escape, query_state, exec_ctx,
+          num_threads_override, scan_fn);
 }
-#endif
 
 void BytecodeEmitter::EmitIndexIteratorInit(Bytecode bytecode, LocalVar iter, LocalVar exec_ctx, uint32_t num_attrs,
                                             LocalVar table_oid, LocalVar index_oid, LocalVar col_oids,
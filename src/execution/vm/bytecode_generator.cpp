@@ -692,6 +692,11 @@ void BytecodeGenerator::VisitBuiltinTableIterCall(ast::CallExpr *call, ast::Buil
       GetEmitter()->Emit(Bytecode::TableVectorIteratorFree, iter);
       break;
     }
+    case ast::Builtin::TableIterSkipBlocks: {
+      LocalVar filter_manager = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::TableVectorIteratorSkipBlocks, iter, filter_manager);
+      break;
+    }
     default: {
       UNREACHABLE("Impossible table iteration call");
     }
@@ -916,7 +921,13 @@ void BytecodeGenerator::VisitBuiltinFilterManagerCall(ast::CallExpr *call, ast::
   switch (builtin) {
     case ast::Builtin::FilterManagerInit: {
       LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[1]);
-      GetEmitter()->Emit(Bytecode::FilterManagerInit, filter_manager, exec_ctx);
+      if (call->NumArgs() == 3) {
+        // An opaque context is passed through to every filter clause
+        LocalVar context = VisitExpressionForRValue(call->Arguments()[2]);
+        GetEmitter()->Emit(Bytecode::FilterManagerInitWithContext, filter_manager, exec_ctx, context);
+      } else {
+        GetEmitter()->Emit(Bytecode::FilterManagerInit, filter_manager, exec_ctx);
+      }
       break;
     }
     case ast::Builtin::FilterManagerInsertFilter: {
@@ -930,6 +941,13 @@ void BytecodeGenerator::VisitBuiltinFilterManagerCall(ast::CallExpr *call, ast::
       }
       break;
     }
+    case ast::Builtin::FilterManagerInsertZoneMapTerm: {
+      LocalVar col_idx = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar comparison = VisitExpressionForRValue(call->Arguments()[2]);
+      LocalVar value = VisitExpressionForRValue(call->Arguments()[3]);
+      GetEmitter()->Emit(Bytecode::FilterManagerInsertZoneMapTerm, filter_manager, col_idx, comparison, value);
+      break;
+    }
     case ast::Builtin::FilterManagerRunFilters: {
       LocalVar vpi = VisitExpressionForRValue(call->Arguments()[1]);
       LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[2]);
@@ -1075,6 +1093,13 @@ void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::B
       GetEmitter()->EmitAggHashTableMovePartitions(agg_ht, tls, aht_offset, merge_part_fn);
       break;
     }
+    case ast::Builtin::AggHashTableEnableSpilling: {
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar query_state = VisitExpressionForRValue(call->Arguments()[1]);
+      auto merge_part_fn = LookupFuncIdByName(call->Arguments()[2]->As<ast::IdentifierExpr>()->Name().GetData());
+      GetEmitter()->EmitAggHashTableEnableSpilling(agg_ht, query_state, merge_part_fn);
+      break;
+    }
     case ast::Builtin::AggHashTableParallelPartitionedScan: {
       LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
       LocalVar ctx = VisitExpressionForRValue(call->Arguments()[1]);
@@ -1465,12 +1490,51 @@ void BytecodeGenerator::VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::JoinHashTableBuildParallel, join_hash_table, tls, jht_offset);
       break;
     }
+    case ast::Builtin::JoinHashTableBuildBloomFilter: {
+      GetEmitter()->Emit(Bytecode::JoinHashTableBuildBloomFilter, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableProbeBloomFilter: {
+      LocalVar vector_projection = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar tid_list = VisitExpressionForRValue(call->Arguments()[2]);
+      // The fourth argument is the array of key column indexes
+      auto *arr_type = call->Arguments()[3]->GetType()->As<ast::ArrayType>();
+      LocalVar key_cols = VisitExpressionForLValue(call->Arguments()[3]);
+      GetEmitter()->EmitJoinHashTableProbeBloomFilter(join_hash_table, vector_projection, tid_list, key_cols,
+                                                      static_cast<uint32_t>(arr_type->GetLength()));
+      break;
+    }
     case ast::Builtin::JoinHashTableLookup: {
       LocalVar ht_entry_iter = VisitExpressionForRValue(call->Arguments()[1]);
       LocalVar hash = VisitExpressionForRValue(call->Arguments()[2]);
       GetEmitter()->Emit(Bytecode::JoinHashTableLookup, join_hash_table, ht_entry_iter, hash);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableSpilling: {
+      LocalVar probe_tuple_size = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableEnableSpilling, join_hash_table, probe_tuple_size);
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsPartitionSpilled: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableIsPartitionSpilled, dest, join_hash_table, hash);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableDeferProbe: {
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar probe_tuple = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableDeferProbe, join_hash_table, hash, probe_tuple);
+      break;
+    }
+    case ast::Builtin::JoinHashTableProbeSpilled: {
+      LocalVar query_state = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar pipeline_state = VisitExpressionForRValue(call->Arguments()[2]);
+      auto probe_fn = LookupFuncIdByName(call->Arguments()[3]->As<ast::IdentifierExpr>()->Name().GetData());
+      GetEmitter()->EmitJoinHashTableProbeSpilledPartitions(join_hash_table, query_state, pipeline_state, probe_fn);
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       GetEmitter()->Emit(Bytecode::JoinHashTableFree, join_hash_table);
       break;
@@ -1554,6 +1618,13 @@ void BytecodeGenerator::VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin
                                    entry_size);
       break;
     }
+    case ast::Builtin::SorterInitForIndex: {
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar index_oid = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::SorterInitForIndex, sorter, exec_ctx, index_oid);
+      break;
+    }
     case ast::Builtin::SorterGetTupleCount: {
       LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
       LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
@@ -1654,6 +1725,81 @@ void BytecodeGenerator::VisitBuiltinSorterIterCall(ast::CallExpr *call, ast::Bui
   }
 }
 
+void BytecodeGenerator::VisitBuiltinRowBufferCall(ast::CallExpr *call, ast::Builtin builtin) {
+  // The first argument to all calls is the row buffer instance
+  const LocalVar buffer = VisitExpressionForRValue(call->Arguments()[0]);
+
+  switch (builtin) {
+    case ast::Builtin::RowBufferInit: {
+      LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar row_size = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::RowBufferInit, buffer, exec_ctx, row_size);
+      break;
+    }
+    case ast::Builtin::RowBufferInsert: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::RowBufferAllocRow, dest, buffer);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::RowBufferFinish: {
+      GetEmitter()->Emit(Bytecode::RowBufferFinish, buffer);
+      break;
+    }
+    case ast::Builtin::RowBufferFree: {
+      GetEmitter()->Emit(Bytecode::RowBufferFree, buffer);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible row buffer call");
+    }
+  }
+}
+
+void BytecodeGenerator::VisitBuiltinRowBufferIterCall(ast::CallExpr *call, ast::Builtin builtin) {
+  // The first argument to all calls is the row buffer iterator instance
+  const LocalVar iter = VisitExpressionForRValue(call->Arguments()[0]);
+
+  switch (builtin) {
+    case ast::Builtin::RowBufferIterInit: {
+      LocalVar buffer = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::RowBufferIteratorInit, iter, buffer);
+      break;
+    }
+    case ast::Builtin::RowBufferIterHasNext: {
+      LocalVar cond = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::RowBufferIteratorHasNext, cond, iter);
+      GetExecutionResult()->SetDestination(cond.ValueOf());
+      break;
+    }
+    case ast::Builtin::RowBufferIterNext: {
+      GetEmitter()->Emit(Bytecode::RowBufferIteratorNext, iter);
+      break;
+    }
+    case ast::Builtin::RowBufferIterGetRow: {
+      LocalVar row_ptr = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::RowBufferIteratorGetRow, row_ptr, iter);
+      GetExecutionResult()->SetDestination(row_ptr.ValueOf());
+      break;
+    }
+    case ast::Builtin::RowBufferIterMark: {
+      GetEmitter()->Emit(Bytecode::RowBufferIteratorMark, iter);
+      break;
+    }
+    case ast::Builtin::RowBufferIterRewind: {
+      GetEmitter()->Emit(Bytecode::RowBufferIteratorRewind, iter);
+      break;
+    }
+    case ast::Builtin::RowBufferIterClose: {
+      GetEmitter()->Emit(Bytecode::RowBufferIteratorFree, iter);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible row buffer iteration call");
+    }
+  }
+}
+
 void BytecodeGenerator::VisitResultBufferCall(ast::CallExpr *call, ast::Builtin builtin) {
   LocalVar input = VisitExpressionForRValue(call->Arguments()[0]);
   switch (builtin) {
@@ -1683,20 +1829,23 @@ void BytecodeGenerator::VisitResultBufferCall(ast::CallExpr *call, ast::Builtin
   }
 }
 
-#if 0
 void BytecodeGenerator::VisitCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (builtin == ast::Builtin::CSVReaderInit) {
+    LocalVar result = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+    LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
+    NOISEPAGE_ASSERT(call->Arguments()[1]->IsLitExpr(), "Second argument expected to be string literal");
+    auto string_lit = call->Arguments()[1]->As<ast::LitExpr>()->StringVal();
+    auto file_name = NewStaticString(call->GetType()->GetContext(), string_lit);
+    const auto delimiter = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+    const auto quote = static_cast<int8_t>(call->Arguments()[3]->As<ast::LitExpr>()->Int64Val());
+    const auto escape = static_cast<int8_t>(call->Arguments()[4]->As<ast::LitExpr>()->Int64Val());
+    GetEmitter()->EmitCSVReaderInit(result, exec_ctx, file_name, string_lit.GetLength(), delimiter, quote, escape);
+    GetExecutionResult()->SetDestination(result.ValueOf());
+    return;
+  }
+
   LocalVar reader = VisitExpressionForRValue(call->Arguments()[0]);
   switch (builtin) {
-    case ast::Builtin::CSVReaderInit: {
-      LocalVar result = GetExecutionResult()->GetOrCreateDestination(call->GetType());
-      NOISEPAGE_ASSERT(call->Arguments()[1]->IsLitExpr(), "Second argument expected to be string literal");
-      auto string_lit = call->Arguments()[1]->As<ast::LitExpr>()->StringVal();
-      auto file_name = NewStaticString(call->GetType()->GetContext(), string_lit);
-      GetEmitter()->EmitCSVReaderInit(reader, file_name, string_lit.GetLength());
-      GetEmitter()->Emit(Bytecode::CSVReaderPerformInit, result, reader);
-      GetExecutionResult()->SetDestination(result.ValueOf());
-      break;
-    }
     case ast::Builtin::CSVReaderAdvance: {
       LocalVar has_more = GetExecutionResult()->GetOrCreateDestination(call->GetType());
       GetEmitter()->Emit(Bytecode::CSVReaderAdvance, has_more, reader);
@@ -1712,10 +1861,7 @@ void BytecodeGenerator::VisitCSVReaderCall(ast::CallExpr *call, ast::Builtin bui
     case ast::Builtin::CSVReaderGetRecordNumber: {
       LocalVar record_number = GetExecutionResult()->GetOrCreateDestination(call->GetType());
       GetEmitter()->Emit(Bytecode::CSVReaderGetRecordNumber, record_number, reader);
-      break;
-    }
-    case ast::Builtin::CSVReaderClose: {
-      GetEmitter()->Emit(Bytecode::CSVReaderClose, reader);
+      GetExecutionResult()->SetDestination(record_number.ValueOf());
       break;
     }
     default: {
@@ -1723,7 +1869,28 @@ void BytecodeGenerator::VisitCSVReaderCall(ast::CallExpr *call, ast::Builtin bui
     }
   }
 }
-#endif
+
+void BytecodeGenerator::VisitBuiltinCSVScanParallelCall(ast::CallExpr *call) {
+  // The first argument is the file name, which is a string literal.
+  NOISEPAGE_ASSERT(call->Arguments()[0]->IsLitExpr(), "First argument expected to be string literal");
+  auto string_lit = call->Arguments()[0]->As<ast::LitExpr>()->StringVal();
+  auto file_name = NewStaticString(call->GetType()->GetContext(), string_lit);
+  // The next three arguments are the delimiter, quote, and escape characters, which are integer literals.
+  const auto delimiter = static_cast<int8_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+  const auto quote = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+  const auto escape = static_cast<int8_t>(call->Arguments()[3]->As<ast::LitExpr>()->Int64Val());
+  // The fifth argument is the query state.
+  LocalVar query_state = VisitExpressionForRValue(call->Arguments()[4]);
+  // The sixth argument should be the execution context.
+  LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[5]);
+  // The seventh argument is the number of threads for override
+  LocalVar num_threads_override = VisitExpressionForRValue(call->Arguments()[6]);
+  // The eighth argument is the scan function as an identifier.
+  const auto scan_fn_name = call->Arguments()[7]->As<ast::IdentifierExpr>()->Name();
+  // Emit the bytecode.
+  GetEmitter()->EmitParallelCSVScan(file_name, string_lit.GetLength(), delimiter, quote, escape, query_state, exec_ctx,
+                                    num_threads_override, LookupFuncIdByName(scan_fn_name.GetData()));
+}
 
 void BytecodeGenerator::VisitExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin) {
   LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
@@ -2412,6 +2579,19 @@ void BytecodeGenerator::VisitBuiltinStorageInterfaceCall(ast::CallExpr *call, as
       GetExecutionResult()->SetDestination(cond.ValueOf());
       break;
     }
+    case ast::Builtin::IndexBulkLoadInsert: {
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar tuple_slot = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::StorageInterfaceIndexBulkLoadInsert, storage_interface, sorter, tuple_slot);
+      break;
+    }
+    case ast::Builtin::IndexBulkLoad: {
+      LocalVar cond = GetExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::StorageInterfaceIndexBulkLoad, cond, storage_interface, sorter);
+      GetExecutionResult()->SetDestination(cond.ValueOf());
+      break;
+    }
     case ast::Builtin::IndexDelete: {
       LocalVar tuple_slot = VisitExpressionForRValue(call->Arguments()[1]);
       GetEmitter()->Emit(Bytecode::StorageInterfaceIndexDelete, storage_interface, tuple_slot);
@@ -2751,7 +2931,8 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPINumTuples:
     case ast::Builtin::TableIterGetVPI:
-    case ast::Builtin::TableIterClose: {
+    case ast::Builtin::TableIterClose:
+    case ast::Builtin::TableIterSkipBlocks: {
       VisitBuiltinTableIterCall(call, builtin);
       break;
     }
@@ -2842,6 +3023,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     };
     case ast::Builtin::FilterManagerInit:
     case ast::Builtin::FilterManagerInsertFilter:
+    case ast::Builtin::FilterManagerInsertZoneMapTerm:
     case ast::Builtin::FilterManagerRunFilters:
     case ast::Builtin::FilterManagerFree: {
       VisitBuiltinFilterManagerCall(call, builtin);
@@ -2866,6 +3048,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::AggHashTableLookup:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
+    case ast::Builtin::AggHashTableEnableSpilling:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
     case ast::Builtin::AggHashTableFree: {
       VisitBuiltinAggHashTableCall(call, builtin);
@@ -2901,7 +3084,13 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::JoinHashTableGetTupleCount:
     case ast::Builtin::JoinHashTableBuild:
     case ast::Builtin::JoinHashTableBuildParallel:
+    case ast::Builtin::JoinHashTableBuildBloomFilter:
+    case ast::Builtin::JoinHashTableProbeBloomFilter:
     case ast::Builtin::JoinHashTableLookup:
+    case ast::Builtin::JoinHashTableEnableSpilling:
+    case ast::Builtin::JoinHashTableIsPartitionSpilled:
+    case ast::Builtin::JoinHashTableDeferProbe:
+    case ast::Builtin::JoinHashTableProbeSpilled:
     case ast::Builtin::JoinHashTableFree: {
       VisitBuiltinJoinHashTableCall(call, builtin);
       break;
@@ -2920,6 +3109,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::SorterInit:
+    case ast::Builtin::SorterInitForIndex:
     case ast::Builtin::SorterGetTupleCount:
     case ast::Builtin::SorterInsert:
     case ast::Builtin::SorterInsertTopK:
@@ -2940,6 +3130,23 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinSorterIterCall(call, builtin);
       break;
     }
+    case ast::Builtin::RowBufferInit:
+    case ast::Builtin::RowBufferInsert:
+    case ast::Builtin::RowBufferFinish:
+    case ast::Builtin::RowBufferFree: {
+      VisitBuiltinRowBufferCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::RowBufferIterInit:
+    case ast::Builtin::RowBufferIterHasNext:
+    case ast::Builtin::RowBufferIterNext:
+    case ast::Builtin::RowBufferIterGetRow:
+    case ast::Builtin::RowBufferIterMark:
+    case ast::Builtin::RowBufferIterRewind:
+    case ast::Builtin::RowBufferIterClose: {
+      VisitBuiltinRowBufferIterCall(call, builtin);
+      break;
+    }
     case ast::Builtin::ResultBufferNew:
     case ast::Builtin::ResultBufferAllocOutRow:
     case ast::Builtin::ResultBufferFinalize:
@@ -2947,19 +3154,24 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitResultBufferCall(call, builtin);
       break;
     }
-#if 0
     case ast::Builtin::CSVReaderInit:
     case ast::Builtin::CSVReaderAdvance:
     case ast::Builtin::CSVReaderGetField:
-    case ast::Builtin::CSVReaderGetRecordNumber:
-    case ast::Builtin::CSVReaderClose: {
+    case ast::Builtin::CSVReaderGetRecordNumber: {
       VisitCSVReaderCall(call, builtin);
       break;
     }
-#endif
+    case ast::Builtin::CSVScanParallel: {
+      VisitBuiltinCSVScanParallelCall(call);
+      break;
+    }
     case ast::Builtin::IndexIteratorInit:
     case ast::Builtin::IndexIteratorGetSize:
+    case ast::Builtin::IndexIteratorEnableIndexOnly:
     case ast::Builtin::IndexIteratorScanKey:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorScanKeyBatch:
+    case ast::Builtin::IndexIteratorNextBatchKey:
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitDescending:
@@ -2969,6 +3181,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorGetLoPR:
     case ast::Builtin::IndexIteratorGetHiPR:
     case ast::Builtin::IndexIteratorGetTablePR:
+    case ast::Builtin::IndexIteratorGetIndexOnlyPR:
     case ast::Builtin::IndexIteratorGetSlot: {
       VisitBuiltinIndexIteratorCall(call, builtin);
       break;
@@ -3066,6 +3279,8 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::IndexInsert:
     case ast::Builtin::IndexInsertUnique:
     case ast::Builtin::IndexInsertWithSlot:
+    case ast::Builtin::IndexBulkLoadInsert:
+    case ast::Builtin::IndexBulkLoad:
     case ast::Builtin::IndexDelete:
     case ast::Builtin::StorageInterfaceFree: {
       VisitBuiltinStorageInterfaceCall(call, builtin);
@@ -3198,10 +3413,26 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       GetExecutionResult()->SetDestination(index_size.ValueOf());
       break;
     }
+    case ast::Builtin::IndexIteratorEnableIndexOnly: {
+      GetEmitter()->Emit(Bytecode::IndexIteratorEnableIndexOnly, iterator);
+      break;
+    }
     case ast::Builtin::IndexIteratorScanKey: {
       GetEmitter()->Emit(Bytecode::IndexIteratorScanKey, iterator);
       break;
     }
+    case ast::Builtin::IndexIteratorAddBatchKey: {
+      GetEmitter()->Emit(Bytecode::IndexIteratorAddBatchKey, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorScanKeyBatch: {
+      GetEmitter()->Emit(Bytecode::IndexIteratorScanKeyBatch, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorNextBatchKey: {
+      GetEmitter()->Emit(Bytecode::IndexIteratorNextBatchKey, iterator);
+      break;
+    }
     case ast::Builtin::IndexIteratorScanAscending: {
       auto asc_type = VisitExpressionForRValue(call->Arguments()[1]);
       auto limit = VisitExpressionForRValue(call->Arguments()[2]);
@@ -3247,6 +3478,11 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::IndexIteratorGetTablePR, pr, iterator);
       break;
     }
+    case ast::Builtin::IndexIteratorGetIndexOnlyPR: {
+      LocalVar pr = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::IndexIteratorGetIndexOnlyPR, pr, iterator);
+      break;
+    }
     case ast::Builtin::IndexIteratorGetSlot: {
       LocalVar pr = GetExecutionResult()->GetOrCreateDestination(call->GetType());
       GetEmitter()->Emit(Bytecode::IndexIteratorGetSlot, pr, iterator);
@@ -7,6 +7,7 @@
 #include "execution/sql/storage_interface.h"
 #include "execution/sql/vector_projection_iterator.h"
 #include "self_driving/modeling/operating_unit_defs.h"
+#include "storage/index/index.h"
 
 extern "C" {
 
@@ -31,6 +32,12 @@ void OpTableVectorIteratorFree(noisepage::execution::sql::TableVectorIterator *i
   iter->~TableVectorIterator();
 }
 
+void OpTableVectorIteratorSkipBlocks(noisepage::execution::sql::TableVectorIterator *iter,
+                                     const noisepage::execution::sql::FilterManager *filter_manager) {
+  NOISEPAGE_ASSERT(iter != nullptr, "NULL iterator given to skip blocks");
+  iter->SkipBlocks(filter_manager);
+}
+
 void OpVPIInit(noisepage::execution::sql::VectorProjectionIterator *vpi,
                noisepage::execution::sql::VectorProjection *vp) {
   new (vpi) noisepage::execution::sql::VectorProjectionIterator(vp);
@@ -133,6 +140,12 @@ void OpFilterManagerInit(noisepage::execution::sql::FilterManager *filter_manage
   new (filter_manager) noisepage::execution::sql::FilterManager(exec_settings);
 }
 
+void OpFilterManagerInitWithContext(noisepage::execution::sql::FilterManager *filter_manager,
+                                    const noisepage::execution::exec::ExecutionSettings &exec_settings,
+                                    void *context) {
+  new (filter_manager) noisepage::execution::sql::FilterManager(exec_settings, true, context);
+}
+
 void OpFilterManagerStartNewClause(noisepage::execution::sql::FilterManager *filter_manager) {
   filter_manager->StartNewClause();
 }
@@ -142,6 +155,12 @@ void OpFilterManagerInsertFilter(noisepage::execution::sql::FilterManager *filte
   filter_manager->InsertClauseTerm(clause);
 }
 
+void OpFilterManagerInsertZoneMapTerm(noisepage::execution::sql::FilterManager *filter_manager, const uint32_t col_idx,
+                                      const uint32_t comparison, const int64_t value) {
+  filter_manager->InsertClauseZoneMapTerm(
+      col_idx, static_cast<noisepage::execution::sql::FilterManager::ZoneMapComparison>(comparison), value);
+}
+
 void OpFilterManagerRunFilters(noisepage::execution::sql::FilterManager *filter_manager,
                                noisepage::execution::sql::VectorProjectionIterator *vpi,
                                noisepage::execution::exec::ExecutionContext *exec_ctx) {
@@ -168,6 +187,16 @@ void OpJoinHashTableBuildParallel(noisepage::execution::sql::JoinHashTable *join
   join_hash_table->MergeParallel(thread_state_container, jht_offset);
 }
 
+void OpJoinHashTableBuildBloomFilter(noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  join_hash_table->BuildBloomFilter();
+}
+
+void OpJoinHashTableProbeSpilledPartitions(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                           void *query_state, void *pipeline_state,
+                                           noisepage::execution::sql::JoinHashTable::ProbeSpilledFn probe_fn) {
+  join_hash_table->ProbeSpilledPartitions(query_state, pipeline_state, probe_fn);
+}
+
 void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_table) {
   join_hash_table->~JoinHashTable();
 }
@@ -209,7 +238,7 @@ void OpAggregationHashTableFree(noisepage::execution::sql::AggregationHashTable
 void OpAggregationHashTableIteratorInit(noisepage::execution::sql::AHTIterator *iter,
                                         noisepage::execution::sql::AggregationHashTable *agg_hash_table) {
   NOISEPAGE_ASSERT(agg_hash_table != nullptr, "Null hash table");
-  new (iter) noisepage::execution::sql::AHTIterator(*agg_hash_table);
+  new (iter) noisepage::execution::sql::AHTIterator(agg_hash_table);
 }
 
 void OpAggregationHashTableBuildAllHashTablePartitions(noisepage::execution::sql::AggregationHashTable *agg_hash_table,
@@ -240,6 +269,12 @@ void OpSorterInit(noisepage::execution::sql::Sorter *const sorter,
   new (sorter) noisepage::execution::sql::Sorter(exec_ctx, cmp_fn, tuple_size);
 }
 
+void OpSorterInitForIndex(noisepage::execution::sql::Sorter *const sorter,
+                          noisepage::execution::exec::ExecutionContext *const exec_ctx, const uint32_t index_oid) {
+  const auto index = exec_ctx->GetAccessor()->GetIndex(noisepage::catalog::index_oid_t(index_oid));
+  new (sorter) noisepage::execution::sql::Sorter(exec_ctx, index->GetBulkLoadComparison(), index->BulkLoadEntrySize());
+}
+
 void OpSorterSort(noisepage::execution::sql::Sorter *sorter) { sorter->Sort(); }
 
 void OpSorterSortParallel(noisepage::execution::sql::Sorter *sorter,
@@ -262,21 +297,45 @@ void OpSorterIteratorInit(noisepage::execution::sql::SorterIterator *iter, noise
 
 void OpSorterIteratorFree(noisepage::execution::sql::SorterIterator *iter) { iter->~SorterIterator(); }
 
+// ---------------------------------------------------------
+// Row Buffers
+// ---------------------------------------------------------
+
+void OpRowBufferInit(noisepage::execution::sql::RowBuffer *const buffer,
+                     noisepage::execution::exec::ExecutionContext *const exec_ctx, const uint32_t row_size) {
+  new (buffer) noisepage::execution::sql::RowBuffer(exec_ctx, row_size);
+}
+
+void OpRowBufferFree(noisepage::execution::sql::RowBuffer *buffer) { buffer->~RowBuffer(); }
+
+void OpRowBufferIteratorInit(noisepage::execution::sql::RowBufferIterator *iter,
+                             noisepage::execution::sql::RowBuffer *buffer) {
+  new (iter) noisepage::execution::sql::RowBufferIterator(*buffer);
+}
+
+void OpRowBufferIteratorFree(noisepage::execution::sql::RowBufferIterator *iter) { iter->~RowBufferIterator(); }
+
 // ---------------------------------------------------------
 // CSV Reader
 // ---------------------------------------------------------
-#if 0
-void OpCSVReaderInit(noisepage::execution::util::CSVReader *reader, const uint8_t *file_name, uint32_t len) {
+
+void OpCSVReaderInit(noisepage::execution::util::CSVReader **result,
+                     noisepage::execution::exec::ExecutionContext *exec_ctx, const uint8_t *file_name, uint32_t len,
+                     int8_t delimiter, int8_t quote, int8_t escape) {
   std::string_view fname(reinterpret_cast<const char *>(file_name), len);
-  new (reader) noisepage::execution::util::CSVReader(std::make_unique<noisepage::execution::util::CSVFile>(fname));
+  *result = noisepage::execution::sql::CSVScanner::Open(exec_ctx, fname, static_cast<char>(delimiter),
+                                                         static_cast<char>(quote), static_cast<char>(escape));
 }
 
-void OpCSVReaderPerformInit(bool *result, noisepage::execution::util::CSVReader *reader) {
-  *result = reader->Initialize();
+void OpParallelScanCSV(const uint8_t *file_name, uint32_t len, int8_t delimiter, int8_t quote, int8_t escape,
+                       void *const query_state, noisepage::execution::exec::ExecutionContext *exec_ctx,
+                       uint32_t num_threads_override, noisepage::execution::sql::CSVScanner::ScanFn scanner) {
+  std::string_view fname(reinterpret_cast<const char *>(file_name), len);
+  noisepage::execution::sql::CSVScanner::ParallelScan(fname, static_cast<char>(delimiter), static_cast<char>(quote),
+                                                      static_cast<char>(escape), query_state, exec_ctx,
+                                                      num_threads_override, scanner);
 }
 
-void OpCSVReaderClose(noisepage::execution::util::CSVReader *reader) { std::destroy_at(reader); }
-#endif
 // -------------------------------------------------------------
 // StorageInterface Calls
 // -------------------------------------------------------------
@@ -334,6 +393,15 @@ void OpStorageInterfaceIndexInsertWithSlot(bool *result, noisepage::execution::s
                                            noisepage::storage::TupleSlot *tuple_slot, bool unique) {
   *result = storage_interface->IndexInsertWithTuple(*tuple_slot, unique);
 }
+void OpStorageInterfaceIndexBulkLoadInsert(noisepage::execution::sql::StorageInterface *storage_interface,
+                                           noisepage::execution::sql::Sorter *sorter,
+                                           noisepage::storage::TupleSlot *tuple_slot) {
+  storage_interface->IndexBulkLoadInsert(sorter, *tuple_slot);
+}
+void OpStorageInterfaceIndexBulkLoad(bool *result, noisepage::execution::sql::StorageInterface *storage_interface,
+                                     noisepage::execution::sql::Sorter *sorter) {
+  *result = storage_interface->IndexBulkLoad(*sorter);
+}
 void OpStorageInterfaceIndexDelete(noisepage::execution::sql::StorageInterface *storage_interface,
                                    noisepage::storage::TupleSlot *tuple_slot) {
   storage_interface->IndexDelete(*tuple_slot);
@@ -664,6 +664,13 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(TableVectorIteratorSkipBlocks) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto *filter_manager = frame->LocalAt<sql::FilterManager *>(READ_LOCAL_ID());
+    OpTableVectorIteratorSkipBlocks(iter, filter_manager);
+    DISPATCH_NEXT();
+  }
+
   OP(TableVectorIteratorGetVPINumTuples) : {
     auto *num_tuples_vpi = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
@@ -1017,6 +1024,14 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(FilterManagerInitWithContext) : {
+    auto *filter_manager = frame->LocalAt<sql::FilterManager *>(READ_LOCAL_ID());
+    auto *exec_context = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto *context = frame->LocalAt<void *>(READ_LOCAL_ID());
+    OpFilterManagerInitWithContext(filter_manager, exec_context->GetExecutionSettings(), context);
+    DISPATCH_NEXT();
+  }
+
   OP(FilterManagerStartNewClause) : {
     auto *filter_manager = frame->LocalAt<sql::FilterManager *>(READ_LOCAL_ID());
     OpFilterManagerStartNewClause(filter_manager);
@@ -1031,6 +1046,15 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(FilterManagerInsertZoneMapTerm) : {
+    auto *filter_manager = frame->LocalAt<sql::FilterManager *>(READ_LOCAL_ID());
+    auto col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto comparison = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto value = frame->LocalAt<int64_t>(READ_LOCAL_ID());
+    OpFilterManagerInsertZoneMapTerm(filter_manager, col_idx, comparison, value);
+    DISPATCH_NEXT();
+  }
+
   OP(FilterManagerRunFilters) : {
     auto *filter_manager = frame->LocalAt<sql::FilterManager *>(READ_LOCAL_ID());
     auto *vpi = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
@@ -1413,6 +1437,17 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(AggregationHashTableEnableSpilling) : {
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto merge_partition_fn_id = READ_FUNC_ID();
+
+    auto merge_partition_fn = reinterpret_cast<sql::AggregationHashTable::MergePartitionFn>(
+        module_->GetRawFunctionImpl(merge_partition_fn_id));
+    OpAggregationHashTableEnableSpilling(agg_hash_table, query_state, merge_partition_fn);
+    DISPATCH_NEXT();
+  }
+
   OP(AggregationHashTableBuildAllHashTablePartitions) : {
     auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
     auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
@@ -1760,6 +1795,22 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableBuildBloomFilter) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableBuildBloomFilter(join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableProbeBloomFilter) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());
+    auto *tid_list = frame->LocalAt<sql::TupleIdList *>(READ_LOCAL_ID());
+    auto *key_cols = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
+    auto num_key_cols = READ_UIMM4();
+    OpJoinHashTableProbeBloomFilter(join_hash_table, vector_projection, tid_list, key_cols, num_key_cols);
+    DISPATCH_NEXT();
+  }
+
   OP(JoinHashTableLookup) : {
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
     auto *ht_entry_iter = frame->LocalAt<sql::HashTableEntryIterator *>(READ_LOCAL_ID());
@@ -1768,6 +1819,40 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableEnableSpilling) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto probe_tuple_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpJoinHashTableEnableSpilling(join_hash_table, probe_tuple_size);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableIsPartitionSpilled) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash_val = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    OpJoinHashTableIsPartitionSpilled(result, join_hash_table, hash_val);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableDeferProbe) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash_val = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    auto *probe_tuple = frame->LocalAt<const byte *>(READ_LOCAL_ID());
+    OpJoinHashTableDeferProbe(join_hash_table, hash_val, probe_tuple);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableProbeSpilledPartitions) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto *pipeline_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto probe_fn_id = READ_FUNC_ID();
+
+    auto probe_fn = reinterpret_cast<sql::JoinHashTable::ProbeSpilledFn>(module_->GetRawFunctionImpl(probe_fn_id));
+    OpJoinHashTableProbeSpilledPartitions(join_hash_table, query_state, pipeline_state, probe_fn);
+    DISPATCH_NEXT();
+  }
+
   OP(JoinHashTableFree) : {
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
     OpJoinHashTableFree(join_hash_table);
@@ -1836,6 +1921,15 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(SorterInitForIndex) : {
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    auto *exec_ctx = frame->LocalAt<noisepage::execution::exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto index_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+
+    OpSorterInitForIndex(sorter, exec_ctx, index_oid);
+    DISPATCH_NEXT();
+  }
+
   OP(SorterGetTupleCount) : {
     auto *result = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
     auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
@@ -1934,6 +2028,82 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  // -------------------------------------------------------
+  // Row Buffers
+  // -------------------------------------------------------
+
+  OP(RowBufferInit) : {
+    auto *buffer = frame->LocalAt<sql::RowBuffer *>(READ_LOCAL_ID());
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto row_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpRowBufferInit(buffer, exec_ctx, row_size);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferAllocRow) : {
+    auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
+    auto *buffer = frame->LocalAt<sql::RowBuffer *>(READ_LOCAL_ID());
+    OpRowBufferAllocRow(result, buffer);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferFinish) : {
+    auto *buffer = frame->LocalAt<sql::RowBuffer *>(READ_LOCAL_ID());
+    OpRowBufferFinish(buffer);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferFree) : {
+    auto *buffer = frame->LocalAt<sql::RowBuffer *>(READ_LOCAL_ID());
+    OpRowBufferFree(buffer);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferIteratorInit) : {
+    auto *iter = frame->LocalAt<sql::RowBufferIterator *>(READ_LOCAL_ID());
+    auto *buffer = frame->LocalAt<sql::RowBuffer *>(READ_LOCAL_ID());
+    OpRowBufferIteratorInit(iter, buffer);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferIteratorHasNext) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::RowBufferIterator *>(READ_LOCAL_ID());
+    OpRowBufferIteratorHasNext(has_more, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferIteratorNext) : {
+    auto *iter = frame->LocalAt<sql::RowBufferIterator *>(READ_LOCAL_ID());
+    OpRowBufferIteratorNext(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferIteratorGetRow) : {
+    const auto **row = frame->LocalAt<const byte **>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::RowBufferIterator *>(READ_LOCAL_ID());
+    OpRowBufferIteratorGetRow(row, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferIteratorMark) : {
+    auto *iter = frame->LocalAt<sql::RowBufferIterator *>(READ_LOCAL_ID());
+    OpRowBufferIteratorMark(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferIteratorRewind) : {
+    auto *iter = frame->LocalAt<sql::RowBufferIterator *>(READ_LOCAL_ID());
+    OpRowBufferIteratorRewind(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(RowBufferIteratorFree) : {
+    auto *iter = frame->LocalAt<sql::RowBufferIterator *>(READ_LOCAL_ID());
+    OpRowBufferIteratorFree(iter);
+    DISPATCH_NEXT();
+  }
+
   // -------------------------------------------------------
   // Output
   // -------------------------------------------------------
@@ -1967,19 +2137,16 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   // -------------------------------------------------------
   // CSV Reader
   // -------------------------------------------------------
-#if 0
+
   OP(CSVReaderInit) : {
-    auto *reader = frame->LocalAt<util::CSVReader *>(READ_LOCAL_ID());
+    auto *result = frame->LocalAt<util::CSVReader **>(READ_LOCAL_ID());
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
     auto *file_name = module_->GetBytecodeModule()->AccessStaticLocalDataRaw(LocalVar::Decode(READ_STATIC_LOCAL_ID()));
     auto length = READ_UIMM4();
-    OpCSVReaderInit(reader, file_name, length);
-    DISPATCH_NEXT();
-  }
-
-  OP(CSVReaderPerformInit) : {
-    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
-    auto *reader = frame->LocalAt<util::CSVReader *>(READ_LOCAL_ID());
-    OpCSVReaderPerformInit(result, reader);
+    auto delimiter = READ_IMM1();
+    auto quote = READ_IMM1();
+    auto escape = READ_IMM1();
+    OpCSVReaderInit(result, exec_ctx, file_name, length, delimiter, quote, escape);
     DISPATCH_NEXT();
   }
 
@@ -2005,12 +2172,23 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
-  OP(CSVReaderClose) : {
-    auto *reader = frame->LocalAt<util::CSVReader *>(READ_LOCAL_ID());
-    OpCSVReaderClose(reader);
+  OP(ParallelScanCSV) : {
+    auto *file_name = module_->GetBytecodeModule()->AccessStaticLocalDataRaw(LocalVar::Decode(READ_STATIC_LOCAL_ID()));
+    auto length = READ_UIMM4();
+    auto delimiter = READ_IMM1();
+    auto quote = READ_IMM1();
+    auto escape = READ_IMM1();
+    auto query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto num_threads_override = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto scan_fn_id = READ_FUNC_ID();
+
+    auto scan_fn = reinterpret_cast<sql::CSVScanner::ScanFn>(module_->GetRawFunctionImpl(scan_fn_id));
+    OpParallelScanCSV(file_name, length, delimiter, quote, escape, query_state, exec_ctx, num_threads_override,
+                      scan_fn);
     DISPATCH_NEXT();
   }
-#endif
+
   // -------------------------------------------------------
   // Index Iterator
   // -------------------------------------------------------
@@ -2039,12 +2217,36 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorEnableIndexOnly) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorEnableIndexOnly(iter);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorScanKey) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorScanKey(iter);
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorAddBatchKey) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorAddBatchKey(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorScanKeyBatch) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorScanKeyBatch(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorNextBatchKey) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorNextBatchKey(iter);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorScanAscending) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     auto scan_type = frame->LocalAt<storage::index::ScanType>(READ_LOCAL_ID());
@@ -2107,6 +2309,13 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorGetIndexOnlyPR) : {
+    auto *pr = frame->LocalAt<storage::ProjectedRow **>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorGetIndexOnlyPR(pr, iter);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorGetSlot) : {
     auto *slot = frame->LocalAt<storage::TupleSlot *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
@@ -2291,6 +2500,22 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(StorageInterfaceIndexBulkLoadInsert) : {
+    auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    auto *tuple_slot = frame->LocalAt<storage::TupleSlot *>(READ_LOCAL_ID());
+    OpStorageInterfaceIndexBulkLoadInsert(storage_interface, sorter, tuple_slot);
+    DISPATCH_NEXT();
+  }
+
+  OP(StorageInterfaceIndexBulkLoad) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    OpStorageInterfaceIndexBulkLoad(result, storage_interface, sorter);
+    DISPATCH_NEXT();
+  }
+
   OP(StorageInterfaceIndexDelete) : {
     auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
     auto *tuple_slot = frame->LocalAt<storage::TupleSlot *>(READ_LOCAL_ID());
@@ -17,6 +17,7 @@ class TransactionManager;
 }  // namespace noisepage::transaction
 
 namespace noisepage::storage {
+class CheckpointManager;
 class GarbageCollector;
 class RecoveryManager;
 }  // namespace noisepage::storage
@@ -140,6 +141,7 @@ class Catalog {
 
  private:
   DISALLOW_COPY_AND_MOVE(Catalog);
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
   friend class selfdriving::pilot::PilotUtil;
   const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
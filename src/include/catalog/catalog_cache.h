@@ -6,6 +6,7 @@
 
 #include "catalog/catalog_defs.h"
 #include "common/managed_pointer.h"
+#include "common/spin_latch.h"
 #include "transaction/transaction_defs.h"
 
 namespace noisepage::storage {
@@ -37,6 +38,7 @@ class CatalogCache {
    * @param now start time of the TransactionContext performing the reset
    */
   void Reset(const transaction::timestamp_t now) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     oldest_entry_ = now;
     pointers_.clear();
     indexes_.clear();
@@ -49,6 +51,7 @@ class CatalogCache {
 
  private:
   common::ManagedPointer<storage::SqlTable> GetTable(const table_oid_t table) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     const auto key = table.UnderlyingValue();
     const auto it = pointers_.find(key);
     if (it != pointers_.end()) {
@@ -59,13 +62,16 @@ class CatalogCache {
   }
 
   void PutTable(const table_oid_t table, const common::ManagedPointer<storage::SqlTable> table_ptr) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     const auto key = table.UnderlyingValue();
     const auto value = reinterpret_cast<uintptr_t>(table_ptr.Get());
-    NOISEPAGE_ASSERT(pointers_.count(key) == 0, "Shouldn't be inserting something that already exists.");
-    pointers_[key] = value;
+    // Threads sharing the cache may both miss and then insert the same entry
+    UNUSED_ATTRIBUTE const auto inserted = pointers_.emplace(key, value);
+    NOISEPAGE_ASSERT(inserted.first->second == value, "Cached pointer should not change.");
   }
 
   common::ManagedPointer<storage::index::Index> GetIndex(const index_oid_t index) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     const auto key = index.UnderlyingValue();
     const auto it = pointers_.find(key);
     if (it != pointers_.end()) {
@@ -76,13 +82,16 @@ class CatalogCache {
   }
 
   void PutIndex(const index_oid_t index, const common::ManagedPointer<storage::index::Index> index_ptr) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     const auto key = index.UnderlyingValue();
     const auto value = reinterpret_cast<uintptr_t>(index_ptr.Get());
-    NOISEPAGE_ASSERT(pointers_.count(key) == 0, "Shouldn't be inserting something that already exists.");
-    pointers_[key] = value;
+    // Threads sharing the cache may both miss and then insert the same entry
+    UNUSED_ATTRIBUTE const auto inserted = pointers_.emplace(key, value);
+    NOISEPAGE_ASSERT(inserted.first->second == value, "Cached pointer should not change.");
   }
 
   std::pair<bool, std::vector<index_oid_t>> GetIndexOids(const table_oid_t table) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     const auto it = indexes_.find(table);
     if (it != indexes_.end()) {
       // return true to indicate table was found, but list could still be empty
@@ -93,8 +102,9 @@ class CatalogCache {
   }
 
   void PutIndexOids(const table_oid_t table, std::vector<index_oid_t> indexes) {
-    NOISEPAGE_ASSERT(indexes_.count(table) == 0, "Shouldn't be inserting something that already exists.");
-    indexes_[table] = std::move(indexes);
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    // Threads sharing the cache may both miss and then insert the same entry
+    indexes_.emplace(table, std::move(indexes));
   }
 
   friend class CatalogAccessor;
@@ -102,6 +112,8 @@ class CatalogCache {
   std::unordered_map<uint32_t, uintptr_t> pointers_;
   std::unordered_map<table_oid_t, std::vector<index_oid_t>> indexes_;
   transaction::timestamp_t oldest_entry_ = transaction::INITIAL_TXN_TIMESTAMP;
+  // Parallel optimizer tasks share the CatalogAccessor, and with it the cache, of their connection
+  common::SpinLatch latch_;
 };
 
 }  // namespace noisepage::catalog
@@ -22,6 +22,7 @@ class TransactionContext;
 }
 
 namespace noisepage::storage {
+class CheckpointManager;
 class GarbageCollector;
 class RecoveryManager;
 class SqlTable;
@@ -210,9 +211,10 @@ class DatabaseCatalog {
   friend class postgres::PgTypeImpl;
   friend class postgres::PgStatisticImpl;
   ///@}
-  friend class Catalog;                   ///< Accesses write_lock_ (creating accessor) and TearDown (cleanup).
-  friend class postgres::Builder;         ///< Initializes DatabaseCatalog's tables.
-  friend class storage::RecoveryManager;  ///< Directly modifies DatabaseCatalog's tables.
+  friend class Catalog;                     ///< Accesses write_lock_ (creating accessor) and TearDown (cleanup).
+  friend class postgres::Builder;           ///< Initializes DatabaseCatalog's tables.
+  friend class storage::RecoveryManager;    ///< Directly modifies DatabaseCatalog's tables.
+  friend class storage::CheckpointManager;  ///< Scans pg_class for the tables to checkpoint.
 
   // Miscellaneous state.
   std::atomic<uint32_t> next_oid_;                    ///< The next OID, shared across different pg tables.
@@ -53,6 +53,8 @@ class IndexOptions {
     BPLUSTREE_INNER_NODE_UPPER_THRESHOLD,
     /** B+Tree Inner node merge threshold */
     BPLUSTREE_INNER_NODE_LOWER_THRESHOLD,
+    /** Percentage of each B+Tree node that bulk loading fills */
+    BPLUSTREE_FILL_FACTOR,
 
     UNKNOWN
   };
@@ -72,6 +74,8 @@ class IndexOptions {
       knob = BPLUSTREE_INNER_NODE_UPPER_THRESHOLD;
     } else if (option == "BPLUSTREE_INNER_NODE_LOWER_THRESHOLD") {
       knob = BPLUSTREE_INNER_NODE_LOWER_THRESHOLD;
+    } else if (option == "BPLUSTREE_FILL_FACTOR") {
+      knob = BPLUSTREE_FILL_FACTOR;
     }
     return knob;
   }
@@ -89,6 +93,8 @@ class IndexOptions {
         return "BPLUSTREE_INNER_NODE_UPPER_THRESHOLD";
       case BPLUSTREE_INNER_NODE_LOWER_THRESHOLD:
         return "BPLUSTREE_INNER_NODE_LOWER_THRESHOLD";
+      case BPLUSTREE_FILL_FACTOR:
+        return "BPLUSTREE_FILL_FACTOR";
       case UNKNOWN:
       default:
         return "UNKNOWN";
@@ -108,6 +114,8 @@ class IndexOptions {
         return execution::sql::SqlTypeId::Integer;
       case BPLUSTREE_INNER_NODE_LOWER_THRESHOLD:
         return execution::sql::SqlTypeId::Integer;
+      case BPLUSTREE_FILL_FACTOR:
+        return execution::sql::SqlTypeId::Integer;
       case UNKNOWN:
       default:
         return execution::sql::SqlTypeId::Invalid;
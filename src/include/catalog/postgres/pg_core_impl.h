@@ -21,6 +21,7 @@ class FunctionContext;
 }  // namespace noisepage::execution::functions
 
 namespace noisepage::storage {
+class CheckpointManager;
 class GarbageCollector;
 class RecoveryManager;
 class SqlTable;
@@ -40,9 +41,10 @@ class Builder;
 /** The NoisePage version of pg_namespace, pg_class, pg_index, and pg_attribute. */
 class PgCoreImpl {
  private:
-  friend class Builder;                   ///< The builder is used to construct the core catalog tables.
-  friend class catalog::DatabaseCatalog;  ///< DatabaseCatalog sets up and owns the core catalog tables.
-  friend class storage::RecoveryManager;  ///< The RM accesses tables and indexes without going through the catalog.
+  friend class Builder;                     ///< The builder is used to construct the core catalog tables.
+  friend class catalog::DatabaseCatalog;    ///< DatabaseCatalog sets up and owns the core catalog tables.
+  friend class storage::RecoveryManager;    ///< The RM accesses tables and indexes without going through the catalog.
+  friend class storage::CheckpointManager;  ///< Scans pg_class for the tables to checkpoint.
 
   /**
    * @brief Prepare to create the core catalog tables: pg_namespace, pg_class, pg_index, and pg_attribute.
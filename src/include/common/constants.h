@@ -126,5 +126,17 @@ struct Constants {
    * Flag indicating if static partitioner is used
    */
   static constexpr const bool IS_STATIC_PARTITIONER_ENABLED = false;
+
+  /**
+   * The number of bytes a single query may allocate before its operators spill to disk. Zero means
+   * there is no limit. This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint64_t QUERY_MEMORY_BUDGET = 0;
+
+  /**
+   * The directory where operators write temporary spill files.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const char *SPILL_FILE_DIRECTORY = "/tmp/";
 };
 }  // namespace noisepage::common
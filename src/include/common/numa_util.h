@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "common/macros.h"
+
+namespace noisepage::common {
+
+/**
+ * Static helpers for placing memory and threads on the NUMA nodes of the machine. The topology is read from sysfs and
+ * the placement is done with raw system calls, so there is no dependency on libnuma. On machines or platforms without
+ * NUMA, every call behaves as if there was a single node holding all of the CPUs.
+ */
+class NumaUtil {
+ public:
+  /** This class cannot be instantiated. */
+  DISALLOW_INSTANTIATION(NumaUtil);
+
+  /** Largest number of nodes that is supported, nodes beyond it are treated as node 0 */
+  static constexpr uint32_t MAX_NODES = 64;
+
+  /** Directory the NUMA topology of the machine is read from */
+  static constexpr const char *SYSFS_NODE_DIR = "/sys/devices/system/node";
+
+  /**
+   * @return number of NUMA node ids of the machine, which is one more than the largest id of a node that is online.
+   * Node ids need not be contiguous, and the ids in between belong to nodes without any CPUs.
+   */
+  static uint32_t NumNodes();
+
+  /** @return NUMA node of the CPU the calling thread is currently running on */
+  static uint32_t CurrentNode();
+
+  /**
+   * Ask the kernel to place the pages of the given memory range on the given node when they are first touched. Pages
+   * go to other nodes when the node runs out of memory.
+   * @param ptr start of the range, aligned to the page size
+   * @param size size of the range
+   * @param node node to place the pages on
+   */
+  static void BindToNode(void *ptr, std::size_t size, uint32_t node);
+
+  /**
+   * Restrict the calling thread to run on the CPUs of the given node, until UnpinThread() is called.
+   * @param node node to run on
+   * @return true if the thread was pinned
+   */
+  static bool PinThreadToNode(uint32_t node);
+
+  /** Let the calling thread run on the CPUs it could run on before it was last pinned by PinThreadToNode(). */
+  static void UnpinThread();
+
+  /**
+   * Read the NUMA topology from a directory laid out like SYSFS_NODE_DIR, and use it instead of the current one. Tests
+   * use it to emulate machines with other topologies.
+   * @param node_dir directory with the list of online nodes, and the list of CPUs of each of them
+   */
+  static void LoadTopology(const std::string &node_dir);
+};
+
+}  // namespace noisepage::common
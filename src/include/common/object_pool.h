@@ -1,10 +1,14 @@
 #pragma once
 
-#include <queue>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/allocator.h"
+#include "common/constants.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 
@@ -46,11 +50,30 @@ class AllocatorFailureException : public std::exception {
   const char *what() const noexcept override { return "Allocator fails to allocate memory.\n"; }
 };
 
+namespace detail {
+/**
+ * @return index of the calling thread, handed out in the order in which threads first ask for it. Object pools use it
+ *         to pick the cache of the thread.
+ */
+inline uint32_t ThisThreadIndex() {
+  static std::atomic<uint32_t> next_index{0};
+  static thread_local const uint32_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+}  // namespace detail
+
 /**
  * Object pool for memory allocation.
  *
  * This prevents liberal calls to malloc and new in the code and makes tracking
  * our memory performance easier.
+ *
+ * The pool is built like the magazine layer of a slab allocator. Every thread keeps a cache of up to two magazines
+ * (fixed-size stacks of objects), so most calls to Get() and Release() touch memory that is only used by the calling
+ * thread. Threads exchange full and empty magazines through a depot of lock-free stacks, and only fall back to a latch
+ * to allocate new objects or to change the limits of the pool. The caches are sized off the reuse limit and the depot
+ * is kept small enough that the pool never holds more than reuse limit reusable objects. With a small reuse limit the
+ * caches are turned off, and every object goes through the depot on its own.
  * @tparam T the type of objects in the pool.
  * @tparam The allocator to use when constructing and destructing a new object.
  *         In most cases it can be left out and the default allocator will
@@ -63,6 +86,11 @@ class AllocatorFailureException : public std::exception {
 template <typename T, class Allocator = ByteAlignedAllocator<T>>
 class ObjectPool {
  public:
+  /** Most objects a magazine can hold */
+  static constexpr uint32_t MAGAZINE_SIZE = 32;
+  /** Number of thread caches, threads beyond this many share caches */
+  static constexpr uint32_t NUM_CACHES = 64;
+
   /**
    * Initializes a new object pool with the supplied limit to the number of
    * objects reused.
@@ -70,8 +98,11 @@ class ObjectPool {
    * @param size_limit the maximum number of objects the object pool controls
    * @param reuse_limit the maximum number of reusable objects
    */
-  ObjectPool(uint64_t size_limit, uint64_t reuse_limit)
-      : size_limit_(size_limit), reuse_limit_(reuse_limit), current_size_(0) {}
+  ObjectPool(uint64_t size_limit, uint64_t reuse_limit) : size_limit_(size_limit), current_size_(0) {
+    SetLimits(reuse_limit);
+  }
+
+  DISALLOW_COPY_AND_MOVE(ObjectPool)
 
   /**
    * Destructs the memory pool. Frees any memory it holds.
@@ -80,12 +111,18 @@ class ObjectPool {
    * not explicitly released via a Release call.
    */
   ~ObjectPool() {
-    T *result = nullptr;
-    while (!reuse_queue_.empty()) {
-      result = reuse_queue_.front();
-      alloc_.Delete(result);
-      reuse_queue_.pop();
+    for (auto &cache : caches_) {
+      for (Magazine *magazine : {cache.loaded_, cache.previous_}) {
+        if (magazine == nullptr) continue;
+        for (uint32_t i = 0; i < magazine->size_; i++) alloc_.Delete(magazine->objects_[i]);
+        delete magazine;
+      }
+    }
+    for (Magazine *magazine = full_.Pop(); magazine != nullptr; magazine = full_.Pop()) {
+      for (uint32_t i = 0; i < magazine->size_; i++) alloc_.Delete(magazine->objects_[i]);
+      delete magazine;
     }
+    for (Magazine *magazine = empty_.Pop(); magazine != nullptr; magazine = empty_.Pop()) delete magazine;
   }
 
   /**
@@ -95,20 +132,20 @@ class ObjectPool {
    * @return pointer to memory that can hold T
    */
   T *Get() {
-    SpinLatch::ScopedSpinLatch guard(&latch_);
-    if (reuse_queue_.empty() && current_size_ >= size_limit_) throw NoMoreObjectException(size_limit_);
-    T *result = nullptr;
-    if (reuse_queue_.empty()) {
-      result = alloc_.New();  // result could be null because the allocator may not find enough memory space
-      if (result != nullptr) current_size_++;
-    } else {
-      result = reuse_queue_.front();
-      reuse_queue_.pop();
-      alloc_.Reuse(result);
+    Cache *const cache = &caches_[detail::ThisThreadIndex() % NUM_CACHES];
+    T *result;
+    {
+      SpinLatch::ScopedSpinLatch guard(&cache->latch_);
+      result = TakeFromCache(cache);
     }
-    // If result is nullptr. The call to alloc_.New() failed (i.e. can't allocate more memory from the system).
-    if (result == nullptr) throw AllocatorFailureException();
-    NOISEPAGE_ASSERT(current_size_ <= size_limit_, "Object pool has exceeded its size limit.");
+    if (result == nullptr) {
+      result = Allocate();
+      if (result != nullptr) return result;
+      // The pool is full, but other threads may still hold on to reusable objects in their caches
+      result = TakeFromOtherCaches(cache);
+      if (result == nullptr) throw NoMoreObjectException(size_limit_);
+    }
+    alloc_.Reuse(result);
     return result;
   }
 
@@ -124,7 +161,7 @@ class ObjectPool {
   bool SetSizeLimit(uint64_t new_size) {
     SpinLatch::ScopedSpinLatch guard(&latch_);
     if (new_size >= current_size_) {
-      // current_size_ might increase and become > new_size if we don't use lock
+      // current_size_ only grows under the latch, so it cannot become > new_size
       size_limit_ = new_size;
       NOISEPAGE_ASSERT(current_size_ <= size_limit_, "object pool size exceed its size limit");
       return true;
@@ -145,17 +182,39 @@ class ObjectPool {
    *
    * If it's 0, then the object pool just never reuse object.
    *
+   * The caches are resized to the new limit, so all the reusable objects are gathered from the caches and the depot,
+   * and handed back to the depot up to the new limit. Calls to Get() and Release() that run at the same time may still
+   * see the old limit.
+   *
    * @param new_reuse_limit
    */
   void SetReuseLimit(uint64_t new_reuse_limit) {
     SpinLatch::ScopedSpinLatch guard(&latch_);
-    reuse_limit_ = new_reuse_limit;
-    T *obj = nullptr;
-    while (reuse_queue_.size() > reuse_limit_) {
-      obj = reuse_queue_.front();
-      alloc_.Delete(obj);
-      reuse_queue_.pop();
-      current_size_--;
+    SetLimits(new_reuse_limit);
+
+    std::vector<T *> reusable;
+    for (auto &cache : caches_) {
+      SpinLatch::ScopedSpinLatch cache_guard(&cache.latch_);
+      for (Magazine *magazine : {cache.loaded_, cache.previous_}) {
+        if (magazine == nullptr) continue;
+        reusable.insert(reusable.end(), magazine->objects_, magazine->objects_ + magazine->size_);
+        magazine->size_ = 0;
+      }
+    }
+    for (Magazine *magazine = full_.Pop(); magazine != nullptr; magazine = full_.Pop()) {
+      depot_size_.fetch_sub(magazine->size_);
+      reusable.insert(reusable.end(), magazine->objects_, magazine->objects_ + magazine->size_);
+      magazine->size_ = 0;
+      empty_.Push(magazine);
+    }
+
+    // Depot magazines must not hold more objects than a cache can take in
+    const uint32_t per_magazine = std::max(cache_rounds_.load(), 1U);
+    for (uint64_t begin = 0; begin < reusable.size(); begin += per_magazine) {
+      Magazine *const magazine = TakeEmptyMagazine();
+      magazine->size_ = static_cast<uint32_t>(std::min<uint64_t>(per_magazine, reusable.size() - begin));
+      std::copy(reusable.begin() + begin, reusable.begin() + begin + magazine->size_, magazine->objects_);
+      Deposit(magazine);
     }
   }
 
@@ -168,13 +227,28 @@ class ObjectPool {
    */
   void Release(T *obj) {
     NOISEPAGE_ASSERT(obj != nullptr, "releasing a null pointer");
-    SpinLatch::ScopedSpinLatch guard(&latch_);
-    if (reuse_queue_.size() >= reuse_limit_) {
-      alloc_.Delete(obj);
-      current_size_--;
-    } else {
-      reuse_queue_.push(obj);
+    const uint32_t rounds = cache_rounds_.load(std::memory_order_relaxed);
+    if (rounds > 0) {
+      Cache *const cache = &caches_[detail::ThisThreadIndex() % NUM_CACHES];
+      SpinLatch::ScopedSpinLatch guard(&cache->latch_);
+      if (cache->loaded_ == nullptr || cache->loaded_->size_ >= rounds) {
+        if (cache->previous_ != nullptr && cache->previous_->size_ < rounds) {
+          std::swap(cache->loaded_, cache->previous_);
+        } else {
+          // Both magazines are full, hand the older one to the depot
+          if (cache->previous_ != nullptr) Deposit(cache->previous_);
+          cache->previous_ = cache->loaded_;
+          cache->loaded_ = TakeEmptyMagazine();
+        }
+      }
+      cache->loaded_->objects_[cache->loaded_->size_++] = obj;
+      return;
     }
+
+    Magazine *const magazine = TakeEmptyMagazine();
+    magazine->objects_[0] = obj;
+    magazine->size_ = 1;
+    Deposit(magazine);
   }
 
   /**
@@ -183,15 +257,161 @@ class ObjectPool {
   uint64_t GetSizeLimit() const { return size_limit_; }
 
  private:
+  // A stack of objects that is moved between the caches and the depot as a whole
+  struct Magazine {
+    std::atomic<Magazine *> next_{nullptr};  // Next magazine in a depot stack
+    uint32_t size_ = 0;
+    T *objects_[MAGAZINE_SIZE];
+  };
+
+  // Lock-free stack of magazines. The top is tagged with a version that changes on every push and pop, and the two are
+  // swapped together with a 16-byte CAS, so a pop cannot succeed on a top that was popped and pushed back in between
+  // (ABA). Magazines are only freed with the pool, so reading the next pointer of a magazine that was just popped by
+  // another thread is safe.
+  class MagazineStack {
+   public:
+    void Push(Magazine *const magazine) {
+      uint128_t head = Load();
+      while (true) {
+        magazine->next_.store(Top(head), std::memory_order_relaxed);
+        const uint128_t prev = __sync_val_compare_and_swap(&head_, head, Pack(magazine, Version(head) + 1));
+        if (prev == head) return;
+        head = prev;
+      }
+    }
+
+    Magazine *Pop() {
+      uint128_t head = Load();
+      while (Top(head) != nullptr) {
+        Magazine *const next = Top(head)->next_.load(std::memory_order_relaxed);
+        const uint128_t prev = __sync_val_compare_and_swap(&head_, head, Pack(next, Version(head) + 1));
+        if (prev == head) return Top(head);
+        head = prev;
+      }
+      return nullptr;
+    }
+
+   private:
+    static uint128_t Pack(Magazine *const top, const uint64_t version) {
+      return (static_cast<uint128_t>(version) << 64) | reinterpret_cast<uintptr_t>(top);
+    }
+    static Magazine *Top(const uint128_t head) {
+      return reinterpret_cast<Magazine *>(static_cast<uintptr_t>(static_cast<uint64_t>(head)));
+    }
+    static uint64_t Version(const uint128_t head) { return static_cast<uint64_t>(head >> 64); }
+    // A CAS that does not change anything is an atomic 16-byte load
+    uint128_t Load() { return __sync_val_compare_and_swap(&head_, 0, 0); }
+
+    alignas(16) uint128_t head_ = 0;
+  };
+
+  struct alignas(Constants::CACHELINE_SIZE) Cache {
+    SpinLatch latch_;  // Only contended when threads share the cache, or when other threads drain it
+    Magazine *loaded_ = nullptr;
+    Magazine *previous_ = nullptr;  // Keeps a thread that alternates calls from going to the depot every time
+  };
+
+  // Derive the size of the caches and the depot from the reuse limit. The caches take up at most half of it.
+  void SetLimits(const uint64_t reuse_limit) {
+    reuse_limit_ = reuse_limit;
+    const auto rounds = static_cast<uint32_t>(std::min<uint64_t>(MAGAZINE_SIZE, reuse_limit / (4 * NUM_CACHES)));
+    cache_rounds_.store(rounds);
+    depot_limit_.store(reuse_limit - uint64_t{2} * NUM_CACHES * rounds);
+  }
+
+  // Pop an object out of the cache, refilling it from the depot if needed. The cache latch must be held.
+  T *TakeFromCache(Cache *const cache) {
+    if (cache->loaded_ == nullptr || cache->loaded_->size_ == 0) {
+      if (cache->previous_ != nullptr && cache->previous_->size_ > 0) {
+        std::swap(cache->loaded_, cache->previous_);
+      } else {
+        Magazine *const full = full_.Pop();
+        if (full == nullptr) return nullptr;
+        depot_size_.fetch_sub(full->size_);
+        if (cache_rounds_.load(std::memory_order_relaxed) == 0) {
+          // The caches are turned off, so the magazine goes straight back to the depot
+          T *const result = full->objects_[--full->size_];
+          Deposit(full);
+          return result;
+        }
+        if (cache->previous_ != nullptr) empty_.Push(cache->previous_);
+        cache->previous_ = cache->loaded_;
+        cache->loaded_ = full;
+      }
+    }
+    return cache->loaded_->objects_[--cache->loaded_->size_];
+  }
+
+  // Look for a reusable object in the depot once more, and then in the caches of other threads
+  T *TakeFromOtherCaches(Cache *const own) {
+    {
+      SpinLatch::ScopedSpinLatch guard(&own->latch_);
+      T *const result = TakeFromCache(own);
+      if (result != nullptr) return result;
+    }
+    for (auto &cache : caches_) {
+      if (&cache == own) continue;
+      SpinLatch::ScopedSpinLatch guard(&cache.latch_);
+      for (Magazine *magazine : {cache.loaded_, cache.previous_}) {
+        if (magazine != nullptr && magazine->size_ > 0) return magazine->objects_[--magazine->size_];
+      }
+    }
+    return nullptr;
+  }
+
+  // Allocate a new object, or return nullptr if the pool has reached its size limit
+  T *Allocate() {
+    {
+      SpinLatch::ScopedSpinLatch guard(&latch_);
+      if (current_size_ >= size_limit_) return nullptr;
+      current_size_++;
+    }
+    T *const result = alloc_.New();
+    // If result is nullptr. The call to alloc_.New() failed (i.e. can't allocate more memory from the system).
+    if (result == nullptr) {
+      current_size_--;
+      throw AllocatorFailureException();
+    }
+    return result;
+  }
+
+  Magazine *TakeEmptyMagazine() {
+    Magazine *const magazine = empty_.Pop();
+    return magazine == nullptr ? new Magazine : magazine;
+  }
+
+  // Hand a magazine to the depot. Objects beyond the depot limit are freed, and empty magazines are kept for reuse.
+  void Deposit(Magazine *const magazine) {
+    uint64_t size = depot_size_.load();
+    uint32_t admitted;
+    do {
+      const uint64_t limit = depot_limit_.load();
+      admitted = size >= limit ? 0 : static_cast<uint32_t>(std::min<uint64_t>(magazine->size_, limit - size));
+    } while (admitted > 0 && !depot_size_.compare_exchange_weak(size, size + admitted));
+
+    while (magazine->size_ > admitted) {
+      alloc_.Delete(magazine->objects_[--magazine->size_]);
+      current_size_--;
+    }
+    if (magazine->size_ > 0) {
+      full_.Push(magazine);
+    } else {
+      empty_.Push(magazine);
+    }
+  }
+
   Allocator alloc_;
-  SpinLatch latch_;
-  // TODO(yangjuns): We don't need to reuse objects in a FIFO pattern. We could potentially pass a second template
-  // parameter to define the backing container for the std::queue. That way we can measure each backing container.
-  std::queue<T *> reuse_queue_;
+  SpinLatch latch_;  // Guards the limits, and the growth of current_size_
+  std::array<Cache, NUM_CACHES> caches_;
+  MagazineStack full_;   // Depot of magazines holding reusable objects
+  MagazineStack empty_;  // Depot of empty magazines
   uint64_t size_limit_;   // the maximum number of objects a object pool can have
-  uint64_t reuse_limit_;  // the maximum number of reusable objects in reuse_queue
+  uint64_t reuse_limit_;  // the maximum number of reusable objects in the caches and the depot
+  std::atomic<uint32_t> cache_rounds_;   // Most objects a cache keeps in each of its magazines
+  std::atomic<uint64_t> depot_limit_;    // Most objects the depot keeps, the rest of the reuse limit is for caches
+  std::atomic<uint64_t> depot_size_{0};  // Number of objects in the depot
   // current_size_ represents the number of objects the object pool has allocated,
-  // including objects that have been given out to callers and those reside in reuse_queue
-  uint64_t current_size_;
+  // including objects that have been given out to callers and those reside in the caches and the depot
+  std::atomic<uint64_t> current_size_;
 };
 }  // namespace noisepage::common
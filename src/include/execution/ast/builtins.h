@@ -58,6 +58,7 @@ namespace noisepage::execution::ast {
   F(TableIterGetVPINumTuples, tableIterGetVPINumTuples)                 \
   F(TableIterGetVPI, tableIterGetVPI)                                   \
   F(TableIterClose, tableIterClose)                                     \
+  F(TableIterSkipBlocks, tableIterSkipBlocks)                           \
   F(TableIterParallel, iterateTableParallel)                            \
   F(TableIterCreateIndexParallel, iterateTableCreateIndexParallel)      \
                                                                         \
@@ -144,6 +145,7 @@ namespace noisepage::execution::ast {
   /* Filter Manager */                                                  \
   F(FilterManagerInit, filterManagerInit)                               \
   F(FilterManagerInsertFilter, filterManagerInsertFilter)               \
+  F(FilterManagerInsertZoneMapTerm, filterManagerInsertZoneMapTerm)     \
   F(FilterManagerRunFilters, filterManagerRunFilters)                   \
   F(FilterManagerFree, filterManagerFree)                               \
   /* Filter Execution */                                                \
@@ -165,6 +167,7 @@ namespace noisepage::execution::ast {
   F(AggHashTableLookup, aggHTLookup)                                    \
   F(AggHashTableProcessBatch, aggHTProcessBatch)                        \
   F(AggHashTableMovePartitions, aggHTMoveParts)                         \
+  F(AggHashTableEnableSpilling, aggHTEnableSpilling)                    \
   F(AggHashTableParallelPartitionedScan, aggHTParallelPartScan)         \
   F(AggHashTableFree, aggHTFree)                                        \
   F(AggHashTableIterInit, aggHTIterInit)                                \
@@ -189,8 +192,14 @@ namespace noisepage::execution::ast {
   F(JoinHashTableInsert, joinHTInsert)                                  \
   F(JoinHashTableBuild, joinHTBuild)                                    \
   F(JoinHashTableBuildParallel, joinHTBuildParallel)                    \
+  F(JoinHashTableBuildBloomFilter, joinHTBuildBloomFilter)              \
+  F(JoinHashTableProbeBloomFilter, joinHTProbeBloomFilter)              \
   F(JoinHashTableGetTupleCount, joinHTGetTupleCount)                    \
   F(JoinHashTableLookup, joinHTLookup)                                  \
+  F(JoinHashTableEnableSpilling, joinHTEnableSpilling)                  \
+  F(JoinHashTableIsPartitionSpilled, joinHTIsPartitionSpilled)          \
+  F(JoinHashTableDeferProbe, joinHTDeferProbe)                          \
+  F(JoinHashTableProbeSpilled, joinHTProbeSpilled)                      \
   F(JoinHashTableFree, joinHTFree)                                      \
                                                                         \
   /* Hash Table Entry Iterator (for hash joins) */                      \
@@ -205,6 +214,7 @@ namespace noisepage::execution::ast {
                                                                         \
   /* Sorting */                                                         \
   F(SorterInit, sorterInit)                                             \
+  F(SorterInitForIndex, sorterInitForIndex)                             \
   F(SorterGetTupleCount, sorterGetTupleCount)                           \
   F(SorterInsert, sorterInsert)                                         \
   F(SorterInsertTopK, sorterInsertTopK)                                 \
@@ -220,6 +230,19 @@ namespace noisepage::execution::ast {
   F(SorterIterGetRow, sorterIterGetRow)                                 \
   F(SorterIterClose, sorterIterClose)                                   \
                                                                         \
+  /* Row Buffers */                                                     \
+  F(RowBufferInit, rowBufferInit)                                       \
+  F(RowBufferInsert, rowBufferInsert)                                   \
+  F(RowBufferFinish, rowBufferFinish)                                   \
+  F(RowBufferFree, rowBufferFree)                                       \
+  F(RowBufferIterInit, rowBufferIterInit)                               \
+  F(RowBufferIterHasNext, rowBufferIterHasNext)                         \
+  F(RowBufferIterNext, rowBufferIterNext)                               \
+  F(RowBufferIterGetRow, rowBufferIterGetRow)                           \
+  F(RowBufferIterMark, rowBufferIterMark)                               \
+  F(RowBufferIterRewind, rowBufferIterRewind)                           \
+  F(RowBufferIterClose, rowBufferIterClose)                             \
+                                                                        \
   /* Output */                                                          \
   F(ResultBufferNew, resultBufferNew)                                   \
   F(ResultBufferAllocOutRow, resultBufferAllocRow)                      \
@@ -229,7 +252,11 @@ namespace noisepage::execution::ast {
   /* Index */                                                           \
   F(IndexIteratorInit, indexIteratorInit)                               \
   F(IndexIteratorGetSize, indexIteratorGetSize)                         \
+  F(IndexIteratorEnableIndexOnly, indexIteratorEnableIndexOnly)         \
   F(IndexIteratorScanKey, indexIteratorScanKey)                         \
+  F(IndexIteratorAddBatchKey, indexIteratorAddBatchKey)                 \
+  F(IndexIteratorScanKeyBatch, indexIteratorScanKeyBatch)               \
+  F(IndexIteratorNextBatchKey, indexIteratorNextBatchKey)               \
   F(IndexIteratorScanAscending, indexIteratorScanAscending)             \
   F(IndexIteratorScanDescending, indexIteratorScanDescending)           \
   F(IndexIteratorScanLimitDescending, indexIteratorScanLimitDescending) \
@@ -239,6 +266,7 @@ namespace noisepage::execution::ast {
   F(IndexIteratorGetHiPR, indexIteratorGetHiPR)                         \
   F(IndexIteratorGetSlot, indexIteratorGetSlot)                         \
   F(IndexIteratorGetTablePR, indexIteratorGetTablePR)                   \
+  F(IndexIteratorGetIndexOnlyPR, indexIteratorGetIndexOnlyPR)           \
   F(IndexIteratorFree, indexIteratorFree)                               \
                                                                         \
   /* Projected Row Operations */                                        \
@@ -287,7 +315,7 @@ namespace noisepage::execution::ast {
   F(CSVReaderAdvance, csvReaderAdvance)                                 \
   F(CSVReaderGetField, csvReaderGetField)                               \
   F(CSVReaderGetRecordNumber, csvReaderGetRecordNumber)                 \
-  F(CSVReaderClose, csvReaderClose)                                     \
+  F(CSVScanParallel, iterateCSVParallel)                                \
                                                                         \
   /* SQL Table Calls */                                                 \
   F(StorageInterfaceInit, storageInterfaceInit)                         \
@@ -301,6 +329,8 @@ namespace noisepage::execution::ast {
   F(IndexInsert, indexInsert)                                           \
   F(IndexInsertUnique, indexInsertUnique)                               \
   F(IndexInsertWithSlot, indexInsertWithSlot)                           \
+  F(IndexBulkLoadInsert, indexBulkLoadInsert)                           \
+  F(IndexBulkLoad, indexBulkLoad)                                       \
   F(IndexDelete, indexDelete)                                           \
   F(StorageInterfaceFree, storageInterfaceFree)                         \
   /* Trig */                                                            \
@@ -61,7 +61,7 @@ class Context;
   NON_PRIM(AHTIterator, noisepage::execution::sql::AHTIterator)                                   \
   NON_PRIM(AHTVectorIterator, noisepage::execution::sql::AHTVectorIterator)                       \
   NON_PRIM(AHTOverflowPartitionIterator, noisepage::execution::sql::AHTOverflowPartitionIterator) \
-  /* NON_PRIM(CSVReader, noisepage::execution::util::CSVReader)                                */ \
+  NON_PRIM(CSVReader, noisepage::execution::util::CSVReader)                                      \
   NON_PRIM(OutputBuffer, noisepage::execution::exec::OutputBuffer)                                \
   NON_PRIM(ExecutionContext, noisepage::execution::exec::ExecutionContext)                        \
   NON_PRIM(ExecOUFeatureVector, noisepage::selfdriving::ExecOUFeatureVector)                      \
@@ -73,6 +73,8 @@ class Context;
   NON_PRIM(MemoryPool, noisepage::execution::sql::MemoryPool)                                     \
   NON_PRIM(Sorter, noisepage::execution::sql::Sorter)                                             \
   NON_PRIM(SorterIterator, noisepage::execution::sql::SorterIterator)                             \
+  NON_PRIM(RowBuffer, noisepage::execution::sql::RowBuffer)                                       \
+  NON_PRIM(RowBufferIterator, noisepage::execution::sql::RowBufferIterator)                       \
   NON_PRIM(TableVectorIterator, noisepage::execution::sql::TableVectorIterator)                   \
   NON_PRIM(ThreadStateContainer, noisepage::execution::sql::ThreadStateContainer)                 \
   NON_PRIM(TupleIdList, noisepage::execution::sql::TupleIdList)                                   \
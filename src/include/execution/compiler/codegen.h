@@ -585,6 +585,14 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *TableIterClose(ast::Expr *table_iter);
 
+  /**
+   * Call \@tableIterSkipBlocks(). Skip the blocks whose zone maps show that none of their tuples can pass the filter.
+   * @param table_iter The table vector iterator.
+   * @param filter_manager The filter manager pointer.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *TableIterSkipBlocks(ast::Expr *table_iter, ast::Expr *filter_manager);
+
   /**
    * Call \@iterateTableParallel(). Performs a parallel scan over the table with the provided name,
    * using the provided query state and thread-state container and calling the provided scan
@@ -693,6 +701,15 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *VPIAdvance(ast::Expr *vpi, bool filtered);
 
+  /**
+   * Call \@vpiReset() or \@vpiResetFiltered(). Move the provided unfiltered (or filtered) VPI back
+   * to its first valid tuple.
+   * @param vpi The vector projection iterator.
+   * @param filtered Flag indicating if the VPI is filtered.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *VPIReset(ast::Expr *vpi, bool filtered);
+
   /**
    * Call \@vpiInit(). Initialize a new VPI using the provided vector projection. The last TID list
    * argument is optional and can be NULL.
@@ -771,6 +788,15 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *FilterManagerInit(ast::Expr *filter_manager, ast::Expr *exec_ctx);
 
+  /**
+   * Call \@filterManagerInit(). Initialize the provided filter manager instance with an opaque context
+   * that is passed to every filter clause when the filters are run.
+   * @param filter_manager The filter manager pointer.
+   * @param exec_ctx The execution context variable.
+   * @param context The opaque context pointer.
+   */
+  [[nodiscard]] ast::Expr *FilterManagerInit(ast::Expr *filter_manager, ast::Expr *exec_ctx, ast::Expr *context);
+
   /**
    * Call \@filterManagerFree(). Destroy and clean up the provided filter manager instance.
    * @param filter_manager The filter manager pointer.
@@ -785,6 +811,17 @@ class CodeGen {
   [[nodiscard]] ast::Expr *FilterManagerInsert(ast::Expr *filter_manager,
                                                const std::vector<ast::Identifier> &clause_fn_names);
 
+  /**
+   * Call \@filterManagerInsertZoneMapTerm(). Insert a comparison of an integer column with a constant into the last
+   * inserted clause, to be checked against the zone maps of blocks.
+   * @param filter_manager The filter manager pointer.
+   * @param comp_type The comparison type.
+   * @param col_idx The index of the column in the vector projection.
+   * @param value The constant.
+   */
+  [[nodiscard]] ast::Expr *FilterManagerInsertZoneMapTerm(ast::Expr *filter_manager, parser::ExpressionType comp_type,
+                                                          uint32_t col_idx, int64_t value);
+
   /**
    * Call \@filterManagerRun(). Runs all filters on the input vector projection iterator.
    * @param filter_manager The filter manager pointer.
@@ -954,6 +991,26 @@ class CodeGen {
   [[nodiscard]] ast::Expr *JoinHashTableBuildParallel(ast::Expr *join_hash_table, ast::Expr *thread_state_container,
                                                       ast::Expr *offset);
 
+  /**
+   * Call \@joinHTBuildBloomFilter(). Builds a bloom filter over the hashes of all tuples in the
+   * provided built join hash table so that it can be pushed down into the probe side of the join.
+   * @param join_hash_table The join hash table.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableBuildBloomFilter(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTProbeBloomFilter(). Removes all TIDs in the provided list whose keys, hashed from the
+   * given columns of the vector projection, do not pass the join hash table's bloom filter.
+   * @param join_hash_table The join hash table.
+   * @param vector_projection The vector projection to probe with.
+   * @param tid_list The list of TIDs to filter.
+   * @param key_cols The name of the array holding the key column indexes in the vector projection.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableProbeBloomFilter(ast::Expr *join_hash_table, ast::Expr *vector_projection,
+                                                         ast::Expr *tid_list, ast::Identifier key_cols);
+
   /**
    * Call \@joinHTLookup(). Performs a single lookup into the hash table with a tuple with the
    * provided hash value. The provided iterator will provide tuples in the hash table that match the
@@ -966,6 +1023,48 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *JoinHashTableLookup(ast::Expr *join_hash_table, ast::Expr *entry_iter, ast::Expr *hash_val);
 
+  /**
+   * Call \@joinHTEnableSpilling(). Let the join hash table spill its build side to disk when the
+   * query exceeds its memory budget.
+   * @param join_hash_table The join hash table.
+   * @param probe_row_type_name The name of the struct of the probe-side rows that can be deferred.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableEnableSpilling(ast::Expr *join_hash_table,
+                                                       ast::Identifier probe_row_type_name);
+
+  /**
+   * Call \@joinHTIsPartitionSpilled(). Determines whether the build-side partition of the provided
+   * hash value has been spilled to disk, in which case its probes must be deferred.
+   * @param join_hash_table The join hash table.
+   * @param hash_val The hash value of the probe key.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableIsPartitionSpilled(ast::Expr *join_hash_table, ast::Expr *hash_val);
+
+  /**
+   * Call \@joinHTDeferProbe(). Writes a copy of the provided probe-side row to disk, alongside the
+   * spilled partition of its hash value.
+   * @param join_hash_table The join hash table.
+   * @param hash_val The hash value of the probe key.
+   * @param probe_row A pointer to the probe-side row.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableDeferProbe(ast::Expr *join_hash_table, ast::Expr *hash_val,
+                                                   ast::Expr *probe_row);
+
+  /**
+   * Call \@joinHTProbeSpilled(). Joins all deferred probe-side rows with their spilled partitions,
+   * one partition at a time, using the provided probe function as a callback.
+   * @param join_hash_table The join hash table.
+   * @param query_state A pointer to the query state.
+   * @param pipeline_state A pointer to the pipeline state.
+   * @param probe_fn The name of the function probing a partition with a deferred row.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableProbeSpilled(ast::Expr *join_hash_table, ast::Expr *query_state,
+                                                     ast::Expr *pipeline_state, ast::Identifier probe_fn);
+
   /**
    * Call \@joinHTFree(). Cleanup and destroy the provided join hash table instance.
    * @param join_hash_table The join hash table.
@@ -1091,6 +1190,18 @@ class CodeGen {
   [[nodiscard]] ast::Expr *AggHashTableMovePartitions(ast::Expr *agg_ht, ast::Expr *tls, ast::Expr *tl_agg_ht_offset,
                                                       ast::Identifier merge_partitions_fn_name);
 
+  /**
+   * Call \@aggHTEnableSpilling(). Let a serially-built aggregation hash table spill its partial
+   * aggregates to disk when the query exceeds its memory budget.
+   * @param agg_ht A pointer to the aggregation hash table.
+   * @param query_state A pointer to the query state.
+   * @param merge_partitions_fn_name The name of the merging function to merge partial aggregates
+   *                                 when the table is iterated.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *AggHashTableEnableSpilling(ast::Expr *agg_ht, ast::Expr *query_state,
+                                                      ast::Identifier merge_partitions_fn_name);
+
   /**
    * Call \@aggHTParallelPartScan(). Performs a parallel partitioned scan over an aggregation hash
    * table, using the provided worker function as a callback.
@@ -1352,6 +1463,95 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *SorterIterClose(ast::Expr *iter);
 
+  // -------------------------------------------------------
+  //
+  // Row buffer stuff
+  //
+  // -------------------------------------------------------
+
+  /**
+   * Call \@rowBufferInit(). Initialize the provided row buffer to hold rows of the given type.
+   * @param buffer The row buffer instance.
+   * @param exec_ctx The execution context that we are running in.
+   * @param row_type_name The name of the TPL type that will be stored in the buffer.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *RowBufferInit(ast::Expr *buffer, ast::Expr *exec_ctx, ast::Identifier row_type_name);
+
+  /**
+   * Call \@rowBufferInsert(). Append a row of the given type to the end of the buffer.
+   * @param buffer The row buffer instance.
+   * @param row_type_name The name of the TPL type that will be stored in the buffer.
+   * @return The call, cast to a pointer to the row type.
+   */
+  [[nodiscard]] ast::Expr *RowBufferInsert(ast::Expr *buffer, ast::Identifier row_type_name);
+
+  /**
+   * Call \@rowBufferFinish(). Indicate that all rows have been appended to the buffer.
+   * @param buffer The row buffer instance.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *RowBufferFinish(ast::Expr *buffer);
+
+  /**
+   * Call \@rowBufferFree(). Destroy the provided row buffer instance.
+   * @param buffer The row buffer instance.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *RowBufferFree(ast::Expr *buffer);
+
+  /**
+   * Call \@rowBufferIterInit(). Initialize the provided iterator over the given row buffer.
+   * @param iter The row buffer iterator.
+   * @param buffer The row buffer instance to iterate.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *RowBufferIterInit(ast::Expr *iter, ast::Expr *buffer);
+
+  /**
+   * Call \@rowBufferIterHasNext(). Check if the iterator is positioned at a row.
+   * @param iter The iterator.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *RowBufferIterHasNext(ast::Expr *iter);
+
+  /**
+   * Call \@rowBufferIterNext(). Advance the iterator one row.
+   * @param iter The iterator.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *RowBufferIterNext(ast::Expr *iter);
+
+  /**
+   * Call \@rowBufferIterGetRow(). Retrieves a pointer to the current row casted to the provided
+   * row type.
+   * @param iter The iterator.
+   * @param row_type_name The name of the TPL type that is stored in the buffer.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *RowBufferIterGetRow(ast::Expr *iter, ast::Identifier row_type_name);
+
+  /**
+   * Call \@rowBufferIterMark(). Remember the current position of the iterator.
+   * @param iter The iterator.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *RowBufferIterMark(ast::Expr *iter);
+
+  /**
+   * Call \@rowBufferIterRewind(). Move the iterator back to its marked position.
+   * @param iter The iterator.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *RowBufferIterRewind(ast::Expr *iter);
+
+  /**
+   * Call \@rowBufferIterClose(). Destroy and cleanup the provided row buffer iterator instance.
+   * @param iter The iterator.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *RowBufferIterClose(ast::Expr *iter);
+
   /**
    * Call \@like(). Implements the SQL LIKE() operation.
    * @param str The input string.
@@ -1369,12 +1569,17 @@ class CodeGen {
   [[nodiscard]] ast::Expr *NotLike(ast::Expr *str, ast::Expr *pattern);
 
   /**
-   * Call \@csvReaderInit(). Initialize a CSV reader for the given file name.
-   * @param reader The reader.
+   * Call \@csvReaderInit(). Open a CSV reader over the whole file with the given name. The reader is
+   * owned by the execution context.
+   * @param exec_ctx The execution context that we are running in.
    * @param file_name The filename.
-   * @return The call.
+   * @param delimiter The character that separates columns within a row.
+   * @param quote The quoting character.
+   * @param escape The character appearing before the quote character in quoted values.
+   * @return The call, returning a pointer to the reader.
    */
-  [[nodiscard]] ast::Expr *CSVReaderInit(ast::Expr *reader, std::string_view file_name);
+  [[nodiscard]] ast::Expr *CSVReaderInit(ast::Expr *exec_ctx, std::string_view file_name, char delimiter, char quote,
+                                         char escape);
 
   /**
    * Call \@csvReaderAdvance(). Advance the reader one row.
@@ -1400,11 +1605,20 @@ class CodeGen {
   [[nodiscard]] ast::Expr *CSVReaderGetRecordNumber(ast::Expr *reader);
 
   /**
-   * Call \@csvReaderClose(). Destroy a CSV reader.
-   * @param reader The reader.
+   * Call \@iterateCSVParallel(). Performs a parallel scan over the CSV file with the provided name,
+   * using the provided query state and thread-state container and calling the provided scan
+   * function on a reader over each chunk of the file.
+   * @param file_name The filename.
+   * @param delimiter The character that separates columns within a row.
+   * @param quote The quoting character.
+   * @param escape The character appearing before the quote character in quoted values.
+   * @param query_state The query state pointer.
+   * @param exec_ctx The execution context that we are running in.
+   * @param worker_name The work function name.
    * @return The call.
    */
-  [[nodiscard]] ast::Expr *CSVReaderClose(ast::Expr *reader);
+  [[nodiscard]] ast::Expr *IterateCSVParallel(std::string_view file_name, char delimiter, char quote, char escape,
+                                              ast::Expr *query_state, ast::Expr *exec_ctx, ast::Identifier worker_name);
 
   /**
    * Call \@storageInterfaceInit(si_ptr, execCtx, table_oid, col_oids, need_indexes)
@@ -36,18 +36,16 @@ class CSVScanTranslator : public OperatorTranslator, public PipelineDriver {
   void PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const override;
 
   /**
-   * CSV Scans are always serial, so should never launch work.
+   * @return The pipeline work function parameters. Just the *CSVReader over a chunk of the file.
    */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override {
-    UNREACHABLE("CSV scans are always serial ... for now.");
-  }
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override;
 
   /**
-   * CSV Scans are always serial, so should never launch work.
+   * Launch a parallel scan over the file, with one reader per newline-aligned chunk.
+   * @param function The pipeline generating function.
+   * @param work_func_name The name of the work function that implements the pipeline logic.
    */
-  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("CSV scans are always serial ... for now.");
-  }
+  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override;
 
   /**
    * Access a column from the base CSV.
@@ -66,9 +64,11 @@ class CSVScanTranslator : public OperatorTranslator, public PipelineDriver {
   ast::Expr *GetFieldPtr(uint32_t field_index) const;
 
  private:
-  // The name of the base row variable.
+  // The name of the base row type.
   ast::Identifier base_row_type_;
-  StateDescriptor::Entry base_row_;
+  // The names of the base row and reader variables.
+  ast::Identifier base_row_var_;
+  ast::Identifier reader_var_;
 };
 
 }  // namespace noisepage::execution::compiler
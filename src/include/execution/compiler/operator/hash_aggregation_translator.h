@@ -173,6 +173,10 @@ class HashAggregationTranslator : public OperatorTranslator, public PipelineDriv
   // Scan the final aggregation hash table.
   void ScanAggregationHashTable(WorkContext *context, FunctionBuilder *function, ast::Expr *agg_ht) const;
 
+  // Can the serial build spill partial aggregates to disk? Parallel builds
+  // always can. Distinct aggregates can't be merged from partial aggregates.
+  bool IsSerialBuildSpillable() const { return !build_pipeline_.IsParallel() && distinct_filters_.empty(); }
+
   // For minirunners.
   ast::StructDecl *GetStructDecl() const { return struct_decl_; }
 
@@ -132,16 +132,19 @@ class HashJoinTranslator : public OperatorTranslator {
   // Initialize the given join hash table instance, provided as a *JHT.
   void InitializeJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const;
 
+  // Let the given join hash table instance, provided as a *JHT, spill to disk if the join type allows it.
+  void EnableSpilling(FunctionBuilder *function, ast::Expr *jht_ptr) const;
+
   // Clean up and destroy the given join hash table instance, provided as a *JHT.
   void TearDownJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const;
 
   // Access an attribute at the given index in the provided row.
   ast::Expr *GetRowAttribute(ast::Expr *row, uint32_t attr_idx) const;
 
-  // Evaluate the provided hash keys in the provided context and return the
-  // results in the provided results output vector.
-  ast::Expr *HashKeys(WorkContext *ctx, FunctionBuilder *function,
-                      const std::vector<common::ManagedPointer<parser::AbstractExpression>> &hash_keys) const;
+  // Hash the provided hash keys in the provided context into a new variable,
+  // and return the name of the variable.
+  ast::Identifier HashKeys(WorkContext *ctx, FunctionBuilder *function,
+                           const std::vector<common::ManagedPointer<parser::AbstractExpression>> &hash_keys) const;
 
   // Fill the build row with the columns from the given context.
   void FillBuildRow(WorkContext *ctx, FunctionBuilder *function, ast::Expr *build_row) const;
@@ -155,6 +158,10 @@ class HashJoinTranslator : public OperatorTranslator {
   // Probe the join hash table with the input tuple(s).
   void ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *function) const;
 
+  // Probe the provided join hash table with the input tuple(s) with the given hash value, and
+  // handle all matches according to the join type.
+  void LookupMatches(WorkContext *ctx, FunctionBuilder *function, ast::Expr *join_ht, ast::Expr *hash_val) const;
+
   // Check the right mark.
   void CheckRightMark(WorkContext *ctx, FunctionBuilder *function, ast::Identifier right_mark) const;
 
@@ -164,6 +171,14 @@ class HashJoinTranslator : public OperatorTranslator {
   // Only for left outer joins - iterate the hash table and output unmatched left rows
   void CollectUnmatchedLeftRows(FunctionBuilder *function) const;
 
+  // Can the build side spill to disk? Only joins whose unmatched build-side rows produce no output
+  // can spill, since the rows of spilled partitions are only visited through deferred probes.
+  bool CanSpillBuild() const;
+
+  // If the plan requests it, push a bloom filter over the build side into the probe-side scan.
+  // Returns true if the bloom filter was pushed down and must be built after the build phase.
+  bool PushDownBloomFilter();
+
   /** @return The struct that was declared, used for the minirunner. */
   ast::StructDecl *GetStructDecl() const { return struct_decl_; }
 
@@ -174,7 +189,8 @@ class HashJoinTranslator : public OperatorTranslator {
   ast::FunctionDecl *GenerateEndHookFunction() const;
 
  private:
-  // Flag to indicate whether or not we are in the joinConsumer function
+  // Flag to indicate whether or not we are in the joinConsumer or probeSpilled function, where the
+  // outputs of the probe side are read from the materialized probe row
   bool join_consumer_flag_;
 
   // The name of the materialized row when inserting into join hash table.
@@ -190,6 +206,9 @@ class HashJoinTranslator : public OperatorTranslator {
   // The name of the function which encapuslates the join conumser
   ast::Identifier join_consumer_;
 
+  // The name of the function which probes a spilled partition with a deferred probe row
+  ast::Identifier probe_spilled_fn_;
+
   // The left build-side pipeline.
   Pipeline left_pipeline_;
 
@@ -198,6 +217,9 @@ class HashJoinTranslator : public OperatorTranslator {
   StateDescriptor::Entry global_join_ht_;
   StateDescriptor::Entry local_join_ht_;
 
+  // Whether a bloom filter is built over the join hash table and pushed into the probe-side scan.
+  bool build_bloom_filter_;
+
   // The number of rows that are inserted into the hash table.
   StateDescriptor::Entry num_build_rows_;
   // The number of probes that are performed.
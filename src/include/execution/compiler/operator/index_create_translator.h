@@ -39,14 +39,14 @@ class IndexCreateTranslator : public OperatorTranslator, public PipelineDriver {
   DISALLOW_COPY_AND_MOVE(IndexCreateTranslator);
 
   /**
-   * Initialize the global col_oids array.
+   * Initialize the global col_oids array, and the sorter of the bulk load entries if the index is bulk loaded.
    */
   void InitializeQueryState(FunctionBuilder *function) const override;
 
   /**
-   * Nothing to tear down.
+   * Free the sorter of the bulk load entries if the index is bulk loaded.
    */
-  void TearDownQueryState(FunctionBuilder *function) const override{};
+  void TearDownQueryState(FunctionBuilder *function) const override;
 
   /**
    * Initilize a thread local storage interface and index pr, work for both serial and parallel
@@ -77,6 +77,13 @@ class IndexCreateTranslator : public OperatorTranslator, public PipelineDriver {
    */
   void PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const override;
 
+  /**
+   * If the index is bulk loaded, sort the entries collected by the scan and build the index from them
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
   /** @return This translator doesn't have a child */
   ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override {
     UNREACHABLE("index create doesn't have child");
@@ -103,6 +110,7 @@ class IndexCreateTranslator : public OperatorTranslator, public PipelineDriver {
   void InitializeStorageInterface(FunctionBuilder *function, ast::Expr *storage_interface_ptr) const;
   void TearDownStorageInterface(FunctionBuilder *function, ast::Expr *storage_interface_ptr) const;
   void DeclareIndexPR(FunctionBuilder *function) const;
+  void InitializeSorter(FunctionBuilder *function, ast::Expr *sorter_ptr) const;
 
   // Initialization for serial only
   void DeclareTVI(FunctionBuilder *function) const;
@@ -127,6 +135,12 @@ class IndexCreateTranslator : public OperatorTranslator, public PipelineDriver {
   // thread local tuple slot
   StateDescriptor::Entry local_tuple_slot_;
 
+  // Whether the index is empty and is built bottom-up from sorted entries rather than by inserting tuple by tuple
+  bool bulk_load_;
+  // Sorter collecting the bulk load entries, and thread local sorters if the pipeline is parallel
+  StateDescriptor::Entry global_sorter_;
+  StateDescriptor::Entry local_sorter_;
+
   // The name of the declared TVI and VPI.
   ast::Identifier tvi_var_;
   ast::Identifier vpi_var_;
@@ -41,7 +41,7 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
 
   void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
-  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *func) const override {}
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
   /**
    * @return The value (or value vector) of the column with the provided column OID in the table
@@ -51,6 +51,16 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
 
   ast::Expr *GetSlotAddress() const override;
 
+  /**
+   * Look up the keys of all tuples of a batch produced by the scan below this join, before the tuples are pushed to
+   * this join one at a time. The results are then picked up tuple by tuple, in the order the tuples are iterated.
+   * @param context The context of the work.
+   * @param function The pipeline generating function.
+   * @param vpi The vector projection iterator over the batch.
+   * @param filtered Whether the scan iterates the batch through its selection vector.
+   */
+  void ProbeBatch(WorkContext *context, FunctionBuilder *function, ast::Expr *vpi, bool filtered) const;
+
   /** @return Throw an error, this is serial for now. */
   util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Index join is serial."); };
 
@@ -68,6 +78,8 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   void DeclareIndexPR(FunctionBuilder *builder) const;
   void DeclareTablePR(FunctionBuilder *builder) const;
   void DeclareSlot(FunctionBuilder *builder) const;
+  // The pointer to the index iterator, in the pipeline state if probes are batched.
+  ast::Expr *GetIteratorPtr() const;
 
  private:
   std::vector<catalog::col_oid_t> input_oids_;
@@ -84,6 +96,11 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   ast::Identifier table_pr_;
   ast::Identifier slot_;
 
+  // Whether the index is probed a batch of outer tuples at a time, which the scan below this join makes possible.
+  bool batched_probes_{false};
+  // The index iterator of batched probes, which lives across the tuples of a batch.
+  StateDescriptor::Entry local_index_iter_;
+
   // The size of the index.
   StateDescriptor::Entry index_size_;
   // The number of scans on the index.
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "execution/compiler/operator/index_scan_translator.h"
+
+namespace noisepage::execution::compiler {
+
+/**
+ * Index scan translator for scans that only read key columns of the index. The columns are read from the index keys,
+ * and the tuples are only read from blocks that are not all-visible.
+ */
+class IndexOnlyScanTranslator : public IndexScanTranslator {
+ public:
+  /**
+   * Create a translator for the given plan.
+   * @param plan The plan, which must be index-only.
+   * @param compilation_context The context this translator belongs to.
+   * @param pipeline The pipeline this translator is participating in.
+   */
+  IndexOnlyScanTranslator(const planner::IndexScanPlanNode &plan, CompilationContext *compilation_context,
+                          Pipeline *pipeline);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(IndexOnlyScanTranslator);
+
+  /**
+   * Initialize the counters and the iterator, which is switched to reading the index keys.
+   */
+  void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+ protected:
+  void DeclareTablePR(FunctionBuilder *builder) const override;
+};
+
+}  // namespace noisepage::execution::compiler
@@ -60,6 +60,18 @@ class IndexScanTranslator : public OperatorTranslator, public PipelineDriver {
     UNREACHABLE("Index scan is serial.");
   };
 
+ protected:
+  /**
+   * Declare the table PR that holds the columns of the current tuple.
+   * @param builder The function being built.
+   */
+  virtual void DeclareTablePR(FunctionBuilder *builder) const;
+
+  /** The index iterator in the pipeline state. */
+  StateDescriptor::Entry index_iter_;
+  /** The table PR of the current tuple. */
+  ast::Identifier table_pr_;
+
  private:
   void DeclareIterator(FunctionBuilder *builder) const;
   void SetOids(FunctionBuilder *builder) const;
@@ -67,7 +79,6 @@ class IndexScanTranslator : public OperatorTranslator, public PipelineDriver {
                const std::unordered_map<catalog::indexkeycol_oid_t, planner::IndexExpression> &index_exprs) const;
   void FreeIterator(FunctionBuilder *builder) const;
   void DeclareIndexPR(FunctionBuilder *builder) const;
-  void DeclareTablePR(FunctionBuilder *builder) const;
   void DeclareSlot(FunctionBuilder *builder) const;
 
  private:
@@ -78,12 +89,10 @@ class IndexScanTranslator : public OperatorTranslator, public PipelineDriver {
   const std::unordered_map<catalog::indexkeycol_oid_t, uint16_t> &index_pm_;
 
   // Structs and local variables
-  StateDescriptor::Entry index_iter_;
   ast::Identifier col_oids_;
   ast::Identifier index_pr_;
   ast::Identifier lo_index_pr_;
   ast::Identifier hi_index_pr_;
-  ast::Identifier table_pr_;
   ast::Identifier slot_;
 
   // The number of scans on the index that are performed.
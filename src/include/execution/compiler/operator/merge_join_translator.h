@@ -0,0 +1,168 @@
+#pragma once
+
+#include <vector>
+
+#include "execution/compiler/operator/operator_translator.h"
+#include "execution/compiler/pipeline.h"
+
+namespace noisepage::selfdriving {
+class OperatingUnitRecorder;
+}  // namespace noisepage::selfdriving
+
+namespace noisepage::parser {
+class AbstractExpression;
+}  // namespace noisepage::parser
+
+namespace noisepage::planner {
+class MergeJoinPlanNode;
+}  // namespace noisepage::planner
+
+namespace noisepage::execution::compiler {
+
+class FunctionBuilder;
+
+/**
+ * A translator for sort-merge joins.
+ *
+ * Both inputs arrive ordered on their merge keys. The left input is materialized, in order, into a
+ * RowBuffer in the left pipeline. The right input is streamed in the right pipeline: a cursor into
+ * the buffer is advanced past all rows whose keys are smaller than the current right key, its
+ * position is marked, and the group of buffered rows with an equal key is joined with the right
+ * tuple. The next right tuple rewinds the cursor to the mark, so a run of equal right keys re-reads
+ * the same group while the buffer is read sequentially otherwise, even after it has spilled.
+ */
+class MergeJoinTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Create a new translator for the given merge join plan. The compilation occurs within the
+   * provided compilation context and the operator is participating in the provided pipeline.
+   * @param plan The plan.
+   * @param compilation_context The context of compilation this translation is occurring in.
+   * @param pipeline The pipeline this operator is participating in.
+   */
+  MergeJoinTranslator(const planner::MergeJoinPlanNode &plan, CompilationContext *compilation_context,
+                      Pipeline *pipeline);
+
+  /**
+   * Declare the row struct used to buffer tuples from the left input and the key struct used to
+   * hold the merge keys of the current right tuple.
+   * @param decls The top-level declarations for the query.
+   */
+  void DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) override;
+
+  /**
+   * Declare the function comparing a buffered row against the keys of the current right tuple.
+   * @param decls The top-level declarations for the query.
+   */
+  void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
+
+  /**
+   * Initialize the row buffer.
+   */
+  void InitializeQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * Tear-down the row buffer.
+   */
+  void TearDownQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * If the given pipeline is the right pipeline, position the merge cursor at the start of the
+   * row buffer.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * If the given pipeline is the right pipeline, close the merge cursor.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * If the given pipeline is the left pipeline, finish the row buffer.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * Implement main join logic. If the context is coming from the left pipeline, the input tuples
+   * are appended to the row buffer. If the context is coming from the right pipeline, the input
+   * tuples are merged against the row buffer.
+   * @param ctx The context of the work.
+   * @param function The pipeline generating function.
+   */
+  void PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const override;
+
+  /**
+   * @return The value (vector) of the attribute at the given index (@em attr_idx) produced by the
+   *         child at the given index (@em child_idx).
+   */
+  ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
+
+  /**
+   * Merge joins do not produce columns from base tables.
+   */
+  ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override {
+    UNREACHABLE("Merge joins do not produce columns from base tables.");
+  }
+
+  bool IsCountersPassThrough() const override { return true; }
+
+ private:
+  friend class selfdriving::OperatingUnitRecorder;
+
+  // Is the given pipeline this join's left pipeline?
+  bool IsLeftPipeline(const Pipeline &pipeline) const { return &left_pipeline_ == &pipeline; }
+
+  // Is the given pipeline this join's right pipeline?
+  bool IsRightPipeline(const Pipeline &pipeline) const { return GetPipeline() == &pipeline; }
+
+  // Get the merge join plan node.
+  const planner::MergeJoinPlanNode &GetMergeJoinPlan() const { return GetPlanAs<planner::MergeJoinPlanNode>(); }
+
+  // Access an attribute at the given index in the provided row.
+  ast::Expr *GetRowAttribute(ast::Expr *row, uint32_t attr_idx) const;
+
+  // Access the key at the given index in the provided merge key.
+  ast::Expr *GetKeyAttribute(ast::Expr *key, uint32_t key_idx) const;
+
+  // Generate a three-way comparison of the left merge keys of the 'lhs' row against the right merge
+  // keys stored in the 'rhs' key.
+  void GenerateKeyComparison(FunctionBuilder *function);
+
+  // Append the tuple in the provided context to the row buffer.
+  void InsertIntoBuffer(WorkContext *ctx, FunctionBuilder *function) const;
+
+  // Join the tuple in the provided context with the matching group of buffered rows.
+  void MergeWithBuffer(WorkContext *ctx, FunctionBuilder *function) const;
+
+ private:
+  // The name of the materialized left row and its type.
+  ast::Identifier merge_row_var_;
+  ast::Identifier merge_row_type_;
+  // The name of the right tuple's merge keys and their type.
+  ast::Identifier merge_key_var_;
+  ast::Identifier merge_key_type_;
+  // Parameters of the generated comparison function.
+  ast::Identifier lhs_row_, rhs_row_;
+  // The row-to-key comparison function.
+  ast::Identifier merge_compare_func_;
+
+  // The left buffering pipeline.
+  Pipeline left_pipeline_;
+
+  // The row buffer, in the query state.
+  StateDescriptor::Entry global_buffer_;
+
+  // The merge cursor, in the right pipeline's state.
+  StateDescriptor::Entry cursor_;
+
+  // Are left child attributes being read from the comparison function's row parameter?
+  bool in_compare_func_;
+};
+
+}  // namespace noisepage::execution::compiler
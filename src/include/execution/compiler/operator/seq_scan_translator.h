@@ -6,6 +6,7 @@
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/pipeline_driver.h"
+#include "parser/expression_defs.h"
 
 namespace noisepage::catalog {
 class CatalogAccessor;
@@ -23,6 +24,7 @@ class SeqScanPlanNode;
 namespace noisepage::execution::compiler {
 
 class FunctionBuilder;
+class IndexJoinTranslator;
 
 /**
  * A translator for sequential table scans.
@@ -96,10 +98,55 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
   /** @return Returns the schema for the underlying plan node */
   catalog::Schema GetPlanSchema() const;
 
+  /**
+   * Register a bloom filter pushed down from a hash join. Each batch of tuples produced by this scan
+   * is filtered through the bloom filter of the provided join hash table, hashing the given columns
+   * in the order they are provided, before being passed up the pipeline.
+   * @param join_hash_table The query state entry of the join hash table owning the bloom filter.
+   * @param key_col_oids The OIDs of the join key columns in this scan's table.
+   */
+  void RegisterBloomFilter(const StateDescriptor::Entry &join_hash_table,
+                           const std::vector<catalog::col_oid_t> &key_col_oids);
+
+  /**
+   * Register an index join probing its index with the tuples of this scan. Before the tuples of a batch are passed up
+   * the pipeline, the index join gets to look up the keys of all of them at once.
+   * @param index_join The index join directly consuming this scan.
+   */
+  void RegisterIndexJoin(const IndexJoinTranslator *index_join);
+
  private:
+  // A bloom filter pushed down from a hash join into this scan.
+  struct BloomFilterProbe {
+    // The query state entry of the join hash table owning the bloom filter.
+    StateDescriptor::Entry join_hash_table_;
+    // The indexes of the key columns in the scanned vector projection.
+    std::vector<uint32_t> key_col_idxs_;
+  };
+
+  // A comparison of an integer column with a constant, checked against the zone maps of blocks to skip them.
+  struct ZoneMapTerm {
+    // The comparison type.
+    parser::ExpressionType comp_type_;
+    // The index of the column in the scanned vector projection.
+    uint32_t col_idx_;
+    // The constant.
+    int64_t value_;
+  };
+
   // Does the scan have a predicate?
   bool HasPredicate() const;
 
+  // Does the scan need a filter manager, i.e., does it have a predicate or any bloom filters?
+  bool UsesFilterManager() const { return HasPredicate() || !bloom_filters_.empty(); }
+
+  // Declare the filter manager in the pipeline state, if it hasn't been already.
+  void DeclareFilterManager();
+
+  // Generate a filter term probing a pushed-down bloom filter.
+  ast::Identifier GenerateBloomFilterTerm(util::RegionVector<ast::FunctionDecl *> *decls,
+                                          const BloomFilterProbe &bloom_filter);
+
   // Get the OID of the table being scanned.
   catalog::table_oid_t GetTableOid() const;
 
@@ -110,10 +157,18 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
   void GenerateGenericTerm(FunctionBuilder *function, common::ManagedPointer<parser::AbstractExpression> term,
                            ast::Expr *vector_proj, ast::Expr *tid_list);
 
-  // Generate all filter clauses.
+  // Generate all filter clauses, along with the zone map terms of each clause.
   void GenerateFilterClauseFunctions(util::RegionVector<ast::FunctionDecl *> *decls,
                                      common::ManagedPointer<parser::AbstractExpression> predicate,
-                                     std::vector<ast::Identifier> *curr_clause, bool seen_conjunction);
+                                     std::vector<ast::Identifier> *curr_clause,
+                                     std::vector<ZoneMapTerm> *curr_zone_map_terms, bool seen_conjunction);
+
+  // Add a zone map term for a comparison of a column with a constant, if the zone maps can answer it.
+  void AddZoneMapTerm(common::ManagedPointer<parser::AbstractExpression> predicate, parser::ExpressionType cmp_type,
+                      uint32_t col_idx, std::vector<ZoneMapTerm> *curr_zone_map_terms) const;
+
+  // Does any filter clause have zone map terms?
+  bool HasZoneMapTerms() const;
 
   // Perform a table scan using the provided table vector iterator pointer.
   void ScanTable(WorkContext *ctx, FunctionBuilder *function) const;
@@ -143,9 +198,18 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
   StateDescriptor::Entry local_filter_manager_;
 
   // The list of filter manager clauses. Populated during helper function
-  // definition, but only if there's a predicate.
+  // definition, but only if there's a predicate or a pushed-down bloom filter.
   std::vector<std::vector<ast::Identifier>> filters_;
 
+  // The zone map terms of each filter manager clause, used to skip whole blocks.
+  std::vector<std::vector<ZoneMapTerm>> zone_map_terms_;
+
+  // Bloom filters pushed down from hash joins consuming this scan.
+  std::vector<BloomFilterProbe> bloom_filters_;
+
+  // An index join consuming this scan that probes its index a batch of tuples at a time, if any.
+  const IndexJoinTranslator *index_join_{nullptr};
+
   // The version of col_oids that we use for translation. See MakeInputOids for justification.
   std::vector<catalog::col_oid_t> col_oids_;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #include "execution/sql/memory_tracker.h"
 #include "execution/sql/runtime_types.h"
 #include "execution/sql/thread_state_container.h"
+#include "execution/util/csv_reader.h"
 #include "execution/util/region.h"
 #include "metrics/metrics_defs.h"
 #include "planner/plannodes/output_schema.h"
@@ -134,6 +136,21 @@ class EXPORT ExecutionContext {
    */
   sql::VarlenHeap *GetStringAllocator() { return &string_allocator_; }
 
+  /**
+   * Map a CSV file for a scan. String values read from the file point into the mapping, so it is kept until the end
+   * of the query.
+   * @param file_name path of the file
+   * @return the mapped file, or nullptr if it could not be mapped
+   */
+  util::CSVMappedFile *MapCSVFile(std::string_view file_name);
+
+  /**
+   * Keep a CSV reader until the end of the query, as string values read through it may point into memory it owns
+   * @param reader the reader
+   * @return the reader
+   */
+  util::CSVReader *RetainCSVReader(std::unique_ptr<util::CSVReader> reader);
+
   /**
    * @param schema the schema of the output
    * @return the size of tuple with this final_schema
@@ -295,6 +312,24 @@ class EXPORT ExecutionContext {
     memory_use_override_value_ = memory_use;
   }
 
+  /**
+   * @return True if this query has allocated more memory than its budget allows; false otherwise.
+   *         Always false if the query has no memory budget. Allocations are published to the
+   *         query's total in batches, so the check may lag behind by a few batches.
+   */
+  bool IsOverMemoryBudget() const {
+    const uint64_t budget = exec_settings_.GetQueryMemoryBudget();
+    return budget != 0 && mem_tracker_->GetTotalAllocatedSize() > budget;
+  }
+
+  /**
+   * Abort the query if it has allocated more memory than its budget allows. Used by operators that
+   * cannot spill their state to disk, so that the query fails rather than exhausting the memory of
+   * the whole server.
+   * @param operator_name The name of the operator checking the budget, for error reporting.
+   */
+  void CheckMemoryBudget(const char *operator_name) const;
+
   /**
    * Sets the opaque query state pointer for the current query invocation
    * @param query_state QueryState
@@ -351,6 +386,9 @@ class EXPORT ExecutionContext {
   std::unique_ptr<sql::ThreadStateContainer> thread_state_container_;
   // TODO(WAN): EXEC PORT we used to push the memory tracker into the string allocator, do this
   sql::VarlenHeap string_allocator_;
+  // CSV files mapped for scans, and the readers over them
+  std::vector<std::unique_ptr<util::CSVMappedFile>> csv_files_;
+  std::vector<std::unique_ptr<util::CSVReader>> csv_readers_;
   common::ManagedPointer<selfdriving::PipelineOperatingUnits> pipeline_operating_units_{nullptr};
 
   common::ManagedPointer<catalog::CatalogAccessor> accessor_;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <utility>
 
 #include "common/constants.h"
@@ -94,6 +95,12 @@ class EXPORT ExecutionSettings {
   /** @return True if static partitioner is enabled. */
   constexpr bool GetIsStaticPartitionerEnabled() const { return is_static_partitioner_enabled_; }
 
+  /** @return The number of bytes a query may allocate before spilling to disk. Zero if unlimited. */
+  uint64_t GetQueryMemoryBudget() const { return query_memory_budget_; }
+
+  /** @return The directory where spill files are written. */
+  const std::string &GetSpillFileDirectory() const { return spill_file_directory_; }
+
  private:
   double select_opt_threshold_{common::Constants::SELECT_OPT_THRESHOLD};
   double arithmetic_full_compute_opt_threshold_{common::Constants::ARITHMETIC_FULL_COMPUTE_THRESHOLD};
@@ -104,6 +111,8 @@ class EXPORT ExecutionSettings {
   bool is_pipeline_metrics_enabled_{common::Constants::IS_PIPELINE_METRICS_ENABLED};
   int number_of_parallel_execution_threads_{common::Constants::NUM_PARALLEL_EXECUTION_THREADS};
   bool is_static_partitioner_enabled_{common::Constants::IS_STATIC_PARTITIONER_ENABLED};
+  uint64_t query_memory_budget_{common::Constants::QUERY_MEMORY_BUDGET};
+  std::string spill_file_directory_{common::Constants::SPILL_FILE_DIRECTORY};
   compiler::CompilerSettings compiler_settings_{};  ///< The settings for compiling the TPL input.
 
   // MiniRunners needs to set query_identifier and pipeline_operating_units_.
@@ -77,6 +77,9 @@ namespace sema {
     "parallel scan function must have type (*ExecutionContext, *TableVectorIterator)->nil, "                          \
     "received '%0'",                                                                                                  \
     (ast::Type *))                                                                                                    \
+  F(BadParallelCSVScanFunction,                                                                                       \
+    "parallel CSV scan function must have type (*QueryState, *ThreadState, *CSVReader)->nil, received '%0'",          \
+    (ast::Type *))                                                                                                    \
   F(BadHookFunction,                                                                                                  \
     "hook function must have type (*QueryState, *TLS, *)->nil, "                                                      \
     "received '%0'",                                                                                                  \
@@ -127,16 +127,21 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinJoinHashTableInsert(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableGetTupleCount(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinJoinHashTableProbeBloomFilter(ast::CallExpr *call);
   void CheckBuiltinJoinHashTableLookup(ast::CallExpr *call);
+  void CheckBuiltinJoinHashTableSpillCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinJoinHashTableFree(ast::CallExpr *call);
   void CheckBuiltinHashTableEntryIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinJoinHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterInit(ast::CallExpr *call);
+  void CheckBuiltinSorterInitForIndex(ast::CallExpr *call);
   void CheckBuiltinSorterGetTupleCount(ast::CallExpr *call);
   void CheckBuiltinSorterInsert(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterSort(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterFree(ast::CallExpr *call);
   void CheckBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinRowBufferCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinRowBufferIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinExecOUFeatureVectorCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinThreadStateContainerCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -153,7 +158,8 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinVectorFilterCall(ast::CallExpr *call);
   void CheckBuiltinHashCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckResultBufferCall(ast::CallExpr *call, ast::Builtin builtin);
-  // TODO(WAN): <charconv> unsupported void CheckCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckCSVScanParCall(ast::CallExpr *call);
   void CheckBuiltinPRCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinStorageInterfaceCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinIndexIteratorInit(ast::CallExpr *call, ast::Builtin builtin);
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -9,6 +10,7 @@
 #include "common/managed_pointer.h"
 #include "execution/sql/chaining_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_projection.h"
 #include "execution/util/chunked_vector.h"
@@ -209,6 +211,22 @@ class EXPORT AggregationHashTable {
   void TransferMemoryAndPartitions(ThreadStateContainer *thread_states, std::size_t agg_ht_offset,
                                    MergePartitionFn merge_partition_fn);
 
+  /**
+   * Allow this table to spill its aggregates to disk when the query exceeds its memory budget
+   * during a serial (i.e., non-partitioned) build. Spilled aggregates are merged back, one overflow
+   * partition at a time, when the table is iterated through an AHTIterator. Without this, a serial
+   * build that exceeds the budget fails the query.
+   *
+   * @param query_state The (opaque) query state passed to the merging function.
+   * @param merge_partition_fn The function to use for merging partitions.
+   */
+  void EnableSpilling(void *query_state, MergePartitionFn merge_partition_fn);
+
+  /**
+   * @return True if some aggregates in this table have been spilled to disk.
+   */
+  bool HasSpilled() const noexcept { return !spilled_partitions_.empty(); }
+
   /**
    * Execute a serial scan over this hash table. It is assumed that the hash table was constructed
    * in a partitioned manner, otherwise use a simple tpl::sql::AHTITerator. This function builds a
@@ -293,6 +311,9 @@ class EXPORT AggregationHashTable {
   // Grow the hash table
   void Grow();
 
+  // Allocate a new entry for an input tuple, growing the table if need be.
+  byte *AllocInputTupleInternal(hash_t hash, bool partitioned);
+
   // Internal entry allocation + hash table linkage. Does not resize!
   HashTableEntry *AllocateEntryInternal(hash_t hash);
 
@@ -309,6 +330,24 @@ class EXPORT AggregationHashTable {
   // Allocate all overflow partition information if unallocated
   void AllocateOverflowPartitions();
 
+  // Spill the overflow partitions flushed since the last insertion if the query is over its memory
+  // budget. Only called when the caller holds no references to aggregates in this table.
+  void SpillIfOverMemoryBudget();
+
+  // Write all overflow partitions to disk and release their memory. The main hash table must be
+  // empty, i.e., all entries must have been flushed to the overflow partitions.
+  void SpillOverflowPartitions();
+
+  // Is the given overflow partition empty, both in memory and on disk?
+  bool IsPartitionEmpty(uint32_t partition_idx) const;
+
+  // Read all spilled entries of the given overflow partition into memory owned by 'target'. Returns
+  // the head of the list of read entries.
+  HashTableEntry *ReadSpilledPartition(uint32_t partition_idx, AggregationHashTable *target) const;
+
+  // Destroy the aggregation hash table built over the given partition.
+  void ReleaseTableOverPartition(uint32_t partition_idx);
+
   // Called from ProcessBatch() to compute hash values for tuples in batch.
   void ComputeHash(VectorProjectionIterator *input_batch, const std::vector<uint32_t> &key_indexes);
 
@@ -428,6 +467,31 @@ class EXPORT AggregationHashTable {
   // partition an entry is linked into.
   uint64_t partition_shift_bits_;
 
+  // -------------------------------------------------------
+  // Spilled overflow partitions
+  // -------------------------------------------------------
+
+  // A file holding the overflow partitions of one table, spilled one or more
+  // times. Partitions are written in order on each spill, so the entries of
+  // partition 'p' in the 'r'-th spill are the tuples in the range
+  // [offsets_[r * DEFAULT_NUM_PARTITIONS + p], offsets_[r * DEFAULT_NUM_PARTITIONS + p + 1]).
+  struct SpilledPartitions {
+    std::unique_ptr<SpillFile> file_;
+    std::vector<uint64_t> offsets_;
+  };
+  // All spilled partitions. A table only writes to the last file; files taken
+  // from thread-local tables are finished.
+  std::vector<SpilledPartitions> spilled_partitions_;
+  // Were entries flushed into the overflow partitions since the last check of
+  // the memory budget?
+  bool spill_check_pending_;
+  // The query state passed to the merging function of a spilling serial build.
+  void *merge_query_state_;
+  // Is this a table built over a single overflow partition of another table?
+  // Such tables grow past the memory budget, since their partition cannot be
+  // split any further.
+  bool is_partition_table_;
+
   // Runtime stats.
   Stats stats_;
 
@@ -469,33 +533,49 @@ inline byte *AggregationHashTable::Lookup(hash_t hash, AggregationHashTable::Key
 class AHTIterator {
  public:
   /**
-   * Construct an iterator over the given aggregation hash table.
+   * Construct an iterator over the given aggregation hash table. If the table has spilled, its
+   * aggregates are merged and iterated one overflow partition at a time, and only the partition
+   * being iterated is kept in memory.
    * @param agg_table The table to iterate.
    */
-  explicit AHTIterator(const AggregationHashTable &agg_table) : iter_(agg_table.hash_table_) {}
+  explicit AHTIterator(AggregationHashTable *agg_table);
 
   /**
    * @return True if the iterator has more data; false otherwise
    */
-  bool HasNext() const { return iter_.HasNext(); }
+  bool HasNext() const { return iter_->HasNext(); }
 
   /**
    * Advance the iterator one tuple.
    */
-  void Next() { iter_.Next(); }
+  void Next() {
+    iter_->Next();
+    if (UNLIKELY(!iter_->HasNext()) && agg_table_->HasSpilled()) {
+      NextPartition();
+    }
+  }
 
   /**
    * @return A pointer to the current row. This assumes a previous call to HasNext() indicated there
    *         is more data.
    */
   const byte *GetCurrentAggregateRow() const {
-    auto *ht_entry = iter_.GetCurrentEntry();
+    auto *ht_entry = iter_->GetCurrentEntry();
     return ht_entry->payload_;
   }
 
  private:
+  // Release the current partition's table, and position the iterator at the
+  // first aggregate of the next non-empty partition.
+  void NextPartition();
+
+ private:
+  // The table being iterated
+  AggregationHashTable *agg_table_;
+  // The overflow partition being iterated, if the table has spilled
+  uint32_t partition_idx_;
   // The iterator over the aggregation hash table
-  ChainingHashTableIterator<false> iter_;
+  std::optional<ChainingHashTableIterator<false>> iter_;
 };
 
 //===----------------------------------------------------------------------===//
@@ -311,6 +311,17 @@ class ChainingHashTable : public ChainingHashTableBase {
   template <bool Concurrent, typename Allocator>
   void InsertBatch(util::ChunkedVector<Allocator> *entries);
 
+  /**
+   * Insert the @em num_entries entries pointed to by @em entries into this hash table. Entries are
+   * inserted where they are stored and are not copied.
+   * @pre All hash values must have been computed already.
+   * @tparam Concurrent Is the insert occurring concurrently with other inserts.
+   * @param entries The array of pointers to the entries to insert.
+   * @param num_entries The number of entries to insert.
+   */
+  template <bool Concurrent>
+  void InsertBatch(HashTableEntry *const *entries, uint64_t num_entries);
+
   /**
    * Return the head of the bucket chain for a key with the provided hash value. Probing assumes no
    * concurrent modifications to the hash table. Thus, is suitable for WORM based workloads.
@@ -405,6 +416,28 @@ inline void ChainingHashTable<UseTags>::InsertBatch(util::ChunkedVector<Allocato
   AddElementCount(entries->size());
 }
 
+template <bool UseTags>
+template <bool Concurrent>
+inline void ChainingHashTable<UseTags>::InsertBatch(HashTableEntry *const *entries, const uint64_t num_entries) {
+  for (uint64_t idx = 0, prefetch_idx = common::Constants::K_PREFETCH_DISTANCE; idx < num_entries;
+       idx++, prefetch_idx++) {
+    // The entries are scattered in memory, and each insert writes the entry's chain pointer.
+    if (LIKELY(prefetch_idx < num_entries)) {
+      util::Memory::Prefetch<false, Locality::Low>(entries[prefetch_idx]);
+    }
+
+    HashTableEntry *entry = entries[idx];
+    if constexpr (UseTags) {  // NOLINT
+      InsertTagged<Concurrent>(entry, entry->hash_);
+    } else {
+      InsertUntagged<Concurrent>(entry, entry->hash_);
+    }
+  }
+
+  // Update element count.
+  AddElementCount(num_entries);
+}
+
 template <bool UseTags>
 inline HashTableEntry *ChainingHashTable<UseTags>::FindChainHead(hash_t hash) const {
   if constexpr (UseTags) {  // NOLINT
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string_view>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "execution/util/csv_reader.h"
+
+namespace noisepage::execution::exec {
+class ExecutionContext;
+}
+
+namespace noisepage::execution::sql {
+
+/**
+ * Entry points for scanning CSV files, serially through a single reader, or in parallel through
+ * one reader per newline-aligned chunk of the file. Files are memory-mapped, and string values read
+ * from them point into the mapping or into memory owned by their reader. Both are owned by the
+ * execution context, so the values stay valid until the end of the query.
+ */
+class EXPORT CSVScanner {
+ public:
+  /** Used to denote the offsets into ExecutionContext::hooks_ of particular functions */
+  enum class HookOffsets : uint32_t {
+    EndHook = 0,
+
+    NUM_HOOKS
+  };
+
+  /**
+   * Minimum number of bytes of the file to give a scan task.
+   */
+  static constexpr const std::size_t K_MIN_CHUNK_SIZE = 4 * common::Constants::MB;
+
+  /**
+   * Number of chunks to split the file into per thread, so that threads finishing early can pick
+   * up the work of slower ones.
+   */
+  static constexpr const uint32_t K_CHUNKS_PER_THREAD = 4;
+
+  /**
+   * Open a reader over the whole file.
+   * @param exec_ctx The execution context, which owns the reader and the mapped file.
+   * @param file_name The path of the file.
+   * @param delimiter The character that separates columns within a row.
+   * @param quote The quoting character used to quote data.
+   * @param escape The character appearing before the quote character in quoted data.
+   * @return The reader, positioned before the first row.
+   * @throw ExecutionException if the file cannot be mapped.
+   */
+  static util::CSVReader *Open(exec::ExecutionContext *exec_ctx, std::string_view file_name, char delimiter,
+                               char quote, char escape);
+
+  /**
+   * Scan function callback used to scan a chunk of the file.
+   * Convention: First argument is the opaque query state (that must contain execCtx as a member),
+   *             second argument is the thread state,
+   *             third argument is a reader over a chunk of the file.
+   *             The first two arguments are void because their types are only known at runtime
+   *             (i.e., defined in generated code).
+   */
+  using ScanFn = void (*)(void *, void *, util::CSVReader *reader);
+
+  /**
+   * Perform a parallel scan over the CSV file at @em file_name using the callback function
+   * @em scan_fn on each chunk of the file. The file is split at the row boundaries a reader over the
+   * whole file would find, so every row is read by exactly one reader. This call is blocking, meaning that it only returns
+   * after the whole file has been scanned. Iteration order is non-deterministic.
+   * @param file_name The path of the file.
+   * @param delimiter The character that separates columns within a row.
+   * @param quote The quoting character used to quote data.
+   * @param escape The character appearing before the quote character in quoted data.
+   * @param query_state An opaque pointer to some query-specific state. Passed to scan functions.
+   * @param exec_ctx The execution context to run the parallel scan in. It should point to a
+   *                 ThreadStateContainer for all thread states, where it is assumed that the
+   *                 container has been configured for size, construction, and destruction
+   *                 before this invocation.
+   * @param num_threads_override If non-zero, specifies the number of threads to use
+   * @param scan_fn The callback function invoked for each chunk of the file.
+   * @throw ExecutionException if the file cannot be mapped.
+   */
+  static void ParallelScan(std::string_view file_name, char delimiter, char quote, char escape, void *query_state,
+                           exec::ExecutionContext *exec_ctx, uint32_t num_threads_override, ScanFn scan_fn);
+};
+
+}  // namespace noisepage::execution::sql
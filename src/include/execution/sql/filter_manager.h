@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <random>
 #include <utility>
@@ -55,6 +56,48 @@ class FilterManager {
    */
   using MatchFn = void (*)(exec::ExecutionContext *, VectorProjection *, TupleIdList *, void *);
 
+  /**
+   * The comparison of a zone map term, i.e., of an integer column with a constant.
+   */
+  enum class ZoneMapComparison : uint32_t { Equal, NotEqual, LessThan, LessThanEqual, GreaterThan, GreaterThanEqual };
+
+  /**
+   * A term of a clause that compares an integer column with a constant. Zone map terms are only used to skip blocks
+   * whose zone maps show that no tuple can pass the term; the clause still applies the comparison through one of its
+   * regular terms.
+   */
+  struct ZoneMapTerm {
+    /** The index of the column in the vector projection. */
+    uint32_t col_idx_;
+    /** The comparison of the column with the constant. */
+    ZoneMapComparison comparison_;
+    /** The constant. */
+    int64_t value_;
+
+    /**
+     * @param min The smallest value of the column in a block.
+     * @param max The largest value of the column in a block.
+     * @return False if no value in [min, max] passes the comparison; true otherwise.
+     */
+    bool MayMatch(int64_t min, int64_t max) const {
+      switch (comparison_) {
+        case ZoneMapComparison::Equal:
+          return min <= value_ && value_ <= max;
+        case ZoneMapComparison::NotEqual:
+          return min <= max && (min != value_ || max != value_);
+        case ZoneMapComparison::LessThan:
+          return min <= max && min < value_;
+        case ZoneMapComparison::LessThanEqual:
+          return min <= max && min <= value_;
+        case ZoneMapComparison::GreaterThan:
+          return min <= max && max > value_;
+        case ZoneMapComparison::GreaterThanEqual:
+          return min <= max && max >= value_;
+      }
+      return true;
+    }
+  };
+
   /**
    * A clause in a multi-clause disjunctive normal form filter. A clause is composed of one or more
    * terms which can be safely reordered.
@@ -74,6 +117,31 @@ class FilterManager {
      */
     void AddTerm(MatchFn term);
 
+    /**
+     * Add a zone map term to the clause.
+     * @param term The zone map term to add to this clause.
+     */
+    void AddZoneMapTerm(const ZoneMapTerm &term) { zone_map_terms_.push_back(term); }
+
+    /**
+     * @return True if the clause has zone map terms; false otherwise.
+     */
+    bool HasZoneMapTerms() const { return !zone_map_terms_.empty(); }
+
+    /**
+     * Check the zone map terms of the clause against the zone maps of a block.
+     * @tparam ZoneMapLookup Callable returning the zone map of the column at a vector projection index.
+     * @param zone_map_of The zone map lookup.
+     * @return False if no tuple in the block can pass the clause; true otherwise.
+     */
+    template <typename ZoneMapLookup>
+    bool MayMatch(const ZoneMapLookup &zone_map_of) const {
+      return std::all_of(zone_map_terms_.begin(), zone_map_terms_.end(), [&](const ZoneMapTerm &term) {
+        const auto &zone_map = zone_map_of(term.col_idx_);
+        return term.MayMatch(zone_map.Min(), zone_map.Max());
+      });
+    }
+
     /**
      * Run the clause over the given input projection.
      * @param exec_ctx The execution context to run with.
@@ -120,6 +188,8 @@ class FilterManager {
     void *opaque_context_;
     // The terms (i.e., factors) of the conjunction.
     std::vector<std::unique_ptr<Term>> terms_;
+    // The terms that can be checked against the zone maps of a block.
+    std::vector<ZoneMapTerm> zone_map_terms_;
     // Temporary lists only used during re-sampling.
     TupleIdList input_copy_;
     TupleIdList temp_;
@@ -166,6 +236,34 @@ class FilterManager {
    */
   void InsertClauseTerms(const std::vector<MatchFn> &terms);
 
+  /**
+   * Insert a zone map term in the currently active clause in the filter.
+   * @param col_idx The index of the integer column in the vector projection.
+   * @param comparison The comparison of the column with the constant.
+   * @param value The constant.
+   */
+  void InsertClauseZoneMapTerm(uint32_t col_idx, ZoneMapComparison comparison, int64_t value);
+
+  /**
+   * @return True if any clause has zone map terms, i.e., if the filter can rule out whole blocks; false otherwise.
+   */
+  bool HasZoneMapTerms() const {
+    return std::any_of(clauses_.begin(), clauses_.end(), [](const auto &clause) { return clause->HasZoneMapTerms(); });
+  }
+
+  /**
+   * Check the zone map terms of the filter against the zone maps of a block.
+   * @tparam ZoneMapLookup Callable returning the zone map of the column at a vector projection index.
+   * @param zone_map_of The zone map lookup.
+   * @return False if no tuple in the block can pass the filter; true otherwise.
+   */
+  template <typename ZoneMapLookup>
+  bool MayMatch(const ZoneMapLookup &zone_map_of) const {
+    return clauses_.empty() || std::any_of(clauses_.begin(), clauses_.end(), [&](const auto &clause) {
+             return clause->MayMatch(zone_map_of);
+           });
+  }
+
   /**
    * Run the filters over the given vector projection.
    * @param exec_ctx The execution context to run with.
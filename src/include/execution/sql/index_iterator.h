@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
@@ -35,6 +36,12 @@ class EXPORT IndexIterator {
    */
   void Init();
 
+  /**
+   * Read the table columns from the index keys where possible, see IndexOnlyPR. Every table column must be a key
+   * column of the index, and only exact and ascending scans are allowed.
+   */
+  void EnableIndexOnly();
+
   /**
    * Frees allocated resources.
    */
@@ -45,6 +52,22 @@ class EXPORT IndexIterator {
    */
   void ScanKey();
 
+  /**
+   * Add the key in the index PR to the batch of keys looked up by ScanKeyBatch.
+   */
+  void AddBatchKey();
+
+  /**
+   * Look up all keys of the batch with a single call into the index, which lets the index share and overlap work
+   * across the keys. The batch is emptied, and the results are iterated key by key through NextBatchKey.
+   */
+  void ScanKeyBatch();
+
+  /**
+   * Move on to the results of the next key of the last batch, in the order the keys were added.
+   */
+  void NextBatchKey();
+
   /**
    * Perform an ascending scan
    * @param scan_type Type of Scan
@@ -89,6 +112,13 @@ class EXPORT IndexIterator {
    */
   storage::ProjectedRow *TablePR();
 
+  /**
+   * Fill the table PR from the key of the current tuple, which skips reading the tuple if its block is all-visible.
+   * The tuple is read through TablePR otherwise.
+   * @return The resulting projected row.
+   */
+  storage::ProjectedRow *IndexOnlyPR();
+
   /**
    * @return The current tuple slot of the iterator.
    */
@@ -104,6 +134,7 @@ class EXPORT IndexIterator {
   exec::ExecutionContext *exec_ctx_;
   uint32_t num_attrs_;
   std::vector<catalog::col_oid_t> col_oids_;
+  catalog::index_oid_t index_oid_;
   common::ManagedPointer<storage::index::Index> index_;
   common::ManagedPointer<storage::SqlTable> table_;
 
@@ -115,6 +146,20 @@ class EXPORT IndexIterator {
   storage::ProjectedRow *hi_index_pr_;
   storage::ProjectedRow *table_pr_;
   std::vector<storage::TupleSlot> tuples_{};
+
+  bool index_only_ = false;
+  // Offset in the index PR and size of the key attribute of every column of the table PR
+  std::vector<std::pair<uint16_t, uint16_t>> key_attrs_{};
+  // Keys of the tuples of the last ascending scan, copied back to back into 8-byte words. Exact scans leave this
+  // empty, as the index PR is the key of every tuple.
+  std::vector<uint64_t> keys_{};
+
+  // Keys added to the current batch, copied back to back into 8-byte words so that each key PR stays aligned
+  std::vector<uint64_t> batch_key_buffer_{};
+  uint32_t num_batch_keys_ = 0;
+  // Results of the last batch, and the key whose results are iterated
+  std::vector<std::vector<storage::TupleSlot>> batch_tuples_{};
+  uint32_t batch_key_idx_ = 0;
 };
 
 }  // namespace noisepage::execution::sql
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>  // NOLINT
 #include <vector>
 
 #include "common/macros.h"
@@ -10,6 +11,7 @@
 #include "execution/sql/chaining_hash_table.h"
 #include "execution/sql/concise_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace libcount {
@@ -24,7 +26,9 @@ class ExecutionContext;
 namespace noisepage::execution::sql {
 
 class ThreadStateContainer;
+class TupleIdList;
 class Vector;
+class VectorProjection;
 
 /**
  * The main class used to for hash joins. JoinHashTables are bulk-loaded through calls to
@@ -46,6 +50,22 @@ class Vector;
  * In parallel mode, thread-local join hash tables are lazily built and merged in parallel into a
  * global join hash table through a call to JoinHashTable::MergeParallel(). After this call, the
  * global table takes ownership of all thread-local allocated memory and hash index.
+ *
+ * Chaining tables whose buffered tuples and directory exceed the last-level cache are built through
+ * radix partitioning. Pointers to the buffered tuples are first clustered by the high-order bits of
+ * their bucket position in one or more partitioning passes whose fan-out is bounded by the TLB and
+ * L1 cache. Each partition's tuples are then inserted into the directory where they are buffered,
+ * so partitioning never copies tuples. Since a partition maps to a contiguous range of directory
+ * slots, each partition is sized to fit in the L2 cache, and partitions can be inserted in parallel
+ * without synchronization.
+ *
+ * Tables with spilling enabled through JoinHashTable::EnableSpilling() perform a Grace hash join
+ * once the query exceeds its memory budget. Build-side tuples are split into spill partitions by the
+ * high-order bits of their hash. Partitions are written to disk, and their memory is released, one
+ * half of the resident partitions at a time until the query is back within its budget. Probes of
+ * tuples that belong to a spilled partition are deferred to disk through
+ * JoinHashTable::DeferProbe(). Once the probe is complete, JoinHashTable::ProbeSpilledPartitions()
+ * loads each spilled partition into memory in turn and joins it with its deferred probes.
  */
 class EXPORT JoinHashTable {
  public:
@@ -57,12 +77,34 @@ class EXPORT JoinHashTable {
     NUM_HOOKS
   };
 
+  /**
+   * Function to join a deferred probe-side tuple with a table built over its spilled partition.
+   * Receives, in order: an opaque query state, an opaque pipeline state, the table over the spilled
+   * partition, and the deferred probe-side tuple.
+   */
+  using ProbeSpilledFn = void (*)(void *, void *, JoinHashTable *, const byte *);
+
   /** Default precision to use for HLL estimations. */
   static constexpr uint32_t DEFAULT_HLL_PRECISION = 10;
 
   /** Minimum number of expected elements to merge before triggering a parallel merge. */
   static constexpr uint32_t DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE = 1024;
 
+  /** The maximum number of radix bits used to partition the build side of a chaining table. */
+  static constexpr uint32_t MAX_RADIX_BITS = 16;
+
+  /** The number of tuples inserted between checks of the query's memory budget. */
+  static constexpr uint32_t MEMORY_BUDGET_CHECK_INTERVAL = 1024;
+
+  /** The log of the number of partitions the build side is split into when it spills to disk. */
+  static constexpr uint32_t LOG_NUM_SPILL_PARTITIONS = 5;
+
+  /** The number of partitions the build side is split into when it spills to disk. */
+  static constexpr uint32_t NUM_SPILL_PARTITIONS = 1u << LOG_NUM_SPILL_PARTITIONS;
+
+  /** The size of the I/O buffer of each partition written to disk. */
+  static constexpr std::size_t SPILL_BLOCK_SIZE = 64 * 1024;
+
   /**
    * Construct a join hash table. All memory allocations are sourced from the injected @em memory,
    * and thus, are ephemeral.
@@ -91,9 +133,46 @@ class EXPORT JoinHashTable {
    * inserted entry.
    * @param hash The hash value of the tuple to insert.
    * @return A memory region where the caller can materialize the tuple.
+   * @throw ExecutionException If the query has exceeded its memory budget and spilling is disabled.
    */
   byte *AllocInputTuple(hash_t hash);
 
+  /**
+   * Let this table spill build-side tuples to disk when the query exceeds its memory budget. Probes
+   * of tuples whose partition was spilled must then be deferred through JoinHashTable::DeferProbe()
+   * and completed through JoinHashTable::ProbeSpilledPartitions().
+   * @param probe_tuple_size The size of the probe-side tuples that can be deferred.
+   */
+  void EnableSpilling(uint32_t probe_tuple_size);
+
+  /**
+   * @return True if tuples whose hash value is @em hash belong to a partition that was spilled to
+   *         disk; false otherwise. Lookups never return tuples of spilled partitions.
+   */
+  bool IsPartitionSpilled(const hash_t hash) const noexcept {
+    return SpillPartitionIndex(hash) >= num_resident_partitions_;
+  }
+
+  /**
+   * Defer the probe of a tuple whose partition was spilled to disk. A copy of the tuple is written
+   * to disk alongside the partition. This function is thread-safe.
+   * @pre The partition of @em hash must have been spilled.
+   * @param hash The hash value of the probe-side tuple.
+   * @param probe_tuple The probe-side tuple.
+   */
+  void DeferProbe(hash_t hash, const byte *probe_tuple);
+
+  /**
+   * Complete all deferred probes. Each spilled partition that has deferred probes is loaded into a
+   * table of its own, and @em probe_fn is invoked on that table with each of its deferred probes.
+   * Only one spilled partition is in memory at a time.
+   * @pre The table must have been built, and all probes must have completed.
+   * @param query_state The query state passed to @em probe_fn.
+   * @param pipeline_state The pipeline state passed to @em probe_fn.
+   * @param probe_fn The function joining a deferred probe-side tuple with its partition.
+   */
+  void ProbeSpilledPartitions(void *query_state, void *pipeline_state, ProbeSpilledFn probe_fn);
+
   /**
    * Build and finalize the join hash table. After finalization, no new insertions are allowed and
    * the table becomes read-only. Nothing is done if the join hash table has already been finalized.
@@ -118,6 +197,28 @@ class EXPORT JoinHashTable {
    */
   void LookupBatch(const Vector &hashes, Vector *results) const;
 
+  /**
+   * Build a bloom filter over the hash values of all tuples in this table. The filter allows the
+   * probe side of the join to discard tuples that definitely have no join partner before they ever
+   * reach the join. Nothing is done if the table is empty or if the filter has already been built.
+   * @pre The table must have been built through JoinHashTable::Build() or
+   *      JoinHashTable::MergeParallel().
+   */
+  void BuildBloomFilter();
+
+  /**
+   * Remove all tuples from @em tid_list whose join keys definitely do not exist in this table. The
+   * hash of a tuple in @em input is computed over the columns at the indexes in @em key_cols, in
+   * order, and is checked against the bloom filter built through JoinHashTable::BuildBloomFilter().
+   * Nothing is done if a bloom filter hasn't been built.
+   * @param input The projection containing the probe-side tuples.
+   * @param tid_list The list of active tuples in @em input. Updated in-place.
+   * @param key_cols The indexes of the join key columns in @em input.
+   * @param num_key_cols The number of join key columns.
+   */
+  void ProbeBloomFilter(const VectorProjection &input, TupleIdList *tid_list, const uint32_t *key_cols,
+                        uint32_t num_key_cols) const;
+
   /**
    * Merge all thread-local hash tables stored in the state contained into this table. Perform the
    * merge in parallel.
@@ -184,6 +285,16 @@ class EXPORT JoinHashTable {
    */
   bool UsingConciseHashTable() const { return use_concise_ht_; }
 
+  /**
+   * @return True if any partition of the build side was spilled to disk; false otherwise.
+   */
+  bool HasSpilled() const noexcept { return num_resident_partitions_ < NUM_SPILL_PARTITIONS; }
+
+  /**
+   * @return True if the chaining table was built through radix partitioning; false otherwise.
+   */
+  bool UsingPartitionedBuild() const { return num_radix_bits_ > 0; }
+
   /**
    * @return The underlying bloom filter.
    */
@@ -193,6 +304,10 @@ class EXPORT JoinHashTable {
   friend class JoinHashTableIterator;
   FRIEND_TEST(JoinHashTableTest, LazyInsertionTest);
   FRIEND_TEST(JoinHashTableTest, PerfTest);
+  FRIEND_TEST(JoinHashTableTest, PartitionedBuildTest);
+  FRIEND_TEST(JoinHashTableTest, ParallelPartitionedBuildTest);
+  FRIEND_TEST(JoinHashTableTest, SpillTest);
+  FRIEND_TEST(JoinHashTableTest, ParallelSpillTest);
 
   // Access a stored entry by index
   HashTableEntry *EntryAt(const uint64_t idx) { return reinterpret_cast<HashTableEntry *>(entries_[idx]); }
@@ -205,6 +320,17 @@ class EXPORT JoinHashTable {
   void BuildChainingHashTable();
   void BuildConciseHashTable();
 
+  // Should a chaining table over 'num_tuples' buffered tuples be built through radix partitioning?
+  // The directory must already be sized.
+  bool ShouldPartitionBuild(uint64_t num_tuples) const;
+
+  // Build the (already sized) chaining hash table by radix partitioning all tuples buffered in the
+  // provided entry lists. Tuples are inserted in place, so the caller must keep the source lists
+  // alive for the lifetime of the table. If a thread state container is provided, partitioning and
+  // insertion occur in parallel.
+  void BuildPartitionedChainingHashTable(const std::vector<util::ChunkedVector<MemoryPoolAllocator<byte>> *> &sources,
+                                         ThreadStateContainer *thread_state_container);
+
   // Dispatched from BuildConciseHashTable() to construct the concise hash table
   // and to reorder buffered build tuples in place according to the CHT.
   template <bool PrefetchCHT, bool PrefetchEntries>
@@ -219,12 +345,35 @@ class EXPORT JoinHashTable {
   // Dispatched from LookupBatch() to lookup from either a chaining or concise
   // hash table in batched manner.
   void LookupBatchInChainingHashTable(const Vector &hashes, Vector *results) const;
+  void LookupBatchInPartitionedHashTable(const Vector &hashes, Vector *results) const;
   void LookupBatchInConciseHashTable(const Vector &hashes, Vector *results) const;
 
   // Merge the source hash table (which isn't built yet) into this one
   template <bool Concurrent>
   void MergeIncomplete(JoinHashTable *source);
 
+  // The spill partition of tuples whose hash value is 'hash'.
+  static uint32_t SpillPartitionIndex(const hash_t hash) noexcept {
+    return static_cast<uint32_t>(hash >> (sizeof(hash_t) * 8 - LOG_NUM_SPILL_PARTITIONS));
+  }
+
+  // Called periodically during the build. Writes staged tuples to disk and, if the query is over
+  // its memory budget, spills half the resident partitions or fails the query if spilling is off.
+  void EnforceMemoryBudget();
+
+  // Write all staged tuples of spilled partitions to disk.
+  void FlushStagedTuples();
+
+  // Spill all buffered tuples of the partitions at or after 'num_resident_partitions' to disk. Only
+  // the partitions before it remain in memory.
+  void SpillPartitions(uint32_t num_resident_partitions);
+
+  // Append a build-side entry to the file of its spilled partition.
+  void AppendToSpilledPartition(const HashTableEntry *entry);
+
+  // Flush and finish all spilled build-side partitions so they can be read.
+  void FinishSpilledPartitions();
+
  private:
   // The execution context to run with.
   const exec::ExecutionSettings &exec_settings_;
@@ -259,8 +408,39 @@ class EXPORT JoinHashTable {
   // Should we use a concise hash table?
   bool use_concise_ht_;
 
+  // The number of radix bits the chaining table was partitioned on. Zero if not partitioned.
+  uint32_t num_radix_bits_;
+
+  // The minimum size (in bytes) of the buffered tuples and directory before the chaining table is
+  // built through radix partitioning, and the target size of each partition. These default to the
+  // last-level and L2 cache sizes, respectively.
+  uint64_t min_partitioned_build_size_;
+  uint64_t target_partition_size_;
+
   // MemoryTracker
   common::ManagedPointer<MemoryTracker> tracker_;
+
+  // Can the build side spill to disk? If so, the size of the probe-side tuples that are deferred.
+  bool spill_enabled_;
+  uint32_t probe_tuple_size_;
+
+  // The number of tuples allocated, used to schedule checks of the memory budget.
+  uint64_t num_inserts_;
+
+  // The spill partitions before this one are in memory. All others are spilled to disk.
+  uint32_t num_resident_partitions_;
+
+  // Tuples of spilled partitions are filled in after they're allocated. They're staged here until
+  // the next check of the memory budget, when they're written to disk.
+  util::ChunkedVector<MemoryPoolAllocator<byte>> staged_entries_;
+
+  // The build-side entries of each spilled partition. A table built in parallel takes over the
+  // files of each thread-local table.
+  std::vector<std::vector<std::unique_ptr<SpillFile>>> spilled_build_;
+
+  // The deferred probe-side tuples of each spilled partition. Protected by 'spilled_probes_latch_'.
+  std::mutex spilled_probes_latch_;
+  std::vector<std::unique_ptr<SpillFile>> spilled_probes_;
 };
 
 // ---------------------------------------------------------
@@ -298,6 +478,7 @@ inline HashTableEntryIterator JoinHashTable::Lookup<true>(const hash_t hash) con
  *
  * The join hash table must be fully built either through a serial call to JoinHashTable::Build()
  * or merged (in parallel) from other join hash tables through JoinHashTable::MergeParallel().
+ * Tuples of partitions spilled to disk are not visited.
  *
  * Users use the OOP-ish iteration API:
  * for (JoinHashTableIterator iter(table); iter.HasNext(); iter.Next()) {
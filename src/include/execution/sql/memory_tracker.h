@@ -2,14 +2,25 @@
 
 #include <tbb/enumerable_thread_specific.h>
 
+#include <atomic>
+#include <cstdint>
+
 namespace noisepage::execution::sql {
 
 /**
  * Class for tracking memory on a per-thread granularity.
- * Currently tracks allocation size in bytes during thread's execution.
+ * Currently tracks allocation size in bytes during thread's execution, along with the total
+ * allocation size across all threads which is used to enforce per-query memory budgets.
+ *
+ * To keep allocation cheap, each thread accumulates its changes locally and only publishes them to
+ * the shared total once they reach MemoryTracker::PUBLISH_THRESHOLD bytes. The total may therefore
+ * lag behind by up to that many bytes per thread.
  */
 class EXPORT MemoryTracker {
  public:
+  /** The number of bytes a thread may allocate or free before publishing the change to the total. */
+  static constexpr int64_t PUBLISH_THRESHOLD = 64 * 1024;
+
   /**
    * Reset tracker
    */
@@ -20,17 +31,33 @@ class EXPORT MemoryTracker {
    */
   size_t GetAllocatedSize() { return stats_.local().allocated_bytes_; }
 
+  /**
+   * @returns number of allocated bytes across all threads
+   */
+  size_t GetTotalAllocatedSize() const {
+    const int64_t total = total_allocated_bytes_.load(std::memory_order_relaxed);
+    return total < 0 ? 0 : static_cast<size_t>(total);
+  }
+
   /**
    * Increments number of allocated bytes
    * @param size number to increment by
    */
-  void Increment(size_t size) { stats_.local().allocated_bytes_ += size; }
+  void Increment(size_t size) {
+    auto &stats = stats_.local();
+    stats.allocated_bytes_ += size;
+    Publish(&stats, static_cast<int64_t>(size));
+  }
 
   /**
    * Decrements number of allocated bytes
    * @param size number to decrement by
    */
-  void Decrement(size_t size) { stats_.local().allocated_bytes_ -= size; }
+  void Decrement(size_t size) {
+    auto &stats = stats_.local();
+    stats.allocated_bytes_ -= size;
+    Publish(&stats, -static_cast<int64_t>(size));
+  }
 
  private:
   /**
@@ -39,8 +66,23 @@ class EXPORT MemoryTracker {
   struct Stats {
     // Number of bytes allocated
     size_t allocated_bytes_ = 0;
+    // Change in allocated bytes not yet added to the total
+    int64_t unpublished_bytes_ = 0;
   };
+
+  // Accumulate a change in the thread's allocated bytes, adding it to the total once large enough.
+  void Publish(Stats *stats, const int64_t delta) {
+    stats->unpublished_bytes_ += delta;
+    if (stats->unpublished_bytes_ >= PUBLISH_THRESHOLD || stats->unpublished_bytes_ <= -PUBLISH_THRESHOLD) {
+      total_allocated_bytes_.fetch_add(stats->unpublished_bytes_, std::memory_order_relaxed);
+      stats->unpublished_bytes_ = 0;
+    }
+  }
+
   tbb::enumerable_thread_specific<Stats> stats_;
+  // Number of bytes allocated across all threads. Signed since memory may be freed by a different
+  // thread than the one that allocated it.
+  std::atomic<int64_t> total_allocated_bytes_{0};
 };
 
 }  // namespace noisepage::execution::sql
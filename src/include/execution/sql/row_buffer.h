@@ -0,0 +1,172 @@
+#pragma once
+
+#include <memory>
+
+#include "common/macros.h"
+#include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
+#include "execution/util/chunked_vector.h"
+
+namespace noisepage::execution::exec {
+class ExecutionContext;
+}
+
+namespace noisepage::execution::sql {
+
+/**
+ * A RowBuffer is an append-only buffer of fixed-size rows that are read back in insertion order.
+ * Rows are kept in memory until the query exceeds its memory budget. At that point, all buffered
+ * rows are moved to a SpillFile, and rows appended later are written to the same file.
+ *
+ * Rows are appended through RowBuffer::AllocInputRow(). Once all rows have been appended, any
+ * number of RowBufferIterator instances can read them. Each iterator can remember a position and
+ * later rewind to it, which is what sort-merge joins need to re-read a group of rows with equal
+ * keys.
+ *
+ * @code
+ * RowBuffer buffer(exec_ctx, sizeof(Row));
+ * for (...) {
+ *   auto row = reinterpret_cast<Row *>(buffer.AllocInputRow());
+ *   row->a = ...
+ * }
+ * buffer.Finish();
+ * RowBufferIterator iter(buffer);
+ * @endcode
+ */
+class RowBuffer {
+ public:
+  /** The number of appended rows between checks of the query's memory budget. */
+  static constexpr uint64_t MEMORY_BUDGET_CHECK_INTERVAL = 1024;
+
+  /**
+   * Create a new, empty buffer.
+   * @param exec_ctx The execution context of the query.
+   * @param row_size The size of each row, in bytes.
+   */
+  RowBuffer(exec::ExecutionContext *exec_ctx, uint32_t row_size);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(RowBuffer);
+
+  /**
+   * Destructor.
+   */
+  ~RowBuffer();
+
+  /**
+   * Allocate space for a new row at the end of the buffer.
+   * @pre The buffer must not have been finished.
+   * @return A pointer to the memory for the row. It remains valid until the next call to
+   *         AllocInputRow() or Finish().
+   */
+  byte *AllocInputRow();
+
+  /**
+   * Indicate that all rows have been appended. Must be called before the rows are read. Calling it
+   * more than once has no effect.
+   */
+  void Finish();
+
+  /**
+   * @return The number of rows in the buffer.
+   */
+  uint64_t GetRowCount() const noexcept { return num_rows_; }
+
+  /**
+   * @return True if the rows have been moved to disk; false otherwise.
+   */
+  bool HasSpilled() const noexcept { return spill_file_ != nullptr; }
+
+ private:
+  friend class RowBufferIterator;
+
+  // Move all rows held in memory to the spill file, creating it if needed.
+  void SpillRows();
+
+ private:
+  exec::ExecutionContext *exec_ctx_;
+  // All rows while the buffer is in memory. Once spilled, the rows not yet written to disk.
+  util::ChunkedVector<MemoryPoolAllocator<byte>> rows_;
+  // The file holding the rows once the buffer has spilled.
+  std::unique_ptr<SpillFile> spill_file_;
+  // The total number of rows appended.
+  uint64_t num_rows_;
+  // Have all rows been appended?
+  bool finished_;
+};
+
+/**
+ * A forward iterator over the rows of a finished RowBuffer, in insertion order. The iterator can
+ * mark its current position and rewind to the mark later. Rewinding a spilled buffer only re-reads
+ * the file if the marked row is no longer in the iterator's read buffer.
+ */
+class RowBufferIterator {
+ public:
+  /**
+   * Create an iterator positioned at the first row of the buffer. The mark is set to that row.
+   * @pre The buffer must have been finished.
+   * @param buffer The buffer to iterate.
+   */
+  explicit RowBufferIterator(const RowBuffer &buffer);
+
+  /**
+   * Destructor.
+   */
+  ~RowBufferIterator();
+
+  /**
+   * @return True if the iterator is positioned at a row; false if all rows have been read.
+   */
+  bool HasNext() const noexcept { return row_ != nullptr; }
+
+  /**
+   * Advance the iterator by one row.
+   */
+  void Next() {
+    NOISEPAGE_ASSERT(HasNext(), "Cannot advance an exhausted iterator");
+    pos_++;
+    row_ = FetchRow();
+  }
+
+  /**
+   * @return A pointer to the current row. The row remains valid until the iterator is moved.
+   */
+  const byte *GetRow() const noexcept {
+    NOISEPAGE_ASSERT(HasNext(), "Invalid iterator");
+    return row_;
+  }
+
+  /**
+   * Remember the current position of the iterator.
+   */
+  void Mark() noexcept { mark_ = pos_; }
+
+  /**
+   * Move the iterator back to the position remembered by the last call to Mark().
+   */
+  void Rewind();
+
+ private:
+  // Read the row at the current position, or return NULL if the position is past the end.
+  const byte *FetchRow() {
+    if (reader_ == nullptr) {
+      return pos_ < buffer_.rows_.size() ? buffer_.rows_[pos_] : nullptr;
+    }
+    return reader_->Next();
+  }
+
+ private:
+  // The buffer being iterated.
+  const RowBuffer &buffer_;
+  // The reader over the buffer's spill file, if it has spilled.
+  std::unique_ptr<SpillFile::Reader> reader_;
+  // The index of the current row, and the index of the marked row.
+  uint64_t pos_;
+  uint64_t mark_;
+  // The current row.
+  const byte *row_;
+};
+
+}  // namespace noisepage::execution::sql
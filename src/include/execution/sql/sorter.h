@@ -7,6 +7,7 @@
 #include "catalog/schema.h"
 #include "common/macros.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace noisepage::execution::exec {
@@ -15,6 +16,7 @@ class ExecutionContext;
 
 namespace noisepage::execution::sql {
 
+class SortedRunMerger;
 class ThreadStateContainer;
 class VectorProjection;
 class VectorProjectionIterator;
@@ -67,6 +69,14 @@ class VectorProjectionIterator;
  * thread-local Sorter, but <b>without calling</b> Sorter::Sort(). When all insertions are complete
  * across all threads, the primary thread uses Sorter::SortParallel() or Sorter::SortTopKParallel()
  * for parallel sort and parallel Top-K, respectively.
+ *
+ * If the query exceeds its memory budget (see exec::ExecutionContext::IsOverMemoryBudget()) while
+ * tuples are being inserted, the Sorter performs an external merge sort: the buffered tuples are
+ * sorted and written to disk as a sorted run, and their memory is released. After sorting, the
+ * spilled runs and any remaining in-memory tuples are merged on-the-fly by SorterIterator, which
+ * streams the runs back from disk. If there are too many runs to merge at once, groups of runs are
+ * first merged into longer runs on disk so that the final merge reads at most
+ * Sorter::MAX_MERGE_FAN_IN sources. Top-K sorters never spill since they only buffer K tuples.
  */
 class EXPORT Sorter {
  public:
@@ -91,6 +101,17 @@ class EXPORT Sorter {
   static constexpr uint64_t DEFAULT_MIN_TUPLES_FOR_PARALLEL_SORT = 10000;
 #endif
 
+  /**
+   * The number of tuples inserted between checks of the query's memory budget.
+   */
+  static constexpr uint64_t MEMORY_BUDGET_CHECK_INTERVAL = 1024;
+
+  /**
+   * The maximum number of sorted sources (spilled runs and in-memory tuples) merged at once. Each
+   * source being merged buffers a block of tuples read from disk.
+   */
+  static constexpr uint32_t MAX_MERGE_FAN_IN = 64;
+
   /**
    * The comparison function used to sort tuples in a Sorter.
    */
@@ -166,9 +187,19 @@ class EXPORT Sorter {
   void SortTopKParallel(ThreadStateContainer *thread_state_container, uint32_t sorter_offset, uint64_t top_k);
 
   /**
-   * @return The number of tuples currently in this sorter.
+   * @return The number of tuples currently in this sorter, including those spilled to disk.
+   */
+  uint64_t GetTupleCount() const noexcept { return tuples_.size() + num_spilled_tuples_; }
+
+  /**
+   * @return True if any tuples in this sorter have been spilled to disk; false otherwise.
+   */
+  bool HasSpilled() const noexcept { return !spilled_runs_.empty(); }
+
+  /**
+   * @return The number of sorted runs spilled to disk that are merged during iteration.
    */
-  uint64_t GetTupleCount() const noexcept { return tuples_.size(); }
+  uint64_t GetSpilledRunCount() const noexcept { return spilled_runs_.size(); }
 
   /**
    * @return True if this sorter contains no tuples; false otherwise.
@@ -188,7 +219,17 @@ class EXPORT Sorter {
   // property
   void HeapSiftDown();
 
+  // Allocate room for a tuple without checking the memory budget
+  byte *AppendTuple();
+
+  // Sort all buffered tuples, write them to disk as a sorted run, and release their memory
+  void SpillRun();
+
+  // Merge groups of spilled runs into longer runs until the final merge is within the fan-in limit
+  void MergeSpilledRuns();
+
  private:
+  friend class SortedRunMerger;
   friend class SorterIterator;
   friend class SorterVectorIterator;
 
@@ -208,6 +249,12 @@ class EXPORT Sorter {
   // Vector of pointers to each entry. This is the vector that's sorted.
   MemPoolVector<const byte *> tuples_;
 
+  // Sorted runs written to disk after the query exceeded its memory budget
+  std::vector<std::unique_ptr<SpillFile>> spilled_runs_;
+
+  // The total number of tuples in all spilled runs
+  uint64_t num_spilled_tuples_;
+
   // Flag indicating if the contents of the sorter have been sorted
   bool sorted_;
 };
@@ -220,20 +267,32 @@ class SorterIterator {
 
  public:
   /**
-   * Create an iterator over the provided sorter.
+   * Create an iterator over the provided sorter. If the sorter has spilled to disk, the iterator
+   * merges the spilled runs as it advances.
    * @param sorter The sorter instance.
    */
   explicit SorterIterator(const Sorter &sorter);
 
+  /**
+   * Destructor.
+   */
+  ~SorterIterator();
+
   /**
    * @return True if the iterator has more data; false otherwise.
    */
-  bool HasNext() const { return iter_ != end_; }
+  bool HasNext() const { return merger_ == nullptr ? iter_ != end_ : HasNextMerged(); }
 
   /**
    * Advance the iterator by one tuple.
    */
-  void Next() { ++iter_; }
+  void Next() {
+    if (merger_ == nullptr) {
+      ++iter_;
+    } else {
+      NextMerged();
+    }
+  }
 
   /**
    * Advance the iterator by @em n rows. If there are fewer than @em n rows remaining in this
@@ -245,14 +304,16 @@ class SorterIterator {
   /**
    * @return The number of tuples remaining in the iterator.
    */
-  uint64_t NumRemaining() const { return std::distance(iter_, end_); }
+  uint64_t NumRemaining() const;
 
   /**
    * @return A pointer to the current row. It assumed the called has checked the iterator is valid.
+   *         When merging spilled runs, the row remains valid for the next
+   *         common::Constants::K_DEFAULT_VECTOR_SIZE advancements of the iterator.
    */
   const byte *GetRow() const {
-    NOISEPAGE_ASSERT(iter_ != end_, "Invalid iterator");
-    return *iter_;
+    NOISEPAGE_ASSERT(HasNext(), "Invalid iterator");
+    return merger_ == nullptr ? *iter_ : GetRowMerged();
   }
 
   /**
@@ -281,11 +342,19 @@ class SorterIterator {
     return *this;
   }
 
+ private:
+  // Out-of-line iteration over merged spilled runs.
+  bool HasNextMerged() const;
+  void NextMerged();
+  const byte *GetRowMerged() const;
+
  private:
   // The current iterator position
   IteratorType iter_;
   // The ending iterator position
   const IteratorType end_;
+  // The merger over spilled runs, if the sorter has spilled
+  std::unique_ptr<SortedRunMerger> merger_;
 };
 
 /**
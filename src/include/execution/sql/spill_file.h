@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+#include "execution/util/execution_common.h"
+#include "execution/util/file.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * A SpillFile is a temporary file of fixed-size tuples written by operators whose state no longer
+ * fits in their query's memory budget. The file is unlinked as soon as it's created, so its space
+ * is reclaimed when it's destroyed, even if the query fails.
+ *
+ * Tuples are appended through a buffered writer. Once all tuples have been written and the file
+ * has been finished through SpillFile::Finish(), the tuples can be streamed back in insertion order
+ * through any number of independent SpillFile::Reader instances. Both the writer and the readers
+ * only buffer a single block of tuples in memory.
+ *
+ * @code
+ * SpillFile file(directory, tuple_size);
+ * for (tuple in tuples) {
+ *   file.Append(tuple);
+ * }
+ * file.Finish();
+ * SpillFile::Reader reader(file);
+ * for (const byte *tuple = reader.Next(); tuple != nullptr; tuple = reader.Next()) {
+ *   ...
+ * }
+ * @endcode
+ *
+ * Tuples are written byte-for-byte. Pointers embedded in tuples (e.g., to out-of-line string data)
+ * are preserved, so their targets must outlive the file.
+ */
+class SpillFile {
+ public:
+  /** The default size of the I/O buffer used when writing or reading a spill file. */
+  static constexpr std::size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+  /**
+   * Create a new spill file in the given directory.
+   * @param directory The directory to create the file in.
+   * @param tuple_size The size of each tuple, in bytes.
+   * @param block_size The size of the write buffer, in bytes. Rounded down to a multiple of the
+   *                   tuple size, with room for at least one tuple.
+   * @throw ExecutionException If the file cannot be created.
+   */
+  SpillFile(const std::string &directory, std::size_t tuple_size, std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /**
+   * Destructor. Closes and removes the file.
+   */
+  ~SpillFile();
+
+  /**
+   * Append a copy of the tuple at @em tuple to the file.
+   * @pre The file must not have been finished.
+   * @param tuple The tuple to write.
+   * @throw ExecutionException If the tuple cannot be written.
+   */
+  void Append(const byte *tuple) {
+    NOISEPAGE_ASSERT(!finished_, "Cannot append to a finished spill file");
+    if (buffer_pos_ == buffer_end_) {
+      FlushBuffer();
+    }
+    std::memcpy(buffer_pos_, tuple, tuple_size_);
+    buffer_pos_ += tuple_size_;
+    num_tuples_++;
+  }
+
+  /**
+   * Flush all buffered tuples and release the write buffer. Must be called before reading.
+   * @throw ExecutionException If the buffered tuples cannot be written.
+   */
+  void Finish();
+
+  /**
+   * @return The number of tuples in the file.
+   */
+  uint64_t GetTupleCount() const noexcept { return num_tuples_; }
+
+  /**
+   * @return The size of each tuple in the file, in bytes.
+   */
+  std::size_t GetTupleSize() const noexcept { return tuple_size_; }
+
+  /**
+   * A sequential, streaming reader over the tuples in a finished spill file.
+   */
+  class Reader {
+   public:
+    /**
+     * Create a reader positioned at the first tuple in @em file.
+     * @pre The file must have been finished.
+     * @param file The file to read.
+     * @param block_size The size of the read buffer, in bytes. Rounded down to a multiple of the
+     *                   tuple size, with room for at least one tuple.
+     */
+    explicit Reader(const SpillFile &file, std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    /**
+     * Create a reader over the @em num_tuples tuples in @em file starting at tuple @em first_tuple.
+     * @pre The file must have been finished, and the range must be within the file.
+     * @param file The file to read.
+     * @param first_tuple The index of the first tuple to read.
+     * @param num_tuples The number of tuples to read.
+     * @param block_size The size of the read buffer, in bytes. Rounded down to a multiple of the
+     *                   tuple size, with room for at least one tuple.
+     */
+    Reader(const SpillFile &file, uint64_t first_tuple, uint64_t num_tuples,
+           std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    /**
+     * @return A pointer to the next tuple in the file, or NULL if all tuples have been read. The
+     *         returned tuple remains valid until the next call to Next().
+     * @throw ExecutionException If the file cannot be read.
+     */
+    const byte *Next() {
+      if (buffer_pos_ == buffer_end_) {
+        if (file_offset_ == end_offset_) {
+          return nullptr;
+        }
+        FillBuffer();
+      }
+      const byte *tuple = buffer_pos_;
+      buffer_pos_ += file_.tuple_size_;
+      return tuple;
+    }
+
+    /**
+     * Reposition the reader so that the next call to Next() returns the tuple at index
+     * @em tuple_idx in the file. If that tuple is still in the read buffer, no I/O is done.
+     * @param tuple_idx The index of the tuple in the file. Must be within the reader's range.
+     */
+    void Seek(uint64_t tuple_idx);
+
+   private:
+    // Read the next block of tuples into the buffer.
+    void FillBuffer();
+
+   private:
+    // The file being read.
+    const SpillFile &file_;
+    // The read buffer.
+    std::size_t buffer_size_;
+    std::unique_ptr<byte[]> buffer_;
+    // The position of the next tuple in the buffer, and the end of the valid buffered tuples.
+    const byte *buffer_pos_;
+    const byte *buffer_end_;
+    // The offset in the file of the next unbuffered tuple, and the offset where reading stops.
+    std::size_t file_offset_;
+    std::size_t end_offset_;
+  };
+
+ private:
+  // Write all buffered tuples into the file.
+  void FlushBuffer();
+
+ private:
+  // The underlying file.
+  util::File file_;
+  // The size of each tuple.
+  std::size_t tuple_size_;
+  // The write buffer.
+  std::size_t buffer_size_;
+  std::unique_ptr<byte[]> buffer_;
+  // The position of the next tuple to write in the buffer, and the end of the buffer.
+  byte *buffer_pos_;
+  byte *buffer_end_;
+  // The number of bytes written to the file.
+  std::size_t file_size_;
+  // The number of tuples appended.
+  uint64_t num_tuples_;
+  // Has the file been finished?
+  bool finished_;
+};
+
+}  // namespace noisepage::execution::sql
@@ -25,6 +25,8 @@ class ExecutionContext;
 
 namespace sql {
 
+class Sorter;
+
 /**
  * Base class to interact with the storage layer (tables and indexes).
  */
@@ -106,6 +108,20 @@ class EXPORT StorageInterface {
    */
   bool IndexInsertWithTuple(storage::TupleSlot table_tuple_slot, bool unique);
 
+  /**
+   * Add the current index PR and the given tuple slot to the entries that bulk load the current index
+   * @param sorter sorter collecting the bulk load entries, initialized with the index's comparison and entry size
+   * @param table_tuple_slot tuple slot
+   */
+  void IndexBulkLoadInsert(Sorter *sorter, storage::TupleSlot table_tuple_slot);
+
+  /**
+   * Bulk load the current index, which must be empty, from the entries of a sorted sorter
+   * @param sorter sorted sorter holding the bulk load entries
+   * @return Whether the bulk load was successful, i.e., no uniqueness constraint was violated.
+   */
+  bool IndexBulkLoad(const Sorter &sorter);
+
   /**
    * @returns index heap size
    */
@@ -17,6 +17,7 @@ class SqlTable;
 
 namespace noisepage::execution::sql {
 
+class FilterManager;
 class ThreadStateContainer;
 
 /**
@@ -88,6 +89,13 @@ class EXPORT TableVectorIterator {
    */
   bool Advance();
 
+  /**
+   * Skip the blocks whose zone maps show that none of their tuples can pass the filter. Does nothing if the filter has
+   * no zone map terms.
+   * @param filter The filter the tuples of the scan are run through. It must outlive the iterator.
+   */
+  void SkipBlocks(const FilterManager *filter);
+
   /**
    * @return True if the iterator has been initialized; false otherwise.
    */
@@ -115,7 +123,8 @@ class EXPORT TableVectorIterator {
    * Perform a parallel scan over the table with ID @em table_id using the callback function
    * @em scanner on each input vector projection from the source table. This call is blocking,
    * meaning that it only returns after the whole table has been scanned. Iteration order is
-   * non-deterministic.
+   * non-deterministic. When the blocks of the table are spread over NUMA nodes, the blocks of each
+   * node are scanned by a share of the threads pinned to that node.
    * @param table_oid The ID of the table to scan.
    * @param col_oids The column OIDs of the table to scan.
    * @param num_oids The number of column OIDs provided in col_oids.
@@ -147,8 +156,15 @@ class EXPORT TableVectorIterator {
   // An iterator over the currently active projection.
   VectorProjectionIterator vector_projection_iterator_;
 
+  // The filter whose zone map terms decide which blocks are skipped, if any.
+  const FilterManager *block_filter_{nullptr};
+
   // True if the iterator has been initialized.
   bool initialized_{false};
+
+  // Check a block against the zone map terms of the block filter.
+  static bool BlockMayMatch(const void *iter, storage::RawBlock *block);
+
   bool Init(common::ManagedPointer<storage::SqlTable> table, const catalog::Schema &schema, uint32_t block_start,
             uint32_t block_end);
 };
@@ -41,6 +41,12 @@ class CpuInfo {
    */
   static constexpr const uint32_t K_NUM_CACHE_LEVELS = CacheLevel::L3_CACHE + 1;
 
+  /**
+   * The number of data TLB entries assumed when the OS doesn't report it. This matches the size of
+   * the first-level data TLB for 4KB pages on most recent x86 micro-architectures.
+   */
+  static constexpr const uint32_t K_DEFAULT_TLB_ENTRIES = 64;
+
   // -------------------------------------------------------
   // Main API
   // -------------------------------------------------------
@@ -83,6 +89,12 @@ y   * @return The size of a cache line at level @em level.
    */
   uint32_t GetCacheLineSize(const CacheLevel level) const noexcept { return cache_line_sizes_[level]; }
 
+  /**
+   * @return The number of data TLB entries for 4KB pages. If the OS doesn't expose this value, a
+   *         conservative default of CpuInfo::K_DEFAULT_TLB_ENTRIES is returned.
+   */
+  uint32_t GetTlbEntryCount() const noexcept { return tlb_entries_; }
+
   /**
    * @return The number of reference cycles advanced per microsecond.
    */
@@ -121,6 +133,7 @@ y   * @return The size of a cache line at level @em level.
   uint64_t ref_cycles_us_;
   uint32_t cache_sizes_[K_NUM_CACHE_LEVELS];
   uint32_t cache_line_sizes_[K_NUM_CACHE_LEVELS];
+  uint32_t tlb_entries_{K_DEFAULT_TLB_ENTRIES};
   std::bitset<Feature::MAX> hardware_flags_;
 };
 
@@ -1,13 +1,13 @@
 #pragma once
 
-#if 0
-#include <charconv>  // TODO(WAN): charconv missing on Ubuntu 18.04
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "common/constants.h"
 #include "execution/util/file.h"
+#include "execution/util/string_heap.h"
 
 namespace noisepage::execution::util {
 
@@ -123,6 +123,148 @@ class CSVFile : public CSVSource {
   std::size_t buffer_alloc_size_;
 };
 
+//===----------------------------------------------------------------------===//
+//
+// CSV Mapped File
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * CSV source for files that maps the whole file into memory instead of reading it through a
+ * buffer. The mapping is private and followed by zeroed tail padding. A new line is appended if
+ * the file doesn't end in one, so the last row is always terminated.
+ *
+ * The file can be split into row-aligned ranges with CSVMappedFile::Split(), each of which can
+ * be read by its own CSVReader through a CSVMappedChunk.
+ */
+class CSVMappedFile : public CSVSource {
+ public:
+  /**
+   * Create an instance using a file at the given path.
+   * @param path Accessible path to the CSV file.
+   */
+  explicit CSVMappedFile(std::string_view path);
+
+  /**
+   * Unmap the file.
+   */
+  ~CSVMappedFile() override;
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(CSVMappedFile);
+
+  /**
+   * Map the file into memory.
+   * @return True if the file is mapped and ready to be read; false otherwise.
+   */
+  bool Initialize() override;
+
+  /**
+   * @return The start of the unread data.
+   */
+  const char *GetBuffer() override { return data_ + read_pos_; }
+
+  /**
+   * @return The number of unread bytes.
+   */
+  std::size_t GetSize() override { return size_ - read_pos_; }
+
+  /**
+   * Called by the consumer to indicate consumption of some buffer bytes.
+   * @param n The number of bytes that've been consumed.
+   */
+  void Consume(std::size_t n) override;
+
+  /**
+   * @return False always. The whole file is visible from the start.
+   */
+  bool Fill() override { return false; }
+
+  /**
+   * @return The start of the mapped file.
+   */
+  const char *GetData() const noexcept { return data_; }
+
+  /**
+   * @return The size of the file in bytes, including the appended new line, if any.
+   */
+  std::size_t GetDataSize() const noexcept { return size_; }
+
+  /**
+   * Split the file into at most @em num_chunks ranges of roughly equal size, each ending at the end
+   * of a row. Rows are found with CSVReader::SkipRow(), so reading the ranges one after the other
+   * yields exactly the rows of a reader over the whole file. The ranges are tokenized in parallel,
+   * guessing whether each range starts inside a quoted value, and the guesses are then resolved
+   * from the start of the file.
+   * @param num_chunks The maximum number of ranges.
+   * @param delimiter The character that separates columns within a row.
+   * @param quote The quoting character.
+   * @param escape The character appearing before the quote character in quoted values.
+   * @return The offsets of the range boundaries: the first is zero, the last is the size of the
+   *         data, and range i is [offsets[i], offsets[i+1]).
+   */
+  std::vector<std::size_t> Split(std::size_t num_chunks, char delimiter, char quote, char escape) const;
+
+ private:
+  // Skip the rows from the row starting at row_start, and return the end of the first row ending at or after target
+  std::size_t SkipRowsTo(std::size_t row_start, std::size_t target, char delimiter, char quote, char escape) const;
+
+  // The path of the file
+  std::string path_;
+  // The mapping, of mapping_size_ bytes, of which the first size_ bytes hold the file
+  char *data_{nullptr};
+  std::size_t size_{0};
+  std::size_t mapping_size_{0};
+  // The current read position
+  std::size_t read_pos_{0};
+};
+
+/**
+ * A CSV source over a range of a CSVMappedFile. The range must end at the end of a row, and the
+ * file must outlive the chunk.
+ */
+class CSVMappedChunk : public CSVSource {
+ public:
+  /**
+   * Create a source over the range [begin, end) of a mapped file.
+   * @param begin The start of the range.
+   * @param end The end of the range.
+   */
+  CSVMappedChunk(const char *begin, const char *end) : p_(begin), pend_(end) {}
+
+  /**
+   * @return True always.
+   */
+  bool Initialize() override { return true; }
+
+  /**
+   * @return The start of the unread data.
+   */
+  const char *GetBuffer() override { return p_; }
+
+  /**
+   * @return The number of unread bytes.
+   */
+  std::size_t GetSize() override { return pend_ - p_; }
+
+  /**
+   * Bump the pointer into the range by the size of the consumption.
+   * @param n The number of bytes to bump.
+   */
+  void Consume(const std::size_t n) override { p_ += n; }
+
+  /**
+   * @return False always. The whole range is visible from the start.
+   */
+  bool Fill() override { return false; }
+
+ private:
+  const char *p_;
+  const char *pend_;
+};
+
 //===----------------------------------------------------------------------===//
 //
 // CSV String
@@ -182,6 +324,63 @@ class CSVString : public CSVSource {
   const char *pend_;
 };
 
+//===----------------------------------------------------------------------===//
+//
+// CSV Stream
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * CSV source for data that is pushed to the reader in chunks, e.g., CopyData messages arriving over the network. A
+ * chunk can end in the middle of a row. The reader stops at the incomplete row, which stays in the buffer and is
+ * parsed again once the rest of it is appended.
+ */
+class CSVStream : public CSVSource {
+ public:
+  /**
+   * @return True always.
+   */
+  bool Initialize() override { return true; }
+
+  /**
+   * @return The start of the unconsumed data.
+   */
+  const char *GetBuffer() override { return &buffer_[read_pos_]; }
+
+  /**
+   * @return The number of unconsumed bytes.
+   */
+  std::size_t GetSize() override { return end_pos_ - read_pos_; }
+
+  /**
+   * Called by the consumer to indicate consumption of some buffer bytes.
+   * @param n The number of bytes that've been consumed.
+   */
+  void Consume(std::size_t n) override;
+
+  /**
+   * @return False always. Data only arrives through CSVStream::Append().
+   */
+  bool Fill() override { return false; }
+
+  /**
+   * Append a chunk of CSV data after the unconsumed data.
+   * @param data The start of the chunk.
+   * @param len The length of the chunk in bytes.
+   */
+  void Append(const char *data, std::size_t len);
+
+  /**
+   * Terminate the last row if the stream does not end in a new line, so that it can be parsed.
+   */
+  void Finish();
+
+ private:
+  std::vector<char> buffer_ = std::vector<char>(NUM_EXTRA_PADDING_CHARS, 0);
+  std::size_t read_pos_ = 0;
+  std::size_t end_pos_ = 0;
+};
+
 //===----------------------------------------------------------------------===//
 //
 // CSV Reader
@@ -217,6 +416,8 @@ class CSVReader {
     std::size_t len_;
     /** True if this cell contains escaped data. */
     bool escaped_;
+    /** True if this cell was enclosed in quote characters. An empty quoted cell holds the empty string. */
+    bool quoted_;
     /** The escaping character. */
     char escape_char_;
 
@@ -225,14 +426,24 @@ class CSVReader {
      */
     bool IsEmpty() const noexcept { return len_ == 0; }
 
+    /**
+     * @return True if the cell is empty and unquoted, which CSV uses for NULL; false otherwise.
+     */
+    bool IsNull() const noexcept { return len_ == 0 && !quoted_; }
+
     /**
      * @return This cell's value converted into a 64-bit signed integer.
      */
     int64_t AsInteger() const {
       NOISEPAGE_ASSERT(!escaped_, "Integer data cannot contain be escaped");
-      int64_t n = 0;
-      std::from_chars(ptr_, ptr_ + len_, n);
-      return n;
+      // Hand-rolled because <charconv> is missing on Ubuntu 18.04. Like std::from_chars, parsing stops at the first
+      // character that is not a digit.
+      const char *p = ptr_, *end = ptr_ + len_;
+      const bool negative = p != end && *p == '-';
+      if (p != end && (*p == '-' || *p == '+')) p++;
+      uint64_t n = 0;
+      for (; p != end && *p >= '0' && *p <= '9'; p++) n = n * 10 + static_cast<uint64_t>(*p - '0');
+      return static_cast<int64_t>(negative ? 0 - n : n);
     }
 
     /**
@@ -297,11 +508,18 @@ class CSVReader {
   bool Initialize();
 
   /**
-   * Advance to the next row.
+   * Advance to the next row. Rows end at a new line, a carriage return, or both, outside of quoted
+   * values.
    * @return True if there is another row; false otherwise.
    */
   bool Advance();
 
+  /**
+   * Move past the next row by the same rules as Advance(), without recording its cells.
+   * @return True if a row was skipped; false if there is no complete row left.
+   */
+  bool SkipRow();
+
   /**
    * @return The current parsed row.
    */
@@ -316,6 +534,15 @@ class CSVReader {
     return &row_.cells_[idx];
   }
 
+  /**
+   * Return the string value of the cell at the given index in the current row. Unescaped values are
+   * returned in place, escaped values are unescaped into memory owned by the reader. The view stays
+   * valid as long as both the reader and its source live, so it can outlive the current row.
+   * @warning No bounds-checking is done on the provided index.
+   * @return The string value of the cell.
+   */
+  std::string_view GetRowCellString(uint32_t idx);
+
   /**
    * @return Return statistics collected during parsing.
    */
@@ -331,7 +558,12 @@ class CSVReader {
   // The result of an attempted parse
   enum class ParseResult { Ok, NeedMoreData, NeedMoreCells };
 
+  // Read the next row from the source, recording its cells only if requested
+  template <bool RecordCells>
+  bool ParseRow();
+
   // Read the next line from the CSV file
+  template <bool RecordCells>
   ParseResult TryParse();
 
  private:
@@ -355,7 +587,9 @@ class CSVReader {
 
   // Structure capturing various statistics.
   Stats stats_;
+
+  // Storage for unescaped cell values.
+  StringHeap strings_;
 };
 
 }  // namespace noisepage::execution::util
-#endif
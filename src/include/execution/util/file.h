@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <string>
+#include <string_view>
 
 #include "common/macros.h"
 
@@ -96,8 +97,10 @@ class File {
 
   /**
    * Create a temporary file.
+   * @param delete_on_close Should the file be deleted once closed?
+   * @param directory The directory to create the file in.
    */
-  void CreateTemp(bool delete_on_close);
+  void CreateTemp(bool delete_on_close, std::string_view directory = "/tmp");
 
   /**
    * Make a best-effort attempt to read @em len bytes of data from the current file position into
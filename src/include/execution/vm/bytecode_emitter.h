@@ -348,15 +348,31 @@ class BytecodeEmitter {
   /** Emit code to move thread-local data into main agg table. */
   void EmitAggHashTableMovePartitions(LocalVar agg_ht, LocalVar tls, LocalVar aht_offset, FunctionId merge_part_fn);
 
+  /** Emit code to let an agg table built serially spill to disk. */
+  void EmitAggHashTableEnableSpilling(LocalVar agg_ht, LocalVar query_state, FunctionId merge_part_fn);
+
   /** Emit code to scan an agg table in parallel. */
   void EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, LocalVar context, LocalVar tls,
                                                FunctionId scan_part_fn);
 
+  /** Emit code to filter a batch of tuples through a join hash table's bloom filter. */
+  void EmitJoinHashTableProbeBloomFilter(LocalVar join_hash_table, LocalVar vector_projection, LocalVar tid_list,
+                                         LocalVar key_cols, uint32_t num_key_cols);
+
+  /** Emit code to join the deferred probes of a join hash table with its spilled partitions. */
+  void EmitJoinHashTableProbeSpilledPartitions(LocalVar join_hash_table, LocalVar query_state, LocalVar pipeline_state,
+                                               FunctionId probe_fn);
+
   /** Initialize a sorter instance. */
   void EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar exec_ctx, FunctionId cmp_fn, LocalVar tuple_size);
 
   /** Initialize a CSV reader. */
-  // void EmitCSVReaderInit(LocalVar creader, LocalVar file_name, uint32_t file_name_len);
+  void EmitCSVReaderInit(LocalVar reader, LocalVar exec_ctx, LocalVar file_name, uint32_t file_name_len,
+                         int8_t delimiter, int8_t quote, int8_t escape);
+
+  /** Emit a parallel CSV scan. */
+  void EmitParallelCSVScan(LocalVar file_name, uint32_t file_name_len, int8_t delimiter, int8_t quote, int8_t escape,
+                           LocalVar query_state, LocalVar exec_ctx, LocalVar num_threads_override, FunctionId scan_fn);
 
   /** ONLY FOR TESTING! */
   void EmitTestCatalogLookup(LocalVar oid_var, LocalVar exec_ctx, LocalVar table_name, uint32_t table_name_len,
@@ -97,8 +97,11 @@ class BytecodeGenerator final : public ast::AstVisitor<BytecodeGenerator> {
   void VisitBuiltinJoinHashTableIteratorCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinRowBufferCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinRowBufferIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitResultBufferCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinCSVScanParallelCall(ast::CallExpr *call);
   void VisitExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinThreadStateContainerCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSizeOfCall(ast::CallExpr *call);
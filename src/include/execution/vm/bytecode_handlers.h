@@ -20,8 +20,10 @@
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/join_hash_table.h"
 #include "execution/sql/operators/hash_operators.h"
+#include "execution/sql/row_buffer.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/sql_def.h"
+#include "execution/sql/csv_scanner.h"
 #include "execution/sql/storage_interface.h"
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql/thread_state_container.h"
@@ -29,8 +31,6 @@
 #include "metrics/metrics_manager.h"
 #include "parser/expression/constant_value_expression.h"
 
-// #include "execution/util/csv_reader.h" Fix later.
-
 // All VM bytecode op handlers must use this macro
 #define VM_OP EXPORT
 
@@ -320,6 +320,9 @@ VM_OP_HOT void OpTableVectorIteratorGetVPI(noisepage::execution::sql::VectorProj
   *vpi = iter->GetVectorProjectionIterator();
 }
 
+VM_OP void OpTableVectorIteratorSkipBlocks(noisepage::execution::sql::TableVectorIterator *iter,
+                                           const noisepage::execution::sql::FilterManager *filter_manager);
+
 VM_OP_HOT void OpParallelScanTable(uint32_t table_oid, uint32_t *col_oids, uint32_t num_oids, void *const query_state,
                                    noisepage::execution::exec::ExecutionContext *exec_ctx,
                                    uint32_t num_threads_override,
@@ -555,11 +558,18 @@ VM_OP_HOT void OpHashCombine(noisepage::hash_t *hash_val, noisepage::hash_t new_
 VM_OP void OpFilterManagerInit(noisepage::execution::sql::FilterManager *filter_manager,
                                const noisepage::execution::exec::ExecutionSettings &exec_settings);
 
+VM_OP void OpFilterManagerInitWithContext(noisepage::execution::sql::FilterManager *filter_manager,
+                                          const noisepage::execution::exec::ExecutionSettings &exec_settings,
+                                          void *context);
+
 VM_OP void OpFilterManagerStartNewClause(noisepage::execution::sql::FilterManager *filter_manager);
 
 VM_OP void OpFilterManagerInsertFilter(noisepage::execution::sql::FilterManager *filter_manager,
                                        noisepage::execution::sql::FilterManager::MatchFn clause);
 
+VM_OP void OpFilterManagerInsertZoneMapTerm(noisepage::execution::sql::FilterManager *filter_manager, uint32_t col_idx,
+                                            uint32_t comparison, int64_t value);
+
 VM_OP void OpFilterManagerRunFilters(noisepage::execution::sql::FilterManager *filter,
                                      noisepage::execution::sql::VectorProjectionIterator *vpi,
                                      noisepage::execution::exec::ExecutionContext *exec_ctx);
@@ -903,6 +913,12 @@ VM_OP_HOT void OpAggregationHashTableTransferPartitions(
   agg_hash_table->TransferMemoryAndPartitions(thread_state_container, agg_ht_offset, merge_partition_fn);
 }
 
+VM_OP_WARM void OpAggregationHashTableEnableSpilling(
+    noisepage::execution::sql::AggregationHashTable *const agg_hash_table, void *const query_state,
+    const noisepage::execution::sql::AggregationHashTable::MergePartitionFn merge_partition_fn) {
+  agg_hash_table->EnableSpilling(query_state, merge_partition_fn);
+}
+
 VM_OP void OpAggregationHashTableBuildAllHashTablePartitions(
     noisepage::execution::sql::AggregationHashTable *agg_hash_table, void *query_state);
 
@@ -1371,12 +1387,41 @@ VM_OP void OpJoinHashTableBuildParallel(noisepage::execution::sql::JoinHashTable
                                         noisepage::execution::sql::ThreadStateContainer *thread_state_container,
                                         uint32_t jht_offset);
 
+VM_OP void OpJoinHashTableBuildBloomFilter(noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP_HOT void OpJoinHashTableProbeBloomFilter(const noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                               const noisepage::execution::sql::VectorProjection *vector_projection,
+                                               noisepage::execution::sql::TupleIdList *tid_list,
+                                               const uint32_t *key_cols, uint32_t num_key_cols) {
+  join_hash_table->ProbeBloomFilter(*vector_projection, tid_list, key_cols, num_key_cols);
+}
+
 VM_OP_HOT void OpJoinHashTableLookup(noisepage::execution::sql::JoinHashTable *join_hash_table,
                                      noisepage::execution::sql::HashTableEntryIterator *ht_entry_iter,
                                      const noisepage::hash_t hash_val) {
   *ht_entry_iter = join_hash_table->Lookup<false>(hash_val);
 }
 
+VM_OP_WARM void OpJoinHashTableEnableSpilling(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                              const uint32_t probe_tuple_size) {
+  join_hash_table->EnableSpilling(probe_tuple_size);
+}
+
+VM_OP_HOT void OpJoinHashTableIsPartitionSpilled(bool *result,
+                                                 const noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                                 const noisepage::hash_t hash_val) {
+  *result = join_hash_table->IsPartitionSpilled(hash_val);
+}
+
+VM_OP_WARM void OpJoinHashTableDeferProbe(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                          const noisepage::hash_t hash_val, const noisepage::byte *probe_tuple) {
+  join_hash_table->DeferProbe(hash_val, probe_tuple);
+}
+
+VM_OP void OpJoinHashTableProbeSpilledPartitions(
+    noisepage::execution::sql::JoinHashTable *join_hash_table, void *query_state, void *pipeline_state,
+    noisepage::execution::sql::JoinHashTable::ProbeSpilledFn probe_fn);
+
 VM_OP void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_table);
 
 VM_OP_HOT void OpHashTableEntryIteratorHasNext(bool *has_next,
@@ -1413,6 +1458,9 @@ VM_OP void OpSorterInit(noisepage::execution::sql::Sorter *sorter,
                         noisepage::execution::exec::ExecutionContext *exec_ctx,
                         noisepage::execution::sql::Sorter::ComparisonFunction cmp_fn, uint32_t tuple_size);
 
+VM_OP void OpSorterInitForIndex(noisepage::execution::sql::Sorter *sorter,
+                                noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t index_oid);
+
 VM_OP_HOT void OpSorterGetTupleCount(uint32_t *result, noisepage::execution::sql::Sorter *sorter) {
   *result = sorter->GetTupleCount();
 }
@@ -1461,6 +1509,41 @@ VM_OP_WARM void OpSorterIteratorSkipRows(noisepage::execution::sql::SorterIterat
 
 VM_OP void OpSorterIteratorFree(noisepage::execution::sql::SorterIterator *iter);
 
+// ---------------------------------------------------------
+// Row Buffers
+// ---------------------------------------------------------
+
+VM_OP void OpRowBufferInit(noisepage::execution::sql::RowBuffer *buffer,
+                           noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t row_size);
+
+VM_OP_HOT void OpRowBufferAllocRow(noisepage::byte **result, noisepage::execution::sql::RowBuffer *buffer) {
+  *result = buffer->AllocInputRow();
+}
+
+VM_OP_WARM void OpRowBufferFinish(noisepage::execution::sql::RowBuffer *buffer) { buffer->Finish(); }
+
+VM_OP void OpRowBufferFree(noisepage::execution::sql::RowBuffer *buffer);
+
+VM_OP void OpRowBufferIteratorInit(noisepage::execution::sql::RowBufferIterator *iter,
+                                   noisepage::execution::sql::RowBuffer *buffer);
+
+VM_OP_HOT void OpRowBufferIteratorHasNext(bool *has_more, noisepage::execution::sql::RowBufferIterator *iter) {
+  *has_more = iter->HasNext();
+}
+
+VM_OP_HOT void OpRowBufferIteratorNext(noisepage::execution::sql::RowBufferIterator *iter) { iter->Next(); }
+
+VM_OP_HOT void OpRowBufferIteratorGetRow(const noisepage::byte **row,
+                                         noisepage::execution::sql::RowBufferIterator *iter) {
+  *row = iter->GetRow();
+}
+
+VM_OP_HOT void OpRowBufferIteratorMark(noisepage::execution::sql::RowBufferIterator *iter) { iter->Mark(); }
+
+VM_OP_HOT void OpRowBufferIteratorRewind(noisepage::execution::sql::RowBufferIterator *iter) { iter->Rewind(); }
+
+VM_OP void OpRowBufferIteratorFree(noisepage::execution::sql::RowBufferIterator *iter);
+
 // ---------------------------------------------------------
 // Output
 // ---------------------------------------------------------
@@ -1486,10 +1569,9 @@ VM_OP_WARM void OpResultBufferFree(noisepage::execution::exec::OutputBuffer *out
 // CSV Reader
 // ---------------------------------------------------------
 
-#if 0
-VM_OP void OpCSVReaderInit(noisepage::execution::util::CSVReader *reader, const uint8_t *file_name, uint32_t len);
-
-VM_OP void OpCSVReaderPerformInit(bool *result, noisepage::execution::util::CSVReader *reader);
+VM_OP void OpCSVReaderInit(noisepage::execution::util::CSVReader **result,
+                           noisepage::execution::exec::ExecutionContext *exec_ctx, const uint8_t *file_name,
+                           uint32_t len, int8_t delimiter, int8_t quote, int8_t escape);
 
 VM_OP_WARM void OpCSVReaderAdvance(bool *has_more, noisepage::execution::util::CSVReader *reader) {
   *has_more = reader->Advance();
@@ -1497,17 +1579,18 @@ VM_OP_WARM void OpCSVReaderAdvance(bool *has_more, noisepage::execution::util::C
 
 VM_OP_WARM void OpCSVReaderGetField(noisepage::execution::util::CSVReader *reader, const uint32_t field_index,
                                     noisepage::execution::sql::StringVal *result) {
-  // TODO(pmenon): There's an extra copy here. Revisit if it's a performance issue.
-  const std::string field_string = reader->GetRowCell(field_index)->AsString();
-  *result = noisepage::execution::sql::StringVal(noisepage::storage::VarlenEntry::Create(field_string));
+  // The string lives in the mapped file or in the reader, both of which are kept until the end of the query
+  const std::string_view field = reader->GetRowCellString(field_index);
+  *result = noisepage::execution::sql::StringVal(noisepage::storage::VarlenEntry::Create(field));
 }
 
 VM_OP_WARM void OpCSVReaderGetRecordNumber(uint32_t *result, noisepage::execution::util::CSVReader *reader) {
   *result = reader->GetRecordNumber();
 }
 
-VM_OP void OpCSVReaderClose(noisepage::execution::util::CSVReader *reader);
-#endif
+VM_OP void OpParallelScanCSV(const uint8_t *file_name, uint32_t len, int8_t delimiter, int8_t quote, int8_t escape,
+                             void *const query_state, noisepage::execution::exec::ExecutionContext *exec_ctx,
+                             uint32_t num_threads_override, noisepage::execution::sql::CSVScanner::ScanFn scanner);
 
 // ---------------------------------------------------------
 // Trig functions
@@ -1914,8 +1997,18 @@ VM_OP void OpIndexIteratorGetSize(uint32_t *index_size, noisepage::execution::sq
 
 VM_OP void OpIndexIteratorPerformInit(noisepage::execution::sql::IndexIterator *iter);
 
+VM_OP_WARM void OpIndexIteratorEnableIndexOnly(noisepage::execution::sql::IndexIterator *iter) {
+  iter->EnableIndexOnly();
+}
+
 VM_OP_WARM void OpIndexIteratorScanKey(noisepage::execution::sql::IndexIterator *iter) { iter->ScanKey(); }
 
+VM_OP_HOT void OpIndexIteratorAddBatchKey(noisepage::execution::sql::IndexIterator *iter) { iter->AddBatchKey(); }
+
+VM_OP_WARM void OpIndexIteratorScanKeyBatch(noisepage::execution::sql::IndexIterator *iter) { iter->ScanKeyBatch(); }
+
+VM_OP_HOT void OpIndexIteratorNextBatchKey(noisepage::execution::sql::IndexIterator *iter) { iter->NextBatchKey(); }
+
 VM_OP_WARM void OpIndexIteratorScanAscending(noisepage::execution::sql::IndexIterator *iter,
                                              noisepage::storage::index::ScanType scan_type, uint32_t limit) {
   iter->ScanAscending(scan_type, limit);
@@ -1953,6 +2046,11 @@ VM_OP_WARM void OpIndexIteratorGetTablePR(noisepage::storage::ProjectedRow **pr,
   *pr = iter->TablePR();
 }
 
+VM_OP_HOT void OpIndexIteratorGetIndexOnlyPR(noisepage::storage::ProjectedRow **pr,
+                                             noisepage::execution::sql::IndexIterator *iter) {
+  *pr = iter->IndexOnlyPR();
+}
+
 VM_OP_WARM void OpIndexIteratorGetSlot(noisepage::storage::TupleSlot *slot,
                                        noisepage::execution::sql::IndexIterator *iter) {
   *slot = iter->CurrentSlot();
@@ -2147,6 +2245,13 @@ VM_OP void OpStorageInterfaceIndexInsertWithSlot(bool *result,
                                                  noisepage::execution::sql::StorageInterface *storage_interface,
                                                  noisepage::storage::TupleSlot *tuple_slot, bool unique);
 
+VM_OP void OpStorageInterfaceIndexBulkLoadInsert(noisepage::execution::sql::StorageInterface *storage_interface,
+                                                 noisepage::execution::sql::Sorter *sorter,
+                                                 noisepage::storage::TupleSlot *tuple_slot);
+
+VM_OP void OpStorageInterfaceIndexBulkLoad(bool *result, noisepage::execution::sql::StorageInterface *storage_interface,
+                                           noisepage::execution::sql::Sorter *sorter);
+
 VM_OP void OpStorageInterfaceIndexDelete(noisepage::execution::sql::StorageInterface *storage_interface,
                                          noisepage::storage::TupleSlot *tuple_slot);
 
@@ -135,6 +135,7 @@ namespace noisepage::execution::vm {
   F(TableVectorIteratorFree, OperandType::Local)                                                                      \
   F(TableVectorIteratorGetVPINumTuples, OperandType::Local, OperandType::Local)                                       \
   F(TableVectorIteratorGetVPI, OperandType::Local, OperandType::Local)                                                \
+  F(TableVectorIteratorSkipBlocks, OperandType::Local, OperandType::Local)                                            \
   F(ParallelScanTable, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local,                \
     OperandType::Local, OperandType::Local, OperandType::FunctionId)                                                  \
                                                                                                                       \
@@ -221,8 +222,10 @@ namespace noisepage::execution::vm {
   F(VPISetStringNull, OperandType::Local, OperandType::Local, OperandType::UImm4)                                     \
   /* Filter Manager */                                                                                                \
   F(FilterManagerInit, OperandType::Local, OperandType::Local)                                                        \
+  F(FilterManagerInitWithContext, OperandType::Local, OperandType::Local, OperandType::Local)                         \
   F(FilterManagerStartNewClause, OperandType::Local)                                                                  \
   F(FilterManagerInsertFilter, OperandType::Local, OperandType::FunctionId)                                           \
+  F(FilterManagerInsertZoneMapTerm, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)    \
   F(FilterManagerRunFilters, OperandType::Local, OperandType::Local, OperandType::Local)                              \
   F(FilterManagerFree, OperandType::Local)                                                                            \
                                                                                                                       \
@@ -366,6 +369,7 @@ namespace noisepage::execution::vm {
     OperandType::FunctionId, OperandType::FunctionId, OperandType::Local)                                             \
   F(AggregationHashTableTransferPartitions, OperandType::Local, OperandType::Local, OperandType::Local,               \
     OperandType::FunctionId)                                                                                          \
+  F(AggregationHashTableEnableSpilling, OperandType::Local, OperandType::Local, OperandType::FunctionId)              \
   F(AggregationHashTableBuildAllHashTablePartitions, OperandType::Local, OperandType::Local)                          \
   F(AggregationHashTableRepartition, OperandType::Local)                                                              \
   F(AggregationHashTableMergePartitions, OperandType::Local, OperandType::Local, OperandType::Local,                  \
@@ -560,7 +564,15 @@ namespace noisepage::execution::vm {
   F(JoinHashTableGetTupleCount, OperandType::Local, OperandType::Local)                                               \
   F(JoinHashTableBuild, OperandType::Local)                                                                           \
   F(JoinHashTableBuildParallel, OperandType::Local, OperandType::Local, OperandType::Local)                           \
+  F(JoinHashTableBuildBloomFilter, OperandType::Local)                                                                \
+  F(JoinHashTableProbeBloomFilter, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,    \
+    OperandType::UImm4)                                                                                               \
   F(JoinHashTableLookup, OperandType::Local, OperandType::Local, OperandType::Local)                                  \
+  F(JoinHashTableEnableSpilling, OperandType::Local, OperandType::Local)                                              \
+  F(JoinHashTableIsPartitionSpilled, OperandType::Local, OperandType::Local, OperandType::Local)                      \
+  F(JoinHashTableDeferProbe, OperandType::Local, OperandType::Local, OperandType::Local)                              \
+  F(JoinHashTableProbeSpilledPartitions, OperandType::Local, OperandType::Local, OperandType::Local,                  \
+    OperandType::FunctionId)                                                                                          \
   F(JoinHashTableFree, OperandType::Local)                                                                            \
   F(HashTableEntryIteratorHasNext, OperandType::Local, OperandType::Local)                                            \
   F(HashTableEntryIteratorGetRow, OperandType::Local, OperandType::Local)                                             \
@@ -572,6 +584,7 @@ namespace noisepage::execution::vm {
                                                                                                                       \
   /* Sorting */                                                                                                       \
   F(SorterInit, OperandType::Local, OperandType::Local, OperandType::FunctionId, OperandType::Local)                  \
+  F(SorterInitForIndex, OperandType::Local, OperandType::Local, OperandType::Local)                                   \
   F(SorterGetTupleCount, OperandType::Local, OperandType::Local)                                                      \
   F(SorterAllocTuple, OperandType::Local, OperandType::Local)                                                         \
   F(SorterAllocTupleTopK, OperandType::Local, OperandType::Local, OperandType::Local)                                 \
@@ -587,6 +600,19 @@ namespace noisepage::execution::vm {
   F(SorterIteratorSkipRows, OperandType::Local, OperandType::Local)                                                   \
   F(SorterIteratorFree, OperandType::Local)                                                                           \
                                                                                                                       \
+  /* Row Buffers */                                                                                                   \
+  F(RowBufferInit, OperandType::Local, OperandType::Local, OperandType::Local)                                        \
+  F(RowBufferAllocRow, OperandType::Local, OperandType::Local)                                                        \
+  F(RowBufferFinish, OperandType::Local)                                                                              \
+  F(RowBufferFree, OperandType::Local)                                                                                \
+  F(RowBufferIteratorInit, OperandType::Local, OperandType::Local)                                                    \
+  F(RowBufferIteratorHasNext, OperandType::Local, OperandType::Local)                                                 \
+  F(RowBufferIteratorNext, OperandType::Local)                                                                        \
+  F(RowBufferIteratorGetRow, OperandType::Local, OperandType::Local)                                                  \
+  F(RowBufferIteratorMark, OperandType::Local)                                                                        \
+  F(RowBufferIteratorRewind, OperandType::Local)                                                                      \
+  F(RowBufferIteratorFree, OperandType::Local)                                                                        \
+                                                                                                                      \
   /* Output */                                                                                                        \
   F(ResultBufferNew, OperandType::Local, OperandType::Local)                                                          \
   F(ResultBufferAllocOutputRow, OperandType::Local, OperandType::Local)                                               \
@@ -598,7 +624,11 @@ namespace noisepage::execution::vm {
     OperandType::Local, OperandType::Local, OperandType::UImm4)                                                       \
   F(IndexIteratorGetSize, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorPerformInit, OperandType::Local)                                                                     \
+  F(IndexIteratorEnableIndexOnly, OperandType::Local)                                                                 \
   F(IndexIteratorScanKey, OperandType::Local)                                                                         \
+  F(IndexIteratorAddBatchKey, OperandType::Local)                                                                     \
+  F(IndexIteratorScanKeyBatch, OperandType::Local)                                                                    \
+  F(IndexIteratorNextBatchKey, OperandType::Local)                                                                    \
   F(IndexIteratorScanAscending, OperandType::Local, OperandType::Local, OperandType::Local)                           \
   F(IndexIteratorScanDescending, OperandType::Local)                                                                  \
   F(IndexIteratorScanLimitDescending, OperandType::Local, OperandType::Local)                                         \
@@ -608,17 +638,17 @@ namespace noisepage::execution::vm {
   F(IndexIteratorGetLoPR, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorGetHiPR, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorGetTablePR, OperandType::Local, OperandType::Local)                                                  \
+  F(IndexIteratorGetIndexOnlyPR, OperandType::Local, OperandType::Local)                                              \
   F(IndexIteratorGetSlot, OperandType::Local, OperandType::Local)                                                     \
                                                                                                                       \
   /* CSV Reader */                                                                                                    \
-  /*                                                                                                                  \
-  F(CSVReaderInit, OperandType::Local, OperandType::StaticLocal, OperandType::UImm4)                                  \
-  F(CSVReaderPerformInit, OperandType::Local, OperandType::Local)                                                     \
+  F(CSVReaderInit, OperandType::Local, OperandType::Local, OperandType::StaticLocal, OperandType::UImm4,              \
+    OperandType::Imm1, OperandType::Imm1, OperandType::Imm1)                                                          \
   F(CSVReaderAdvance, OperandType::Local, OperandType::Local)                                                         \
   F(CSVReaderGetField, OperandType::Local, OperandType::Local, OperandType::Local)                                    \
   F(CSVReaderGetRecordNumber, OperandType::Local, OperandType::Local)                                                 \
-  F(CSVReaderClose, OperandType::Local)                                                                               \
-  */                                                                                                                  \
+  F(ParallelScanCSV, OperandType::StaticLocal, OperandType::UImm4, OperandType::Imm1, OperandType::Imm1,              \
+    OperandType::Imm1, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId)           \
                                                                                                                       \
   /* ProjectedRow */                                                                                                  \
   F(PRGetBool, OperandType::Local, OperandType::Local, OperandType::UImm2)                                            \
@@ -676,6 +706,8 @@ namespace noisepage::execution::vm {
   F(StorageInterfaceIndexInsertUnique, OperandType::Local, OperandType::Local)                                        \
   F(StorageInterfaceIndexInsertWithSlot, OperandType::Local, OperandType::Local, OperandType::Local,                  \
     OperandType::Local)                                                                                               \
+  F(StorageInterfaceIndexBulkLoadInsert, OperandType::Local, OperandType::Local, OperandType::Local)                  \
+  F(StorageInterfaceIndexBulkLoad, OperandType::Local, OperandType::Local, OperandType::Local)                        \
   F(StorageInterfaceIndexDelete, OperandType::Local, OperandType::Local)                                              \
   F(StorageInterfaceFree, OperandType::Local)                                                                         \
                                                                                                                       \
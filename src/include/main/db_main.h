@@ -16,6 +16,7 @@
 #include "network/noisepage_server.h"
 #include "network/postgres/postgres_command_factory.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
+#include "optimizer/cost_model/cost_model_util.h"
 #include "optimizer/statistics/stats_storage.h"
 #include "replication/primary_replication_manager.h"
 #include "replication/replica_replication_manager.h"
@@ -25,6 +26,7 @@
 #include "settings/settings_manager.h"
 #include "settings/settings_param.h"
 #include "storage/garbage_collector_thread.h"
+#include "storage/recovery/checkpoint_manager.h"
 #include "storage/recovery/recovery_manager.h"
 #include "task/task_manager.h"
 #include "traffic_cop/traffic_cop.h"
@@ -151,20 +153,21 @@ class DBMain {
      * @param block_store_size_limit argument to the BlockStore
      * @param block_store_reuse_limit argument to the BlockStore
      * @param use_gc enable GarbageCollector
+     * @param gc_num_workers argument to the GarbageCollector
      * @param log_manager needed for safe destruction of StorageLayer
      * @param empty_buffer_queue The common buffer queue that all empty buffers are pulled from and returned to.
      */
     StorageLayer(const common::ManagedPointer<TransactionLayer> txn_layer, const uint64_t block_store_size_limit,
-                 const uint64_t block_store_reuse_limit, const bool use_gc,
+                 const uint64_t block_store_reuse_limit, const bool use_gc, const uint32_t gc_num_workers,
                  const common::ManagedPointer<storage::LogManager> log_manager,
                  std::unique_ptr<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue)
         : empty_buffer_queue_(std::move(empty_buffer_queue)),
           deferred_action_manager_(txn_layer->GetDeferredActionManager()),
           log_manager_(log_manager) {
       if (use_gc)
-        garbage_collector_ = std::make_unique<storage::GarbageCollector>(txn_layer->GetTimestampManager(),
-                                                                         txn_layer->GetDeferredActionManager(),
-                                                                         txn_layer->GetTransactionManager(), DISABLED);
+        garbage_collector_ = std::make_unique<storage::GarbageCollector>(
+            txn_layer->GetTimestampManager(), txn_layer->GetDeferredActionManager(),
+            txn_layer->GetTransactionManager(), DISABLED, gc_num_workers);
 
       block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit);
     }
@@ -427,11 +430,14 @@ class DBMain {
                                    ? common::ManagedPointer(replication_manager)
                                          .CastManagedPointerTo<replication::PrimaryReplicationManager>()
                                    : nullptr;
+        // Replication ships the logs of a single partition, so the WAL is not partitioned when replicating
+        const uint32_t wal_num_partitions = use_replication_ ? 1 : wal_num_partitions_;
         log_manager = std::make_unique<storage::LogManager>(
             wal_file_path_, wal_num_buffers_, std::chrono::microseconds{wal_serialization_interval_},
             std::chrono::microseconds{wal_persist_interval_}, wal_persist_threshold_,
             common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(empty_buffer_queue), rep_manager_ptr,
-            common::ManagedPointer(thread_registry));
+            common::ManagedPointer(thread_registry), wal_group_commit_target_iops_, wal_num_partitions,
+            wal_compression_);
         log_manager->Start();
       }
 
@@ -441,7 +447,8 @@ class DBMain {
 
       auto storage_layer =
           std::make_unique<StorageLayer>(common::ManagedPointer(txn_layer), block_store_size_, block_store_reuse_,
-                                         use_gc_, common::ManagedPointer(log_manager), std::move(empty_buffer_queue));
+                                         use_gc_, gc_num_workers_, common::ManagedPointer(log_manager),
+                                         std::move(empty_buffer_queue));
 
       std::unique_ptr<CatalogLayer> catalog_layer = DISABLED;
       if (use_catalog_) {
@@ -476,6 +483,15 @@ class DBMain {
                                                                   std::chrono::microseconds{metrics_interval_});
       }
 
+      std::unique_ptr<storage::CheckpointManager> checkpoint_manager = DISABLED;
+      if (use_checkpoints_) {
+        NOISEPAGE_ASSERT(use_catalog_ && catalog_layer->GetCatalog() != DISABLED,
+                         "CheckpointManager needs the CatalogLayer.");
+        checkpoint_manager = std::make_unique<storage::CheckpointManager>(
+            catalog_layer->GetCatalog(), txn_layer->GetTransactionManager(), common::ManagedPointer(log_manager));
+        checkpoint_manager->StartCheckpointThread(checkpoint_file_path_, std::chrono::seconds{checkpoint_interval_});
+      }
+
       std::unique_ptr<storage::RecoveryManager> recovery_manager = DISABLED;
       if (use_replication_) {
         auto log_provider = replication_manager->IsPrimary()
@@ -487,6 +503,7 @@ class DBMain {
             log_provider, catalog_layer->GetCatalog(), txn_layer->GetTransactionManager(),
             txn_layer->GetDeferredActionManager(), common::ManagedPointer(replication_manager),
             common::ManagedPointer(thread_registry), common::ManagedPointer(storage_layer->GetBlockStore()));
+        recovery_manager->SetReplayThreads(recovery_replay_threads_);
         recovery_manager->StartRecovery();
       }
 
@@ -514,7 +531,7 @@ class DBMain {
             txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(),
             common::ManagedPointer(replication_manager), common::ManagedPointer(recovery_manager),
             common::ManagedPointer(settings_manager), common::ManagedPointer(stats_storage), optimizer_timeout_,
-            use_query_cache_, execution_mode_);
+            cost_model_type_, join_enumeration_threshold_, optimizer_threads_, use_query_cache_, execution_mode_);
       }
 
       std::unique_ptr<NetworkLayer> network_layer = DISABLED;
@@ -584,6 +601,7 @@ class DBMain {
       db_main->txn_layer_ = std::move(txn_layer);
       db_main->storage_layer_ = std::move(storage_layer);
       db_main->catalog_layer_ = std::move(catalog_layer);
+      db_main->checkpoint_manager_ = std::move(checkpoint_manager);
       db_main->recovery_manager_ = std::move(recovery_manager);
       db_main->gc_thread_ = std::move(gc_thread);
       db_main->stats_storage_ = std::move(stats_storage);
@@ -708,6 +726,33 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalGroupCommitTargetIops(const uint32_t value) {
+      wal_group_commit_target_iops_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalNumPartitions(const uint32_t value) {
+      wal_num_partitions_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalCompression(const storage::LogCompressionType value) {
+      wal_compression_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -717,6 +762,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value GarbageCollector argument
+     * @return self reference for chaining
+     */
+    Builder &SetGCNumWorkers(const uint32_t value) {
+      gc_num_workers_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -735,6 +789,33 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value use component
+     * @return self reference for chaining
+     */
+    Builder &SetUseCheckpoints(const bool value) {
+      use_checkpoints_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value CheckpointManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointFilePath(const std::string &value) {
+      checkpoint_file_path_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value CheckpointManager argument, in seconds
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointInterval(const uint32_t value) {
+      checkpoint_interval_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -852,6 +933,33 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetOptimizerCostModel(const optimizer::CostModelType value) {
+      cost_model_type_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetOptimizerJoinEnumerationThreshold(const uint32_t value) {
+      join_enumeration_threshold_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetOptimizerThreads(const uint32_t value) {
+      optimizer_threads_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -940,6 +1048,7 @@ class DBMain {
     uint64_t forecast_sample_limit_ = 5;
 
     std::string wal_file_path_ = "wal.log";
+    std::string checkpoint_file_path_ = "checkpoint";
     std::string ou_model_save_path_;
     std::string interference_model_save_path_;
     std::string forecast_model_save_path_;
@@ -971,15 +1080,24 @@ class DBMain {
     bool execute_command_metrics_ = false;
     int32_t wal_serialization_interval_ = 100;
     int32_t wal_persist_interval_ = 100;
+    uint32_t wal_group_commit_target_iops_ = 0;
+    uint32_t wal_num_partitions_ = 1;
+    storage::LogCompressionType wal_compression_ = storage::LogCompressionType::NONE;
     int32_t gc_interval_ = 1000;
+    uint32_t gc_num_workers_ = 1;
     uint32_t task_pool_size_ = 1;
 
     uint16_t connection_thread_count_ = 4;
     uint16_t network_port_ = 15721;
     uint16_t messenger_port_ = 9022;
     uint16_t replication_port_ = 15445;
+    uint32_t recovery_replay_threads_ = 0;
+    uint32_t checkpoint_interval_ = 300;
 
     execution::vm::ExecutionMode execution_mode_ = execution::vm::ExecutionMode::Interpret;
+    optimizer::CostModelType cost_model_type_ = optimizer::CostModelType::TRIVIAL;
+    uint32_t join_enumeration_threshold_ = optimizer::DEFAULT_JOIN_ENUMERATION_THRESHOLD;
+    uint32_t optimizer_threads_ = 1;
 
     bool use_logging_ = false;
     bool wal_async_commit_enable_ = false;
@@ -987,6 +1105,7 @@ class DBMain {
     bool use_catalog_ = false;
     bool create_default_database_ = true;
     bool use_gc_thread_ = false;
+    bool use_checkpoints_ = false;
     bool use_stats_storage_ = false;
     bool use_execution_ = false;
     bool use_traffic_cop_ = false;
@@ -1025,6 +1144,17 @@ class DBMain {
         wal_persist_interval_ = settings_manager->GetInt(settings::Param::wal_persist_interval);
         wal_persist_threshold_ =
             static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_persist_threshold));
+        wal_group_commit_target_iops_ =
+            static_cast<uint32_t>(settings_manager->GetInt(settings::Param::wal_group_commit_target_iops));
+        wal_num_partitions_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::wal_num_partitions));
+        const auto wal_compression = settings_manager->GetString(settings::Param::wal_compression);
+        const auto compression_type = storage::LogCompressor::FromCompressionString(wal_compression);
+        if (!compression_type.has_value()) {
+          throw SETTINGS_EXCEPTION(
+              fmt::format("\"{}\" is not a valid value for parameter \"wal_compression\"", wal_compression),
+              common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
+        }
+        wal_compression_ = *compression_type;
       }
 
       use_metrics_ = settings_manager->GetBool(settings::Param::metrics);
@@ -1033,6 +1163,7 @@ class DBMain {
       pilot_planning_ = settings_manager->GetBool(settings::Param::pilot_planning);
 
       gc_interval_ = settings_manager->GetInt(settings::Param::gc_interval);
+      gc_num_workers_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::gc_num_workers));
       pilot_interval_ = settings_manager->GetInt64(settings::Param::pilot_interval);
       forecast_train_interval_ = settings_manager->GetInt64(settings::Param::forecast_train_interval);
       workload_forecast_interval_ = settings_manager->GetInt64(settings::Param::workload_forecast_interval);
@@ -1052,6 +1183,17 @@ class DBMain {
       connection_thread_count_ =
           static_cast<uint16_t>(settings_manager->GetInt(settings::Param::connection_thread_count));
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
+      const auto cost_model = settings_manager->GetString(settings::Param::optimizer_cost_model);
+      const auto cost_model_type = optimizer::CostModelUtil::FromCostModelString(cost_model);
+      if (!cost_model_type.has_value()) {
+        throw SETTINGS_EXCEPTION(
+            fmt::format("\"{}\" is not a valid value for parameter \"optimizer_cost_model\"", cost_model),
+            common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
+      }
+      cost_model_type_ = *cost_model_type;
+      join_enumeration_threshold_ =
+          static_cast<uint32_t>(settings_manager->GetInt(settings::Param::optimizer_join_enumeration_threshold));
+      optimizer_threads_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::optimizer_threads));
       use_query_cache_ = settings_manager->GetBool(settings::Param::use_query_cache);
 
       execution_mode_ = settings_manager->GetBool(settings::Param::compiled_query_execution)
@@ -1078,6 +1220,10 @@ class DBMain {
       async_replication_enable_ = settings_manager->GetBool(settings::Param::async_replication_enable);
       replication_port_ = settings_manager->GetInt(settings::Param::replication_port);
       replication_hosts_path_ = settings_manager->GetString(settings::Param::replication_hosts_path);
+      recovery_replay_threads_ = settings_manager->GetInt(settings::Param::recovery_replay_threads);
+      use_checkpoints_ = settings_manager->GetBool(settings::Param::checkpoint_enable);
+      checkpoint_file_path_ = settings_manager->GetString(settings::Param::checkpoint_file_path);
+      checkpoint_interval_ = settings_manager->GetInt(settings::Param::checkpoint_interval);
       use_model_server_ = settings_manager->GetBool(settings::Param::model_server_enable);
       model_server_path_ = settings_manager->GetString(settings::Param::model_server_path);
 
@@ -1165,6 +1311,13 @@ class DBMain {
    */
   common::ManagedPointer<CatalogLayer> GetCatalogLayer() const { return common::ManagedPointer(catalog_layer_); }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<storage::CheckpointManager> GetCheckpointManager() const {
+    return common::ManagedPointer(checkpoint_manager_);
+  }
+
   /**
    * @return ManagedPointer to the component, can be nullptr if disabled
    */
@@ -1240,6 +1393,7 @@ class DBMain {
   std::unique_ptr<TransactionLayer> txn_layer_;
   std::unique_ptr<StorageLayer> storage_layer_;
   std::unique_ptr<CatalogLayer> catalog_layer_;
+  std::unique_ptr<storage::CheckpointManager> checkpoint_manager_;  // Depends on catalog, txn and log manager.
   std::unique_ptr<storage::GarbageCollectorThread>
       gc_thread_;  // thread needs to die before manual invocations of GC in CatalogLayer and others
   std::unique_ptr<optimizer::StatsStorage> stats_storage_;
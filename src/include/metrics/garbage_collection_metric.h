@@ -46,7 +46,8 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
 
     for (const auto &data : gc_data_) {
       outfile << data.txns_deallocated_ << ", " << data.txns_unlinked_ << ", " << data.buffer_unlinked_ << ", "
-              << data.readonly_unlinked_ << ", " << data.interval_ << ", ";
+              << data.readonly_unlinked_ << ", " << data.interval_ << ", " << data.unlink_backlog_ << ", "
+              << data.deallocate_backlog_ << ", " << data.num_workers_ << ", ";
       data.resource_metrics_.ToCSV(outfile);
       outfile << std::endl;
     }
@@ -62,33 +63,42 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
    * Note: This includes the columns for the input feature, but not the output (resource counters)
    */
   static constexpr std::array<std::string_view, 1> FEATURE_COLUMNS = {
-      "txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval"};
+      "txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval, unlink_backlog, "
+      "deallocate_backlog, num_workers"};
 
  private:
   friend class GarbageCollectionMetric;
   FRIEND_TEST(MetricsTests, LoggingCSVTest);
 
   void RecordGCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked,
-                    uint64_t readonly_unlinked, const uint64_t interval,
+                    uint64_t readonly_unlinked, const uint64_t interval, uint64_t unlink_backlog,
+                    uint64_t deallocate_backlog, uint64_t num_workers,
                     const common::ResourceTracker::Metrics &resource_metrics) {
     gc_data_.emplace_back(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
-                          resource_metrics);
+                          unlink_backlog, deallocate_backlog, num_workers, resource_metrics);
   }
 
   struct GCData {
     GCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked, uint64_t readonly_unlinked,
-           const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics)
+           const uint64_t interval, uint64_t unlink_backlog, uint64_t deallocate_backlog, uint64_t num_workers,
+           const common::ResourceTracker::Metrics &resource_metrics)
         : txns_deallocated_(txns_deallocated),
           txns_unlinked_(txns_unlinked),
           buffer_unlinked_(buffer_unlinked),
           readonly_unlinked_(readonly_unlinked),
           interval_(interval),
+          unlink_backlog_(unlink_backlog),
+          deallocate_backlog_(deallocate_backlog),
+          num_workers_(num_workers),
           resource_metrics_(resource_metrics) {}
     const uint64_t txns_deallocated_;
     const uint64_t txns_unlinked_;
     const uint64_t buffer_unlinked_;
     const uint64_t readonly_unlinked_;
     const uint64_t interval_;
+    const uint64_t unlink_backlog_;      // txns still visible to running txns, left for the next invocation
+    const uint64_t deallocate_backlog_;  // txns unlinked but not yet deallocated
+    const uint64_t num_workers_;
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
@@ -96,17 +106,18 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
 };
 
 /**
- * Metrics for the garbage collection components of the system: currently deallocation and unlinking
+ * Metrics for the garbage collection components of the system: currently deallocation and unlinking, and the backlog
+ * of transactions the GC could not get to yet
  */
 class GarbageCollectionMetric : public AbstractMetric<GarbageCollectionMetricRawData> {
  private:
   friend class MetricsStore;
 
   void RecordGCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked,
-                    uint64_t readonly_unlinked, uint64_t interval,
-                    const common::ResourceTracker::Metrics &resource_metrics) {
+                    uint64_t readonly_unlinked, uint64_t interval, uint64_t unlink_backlog, uint64_t deallocate_backlog,
+                    uint64_t num_workers, const common::ResourceTracker::Metrics &resource_metrics) {
     GetRawData()->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
-                               resource_metrics);
+                               unlink_backlog, deallocate_backlog, num_workers, resource_metrics);
   }
 };
 }  // namespace noisepage::metrics
@@ -59,7 +59,8 @@ class LoggingMetricRawData : public AbstractRawData {
       serializer_outfile << std::endl;
     }
     for (const auto &data : consumer_data_) {
-      consumer_outfile << data.num_bytes_ << ", " << data.num_buffers_ << ", " << data.interval_ << ", ";
+      consumer_outfile << data.num_bytes_ << ", " << data.num_buffers_ << ", " << data.num_commits_ << ", "
+                       << data.interval_ << ", ";
       data.resource_metrics_.ToCSV(consumer_outfile);
       consumer_outfile << std::endl;
     }
@@ -83,7 +84,8 @@ class LoggingMetricRawData : public AbstractRawData {
    * Note: This includes the columns for the input feature, but not the output (resource counters)
    */
   static constexpr std::array<std::string_view, 3> FEATURE_COLUMNS = {
-      "num_bytes, num_records, num_txns, interval", "num_bytes, num_buffers, interval", "num_records, num_txns"};
+      "num_bytes, num_records, num_txns, interval", "num_bytes, num_buffers, num_commits, interval",
+      "num_records, num_txns"};
 
  private:
   friend class LoggingMetric;
@@ -94,9 +96,9 @@ class LoggingMetricRawData : public AbstractRawData {
     serializer_data_.emplace_back(num_bytes, num_records, num_txns, interval, resource_metrics);
   }
 
-  void RecordConsumerData(const uint64_t num_bytes, const uint64_t num_buffers, const uint64_t interval,
-                          const common::ResourceTracker::Metrics &resource_metrics) {
-    consumer_data_.emplace_back(num_bytes, num_buffers, interval, resource_metrics);
+  void RecordConsumerData(const uint64_t num_bytes, const uint64_t num_buffers, const uint64_t num_commits,
+                          const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics) {
+    consumer_data_.emplace_back(num_bytes, num_buffers, num_commits, interval, resource_metrics);
   }
 
   void RecordRecoveryData(const uint64_t num_records, const uint64_t num_txns,
@@ -120,11 +122,17 @@ class LoggingMetricRawData : public AbstractRawData {
   };
 
   struct ConsumerData {
-    ConsumerData(const uint64_t num_bytes, const uint64_t num_buffers, const uint64_t interval,
-                 const common::ResourceTracker::Metrics &resource_metrics)
-        : num_bytes_(num_bytes), num_buffers_(num_buffers), interval_(interval), resource_metrics_(resource_metrics) {}
+    ConsumerData(const uint64_t num_bytes, const uint64_t num_buffers, const uint64_t num_commits,
+                 const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics)
+        : num_bytes_(num_bytes),
+          num_buffers_(num_buffers),
+          num_commits_(num_commits),
+          interval_(interval),
+          resource_metrics_(resource_metrics) {}
     const uint64_t num_bytes_;
     const uint64_t num_buffers_;
+    // Number of commits persisted together, i.e. the size of the commit batch
+    const uint64_t num_commits_;
     const uint64_t interval_;
     const common::ResourceTracker::Metrics resource_metrics_;
   };
@@ -155,9 +163,9 @@ class LoggingMetric : public AbstractMetric<LoggingMetricRawData> {
                             const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics) {
     GetRawData()->RecordSerializerData(num_bytes, num_records, num_txns, interval, resource_metrics);
   }
-  void RecordConsumerData(const uint64_t num_bytes, const uint64_t num_buffers, const uint64_t interval,
-                          const common::ResourceTracker::Metrics &resource_metrics) {
-    GetRawData()->RecordConsumerData(num_bytes, num_buffers, interval, resource_metrics);
+  void RecordConsumerData(const uint64_t num_bytes, const uint64_t num_buffers, const uint64_t num_commits,
+                          const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics) {
+    GetRawData()->RecordConsumerData(num_bytes, num_buffers, num_commits, interval, resource_metrics);
   }
   void RecordRecoveryData(const uint64_t num_records, const uint64_t num_txns,
                           const common::ResourceTracker::Metrics &resource_metrics) {
@@ -59,18 +59,19 @@ class MetricsStore {
   /**
    * Record metrics from the LogConsumerTask
    * @param num_bytes first entry of metrics datapoint
-   * @param num_records second entry of metrics datapoint
-   * @param interval third entry of metrics datapoint
-   * @param resource_metrics third entry of metrics datapoint
+   * @param num_buffers second entry of metrics datapoint
+   * @param num_commits third entry of metrics datapoint, the number of commits persisted together
+   * @param interval fourth entry of metrics datapoint
+   * @param resource_metrics fifth entry of metrics datapoint
    */
-  void RecordConsumerData(const uint64_t num_bytes, const uint64_t num_records, const uint64_t interval,
-                          const common::ResourceTracker::Metrics &resource_metrics) {
+  void RecordConsumerData(const uint64_t num_bytes, const uint64_t num_buffers, const uint64_t num_commits,
+                          const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics) {
     if (!ComponentEnabled(MetricsComponent::LOGGING))
       METRICS_LOG_WARN(
           "RecordConsumerData() called without logging metrics enabled. Was it recently disabled and the component is "
           "just lagging?");
     NOISEPAGE_ASSERT(logging_metric_ != nullptr, "LoggingMetric not allocated. Check MetricsStore constructor.");
-    logging_metric_->RecordConsumerData(num_bytes, num_records, interval, resource_metrics);
+    logging_metric_->RecordConsumerData(num_bytes, num_buffers, num_commits, interval, resource_metrics);
   }
 
   /**
@@ -96,18 +97,21 @@ class MetricsStore {
    * @param buffer_unlinked third entry of metrics datapoint
    * @param readonly_unlinked fourth entry of metrics datapoint
    * @param interval fifth entry of metrics datapoint
-   * @param resource_metrics sixth entry of metrics datapoint
+   * @param unlink_backlog sixth entry of metrics datapoint
+   * @param deallocate_backlog seventh entry of metrics datapoint
+   * @param num_workers eighth entry of metrics datapoint
+   * @param resource_metrics ninth entry of metrics datapoint
    */
   void RecordGCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked,
-                    uint64_t readonly_unlinked, uint64_t interval,
-                    const common::ResourceTracker::Metrics &resource_metrics) {
+                    uint64_t readonly_unlinked, uint64_t interval, uint64_t unlink_backlog, uint64_t deallocate_backlog,
+                    uint64_t num_workers, const common::ResourceTracker::Metrics &resource_metrics) {
     if (!ComponentEnabled(MetricsComponent::GARBAGECOLLECTION))
       METRICS_LOG_WARN(
           "RecordUnlinkData() called without GC metrics enabled. Was it recently disabled and the component is just "
           "lagging?");
     NOISEPAGE_ASSERT(gc_metric_ != nullptr, "GarbageCollectionMetric not allocated. Check MetricsStore constructor.");
     gc_metric_->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
-                             resource_metrics);
+                             unlink_backlog, deallocate_backlog, num_workers, resource_metrics);
   }
 
   /**
@@ -71,6 +71,11 @@ enum class NetworkMessageType : unsigned char {
   PG_PARAMETER_DESCRIPTION = 't',
   PG_ROW_DESCRIPTION = 'T',
   PG_DATA_ROW = 'D',
+  PG_COPY_IN_RESPONSE = 'G',
+  PG_COPY_OUT_RESPONSE = 'H',
+  // Sent in both directions during COPY
+  PG_COPY_DATA = 'd',
+  PG_COPY_DONE = 'c',
   // Commands
   PG_EXECUTE_COMMAND = 'E',
   PG_SYNC_COMMAND = 'S',
@@ -80,6 +85,7 @@ enum class NetworkMessageType : unsigned char {
   PG_PARSE_COMMAND = 'P',
   PG_SIMPLE_QUERY_COMMAND = 'Q',
   PG_CLOSE_COMMAND = 'C',
+  PG_COPY_FAIL_COMMAND = 'f',
 
   ////////////////////////
   // ITP message types  //
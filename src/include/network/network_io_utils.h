@@ -7,6 +7,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "common/error/exception.h"
@@ -209,6 +210,19 @@ class ReadBufferView {
     return result;
   }
 
+  /**
+   * Read the rest of the view without copying it. The returned string_view is only valid as long as the underlying
+   * read buffer is not modified.
+   * @return the bytes that have not been read yet
+   */
+  std::string_view ReadRemaining() {
+    const size_t len = size_ - offset_;
+    if (len == 0) return {};
+    std::string_view result(reinterpret_cast<const char *>(&*(begin_ + offset_)), len);
+    offset_ = size_;
+    return result;
+  }
+
   /**
    * Read a value of type T off of the buffer, advancing cursor by appropriate
    * amount. Does NOT convert from network bytes order. It is the caller's
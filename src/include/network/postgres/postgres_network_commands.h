@@ -50,6 +50,10 @@ DEFINE_POSTGRES_COMMAND(ExecuteCommand, false);
 DEFINE_POSTGRES_COMMAND(SyncCommand, true);
 DEFINE_POSTGRES_COMMAND(CloseCommand, true);
 DEFINE_POSTGRES_COMMAND(TerminateCommand, true);
+// COPY ... FROM STDIN only answers once the data is done, or on the first error
+DEFINE_POSTGRES_COMMAND(CopyDataCommand, false);
+DEFINE_POSTGRES_COMMAND(CopyDoneCommand, true);
+DEFINE_POSTGRES_COMMAND(CopyFailCommand, true);
 DEFINE_POSTGRES_COMMAND(EmptyCommand, true);  // (Matt): This seems to be only for testing? Not a big fan of that.
 
 }  // namespace noisepage::network
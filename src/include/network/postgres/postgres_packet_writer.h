@@ -168,6 +168,29 @@ class PostgresPacketWriter : public PacketWriter {
    */
   void WriteBindComplete();
 
+  /**
+   * Tells the client to start sending COPY data, in text format
+   * @param num_columns number of columns in every row
+   */
+  void WriteCopyInResponse(uint16_t num_columns);
+
+  /**
+   * Tells the client that COPY data follows, in text format
+   * @param num_columns number of columns in every row
+   */
+  void WriteCopyOutResponse(uint16_t num_columns);
+
+  /**
+   * Writes a chunk of COPY data
+   * @param data the data, which need not be aligned to rows
+   */
+  void WriteCopyData(std::string_view data);
+
+  /**
+   * Tells the client that all COPY data was sent
+   */
+  void WriteCopyDone();
+
   /**
    * Write a data row from the execution engine back to the client
    * @param tuple pointer to the start of the row
@@ -15,6 +15,7 @@
 #include "network/postgres/statement.h"
 #include "network/postgres/statement_cache.h"
 #include "network/protocol_interpreter.h"
+#include "traffic_cop/copy_loader.h"
 
 namespace noisepage::network {
 
@@ -91,12 +92,14 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   void GetResult(const common::ManagedPointer<WriteQueue> out) override {}
 
   /**
-   * Used to clear the waiting for sync, explicit txn block, and portals. Call whenever a transaction is ended.
+   * Used to clear the waiting for sync, explicit txn block, portals, and any COPY in progress. Call whenever a
+   * transaction is ended.
    */
   void ResetTransactionState() {
     waiting_for_sync_ = false;
     explicit_txn_block_ = false;
     portals_.clear();
+    copy_loader_.reset();
   }
 
   /**
@@ -148,6 +151,30 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
     waiting_for_sync_ = false;
   }
 
+  /**
+   * @return true if a COPY ... FROM STDIN is waiting for CopyData messages from the client
+   */
+  bool CopyInProgress() const { return copy_loader_ != nullptr; }
+
+  /**
+   * Enters the copy-in mode of a COPY ... FROM STDIN
+   * @param loader loader to take ownership of, which receives the data of the following CopyData messages
+   */
+  void BeginCopy(std::unique_ptr<trafficcop::CopyLoader> &&loader) {
+    NOISEPAGE_ASSERT(copy_loader_ == nullptr, "COPY is already in progress. That seems wrong.");
+    copy_loader_ = std::move(loader);
+  }
+
+  /**
+   * @return loader of the COPY in progress, nullptr if there is none
+   */
+  common::ManagedPointer<trafficcop::CopyLoader> GetCopyLoader() const { return common::ManagedPointer(copy_loader_); }
+
+  /**
+   * Leaves the copy-in mode. Any CopyData, CopyDone or CopyFail messages still sent by the client are ignored.
+   */
+  void EndCopy() { copy_loader_.reset(); }
+
   /**
    * @param name statement to look up
    * @return managed pointer to statement if it exists, nullptr otherwise
@@ -244,6 +271,9 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   // name to portal
   std::unordered_map<std::string, std::unique_ptr<network::Portal>> portals_;
 
+  // loader of the COPY ... FROM STDIN in progress, if any
+  std::unique_ptr<trafficcop::CopyLoader> copy_loader_;
+
   /**
    * close all Portals constructed from a Statement. We don't care about return value since it's not an error to call
    * Close on non-existent statement
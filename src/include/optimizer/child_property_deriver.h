@@ -151,6 +151,12 @@ class ChildPropertyDeriver : public OperatorVisitor {
    * @param op LeftSemiHashJoin operator to visit
    */
   void Visit(const LeftSemiHashJoin *op) override;
+
+  /**
+   * Visitor function for InnerMergeJoin
+   * @param op InnerMergeJoin operator to visit
+   */
+  void Visit(const InnerMergeJoin *op) override;
   /**
    * Visitor function for Insert
    * @param op Insert operator to visit
@@ -0,0 +1,275 @@
+#pragma once
+
+#include "common/macros.h"
+#include "optimizer/cost_model/abstract_cost_model.h"
+#include "optimizer/optimizer_defs.h"
+
+namespace noisepage::optimizer {
+
+class Memo;
+class GroupExpression;
+
+/**
+ * A cost model that estimates the work an operator does from the cardinalities derived by the StatsCalculator.
+ *
+ * The cost of an operator is the sum of three components, all expressed in units of processing one tuple:
+ * - CPU: producing tuples and evaluating predicates, hashing and comparing keys
+ * - Memory: materializing tuples in hash tables, sort buffers and aggregation tables
+ * - Access: reading tuples from a table, either sequentially through a scan or randomly through an index
+ *
+ * Base table sizes come from TableStats, and scan selectivities from the per-column filter selectivities recorded in
+ * each group. Groups without derived stats, and tables that have not been analyzed, fall back to default estimates.
+ * The cost of an operator does not include the cost of its children, which is added by the optimizer.
+ */
+class CostBasedCostModel : public AbstractCostModel {
+ public:
+  /** Cost of producing a tuple and passing it to the parent operator */
+  static constexpr double CPU_TUPLE_COST = 0.01;
+
+  /** Cost of evaluating a single predicate or key comparison on a tuple */
+  static constexpr double CPU_OPERATOR_COST = 0.0025;
+
+  /** Cost of processing an index entry */
+  static constexpr double CPU_INDEX_TUPLE_COST = 0.005;
+
+  /** Cost of reading a tuple during a sequential scan of its table */
+  static constexpr double SEQ_ACCESS_COST = 0.01;
+
+  /** Cost of fetching a tuple from its table through a TupleSlot, i.e. a random access */
+  static constexpr double RANDOM_ACCESS_COST = 0.04;
+
+  /** Cost of hashing a tuple and inserting it into a hash table */
+  static constexpr double HASH_BUILD_COST = 0.02;
+
+  /** Cost of hashing a tuple and probing a hash table with it */
+  static constexpr double HASH_PROBE_COST = 0.005;
+
+  /** Cost of keeping a tuple materialized in memory */
+  static constexpr double MEMORY_TUPLE_COST = 0.005;
+
+  /** Cost of descending an index to the first matching entry */
+  static constexpr double INDEX_DESCENT_COST = 0.05;
+
+  /** Number of rows assumed for groups without derived stats and tables that have not been analyzed */
+  static constexpr double DEFAULT_NUM_ROWS = 1000;
+
+  /** Selectivity assumed for an equality bound on an index column without column statistics */
+  static constexpr double DEFAULT_EQUALITY_SELECTIVITY = 0.005;
+
+  /** Selectivity assumed for a range bound on an index column without column statistics */
+  static constexpr double DEFAULT_RANGE_SELECTIVITY = 0.333;
+
+  /**
+   * Default constructor
+   */
+  CostBasedCostModel() = default;
+
+  /**
+   * Costs a GroupExpression
+   * @param txn TransactionContext that query is generated under
+   * @param accessor CatalogAccessor
+   * @param memo Memo object containing all relevant groups
+   * @param gexpr GroupExpression to calculate cost for
+   */
+  double CalculateCost(transaction::TransactionContext *txn, catalog::CatalogAccessor *accessor, Memo *memo,
+                       GroupExpression *gexpr) override;
+
+  /**
+   * Visit a SeqScan operator
+   * @param op operator
+   */
+  void Visit(const SeqScan *op) override;
+
+  /**
+   * Visit a IndexScan operator
+   * @param op operator
+   */
+  void Visit(const IndexScan *op) override;
+
+  /**
+   * Visit a QueryDerivedScan operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const QueryDerivedScan *op) override;
+
+  /**
+   * Visit a OrderBy operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const OrderBy *op) override;
+
+  /**
+   * Visit a Limit operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const Limit *op) override;
+
+  /**
+   * Visit a InnerIndexJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerIndexJoin *op) override;
+
+  /**
+   * Visit a InnerNLJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerNLJoin *op) override;
+
+  /**
+   * Visit a LeftNLJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const LeftNLJoin *op) override;
+
+  /**
+   * Visit a RightNLJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const RightNLJoin *op) override;
+
+  /**
+   * Visit a OuterNLJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const OuterNLJoin *op) override;
+
+  /**
+   * Visit a InnerHashJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerHashJoin *op) override;
+
+  /**
+   * Visit a LeftHashJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftHashJoin *op) override;
+
+  /**
+   * Visit a RightHashJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) override;
+
+  /**
+   * Visit a OuterHashJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) override;
+
+  /**
+   * Visit a LeftSemiHashJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftSemiHashJoin *op) override;
+
+  /**
+   * Visit a InnerMergeJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
+  /**
+   * Visit a Insert operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const Insert *op) override;
+
+  /**
+   * Visit a InsertSelect operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const InsertSelect *op) override;
+
+  /**
+   * Visit a Delete operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const Delete *op) override;
+
+  /**
+   * Visit a Update operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const Update *op) override;
+
+  /**
+   * Visit a HashGroupBy operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const HashGroupBy *op) override;
+
+  /**
+   * Visit a SortGroupBy operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const SortGroupBy *op) override;
+
+  /**
+   * Visit a Aggregate operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const Aggregate *op) override;
+
+ private:
+  /**
+   * @return estimated number of rows produced by the group being costed
+   */
+  double GetOutputRows() const;
+
+  /**
+   * @param child_idx index of the child
+   * @return estimated number of rows produced by the child group at the given index
+   */
+  double GetChildRows(int child_idx) const;
+
+  /**
+   * @return estimated number of rows in the base table scanned by the group being costed
+   */
+  double GetTableRows() const;
+
+  /**
+   * @return estimated number of rows produced by the given group
+   */
+  double GetGroupRows(group_id_t group_id) const;
+
+  /**
+   * Cost a nested loop join, which evaluates its predicates on every pair of left and right tuples
+   * @param num_predicates number of join predicates
+   */
+  void CostNLJoin(size_t num_predicates);
+
+  /**
+   * Cost a hash join, which builds a hash table on its left child and probes it with its right child
+   * @param num_keys number of join keys
+   */
+  void CostHashJoin(size_t num_keys);
+
+  /**
+   * GroupExpression to cost
+   */
+  GroupExpression *gexpr_;
+
+  /**
+   * Memo table to use
+   */
+  Memo *memo_;
+
+  /**
+   * Transaction Context
+   */
+  transaction::TransactionContext *txn_;
+
+  /**
+   * Accessor
+   */
+  catalog::CatalogAccessor *accessor_;
+
+  /**
+   * Computed output cost
+   */
+  double output_cost_ = 0;
+};
+
+}  // namespace noisepage::optimizer
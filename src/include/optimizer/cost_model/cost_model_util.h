@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "common/macros.h"
+#include "optimizer/cost_model/abstract_cost_model.h"
+#include "optimizer/cost_model/cost_based_cost_model.h"
+#include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/optimizer_defs.h"
+
+namespace noisepage::optimizer {
+
+/**
+ * Static utility methods for selecting a cost model
+ */
+struct CostModelUtil {
+  CostModelUtil() = delete;
+
+  /**
+   * Converts a cost model string to the enum.
+   * Mainly used to convert a settings flag (string) to internal enum.
+   * @param cost_model cost model string
+   * @return CostModelType corresponding to it, std::nullopt if the string does not name a cost model
+   */
+  static std::optional<CostModelType> FromCostModelString(const std::string_view &cost_model) {
+    std::optional<CostModelType> type{std::nullopt};
+    if (cost_model == "TRIVIAL") {
+      type = CostModelType::TRIVIAL;
+    } else if (cost_model == "COST_BASED") {
+      type = CostModelType::COST_BASED;
+    }
+    return type;
+  }
+
+  /**
+   * @param type cost model to create
+   * @return a new instance of the cost model
+   */
+  static std::unique_ptr<AbstractCostModel> CreateCostModel(const CostModelType type) {
+    switch (type) {
+      case CostModelType::TRIVIAL:
+        return std::make_unique<TrivialCostModel>();
+      case CostModelType::COST_BASED:
+        return std::make_unique<CostBasedCostModel>();
+    }
+    UNREACHABLE("Unknown cost model type.");
+  }
+};
+
+}  // namespace noisepage::optimizer
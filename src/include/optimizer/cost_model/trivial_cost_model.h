@@ -13,6 +13,7 @@ class GroupExpression;
  * Always choose index scan (cost of 0) over sequential scan (cost of 1)
  * Choose NL if left rows is a single record (for single record lookup queries), else choose hash join
  * Choose hash group by over sort group by
+ * Never choose merge join, since sorting its inputs is free in this model
  */
 class TrivialCostModel : public AbstractCostModel {
  public:
@@ -132,6 +133,12 @@ class TrivialCostModel : public AbstractCostModel {
    */
   void Visit(UNUSED_ATTRIBUTE const LeftSemiHashJoin *op) override { output_cost_ = 1.f; }
 
+  /**
+   * Visit a InnerMergeJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const InnerMergeJoin *op) override { output_cost_ = NLJOIN_COST + 2.0f; }
+
   /**
    * Visit a Insert operator
    * @param op operator
@@ -167,6 +167,12 @@ class InputColumnDeriver : public OperatorVisitor {
    */
   void Visit(const LeftSemiHashJoin *op) override;
 
+  /**
+   * Visit function to derive input/output columns for InnerMergeJoin
+   * @param op InnerMergeJoin operator to visit
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
   /**
    * Visit function to derive input/output columns for TableFreeScan
    * @param op TableFreeScan operator to visit
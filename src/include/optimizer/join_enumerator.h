@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "optimizer/optimizer_defs.h"
+
+namespace noisepage::optimizer {
+
+class GroupExpression;
+class OptimizerContext;
+
+/**
+ * JoinEnumerator fills the Memo with the join orders of every tree of inner joins in a query, bottom-up.
+ *
+ * A join tree is a maximal tree of LogicalInnerJoins. Its leaves, the non-join groups below it, are the relations of
+ * the join graph, and two relations are connected if a join predicate references both of them. For join trees with at
+ * most dp_threshold relations, every pair of connected subgraphs whose union is connected (a csg-cmp-pair) is
+ * enumerated with DPccp. Each pair becomes a LogicalInnerJoin, in both orders, in the group of the union of the two
+ * subgraphs, so cross products are only considered if the join graph is not connected. Larger join trees are built
+ * greedily instead: the pair of subtrees with the smallest estimated join cardinality is joined until one tree is
+ * left, which bounds the number of groups by the number of relations.
+ *
+ * Stats are derived for every new group as it is created. The join orders are complete afterwards, so the join
+ * commutativity and associativity rules are marked as explored on every join in the tree. The physical implementation
+ * rules and the cost model then pick the cheapest plan among the enumerated join orders.
+ */
+class JoinEnumerator {
+ public:
+  /**
+   * @param context OptimizerContext holding the Memo to fill
+   * @param dp_threshold maximum number of relations in a join tree to enumerate with dynamic programming
+   */
+  JoinEnumerator(OptimizerContext *context, uint32_t dp_threshold) : context_(context), dp_threshold_(dp_threshold) {}
+
+  /**
+   * Enumerate the join orders of all join trees below the given group
+   * @param group_id group to start from, usually the root group
+   */
+  void EnumerateJoins(group_id_t group_id);
+
+  /** Join trees with more relations than this are left to the transformation rules */
+  static constexpr uint32_t MAX_JOIN_RELATIONS = 64;
+
+ private:
+  /** Set of relations of a join tree, one bit per relation */
+  using RelationSet = uint64_t;
+
+  /** A join predicate of the join tree and the relations it references */
+  struct JoinPredicate {
+    /** The predicate */
+    AnnotatedExpression predicate_;
+    /** Relations referenced by the predicate */
+    RelationSet relations_;
+  };
+
+  /**
+   * Collect the relations, join predicates and join groups of the join tree rooted at the given group
+   * @param group_id group of a LogicalInnerJoin
+   * @return the set of relations below the group
+   */
+  RelationSet CollectJoinTree(group_id_t group_id);
+
+  /**
+   * Enumerate the join orders of the join tree rooted at the given group
+   * @param group_id group of the top-most LogicalInnerJoin of the tree
+   */
+  void EnumerateJoinTree(group_id_t group_id);
+
+  /** Enumerate all csg-cmp-pairs of the join graph with DPccp */
+  void EnumerateDPccp();
+
+  /** Recursively extend the connected subgraph 'csg' with neighbors that are not in 'excluded' */
+  void EnumerateCsgRec(RelationSet csg, RelationSet excluded);
+
+  /** Emit all complements of the connected subgraph 'csg' */
+  void EmitCsg(RelationSet csg);
+
+  /** Recursively extend the complement 'cmp' of 'csg' with neighbors that are not in 'excluded' */
+  void EnumerateCmpRec(RelationSet csg, RelationSet cmp, RelationSet excluded);
+
+  /** Join subtrees greedily by smallest estimated cardinality */
+  void EnumerateGreedy();
+
+  /**
+   * Insert the join of the two given sets of relations, in both orders, into the group of their union
+   * @return the group of the union
+   */
+  group_id_t EmitJoin(RelationSet left, RelationSet right);
+
+  /** @return the join predicates to evaluate when joining the two given sets of relations */
+  std::vector<AnnotatedExpression> GetJoinPredicates(RelationSet left, RelationSet right) const;
+
+  /** @return the relations adjacent to any relation in 'relations' that are neither in 'relations' nor 'excluded' */
+  RelationSet GetNeighbors(RelationSet relations, RelationSet excluded) const;
+
+  /** Mark the join transformation rules as explored on the given join expression */
+  void MarkJoinRulesExplored(GroupExpression *gexpr);
+
+  OptimizerContext *context_;
+  const uint32_t dp_threshold_;
+
+  // State of the join tree being enumerated
+  std::vector<group_id_t> relations_;
+  std::vector<JoinPredicate> predicates_;
+  std::vector<RelationSet> neighbors_;
+  std::unordered_map<RelationSet, group_id_t> join_groups_;
+};
+
+}  // namespace noisepage::optimizer
@@ -4,6 +4,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "common/shared_latch.h"
 #include "optimizer/group.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/operator_node.h"
@@ -41,6 +42,9 @@ struct GExprPtrEq {
 /**
  * Memo class provides for tracking Groups and GroupExpressions and provides the
  * mechanisms by which we can do duplicate group detection.
+ *
+ * While set concurrent, insertions and group lookups are latched so that optimizer tasks running in parallel on
+ * disjoint sets of groups (@see ConcurrentOptimizerTaskPool) can share one Memo. The groups themselves are not latched.
  */
 class Memo {
  public:
@@ -97,9 +101,11 @@ class Memo {
    * @returns Group with specified ID
    */
   Group *GetGroupByID(group_id_t id) const {
-    auto idx = id.UnderlyingValue();
-    NOISEPAGE_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
-    return groups_[idx];
+    if (concurrent_) {
+      common::SharedLatch::ScopedSharedLatch guard(&latch_);
+      return GetGroupByIDUnlocked(id);
+    }
+    return GetGroupByIDUnlocked(id);
   }
 
   /**
@@ -109,6 +115,37 @@ class Memo {
    * @param group_id GroupID of Group to erase
    */
   void EraseExpression(group_id_t group_id) {
+    if (concurrent_) {
+      common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+      EraseExpressionUnlocked(group_id);
+      return;
+    }
+    EraseExpressionUnlocked(group_id);
+  }
+
+  /**
+   * Sets whether optimizer tasks share the Memo concurrently. Insertions and group lookups are only latched while
+   * this is set, it must not change while tasks run.
+   * @param concurrent whether tasks may use the Memo concurrently
+   */
+  void SetConcurrent(const bool concurrent) { concurrent_ = concurrent; }
+
+ private:
+  /**
+   * Adds a non-leaf group expression into the proper group in the memo, the caller must hold the latch exclusively
+   * if the Memo is concurrent
+   * @param gexpr GroupExpression to insert
+   * @param target_group Group to insert into
+   * @param enforced if the new expression is created by enforcer
+   * @returns Existing expression if found. Otherwise, return the new expr
+   */
+  GroupExpression *InsertExpressionUnlocked(GroupExpression *gexpr, group_id_t target_group, bool enforced);
+
+  /**
+   * Erases the logical expression of a group, the caller must hold the latch exclusively if the Memo is concurrent
+   * @param group_id GroupID of Group to erase
+   */
+  void EraseExpressionUnlocked(group_id_t group_id) {
     auto idx = group_id.UnderlyingValue();
     NOISEPAGE_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
 
@@ -117,9 +154,19 @@ class Memo {
     groups_[idx]->EraseLogicalExpression();
   }
 
- private:
   /**
-   * Creates a new group
+   * Gets the group with certain ID, the caller must hold the latch if the Memo is concurrent
+   * @param id ID of the group to get
+   * @returns Group with specified ID
+   */
+  Group *GetGroupByIDUnlocked(group_id_t id) const {
+    auto idx = id.UnderlyingValue();
+    NOISEPAGE_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
+    return groups_[idx];
+  }
+
+  /**
+   * Creates a new group, the caller must hold the latch exclusively if the Memo is concurrent
    * @param gexpr GroupExpression to collect metadata from
    * @returns GroupID of the new group
    */
@@ -135,6 +182,16 @@ class Memo {
    * Vector of groups tracked
    */
   std::vector<Group *> groups_;
+
+  /**
+   * Latch protecting group_expressions_ and groups_ while the Memo is concurrent
+   */
+  mutable common::SharedLatch latch_;
+
+  /**
+   * Whether optimizer tasks use the Memo concurrently
+   */
+  bool concurrent_ = false;
 };
 
 }  // namespace noisepage::optimizer
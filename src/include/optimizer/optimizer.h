@@ -4,9 +4,12 @@
 #include <utility>
 #include <vector>
 
+#include "common/managed_pointer.h"
+#include "common/worker_pool.h"
 #include "optimizer/abstract_optimizer.h"
 #include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/optimize_result.h"
+#include "optimizer/optimizer_defs.h"
 #include "optimizer/optimizer_context.h"
 #include "optimizer/property_set.h"
 
@@ -45,11 +48,19 @@ class Optimizer : public AbstractOptimizer {
    * Constructor for Optimizer with a cost_model
    * @param model Cost Model to use for the optimizer
    * @param task_execution_timeout time in ms to spend on a task
+   * @param join_enumeration_threshold maximum number of relations in a join tree to enumerate with dynamic
+   *        programming, larger join trees are ordered greedily
+   * @param workers shared pool whose threads optimize independent groups along with the calling thread, nullptr
+   *        optimizes on the calling thread only
    */
-  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout)
+  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout,
+                     const uint32_t join_enumeration_threshold = DEFAULT_JOIN_ENUMERATION_THRESHOLD,
+                     const common::ManagedPointer<common::WorkerPool> workers = nullptr)
       : cost_model_(std::move(model)),
         context_(std::make_unique<OptimizerContext>(common::ManagedPointer(cost_model_))),
-        task_execution_timeout_(task_execution_timeout) {}
+        task_execution_timeout_(task_execution_timeout),
+        join_enumeration_threshold_(join_enumeration_threshold),
+        workers_(workers) {}
 
   /**
    * Build the plan tree for query execution
@@ -80,6 +91,25 @@ class Optimizer : public AbstractOptimizer {
    */
   void OptimizeLoop(group_id_t root_group_id, PropertySet *required_props);
 
+  /**
+   * Optimize the independent groups below the root in parallel, without required properties. The root pass then
+   * finds these groups already optimized and only has to cost the groups above them. Groups that are not optimized
+   * within the budget are left to the root pass.
+   * @param root_group_id Root Group ID of the query
+   * @param budget time in ms after which no more groups are started
+   */
+  void OptimizeIndependentGroups(group_id_t root_group_id, uint64_t budget);
+
+  /**
+   * Find groups below the root that can be optimized in parallel. A group is independent if no group in its subtree
+   * is referenced from outside the subtree, so tasks on different independent groups never touch the same group.
+   * Starting from the root, an independent group is split into the topmost independent groups below it as long as
+   * there are at least two of them to run in parallel.
+   * @param root_group_id Root Group ID of the query
+   * @returns groups with pairwise disjoint subtrees
+   */
+  std::vector<group_id_t> CollectIndependentGroups(group_id_t root_group_id);
+
   /**
    * Retrieve the lowest cost execution plan with the given properties
    *
@@ -104,8 +134,10 @@ class Optimizer : public AbstractOptimizer {
    * @param task_stack Optimizer's Task Stack to execute through
    * @param root_group_id Root Group ID to check whether there is a plan or not
    * @param root_context OptimizerContext to use that maintains required properties
+   * @param elapsed_time time in ms already spent on the optimization before the task stack
    */
-  void ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id, OptimizationContext *root_context);
+  void ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id, OptimizationContext *root_context,
+                        uint64_t elapsed_time = 0);
 
   /**
    * Invoke a single DFS pass through the entire plan
@@ -118,6 +150,8 @@ class Optimizer : public AbstractOptimizer {
   std::unique_ptr<AbstractCostModel> cost_model_;
   std::unique_ptr<OptimizerContext> context_;
   const uint64_t task_execution_timeout_;
+  const uint32_t join_enumeration_threshold_;
+  const common::ManagedPointer<common::WorkerPool> workers_;
 };
 
 }  // namespace optimizer
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "common/settings.h"
+#include "common/spin_latch.h"
 #include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/memo.h"
@@ -109,7 +110,14 @@ class OptimizerContext {
    * Adds a OptimizationContext to the tracking list
    * @param ctx OptimizationContext to add to tracking
    */
-  void AddOptimizationContext(OptimizationContext *ctx) { track_list_.push_back(ctx); }
+  void AddOptimizationContext(OptimizationContext *ctx) {
+    if (concurrent_) {
+      common::SpinLatch::ScopedSpinLatch guard(&latch_);
+      track_list_.push_back(ctx);
+      return;
+    }
+    track_list_.push_back(ctx);
+  }
 
   /**
    * Pushes a task to the task pool managed
@@ -123,6 +131,27 @@ class OptimizerContext {
    */
   AbstractCostModel *GetCostModel() { return cost_model_.Get(); }
 
+  /**
+   * Costs a GroupExpression with the cost model. Cost models keep the state of the expression being costed in
+   * their members, so calls from concurrent optimizer tasks are serialized.
+   * @param gexpr GroupExpression to cost
+   * @returns cost of the GroupExpression, excluding its children
+   */
+  double CalculateCost(GroupExpression *gexpr) {
+    if (concurrent_) {
+      common::SpinLatch::ScopedSpinLatch guard(&latch_);
+      return cost_model_->CalculateCost(txn_, accessor_, &memo_, gexpr);
+    }
+    return cost_model_->CalculateCost(txn_, accessor_, &memo_, gexpr);
+  }
+
+  /**
+   * Sets whether optimizer tasks run concurrently. While set, the state that tasks share, i.e. this context, the Memo
+   * and the transaction, is latched. It must not change while tasks run.
+   * @param concurrent whether tasks run concurrently
+   */
+  void SetConcurrent(bool concurrent);
+
   /**
    * Gets the transaction
    * @returns transaction
@@ -254,6 +283,9 @@ class OptimizerContext {
   std::vector<OptimizationContext *> track_list_;
   std::unordered_map<catalog::table_oid_t, catalog::Schema> cte_schemas_;
   common::ManagedPointer<std::vector<parser::ConstantValueExpression>> params_;
+  // Serializes the tracking list and the cost model while tasks run concurrently
+  common::SpinLatch latch_;
+  bool concurrent_ = false;
 };
 
 }  // namespace optimizer
@@ -35,6 +35,16 @@ enum class ExternalFileFormat { CSV };
  */
 enum class OrderByOrderingType { ASC, DESC };
 
+/**
+ * Cost models the optimizer can use to cost physical plans
+ */
+enum class CostModelType : uint8_t { TRIVIAL, COST_BASED };
+
+/**
+ * Default maximum number of relations in a join tree to enumerate with dynamic programming
+ */
+constexpr uint32_t DEFAULT_JOIN_ENUMERATION_THRESHOLD = 10;
+
 /**
  * Operator type
  */
@@ -103,6 +113,7 @@ enum class OpType {
   RIGHTHASHJOIN,
   OUTERHASHJOIN,
   LEFTSEMIHASHJOIN,
+  INNERMERGEJOIN,
   INSERT,
   INSERTSELECT,
   DELETE,
@@ -36,6 +36,7 @@ enum class OptimizerTaskType {
   APPLY_RULE,
   OPTIMIZE_INPUTS,
   DERIVE_STATS,
+  ENUMERATE_JOINS,
   REWRITE_EXPR,
   APPLY_REWIRE_RULE,
   TOP_DOWN_REWRITE,
@@ -371,6 +372,39 @@ class DeriveStats : public OptimizerTask {
   bool children_derived_;
 };
 
+/**
+ * EnumerateJoins fills the Memo with the join orders of all join trees below a group (@see JoinEnumerator).
+ * Stats must have been derived for the group before this task runs, since the join orders are enumerated and
+ * costed from the cardinalities of their relations.
+ */
+class EnumerateJoins : public OptimizerTask {
+ public:
+  /**
+   * Constructor for EnumerateJoins
+   * @param group_id Group to enumerate the join trees below
+   * @param dp_threshold Maximum number of relations in a join tree to enumerate with dynamic programming
+   * @param context Current OptimizationContext
+   */
+  EnumerateJoins(group_id_t group_id, uint32_t dp_threshold, OptimizationContext *context)
+      : OptimizerTask(context, OptimizerTaskType::ENUMERATE_JOINS), group_id_(group_id), dp_threshold_(dp_threshold) {}
+
+  /**
+   * Function to execute the task
+   */
+  void Execute() override;
+
+ private:
+  /**
+   * Group to enumerate the join trees below
+   */
+  group_id_t group_id_;
+
+  /**
+   * Maximum number of relations in a join tree to enumerate with dynamic programming
+   */
+  uint32_t dp_threshold_;
+};
+
 /**
  * TopDownRewrite performs a top-down rewrite pass. A generally held assumption for
  * any RuleSet utilizing TopDownRewrite is that once a tree level has been saturated,
@@ -1,8 +1,18 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <stack>
+#include <vector>
 
+#include "common/managed_pointer.h"
+#include "common/spin_latch.h"
+#include "common/worker_pool.h"
 #include "optimizer/optimizer_task.h"
 
 namespace noisepage::optimizer {
@@ -84,4 +94,105 @@ class OptimizerTaskStack : public OptimizerTaskPool {
   std::stack<OptimizerTask *> task_stack_;
 };
 
+/**
+ * Concurrent implementation of the OptimizerTaskPool that runs independent jobs on the calling thread and the threads
+ * of a WorkerPool shared by all queries.
+ *
+ * A job is a task pushed from outside the workers, e.g. an OptimizeGroup on a group whose subtree shares no group with
+ * the subtree of any other job. A worker runs one job at a time on a private stack, so the tasks of a job execute in
+ * the same order as they would on an OptimizerTaskStack and the plan chosen for each group does not depend on the
+ * schedule. Jobs are dealt round-robin to per-worker deques. A worker takes its next job from the back of its own
+ * deque and steals from the front of the other deques once its own is empty.
+ *
+ * Push, Pop and Empty operate on the private stack of the calling worker, or on the jobs if called from any other
+ * thread. Tasks that run concurrently must only touch their own groups, while the Memo is shared.
+ */
+class ConcurrentOptimizerTaskPool : public OptimizerTaskPool {
+ public:
+  /**
+   * Constructor for ConcurrentOptimizerTaskPool
+   * @param workers shared pool whose threads run jobs besides the calling thread, nullptr runs all jobs on the calling
+   *        thread
+   */
+  explicit ConcurrentOptimizerTaskPool(common::ManagedPointer<common::WorkerPool> workers);
+
+  /**
+   * Destructor for ConcurrentOptimizerTaskPool, deletes all tasks that have not been executed
+   */
+  ~ConcurrentOptimizerTaskPool() override;
+
+  /**
+   * Implementation of the Pop interface of OptimizerTaskPool
+   * @returns Next OptimizerTask of the calling worker's job, or the next job if not called from a worker
+   */
+  OptimizerTask *Pop() override;
+
+  /**
+   * Implementation of the Push interface of OptimizerTaskPool
+   * @param task OptimizerTask to add to the calling worker's job, or to add as a new job if not called from a worker
+   */
+  void Push(OptimizerTask *task) override;
+
+  /**
+   * @returns TRUE if the calling worker's job has no tasks left, or if there are no jobs left if not called from a
+   *          worker
+   */
+  bool Empty() override;
+
+  /**
+   * Run jobs on the calling thread and the shared workers until there are none left. Once the budget is spent, no more
+   * jobs are started: jobs already running finish, so that no group is left partially explored, and the others stay in
+   * the pool. If a task throws, no more jobs are started either and the first exception is rethrown once all workers
+   * have stopped.
+   * @param budget time in ms after which no more jobs are started
+   */
+  void Execute(uint64_t budget);
+
+ private:
+  /**
+   * State shared with the workers submitted to the WorkerPool. A busy pool may only run a worker after Execute has
+   * returned, so the worker must check that the call is still open before touching the task pool.
+   */
+  struct WorkerState {
+    /** Protects the other members */
+    std::mutex latch_;
+    /** Notified when a worker stops */
+    std::condition_variable stopped_;
+    /** Number of workers running jobs */
+    uint32_t running_ = 0;
+    /** Whether Execute has stopped waiting for workers to start */
+    bool closed_ = false;
+  };
+
+  /** Jobs assigned to a worker */
+  struct JobQueue {
+    /** Protects jobs_ from thieves */
+    common::SpinLatch latch_;
+    /** Jobs not yet started */
+    std::deque<OptimizerTask *> jobs_;
+  };
+
+  /**
+   * Worker loop, runs jobs until there are none left, the budget is spent or a task has thrown
+   * @param worker_id index of the worker's own queue
+   */
+  void RunWorker(uint32_t worker_id);
+
+  /**
+   * Take the next job for a worker, from its own queue first and then from the other queues
+   * @param worker_id index of the worker's own queue
+   * @returns next job, or nullptr if there are no jobs left
+   */
+  OptimizerTask *NextJob(uint32_t worker_id);
+
+  const common::ManagedPointer<common::WorkerPool> workers_;
+  const uint32_t num_workers_;
+  std::vector<JobQueue> queues_;
+  std::chrono::steady_clock::time_point deadline_;
+  uint32_t next_queue_ = 0;
+  std::atomic<bool> aborted_{false};
+  common::SpinLatch error_latch_;
+  std::exception_ptr error_;
+};
+
 }  // namespace noisepage::optimizer
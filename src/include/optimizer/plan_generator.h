@@ -178,6 +178,12 @@ class PlanGenerator : public OperatorVisitor {
    */
   void Visit(const LeftSemiHashJoin *op) override;
 
+  /**
+   * Visitor function for a InnerMergeJoin operator
+   * @param op InnerMergeJoin operator being visited
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
   /**
    * Visitor function for a Insert operator
    * @param op Insert operator being visited
@@ -340,6 +346,16 @@ class PlanGenerator : public OperatorVisitor {
    */
   std::vector<catalog::col_oid_t> GenerateColumnsForScan(const parser::AbstractExpression *predicate);
 
+  /**
+   * Check whether an index scan can read its columns from the index keys instead of the tuples
+   * @param index_oid OID of the index being scanned
+   * @param scan_type type of the index scan
+   * @param column_ids columns read by the scan
+   * @return true if every column is a key column of the index, and the index returns its keys for the scan type
+   */
+  bool IsIndexOnlyScan(catalog::index_oid_t index_oid, planner::IndexScanType scan_type,
+                       const std::vector<catalog::col_oid_t> &column_ids);
+
   /**
    * Read the oids contained in an expression.
    * @param oids Oids contained in the given expression.
@@ -362,6 +378,18 @@ class PlanGenerator : public OperatorVisitor {
    */
   std::unique_ptr<planner::OutputSchema> GenerateProjectionForJoin();
 
+  /**
+   * Decide whether a hash join should build a bloom filter over its build side and push it into its
+   * probe-side scan. This pays off when the probe side is large and most of its tuples find no join partner.
+   * @param build_plan The build-side (left) child plan
+   * @param probe_plan The probe-side (right) child plan
+   * @param probe_keys The probe-side hash keys
+   * @returns true if the bloom filter should be pushed down
+   */
+  bool ShouldPushDownBloomFilter(const planner::AbstractPlanNode &build_plan,
+                                 const planner::AbstractPlanNode &probe_plan,
+                                 const std::vector<common::ManagedPointer<parser::AbstractExpression>> &probe_keys);
+
   /**
    * The Plan node's OutputSchema may not match the required columns. As such,
    * this function adds a projection on top of the output plan which will ensure
@@ -40,6 +40,7 @@ enum class RuleType : uint32_t {
   INNER_JOIN_TO_NL_JOIN,
   SEMI_JOIN_TO_HASH_JOIN,
   INNER_JOIN_TO_HASH_JOIN,
+  INNER_JOIN_TO_MERGE_JOIN,
   LEFT_JOIN_TO_HASH_JOIN,
   IMPLEMENT_DISTINCT,
   IMPLEMENT_LIMIT,
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "catalog/index_schema.h"
+#include "execution/sql/sql.h"
 #include "optimizer/rule.h"
 
 namespace noisepage::optimizer {
@@ -459,6 +460,50 @@ class LogicalInnerJoinToPhysicalInnerHashJoin : public Rule {
                  OptimizationContext *context) const override;
 };
 
+/**
+ * Rule transforms Logical Inner Join to InnerMergeJoin
+ */
+class LogicalInnerJoinToPhysicalInnerMergeJoin : public Rule {
+ public:
+  /**
+   * Constructor
+   */
+  LogicalInnerJoinToPhysicalInnerMergeJoin();
+
+  /**
+   * Checks whether the given rule can be applied
+   * @param plan AbstractOptimizerNode to check
+   * @param context Current OptimizationContext executing under
+   * @returns Whether the input AbstractOptimizerNode passes the check
+   */
+  bool Check(common::ManagedPointer<AbstractOptimizerNode> plan, OptimizationContext *context) const override;
+
+  /**
+   * Transforms the input expression using the given rule
+   * @param input Input AbstractOptimizerNode to transform
+   * @param transformed Vector of transformed AbstractOptimizerNodes
+   * @param context Current OptimizationContext executing under
+   */
+  void Transform(common::ManagedPointer<AbstractOptimizerNode> input,
+                 std::vector<std::unique_ptr<AbstractOptimizerNode>> *transformed,
+                 OptimizationContext *context) const override;
+
+  /**
+   * Merge join keys are compared with '<' and '>' after both inputs have been sorted on them. A
+   * left and a right key can only be merged if their types have the same ordering.
+   * @param type The type of a merge key.
+   * @return The type whose ordering the key's values follow, or Invalid if they can't be ordered.
+   */
+  static execution::sql::SqlTypeId MergeKeyOrdering(execution::sql::SqlTypeId type);
+
+ private:
+  // Extract the equi-join keys of the inner join, returning all of its join predicates.
+  static std::vector<AnnotatedExpression> ExtractMergeJoinKeys(
+      common::ManagedPointer<AbstractOptimizerNode> plan, OptimizationContext *context,
+      std::vector<common::ManagedPointer<parser::AbstractExpression>> *left_keys,
+      std::vector<common::ManagedPointer<parser::AbstractExpression>> *right_keys);
+};
+
 /**
  * Rule transforms Logical Left Join to LeftHashJoin
  */
@@ -19,6 +19,9 @@ namespace noisepage::optimizer {
  */
 class StatsCalculator : public OperatorVisitor {
  public:
+  /** Number of rows assumed for an input whose stats are missing */
+  static constexpr size_t DEFAULT_NUM_ROWS = 1000;
+
   /**
    * Calculates stats for a logical GroupExpression
    * @param gexpr GroupExpression
@@ -98,6 +101,17 @@ class StatsCalculator : public OperatorVisitor {
    */
   void Visit(const LogicalCreateIndex *op) override;
 
+  /**
+   * Return estimated cardinality for an inner or semi join. Every equality predicate between two columns is assumed
+   * to match each row of the larger input at most once. An input without derived stats counts as DEFAULT_NUM_ROWS.
+   * @param left_num_rows Number of rows of the left input
+   * @param right_num_rows Number of rows of the right input
+   * @param join_predicates conjunction join predicates
+   * @returns Estimated cardinality
+   */
+  static size_t EstimateCardinalityForJoin(size_t left_num_rows, size_t right_num_rows,
+                                           const std::vector<AnnotatedExpression> &join_predicates);
+
  private:
   /**
    * Return estimated cardinality for a filter
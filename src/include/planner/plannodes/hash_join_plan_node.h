@@ -47,6 +47,15 @@ class HashJoinPlanNode : public AbstractJoinPlanNode {
       return *this;
     }
 
+    /**
+     * @param flag whether a bloom filter over the build side should be pushed into the probe side
+     * @return builder object
+     */
+    Builder &SetBloomFilterPushdown(bool flag) {
+      bloom_filter_pushdown_ = flag;
+      return *this;
+    }
+
     // TODO(WAN) do we want to invalidate the builder after build?
     /**
      * Build the hash join plan node
@@ -63,6 +72,10 @@ class HashJoinPlanNode : public AbstractJoinPlanNode {
      * right side hash keys
      */
     std::vector<common::ManagedPointer<parser::AbstractExpression>> right_hash_keys_;
+    /**
+     * whether to push a bloom filter over the build side into the probe side
+     */
+    bool bloom_filter_pushdown_ = false;
   };
 
  private:
@@ -73,6 +86,7 @@ class HashJoinPlanNode : public AbstractJoinPlanNode {
    * @param predicate join predicate
    * @param left_hash_keys left side keys to be hashed on
    * @param right_hash_keys right side keys to be hashed on
+   * @param bloom_filter_pushdown whether to push a bloom filter over the build side into the probe side
    * @param plan_node_id Plan node id
    */
   HashJoinPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
@@ -80,7 +94,7 @@ class HashJoinPlanNode : public AbstractJoinPlanNode {
                    common::ManagedPointer<parser::AbstractExpression> predicate,
                    std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_hash_keys,
                    std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_hash_keys,
-                   plan_node_id_t plan_node_id);
+                   bool bloom_filter_pushdown, plan_node_id_t plan_node_id);
 
  public:
   /**
@@ -109,6 +123,11 @@ class HashJoinPlanNode : public AbstractJoinPlanNode {
     return right_hash_keys_;
   }
 
+  /**
+   * @return true if a bloom filter over the build side should be pushed into the probe side
+   */
+  bool IsBloomFilterPushdown() const { return bloom_filter_pushdown_; }
+
   /**
    * @return the hashed value of this plan node
    */
@@ -125,6 +144,9 @@ class HashJoinPlanNode : public AbstractJoinPlanNode {
   // The left and right expressions that constitute the join keys
   std::vector<common::ManagedPointer<parser::AbstractExpression>> left_hash_keys_;
   std::vector<common::ManagedPointer<parser::AbstractExpression>> right_hash_keys_;
+
+  // Whether the build side's bloom filter is pushed into the probe side
+  bool bloom_filter_pushdown_ = false;
 };
 
 DEFINE_JSON_HEADER_DECLARATIONS(HashJoinPlanNode);
@@ -44,6 +44,7 @@ enum class PlanNodeType {
   NESTLOOP,
   HASHJOIN,
   INDEXNLJOIN,
+  MERGEJOIN,
 
   // Mutator Nodes
   UPDATE,
@@ -25,6 +25,7 @@ class IndexJoinPlanNode;
 class IndexScanPlanNode;
 class InsertPlanNode;
 class LimitPlanNode;
+class MergeJoinPlanNode;
 class CteScanPlanNode;
 class NestedLoopJoinPlanNode;
 class OrderByPlanNode;
@@ -161,6 +162,12 @@ class PlanVisitor {
    */
   virtual void Visit(UNUSED_ATTRIBUTE const IndexJoinPlanNode *plan) {}
 
+  /**
+   * Visit a MergeJoinPlanNode
+   * @param plan MergeJoinPlanNode
+   */
+  virtual void Visit(UNUSED_ATTRIBUTE const MergeJoinPlanNode *plan) {}
+
   /**
    * Visit an IndexScanPlanNode
    * @param plan IndexScanPlanNode
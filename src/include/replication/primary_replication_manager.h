@@ -73,6 +73,9 @@ class PrimaryReplicationManager final : public ReplicationManager {
 
   void Handle(const messenger::ZmqMessage &zmq_msg, const TxnAppliedMsg &msg);
 
+  /** Send the message to every replica, in the format that each replica asked for. */
+  void SendToReplicas(const BaseReplicationMessage &msg);
+
   /**
    * Queue of batches of commit callbacks. Each batch is tagged with whether there are corresponding commit records.
    * Each item in the queue is a separate invocation of ReplicateBatchOfRecords() being recorded.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -88,6 +89,13 @@ class ReplicationManager {
   void Send(const std::string &destination, msg_id_t msg_id, const std::string &message,
             const messenger::CallbackFn &source_callback, messenger::callback_id_t destination_callback);
 
+  /**
+   * @param node_name                   The node that messages are being sent to.
+   * @return                            The format that the node asked for in the last message received from it, or
+   *                                    MSGPACK, which every node reads, if the node has not sent any message yet.
+   */
+  ReplicationMessageFormat GetNodeFormat(const std::string &node_name);
+
   /** The main event loop that all nodes run. This handles receiving messages. */
   virtual void EventLoop(common::ManagedPointer<messenger::Messenger> messenger, const messenger::ZmqMessage &zmq_msg,
                          common::ManagedPointer<BaseReplicationMessage> msg);
@@ -122,6 +130,10 @@ class ReplicationManager {
   uint16_t port_;                                           ///< The port that replication runs on.
 
   std::atomic<msg_id_t> next_msg_id_{1};  ///< ID of the next message being sent out.
+
+  /** Node name -> the format that the node asked to be sent. Updated whenever a message from the node arrives. */
+  std::unordered_map<std::string, ReplicationMessageFormat> node_formats_;
+  std::mutex node_formats_mutex_;  ///< Protecting node_formats_.
 };
 
 }  // namespace noisepage::replication
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "common/enum_defs.h"
+#include "common/error/exception.h"
 #include "common/json_header.h"
 #include "common/macros.h"
 #include "messenger/messenger_defs.h"
@@ -33,6 +37,86 @@ namespace noisepage::replication {
 ENUM_DEFINE(ReplicationMessageType, uint8_t, REPLICATION_MESSAGE_TYPE_ENUM);
 #undef REPLICATION_MESSAGE_TYPE_ENUM
 
+/**
+ * The wire formats that replication messages can be serialized to.
+ *
+ * Every BINARY message begins with a format version byte. Since a MSGPACK message always begins with a msgpack map
+ * header (a byte >= 0x80), the receiver can tell the two apart and decode whichever one it was sent.
+ *
+ * Which format a node is sent is up to that node: every message carries the format that its sender asks to be sent
+ * (see ReplicationMessageMetadata::GetRequestedFormat), and nodes that predate BINARY only ever get MSGPACK.
+ */
+enum class ReplicationMessageFormat : uint8_t {
+  MSGPACK,  ///< Self-describing msgpack encoding of the message's MessageWrapper.
+  BINARY    ///< Compact length-prefixed binary encoding.
+};
+
+/**
+ * Builds the BINARY wire format of a replication message.
+ *
+ * Fixed-width fields are copied in host byte order, which matches the log records that RecordsBatchMsg carries.
+ * Variable-length fields are prefixed by their length.
+ */
+class BinaryMessageWriter {
+ public:
+  /** @param size_hint The expected size of the message in bytes, used to allocate the output once. */
+  explicit BinaryMessageWriter(size_t size_hint) { buffer_.reserve(size_hint); }
+
+  /** Append a fixed-width value to the message. */
+  template <typename T>
+  void Write(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written.");
+    buffer_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  /** Append a length-prefixed byte string to the message. */
+  void WriteBytes(std::string_view bytes) {
+    Write(static_cast<uint32_t>(bytes.size()));
+    buffer_.append(bytes.data(), bytes.size());
+  }
+
+  /** @return The serialized message. The writer must not be used afterwards. */
+  std::string Finish() { return std::move(buffer_); }
+
+ private:
+  std::string buffer_;
+};
+
+/** Reads the BINARY wire format of a replication message. */
+class BinaryMessageReader {
+ public:
+  /** @param message The serialized message. It must outlive the reader. */
+  explicit BinaryMessageReader(std::string_view message) : message_(message) {}
+
+  /** @return The next fixed-width value in the message. */
+  template <typename T>
+  T Read() {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read.");
+    T value;
+    std::memcpy(&value, Advance(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  /** @return The next length-prefixed byte string in the message, pointing into the message. */
+  std::string_view ReadBytes() {
+    const auto size = Read<uint32_t>();
+    return std::string_view(Advance(size), size);
+  }
+
+ private:
+  const char *Advance(size_t size) {
+    if (message_.size() - offset_ < size) {
+      throw REPLICATION_EXCEPTION("Truncated replication message.");
+    }
+    const char *data = message_.data() + offset_;
+    offset_ += size;
+    return data;
+  }
+
+  std::string_view message_;
+  size_t offset_ = 0;
+};
+
 /** Abstraction over the underlying format used to send replication messages over the network */
 class MessageWrapper {
  public:
@@ -55,6 +139,12 @@ class MessageWrapper {
   template <typename T>
   void Put(const char *key, T value);
 
+  /**
+   * @param key key of value
+   * @return true if the message has a value with the specified key
+   */
+  bool Contains(const char *key) const;
+
   /**
    * Get a value from the message with specific key
    *
@@ -93,20 +183,38 @@ DEFINE_JSON_HEADER_DECLARATIONS(MessageWrapper);
 /** ReplicationMessageMetadata contains all of the metadata that every type of BaseReplicationMessage should contain. */
 class ReplicationMessageMetadata {
  public:
-  /** Constructor (to send). */
+  /** Constructor (to send). The message asks its receiver for this node's PREFERRED_FORMAT. */
   explicit ReplicationMessageMetadata(msg_id_t msg_id);
+  /** Constructor (to send), asking the receiver for a specific format. */
+  ReplicationMessageMetadata(msg_id_t msg_id, ReplicationMessageFormat requested_format);
   /** Constructor (to receive). */
   explicit ReplicationMessageMetadata(const MessageWrapper &message);
+  /** Constructor (to receive, BINARY format). */
+  explicit ReplicationMessageMetadata(BinaryMessageReader *reader);
 
   /** @return     The MessageWrapper form of this metadata. */
   MessageWrapper ToMessageWrapper() const;
 
+  /** Append the BINARY form of this metadata to the writer. */
+  void ToBinary(BinaryMessageWriter *writer) const;
+
   /** @return     The ID of the message. */
   msg_id_t GetMessageId() const { return msg_id_; }
 
+  /** @return     The format that the sender of the message asks to be sent. MSGPACK if the sender predates BINARY. */
+  ReplicationMessageFormat GetRequestedFormat() const { return requested_format_; }
+
+  /** The format that this node asks other nodes to send it. */
+  static constexpr ReplicationMessageFormat PREFERRED_FORMAT = ReplicationMessageFormat::BINARY;
+
  private:
-  static const char *key_message_id;  ///< JSON key for the message ID.
-  msg_id_t msg_id_;                   ///< The ID of this message.
+  /** @return     The format for a requested format read off the wire. */
+  static ReplicationMessageFormat ToRequestedFormat(uint8_t requested_format);
+
+  static const char *key_message_id;           ///< JSON key for the message ID.
+  static const char *key_requested_format;     ///< JSON key for the requested format.
+  msg_id_t msg_id_;                            ///< The ID of this message.
+  ReplicationMessageFormat requested_format_;  ///< The format that the sender of this message asks to be sent.
 };
 
 /** Base class for all replicated messages. */
@@ -118,8 +226,11 @@ class BaseReplicationMessage {
   /** @return     The type of replication message that this is. */
   virtual ReplicationMessageType GetMessageType() const { return type_; }
 
-  /** @return     Serialized form of this message. */
-  std::string Serialize() const;
+  /**
+   * @param format  The wire format to serialize to. MSGPACK is only needed to talk to nodes that predate BINARY.
+   * @return        Serialized form of this message.
+   */
+  std::string Serialize(ReplicationMessageFormat format = ReplicationMessageFormat::BINARY) const;
 
   /** @return     The parsed replication message. */
   static std::unique_ptr<BaseReplicationMessage> ParseFromString(std::string_view str);
@@ -135,10 +246,26 @@ class BaseReplicationMessage {
   explicit BaseReplicationMessage(ReplicationMessageType type, ReplicationMessageMetadata metadata);
   /** Constructor (to receive). */
   explicit BaseReplicationMessage(const MessageWrapper &message);
+  /** Constructor (to receive, BINARY format). The reader is positioned after the message type. */
+  BaseReplicationMessage(ReplicationMessageType type, BinaryMessageReader *reader);
   /** Converts message into MessageWrapper form */
   virtual MessageWrapper ToMessageWrapper() const;
+  /** Append the BINARY form of this message, excluding the version and message type, to the writer. */
+  virtual void ToBinary(BinaryMessageWriter *writer) const;
+  /** @return     The expected size of the BINARY form of this message. */
+  virtual size_t BinarySizeHint() const { return BINARY_HEADER_SIZE_HINT; }
+
+  /** Upper bound on the size of the BINARY form of a message without any variable-length fields. */
+  static constexpr size_t BINARY_HEADER_SIZE_HINT = 64;
 
  private:
+  /**
+   * The version of the BINARY format that this node writes. A node can read every version up to and including
+   * its own, so a newer node can keep talking to older ones by not bumping the format it writes until all of them
+   * have been upgraded.
+   */
+  static constexpr uint8_t BINARY_FORMAT_VERSION = 1;
+
   static const char *key_message_type;  ///< JSON key for the message type.
   static const char *key_metadata;      ///< JSON key for the message metadata.
 
@@ -163,6 +290,8 @@ class NotifyOATMsg : public BaseReplicationMessage {
                transaction::timestamp_t oldest_active_txn);
   /** Constructor (to receive). */
   explicit NotifyOATMsg(const MessageWrapper &message);
+  /** Constructor (to receive, BINARY format). */
+  explicit NotifyOATMsg(BinaryMessageReader *reader);
   /** Destructor. */
   ~NotifyOATMsg() override = default;
 
@@ -176,6 +305,7 @@ class NotifyOATMsg : public BaseReplicationMessage {
 
  protected:
   MessageWrapper ToMessageWrapper() const override;
+  void ToBinary(BinaryMessageWriter *writer) const override;
 
  private:
   static const char *key_batch_id;           ///< JSON key for the batch ID.
@@ -196,11 +326,14 @@ class RecordsBatchMsg : public BaseReplicationMessage {
    *
    * @param metadata            The metadata of the message.
    * @param batch_id            The ID for this batch of log records.
-   * @param buffer              The contents of this batch of log records.
+   * @param buffer              The contents of this batch of log records. The contents are not copied, so the
+   *                            buffer must not be reused while this message is alive.
    */
   RecordsBatchMsg(ReplicationMessageMetadata metadata, record_batch_id_t batch_id, storage::BufferedLogWriter *buffer);
   /** Constructor (to receive). */
   explicit RecordsBatchMsg(const MessageWrapper &message);
+  /** Constructor (to receive, BINARY format). */
+  explicit RecordsBatchMsg(BinaryMessageReader *reader);
   /** Destructor. */
   ~RecordsBatchMsg() override = default;
 
@@ -210,7 +343,13 @@ class RecordsBatchMsg : public BaseReplicationMessage {
   record_batch_id_t GetBatchId() const { return batch_id_; }
 
   /** @return The contents of this batch of log records. */
-  std::string GetContents() const { return contents_; }
+  std::string_view GetContents() const;
+
+  /**
+   * @return True if the contents are a block of a compressed WAL (see storage::LogBlockHeader), false if they are the
+   *         log records as they were serialized.
+   */
+  bool IsCompressed() const;
 
   /** @return The batch ID that should appear after the given batch ID. */
   static record_batch_id_t NextBatchId(record_batch_id_t batch_id) {
@@ -222,13 +361,18 @@ class RecordsBatchMsg : public BaseReplicationMessage {
 
  protected:
   MessageWrapper ToMessageWrapper() const override;
+  void ToBinary(BinaryMessageWriter *writer) const override;
+  size_t BinarySizeHint() const override;
 
  private:
   static const char *key_batch_id;  ///< JSON key for the batch ID.
-  static const char *key_contents;  ///< JSON key for the contents.
+  static const char *key_contents;    ///< JSON key for the contents.
+  static const char *key_compressed;  ///< JSON key for whether the contents are compressed.
 
   record_batch_id_t batch_id_;  ///< The batch ID identifies the order of records sent by the remote origin.
-  std::string contents_;        ///< The actual contents of the buffer.
+  std::string contents_;        ///< The actual contents of the buffer, if this message was received.
+  bool compressed_;             ///< True if the contents are a block, if this message was received.
+  const storage::BufferedLogWriter *buffer_;  ///< The buffer holding the contents, if this message is being sent.
 };
 
 /** TxnAppliedMsg is sent from replica -> primary, indicating that a given transaction has been successfully applied. */
@@ -238,6 +382,8 @@ class TxnAppliedMsg : public BaseReplicationMessage {
   explicit TxnAppliedMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t applied_txn_id);
   /** Constructor (to receive). */
   explicit TxnAppliedMsg(const MessageWrapper &message);
+  /** Constructor (to receive, BINARY format). */
+  explicit TxnAppliedMsg(BinaryMessageReader *reader);
   /** Destructor. */
   ~TxnAppliedMsg() override = default;
 
@@ -248,6 +394,7 @@ class TxnAppliedMsg : public BaseReplicationMessage {
 
  protected:
   MessageWrapper ToMessageWrapper() const override;
+  void ToBinary(BinaryMessageWriter *writer) const override;
 
  private:
   static const char *key_applied_txn_id;     ///< JSON key for the applied transaction ID.
@@ -96,6 +96,14 @@ class Callbacks {
   static void MetricsQueryTraceOutput(void *old_value, void *new_value, DBMain *db_main,
                                       common::ManagedPointer<common::ActionContext> action_context);
 
+  /** Update the cost model used by the optimizer in TrafficCop */
+  static void OptimizerCostModel(void *old_value, void *new_value, DBMain *db_main,
+                                 common::ManagedPointer<common::ActionContext> action_context);
+
+  /** Update the join enumeration threshold used by the optimizer in TrafficCop */
+  static void OptimizerJoinEnumerationThreshold(void *old_value, void *new_value, DBMain *db_main,
+                                                common::ManagedPointer<common::ActionContext> action_context);
+
   /** Update the query execution mode in TrafficCop */
   static void CompiledQueryExecution(void *old_value, void *new_value, DBMain *db_main,
                                      common::ManagedPointer<common::ActionContext> action_context);
@@ -97,6 +97,18 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Number of garbage collector workers
+SETTING_int(
+    gc_num_workers,
+    "Number of threads that truncate version chains and collect indexes on every garbage collector invocation, "
+    "including the garbage collector thread (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Write ahead logging
 SETTING_bool(
     wal_enable,
@@ -172,6 +184,39 @@ SETTING_int(task_execution_timeout,
             "assuming one plan has been found (default 5000)",
             5000, 1000, 60000, false, noisepage::settings::Callbacks::NoOp)
 
+// Optimizer cost model
+SETTING_string(
+    optimizer_cost_model,
+    "Cost model used by the optimizer to choose between plans (default: TRIVIAL, values: TRIVIAL, COST_BASED)",
+    "TRIVIAL",
+    true,
+    noisepage::settings::Callbacks::OptimizerCostModel
+)
+
+// Optimizer join enumeration
+SETTING_int(
+    optimizer_join_enumeration_threshold,
+    "Maximum number of relations in a join tree whose join orders are enumerated exhaustively, "
+    "larger join trees are ordered greedily (default: 10)",
+    10,
+    2,
+    64,
+    true,
+    noisepage::settings::Callbacks::OptimizerJoinEnumerationThreshold
+)
+
+// Optimizer threads
+SETTING_int(
+    optimizer_threads,
+    "Number of threads to optimize independent groups of a query on, including the connection thread. The "
+    "threads besides the connection thread are shared by all connections (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Parallel Execution
 SETTING_bool(
     parallel_execution,
@@ -192,6 +237,41 @@ SETTING_int64(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Number of WAL partitions
+SETTING_int(
+    wal_num_partitions,
+    "Number of partitions of the WAL, each serialized and written to its own log file by its own threads. Replication "
+    "requires a single partition (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// WAL compression codec
+SETTING_string(
+    wal_compression,
+    "Codec that every buffer of the WAL of this instance, across all databases, is compressed with before it is "
+    "written to the log file or shipped to replicas. Readers detect compressed log files and batches on their own, but "
+    "a log file must be sealed before the codec is changed (default: NONE, values: NONE, LZ)",
+    "NONE",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Group commit target fsync rate
+SETTING_int(
+    wal_group_commit_target_iops,
+    "Target number of log file persists per second. When set, the log file is persisted as soon as a committing txn is "
+    "waiting and the target rate allows it, instead of on the persist interval (default: 0, disabled)",
+    0,
+    0,
+    1000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_int(
     extra_float_digits,
     "Sets the number of digits displayed for floating-point values. (default : 1)",
@@ -448,6 +528,24 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_int64(
+    query_memory_budget,
+    "Bytes of memory a single query may allocate before its operators spill to disk, 0 for no limit (default: 0)",
+    0,
+    0,
+    (1LL << 40) /* 1TB */,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_string(
+    spill_file_directory,
+    "The directory where queries exceeding their memory budget write temporary spill files (default: /tmp/)",
+    "/tmp/",
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     counters_enable,
     "Whether to use counters (default: false)",
@@ -500,6 +598,47 @@ SETTING_string(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Number of workers that replay non-conflicting transactions in parallel on replicas
+SETTING_int(
+    recovery_replay_threads,
+    "The number of workers replaying non-conflicting transactions in parallel during recovery, 0 to replay serially "
+    "(default: 0)",
+    0,
+    0,
+    256,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Periodic checkpoints of all user tables
+SETTING_bool(
+    checkpoint_enable,
+    "Whether to periodically checkpoint all user tables, and truncate the WAL after each checkpoint (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Path to the checkpoint file
+SETTING_string(
+    checkpoint_file_path,
+    "The path to the checkpoint file (default: checkpoint)",
+    "checkpoint",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Checkpoint interval
+SETTING_int(
+    checkpoint_interval,
+    "Time between two checkpoints (s) (default: 300)",
+    300,
+    1,
+    86400,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     model_server_enable,
     "Whether to enable the ModelServerManager (default: false)",
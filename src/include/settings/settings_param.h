@@ -31,6 +31,8 @@ void InitializeRunnersState();
 
 namespace noisepage::settings {
 
+class SettingsTests;
+
 using callback_fn = void (*)(void *, void *, DBMain *, common::ManagedPointer<common::ActionContext> action_context);
 
 /**
@@ -91,6 +93,7 @@ class ParamInfo {
   friend class selfdriving::pilot::test::GenerateChangeKnobAction_GenerateAction_Test;
   friend class selfdriving::pilot::test::QueryTraceLogging;
   friend class task::test::TaskManagerTests;
+  friend class SettingsTests;
   std::string name_;
   parser::ConstantValueExpression value_;
   std::string desc_;
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "common/macros.h"
+
+namespace noisepage::storage {
+
+/**
+ * Tracks whether every tuple in a block is visible to all running and future transactions, in which case a tuple
+ * matches the index entries that point to it and index-only scans can return the key columns from the index without
+ * reading the tuple.
+ *
+ * A block is all-visible once none of its tuples has a version chain and the deferred index deletes of the unlinked
+ * versions have run. The block counts its version chains: writers count a chain when they install the first version
+ * of a tuple, and the GC uncounts it when it truncates the whole chain. Writers clear the bit after they install a
+ * version, but before they change the tuple or any index. The GC marks a block in two steps: it flags the block as
+ * pending under a fresh generation before it reads the chain count, and registers a deferred action that sets the
+ * bit. Deferred actions run in the
+ * order they were registered, so the index deletes of the versions the GC just unlinked are done by the time the bit
+ * is set. A writer that touches the block in the meantime clears the pending flag, and a later mark of the block uses
+ * a new generation, so that an outdated deferred action cannot set the bit.
+ */
+class BlockVisibility {
+ public:
+  /**
+   * Initialize the visibility of a new block, which is not all-visible until the GC has seen it.
+   */
+  void Initialize() {
+    word_.store(0);
+    num_version_chains_.store(0);
+  }
+
+  /** @return whether every tuple in the block is visible to all transactions */
+  bool AllVisible() const { return (word_.load() & ALL_VISIBLE) != 0; }
+
+  /**
+   * Clear the all-visible bit and any pending mark. Writers call this after they install a version in the block.
+   */
+  void Clear() {
+    // Blocks under write are rarely marked, so only write the word if there is something to clear
+    uint64_t word = word_.load();
+    while ((word & FLAGS) != 0 && !word_.compare_exchange_weak(word, word & ~FLAGS)) {
+    }
+  }
+
+  /**
+   * Count a new version chain in the block. Writers call this before Clear, after they install a version into a tuple
+   * that had no version chain.
+   */
+  void AddVersionChain() { num_version_chains_.fetch_add(1); }
+
+  /**
+   * Uncount a version chain of the block, after the GC truncated all of it.
+   */
+  void RemoveVersionChain() {
+    NOISEPAGE_ASSERT(num_version_chains_.load() > 0, "Removed more version chains than were added");
+    num_version_chains_.fetch_sub(1);
+  }
+
+  /** @return whether any tuple in the block has a version chain */
+  bool HasVersionChains() const { return num_version_chains_.load() != 0; }
+
+  /**
+   * Start marking the block all-visible. The caller must check HasVersionChains after this call,
+   * and either finish or cancel the mark.
+   * @param[out] mark identifies the mark to FinishMark or CancelMark
+   * @return false if the block is all-visible or a mark is pending already, true otherwise
+   */
+  bool BeginMark(uint64_t *const mark) {
+    uint64_t word = word_.load();
+    do {
+      if ((word & FLAGS) != 0) return false;
+      *mark = ((word & ~FLAGS) + GENERATION_INCREMENT) | PENDING;
+    } while (!word_.compare_exchange_weak(word, *mark));
+    return true;
+  }
+
+  /**
+   * Set the all-visible bit, unless a writer touched the block since the mark began.
+   * @param mark the mark returned by BeginMark
+   * @return true if the block is now all-visible, false otherwise
+   */
+  bool FinishMark(uint64_t mark) { return word_.compare_exchange_strong(mark, (mark & ~PENDING) | ALL_VISIBLE); }
+
+  /**
+   * Give up marking the block, because the block has a version chain.
+   * @param mark the mark returned by BeginMark
+   */
+  void CancelMark(uint64_t mark) { word_.compare_exchange_strong(mark, mark & ~PENDING); }
+
+ private:
+  static constexpr uint64_t ALL_VISIBLE = 1;
+  static constexpr uint64_t PENDING = 1 << 1;
+  static constexpr uint64_t FLAGS = ALL_VISIBLE | PENDING;
+  // The rest of the word counts the marks of the block
+  static constexpr uint64_t GENERATION_INCREMENT = 1 << 2;
+
+  std::atomic<uint64_t> word_;
+  // Number of tuples in the block with a version chain
+  std::atomic<uint32_t> num_version_chains_;
+};
+
+}  // namespace noisepage::storage
@@ -47,6 +47,12 @@ class DataTable {
    */
   class SlotIterator {
    public:
+    /**
+     * Decides from the block header alone whether a block may hold tuples the scan is interested in.
+     * The first argument is the opaque context given to SetBlockFilter(), the second argument is the block.
+     */
+    using BlockFilter = bool (*)(const void *, RawBlock *);
+
     /**
      * @return reference to the underlying tuple slot
      */
@@ -99,6 +105,21 @@ class DataTable {
      */
     bool operator!=(const SlotIterator &other) const { return !this->operator==(other); }
 
+    /**
+     * Skip the blocks rejected by the given filter from now on. The block the iterator is on is skipped as well if the
+     * iterator has not moved into it yet.
+     * @param filter the filter to check every block with before iterating over it
+     * @param context opaque context passed to the filter
+     */
+    void SetBlockFilter(BlockFilter filter, const void *context) {
+      block_filter_ = filter;
+      block_filter_context_ = context;
+      if (slot_num_ == 0 && current_slot_.GetBlock() != nullptr && !block_filter_(context, current_slot_.GetBlock())) {
+        block_index_++;
+        UpdateFromNextBlock();
+      }
+    }
+
    private:
     friend class DataTable;
 
@@ -130,7 +151,7 @@ class DataTable {
         max_slot_num_ = b->GetInsertHead();
         current_slot_ = {b, slot_num_};
 
-        if (max_slot_num_ != 0) return;
+        if (max_slot_num_ != 0 && (block_filter_ == nullptr || block_filter_(block_filter_context_, b))) return;
         block_index_++;
       }
     }
@@ -140,6 +161,8 @@ class DataTable {
     uint64_t block_index_ = 0, end_index_ = 0;
     TupleSlot current_slot_ = InvalidTupleSlot();
     uint32_t slot_num_ = 0, max_slot_num_ = 0;
+    BlockFilter block_filter_ = nullptr;
+    const void *block_filter_context_ = nullptr;
   };
   /**
    * Constructs a new DataTable with the given layout, using the given BlockStore as the source
@@ -280,6 +303,13 @@ class DataTable {
     return std::vector<RawBlock *>(blocks_.begin(), blocks_.end());
   }
 
+  /**
+   * @param block block of this DataTable
+   * @param col_id id of a fixed-length column
+   * @return the zone map of the column on the given block
+   */
+  const ZoneMap &GetZoneMap(RawBlock *block, col_id_t col_id) const { return accessor_.GetZoneMap(block, col_id); }
+
   /**
    * @return read-only view of this DataTable's BlockLayout
    */
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/shared_latch.h"
 #include "storage/storage_defs.h"
@@ -31,6 +36,13 @@ class Index;
  * Based on the contents of this queue, it unlinks the UndoRecords from their version chains when no running
  * transactions can view those versions anymore. It then stores those transactions to attempt to deallocate on the next
  * iteration if no running transactions can still hold references to them.
+ *
+ * The GC can spread its work over several workers. The version chains to truncate are partitioned by tuple slot, so
+ * that every chain is only ever traversed by one worker, and the registered indexes are collected in parallel.
+ * Reclaiming slots and varlens, and processing deferred actions, stays on the calling thread.
+ *
+ * Once the version chains of a block are gone, the GC marks the block all-visible (see BlockVisibility), which lets
+ * index-only scans skip reading its tuples.
  */
 class GarbageCollector {
  public:
@@ -44,12 +56,15 @@ class GarbageCollector {
    *                 it is not null. The observer can then gain insight invoke other components to perform actions.
    *                 The observer's function implementation needs to be lightweight because it is called on the GC
    *                 thread.
+   * @param num_workers number of threads that truncate version chains and collect indexes, including the thread that
+   *                    invokes the GC. With a single worker the GC runs entirely on the calling thread.
    */
   // TODO(Tianyu): Eventually the GC will be re-written to be purely on the deferred action manager. which will
   //  eliminate this perceived redundancy of taking in a transaction manager.
   GarbageCollector(common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
                    common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer);
+                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+                   uint32_t num_workers = 1);
 
   ~GarbageCollector() {
     NOISEPAGE_ASSERT(txns_to_deallocate_.empty(), "Not all txns have been deallocated");
@@ -86,6 +101,21 @@ class GarbageCollector {
    */
   void SetGCInterval(uint64_t gc_interval) { gc_interval_ = gc_interval; }
 
+  /**
+   * @return number of threads that truncate version chains and collect indexes
+   */
+  uint32_t GetNumWorkers() const { return num_workers_; }
+
+  /**
+   * @return number of transactions that were not yet safe to unlink on the last GC invocation
+   */
+  uint32_t GetUnlinkBacklog() const { return unlink_backlog_; }
+
+  /**
+   * @return number of unlinked transactions that are waiting to be deallocated
+   */
+  uint32_t GetDeallocateBacklog() const { return deallocate_backlog_; }
+
  private:
   /**
    * Process the deallocate queue
@@ -113,8 +143,33 @@ class GarbageCollector {
 
   void TruncateVersionChain(DataTable *table, TupleSlot slot, transaction::timestamp_t oldest) const;
 
+  /**
+   * Truncate the version chains of the given tuples, each partition on its own worker
+   * @param partitions tuples to truncate, partitioned by slot
+   * @param oldest start time of the oldest running transaction
+   */
+  void TruncateVersionChains(const std::vector<std::vector<std::pair<DataTable *, TupleSlot>>> &partitions,
+                             transaction::timestamp_t oldest);
+
+  /**
+   * Start marking the blocks of the given tuples all-visible, if they have no version chains left. The marks are
+   * finished by deferred actions, which run after the index deletes of the versions unlinked in this GC invocation.
+   * @param partitions tuples whose version chains were truncated, partitioned by slot
+   */
+  void MarkBlocksAllVisible(const std::vector<std::vector<std::pair<DataTable *, TupleSlot>>> &partitions);
+
   void ProcessIndexes();
 
+  // Invoke f on every index in [0, n), spread over the workers if the GC has more than one
+  template <typename F>
+  void ForEachOnWorkers(const std::size_t n, const F &f) {
+    if (workers_ == nullptr) {
+      for (std::size_t i = 0; i < n; i++) f(i);
+      return;
+    }
+    workers_->execute([&] { tbb::parallel_for(std::size_t{0}, n, f); });
+  }
+
   const common::ManagedPointer<transaction::TimestampManager> timestamp_manager_;
   const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager_;
   const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
@@ -125,11 +180,18 @@ class GarbageCollector {
   transaction::TransactionQueue txns_to_deallocate_;
   // queue of txns that need to be unlinked
   transaction::TransactionQueue txns_to_unlink_;
+  // lengths of the two queues above, reported to the metrics as the backlog of the GC
+  uint32_t unlink_backlog_ = 0;
+  uint32_t deallocate_backlog_ = 0;
 
   std::unordered_set<common::ManagedPointer<index::Index>> indexes_;
   common::SharedLatch indexes_latch_;
 
   uint64_t gc_interval_{0};
+
+  const uint32_t num_workers_;
+  // Arena of the workers, or nullptr if the GC runs on the calling thread
+  std::unique_ptr<tbb::task_arena> workers_;
 };
 
 }  // namespace noisepage::storage
@@ -1,16 +1,23 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <numeric>
 #include <queue>
 #include <set>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/shared_latch.h"
+#include "common/spin_latch.h"
+#include "execution/util/execution_common.h"
+#include "execution/util/memory.h"
 #include "loggers/index_logger.h"
 #include "storage/index/index.h"
 #include "storage/index/index_defs.h"
@@ -39,6 +46,10 @@ class BPlusTreeBase {
    * @return leaf_node_size_lower_threshold
    */
   int GetLeafNodeSizeLowerThreshold() const { return leaf_node_size_lower_threshold_; }
+  /**
+   * @return percentage of each node that bulk loading fills
+   */
+  int GetBulkLoadFillFactor() const { return bulk_load_fill_factor_; }
 
  public:
   /**
@@ -69,6 +80,11 @@ class BPlusTreeBase {
     leaf_node_size_lower_threshold_ = leaf_node_size_lower_threshold;
   }
 
+  /**
+   * @param bulk_load_fill_factor percentage of each node that bulk loading fills, leaving the rest for later inserts
+   */
+  void SetBulkLoadFillFactor(int bulk_load_fill_factor) { bulk_load_fill_factor_ = bulk_load_fill_factor; }
+
  protected:
   /** upper size threshold for inner node split [FAN_OUT] */
   int inner_node_size_upper_threshold_ = DEFAULT_INNER_NODE_SIZE_UPPER_THRESHOLD;
@@ -80,11 +96,90 @@ class BPlusTreeBase {
   /** lower size threshold for leaf node removal [Ceil((FAN_OUT - 1) / 2)] */
   int leaf_node_size_lower_threshold_ = 64;
 
+  /** percentage of each node that bulk loading fills */
+  int bulk_load_fill_factor_ = DEFAULT_BULK_LOAD_FILL_FACTOR;
+
  public:
   /** upper size threshold for inner node split [FAN_OUT] */
   static int constexpr DEFAULT_INNER_NODE_SIZE_UPPER_THRESHOLD = 128;
   /** lower size threshold for inner node removal [Ceil(FAN_OUT / 2) - 1] */
   static int constexpr DEFAULT_INNER_NODE_SIZE_LOWER_THRESHOLD = 63;
+  /** percentage of each node that bulk loading fills, leaves room for a few inserts before nodes split */
+  static int constexpr DEFAULT_BULK_LOAD_FILL_FACTOR = 90;
+
+  /**
+   * Latch of a node, and of the root pointer, that also counts how often it was acquired exclusively. The version is
+   * odd while a writer holds the latch. Optimistic readers do not latch inner nodes, they read the version before and
+   * after looking at a node, and start over if it changed.
+   */
+  class NodeLatch {
+   public:
+    /**
+     * Acquire the latch exclusively, readers that validate against an older version from now on fail
+     */
+    void LockExclusive() {
+      latch_.LockExclusive();
+      version_.fetch_add(1);
+    }
+
+    /**
+     * Try to acquire the latch exclusively
+     * @return true if the latch was acquired
+     */
+    bool TryExclusiveLock() {
+      if (!latch_.TryExclusiveLock()) return false;
+      version_.fetch_add(1);
+      return true;
+    }
+
+    /**
+     * Release the exclusive latch
+     */
+    void UnlockExclusive() {
+      version_.fetch_add(1);
+      latch_.UnlockExclusive();
+    }
+
+    /**
+     * Acquire the latch in shared mode, this does not change the version
+     */
+    void LockShared() { latch_.LockShared(); }
+
+    /**
+     * Try to acquire the latch in shared mode
+     * @return true if the latch was acquired
+     */
+    bool TryLockShared() { return latch_.TryLockShared(); }
+
+    /**
+     * Release the shared latch
+     */
+    void UnlockShared() { latch_.UnlockShared(); }
+
+    /**
+     * Start an optimistic read of what the latch protects
+     * @param[out] version version to validate the read against
+     * @return false if a writer holds the latch, in which case the read has to start over
+     */
+    bool ReadVersion(uint64_t *version) const {
+      *version = version_.load();
+      return (*version & 1) == 0;
+    }
+
+    /**
+     * Finish an optimistic read, everything read since ReadVersion is only valid if this succeeds
+     * @param version version returned by ReadVersion
+     * @return true if no writer acquired the latch since the version was read
+     */
+    bool Validate(uint64_t version) const {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return version_.load(std::memory_order_relaxed) == version;
+    }
+
+   private:
+    common::SharedLatch latch_;
+    std::atomic<uint64_t> version_{0};
+  };
 
   /**
    * Constructor
@@ -110,10 +205,14 @@ class BPlusTreeBase {
  *  top to bottom. Thus, before accessing a child node pointer, it is ensured that the pointer cannot be
  *  deleted no matter what (the parent latch is also being held at that point).
  *
- * Optimistic latch crabbing is used to acquire node latches for reads and writes.
+ * Optimistic latch crabbing is used to acquire node latches for writes, reads use optimistic lock coupling.
  *  Read:
- *    Acquire latches starting from root, in the path to find the key. Release shared latch of parent
- *    once the latch on current node is obtained and so on...
+ *    Inner nodes are not latched. Every latch carries a version that writers bump when they acquire and release it
+ *    exclusively. A reader remembers the version of a node, picks the child, and checks that the version did not
+ *    change before it moves on, otherwise it starts over from the root. Leaves are latched in shared mode, since their
+ *    value lists are changed in place. Nodes that writers unlink are only freed once no reader that might still look
+ *    at them is left (epoch based reclamation). SetOptimisticReads(false) goes back to latching every node from the
+ *    root latch down.
  *
  *  Write:
  *    Happens in 2 phases:
@@ -223,7 +322,7 @@ class BPlusTree : public BPlusTreeBase {
     int item_count_;
 
     /** Latch for each node */
-    common::SharedLatch node_latch_;
+    NodeLatch node_latch_;
 
     /**
      * Constructor
@@ -334,7 +433,7 @@ class BPlusTree : public BPlusTreeBase {
     /**
      * GetLatchPointer() - Get the Latch Pointer of current node's latch
      */
-    common::SharedLatch *GetLatchPointer() { return &(metadata_.node_latch_); }
+    NodeLatch *GetLatchPointer() { return &(metadata_.node_latch_); }
 
     /**
      * TryExclusiveLock() - Try to get the exclusive lock
@@ -346,6 +445,16 @@ class BPlusTree : public BPlusTreeBase {
      */
     bool TrySharedLock() { return metadata_.node_latch_.TryLockShared(); }
 
+    /**
+     * ReadVersion() - Start an optimistic read of the current node
+     */
+    bool ReadVersion(uint64_t *version) const { return metadata_.node_latch_.ReadVersion(version); }
+
+    /**
+     * ValidateVersion() - Check that the current node did not change since its version was read
+     */
+    bool ValidateVersion(uint64_t version) const { return metadata_.node_latch_.Validate(version); }
+
     /**
      * SetLowKeyPair() - Sets the low key pair of metadata
      */
@@ -748,21 +857,104 @@ class BPlusTree : public BPlusTreeBase {
   const ValueEqualityChecker value_eq_obj_;
 
  private:
-  BaseNode *root_;
-  common::SharedLatch root_latch_;
+  /** Number of slots optimistic readers announce themselves in, threads share a slot if there are more of them */
+  static constexpr uint32_t NUM_READER_SLOTS = 32;
+
+  /** Number of optimistic readers of a slot that entered the tree during an even and an odd epoch */
+  struct alignas(common::Constants::CACHELINE_SIZE) ReaderSlot {
+    std::atomic<uint64_t> readers_[2]{};
+  };
+
+  /**
+   * Announces an optimistic reader for as long as it lives, nodes unlinked from the tree in the meantime are not freed
+   */
+  class EpochGuard {
+   public:
+    explicit EpochGuard(BPlusTree *tree)
+        : slot_(&tree->reader_slots_[ReaderSlotOfThread()]), parity_(tree->epoch_.load() & 1) {
+      slot_->readers_[parity_].fetch_add(1);
+    }
+
+    ~EpochGuard() { slot_->readers_[parity_].fetch_sub(1); }
+
+    DISALLOW_COPY_AND_MOVE(EpochGuard)
+
+   private:
+    ReaderSlot *const slot_;
+    const uint64_t parity_;
+  };
+
+  std::atomic<BaseNode *> root_;
+  NodeLatch root_latch_;
   std::atomic_uint64_t num_keys_;
   std::atomic_uint64_t num_values_;
 
- public:
+  bool optimistic_reads_ = true;
+  // On the heap, so that the alignment of the slots does not carry over to the tree
+  std::vector<ReaderSlot> reader_slots_;
+  std::atomic<uint64_t> epoch_{0};
+  common::SpinLatch retire_latch_;
+  std::vector<BaseNode *> retired_nodes_[2];
+
   /**
-   * This function returns the pointer to the First Leaf Node (node containing the
-   * smallest key)
+   * @return slot of the calling thread, threads are spread over the slots round robin
+   */
+  static uint32_t ReaderSlotOfThread() {
+    static std::atomic<uint32_t> next_slot{0};
+    thread_local const uint32_t slot = next_slot.fetch_add(1) % NUM_READER_SLOTS;
+    return slot;
+  }
+
+  /**
+   * Frees nodes without looking at the value lists of leaves, they belong to the nodes the elements were merged into
+   * @param nodes nodes to free, empty on return
+   */
+  void FreeNodes(std::vector<BaseNode *> *nodes) {
+    for (BaseNode *node : *nodes) {
+      if (node->GetType() != NodeType::LeafType) {
+        reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(node)->FreeElasticNode();
+      } else {
+        reinterpret_cast<ElasticNode<KeyValuePair> *>(node)->FreeElasticNode();
+      }
+    }
+    nodes->clear();
+  }
+
+  /**
+   * Frees a node that was unlinked from the tree once no optimistic reader can reach it anymore.
+   *
+   * Nodes are retired into the list of the current epoch. The epoch only advances once all readers that entered
+   * during the previous epoch have left, and then frees the nodes retired during the previous epoch: every reader
+   * that could have seen them entered during that epoch or the one before, and has left by then.
+   *
+   * NOTE: The node must not be latched anymore
+   *
+   * @param node node to free
+   */
+  void RetireNode(BaseNode *node) {
+    common::SpinLatch::ScopedSpinLatch guard(&retire_latch_);
+    const uint64_t epoch = epoch_.load();
+    retired_nodes_[epoch & 1].push_back(node);
+
+    // Readers that did not announce themselves yet must see that the node was unlinked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (const auto &slot : reader_slots_) {
+      if (slot.readers_[(epoch - 1) & 1].load() != 0) return;
+    }
+    FreeNodes(&retired_nodes_[(epoch - 1) & 1]);
+    epoch_.store(epoch + 1);
+  }
+
+  /**
+   * Descends from the root to a leaf while holding a shared latch on at most two nodes at a time
    *
    * NOTE: Upon return, shared latch will be held on the corresponding leaf node.
    *
+   * @param child_of picks the child of an inner node to descend into
    * @return Pointer to LeafNode if tree is not empty, nullptr otherwise
    */
-  BaseNode *FindLeafNode() {
+  template <typename ChildOf>
+  BaseNode *FindLeafNodeLatched(ChildOf child_of) {
     root_latch_.LockShared();
 
     if (root_ == nullptr) {
@@ -781,7 +973,7 @@ class BPlusTree : public BPlusTreeBase {
     while (current_node->GetType() != NodeType::LeafType) {
       // Set parent for releasing the lock
       parent = current_node;
-      current_node = current_node->GetLowKeyPair().second;
+      current_node = child_of(reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(current_node));
 
       // Get shared latch on current node, and release the parent.
       current_node->GetNodeSharedLatch();
@@ -792,50 +984,132 @@ class BPlusTree : public BPlusTreeBase {
   }
 
   /**
-   * This function returns the pointer to the leaf node containing a particular key.
+   * Descends from the root to a leaf without latching inner nodes or the root latch. A node's version is validated
+   * after its child was picked, before the child is touched, and the descent starts over from the root if the node
+   * changed in between. The leaf is not latched: its version is returned to be validated once it is.
+   *
+   * NOTE: The caller must hold an EpochGuard for as long as it looks at the leaf
+   *
+   * @param child_of picks the child of an inner node to descend into
+   * @param[out] leaf_version version of the leaf when it was reached
+   * @return Pointer to LeafNode if tree is not empty, nullptr otherwise
+   */
+  template <typename ChildOf>
+  BaseNode *DescendOptimistic(ChildOf child_of, uint64_t *leaf_version) {
+    while (true) {
+      BaseNode *current_node = root_.load();
+      if (current_node == nullptr) return nullptr;
+
+      uint64_t version;
+      if (!current_node->ReadVersion(&version) || current_node != root_.load()) continue;
+
+      bool restart = false;
+      while (current_node->GetType() != NodeType::LeafType) {
+        BaseNode *child = child_of(reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(current_node));
+        uint64_t child_version;
+        // The child is only linked from the node if the node did not change while the child was picked and its
+        // version was read
+        if (!current_node->ValidateVersion(version) || !child->ReadVersion(&child_version) ||
+            !current_node->ValidateVersion(version)) {
+          restart = true;
+          break;
+        }
+        current_node = child;
+        version = child_version;
+      }
+      if (restart) continue;
+
+      *leaf_version = version;
+      return current_node;
+    }
+  }
+
+  /**
+   * Descends from the root to a leaf with optimistic lock coupling, see DescendOptimistic.
    *
    * NOTE: Upon return, shared latch will be held on the corresponding leaf node.
    *
-   * @param key Key to be searched for.
+   * @param child_of picks the child of an inner node to descend into
    * @return Pointer to LeafNode if tree is not empty, nullptr otherwise
    */
-  BaseNode *FindLeafNode(KeyType key) {
-    root_latch_.LockShared();
+  template <typename ChildOf>
+  BaseNode *FindLeafNodeOptimistic(ChildOf child_of) {
+    EpochGuard guard(this);
 
-    if (root_ == nullptr) {
-      root_latch_.UnlockShared();
-      return nullptr;
+    while (true) {
+      uint64_t version;
+      BaseNode *leaf = DescendOptimistic(child_of, &version);
+      if (leaf == nullptr) return nullptr;
+      if (LatchLeafIfUnchanged(leaf, version)) return leaf;
     }
+  }
 
-    BaseNode *current_node = root_;
-    BaseNode *parent = nullptr;
+  /**
+   * Latches a leaf reached through DescendOptimistic, unless it changed since. Splits, merges and borrowing all latch
+   * the leaf exclusively, so an unchanged version means that the leaf still is the one to look at.
+   * @param leaf the leaf
+   * @param version version of the leaf when it was reached
+   * @return true if the leaf is unchanged and now latched shared, false if it changed and is not latched
+   */
+  bool LatchLeafIfUnchanged(BaseNode *leaf, const uint64_t version) {
+    leaf->GetNodeSharedLatch();
+    if (leaf->ValidateVersion(version)) return true;
+    leaf->ReleaseNodeSharedLatch();
+    return false;
+  }
 
-    // Get the shared latch of next node, release the root_latch
-    current_node->GetNodeSharedLatch();
-    root_latch_.UnlockShared();
+  /**
+   * Picks the child of an inner node whose subtree holds the given key
+   * @param node the inner node
+   * @param key the key
+   * @return the child to descend into
+   */
+  BaseNode *ChildOfKey(ElasticNode<KeyNodePointerPair> *node, const KeyType &key) {
+    // Note that Find Location returns the location of first element
+    // that compare greater than
+    auto index_pointer = static_cast<InnerNode *>(node)->FindLocation(key, this);
+    // Thus we have to go in the left side of location which will be the
+    // pointer of the previous location.
+    return index_pointer != node->Begin() ? (index_pointer - 1)->second : node->GetLowKeyPair().second;
+  }
 
-    // Traversing Down to the right leaf node
-    while (current_node->GetType() != NodeType::LeafType) {
-      auto node = reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(current_node);
-      // Note that Find Location returns the location of first element
-      // that compare greater than
-      auto index_pointer = static_cast<InnerNode *>(node)->FindLocation(key, this);
-      // Thus we have to go in the left side of location which will be the
-      // pointer of the previous location.
-      parent = current_node;
-      if (index_pointer != node->Begin()) {
-        index_pointer -= 1;
-        current_node = index_pointer->second;
-      } else {
-        current_node = node->GetLowKeyPair().second;
-      }
+ public:
+  /**
+   * Switches readers between optimistic lock coupling and latching every node on their path
+   * NOTE: Only safe to change while no reader is inside the tree
+   * @param optimistic_reads true to read without latching inner nodes
+   */
+  void SetOptimisticReads(const bool optimistic_reads) { optimistic_reads_ = optimistic_reads; }
 
-      // Get the shared latch for next node and release the parent
-      current_node->GetNodeSharedLatch();
-      parent->ReleaseNodeSharedLatch();
-    }
+  /**
+   * @return true if readers use optimistic lock coupling
+   */
+  bool GetOptimisticReads() const { return optimistic_reads_; }
 
-    return current_node;
+  /**
+   * This function returns the pointer to the First Leaf Node (node containing the
+   * smallest key)
+   *
+   * NOTE: Upon return, shared latch will be held on the corresponding leaf node.
+   *
+   * @return Pointer to LeafNode if tree is not empty, nullptr otherwise
+   */
+  BaseNode *FindLeafNode() {
+    auto child_of = [](ElasticNode<KeyNodePointerPair> *node) { return node->GetLowKeyPair().second; };
+    return optimistic_reads_ ? FindLeafNodeOptimistic(child_of) : FindLeafNodeLatched(child_of);
+  }
+
+  /**
+   * This function returns the pointer to the leaf node containing a particular key.
+   *
+   * NOTE: Upon return, shared latch will be held on the corresponding leaf node.
+   *
+   * @param key Key to be searched for.
+   * @return Pointer to LeafNode if tree is not empty, nullptr otherwise
+   */
+  BaseNode *FindLeafNode(KeyType key) {
+    auto child_of = [this, &key](ElasticNode<KeyNodePointerPair> *node) { return ChildOfKey(node, key); };
+    return optimistic_reads_ ? FindLeafNodeOptimistic(child_of) : FindLeafNodeLatched(child_of);
   }
 
   /**
@@ -844,27 +1118,8 @@ class BPlusTree : public BPlusTreeBase {
    * @return Pointer to the last leaf node
    */
   BaseNode *FindLastLeafNode() {
-    root_latch_.LockShared();
-
-    if (root_ == nullptr) {
-      root_latch_.UnlockShared();
-      return nullptr;
-    }
-    BaseNode *current_node = root_;
-    BaseNode *parent = nullptr;
-    // Acquire latch on the root, release root_latch
-    current_node->GetNodeSharedLatch();
-    root_latch_.UnlockShared();
-    // Traversing Down to the correct leaf node
-    while (current_node->GetType() != NodeType::LeafType) {
-      // Set parent for releasing the lock
-      parent = current_node;
-      current_node = current_node->GetHighKeyPair().second;
-      // Get shared latch on current node, and release the parent.
-      current_node->GetNodeSharedLatch();
-      parent->ReleaseNodeSharedLatch();
-    }
-    return current_node;
+    auto child_of = [](ElasticNode<KeyNodePointerPair> *node) { return node->GetHighKeyPair().second; };
+    return optimistic_reads_ ? FindLeafNodeOptimistic(child_of) : FindLeafNodeLatched(child_of);
   }
 
   /**
@@ -1371,6 +1626,89 @@ class BPlusTree : public BPlusTreeBase {
     current_node->ReleaseNodeSharedLatch();
   }
 
+  /**
+   * Looks up a batch of keys. The keys are visited in ascending order: keys that fall into the same leaf share one
+   * search of the leaf, and consecutive descents go down mostly the same, already cached, path. With optimistic reads
+   * and keys spread over many leaves, the leaves of the keys K_PREFETCH_DISTANCE positions ahead are found and
+   * prefetched before they are searched.
+   * @param keys keys to look up
+   * @param callback called with the position of the key in keys and the value, for every value of every key found
+   */
+  template <typename Callback>
+  void FindValuesOfKeys(const std::vector<KeyType> &keys, Callback callback) {
+    const auto batch_size = static_cast<uint32_t>(keys.size());
+    std::vector<uint32_t> order(batch_size);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [this, &keys](const uint32_t a, const uint32_t b) { return KeyCmpLess(keys[a], keys[b]); });
+
+    // Finding leaves ahead of time only pays off if most keys go to a different leaf than the key before them, dense
+    // batches are better served by searching the latched leaf again. Leaves found ahead of time are not latched, the
+    // guard keeps them from being freed until they are searched.
+    EpochGuard guard(this);
+    const uint64_t average_leaf_size = (leaf_node_size_lower_threshold_ + leaf_node_size_upper_threshold_) / 2;
+    const bool sparse = batch_size * average_leaf_size < num_keys_.load();
+    const uint32_t distance = optimistic_reads_ && sparse ? common::Constants::K_PREFETCH_DISTANCE : 0;
+    std::vector<std::pair<BaseNode *, uint64_t>> leaves_ahead(distance == 0 ? 0 : batch_size);
+    auto find_leaf_ahead = [&](const uint32_t pos) {
+      const KeyType &key = keys[order[pos]];
+      auto child_of = [this, &key](ElasticNode<KeyNodePointerPair> *node) { return ChildOfKey(node, key); };
+      leaves_ahead[pos].first = DescendOptimistic(child_of, &leaves_ahead[pos].second);
+      if (leaves_ahead[pos].first != nullptr) PrefetchLeaf(leaves_ahead[pos].first);
+    };
+    for (uint32_t pos = 0; pos < std::min(distance, batch_size); pos++) find_leaf_ahead(pos);
+
+    ElasticNode<KeyValuePair> *leaf = nullptr;
+    for (uint32_t pos = 0; pos < batch_size; pos++) {
+      if (distance != 0 && pos + distance < batch_size) find_leaf_ahead(pos + distance);
+      const uint32_t key_idx = order[pos];
+      const KeyType &key = keys[key_idx];
+
+      // The previous key belongs to the latched leaf and this key is not smaller, so this key belongs to the leaf as
+      // well unless it is larger than all keys in the leaf
+      if (leaf != nullptr && (leaf->GetSize() == 0 || KeyCmpGreater(key, leaf->RBegin()->first))) {
+        leaf->ReleaseNodeSharedLatch();
+        leaf = nullptr;
+      }
+      if (leaf == nullptr) {
+        BaseNode *current_node = nullptr;
+        if (distance != 0 && leaves_ahead[pos].first != nullptr &&
+            LatchLeafIfUnchanged(leaves_ahead[pos].first, leaves_ahead[pos].second)) {
+          current_node = leaves_ahead[pos].first;
+        } else {
+          current_node = FindLeafNode(key);
+        }
+        // Empty tree
+        if (current_node == nullptr) return;
+        leaf = reinterpret_cast<ElasticNode<KeyValuePair> *>(current_node);
+      }
+
+      KeyValuePair *element_p = std::lower_bound(
+          leaf->Begin(), leaf->End(), key,
+          [this](const KeyValuePair &element, const KeyType &k) { return KeyCmpLess(element.first, k); });
+      if (element_p != leaf->End() && KeyCmpEqual(element_p->first, key)) {
+        for (const ValueType &value : *element_p->second) callback(key_idx, value);
+      }
+    }
+
+    // Release the Leaf shared latch
+    if (leaf != nullptr) leaf->ReleaseNodeSharedLatch();
+  }
+
+  /**
+   * Prefetches the header of a leaf and the element in the middle of a leaf of average size, where a search of it
+   * starts. Does not read the leaf, whose header is not in cache yet.
+   * @param node the leaf
+   */
+  void PrefetchLeaf(BaseNode *node) const {
+    // Elements are stored right behind the header
+    const auto *elements = reinterpret_cast<const KeyValuePair *>(reinterpret_cast<const char *>(node) +
+                                                                 sizeof(ElasticNode<KeyValuePair>));
+    execution::util::Memory::Prefetch<true, execution::Locality::Low>(node);
+    execution::util::Memory::Prefetch<true, execution::Locality::Low>(
+        elements + (leaf_node_size_lower_threshold_ + leaf_node_size_upper_threshold_) / 4);
+  }
+
   /**
    * Traverses Down the root in a BFS manner and frees all the nodes. Used in
    * the B+ Tree destructor.
@@ -1698,10 +2036,12 @@ class BPlusTree : public BPlusTreeBase {
    * @param value_list List of values scanned
    * @param metadata Index metadata
    * @param predicate Predicate to be satisfied to add a value to the result
+   * @param key_list if not null, the key of every value in value_list is added at the same position
    */
   bool ScanAscending(KeyType index_low_key, KeyType index_high_key, bool low_key_exists, uint32_t num_attrs,
                      bool high_key_exists, uint32_t limit, std::vector<TupleSlot> *value_list,
-                     const IndexMetadata *metadata, std::function<bool(const ValueType)> predicate) {
+                     const IndexMetadata *metadata, std::function<bool(const ValueType)> predicate,
+                     std::vector<KeyType> *key_list = nullptr) {
     BPlusTreeIterator iterator;
     if (low_key_exists) {
       iterator = Begin(index_low_key);
@@ -1716,6 +2056,7 @@ class BPlusTree : public BPlusTreeBase {
         continue;
       }
       value_list->push_back(iterator.Value());
+      if (key_list != nullptr) key_list->push_back(iterator.Key());
       if (!(limit == 0 || value_list->size() < limit)) break;
       ++iterator;
     }
@@ -2114,17 +2455,19 @@ class BPlusTree : public BPlusTreeBase {
     // Remember the root must have been split by now.
     if (!finished_insertion) {
       NOISEPAGE_ASSERT(got_root_latch, "Root Latch should be held here");
-      auto old_root = root_;
+      BaseNode *old_root = root_;
       KeyNodePointerPair p1, p2;
       p1.first = inner_node_element.first; /* This is a dummy initialization */
       p2.first = inner_node_element.first; /* This is a dummy initialization */
       p1.second = old_root;                /* This initialization matters */
       p2.second = nullptr;                 /* This is a dummy initialization */
-      root_ = ElasticNode<KeyNodePointerPair>::Get(inner_node_size_upper_threshold_, NodeType::InnerType,
-                                                   root_->GetDepth() + 1, inner_node_size_upper_threshold_, p1, p2);
-      auto new_root_node = reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(root_);
+      auto new_root_node = ElasticNode<KeyNodePointerPair>::Get(
+          inner_node_size_upper_threshold_, NodeType::InnerType, old_root->GetDepth() + 1,
+          inner_node_size_upper_threshold_, p1, p2);
       new_root_node->InsertElementIfPossible(
           inner_node_element, static_cast<InnerNode *>(new_root_node)->FindLocation(inner_node_element.first, this));
+      // Optimistic readers do not take the root latch, only publish the new root once it is complete
+      root_ = new_root_node;
     }
 
     if (got_root_latch) {
@@ -2135,6 +2478,144 @@ class BPlusTree : public BPlusTreeBase {
     return true;
   }
 
+  /**
+   * Builds the tree bottom-up from elements sorted by key, which is much cheaper than inserting them one by one: every
+   * leaf is filled up to the bulk load fill factor before the next one is started, and each level of inner nodes is
+   * built from the level below it. The last node of a level takes elements from its left neighbor if it would be
+   * underfull. The tree must be empty.
+   *
+   * NOTE: This function holds the exclusive root latch for the whole load.
+   *
+   * @tparam ElementSource callable returning a pointer to the next element, or nullptr once all elements are consumed.
+   *                       The element only needs to stay valid until the next call.
+   * @param next_element source of the elements, in ascending order of their keys
+   * @param unique whether a key may have at most one value
+   * @return false if unique is set and a key has more than one value, in which case the tree stays empty, true
+   *         otherwise
+   */
+  template <typename ElementSource>
+  bool BulkLoad(const ElementSource &next_element, const bool unique) {
+    root_latch_.LockExclusive();
+    NOISEPAGE_ASSERT(root_ == nullptr, "Bulk loading requires an empty tree.");
+
+    const int leaf_fill = BulkLoadNodeSize(leaf_node_size_lower_threshold_, leaf_node_size_upper_threshold_);
+    const int inner_fill = BulkLoadNodeSize(inner_node_size_lower_threshold_, inner_node_size_upper_threshold_);
+
+    // Build the leaves, each one linked to its siblings
+    std::vector<BaseNode *> level;
+    std::vector<KeyType> low_keys;
+    ElasticNode<KeyValuePair> *leaf = nullptr;
+    uint64_t num_keys = 0;
+    uint64_t num_values = 0;
+    for (const KeyElementPair *element = next_element(); element != nullptr; element = next_element()) {
+      NOISEPAGE_ASSERT(leaf == nullptr || !KeyCmpLess(element->first, leaf->RBegin()->first),
+                       "Bulk loaded elements must be sorted by key.");
+      if (leaf != nullptr && KeyCmpEqual(leaf->RBegin()->first, element->first)) {
+        if (unique) {
+          FreeBulkLoadedLeaves(&level);
+          root_latch_.UnlockExclusive();
+          return false;
+        }
+        leaf->RBegin()->second->push_back(element->second);
+        num_values++;
+        continue;
+      }
+
+      if (leaf == nullptr || leaf->GetSize() == leaf_fill) {
+        KeyNodePointerPair low_key{element->first, leaf};
+        KeyNodePointerPair high_key{element->first, nullptr};
+        auto *next_leaf = ElasticNode<KeyValuePair>::Get(leaf_node_size_upper_threshold_, NodeType::LeafType, 0,
+                                                         leaf_node_size_upper_threshold_, low_key, high_key);
+        if (leaf != nullptr) leaf->GetElasticHighKeyPair()->second = next_leaf;
+        leaf = next_leaf;
+        level.push_back(leaf);
+      }
+      leaf->PushBack(KeyValuePair{element->first, new ValueList{element->second}});
+      num_keys++;
+      num_values++;
+    }
+
+    if (level.empty()) {
+      root_latch_.UnlockExclusive();
+      return true;
+    }
+
+    // Balance the last leaf with its left sibling, merging the two if they fit in one leaf
+    if (level.size() > 1 && leaf->GetSize() < leaf_node_size_lower_threshold_) {
+      auto *prev = reinterpret_cast<ElasticNode<KeyValuePair> *>(level[level.size() - 2]);
+      if (prev->GetSize() + leaf->GetSize() <= leaf_node_size_upper_threshold_) {
+        prev->MergeNode(leaf);
+        prev->GetElasticHighKeyPair()->second = nullptr;
+        leaf->FreeElasticNode();
+        level.pop_back();
+      } else {
+        const int half = (prev->GetSize() + leaf->GetSize()) / 2;
+        while (leaf->GetSize() < half) {
+          leaf->InsertElementIfPossible(*prev->RBegin(), leaf->Begin());
+          prev->PopEnd();
+        }
+      }
+    }
+    for (auto *node : level) low_keys.push_back(reinterpret_cast<ElasticNode<KeyValuePair> *>(node)->Begin()->first);
+
+    // Build the inner levels, the first child of each node is its low key pointer
+    for (int depth = 1; level.size() > 1; depth++) {
+      const auto num_children = static_cast<int>(level.size());
+      std::vector<int> node_sizes(num_children / (inner_fill + 1), inner_fill + 1);
+      if (const int rest = num_children % (inner_fill + 1); rest > 0) node_sizes.push_back(rest);
+      if (node_sizes.size() > 1 && node_sizes.back() - 1 < inner_node_size_lower_threshold_) {
+        const int children = node_sizes[node_sizes.size() - 2] + node_sizes.back();
+        node_sizes.pop_back();
+        if (children - 1 <= inner_node_size_upper_threshold_) {
+          node_sizes.back() = children;
+        } else {
+          node_sizes.back() = children / 2;
+          node_sizes.push_back(children - children / 2);
+        }
+      }
+
+      std::vector<BaseNode *> parents;
+      std::vector<KeyType> parent_low_keys;
+      int child = 0;
+      for (const int node_size : node_sizes) {
+        KeyNodePointerPair low_key{low_keys[child], level[child]};
+        KeyNodePointerPair high_key{low_keys[child], nullptr};
+        auto *node = ElasticNode<KeyNodePointerPair>::Get(inner_node_size_upper_threshold_, NodeType::InnerType, depth,
+                                                          inner_node_size_upper_threshold_, low_key, high_key);
+        for (int i = child + 1; i < child + node_size; i++) node->PushBack(KeyNodePointerPair{low_keys[i], level[i]});
+        parents.push_back(node);
+        parent_low_keys.push_back(low_keys[child]);
+        child += node_size;
+      }
+      level = std::move(parents);
+      low_keys = std::move(parent_low_keys);
+    }
+
+    root_ = level[0];
+    num_keys_ = num_keys;
+    num_values_ = num_values;
+    root_latch_.UnlockExclusive();
+    return true;
+  }
+
+ private:
+  // Number of elements bulk loading puts into a node with the given size thresholds
+  int BulkLoadNodeSize(const int lower_threshold, const int upper_threshold) const {
+    const int fill = upper_threshold * bulk_load_fill_factor_ / 100;
+    return std::min(std::max(fill, std::max(lower_threshold, 1)), upper_threshold);
+  }
+
+  // Free the leaves and value lists built by a failed bulk load
+  void FreeBulkLoadedLeaves(std::vector<BaseNode *> *leaves) {
+    for (auto *node : *leaves) {
+      auto *leaf = reinterpret_cast<ElasticNode<KeyValuePair> *>(node);
+      for (KeyValuePair *element_p = leaf->Begin(); element_p != leaf->End(); element_p++) delete element_p->second;
+      leaf->FreeElasticNode();
+    }
+    leaves->clear();
+  }
+
+ public:
   /**
    * DeleteRebalance - Function that deletes and rebalances the tree by borrowing from siblings or by
    * merging nodes.
@@ -2367,8 +2848,8 @@ class BPlusTree : public BPlusTreeBase {
       input_child_pointer->ReleaseNodeLatch();
       left_sibling_base_node->ReleaseNodeLatch();
 
-      child->FreeElasticNode();
       parent->Erase(index);
+      RetireNode(child);
 
     } else {
       BaseNode *right_sibling_base_node = (parent->Begin() + index + 1)->second;
@@ -2414,15 +2895,15 @@ class BPlusTree : public BPlusTreeBase {
       input_child_pointer->ReleaseNodeLatch();
       right_sibling_base_node->ReleaseNodeLatch();
 
-      right_sibling->FreeElasticNode();
       parent->Erase(index + 1);
+      RetireNode(right_sibling);
     }
   }
 
   /**
    * RelaseLastLocksDelete - Releases the node's latch and pops it from the list
    */
-  void RelaseLastLocksDelete(std::vector<common::SharedLatch *> *lock_list) {
+  void RelaseLastLocksDelete(std::vector<NodeLatch *> *lock_list) {
     if (!lock_list->empty()) {
       (*lock_list->rbegin())->UnlockExclusive();
       lock_list->pop_back();
@@ -2573,7 +3054,7 @@ class BPlusTree : public BPlusTreeBase {
      ****************************************
     */
 
-    std::vector<common::SharedLatch *> lock_list;
+    std::vector<NodeLatch *> lock_list;
     root_latch_.LockExclusive();
     lock_list.push_back(&root_latch_);
     bool is_deleted = Delete(root_, element, &lock_list);
@@ -2588,7 +3069,7 @@ class BPlusTree : public BPlusTreeBase {
    * exist. Return true if delete succeeds
    *
    */
-  bool Delete(BaseNode *current_node, const KeyElementPair &element, std::vector<common::SharedLatch *> *lock_list) {
+  bool Delete(BaseNode *current_node, const KeyElementPair &element, std::vector<NodeLatch *> *lock_list) {
     // If tree is empty, return false
     if (current_node == nullptr) {
       return false;
@@ -2665,14 +3146,17 @@ class BPlusTree : public BPlusTreeBase {
           // If now the list is empty delete key-emptylist from the tree
           delete leaf_position->second;
           bool is_deleted = node->Erase(leaf_position - node->Begin());
-          if (is_deleted && node->GetSize() == 0) {
+          const bool is_empty = is_deleted && node->GetSize() == 0;
+          if (is_empty) {
             // All elements of tree are now deleted
-            node->FreeElasticNode();  // Important - we need to free node
             root_ = nullptr;
           }
 
           // Release the lock
           RelaseLastLocksDelete(lock_list);
+          if (is_empty) {
+            RetireNode(node);  // Important - we need to free node
+          }
           num_values_--;
           num_keys_--;
 
@@ -2721,7 +3205,7 @@ class BPlusTree : public BPlusTreeBase {
 
           // Release the lock and free the node
           RelaseLastLocksDelete(lock_list);
-          node->FreeElasticNode();
+          RetireNode(node);
           return true;
         }
 
@@ -2739,6 +3223,19 @@ class BPlusTree : public BPlusTreeBase {
     return false;
   }
 
+  /**
+   * Removes all elements from the tree, e.g., to undo a bulk load.
+   * NOTE: This function holds the exclusive root latch but no node latches, no other thread may be inside the tree
+   */
+  void Clear() {
+    root_latch_.LockExclusive();
+    FreeTree();
+    root_ = nullptr;
+    num_keys_ = 0;
+    num_values_ = 0;
+    root_latch_.UnlockExclusive();
+  }
+
   /**
    * Returns the size of the B+ Tree (number of keys stored)
    * @return The size of the tree
@@ -2756,7 +3253,7 @@ class BPlusTree : public BPlusTreeBase {
       return 0;
     }
 
-    auto depth = root_->GetDepth();
+    auto depth = root_.load()->GetDepth();
     size_t heap_usage = (depth * GetInnerNodeSizeLowerThreshold() *
                          sizeof(KeyNodePointerPair)) +  // InnerNode size (assuming half full)
                         (num_keys_ * sizeof(KeyType)) +
@@ -2785,12 +3282,16 @@ class BPlusTree : public BPlusTreeBase {
         // Root and key/value counters
         root_(nullptr),
         num_keys_(0),
-        num_values_(0) {}
+        num_values_(0),
+        reader_slots_(NUM_READER_SLOTS) {}
 
   /**
    * Destructor - Destroy BPlusTree instance
    */
-  ~BPlusTree() { FreeTree(); }
+  ~BPlusTree() {
+    FreeTree();
+    for (auto &retired_nodes : retired_nodes_) FreeNodes(&retired_nodes);
+  }
 };  // class BPlusTree
 
 }  // namespace noisepage::storage::index
@@ -36,6 +36,16 @@ class BPlusTreeIndex final : public Index {
       bplustree_;
   mutable common::SpinLatch transaction_context_latch_;  // latch used to protect transaction context
 
+  // A bulk load entry is the element that the B+ Tree stores for it
+  using BulkLoadEntry = std::pair<KeyType, TupleSlot>;
+
+  static int32_t CompareBulkLoadEntries(const void *lhs, const void *rhs);
+
+  // Scan ascending, adding the key of every value to key_list if it is not null
+  void ScanAscendingInternal(const transaction::TransactionContext &txn, ScanType scan_type, uint32_t num_attrs,
+                             ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
+                             std::vector<TupleSlot> *value_list, std::vector<KeyType> *key_list);
+
  public:
   /**
    * @return type of the index. Note that this is the physical type, not extracted from the underlying schema or other
@@ -61,6 +71,15 @@ class BPlusTreeIndex final : public Index {
   /** @return inner node lower threshold (merge) */
   int GetInnerNodeSizeLowerThreshold() const;
 
+  /**
+   * Sets the percentage of each node that bulk loading fills
+   * @param fill_factor Fill factor to use for bulk loading
+   */
+  void SetBulkLoadFillFactor(int fill_factor);
+
+  /** @return percentage of each node that bulk loading fills */
+  int GetBulkLoadFillFactor() const;
+
   /**
    * @return approximate number of bytes allocated on the heap for this index data structure
    */
@@ -97,6 +116,33 @@ class BPlusTreeIndex final : public Index {
   void Delete(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
               TupleSlot location) final;
 
+  /** @return true, the B+ Tree is built bottom-up by BulkLoad() */
+  bool SupportsBulkLoad() const final { return true; }
+
+  /** @return size in bytes of the entries consumed by BulkLoad() */
+  uint32_t BulkLoadEntrySize() const final { return sizeof(BulkLoadEntry); }
+
+  /** @return function that orders bulk load entries by their keys */
+  BulkLoadComparison GetBulkLoadComparison() const final { return &CompareBulkLoadEntries; }
+
+  /**
+   * Writes a key-value pair into a bulk load entry.
+   * @param tuple key
+   * @param location value
+   * @param[out] entry memory of BulkLoadEntrySize() bytes that the entry is written into
+   */
+  void SetBulkLoadEntry(const ProjectedRow &tuple, TupleSlot location, byte *entry) const final;
+
+  /**
+   * Builds the empty B+ Tree bottom-up from bulk load entries, filling each node up to the bulk load fill factor.
+   * @param txn txn context for the calling txn, used to register abort actions
+   * @param next_entry returns the next entry in the order of GetBulkLoadComparison(), or nullptr once all entries are
+   *                   consumed
+   * @return false if the index is unique and two entries have the same key, true otherwise
+   */
+  bool BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                const std::function<const byte *()> &next_entry) final;
+
   /**
    * Finds all the values associated with the given key in our index.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -106,6 +152,15 @@ class BPlusTreeIndex final : public Index {
   void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * Finds all the values associated with each of the given keys, looking the keys up in ascending order.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param[out] value_lists the values associated with each key, in the order of the keys
+   */
+  void ScanKeyBatch(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                    std::vector<std::vector<TupleSlot>> *value_lists) final;
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -120,6 +175,26 @@ class BPlusTreeIndex final : public Index {
                      ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
                      std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * @return true if the keys hold their attributes, which they do unless varlens must be inlined
+   */
+  bool SupportsKeyScans() const final { return !metadata_.MustInlineVarlen(); }
+
+  /**
+   * Finds all the values between the given keys in our index, sorted in ascending order, along with their keys.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param scan_type Scan Type
+   * @param num_attrs Number of attributes to compare
+   * @param low_key the key to start at
+   * @param high_key the key to end at
+   * @param limit if any
+   * @param[out] value_list the values associated with the keys
+   * @param[out] key_list the key of each value, see Index::ScanAscendingWithKeys()
+   */
+  void ScanAscendingWithKeys(const transaction::TransactionContext &txn, ScanType scan_type, uint32_t num_attrs,
+                             ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
+                             std::vector<TupleSlot> *value_list, std::vector<uint64_t> *key_list) final;
+
   /**
    * Finds all the values between the given keys in our index, sorted in descending order.
    * @param txn txn context for the calling txn, used for visibility checks
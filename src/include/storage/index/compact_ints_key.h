@@ -92,6 +92,38 @@ class CompactIntsKey {
     }
   }
 
+  /**
+   * Write the attributes of the CompactIntsKey into a ProjectedRow, the inverse of SetFromProjectedRow
+   * @param[out] to ProjectedRow of the index's initializer to write the attributes into
+   * @param metadata index information, primarily attribute sizes and the precomputed offsets to translate
+   * CompactIntsKey to PR layout
+   */
+  void CopyToProjectedRow(storage::ProjectedRow *const to, const IndexMetadata &metadata) const {
+    const auto &attr_sizes = metadata.GetAttributeSizes();
+    const auto &compact_ints_offsets = metadata.GetCompactIntsOffsets();
+    NOISEPAGE_ASSERT(attr_sizes.size() == to->NumColumns(), "attr_sizes and ProjectedRow must be equal in size.");
+
+    for (uint8_t i = 0; i < attr_sizes.size(); i++) {
+      byte *const attr = to->AccessForceNotNull(to->ColumnIds()[i].UnderlyingValue());
+      switch (attr_sizes[i]) {
+        case sizeof(int8_t):
+          *reinterpret_cast<int8_t *>(attr) = GetInteger<int8_t>(compact_ints_offsets[i]);
+          break;
+        case sizeof(int16_t):
+          *reinterpret_cast<int16_t *>(attr) = GetInteger<int16_t>(compact_ints_offsets[i]);
+          break;
+        case sizeof(int32_t):
+          *reinterpret_cast<int32_t *>(attr) = GetInteger<int32_t>(compact_ints_offsets[i]);
+          break;
+        case sizeof(int64_t):
+          *reinterpret_cast<int64_t *>(attr) = GetInteger<int64_t>(compact_ints_offsets[i]);
+          break;
+        default:
+          throw std::runtime_error("Invalid attribute size.");
+      }
+    }
+  }
+
   /**
    * Returns whether this key is less than another key up to num_attrs for comparison.
    * @param rhs other key to compare against
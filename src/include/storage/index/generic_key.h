@@ -84,6 +84,20 @@ class GenericKey {
     }
   }
 
+  /**
+   * Write the attributes of the GenericKey into a ProjectedRow, the inverse of SetFromProjectedRow. Only keys that
+   * do not inline their varlens hold the ProjectedRow they were built from.
+   * @param[out] to ProjectedRow of the index's initializer to write the attributes into
+   * @param metadata index information, key_schema used to interpret PR data correctly
+   */
+  void CopyToProjectedRow(storage::ProjectedRow *const to, const IndexMetadata &metadata) const {
+    NOISEPAGE_ASSERT(!metadata.MustInlineVarlen(), "Keys with inlined varlens cannot be copied out.");
+    const ProjectedRow *const from = GetProjectedRow();
+    NOISEPAGE_ASSERT(from->Size() == to->Size(), "ProjectedRows must have the same layout.");
+    // We recast to as a workaround for -Wclass-memaccess
+    std::memcpy(static_cast<void *>(to), from, from->Size());
+  }
+
   /**
    * @return Aligned pointer to the key's internal ProjectedRow, exposed for hasher and comparators
    */
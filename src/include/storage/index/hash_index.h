@@ -1,14 +1,10 @@
 #pragma once
 
-#include <functional>
 #include <memory>
-#include <unordered_set>
-#include <utility>
-#include <variant>  // NOLINT (Matt): lint thinks this C++17 header is a C header because it only knows C++11
 #include <vector>
 
 #include "common/managed_pointer.h"
-#include "libcuckoo/cuckoohash_config.hh"
+#include "storage/index/hash_multimap.h"
 #include "storage/index/index.h"
 #include "storage/index/index_defs.h"
 
@@ -16,9 +12,6 @@ namespace noisepage::transaction {
 class TransactionContext;
 }
 
-template <class Key, class T, class Hash, class KeyEqual, class Allocator, std::size_t SLOT_PER_BUCKET>
-class cuckoohash_map;
-
 namespace noisepage::storage::index {
 
 template <uint16_t KeySize>
@@ -27,10 +20,9 @@ template <uint16_t KeySize>
 class GenericKey;
 
 /**
- * Wrapper around libcuckoo's hash map. The MVCC is logic is similar to our reference index (BwTreeIndex). Much of the
- * logic here is related to the cuckoohash_map not being a multimap. We get around this by making the value type a
- * std::variant that can either be a TupleSlot if there's only a single value for a given key, or a std::unordered_set
- * of TupleSlots if a single key needs to map to multiple TupleSlots.
+ * Wrapper around HashMultiMap. The MVCC is logic is similar to our reference index (BwTreeIndex). The multimap keeps
+ * the first few TupleSlots of a key inline and the rest in overflow pages, so duplicate keys of non-unique indexes do
+ * not allocate per value.
  * @tparam KeyType the type of keys stored in the map
  */
 template <typename KeyType>
@@ -38,21 +30,9 @@ class HashIndex final : public Index {
   friend class IndexBuilder;
 
  private:
-  // TODO(Matt): unclear at the moment if we would want this to be tunable via the SettingsManager. Alternatively, it
-  // might be something that is a per-index hint based on the table size (cardinality?), rather than a global setting
-  static constexpr uint16_t INITIAL_CUCKOOHASH_MAP_SIZE = 256;
-  struct TupleSlotHash;
-
-  using ValueMap = std::unordered_set<TupleSlot, TupleSlotHash>;
-  using ValueType = std::variant<TupleSlot, ValueMap>;
-
   explicit HashIndex(IndexMetadata metadata);
 
-  const std::unique_ptr<
-      cuckoohash_map<KeyType, ValueType, std::hash<KeyType>,
-                     std::equal_to<KeyType>,  // NOLINT transparent functors can't figure out template
-                     std::allocator<std::pair<const KeyType, ValueType>>, LIBCUCKOO_DEFAULT_SLOT_PER_BUCKET>>
-      hash_map_;
+  const std::unique_ptr<HashMultiMap<KeyType, TupleSlot>> hash_map_;
   mutable common::SpinLatch transaction_context_latch_;  // latch used to protect transaction context
 
  public:
@@ -107,6 +87,15 @@ class HashIndex final : public Index {
   void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * Finds all the values associated with each of the given keys, prefetching the buckets of upcoming keys.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param[out] value_lists the values associated with each key, in the order of the keys
+   */
+  void ScanKeyBatch(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                    std::vector<std::vector<TupleSlot>> *value_lists) final;
+
   /** @return The number of keys in the index. */
   uint64_t GetSize() const final;
 };
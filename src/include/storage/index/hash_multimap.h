@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "common/math_util.h"
+#include "common/shared_latch.h"
+#include "execution/util/execution_common.h"
+#include "execution/util/memory.h"
+
+namespace noisepage::storage::index {
+
+/**
+ * Concurrent hash multimap with open addressing, built to hold the values of a HashIndex. Every key is stored once,
+ * with its first INLINE_VALUES values in its bucket and any further values in a list of overflow pages. Keys with a
+ * handful of duplicates therefore never allocate, and large groups of duplicates allocate one page per
+ * OVERFLOW_PAGE_VALUES values.
+ *
+ * The map is split into partitions by the upper bits of the hash. Every partition has its own latch and its own array
+ * of buckets, which grows independently of the other partitions. Within a partition keys are probed linearly, and a
+ * bucket that is emptied is refilled by shifting back the buckets that follow it in its probe sequence, so that there
+ * are no tombstones.
+ *
+ * The values of a key are not ordered, and the map does not check whether a value was already added to a key.
+ *
+ * @tparam KeyType type of the keys
+ * @tparam ValueType type of the values, needs to be trivially copyable
+ * @tparam Hash hash function of the keys, needs to spread keys over all 64 bits since the upper bits pick the partition
+ * @tparam KeyEqual equality of the keys
+ */
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>>  // NOLINT transparent functors can't figure out template
+class HashMultiMap {
+ public:
+  /** Number of partitions, each with its own latch */
+  static constexpr uint32_t NUM_PARTITIONS = 64;
+  /** Number of values stored in the bucket of a key */
+  static constexpr uint32_t INLINE_VALUES = 3;
+  /** Number of values in an overflow page, makes for pages of 512 bytes with 8-byte values */
+  static constexpr uint32_t OVERFLOW_PAGE_VALUES = 62;
+  /** Number of buckets a partition starts out with once it holds a key */
+  static constexpr uint64_t MIN_PARTITION_CAPACITY = 16;
+
+  HashMultiMap() = default;
+
+  ~HashMultiMap() {
+    for (auto &partition : partitions_) {
+      Bucket *const buckets = partition.buckets_.load();
+      for (uint64_t i = 0; i < partition.capacity_.load(); i++) {
+        for (OverflowPage *page = buckets[i].overflow_; page != nullptr;) {
+          OverflowPage *const next = page->next_;
+          delete page;
+          page = next;
+        }
+      }
+      delete[] buckets;
+    }
+  }
+
+  DISALLOW_COPY_AND_MOVE(HashMultiMap)
+
+  /**
+   * Grows the map so that it holds the given number of keys without growing again, e.g., ahead of a bulk insert
+   * @param num_keys expected number of keys
+   */
+  void Reserve(const uint64_t num_keys) {
+    const uint64_t keys_per_partition = common::MathUtil::DivRoundUp(num_keys, NUM_PARTITIONS);
+    const uint64_t capacity =
+        std::max(MIN_PARTITION_CAPACITY, common::MathUtil::PowerOf2Ceil(keys_per_partition * 4 / 3 + 1));
+    for (auto &partition : partitions_) {
+      common::SharedLatch::ScopedExclusiveLatch guard(&partition.latch_);
+      if (capacity > partition.capacity_.load()) Grow(&partition, capacity);
+    }
+  }
+
+  /**
+   * Adds a value to a key, unless the predicate holds for one of the values the key already has
+   * @tparam Predicate bool(const ValueType &)
+   * @param key key to add the value to
+   * @param value value to add
+   * @param predicate evaluated on the values of the key while the key is latched
+   * @return true if the value was added, false if the predicate held for an existing value
+   */
+  template <typename Predicate>
+  bool Insert(const KeyType &key, const ValueType &value, Predicate predicate) {
+    const uint64_t hash = Hash()(key);
+    Partition *const partition = &PartitionOf(hash);
+    common::SharedLatch::ScopedExclusiveLatch guard(&partition->latch_);
+
+    Bucket *bucket = FindBucket(*partition, key, hash);
+    if (bucket != nullptr) {
+      if (AnyValue(*bucket, predicate)) return false;
+      AppendValue(bucket, value);
+      return true;
+    }
+
+    // Keep the load factor below 3/4, linear probing degrades quickly beyond that
+    const uint64_t capacity = partition->capacity_.load();
+    if ((partition->num_keys_ + 1) * 4 > capacity * 3) {
+      Grow(partition, std::max(MIN_PARTITION_CAPACITY, capacity * 2));
+    }
+    bucket = FindEmptyBucket(*partition, hash);
+    bucket->hash_ = hash;
+    bucket->key_ = key;
+    bucket->values_[0] = value;
+    bucket->num_values_ = 1;
+    bucket->overflow_ = nullptr;
+    partition->num_keys_++;
+    num_keys_.fetch_add(1);
+    return true;
+  }
+
+  /**
+   * Removes one occurrence of a value from a key, and the key if this was its last value
+   * @param key key to remove the value from
+   * @param value value to remove
+   * @return true if the value was found
+   */
+  bool Erase(const KeyType &key, const ValueType &value) {
+    const uint64_t hash = Hash()(key);
+    Partition *const partition = &PartitionOf(hash);
+    common::SharedLatch::ScopedExclusiveLatch guard(&partition->latch_);
+
+    Bucket *const bucket = FindBucket(*partition, key, hash);
+    if (bucket == nullptr) return false;
+    ValueType *const found = FindValue(bucket, value);
+    if (found == nullptr) return false;
+
+    // Fill the gap with the last value, so that values stay packed
+    ValueType *const last = LastValue(bucket);
+    if (found != last) *found = *last;
+    RemoveLastValue(bucket);
+    if (bucket->num_values_ == 0) RemoveBucket(partition, bucket - partition->buckets_.load());
+    return true;
+  }
+
+  /**
+   * Calls a function on every value of a key
+   * @tparam Function void(const ValueType &)
+   * @param key key to look up
+   * @param fn function to call, while the key is latched
+   * @return true if the key was found
+   */
+  template <typename Function>
+  bool Find(const KeyType &key, Function fn) const {
+    return Find(key, Hash()(key), fn);
+  }
+
+  /**
+   * Calls a function on every value of each of the given keys. Buckets are prefetched a few keys ahead of the key that
+   * is looked up, so that the cache misses of several keys overlap.
+   * @tparam Function void(uint32_t, const ValueType &), called with the position of the key and one of its values
+   * @param keys keys to look up
+   * @param num_keys number of keys
+   * @param fn function to call, while the key is latched
+   */
+  template <typename Function>
+  void FindBatch(const KeyType *const keys, const uint32_t num_keys, Function fn) const {
+    std::vector<uint64_t> hashes(num_keys);
+    for (uint32_t idx = 0; idx < num_keys; idx++) hashes[idx] = Hash()(keys[idx]);
+
+    const uint32_t distance = std::min(num_keys, common::Constants::K_PREFETCH_DISTANCE);
+    for (uint32_t idx = 0; idx < distance; idx++) PrefetchBucket(hashes[idx]);
+    for (uint32_t idx = 0, prefetch_idx = distance; idx < num_keys; idx++, prefetch_idx++) {
+      if (prefetch_idx < num_keys) PrefetchBucket(hashes[prefetch_idx]);
+      Find(keys[idx], hashes[idx], [&fn, idx](const ValueType &value) { fn(idx, value); });
+    }
+  }
+
+  /** @return number of keys in the map */
+  uint64_t Size() const { return num_keys_.load(); }
+
+  /** @return number of bytes of buckets and overflow pages */
+  size_t HeapUsage() const {
+    size_t heap_usage = num_overflow_pages_.load() * sizeof(OverflowPage);
+    for (const auto &partition : partitions_) heap_usage += partition.capacity_.load() * sizeof(Bucket);
+    return heap_usage;
+  }
+
+ private:
+  struct OverflowPage {
+    OverflowPage *next_;
+    uint32_t num_values_;
+    ValueType values_[OVERFLOW_PAGE_VALUES];
+  };
+
+  // Values past the inline ones live in a list of pages, of which only the first one can be partially filled. The key
+  // has overflow pages if and only if it has more than INLINE_VALUES values.
+  struct Bucket {
+    uint64_t hash_;
+    // Zero if the bucket is empty
+    uint32_t num_values_ = 0;
+    KeyType key_;
+    ValueType values_[INLINE_VALUES];
+    OverflowPage *overflow_ = nullptr;
+  };
+
+  // The buckets and their number are atomic so that they can be prefetched without the latch
+  struct alignas(common::Constants::CACHELINE_SIZE) Partition {
+    mutable common::SharedLatch latch_;
+    std::atomic<Bucket *> buckets_ = nullptr;
+    std::atomic<uint64_t> capacity_ = 0;
+    uint64_t num_keys_ = 0;
+  };
+
+  Partition &PartitionOf(const uint64_t hash) { return partitions_[hash >> (64 - PARTITION_BITS)]; }
+
+  const Partition &PartitionOf(const uint64_t hash) const { return partitions_[hash >> (64 - PARTITION_BITS)]; }
+
+  template <typename Function>
+  bool Find(const KeyType &key, const uint64_t hash, Function fn) const {
+    const Partition &partition = PartitionOf(hash);
+    common::SharedLatch::ScopedSharedLatch guard(&partition.latch_);
+    const Bucket *const bucket = FindBucket(partition, key, hash);
+    if (bucket == nullptr) return false;
+    AnyValue(*bucket, [&fn](const ValueType &value) {
+      fn(value);
+      return false;
+    });
+    return true;
+  }
+
+  void PrefetchBucket(const uint64_t hash) const {
+    // The pair may be torn by a concurrent Grow, which at worst prefetches a useless address
+    const Partition &partition = PartitionOf(hash);
+    const Bucket *const buckets = partition.buckets_.load(std::memory_order_relaxed);
+    const uint64_t capacity = partition.capacity_.load(std::memory_order_relaxed);
+    if (buckets == nullptr || capacity == 0) return;
+    execution::util::Memory::Prefetch<true, execution::Locality::Low>(buckets + (hash & (capacity - 1)));
+  }
+
+  // Requires the partition latch
+  Bucket *FindBucket(const Partition &partition, const KeyType &key, const uint64_t hash) const {
+    const uint64_t capacity = partition.capacity_.load(std::memory_order_relaxed);
+    if (capacity == 0) return nullptr;
+    Bucket *const buckets = partition.buckets_.load(std::memory_order_relaxed);
+    for (uint64_t i = hash & (capacity - 1);; i = (i + 1) & (capacity - 1)) {
+      Bucket *const bucket = buckets + i;
+      if (bucket->num_values_ == 0) return nullptr;
+      if (bucket->hash_ == hash && KeyEqual()(bucket->key_, key)) return bucket;
+    }
+  }
+
+  // Requires the exclusive partition latch, and the key to not be in the map
+  Bucket *FindEmptyBucket(const Partition &partition, const uint64_t hash) const {
+    const uint64_t capacity = partition.capacity_.load(std::memory_order_relaxed);
+    Bucket *const buckets = partition.buckets_.load(std::memory_order_relaxed);
+    uint64_t i = hash & (capacity - 1);
+    while (buckets[i].num_values_ != 0) i = (i + 1) & (capacity - 1);
+    return buckets + i;
+  }
+
+  // Requires the exclusive partition latch
+  void Grow(Partition *const partition, const uint64_t capacity) {
+    NOISEPAGE_ASSERT(common::MathUtil::IsPowerOf2(capacity), "Partitions need a power of two buckets.");
+    Bucket *const old_buckets = partition->buckets_.load(std::memory_order_relaxed);
+    const uint64_t old_capacity = partition->capacity_.load(std::memory_order_relaxed);
+
+    auto *const buckets = new Bucket[capacity];
+    for (uint64_t i = 0; i < old_capacity; i++) {
+      if (old_buckets[i].num_values_ == 0) continue;
+      uint64_t j = old_buckets[i].hash_ & (capacity - 1);
+      while (buckets[j].num_values_ != 0) j = (j + 1) & (capacity - 1);
+      buckets[j] = old_buckets[i];
+    }
+    partition->buckets_.store(buckets);
+    partition->capacity_.store(capacity);
+    delete[] old_buckets;
+  }
+
+  // Requires the exclusive partition latch, and the bucket to hold no values
+  void RemoveBucket(Partition *const partition, uint64_t hole) {
+    Bucket *const buckets = partition->buckets_.load(std::memory_order_relaxed);
+    const uint64_t mask = partition->capacity_.load(std::memory_order_relaxed) - 1;
+    for (uint64_t i = (hole + 1) & mask; buckets[i].num_values_ != 0; i = (i + 1) & mask) {
+      // A bucket can move into the hole if the hole lies between the bucket's home and the bucket itself, otherwise a
+      // probe for its key would stop at the hole
+      const uint64_t home = buckets[i].hash_ & mask;
+      if (((i - home) & mask) >= ((i - hole) & mask)) {
+        buckets[hole] = buckets[i];
+        hole = i;
+      }
+    }
+    buckets[hole].num_values_ = 0;
+    buckets[hole].overflow_ = nullptr;
+    partition->num_keys_--;
+    num_keys_.fetch_sub(1);
+  }
+
+  // Returns true as soon as the predicate holds for a value
+  template <typename Predicate>
+  static bool AnyValue(const Bucket &bucket, Predicate predicate) {
+    const uint32_t num_inline = std::min(bucket.num_values_, INLINE_VALUES);
+    for (uint32_t i = 0; i < num_inline; i++) {
+      if (predicate(bucket.values_[i])) return true;
+    }
+    for (const OverflowPage *page = bucket.overflow_; page != nullptr; page = page->next_) {
+      for (uint32_t i = 0; i < page->num_values_; i++) {
+        if (predicate(page->values_[i])) return true;
+      }
+    }
+    return false;
+  }
+
+  static ValueType *FindValue(Bucket *const bucket, const ValueType &value) {
+    const uint32_t num_inline = std::min(bucket->num_values_, INLINE_VALUES);
+    for (uint32_t i = 0; i < num_inline; i++) {
+      if (bucket->values_[i] == value) return &bucket->values_[i];
+    }
+    for (OverflowPage *page = bucket->overflow_; page != nullptr; page = page->next_) {
+      for (uint32_t i = 0; i < page->num_values_; i++) {
+        if (page->values_[i] == value) return &page->values_[i];
+      }
+    }
+    return nullptr;
+  }
+
+  static ValueType *LastValue(Bucket *const bucket) {
+    if (bucket->overflow_ != nullptr) return &bucket->overflow_->values_[bucket->overflow_->num_values_ - 1];
+    return &bucket->values_[bucket->num_values_ - 1];
+  }
+
+  void AppendValue(Bucket *const bucket, const ValueType &value) {
+    if (bucket->num_values_ < INLINE_VALUES) {
+      bucket->values_[bucket->num_values_++] = value;
+      return;
+    }
+    if (bucket->overflow_ == nullptr || bucket->overflow_->num_values_ == OVERFLOW_PAGE_VALUES) {
+      auto *const page = new OverflowPage;
+      page->next_ = bucket->overflow_;
+      page->num_values_ = 0;
+      bucket->overflow_ = page;
+      num_overflow_pages_.fetch_add(1);
+    }
+    bucket->overflow_->values_[bucket->overflow_->num_values_++] = value;
+    bucket->num_values_++;
+  }
+
+  void RemoveLastValue(Bucket *const bucket) {
+    OverflowPage *const page = bucket->overflow_;
+    if (page != nullptr && --page->num_values_ == 0) {
+      bucket->overflow_ = page->next_;
+      delete page;
+      num_overflow_pages_.fetch_sub(1);
+    }
+    bucket->num_values_--;
+  }
+
+  static constexpr uint32_t PARTITION_BITS = 6;
+  static_assert(NUM_PARTITIONS == 1U << PARTITION_BITS, "Partitions are picked by the upper bits of the hash.");
+
+  Partition partitions_[NUM_PARTITIONS];
+  std::atomic<uint64_t> num_keys_ = 0;
+  std::atomic<uint64_t> num_overflow_pages_ = 0;
+};
+
+}  // namespace noisepage::storage::index
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -43,6 +44,8 @@ class Index {
    * @return true if tuple is visible to this txn, false otherwise
    */
   static bool IsVisible(const transaction::TransactionContext &txn, const TupleSlot slot) {
+    // Index entries into an all-visible block point to tuples that every transaction sees
+    if (slot.GetBlock()->visibility_.AllVisible()) return true;
     const auto *const data_table = slot.GetBlock()->data_table_;
     return data_table->IsVisible(txn, slot);
   }
@@ -115,6 +118,20 @@ class Index {
   virtual void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                        std::vector<TupleSlot> *value_list) = 0;
 
+  /**
+   * Finds all the values associated with each of the given keys. By default the keys are looked up one at a time,
+   * indexes override this to overlap the lookups.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param[out] value_lists the values associated with each key, in the order of the keys
+   */
+  virtual void ScanKeyBatch(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                            std::vector<std::vector<TupleSlot>> *value_lists) {
+    value_lists->clear();
+    value_lists->resize(keys.size());
+    for (uint32_t i = 0; i < keys.size(); i++) ScanKey(txn, *keys[i], &(*value_lists)[i]);
+  }
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -131,6 +148,37 @@ class Index {
     NOISEPAGE_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
   }
 
+  /**
+   * @return true if the index can return the keys of its values with ScanAscendingWithKeys(), false otherwise
+   */
+  virtual bool SupportsKeyScans() const { return false; }
+
+  /**
+   * @return number of 8-byte words that ScanAscendingWithKeys() uses for each key
+   */
+  uint32_t KeyScanWords() const {
+    return static_cast<uint32_t>((GetProjectedRowInitializer().ProjectedRowSize() + sizeof(uint64_t) - 1) /
+                                 sizeof(uint64_t));
+  }
+
+  /**
+   * Finds all the values between the given keys in our index, sorted in ascending order, along with their keys.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param scan_type Scan Type
+   * @param num_attrs Number of attributes to compare
+   * @param low_key the key to start at
+   * @param high_key the key to end at
+   * @param limit if any
+   * @param[out] value_list the values associated with the keys
+   * @param[out] key_list the key of each value, as a ProjectedRow of GetProjectedRowInitializer() that starts at word
+   *                      i * KeyScanWords() for the i-th value
+   */
+  virtual void ScanAscendingWithKeys(const transaction::TransactionContext &txn, ScanType scan_type,
+                                     uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
+                                     std::vector<TupleSlot> *value_list, std::vector<uint64_t> *key_list) {
+    NOISEPAGE_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
+  }
+
   /**
    * Finds all the values between the given keys in our index, sorted in descending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -156,6 +204,56 @@ class Index {
     NOISEPAGE_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
   }
 
+  /**
+   * Function that orders two bulk load entries by their keys, returning a negative number, zero, or a positive number
+   * if the first key is less than, equal to, or greater than the second key.
+   */
+  using BulkLoadComparison = int32_t (*)(const void *lhs, const void *rhs);
+
+  /**
+   * @return true if the index can be built with BulkLoad(), false otherwise
+   */
+  virtual bool SupportsBulkLoad() const { return false; }
+
+  /**
+   * @return size in bytes of the entries consumed by BulkLoad()
+   */
+  virtual uint32_t BulkLoadEntrySize() const {
+    NOISEPAGE_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
+    return 0;
+  }
+
+  /**
+   * @return function that orders bulk load entries by their keys, used to sort the entries before BulkLoad()
+   */
+  virtual BulkLoadComparison GetBulkLoadComparison() const {
+    NOISEPAGE_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
+    return nullptr;
+  }
+
+  /**
+   * Writes a key-value pair into a bulk load entry.
+   * @param tuple key
+   * @param location value
+   * @param[out] entry memory of BulkLoadEntrySize() bytes that the entry is written into
+   */
+  virtual void SetBulkLoadEntry(const ProjectedRow &tuple, TupleSlot location, byte *entry) const {
+    NOISEPAGE_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
+  }
+
+  /**
+   * Builds an empty index from bulk load entries, which is much cheaper than inserting the key-value pairs one by one.
+   * @param txn txn context for the calling txn, used to register abort actions
+   * @param next_entry returns the next entry in the order of GetBulkLoadComparison(), or nullptr once all entries are
+   *                   consumed. An entry only needs to stay valid until the next call.
+   * @return false if the index is unique and two entries have the same key, true otherwise
+   */
+  virtual bool BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                        const std::function<const byte *()> &next_entry) {
+    NOISEPAGE_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
+    return false;
+  }
+
   /**
    * @return mapping from key oid to projected row offset
    */
@@ -30,9 +30,34 @@ class AbstractLogProvider {
    * provided.
    */
   std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
-    return HasMoreRecords() ? ReadNextRecord() : std::make_pair(nullptr, std::vector<byte *>());
+    while (HasMoreRecords()) {
+      auto record = ReadNextRecord();
+      // Watermarks are taken in by the provider, and do not come out as records
+      if (record.first != nullptr) return record;
+    }
+    return std::make_pair(nullptr, std::vector<byte *>());
   }
 
+  /**
+   * Called with the oldest active txn of every commit record provided. Every committed txn that started before the
+   * oldest active txn of a commit record has been provided before that commit record, if the records come from a single
+   * log. A provider that interleaves several logs has to hold the bound back until it holds in every one of them.
+   * @param oldest_active_txn oldest active txn of the commit record that was just provided
+   * @return timestamp such that every committed txn that started before it has been provided
+   */
+  virtual transaction::timestamp_t ProvidedTxnsUpTo(transaction::timestamp_t oldest_active_txn) {
+    return oldest_active_txn;
+  }
+
+  /**
+   * A partitioned WAL only vouches for the commits that were durable in every partition (see DurableWatermark). The
+   * other commits provided were never acknowledged, and have to be treated as if they had not committed, as a commit
+   * they depend on may be lost.
+   * @return timestamp such that the txns that committed before it are durable, or INVALID_TXN_TIMESTAMP if every
+   * commit provided is
+   */
+  virtual transaction::timestamp_t DurableCommitsBefore() { return transaction::INVALID_TXN_TIMESTAMP; }
+
  protected:
   /**
    * @return true if provider has more records to provide. false otherwise
@@ -52,6 +77,12 @@ class AbstractLogProvider {
    */
   virtual bool Read(void *dest, uint32_t size) = 0;
 
+  /**
+   * Called with the watermark of every WATERMARK record read, in the order they were read
+   * @param watermark every txn of the log being read that committed before the watermark was durable
+   */
+  virtual void ReadWatermark(transaction::timestamp_t watermark) {}
+
  private:
   // TODO(Gus): Support a more fail-safe way than just throwing an exception
   /**
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/managed_pointer.h"
+#include "storage/storage_defs.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::catalog {
+class Catalog;
+class DatabaseCatalog;
+}  // namespace noisepage::catalog
+
+namespace noisepage::transaction {
+class TransactionContext;
+class TransactionManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::storage {
+class BufferedLogWriter;
+class LogManager;
+class SqlTable;
+
+/**
+ * The checkpoint manager takes fuzzy, non-blocking checkpoints of all user tables.
+ *
+ * A checkpoint is taken inside a single read-only transaction, so the MVCC version chains give it a consistent snapshot
+ * of every table as of the transaction's start timestamp while other transactions keep running. Rows are streamed out
+ * table by table in batches that follow the Arrow columnar layout of a compacted block: for every column, a validity
+ * bitmap followed by either the fixed-size values or, for varlens, an offsets array and the value bytes. The original
+ * TupleSlot of every row is written as well, so recovery can map log records written after the checkpoint onto the
+ * recovered tuples.
+ *
+ * The catalog tables hold raw pointers to tables, schemas and indexes, so they are not part of the checkpoint and are
+ * still rebuilt from the log. Recovery only skips the user table changes of transactions the checkpoint covers, i.e.
+ * transactions that committed before the checkpoint timestamp.
+ *
+ * The file is written to a temporary path and renamed into place once it has been persisted, so a crash while taking
+ * a checkpoint leaves the previous checkpoint intact.
+ *
+ * Once a checkpoint is published, the log can be truncated: the log files are sealed into segments, and the segments
+ * that only hold transactions recovery skips with the checkpoint are deleted. From then on, recovery needs the
+ * checkpoint. The checkpoint thread truncates the log after every checkpoint.
+ */
+class CheckpointManager {
+ public:
+  /** Magic number at the start of a checkpoint file ("NPCK"). */
+  static constexpr uint32_t CHECKPOINT_MAGIC = 0x4B43504E;
+  /** Version of the checkpoint file format. */
+  static constexpr uint8_t CHECKPOINT_FORMAT_VERSION = 1;
+  /** Maximum number of tuples in a single checkpointed batch. */
+  static constexpr uint32_t CHECKPOINT_BATCH_SIZE = 1024;
+
+  /** Markers that delimit the sections of a checkpoint file. */
+  enum class CheckpointMarker : uint8_t { END = 0, TABLE, BATCH, TABLE_END };
+
+  /**
+   * @param catalog catalog used to find the tables to checkpoint
+   * @param txn_manager transaction manager used to begin the snapshot transaction
+   * @param log_manager log manager to flush before a checkpoint is published, DISABLED if logging is disabled
+   */
+  CheckpointManager(common::ManagedPointer<catalog::Catalog> catalog,
+                    common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                    common::ManagedPointer<LogManager> log_manager)
+      : catalog_(catalog), txn_manager_(txn_manager), log_manager_(log_manager) {}
+
+  ~CheckpointManager() {
+    if (run_checkpoints_) StopCheckpointThread();
+  }
+
+  /**
+   * Take a checkpoint of all user tables. This does not block concurrent transactions.
+   * @param checkpoint_file_path path of the checkpoint file, replaced atomically once the checkpoint is persisted
+   * @return the checkpoint timestamp. Exactly the changes of transactions that committed before it are checkpointed.
+   */
+  transaction::timestamp_t TakeCheckpoint(const std::string &checkpoint_file_path);
+
+  /**
+   * Delete the log segments that recovery from the given checkpoint does not need: those that only hold transactions
+   * that aborted, or that committed before the checkpoint timestamp without changing the catalog. Transactions still
+   * in flight keep their segments until a later truncation.
+   * @pre logging is enabled, and the checkpoint at the given timestamp has been published
+   * @param checkpoint_ts timestamp of the published checkpoint
+   * @return number of segments deleted
+   */
+  uint64_t TruncateLog(transaction::timestamp_t checkpoint_ts);
+
+  /**
+   * Spawn a thread that takes a checkpoint at a fixed interval, and truncates the log after it if logging is enabled.
+   * A failed checkpoint is logged and retried in the next period.
+   * @param checkpoint_file_path path of the checkpoint file
+   * @param checkpoint_period sleep time between checkpoints
+   */
+  void StartCheckpointThread(const std::string &checkpoint_file_path, std::chrono::seconds checkpoint_period);
+
+  /** Stop the checkpoint thread, waiting for a checkpoint in progress to finish. */
+  void StopCheckpointThread();
+
+  /** @return the timestamp of the last checkpoint taken by this manager, INVALID_TXN_TIMESTAMP if none */
+  transaction::timestamp_t GetLastCheckpointTimestamp() const { return last_checkpoint_ts_.load(); }
+
+ private:
+  const common::ManagedPointer<catalog::Catalog> catalog_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const common::ManagedPointer<LogManager> log_manager_;
+
+  std::atomic<transaction::timestamp_t> last_checkpoint_ts_{transaction::INVALID_TXN_TIMESTAMP};
+
+  volatile bool run_checkpoints_ = false;
+  std::string checkpoint_file_path_;
+  std::chrono::seconds checkpoint_period_{0};
+  std::thread checkpoint_thread_;
+
+  void CheckpointThreadLoop();
+
+  /** Delete the segments of one partition of the log that recovery from the checkpoint does not need */
+  uint64_t TruncateLogPartition(const std::string &log_file_path, transaction::timestamp_t checkpoint_ts);
+
+  /** @return the oids and catalogs of all databases visible to the given transaction */
+  std::vector<std::pair<catalog::db_oid_t, catalog::DatabaseCatalog *>> GetDatabases(
+      common::ManagedPointer<transaction::TransactionContext> txn);
+
+  /** @return the oids and pointers of all user tables in the given database that are visible to the transaction */
+  std::vector<std::pair<catalog::table_oid_t, SqlTable *>> GetUserTables(
+      common::ManagedPointer<transaction::TransactionContext> txn,
+      common::ManagedPointer<catalog::DatabaseCatalog> dbc);
+
+  /** Stream all rows of a table that are visible to the transaction to the checkpoint file */
+  void CheckpointTable(common::ManagedPointer<transaction::TransactionContext> txn, catalog::db_oid_t db_oid,
+                       catalog::table_oid_t table_oid, common::ManagedPointer<catalog::DatabaseCatalog> dbc,
+                       common::ManagedPointer<SqlTable> table, BufferedLogWriter *out);
+};
+
+}  // namespace noisepage::storage
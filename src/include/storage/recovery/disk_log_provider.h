@@ -1,6 +1,12 @@
 #pragma once
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/write_ahead_log/log_io.h"
@@ -11,24 +17,82 @@ namespace noisepage::storage {
  * @brief Log provider for logs stored on disk
  * Provides logs to the recovery manager from logs persisted on disk. The log file is read in using the
  * BufferedLogReader.
+ *
+ * The log files of a partitioned WAL are read one record at a time from each in turn. A partition's commit records
+ * only vouch for the transactions of that partition read so far, so the bound on the transactions provided is the
+ * oldest of the oldest active txns last read from each partition that still has records.
+ *
+ * After a crash, the partitions end at uneven points. Only the commits before the watermark last read from every
+ * partition are known to be durable in all of them (see DurableWatermark), so recovery replays those alone.
+ *
+ * A partition is read from its sealed segments in the order they were sealed, followed by its log file.
  */
 class DiskLogProvider : public AbstractLogProvider {
  public:
   /**
    * @param log_file_path path to log file to read logs from
+   * @param num_partitions number of partitions of the WAL that wrote the log file
    */
-  explicit DiskLogProvider(const std::string &log_file_path) : in_(BufferedLogReader(log_file_path.c_str())) {}
+  explicit DiskLogProvider(const std::string &log_file_path, const uint32_t num_partitions = 1)
+      : files_(num_partitions), in_(num_partitions),
+        oldest_active_txns_(num_partitions, transaction::INITIAL_TXN_TIMESTAMP),
+        watermarks_(num_partitions, transaction::INITIAL_TXN_TIMESTAMP) {
+    for (uint32_t partition = 0; partition < num_partitions; partition++) {
+      const std::string partition_file_path = LogPartitionFilePath(log_file_path, partition);
+      for (const auto segment : LogSegments(partition_file_path)) {
+        files_[partition].emplace_back(LogSegmentFilePath(partition_file_path, segment));
+      }
+      // A crash right after the log file was sealed leaves no log file behind, as it is only created on the next write.
+      // Without any segments, a missing log file is still an error.
+      if (files_[partition].empty() || access(partition_file_path.c_str(), F_OK) == 0) {
+        files_[partition].emplace_back(partition_file_path);
+      }
+    }
+  }
 
   LogProviderType GetType() const override { return LogProviderType::DISK; }
 
+  transaction::timestamp_t ProvidedTxnsUpTo(const transaction::timestamp_t oldest_active_txn) override {
+    if (in_.size() == 1) return oldest_active_txn;
+    oldest_active_txns_[current_] = std::max(oldest_active_txns_[current_], oldest_active_txn);
+    auto result = transaction::INVALID_TXN_TIMESTAMP;
+    for (uint32_t partition = 0; partition < in_.size(); partition++) {
+      if (PartitionHasMore(partition)) result = std::min(result, oldest_active_txns_[partition]);
+    }
+    return result;
+  }
+
+  transaction::timestamp_t DurableCommitsBefore() override {
+    if (in_.size() == 1) return transaction::INVALID_TXN_TIMESTAMP;
+    return *std::min_element(watermarks_.cbegin(), watermarks_.cend());
+  }
+
  private:
-  // Buffered log file reader
-  storage::BufferedLogReader in_;
+  // Files of each partition that are left to be read, in order
+  std::vector<std::deque<std::string>> files_;
+  // Buffered reader of the file each partition is read from, nullptr before the first file is opened
+  std::vector<std::unique_ptr<BufferedLogReader>> in_;
+  // Partition the current record is read from
+  uint32_t current_ = 0;
+  // Newest oldest active txn read from each partition
+  std::vector<transaction::timestamp_t> oldest_active_txns_;
+  // Last watermark read from each partition
+  std::vector<transaction::timestamp_t> watermarks_;
 
   /**
+   * Moves on to the next partition that has records
    * @return true if log file contains more records, false otherwise
    */
-  bool HasMoreRecords() override { return in_.HasMore(); }
+  bool HasMoreRecords() override {
+    for (uint32_t i = 1; i <= in_.size(); i++) {
+      const auto partition = static_cast<uint32_t>((current_ + i) % in_.size());
+      if (PartitionHasMore(partition)) {
+        current_ = partition;
+        return true;
+      }
+    }
+    return false;
+  }
 
   /**
    * Read data from the log file into the destination provided
@@ -36,7 +100,24 @@ class DiskLogProvider : public AbstractLogProvider {
    * @param size number of bytes to read
    * @return true if we read the given number of bytes
    */
-  bool Read(void *dest, uint32_t size) override { return in_.Read(dest, size); }
+  bool Read(void *dest, uint32_t size) override { return in_[current_]->Read(dest, size); }
+
+  void ReadWatermark(const transaction::timestamp_t watermark) override { watermarks_[current_] = watermark; }
+
+  /**
+   * Moves on to the next file of the partition once the current one is read
+   * @param partition partition of the WAL
+   * @return true if the partition has more records, false otherwise
+   */
+  bool PartitionHasMore(const uint32_t partition) {
+    // Records never span files, since the log file is only sealed at a record boundary (see LogManager::RotateLogFile)
+    while (in_[partition] == nullptr || !in_[partition]->HasMore()) {
+      if (files_[partition].empty()) return false;
+      in_[partition] = std::make_unique<BufferedLogReader>(files_[partition].front().c_str());
+      files_[partition].pop_front();
+    }
+    return true;
+  }
 };
 
 }  // namespace noisepage::storage
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <chrono>  // NOLINT
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -18,8 +22,11 @@
 #include "catalog/postgres/pg_namespace.h"
 #include "catalog/postgres/pg_type.h"
 #include "common/dedicated_thread_owner.h"
+#include "common/spin_latch.h"
+#include "common/worker_pool.h"
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/sql_table.h"
+#include "storage/write_ahead_log/log_io.h"
 
 namespace noisepage {
 class RecoveryBenchmark;
@@ -125,6 +132,28 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   /** @return The ID of the last transaction that was applied. */
   transaction::timestamp_t GetLastAppliedTransactionId() const { return last_applied_txn_id_; }
 
+  /**
+   * Recover from a checkpoint taken by the CheckpointManager before applying the log on top of it. The changes that
+   * transactions covered by the checkpoint made to user tables are skipped in the log, since the checkpoint already
+   * contains them. Must be called before StartRecovery().
+   * @param checkpoint_file_path path to the checkpoint file
+   */
+  void UseCheckpoint(const std::string &checkpoint_file_path);
+
+  /** @return The timestamp of the checkpoint used for recovery, INVALID_TXN_TIMESTAMP if none. */
+  transaction::timestamp_t GetCheckpointTimestamp() const { return checkpoint_ts_; }
+
+  /**
+   * Replay transactions that only modify user tables in parallel. Transactions are grouped into rounds of
+   * non-conflicting transactions, i.e. ones that touch disjoint tuple slots and do not mix deletes and writes on the
+   * same table. The transactions of a round are applied on a pool of workers, but still commit in the serial replay
+   * order so readers never see a transaction without the ones replayed before it. Catalog changes are always replayed
+   * serially.
+   * Must be called before StartRecovery().
+   * @param num_workers number of replay workers, 0 to replay serially
+   */
+  void SetReplayThreads(uint32_t num_workers);
+
  private:
   FRIEND_TEST(RecoveryTests, DoubleRecoveryTest);
   friend class RecoveryTests;
@@ -166,6 +195,46 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   std::unordered_map<transaction::timestamp_t, std::vector<std::pair<LogRecord *, std::vector<byte *>>>>
       buffered_changes_map_;
 
+  // Used during recovery from a checkpoint. Reader for the checkpoint file, until the checkpoint has been loaded.
+  std::unique_ptr<BufferedLogReader> checkpoint_reader_;
+
+  // Used during recovery from a checkpoint. Transactions that committed before this timestamp are in the checkpoint.
+  transaction::timestamp_t checkpoint_ts_ = transaction::INVALID_TXN_TIMESTAMP;
+
+  // Used during recovery from a checkpoint. Committed transactions covered by the checkpoint whose changes to user
+  // tables should be skipped when they are replayed.
+  std::unordered_set<transaction::timestamp_t> checkpointed_txns_;
+
+  // Used during recovery from a checkpoint. Committed transactions that are not covered by the checkpoint, and are
+  // replayed in serial order once the checkpoint has been loaded.
+  std::set<transaction::timestamp_t> checkpoint_tail_txns_;
+
+  // Used during recovery from a partitioned log. Committed transactions whose commits are not known to be durable in
+  // every partition yet, by commit timestamp. They are deferred in commit order once they are, and dropped like
+  // unfinished transactions if the log ends before.
+  std::map<transaction::timestamp_t, transaction::timestamp_t> undurable_txns_;
+
+  // Used during parallel replay. Workers applying the transactions of a round, nullptr when replaying serially.
+  std::unique_ptr<common::WorkerPool> replay_workers_;
+
+  // Used during parallel replay. Protects tuple_slot_map_, which is accessed by all replay workers.
+  common::SpinLatch tuple_slot_map_latch_;
+
+  // Used during parallel replay. Deferred transactions are only replayed once there are at least this many of them (or
+  // at the end of the logs), so rounds are large enough to be worth parallelizing.
+  static constexpr uint32_t PARALLEL_REPLAY_MIN_BATCH_SIZE = 64;
+
+  // Used during parallel replay. Deferred transactions are also replayed once this long has passed since the last
+  // round, so that a replica under a low write rate does not hold them back until the batch fills up.
+  static constexpr std::chrono::milliseconds PARALLEL_REPLAY_MAX_DELAY{10};
+
+  // Used during parallel replay. When the last round of deferred transactions was replayed.
+  std::chrono::steady_clock::time_point last_replay_ = std::chrono::steady_clock::now();
+
+  // Used during parallel replay. The upper bound given by the last commit record or OAT, up to which deferred
+  // transactions are safe to replay when the delay runs out.
+  transaction::timestamp_t replayable_up_to_ = transaction::INITIAL_TXN_TIMESTAMP;
+
   // Background recovery task
   common::ManagedPointer<RecoveryTask> recovery_task_ = nullptr;
   /**
@@ -186,18 +255,96 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   uint32_t recovered_txns_ = 0;  ///< The number of recovered committed txns.
 
   /**
-   * Recovers the databases using the provided log provider
+   * Recovers the databases using the provided checkpoint and log provider
    */
   void Recover() {
     if (log_provider_ != nullptr) RecoverFromLogs(log_provider_);
+    // Without any logs, the checkpoint has not been loaded yet
+    if (checkpoint_reader_ != nullptr) RecoverFromCheckpoint();
   }
 
   /**
-   * Recovers the databases from the logs.
-   * @note this is a separate method so in the future, we can also have a RecoverFromCheckpoint method
+   * Recovers the databases from the logs. If a checkpoint is used, it is loaded as soon as all the transactions it
+   * covers have been replayed, and the remaining transactions are replayed after it as they are read.
    */
   void RecoverFromLogs(common::ManagedPointer<AbstractLogProvider> log_provider_);
 
+  /**
+   * Loads the rows of all user tables from the checkpoint. The catalog changes of all transactions covered by the
+   * checkpoint must have been replayed already, so that the checkpointed tables exist.
+   */
+  void RecoverFromCheckpoint();
+
+  /**
+   * Loads the checkpoint, and defers the committed transactions read so far that are not covered by it
+   */
+  void LoadCheckpointAndTail();
+
+  /**
+   * Defers a committed transaction, to be replayed once it is safe to. If it is not covered by the checkpoint, it is
+   * replayed after the checkpoint has been loaded.
+   * @param txn_id start timestamp of the transaction
+   * @param commit_time commit timestamp of the transaction
+   */
+  void DeferCommittedTransaction(transaction::timestamp_t txn_id, transaction::timestamp_t commit_time);
+
+  /**
+   * Defers the transactions held back in undurable_txns_ that committed before the given timestamp
+   * @param durable_before timestamp such that every transaction that committed before it is durable
+   */
+  void DeferDurableTransactions(transaction::timestamp_t durable_before);
+
+  /**
+   * Loads one batch of checkpointed rows into a table, and maps their original tuple slots to the recovered ones
+   * @param db_oid database oid of the table
+   * @param table_oid oid of the table
+   * @param col_oids oids of the checkpointed columns
+   * @param attr_sizes attribute sizes of the checkpointed columns, VARLEN_COLUMN for varlens
+   */
+  void RecoverCheckpointBatch(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid,
+                              const std::vector<catalog::col_oid_t> &col_oids, const std::vector<uint16_t> &attr_sizes);
+
+  /**
+   * Read the given number of bytes from the checkpoint file
+   * @param dest pointer to location to read into
+   * @param size number of bytes to read
+   * @throw std::runtime_error if the checkpoint file does not have enough bytes left
+   */
+  void ReadCheckpoint(void *dest, uint32_t size) {
+    if (!checkpoint_reader_->Read(dest, size)) throw std::runtime_error("Checkpoint file is truncated");
+  }
+
+  /**
+   * @tparam T type of value to read
+   * @return the value read from the checkpoint file
+   */
+  template <class T>
+  T ReadCheckpointValue() {
+    T result;
+    ReadCheckpoint(&result, sizeof(T));
+    return result;
+  }
+
+  /**
+   * @param record redo or delete record
+   * @return true if the record modifies a user table, whose contents can be restored from a checkpoint
+   */
+  static bool IsUserTableRecord(const LogRecord *record) {
+    const auto table_oid = record->RecordType() == LogRecordType::REDO
+                               ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid()
+                               : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+    return !IsCatalogTable(table_oid);
+  }
+
+  /**
+   * @param table_oid oid of a table
+   * @return true if the table is a catalog table
+   */
+  static bool IsCatalogTable(catalog::table_oid_t table_oid) {
+    // All catalog tables have OIDS less than START_OID
+    return table_oid.UnderlyingValue() < catalog::START_OID;
+  }
+
   /**
    * @brief Replay a committed transaction corresponding to txn_id.
    * @param txn_id start timestamp for committed transaction
@@ -205,6 +352,26 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    */
   uint32_t ProcessCommittedTransaction(transaction::timestamp_t txn_id);
 
+  /**
+   * Cleans up after a committed transaction was replayed, and acknowledges it to the replication manager
+   * @param txn_id start timestamp for committed transaction
+   */
+  void FinishCommittedTransaction(transaction::timestamp_t txn_id);
+
+  /**
+   * Replay committed transactions in the given order, applying rounds of non-conflicting transactions in parallel
+   * @param txn_ids start timestamps of the committed transactions, in serial replay order
+   * @return number of records replayed
+   */
+  uint32_t ProcessCommittedTransactionsInParallel(const std::vector<transaction::timestamp_t> &txn_ids);
+
+  /**
+   * Replay a round of non-conflicting transactions on the replay workers. They commit in the given order.
+   * @param txn_ids start timestamps of the committed transactions, in serial replay order
+   * @return number of records replayed
+   */
+  uint32_t ProcessReplayRound(const std::vector<transaction::timestamp_t> &txn_ids);
+
   /**
    * Defers log records deletes with the transaction manager
    * @param txn_id txn_id for txn who's records to delete
@@ -226,6 +393,7 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @return new tuple slot
    */
   TupleSlot GetTupleSlotMapping(TupleSlot slot) {
+    common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
     NOISEPAGE_ASSERT(tuple_slot_map_.find(slot) != tuple_slot_map_.end(), "No tuple slot mapping exists");
     return tuple_slot_map_[slot];
   }
@@ -234,14 +402,18 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * Wrapper over GetDatabaseCatalog method that asserts the database exists
    * @param txn txn for catalog lookup
    * @param database oid for database we want
+   * @param lock true to take the DDL lock of the database. Changes to user tables do not need it, which lets them be
+   * replayed by concurrent transactions.
    * @return pointer to database catalog
    */
   common::ManagedPointer<catalog::DatabaseCatalog> GetDatabaseCatalog(transaction::TransactionContext *txn,
-                                                                      catalog::db_oid_t db_oid) {
+                                                                      catalog::db_oid_t db_oid, bool lock = true) {
     auto db_catalog_ptr = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
     NOISEPAGE_ASSERT(db_catalog_ptr != nullptr, "No catalog for given database oid");
-    auto result UNUSED_ATTRIBUTE = db_catalog_ptr->TryLock(common::ManagedPointer(txn));
-    NOISEPAGE_ASSERT(result, "There should not be concurrent DDL changes during recovery.");
+    if (lock) {
+      auto result UNUSED_ATTRIBUTE = db_catalog_ptr->TryLock(common::ManagedPointer(txn));
+      NOISEPAGE_ASSERT(result, "There should not be concurrent DDL changes during recovery.");
+    }
     return db_catalog_ptr;
   }
 
@@ -315,7 +487,8 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param record record we want to determine redo type of
    * @return true if record is an insert redo, false if it is an update redo
    */
-  bool IsInsertRecord(const RedoRecord *record) const {
+  bool IsInsertRecord(const RedoRecord *record) {
+    common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
     return tuple_slot_map_.find(record->GetTupleSlot()) == tuple_slot_map_.end();
   }
 
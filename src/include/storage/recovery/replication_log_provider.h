@@ -1,11 +1,15 @@
 #pragma once
 
+#include <chrono>  // NOLINT
+#include <cstring>
 #include <memory>
 #include <queue>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "loggers/replication_logger.h"
 #include "network/network_io_utils.h"
 #include "replication/replication_messages.h"
 #include "storage/recovery/abstract_log_provider.h"
@@ -23,7 +27,8 @@ class ReplicationLogProvider final : public AbstractLogProvider {
   enum class ReplicationEvent : uint8_t {
     END = 0,  ///< Replication ended.
     LOGS,     ///< Unprocessed replication logs (ReplicateBatchMsg) available.
-    OAT       ///< Unprocessed oldest active txn (NotifyOATMsg) available.
+    OAT,      ///< Unprocessed oldest active txn (NotifyOATMsg) available.
+    TIMEOUT   ///< Nothing became available before the deadline.
   };
 
   LogProviderType GetType() const override { return LogProviderType::REPLICATION; }
@@ -35,11 +40,24 @@ class ReplicationLogProvider final : public AbstractLogProvider {
     replication_cv_.notify_all();
   }
 
-  /** Add the batch of records to the log provider. */
+  /**
+   * Add the batch of records to the log provider. A batch that is a block of a compressed WAL is decompressed right
+   * away, so that a corrupted batch ends replication before any of its records are read, instead of in the middle of a
+   * record. No batch after a corrupted one can be applied either.
+   */
   void AddBatchOfRecords(const replication::RecordsBatchMsg &msg) {
+    std::string_view contents = msg.GetContents();
+    std::vector<unsigned char> records;
+    if (!msg.IsCompressed()) {
+      records.assign(contents.begin(), contents.end());
+    } else if (!DecompressBatch(contents, &records)) {
+      REPLICATION_LOG_ERROR(fmt::format("Corrupted log block in BATCH {}, ending replication", msg.GetBatchId()));
+      EndReplication();
+      return;
+    }
     {
       std::unique_lock<std::mutex> lock(replication_latch_);
-      received_batch_queue_.emplace(msg);
+      received_batch_queue_.emplace(ReceivedBatch{msg.GetBatchId(), std::move(records)});
     }
     replication_cv_.notify_all();
   }
@@ -60,7 +78,14 @@ class ReplicationLogProvider final : public AbstractLogProvider {
    * Block until a replication event is available; either replication ended, logs are received, or an OAT is available.
    * @return The type of replication event that became available.
    */
-  ReplicationEvent WaitUntilEvent() {
+  ReplicationEvent WaitUntilEvent() { return WaitUntilEvent(std::chrono::steady_clock::time_point::max()); }
+
+  /**
+   * Block until a replication event is available or the deadline passes, whichever comes first.
+   * @param deadline The time after which to stop waiting.
+   * @return The type of replication event that became available, TIMEOUT if none did by the deadline.
+   */
+  ReplicationEvent WaitUntilEvent(const std::chrono::steady_clock::time_point deadline) {
     std::unique_lock<std::mutex> lock(replication_latch_);
     while (true) {
       // The order here matters. Due to the AbstractLogProvider framework that was inherited, returning LOGS without
@@ -69,8 +94,14 @@ class ReplicationLogProvider final : public AbstractLogProvider {
       if (!replication_active_) return ReplicationEvent::END;
       if (OATReady()) return ReplicationEvent::OAT;
       if (NonBlockingHasMoreRecords() || NextBatchReady()) return ReplicationEvent::LOGS;
-      replication_cv_.wait(
-          lock, [&] { return !replication_active_ || NonBlockingHasMoreRecords() || NextBatchReady() || OATReady(); });
+      const auto event_ready = [&] {
+        return !replication_active_ || NonBlockingHasMoreRecords() || NextBatchReady() || OATReady();
+      };
+      if (deadline == std::chrono::steady_clock::time_point::max()) {
+        replication_cv_.wait(lock, event_ready);
+      } else if (!replication_cv_.wait_until(lock, deadline, event_ready)) {
+        return ReplicationEvent::TIMEOUT;
+      }
     }
   }
 
@@ -102,9 +133,15 @@ class ReplicationLogProvider final : public AbstractLogProvider {
   }
 
  private:
+  /** The records of a batch that was received. */
+  struct ReceivedBatch {
+    replication::record_batch_id_t batch_id_;  ///< The batch ID of the batch.
+    std::vector<unsigned char> records_;       ///< The records of the batch, decompressed if need be.
+  };
+
   /** @return True if left > right. False otherwise. */
-  static bool CompareBatches(const replication::RecordsBatchMsg &left, const replication::RecordsBatchMsg &right) {
-    return left.GetBatchId() > right.GetBatchId();
+  static bool CompareBatches(const ReceivedBatch &left, const ReceivedBatch &right) {
+    return left.batch_id_ > right.batch_id_;
   }
 
   /** A pair of OAT and associated batch ID that must be processed before the OAT. */
@@ -122,10 +159,10 @@ class ReplicationLogProvider final : public AbstractLogProvider {
     if (received_batch_queue_.empty()) {
       return false;
     }
-    NOISEPAGE_ASSERT(received_batch_queue_.top().GetBatchId() > last_batch_popped_, "Duplicate batch added?");
+    NOISEPAGE_ASSERT(received_batch_queue_.top().batch_id_ > last_batch_popped_, "Duplicate batch added?");
     // The next batch is ready for application if the batch ID is consecutive.
     bool top_batch_is_next =
-        received_batch_queue_.top().GetBatchId() == replication::RecordsBatchMsg::NextBatchId(last_batch_popped_);
+        received_batch_queue_.top().batch_id_ == replication::RecordsBatchMsg::NextBatchId(last_batch_popped_);
     return top_batch_is_next;
   }
 
@@ -155,18 +192,16 @@ class ReplicationLogProvider final : public AbstractLogProvider {
 
       // Pop the next batch of records off into curr_buffer_.
       {
-        const replication::RecordsBatchMsg &msg = received_batch_queue_.top();
-        std::string contents = msg.GetContents();
-        std::vector<unsigned char> bytes(contents.begin(), contents.end());
-        network::ReadBufferView view(bytes.size(), bytes.begin());
+        const ReceivedBatch &batch = received_batch_queue_.top();
+        network::ReadBufferView view(batch.records_.size(), batch.records_.begin());
         auto buffer = std::make_unique<network::ReadBuffer>();
-        buffer->FillBufferFrom(view, bytes.size());
+        buffer->FillBufferFrom(view, batch.records_.size());
 
         NOISEPAGE_ASSERT((last_batch_popped_ == replication::INVALID_RECORD_BATCH_ID) ||
-                             (msg.GetBatchId() == replication::RecordsBatchMsg::NextBatchId(last_batch_popped_)),
+                             (batch.batch_id_ == replication::RecordsBatchMsg::NextBatchId(last_batch_popped_)),
                          "Batches are being added out of order?");
 
-        last_batch_popped_ = msg.GetBatchId();
+        last_batch_popped_ = batch.batch_id_;
         curr_buffer_ = std::move(buffer);
         received_batch_queue_.pop();
         replication_cv_.notify_one();
@@ -181,12 +216,37 @@ class ReplicationLogProvider final : public AbstractLogProvider {
     return (readable_size < size) ? Read(static_cast<char *>(dest) + readable_size, size - readable_size) : true;
   }
 
+  /**
+   * Decompress a batch that holds a block of the primary's WAL.
+   * @param contents contents of the batch
+   * @param[out] records the records of the batch
+   * @return True if the block was decompressed. False if it is corrupted.
+   */
+  static bool DecompressBatch(std::string_view contents, std::vector<unsigned char> *records) {
+    LogBlockHeader header;
+    if (contents.size() < sizeof(LogBlockHeader)) return false;
+    std::memcpy(&header, contents.data(), sizeof(LogBlockHeader));
+    if (contents.size() - sizeof(LogBlockHeader) != header.stored_size_ ||
+        header.raw_size_ > common::Constants::LOG_BUFFER_SIZE) {
+      return false;
+    }
+    records->resize(header.raw_size_);
+    try {
+      LogCompressor::DecodeBlock(header, contents.data() + sizeof(LogBlockHeader),
+                                 reinterpret_cast<char *>(records->data()), header.raw_size_);
+    } catch (const std::runtime_error &e) {
+      REPLICATION_LOG_ERROR(fmt::format("Failed to decompress replicated log block: {}", e.what()));
+      return false;
+    }
+    return true;
+  }
+
   bool replication_active_ = true;  ///< True if replication is currently active. False otherwise.
   std::unique_ptr<network::ReadBuffer> curr_buffer_ = nullptr;  ///< Current buffer to read logs from.
 
   /** The batches received from replication. */
-  std::priority_queue<replication::RecordsBatchMsg, std::vector<replication::RecordsBatchMsg>,
-                      std::function<bool(replication::RecordsBatchMsg, replication::RecordsBatchMsg)>>
+  std::priority_queue<ReceivedBatch, std::vector<ReceivedBatch>,
+                      std::function<bool(const ReceivedBatch &, const ReceivedBatch &)>>
       received_batch_queue_{CompareBatches};
   replication::record_batch_id_t last_batch_popped_ = replication::INVALID_RECORD_BATCH_ID;
   std::priority_queue<OATPair, std::vector<OATPair>, std::function<bool(OATPair, OATPair)>> oats_{CompareOATs};
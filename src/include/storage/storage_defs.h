@@ -5,14 +5,17 @@
 #include <ostream>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog_defs.h"
 #include "common/constants.h"
 #include "common/macros.h"
+#include "common/numa_util.h"
 #include "common/object_pool.h"
 #include "common/strong_typedef.h"
 #include "execution/sql/sql.h"
 #include "storage/block_access_controller.h"
+#include "storage/block_visibility.h"
 #include "transaction/transaction_defs.h"
 
 namespace noisepage::storage {
@@ -56,10 +59,10 @@ class alignas(common::Constants::BLOCK_SIZE) RawBlock {
   DataTable *data_table_;
 
   /**
-   * Padding for flags or whatever we may want in the future. Determined by size of layout_version below. See
-   * tuple_access_strategy.h for more details on Block header layout.
+   * NUMA node the memory of the block is placed on, set by the BlockStore. Determined by size of layout_version below.
+   * See tuple_access_strategy.h for more details on Block header layout.
    */
-  uint16_t padding_;
+  uint16_t numa_node_;
 
   /**
    * Layout version.
@@ -79,12 +82,17 @@ class alignas(common::Constants::BLOCK_SIZE) RawBlock {
    * and the transformation thread. In practice this can be used almost like a lock.
    */
   BlockAccessController controller_;
+  /**
+   * Whether every tuple in the block is visible to all transactions, so that index-only scans can skip reading its
+   * tuples.
+   */
+  BlockVisibility visibility_;
 
   /**
    * Contents of the raw block.
    */
   byte content_[common::Constants::BLOCK_SIZE - sizeof(uintptr_t) - sizeof(uint16_t) - sizeof(layout_version_t) -
-                sizeof(uint32_t) - sizeof(BlockAccessController)];
+                sizeof(uint32_t) - sizeof(BlockAccessController) - sizeof(BlockVisibility)];
   // A Block needs to always be aligned to 1 MB, so we can get free bytes to
   // store offsets within a block in one 8-byte word
 
@@ -165,36 +173,123 @@ class TupleSlot {
 };
 
 /**
- * Allocator that allocates a block
+ * Allocator of the memory of blocks. Blocks are carved out of chunks of CHUNK_SIZE bytes placed on a NUMA node. Chunks
+ * are backed by huge pages if the system has reserved any, and are advised to be backed by transparent huge pages
+ * otherwise. Deleting a block gives its physical memory back to the system, but its addresses stay mapped for later
+ * blocks of the same node until the allocator is destroyed.
+ *
+ * The allocator is not thread-safe, the BlockStore serializes calls to it.
  */
 class BlockAllocator {
  public:
-  /**
-   * Allocates a new object by calling its constructor.
-   * @return a pointer to the allocated object.
-   */
-  RawBlock *New() { return new RawBlock(); }
+  /** Size of the chunks blocks are carved out of, which is the size of a huge page */
+  static constexpr uint64_t CHUNK_SIZE = 2 * static_cast<uint64_t>(common::Constants::BLOCK_SIZE);
+
+  BlockAllocator() = default;
+
+  /** Unmaps the chunks of which every block was deleted. */
+  ~BlockAllocator();
+
+  DISALLOW_COPY_AND_MOVE(BlockAllocator);
 
   /**
-   * Reuse a reused chunk of memory to be handed out again
-   * @param reused memory location, possibly filled with junk bytes
+   * Allocates a new block on the given node.
+   * @param node NUMA node to place the block on
+   * @return a pointer to the block, or nullptr if the system is out of memory
    */
-  void Reuse(RawBlock *const reused) { /* no operation required */
-  }
+  RawBlock *New(uint32_t node);
 
   /**
-   * Deletes the object by calling its destructor.
-   * @param ptr a pointer to the object to be deleted.
+   * Deletes the block, and keeps its addresses for a later block on its node.
+   * @param block a pointer to the block to be deleted
    */
-  void Delete(RawBlock *const ptr) { delete ptr; }
+  void Delete(RawBlock *block);
+
+ private:
+  // Maps a new chunk on the node, and adds its blocks to the unused blocks of the node
+  bool MapChunk(uint32_t node);
+
+  std::vector<void *> chunks_;
+  // Mapped but unused blocks of each node
+  std::vector<RawBlock *> unused_[common::NumaUtil::MAX_NODES];
 };
 
 /**
- * A block store is essentially an object pool. However, all blocks should be
- * aligned, so we will need to use the default constructor instead of raw
- * malloc.
+ * A block store is an object pool of blocks, with the interface of common::ObjectPool. Blocks are placed on the NUMA
+ * node of the thread that asks for them, which is the thread that inserts into the table that the block goes to.
+ * Released blocks are kept on a free list per node for reuse on their node. A block of another node is only reused
+ * when the size limit does not allow for a new one.
  */
-using BlockStore = common::ObjectPool<RawBlock, BlockAllocator>;
+class BlockStore {
+ public:
+  /**
+   * Initializes a new block store with the supplied limit to the number of blocks reused.
+   * @param size_limit the maximum number of blocks the block store controls
+   * @param reuse_limit the maximum number of reusable blocks
+   */
+  BlockStore(uint64_t size_limit, uint64_t reuse_limit);
+
+  /**
+   * Destructs the block store. Frees any memory it holds.
+   *
+   * Beware that the block store will not deallocate blocks not explicitly released via a Release call.
+   */
+  ~BlockStore();
+
+  DISALLOW_COPY_AND_MOVE(BlockStore);
+
+  /**
+   * Returns a block on the node of the calling thread, if possible.
+   * @throw NoMoreObjectException if the block store has reached the limit of how many blocks it may hand out.
+   * @throw AllocatorFailureException if the allocator fails to return a valid memory address.
+   * @return pointer to the block
+   */
+  RawBlock *Get();
+
+  /**
+   * Releases the block given, allowing it to be freed or reused for later. Although the memory is not necessarily
+   * immediately reclaimed, it will be unsafe to access after entering this call.
+   * @param block pointer to the block to release
+   */
+  void Release(RawBlock *block);
+
+  /**
+   * Set the block store's size limit. The operation fails if the block store has already allocated more blocks than
+   * the size limit.
+   * @param new_size the new block store size
+   * @return true if new_size is successfully set and false the operation fails
+   */
+  bool SetSizeLimit(uint64_t new_size);
+
+  /**
+   * Set the reuse limit to a new value, freeing reusable blocks beyond it. This function always succeeds.
+   * @param new_reuse_limit the maximum number of reusable blocks
+   */
+  void SetReuseLimit(uint64_t new_reuse_limit);
+
+  /**
+   * @return size limit of the block store
+   */
+  uint64_t GetSizeLimit() const { return size_limit_; }
+
+  /**
+   * @param block a block handed out by a block store
+   * @return NUMA node the block is placed on
+   */
+  static uint32_t NodeOf(const RawBlock *const block) { return block->numa_node_; }
+
+ private:
+  BlockAllocator alloc_;
+  common::SpinLatch latch_;
+  // Reusable blocks of each node
+  std::vector<RawBlock *> reuse_lists_[common::NumaUtil::MAX_NODES];
+  uint64_t size_limit_;   // the maximum number of blocks the block store can have
+  uint64_t reuse_limit_;  // the maximum number of reusable blocks in reuse_lists_
+  // current_size_ represents the number of blocks the block store has allocated, including blocks that have been
+  // given out to callers and those that reside in reuse_lists_
+  uint64_t current_size_ = 0;
+  uint64_t num_reusable_ = 0;
+};
 /**
  * Used by SqlTable to map between col_oids in Schema and useful necessary information.
  */
@@ -210,9 +305,10 @@ using ProjectionMap = std::unordered_map<catalog::col_oid_t, uint16_t>;
 enum class DeltaRecordType : uint8_t { UPDATE = 0, INSERT, DELETE };
 
 /**
- * Types of LogRecords
+ * Types of LogRecords. A WATERMARK is never handed to recovery as a record: it is written into the log file of each
+ * partition of a partitioned WAL, to tell up to where the commits of the partition are durable (see DurableWatermark).
  */
-enum class LogRecordType : uint8_t { REDO = 1, DELETE, COMMIT, ABORT };
+enum class LogRecordType : uint8_t { REDO = 1, DELETE, COMMIT, ABORT, WATERMARK };
 
 }  // namespace noisepage::storage
 
@@ -8,6 +8,7 @@
 #include "storage/arrow_block_metadata.h"
 #include "storage/storage_defs.h"
 #include "storage/storage_util.h"
+#include "storage/zone_map.h"
 
 namespace noisepage::storage {
 
@@ -45,9 +46,11 @@ class TupleAccessStrategy {
   /*
    * Block Header layout:
    * -----------------------------------------------------------------------------------------------------------------
-   * | data_table *(64) | padding (16) | layout_version (16) | insert_head (32) |        control_block (64)          |
+   * | data_table *(64) | padding (16) | layout_version (16) | insert_head (32) | control_block (64) | visibility (64) |
    * -----------------------------------------------------------------------------------------------------------------
-   * | ArrowBlockMetadata | attr_offsets[num_col] (32) | bitmap for slots (64-bit aligned) | data (64-bit aligned)   |
+   * | ArrowBlockMetadata | attr_offsets[num_col] (32) | zone_maps[num_col] (64-bit aligned) |                        |
+   * -----------------------------------------------------------------------------------------------------------------
+   * | bitmap for slots (64-bit aligned) | data (64-bit aligned)                                                     |
    * -----------------------------------------------------------------------------------------------------------------
    *
    * Note that we will never need to span a tuple across multiple pages if we enforce
@@ -65,10 +68,15 @@ class TupleAccessStrategy {
       return reinterpret_cast<uint32_t *>(block_.content_ + ArrowBlockMetadata::Size(layout.NumColumns()));
     }
 
+    // return reference to the zone maps. Use as an array.
+    ZoneMap *ZoneMaps(const BlockLayout &layout) {
+      return reinterpret_cast<ZoneMap *>(
+          StorageUtil::AlignedPtr(sizeof(uint64_t), AttrOffsets(layout) + layout.NumColumns()));
+    }
+
     // return reference to the bitmap for slots. Use as a member
     common::RawConcurrentBitmap *SlotAllocationBitmap(const BlockLayout &layout) {
-      return reinterpret_cast<common::RawConcurrentBitmap *>(
-          StorageUtil::AlignedPtr(sizeof(uint64_t), AttrOffsets(layout) + layout.NumColumns()));
+      return reinterpret_cast<common::RawConcurrentBitmap *>(ZoneMaps(layout) + layout.NumColumns());
     }
 
     // return the miniblock for the column at the given offset.
@@ -135,6 +143,32 @@ class TupleAccessStrategy {
     return reinterpret_cast<Block *>(block)->Column(layout_, col_id)->ColumnStart(layout_, col_id);
   }
 
+  /**
+   * @param block block to access
+   * @param col_id id of the column
+   * @return the zone map of the column on the given block, only maintained for fixed-length columns
+   */
+  ZoneMap &GetZoneMap(RawBlock *block, const col_id_t col_id) const {
+    NOISEPAGE_ASSERT((col_id.UnderlyingValue()) < layout_.NumColumns(), "Column out of bounds!");
+    return reinterpret_cast<Block *>(block)->ZoneMaps(layout_)[col_id.UnderlyingValue()];
+  }
+
+  /**
+   * Widen the zone map of a column to cover a value that is about to be written into the given block. Does nothing
+   * for varlen columns.
+   * @param block block the value is written into
+   * @param col_id id of the column
+   * @param value pointer to the value, or nullptr if the value is null
+   */
+  void WidenZoneMap(RawBlock *block, const col_id_t col_id, const byte *value) const {
+    if (layout_.IsVarlen(col_id)) return;
+    ZoneMap &zone_map = GetZoneMap(block, col_id);
+    if (value == nullptr)
+      zone_map.AddNull();
+    else
+      zone_map.Widen(ZoneMap::ReadValue(value, layout_.AttrSize(col_id)));
+  }
+
   /**
    * @param slot tuple slot to access
    * @param col_id id of the column
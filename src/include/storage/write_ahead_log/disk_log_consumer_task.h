@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>  // NOLINT
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -8,6 +11,8 @@
 #include "common/container/concurrent_queue.h"
 #include "common/dedicated_thread_task.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/durable_watermark.h"
+#include "storage/write_ahead_log/log_compression.h"
 #include "storage/write_ahead_log/log_io.h"
 
 namespace noisepage::storage {
@@ -15,6 +20,15 @@ namespace noisepage::storage {
 /**
  * A DiskLogConsumerTask is responsible for writing serialized log records out to disk by processing buffers in the log
  * manager's filled buffer queue
+ *
+ * By default the log file is persisted on a timer. With group commit, it is persisted as soon as a committing
+ * transaction is waiting for it, unless the last persist began less than 1 / target IOPS ago, in which case the persist
+ * is deferred until then. Transactions that commit while a persist is in flight or deferred are persisted together by
+ * the next one, so batches grow with the commit rate while the persist rate stays at or below the target.
+ *
+ * The consumer of a partition of a partitioned WAL hands its commit callbacks to the DurableWatermark instead of
+ * invoking them, and writes its frontier into the log file when it persists. With group commit, it also persists when
+ * the watermark waits on it, as if a committer of its own was waiting.
  */
 class DiskLogConsumerTask : public common::DedicatedThreadTask {
  public:
@@ -22,21 +36,38 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
    * Constructs a new DiskLogConsumerTask
    * @param persist_interval Interval time for when to persist log file
    * @param persist_threshold threshold of data written since the last persist to trigger another persist
+   * @param group_commit_target_iops target number of persists per second for group commit, 0 to persist on the interval
    * @param buffers pointer to list of all buffers used by log manager, used to persist log file
    * @param empty_buffer_queue pointer to queue to push empty buffers to
    * @param filled_buffer_queue pointer to queue to pop filled buffers from
+   * @param log_file_path path of the log file the buffers write to, used to rotate the log file
+   * @param watermark durable watermark of a partitioned WAL, nullptr for a single partition
+   * @param partition partition of the WAL the task writes out
+   * @param compressor codec the buffers are compressed with, nullptr if they are not
    */
   explicit DiskLogConsumerTask(const std::chrono::microseconds persist_interval, uint64_t persist_threshold,
-                               std::vector<BufferedLogWriter> *buffers,
+                               uint32_t group_commit_target_iops, std::vector<BufferedLogWriter> *buffers,
                                common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
-                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue)
+                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
+                               std::string log_file_path, DurableWatermark *watermark = nullptr,
+                               uint32_t partition = 0, const LogCompressor *compressor = nullptr)
       : run_task_(false),
         persist_interval_(persist_interval),
         persist_threshold_(persist_threshold),
+        group_commit_(group_commit_target_iops > 0),
+        group_commit_gap_(group_commit_ ? std::chrono::microseconds(1000000 / group_commit_target_iops)
+                                        : std::chrono::microseconds(0)),
         current_data_written_(0),
+        current_buffers_written_(0),
         buffers_(buffers),
         empty_buffer_queue_(empty_buffer_queue),
-        filled_buffer_queue_(filled_buffer_queue) {}
+        filled_buffer_queue_(filled_buffer_queue),
+        log_file_path_(std::move(log_file_path)),
+        watermark_(watermark),
+        partition_(partition),
+        compressor_(compressor),
+        watermark_writer_(watermark == nullptr ? nullptr
+                                               : std::make_unique<BufferedLogWriter>(log_file_path_.c_str())) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -50,6 +81,7 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
 
  private:
   friend class LogManager;
+  friend class DurableWatermark;
   // Flag to signal task to run or stop
   bool run_task_;
   // Stores callbacks for commit records written to disk but not yet persisted
@@ -59,8 +91,19 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   const std::chrono::microseconds persist_interval_;
   // Threshold of data written since the last persist to trigger another persist
   uint64_t persist_threshold_;
+  // Whether the log file is persisted for waiting committers rather than on the persist interval
+  const bool group_commit_;
+  // Minimum time between the start of two persists with group commit, from the target persist rate
+  const std::chrono::microseconds group_commit_gap_;
   // Amount of data written since last persist
   uint64_t current_data_written_;
+  // Number of buffers written since last persist
+  uint64_t current_buffers_written_;
+  // Number of batches dequeued from filled_buffer_queue_ so far
+  uint64_t num_batches_written_ = 0;
+  // Number of persists that made at least one commit durable, and the number of commits they made durable
+  std::atomic<uint64_t> num_commit_batches_ = 0;
+  std::atomic<uint64_t> num_commits_persisted_ = 0;
 
   // This stores a reference to all the buffers the log manager has created. Used for persisting
   std::vector<BufferedLogWriter> *buffers_;
@@ -72,6 +115,27 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   // Flag used by the serializer thread to signal the disk log consumer task thread to persist the data on disk
   volatile bool force_flush_;
 
+  // Path of the log file the buffers write to
+  const std::string log_file_path_;
+  // Flag used by the log manager to signal the disk log consumer task thread to seal the log file into a segment
+  volatile bool rotate_log_file_ = false;
+  // Number of batches that go into the log file before it is sealed. The last one ends at a record boundary.
+  uint64_t rotate_after_batches_ = 0;
+
+  // Durable watermark of a partitioned WAL, nullptr for a single partition, and the partition written out
+  DurableWatermark *const watermark_;
+  const uint32_t partition_;
+  // Codec the buffers are compressed with, which the watermarks written to the log file are compressed with as well
+  const LogCompressor *const compressor_;
+  // Writes the watermarks to the log file, nullptr for a single partition
+  std::unique_ptr<BufferedLogWriter> watermark_writer_;
+  // Every transaction of the partition that committed before written_up_to_ is in the log file, and every one that
+  // committed before persisted_up_to_ is durable, as is a watermark of persisted_up_to_
+  transaction::timestamp_t written_up_to_ = transaction::INITIAL_TXN_TIMESTAMP;
+  transaction::timestamp_t persisted_up_to_ = transaction::INITIAL_TXN_TIMESTAMP;
+  // Flag used by the durable watermark to signal the disk log consumer task thread that it waits on this partition
+  std::atomic<bool> watermark_wakeup_ = false;
+
   // Synchronisation primitives to synchronise persisting buffers to disk
   std::mutex persist_lock_;
   std::condition_variable persist_cv_;
@@ -79,6 +143,14 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   // initiated, then quit
   std::condition_variable disk_log_writer_thread_cv_;
 
+  // Whether the log file is to be sealed before writing the next batch
+  bool RotationDue() const { return rotate_log_file_ && num_batches_written_ == rotate_after_batches_; }
+
+  // Whether a committer waits for the next persist, either one of this partition's or the durable watermark
+  bool CommittersWaiting() const {
+    return !commit_callbacks_.empty() || (watermark_ != nullptr && watermark_->IsWaitingOn(partition_));
+  }
+
   /**
    * Main disk log consumer task loop. Flushes buffers to disk when new buffers are handed to it via
    * filled_buffer_queue_, or when notified by LogManager to persist buffers
@@ -86,15 +158,29 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   void DiskLogConsumerTaskLoop();
 
   /**
-   * Flush all buffers in the filled buffers queue to the log file
+   * Flush all buffers in the filled buffers queue to the log file, and with a partitioned WAL, advance written_up_to_
+   * if none were left to the next log file
    */
   void WriteBuffersToLogFile();
 
   /*
    * Persists the log file on disk by calling fsync, as well as calling callbacks for all committed transactions that
-   * were persisted
-   * @return number of buffers persisted, used for metrics
+   * were persisted. With a partitioned WAL, the callbacks are handed to the durable watermark instead, along with the
+   * frontier of the partition, which is written to the log file first if it advanced and anyone waits for it.
+   * @return number of commit callbacks invoked, i.e. the size of the commit batch, used for metrics
    */
   uint64_t PersistLogFile();
+
+  /**
+   * Append a WATERMARK record to the log file, without persisting it
+   * @param watermark every transaction of the partition that committed before it is durable once the record is
+   */
+  void WriteWatermark(transaction::timestamp_t watermark);
+
+  /**
+   * Persists the log file, renames it to the next segment (see LogSegmentFilePath), and points all buffers at a new log
+   * file in its place
+   */
+  void RotateLogFile();
 };
 }  // namespace noisepage::storage
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include "common/managed_pointer.h"
+#include "common/spin_latch.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::transaction {
+class TimestampManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::storage {
+
+class DiskLogConsumerTask;
+
+/**
+ * The partitions of a WAL persist their log files independently, so a transaction could be durable in one partition
+ * while a transaction that committed before it, and that it may have read from or overwritten, is not durable yet in
+ * another one. The DurableWatermark holds commit callbacks back until this cannot happen.
+ *
+ * Whenever a partition persists, it reports its frontier: every transaction of the partition that committed before the
+ * frontier is durable. The watermark is the oldest frontier of all partitions, and a commit callback is only invoked
+ * once the transaction committed before the watermark. Each partition writes its frontier into its log file as well
+ * (see LogRecordType::WATERMARK), so that recovery replays the same prefix of the history after a crash.
+ *
+ * A partition learns its frontier from the TimestampManager: once every transaction that committed before some time
+ * has been handed over to the partition's disk log consumer task, writing out what was handed over makes them durable.
+ */
+class DurableWatermark {
+ public:
+  /**
+   * @param num_partitions number of partitions of the WAL
+   */
+  explicit DurableWatermark(const uint32_t num_partitions)
+      : frontiers_(num_partitions, transaction::INITIAL_TXN_TIMESTAMP), consumers_(num_partitions, nullptr) {}
+
+  /**
+   * Set the timestamp manager of the transactions that log to the WAL. Must be set before the first commit.
+   * @param timestamp_manager timestamp manager that tracks commits (see TimestampManager::TrackCommits)
+   */
+  void SetTimestampManager(const common::ManagedPointer<transaction::TimestampManager> timestamp_manager) {
+    timestamp_manager_ = timestamp_manager.Get();
+  }
+
+  /**
+   * @return timestamp such that every transaction that committed before it has been handed over to the disk log
+   * consumer task of its partition, or INITIAL_TXN_TIMESTAMP before the timestamp manager is set
+   */
+  transaction::timestamp_t SerializedCommitsBefore() const;
+
+  /**
+   * Set the disk log consumer task of a partition, which is woken up when the watermark waits on it
+   * @param partition partition of the WAL
+   * @param consumer disk log consumer task of the partition, nullptr once it is stopped
+   */
+  void SetConsumer(uint32_t partition, DiskLogConsumerTask *consumer);
+
+  /**
+   * Called by a partition after it persisted its log file. Takes over the callbacks of the transactions it persisted,
+   * and invokes the callbacks of all partitions that the watermark passed.
+   * @param partition partition of the WAL
+   * @param frontier every transaction of the partition that committed before it is durable
+   * @param callbacks commit callbacks of the transactions the partition persisted, cleared on return
+   */
+  void Persisted(uint32_t partition, transaction::timestamp_t frontier, std::vector<CommitCallback> *callbacks);
+
+  /**
+   * @param partition partition of the WAL
+   * @return true if commit callbacks are held back until the partition persists a newer frontier
+   */
+  bool IsWaitingOn(uint32_t partition);
+
+ private:
+  std::atomic<transaction::TimestampManager *> timestamp_manager_ = nullptr;
+  // Protects everything below
+  common::SpinLatch latch_;
+  // Frontier last reported by each partition
+  std::vector<transaction::timestamp_t> frontiers_;
+  // Callbacks of the persisted transactions that committed at or after the watermark, by commit timestamp
+  std::multimap<transaction::timestamp_t, CommitCallback> pending_;
+  // Disk log consumer task of each partition
+  std::vector<DiskLogConsumerTask *> consumers_;
+};
+
+}  // namespace noisepage::storage
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+#include "common/macros.h"
+
+namespace noisepage::storage {
+
+/** Codecs that the buffers of the WAL can be compressed with. */
+enum class LogCompressionType : uint8_t {
+  NONE = 0,  ///< Buffers are written out as they were serialized.
+  LZ         ///< Buffers are compressed with the built-in LZ77 codec.
+};
+
+/**
+ * Every buffer of a compressed WAL is written out as a block, which is this header followed by the stored bytes. The
+ * codec of the block is NONE when the codec of the WAL did not make the buffer any smaller, and the buffer is stored
+ * as is.
+ *
+ * A block starts with MAGIC where a buffer of an uncompressed WAL starts with the size of a record. MAGIC is larger
+ * than any record, so the two are never mistaken for each other, and readers tell which one they were given.
+ */
+struct LogBlockHeader {
+  /** Value of magic_ in every block */
+  static constexpr uint32_t MAGIC = 0x4B4C504E;
+
+  uint32_t magic_;        ///< Always MAGIC.
+  uint32_t raw_size_;     ///< Size of the buffer before compression.
+  uint32_t stored_size_;  ///< Number of bytes following the header.
+  uint32_t codec_;        ///< LogCompressionType of the stored bytes.
+};
+
+/**
+ * A codec for the buffers of the WAL. Codecs are stateless, so a single instance of each one is shared by all the
+ * serializers and readers of the system.
+ */
+class LogCompressor {
+ public:
+  virtual ~LogCompressor() = default;
+
+  /** @return type of the codec */
+  virtual LogCompressionType GetType() const = 0;
+
+  /**
+   * Compress the given bytes.
+   * @param src bytes to compress
+   * @param size number of bytes to compress
+   * @param dest location to write the compressed bytes to
+   * @param capacity number of bytes that can be written to dest
+   * @return number of compressed bytes, or 0 if they do not fit in capacity
+   */
+  virtual uint32_t Compress(const char *src, uint32_t size, char *dest, uint32_t capacity) const = 0;
+
+  /**
+   * Decompress the given bytes.
+   * @param src bytes to decompress
+   * @param size number of bytes to decompress
+   * @param dest location to write the decompressed bytes to
+   * @param capacity number of bytes that can be written to dest
+   * @return number of decompressed bytes
+   * @throw std::runtime_error if the bytes are corrupted or do not decompress into capacity
+   */
+  virtual uint32_t Decompress(const char *src, uint32_t size, char *dest, uint32_t capacity) const = 0;
+
+  /**
+   * Write the given bytes out as a block.
+   * @param src bytes of the buffer
+   * @param size number of bytes in the buffer
+   * @param dest location to write the block to, which must have room for size + sizeof(LogBlockHeader) bytes
+   * @return size of the block
+   */
+  uint32_t EncodeBlock(const char *src, uint32_t size, char *dest) const;
+
+  /**
+   * Read the contents of a block back.
+   * @param header header of the block
+   * @param payload bytes following the header
+   * @param dest location to write the buffer to
+   * @param capacity number of bytes that can be written to dest
+   * @return number of bytes in the buffer
+   * @throw std::runtime_error if the header is not that of a block, or the block is corrupted or does not fit in
+   * capacity
+   */
+  static uint32_t DecodeBlock(const LogBlockHeader &header, const char *payload, char *dest, uint32_t capacity);
+
+  /**
+   * @param bytes start of a buffer of the WAL, as written out or shipped to replicas
+   * @param size number of bytes in the buffer
+   * @return true if the buffer is a block, false if it holds records as they were serialized
+   */
+  static bool IsBlock(const char *bytes, uint32_t size) {
+    uint32_t magic = 0;
+    if (size >= sizeof(magic)) std::memcpy(&magic, bytes, sizeof(magic));
+    return magic == LogBlockHeader::MAGIC;
+  }
+
+  /**
+   * @param type type of codec
+   * @return the shared instance of the codec, or nullptr for NONE
+   */
+  static const LogCompressor *Get(LogCompressionType type);
+
+  /**
+   * @param compression name of a codec, as given in the wal_compression setting
+   * @return type of the codec, or nullopt if there is no codec of that name
+   */
+  static std::optional<LogCompressionType> FromCompressionString(const std::string_view &compression) {
+    std::optional<LogCompressionType> type{std::nullopt};
+    if (compression == "NONE") {
+      type = LogCompressionType::NONE;
+    } else if (compression == "LZ") {
+      type = LogCompressionType::LZ;
+    }
+    return type;
+  }
+};
+
+/**
+ * Byte-oriented LZ77 codec in the spirit of LZ4. The compressed bytes are a sequence of literal runs, each followed by
+ * a back reference of at least MIN_MATCH bytes into the last 64 KB of output, except for the last run. It does not
+ * compress as well as entropy coding codecs, but it is fast enough to run on the serializer thread, and serialized
+ * records repeat a lot of bytes (headers, oids, timestamps, unchanged columns).
+ */
+class LZLogCompressor final : public LogCompressor {
+ public:
+  /** Shortest back reference that is encoded */
+  static constexpr uint32_t MIN_MATCH = 4;
+  /** Farthest back a reference can point */
+  static constexpr uint32_t MAX_OFFSET = UINT16_MAX;
+
+  LogCompressionType GetType() const override { return LogCompressionType::LZ; }
+
+  uint32_t Compress(const char *src, uint32_t size, char *dest, uint32_t capacity) const override;
+
+  uint32_t Decompress(const char *src, uint32_t size, char *dest, uint32_t capacity) const override;
+
+ private:
+  // Number of bits of the hash of MIN_MATCH bytes that is used to find earlier occurrences
+  static constexpr uint32_t HASH_BITS = 12;
+};
+
+}  // namespace noisepage::storage
@@ -9,6 +9,7 @@
 #include <atomic>
 #include <cerrno>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "common/macros.h"
 #include "common/posix_io_wrappers.h"
 #include "loggers/storage_logger.h"
+#include "storage/write_ahead_log/log_compression.h"
 #include "transaction/transaction_defs.h"
 
 namespace noisepage::replication {
@@ -51,8 +53,9 @@ class BufferedLogWriter {
    * and EmplaceConstructible will be satisfied.
    */
   BufferedLogWriter(BufferedLogWriter &&other) noexcept : out_(other.out_) {
-    memcpy(buffer_, other.buffer_, common::Constants::LOG_BUFFER_SIZE);
+    memcpy(buffer_, other.buffer_, sizeof(buffer_));
     buffer_size_ = other.buffer_size_;
+    is_block_ = other.is_block_;
     serialize_refcount_.store(other.serialize_refcount_.load());
   }
 
@@ -61,6 +64,16 @@ class BufferedLogWriter {
    */
   void Close() { PosixIoWrappers::Close(out_); }
 
+  /**
+   * Close the log file and write to the given one from now on. Must only be called by the thread that flushes the
+   * buffer, between two flushes.
+   * @param log_file_path path to the log file to write to, created if it does not exist
+   */
+  void Reopen(const char *const log_file_path) {
+    PosixIoWrappers::Close(out_);
+    out_ = PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
+  }
+
   /**
    * Write to the log file the given amount of bytes from the given location in memory, but buffer the write so the
    * update is only written out when the BufferedLogWriter is persisted. Note that this function writes to the buffer
@@ -104,6 +117,7 @@ class BufferedLogWriter {
     const auto size = buffer_size_;
     WriteUnsynced(buffer_, buffer_size_);
     buffer_size_ = 0;
+    is_block_ = false;
     return size;
   }
 
@@ -112,6 +126,23 @@ class BufferedLogWriter {
    */
   bool IsBufferFull() const { return buffer_size_ == common::Constants::LOG_BUFFER_SIZE; }
 
+  /**
+   * Replace the contents of the buffer with a block of them compressed by the given codec. This must be done at most
+   * once, after all of the writes to the buffer and before it is persisted or sent anywhere.
+   * @param compressor codec to compress the buffer with
+   * @param scratch space for the block, of at least LOG_BUFFER_SIZE + sizeof(LogBlockHeader) bytes
+   */
+  void CompressBuffer(const LogCompressor &compressor, char *const scratch) {
+    buffer_size_ = compressor.EncodeBlock(buffer_, buffer_size_, scratch);
+    std::memcpy(buffer_, scratch, buffer_size_);
+    is_block_ = true;
+  }
+
+  /**
+   * @return true if the contents of the buffer were replaced with a block by CompressBuffer
+   */
+  bool IsBlock() const { return is_block_; }
+
   /**
    * Mark that the BufferedLogWriter is now ready to be persisted and sent to different destinations.
    * Note that the BufferedLogWriter represents a batch of different logs.
@@ -158,10 +189,13 @@ class BufferedLogWriter {
  private:
   friend class replication::RecordsBatchMsg;
 
-  const int out_;  // fd of the output files
-  char buffer_[common::Constants::LOG_BUFFER_SIZE];
+  int out_;  // fd of the output files
+  // Writes only fill LOG_BUFFER_SIZE bytes, the rest is room for the header when the buffer is compressed as a block
+  char buffer_[common::Constants::LOG_BUFFER_SIZE + sizeof(LogBlockHeader)];
 
   uint32_t buffer_size_ = 0;
+  // True if the contents were replaced with a block
+  bool is_block_ = false;
   std::atomic<int8_t> serialize_refcount_ = 0;  ///< The number of would-be serializers that haven't serialized yet.
 
   bool CanBuffer(uint32_t size) { return common::Constants::LOG_BUFFER_SIZE - buffer_size_ >= size; }
@@ -175,10 +209,11 @@ class BufferedLogWriter {
 class BufferedLogReader {
  public:
   /**
-   * Instantiates a new BufferedLogReader to read from the specified log file.
+   * Instantiates a new BufferedLogReader to read from the specified log file. A log file that starts with a block (see
+   * LogBlockHeader) is read as a sequence of blocks, whichever codec the WAL is configured with now.
    * @param log_file_path path to the the log file to read from.
    */
-  explicit BufferedLogReader(const char *log_file_path) : in_(PosixIoWrappers::Open(log_file_path, O_RDONLY)) {}
+  explicit BufferedLogReader(const char *log_file_path);
 
   /**
    * Closes log file if it has not been closed already. While Read will close the file if it reaches the end, this will
@@ -191,7 +226,11 @@ class BufferedLogReader {
   /**
    * @return if there are contents left in the write ahead log
    */
-  bool HasMore() { return filled_size_ > read_head_ || in_ != -1; }
+  bool HasMore() {
+    // Look ahead into the file once the buffer is used up, so that an empty or fully read file has no contents left
+    if (filled_size_ == read_head_ && in_ != -1) RefillBuffer();
+    return filled_size_ > read_head_;
+  }
 
   /**
    * Read the specified number of bytes into the target location from the write ahead log. The method reads as many as
@@ -222,6 +261,8 @@ class BufferedLogReader {
   int in_;  // or -1 if closed
   uint32_t read_head_ = 0, filled_size_ = 0;
   char buffer_[common::Constants::LOG_BUFFER_SIZE];
+  // Stored bytes of the block being decompressed, or nullptr if the log file is not compressed
+  std::unique_ptr<char[]> block_;
 
   void ReadFromBuffer(void *dest, uint32_t size) {
     NOISEPAGE_ASSERT(read_head_ + size <= filled_size_, "Not enough bytes in buffer for the read");
@@ -230,6 +271,8 @@ class BufferedLogReader {
   }
 
   void RefillBuffer();
+
+  void RefillBufferFromBlock();
 };
 
 /** A commit callback is of the form fn_(arg_), and is invoked when the corresponding commit record is persisted. */
@@ -237,6 +280,7 @@ struct CommitCallback {
   transaction::callback_fn fn_;              ///< The commit callback to invoke.
   void *arg_;                                ///< The argument to invoke the commit callback with.
   transaction::timestamp_t txn_start_time_;  ///< (Metadata) The transaction ID that generated this commit callback.
+  transaction::timestamp_t commit_time_;     ///< (Metadata) The commit timestamp of the transaction.
   bool is_from_read_only_;                   ///< True if the commit callback was from a read only commit record.
 };
 
@@ -246,4 +290,32 @@ struct CommitCallback {
  */
 using SerializedLogs = std::pair<BufferedLogWriter *, std::vector<CommitCallback>>;
 
+/**
+ * With a partitioned WAL, partition 0 is written to the log file itself, and partition i > 0 to the log file with ".i"
+ * appended.
+ * @param log_file_path path of the log file
+ * @param partition partition of the WAL
+ * @return path of the log file of the partition
+ */
+inline std::string LogPartitionFilePath(const std::string &log_file_path, const uint32_t partition) {
+  return partition == 0 ? log_file_path : log_file_path + "." + std::to_string(partition);
+}
+
+/**
+ * A log file is sealed into a numbered segment when the log manager rotates it, and a new log file is started in its
+ * place. A segment is deleted once a checkpoint covers all of it.
+ * @param log_file_path path of the log file of a partition
+ * @param segment number of the segment
+ * @return path of the segment
+ */
+inline std::string LogSegmentFilePath(const std::string &log_file_path, const uint64_t segment) {
+  return log_file_path + ".segment." + std::to_string(segment);
+}
+
+/**
+ * @param log_file_path path of the log file of a partition
+ * @return the numbers of the segments of the log file that exist, in the order they were sealed
+ */
+std::vector<uint64_t> LogSegments(const std::string &log_file_path);
+
 }  // namespace noisepage::storage
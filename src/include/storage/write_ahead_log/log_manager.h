@@ -14,6 +14,7 @@
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/record_buffer.h"
+#include "storage/write_ahead_log/durable_watermark.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
 
@@ -38,10 +39,26 @@ class DiskLogConsumerTask;
  * case of the DiskLogConsumerTask, this means writing it to the log file.
  *      4. The DiskLogConsumer task will persist the log file when:
  *          a) Someone calls ForceFlush on the LogManager, or
- *          b) Periodically
+ *          b) Periodically, or with group commit, as soon as a committing transaction is waiting and the target persist
+ *             rate allows another persist
  *          c) A sufficient amount of data has been written since the last persist
  *      5. When the persist is done, the `DiskLogConsumerTask` will call the commit callbacks for any CommitRecords that
  * were just persisted.
+ *
+ * The WAL can be partitioned to serialize and write logs on more than one thread. Each of the N partitions is a
+ * LogManager of its own, with its own serializer, consumer, log buffers and log file (see LogPartitionFilePath), and a
+ * transaction's records all go to the partition of its start timestamp modulo N. This LogManager is partition 0. The
+ * partitions are merged during recovery by a DiskLogProvider over all of the log files. Since the partitions persist
+ * independently, commit callbacks are held back by a DurableWatermark until every transaction that committed before
+ * them is durable in all partitions, and recovery replays the same prefix of the history.
+ *
+ * With compression enabled, the serializer compresses every buffer into a block (see LogBlockHeader) before handing
+ * it over, so the log file and the replicas both receive blocks. Readers tell blocks from uncompressed buffers by the
+ * magic of their header, so the codec only has to be configured on the writer.
+ *
+ * RotateLogFile seals the log file of every partition into a numbered segment (see LogSegmentFilePath) and starts a new
+ * log file, so that the CheckpointManager can delete the segments a checkpoint covers. A DiskLogProvider reads the
+ * segments of a partition before its log file.
  */
 class LogManager : public common::DedicatedThreadOwner {
  public:
@@ -61,13 +78,19 @@ class LogManager : public common::DedicatedThreadOwner {
    * @param primary_replication_manager     The replication manager that handles shipping logs over the network.
    *                                        Currently only the primary does this.
    * @param thread_registry                 DedicatedThreadRegistry dependency injection
+   * @param group_commit_target_iops        Target number of log file persists per second for group commit,
+   *                                        or 0 to persist on the persist interval instead.
+   * @param num_partitions                  Number of partitions of the WAL. Replication requires a single partition.
+   * @param compression                     Codec the serialized buffers are compressed with.
    */
   LogManager(std::string log_file_path, uint64_t num_buffers, std::chrono::microseconds serialization_interval,
              std::chrono::microseconds persist_interval, uint64_t persist_threshold,
              common::ManagedPointer<RecordBufferSegmentPool> buffer_pool,
              common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
              common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager,
-             common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry)
+             common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
+             uint32_t group_commit_target_iops = 0, uint32_t num_partitions = 1,
+             LogCompressionType compression = LogCompressionType::NONE)
       : DedicatedThreadOwner(thread_registry),
         run_log_manager_(false),
         log_file_path_(std::move(log_file_path)),
@@ -77,13 +100,34 @@ class LogManager : public common::DedicatedThreadOwner {
         serialization_interval_(serialization_interval),
         persist_interval_(persist_interval),
         persist_threshold_(persist_threshold),
-        primary_replication_manager_(primary_replication_manager) {}
+        group_commit_target_iops_(group_commit_target_iops),
+        compression_(compression),
+        primary_replication_manager_(primary_replication_manager) {
+    NOISEPAGE_ASSERT(num_partitions >= 1, "The WAL needs at least one partition");
+    NOISEPAGE_ASSERT(num_partitions == 1 || primary_replication_manager == DISABLED,
+                     "Replication ships the logs of a single partition.");
+    if (num_partitions > 1) {
+      durable_watermark_ = std::make_unique<DurableWatermark>(num_partitions);
+      watermark_ = durable_watermark_.get();
+    }
+    for (uint32_t partition = 1; partition < num_partitions; partition++) {
+      partition_empty_buffer_queues_.emplace_back(
+          std::make_unique<common::ConcurrentBlockingQueue<BufferedLogWriter *>>());
+      partitions_.emplace_back(std::make_unique<LogManager>(
+          LogPartitionFilePath(log_file_path_, partition), num_buffers, serialization_interval, persist_interval,
+          persist_threshold, buffer_pool, common::ManagedPointer(partition_empty_buffer_queues_.back()), DISABLED,
+          thread_registry, group_commit_target_iops, 1, compression));
+      partitions_.back()->watermark_ = watermark_;
+      partitions_.back()->partition_ = partition;
+    }
+  }
 
   /**
    * Starts log manager. Does the following in order:
    *    1. Initialize buffers to pass serialized logs to log consumers
    *    2. Starts up DiskLogConsumerTask
    *    3. Starts up LogSerializerTask
+   * and then starts the other partitions of the WAL.
    */
   void Start();
 
@@ -96,7 +140,14 @@ class LogManager : public common::DedicatedThreadOwner {
   void ForceFlush();
 
   /**
-   * Persists all unpersisted logs and stops the log manager. Does what Start() does in reverse order:
+   * Seal the log file of every partition into a new segment (see LogSegmentFilePath) once everything handed over so
+   * far is persisted, and start a new log file in its place. Segments can be deleted once a checkpoint covers them.
+   */
+  void RotateLogFile();
+
+  /**
+   * Persists all unpersisted logs and stops the log manager, and the other partitions of the WAL. Does what Start()
+   * does in reverse order:
    *    1. Stops LogSerializerTask
    *    2. Stops DiskLogConsumerTask
    *    3. Closes all open buffers
@@ -114,12 +165,37 @@ class LogManager : public common::DedicatedThreadOwner {
    */
   void AddBufferToFlushQueue(RecordBufferSegment *buffer_segment, const transaction::TransactionPolicy &policy);
 
+  /** @return path of the log file, which is the log file of partition 0 */
+  const std::string &GetLogFilePath() const { return log_file_path_; }
+
+  /** @return number of partitions of the WAL */
+  uint32_t GetNumPartitions() const { return static_cast<uint32_t>(partitions_.size()) + 1; }
+
+  /**
+   * With a partitioned WAL, set the timestamp manager that the partitions learn their durable frontier from. Must be
+   * called before the first commit.
+   * @param timestamp_manager timestamp manager that tracks commits (see TimestampManager::TrackCommits)
+   */
+  void SetTimestampManager(common::ManagedPointer<transaction::TimestampManager> timestamp_manager);
+
   /**
    * For testing only
    * @return number of buffers used for logging
    */
   uint64_t TestGetNumBuffers() { return num_buffers_; }
 
+  /**
+   * For testing only
+   * @return number of persists that made committed transactions durable, across all partitions
+   */
+  uint64_t TestGetNumCommitBatches();
+
+  /**
+   * For testing only
+   * @return number of committed transactions made durable, across all partitions
+   */
+  uint64_t TestGetNumCommitsPersisted();
+
   /**
    * Set the number of buffers used for buffering logs. The operation fails if the LogManager has already allocated more
    * buffers than the new size
@@ -128,6 +204,9 @@ class LogManager : public common::DedicatedThreadOwner {
    * @return true if new_num_buffers is successfully set and false the operation fails
    */
   bool SetNumBuffers(uint64_t new_num_buffers) {
+    for (auto &partition : partitions_) {
+      if (!partition->SetNumBuffers(new_num_buffers)) return false;
+    }
     if (new_num_buffers >= num_buffers_) {
       // Add in new buffers
       for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
@@ -186,9 +265,36 @@ class LogManager : public common::DedicatedThreadOwner {
   const std::chrono::microseconds persist_interval_;
   // Threshold used by disk consumer task
   uint64_t persist_threshold_;
+  // Target persist rate used by disk consumer task for group commit, 0 if disabled
+  const uint32_t group_commit_target_iops_;
+  // Codec used by the serializer task to compress buffers
+  const LogCompressionType compression_;
+
+  // The other partitions of the WAL, partition i is at index i - 1, along with the queues of their empty buffers
+  std::vector<std::unique_ptr<common::ConcurrentBlockingQueue<BufferedLogWriter *>>> partition_empty_buffer_queues_;
+  std::vector<std::unique_ptr<LogManager>> partitions_;
+  // With a partitioned WAL, the durable watermark of all partitions, owned by partition 0, and this one's partition
+  std::unique_ptr<DurableWatermark> durable_watermark_;
+  DurableWatermark *watermark_ = nullptr;
+  uint32_t partition_ = 0;
 
   common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager_;
 
+  /**
+   * @param buffer_segment buffer handed over by a transaction
+   * @return the partition of the WAL that the records of the transaction go to
+   */
+  uint32_t PartitionOf(RecordBufferSegment *buffer_segment) const;
+
+  /** Stop the LogSerializerTask, which serializes the buffers handed over so far */
+  void StopLogSerializerTask();
+
+  /** Stop the DiskLogConsumerTask, which persists the serialized buffers, and close the buffers */
+  void StopDiskLogConsumerTask();
+
+  /** Ask the DiskLogConsumerTask to persist, and wait until it has */
+  void FlushDiskLogConsumerTask();
+
   /**
    * If the central registry wants to removes our thread used for the disk log consumer task, we only allow removal if
    * we are in shut down, else we need to keep the task, so we reject the removal
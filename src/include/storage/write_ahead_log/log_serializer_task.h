@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>  // NOLINT
+#include <memory>
 #include <queue>
 #include <thread>  // NOLINT
 #include <tuple>
@@ -34,13 +35,15 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    * @param filled_buffer_queue         Pointer to queue to push filled buffers to.
    * @param disk_log_writer_thread_cv   Pointer to cvar to notify consumer when a new buffer has handed over.
    * @param primary_replication_manager Pointer to replication manager where to-be-replicated serialized logs are sent.
+   * @param compressor                  Codec to compress filled buffers with, or nullptr to leave them uncompressed.
    */
   explicit LogSerializerTask(
       const std::chrono::microseconds serialization_interval, RecordBufferSegmentPool *buffer_pool,
       common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
       common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
       std::condition_variable *disk_log_writer_thread_cv,
-      common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager)
+      common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager,
+      const LogCompressor *compressor = nullptr)
       : run_task_(false),
         serialization_interval_(serialization_interval),
         buffer_pool_(buffer_pool),
@@ -49,7 +52,11 @@ class LogSerializerTask : public common::DedicatedThreadTask {
         empty_buffer_queue_(empty_buffer_queue),
         filled_buffer_queue_(filled_buffer_queue),
         disk_log_writer_thread_cv_(disk_log_writer_thread_cv),
-        primary_replication_manager_(primary_replication_manager) {}
+        primary_replication_manager_(primary_replication_manager),
+        compressor_(compressor),
+        compression_buffer_(compressor == nullptr
+                                ? nullptr
+                                : new char[common::Constants::LOG_BUFFER_SIZE + sizeof(LogBlockHeader)]) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -113,6 +120,11 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   BufferedLogWriter *filled_buffer_;  ///< The current buffer that logs are being serialized to.
   std::optional<transaction::TransactionPolicy> filled_buffer_policy_;  ///< Transaction policy for the current buffer.
   std::vector<storage::CommitCallback> commits_in_buffer_;  ///< Commit callbacks for commit records in filled_buffer_.
+  /**
+   * Number of batches handed to the disk log consumer task so far. A record may be split across the buffers of two
+   * batches, but never while serialization_latch_ is free.
+   */
+  uint64_t num_batches_handed_ = 0;
   transaction::timestamp_t newest_buffer_txn_ = transaction::INITIAL_TXN_TIMESTAMP;  ///< Newest txn ever in buffer.
 
   /** Used by the serializer thread to store buffers that were grabbed from the log manager. */
@@ -137,6 +149,9 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   bool oat_replicas_ = false;  ///< True if the replicas may need an update of their OAT.
   bool notify_oat_ = true;     ///< TODO(WAN): A hack to prevent use after free.
 
+  const LogCompressor *compressor_;  ///< Codec that filled buffers are compressed with, or nullptr if disabled.
+  std::unique_ptr<char[]> compression_buffer_;  ///< Scratch space for compressing a filled buffer.
+
   /**
    * Main serialization loop. Calls Process every interval. Processes all the accumulated log records and
    * serializes them to log consumer tasks.
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <limits>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+
+namespace noisepage::storage {
+
+/**
+ * Summary of the values of a fixed-length column within a block: the smallest and largest value, and the number of
+ * nulls. Scans use it to skip blocks that cannot hold a tuple they are looking for. Values are read as signed integers
+ * of the width of the column, so the bounds only mean something to callers that know the column holds integers (this
+ * includes dates and timestamps).
+ *
+ * While a block is hot, the zone map is only ever widened by writers, so the bounds cover every value that was written
+ * into the block, and with it every version any running transaction can see. The null count is then an upper bound.
+ * The block compactor makes the zone map exact when it freezes the block. A column without non-null values has a
+ * minimum larger than its maximum.
+ *
+ * Zone maps live in the block header and are only accessed through reinterpretation of the block's memory.
+ */
+class ZoneMap {
+ public:
+  MEM_REINTERPRETATION_ONLY(ZoneMap)
+
+  /**
+   * Read a value of a fixed-length column as a signed integer.
+   * @param value pointer to the value
+   * @param size size of the column in bytes
+   * @return the value as a 64-bit signed integer
+   */
+  static int64_t ReadValue(const byte *value, const uint16_t size) {
+    switch (size) {
+      case sizeof(int8_t):
+        return *reinterpret_cast<const int8_t *>(value);
+      case sizeof(int16_t):
+        return *reinterpret_cast<const int16_t *>(value);
+      case sizeof(int32_t):
+        return *reinterpret_cast<const int32_t *>(value);
+      default:
+        NOISEPAGE_ASSERT(size == sizeof(int64_t), "Fixed-length columns are 1, 2, 4 or 8 bytes wide");
+        return *reinterpret_cast<const int64_t *>(value);
+    }
+  }
+
+  /**
+   * Make the zone map describe a column that holds no values.
+   */
+  void Clear() { Set(std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), 0); }
+
+  /**
+   * Overwrite the zone map with exact values. Only safe when no writer can touch the block.
+   * @param min smallest non-null value
+   * @param max largest non-null value
+   * @param null_count number of nulls
+   */
+  void Set(const int64_t min, const int64_t max, const uint32_t null_count) {
+    // The minimum goes first, so that a concurrent reader only ever sees bounds as wide as the old or the new ones
+    min_.store(min);
+    max_.store(max);
+    null_count_.store(null_count);
+  }
+
+  /**
+   * Widen the bounds to include the given value.
+   * @param value the value written into the column
+   */
+  void Widen(const int64_t value) {
+    int64_t min = min_.load();
+    while (value < min && !min_.compare_exchange_weak(min, value)) {
+    }
+    int64_t max = max_.load();
+    while (value > max && !max_.compare_exchange_weak(max, value)) {
+    }
+  }
+
+  /**
+   * Account for a null written into the column.
+   */
+  void AddNull() { null_count_.fetch_add(1); }
+
+  /** @return smallest value of the column, or INT64_MAX if the column holds no non-null values */
+  int64_t Min() const { return min_.load(); }
+
+  /** @return largest value of the column, or INT64_MIN if the column holds no non-null values */
+  int64_t Max() const { return max_.load(); }
+
+  /** @return number of nulls in the column, an upper bound while the block is hot */
+  uint32_t NullCount() const { return null_count_.load(); }
+
+ private:
+  std::atomic<int64_t> min_;
+  std::atomic<int64_t> max_;
+  std::atomic<uint32_t> null_count_;
+};
+
+}  // namespace noisepage::storage
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "execution/sql/sql.h"
+#include "execution/util/csv_reader.h"
+#include "storage/projected_row.h"
+#include "traffic_cop/traffic_cop_defs.h"
+
+namespace noisepage::catalog {
+class CatalogAccessor;
+}  // namespace noisepage::catalog
+
+namespace noisepage::storage {
+class SqlTable;
+namespace index {
+class Index;
+}  // namespace index
+}  // namespace noisepage::storage
+
+namespace noisepage::transaction {
+class TransactionContext;
+}  // namespace noisepage::transaction
+
+namespace noisepage::trafficcop {
+
+/**
+ * CopyLoader implements the bulk path of COPY ... FROM STDIN. The CSV data arrives in chunks of arbitrary size, which
+ * are parsed with a CSVReader straight into ProjectedRows in the layout of the table, without going through the
+ * binder, the optimizer or code generation.
+ *
+ * Rows are parsed into a batch of ProjectedRows owned by the loader. A full batch is inserted into the table, and then
+ * into every index of the table, one index at a time. Values are converted and checked for the whole batch before any
+ * of it is written, so a malformed row never leaves half a batch in the table.
+ *
+ * All columns of the table are loaded, in schema order. An unquoted empty cell is NULL and a quoted empty cell ("") is
+ * the empty string, as in Postgres' CSV format.
+ */
+class CopyLoader {
+ public:
+  /** Number of rows parsed before they are inserted into the table and its indexes */
+  static constexpr uint32_t BATCH_SIZE = 1024;
+
+  /**
+   * @param txn transaction to load the rows in
+   * @param accessor catalog accessor of the transaction
+   * @param db_oid database of the table
+   * @param table_oid table to load the rows into, its indexes may only have column references as keys
+   * @param delimiter character that separates columns within a row
+   * @param quote character used to quote values
+   * @param escape character appearing before the quote character inside quoted values
+   */
+  CopyLoader(common::ManagedPointer<transaction::TransactionContext> txn,
+             common::ManagedPointer<catalog::CatalogAccessor> accessor, catalog::db_oid_t db_oid,
+             catalog::table_oid_t table_oid, char delimiter, char quote, char escape);
+
+  /**
+   * Frees the values of rows that were parsed but never inserted
+   */
+  ~CopyLoader();
+
+  DISALLOW_COPY_AND_MOVE(CopyLoader)
+
+  /**
+   * Checks that the indexes of a table can be maintained by a CopyLoader
+   * @param accessor catalog accessor of the transaction
+   * @param table_oid table to load the rows into
+   * @return true if every index key of the table is a column reference
+   */
+  static bool SupportsIndexes(common::ManagedPointer<catalog::CatalogAccessor> accessor,
+                              catalog::table_oid_t table_oid);
+
+  /**
+   * Parse and load all complete rows in the data received so far. An incomplete row at the end of the chunk is kept
+   * until the rest of it arrives.
+   * @param data next chunk of CSV data
+   * @return COMPLETE, or ERROR if a row could not be loaded, in which case the transaction must abort
+   */
+  TrafficCopResult Append(std::string_view data);
+
+  /**
+   * Load the last row and the remaining batch
+   * @return COMPLETE with the number of rows loaded, or ERROR if a row could not be loaded, in which case the
+   * transaction must abort
+   */
+  TrafficCopResult Finish();
+
+  /** @return number of columns expected in every row */
+  uint16_t NumColumns() const { return static_cast<uint16_t>(columns_.size()); }
+
+  /** @return number of rows inserted into the table so far */
+  uint32_t NumRowsLoaded() const { return num_rows_loaded_; }
+
+ private:
+  /** A column of the table, in schema order */
+  struct CopyColumn {
+    std::string name_;
+    execution::sql::SqlTypeId type_;
+    bool nullable_;
+    uint16_t offset_;
+  };
+
+  /** An index of the table, with the offsets of its key columns in the table's ProjectedRow and in the key */
+  struct CopyIndex {
+    common::ManagedPointer<storage::index::Index> index_;
+    bool unique_;
+    std::vector<std::pair<uint16_t, uint16_t>> key_offsets_;
+    std::vector<uint16_t> key_sizes_;
+  };
+
+  /** Parse all complete rows from the reader into the batch, flushing the batch whenever it is full */
+  void LoadRows();
+
+  /** Convert the current row of the reader into the next ProjectedRow of the batch */
+  void ParseRow();
+
+  /** Convert a cell into the attribute of the given column */
+  void SetAttribute(storage::ProjectedRow *row, const CopyColumn &column,
+                    const execution::util::CSVReader::CSVCell &cell);
+
+  /** Insert the batch into the table and then into each index */
+  void FlushBatch();
+
+  /** Free the out-of-line varlens of the parsed rows of the batch, which were not handed over to the table */
+  void ReleaseBatch();
+
+  const common::ManagedPointer<transaction::TransactionContext> txn_;
+  const catalog::db_oid_t db_oid_;
+  const catalog::table_oid_t table_oid_;
+  const common::ManagedPointer<storage::SqlTable> table_;
+  const storage::ProjectedRowInitializer row_initializer_;
+
+  std::vector<CopyColumn> columns_;
+  std::vector<CopyIndex> indexes_;
+
+  // The reader owns the stream, which is appended to as chunks arrive
+  execution::util::CSVStream *stream_;
+  execution::util::CSVReader reader_;
+
+  // Batch of parsed rows, and the TupleSlots they were inserted at
+  byte *batch_buffer_ = nullptr;
+  std::vector<storage::ProjectedRow *> batch_;
+  std::vector<storage::TupleSlot> batch_slots_;
+  uint32_t batch_size_ = 0;
+  byte *key_buffer_ = nullptr;
+
+  uint32_t num_rows_loaded_ = 0;
+};
+
+}  // namespace noisepage::trafficcop
@@ -7,8 +7,10 @@
 
 #include "catalog/catalog_defs.h"
 #include "common/managed_pointer.h"
+#include "common/worker_pool.h"
 #include "execution/vm/vm_defs.h"
 #include "network/network_defs.h"
+#include "optimizer/optimizer_defs.h"
 #include "traffic_cop/traffic_cop_defs.h"
 #include "transaction/transaction_defs.h"
 
@@ -30,6 +32,7 @@ class OptimizeResult;
 
 namespace noisepage::parser {
 class ConstantValueExpression;
+class CopyStatement;
 class CreateStatement;
 class DropStatement;
 class TransactionStatement;
@@ -62,6 +65,8 @@ class ErrorData;
 
 namespace noisepage::trafficcop {
 
+class CopyLoader;
+
 /**
  * The TrafficCop acts as a translation layer between protocol implementations at at the front-end and execution of
  * queries in the back-end. We strive to encapsulate protocol-agnostic behavior at this layer (i.e. nothing
@@ -78,6 +83,9 @@ class TrafficCop {
    * @param settings_manager the settings manager
    * @param stats_storage for optimizer calls
    * @param optimizer_timeout for optimizer calls
+   * @param cost_model_type cost model used by optimizer calls
+   * @param join_enumeration_threshold largest join tree ordered with dynamic programming by optimizer calls
+   * @param optimizer_threads number of threads that optimizer calls run on, including the connection thread
    * @param use_query_cache whether to cache physical plans and generated code for Extended Query protocol
    * @param execution_mode how to run executable queries after code generation
    */
@@ -87,7 +95,9 @@ class TrafficCop {
              common::ManagedPointer<storage::RecoveryManager> recovery_manager,
              common::ManagedPointer<settings::SettingsManager> settings_manager,
              common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
-             bool use_query_cache, const execution::vm::ExecutionMode execution_mode)
+             optimizer::CostModelType cost_model_type, uint32_t join_enumeration_threshold,
+             uint32_t optimizer_threads, bool use_query_cache,
+             const execution::vm::ExecutionMode execution_mode)
       : txn_manager_(txn_manager),
         catalog_(catalog),
         replication_manager_(replication_manager),
@@ -95,9 +105,16 @@ class TrafficCop {
         settings_manager_(settings_manager),
         stats_storage_(stats_storage),
         optimizer_timeout_(optimizer_timeout),
+        cost_model_type_(cost_model_type),
+        join_enumeration_threshold_(join_enumeration_threshold),
         use_query_cache_(use_query_cache),
         query_cache_timestamp_(transaction::INITIAL_TXN_TIMESTAMP),
-        execution_mode_(execution_mode) {}
+        execution_mode_(execution_mode) {
+    if (optimizer_threads > 1) {
+      optimizer_workers_ = std::make_unique<common::WorkerPool>(optimizer_threads - 1, common::TaskQueue{});
+      optimizer_workers_->Startup();
+    }
+  }
 
   virtual ~TrafficCop() = default;
 
@@ -200,6 +217,29 @@ class TrafficCop {
                                         common::ManagedPointer<network::PostgresPacketWriter> out,
                                         common::ManagedPointer<network::Statement> statement) const;
 
+  /**
+   * Contains the logic to start a COPY ... FROM STDIN. The statement is not bound or optimized, the rows are instead
+   * loaded into the table by the returned CopyLoader as the client sends them.
+   * @param connection_ctx  The context to be used to access the internal txn.
+   * @param copy_stmt       COPY of a table from STDIN, in CSV format.
+   * @return                The loader of the table, or the error that prevents loading it.
+   */
+  std::variant<std::unique_ptr<CopyLoader>, common::ErrorData> BeginCopyFrom(
+      common::ManagedPointer<network::ConnectionContext> connection_ctx,
+      common::ManagedPointer<parser::CopyStatement> copy_stmt) const;
+
+  /**
+   * Contains the logic of COPY ... TO STDOUT. Scans the whole table and writes every row as a CopyData message in CSV
+   * format, enclosed in the CopyOutResponse and CopyDone messages.
+   * @param connection_ctx  The context to be used to access the internal txn.
+   * @param out             The packet writer to return results.
+   * @param copy_stmt       COPY of a table to STDOUT, in CSV format.
+   * @return                The result of the operation, with the number of rows written if it succeeded.
+   */
+  TrafficCopResult ExecuteCopyToStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                          common::ManagedPointer<network::PostgresPacketWriter> out,
+                                          common::ManagedPointer<parser::CopyStatement> copy_stmt) const;
+
   /**
    * Contains the logic to reason about CREATE execution.
    * @param connection_ctx context to be used to access the internal txn
@@ -262,6 +302,25 @@ class TrafficCop {
    */
   void SetOptimizerTimeout(const uint64_t optimizer_timeout) { optimizer_timeout_ = optimizer_timeout; }
 
+  /**
+   * Adjust the TrafficCop's cost model (for use by SettingsManager)
+   * @param cost_model_type cost model used to optimize subsequent queries
+   */
+  void SetCostModel(const optimizer::CostModelType cost_model_type) { cost_model_type_ = cost_model_type; }
+
+  /**
+   * @return cost model used to optimize queries
+   */
+  optimizer::CostModelType GetCostModel() const { return cost_model_type_; }
+
+  /**
+   * Adjust the TrafficCop's join enumeration threshold (for use by SettingsManager)
+   * @param join_enumeration_threshold maximum number of relations in a join tree to order with dynamic programming
+   */
+  void SetJoinEnumerationThreshold(const uint32_t join_enumeration_threshold) {
+    join_enumeration_threshold_ = join_enumeration_threshold;
+  }
+
   /**
    * Adjust the TrafficCop's execution mode value (for use by SettingsManager)
    * @param is_compiled set execution_mode_ to Compiled if true; Interpret if false
@@ -289,6 +348,11 @@ class TrafficCop {
   common::ManagedPointer<settings::SettingsManager> settings_manager_;
   common::ManagedPointer<optimizer::StatsStorage> stats_storage_;
   uint64_t optimizer_timeout_;
+  optimizer::CostModelType cost_model_type_;
+  uint32_t join_enumeration_threshold_;
+  // Threads shared by all connections to optimize independent groups of their queries, nullptr if the optimizer only
+  // runs on the connection thread
+  std::unique_ptr<common::WorkerPool> optimizer_workers_;
   const bool use_query_cache_;
   transaction::timestamp_t query_cache_timestamp_;
   execution::vm::ExecutionMode execution_mode_;
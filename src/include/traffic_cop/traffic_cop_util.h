@@ -8,11 +8,16 @@
 #include "common/managed_pointer.h"
 #include "network/network_defs.h"
 #include "optimizer/optimize_result.h"
+#include "optimizer/optimizer_defs.h"
 
 namespace noisepage::catalog {
 class CatalogAccessor;
 }
 
+namespace noisepage::common {
+class WorkerPool;
+}
+
 namespace noisepage::parser {
 class ConstantValueExpression;
 class ParseResult;
@@ -52,6 +57,8 @@ class TrafficCopUtil {
    * @param cost_model used by optimizer
    * @param optimizer_timeout used by optimizer
    * @param parameters parameters for the query, can be nullptr if there are no parameters
+   * @param join_enumeration_threshold used by optimizer
+   * @param optimizer_workers shared threads used by optimizer, nullptr optimizes on the calling thread only
    * @return physical plan that can be executed
    */
   static std::unique_ptr<optimizer::OptimizeResult> Optimize(
@@ -59,7 +66,9 @@ class TrafficCopUtil {
       common::ManagedPointer<catalog::CatalogAccessor> accessor, common::ManagedPointer<parser::ParseResult> query,
       catalog::db_oid_t db_oid, common::ManagedPointer<optimizer::StatsStorage> stats_storage,
       std::unique_ptr<optimizer::AbstractCostModel> cost_model, uint64_t optimizer_timeout,
-      common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters);
+      common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters,
+      uint32_t join_enumeration_threshold = optimizer::DEFAULT_JOIN_ENUMERATION_THRESHOLD,
+      common::ManagedPointer<common::WorkerPool> optimizer_workers = nullptr);
 
   /**
    * Converts parser statement types (which rely on multiple enums) to a single QueryType enum from the network layer
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "transaction/transaction_defs.h"
@@ -17,11 +20,18 @@ namespace noisepage::transaction {
 class TransactionManager;
 /**
  * Generates timestamps, and keeps track of the lifetime of transactions (whether they have entered or left the system)
+ *
+ * The running transactions are spread over NUM_SHARDS shards by start timestamp, each with its own latch, so that
+ * concurrent begins and commits almost never contend on the same latch. Computing the oldest running transaction visits
+ * every shard instead.
  */
 class TimestampManager {
  public:
+  /** Number of shards of the running transactions set, must be a power of two */
+  static constexpr uint32_t NUM_SHARDS = 64;
+
   ~TimestampManager() {
-    NOISEPAGE_ASSERT(curr_running_txns_.empty(),
+    NOISEPAGE_ASSERT(NoRunningTransactions(),
                      "Destroying the TimestampManager while txns are still running. That seems wrong.");
   }
 
@@ -56,33 +66,73 @@ class TimestampManager {
    */
   timestamp_t CachedOldestTransactionStartTime();
 
+  /**
+   * Only meaningful once commits are tracked (see TrackCommits). Because of concurrent operations, newer commits may
+   * also be serialized by the time this returns.
+   * @return timestamp such that every transaction that committed before it has been serialized by the log manager
+   */
+  timestamp_t SerializedCommitsBefore();
+
  private:
-  // TransactionManager needs to be able to use the curr_running_txns_latch to guard more than just the
-  // duration of the following method calls --- things such as adding to the GC queue needs to be atomic
-  // along with removing a transaction from the table of active transactions. We need this for correctness
-  // in the deferred action framework when dropping tables.
   friend class TransactionManager;
   friend class storage::LogSerializerTask;
+
+  /**
+   * A shard of the running transactions set. Shards are cache line aligned so that latching one does not invalidate
+   * its neighbours.
+   */
+  struct alignas(common::Constants::CACHELINE_SIZE) Shard {
+    // Held by a beginning transaction from checking out its start timestamp until it is in the running transactions set
+    common::SpinLatch begin_latch_;
+    // Guards running_txns_
+    common::SpinLatch running_txns_latch_;
+    std::unordered_set<timestamp_t> running_txns_;
+    // Commit timestamps of the running transactions that have committed, by start timestamp, if commits are tracked
+    std::unordered_map<timestamp_t, timestamp_t> committing_txns_;
+  };
+
   timestamp_t BeginTransaction() {
-    timestamp_t start_time;
-    {
-      common::SpinLatch::ScopedSpinLatch running_guard(&curr_running_txns_latch_);
-      // There is a three-way race that needs to be prevented.  Specifically, we
-      // cannot allow both a transaction to commit and the GC to poll for the
-      // oldest running transaction in between this transaction acquiring its
-      // begin timestamp and getting inserted into the current running
-      // transactions list.  Using the current running transactions latch
-      // prevents the GC from polling and stops the race.  This allows us to
-      // replace acquiring a shared instance of the commit latch with a
-      // read-only spin-latch and move the allocation out of a critical section.
-      start_time = time_++;
-
-      const auto ret UNUSED_ATTRIBUTE = curr_running_txns_.emplace(start_time);
-      NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
-    }  // Release latch on current running transactions
+    // There is a three-way race that needs to be prevented.  Specifically, we
+    // cannot allow both a transaction to commit and the GC to poll for the
+    // oldest running transaction in between this transaction acquiring its
+    // begin timestamp and getting inserted into the current running
+    // transactions list.  Holding a begin latch over both steps lets the GC
+    // wait for every begin that already has a timestamp, by passing through all
+    // of the begin latches before it looks at the running transactions.  The
+    // begin latch is picked by thread and the running transactions shard by
+    // timestamp, so that neither is contended in the common case.  Begin latches
+    // are always taken before running transactions latches.
+    common::SpinLatch::ScopedSpinLatch begin_guard(&shards_[ThreadShard()].begin_latch_);
+    const timestamp_t start_time = time_++;
+    Shard &shard = TimestampShard(start_time);
+    common::SpinLatch::ScopedSpinLatch running_guard(&shard.running_txns_latch_);
+    const auto ret UNUSED_ATTRIBUTE = shard.running_txns_.emplace(start_time);
+    NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
     return start_time;
   }
 
+  /**
+   * Keep track of the transactions that have committed but are not serialized yet, for SerializedCommitsBefore. Must be
+   * called before the first commit.
+   */
+  void TrackCommits() { track_commits_ = true; }
+
+  /**
+   * @param start_time start timestamp of the committing transaction
+   * @return unique timestamp based on current time to commit the transaction at, and advances one tick
+   */
+  timestamp_t CheckOutCommitTimestamp(const timestamp_t start_time) {
+    if (!track_commits_) return CheckOutTimestamp();
+    // Like a begin, the commit holds a begin latch until it is in its shard, so that SerializedCommitsBefore can wait
+    // for every commit that already has a timestamp
+    common::SpinLatch::ScopedSpinLatch begin_guard(&shards_[ThreadShard()].begin_latch_);
+    const timestamp_t commit_time = time_++;
+    Shard &shard = TimestampShard(start_time);
+    common::SpinLatch::ScopedSpinLatch running_guard(&shard.running_txns_latch_);
+    shard.committing_txns_.emplace(start_time, commit_time);
+    return commit_time;
+  }
+
   /**
    * Remove a timestamp from active txn set
    * @param timestamp timestamp to remove
@@ -90,23 +140,44 @@ class TimestampManager {
   void RemoveTransaction(timestamp_t timestamp);
 
   /**
-   * Bulk remove a set of timestamps from the active txn set. Only grabs the curr_running_txns_latch_ once for all the
-   * timestamps.
+   * Bulk remove a set of timestamps from the active txn set. Grabs the latch of each shard once for all the timestamps
+   * in that shard.
    * @param timestamps vector of timestamps to remove
-   * @return True if there are no more running transactions after removal. False otherwise.
+   * @return True if no transaction, including one that was still beginning, was running after removal. False otherwise.
    */
   bool RemoveTransactions(const std::vector<timestamp_t> &timestamps);
 
+  /**
+   * @return true if no shard holds a running transaction, including transactions that are still beginning
+   */
+  bool NoRunningTransactions();
+
+  /**
+   * Wait out the begins that have already checked out a timestamp but may not be in the running transactions set yet,
+   * by passing through every begin latch. Must not be called while holding a running transactions latch.
+   */
+  void WaitForBeginningTransactions();
+
+  /** @return the shard holding the running transaction with the given start time */
+  Shard &TimestampShard(const timestamp_t timestamp) {
+    return shards_[timestamp.UnderlyingValue() & (NUM_SHARDS - 1)];
+  }
+
+  /** @return the index of the begin latch used by the calling thread */
+  static uint32_t ThreadShard();
+
   // TODO(Tianyu): Timestamp generation needs to be more efficient (batches)
   // TODO(Tianyu): We don't handle timestamp wrap-arounds. I doubt this would be an issue any time soon.
   std::atomic<timestamp_t> time_{INITIAL_TXN_TIMESTAMP};
   // We cache the oldest txn start time
   std::atomic<timestamp_t> cached_oldest_txn_start_time_{INITIAL_TXN_TIMESTAMP};
-  // TODO(Matt): consider a different data structure if this becomes a measured bottleneck
+  // Whether the commit timestamps of running transactions are kept, which a partitioned WAL needs
+  bool track_commits_ = false;
   // TODO(Gus): This data structure initially only held items in the order of # of workers. With the logging change, it
   // can hold many more, since txns are only removed when serialized. We should consider if there is a possible better
   // data structure
-  std::unordered_set<timestamp_t> curr_running_txns_;
-  mutable common::SpinLatch curr_running_txns_latch_;
+  std::array<Shard, NUM_SHARDS> shards_;
+
+  static_assert((NUM_SHARDS & (NUM_SHARDS - 1)) == 0, "The number of shards must be a power of two");
 };
 }  // namespace noisepage::transaction
@@ -5,6 +5,7 @@
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "common/object_pool.h"
+#include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/data_table.h"
 #include "storage/record_buffer.h"
@@ -164,7 +165,7 @@ class TransactionContext {
    * @param a the action to be executed. A handle to the system's deferred action manager is supplied
    * to enable further deferral of actions
    */
-  void RegisterAbortAction(const TransactionEndAction &a) { abort_actions_.push_front(a); }
+  void RegisterAbortAction(const TransactionEndAction &a) { RegisterAction(&abort_actions_, a); }
 
   /**
    * Defers an action to be called if and only if the transaction aborts.  Actions executed LIFO.
@@ -180,7 +181,7 @@ class TransactionContext {
    * @param a the action to be executed. A handle to the system's deferred action manager is supplied
    * to enable further deferral of actions
    */
-  void RegisterCommitAction(const TransactionEndAction &a) { commit_actions_.push_front(a); }
+  void RegisterCommitAction(const TransactionEndAction &a) { RegisterAction(&commit_actions_, a); }
 
   /**
    * Defers an action to be called if and only if the transaction commits.  Actions executed LIFO.
@@ -191,6 +192,13 @@ class TransactionContext {
     RegisterCommitAction([=](transaction::DeferredActionManager * /*unused*/) { a(); });
   }
 
+  /**
+   * Sets whether several threads work on behalf of the transaction at once, e.g. parallel optimizer tasks. Commit and
+   * abort actions are only registered under a latch while this is set.
+   * @param concurrent whether actions may be registered concurrently
+   */
+  void SetConcurrent(const bool concurrent) { concurrent_ = concurrent; }
+
   /**
    * This transaction encountered a conflict and cannot commit. Set a breakpoint at TransactionContext::SetMustAbort()
    * and run again to see why.
@@ -244,6 +252,9 @@ class TransactionContext {
   // These actions will be triggered (not deferred) at abort/commit.
   std::forward_list<TransactionEndAction> abort_actions_;
   std::forward_list<TransactionEndAction> commit_actions_;
+  // Protects the actions while they may be registered concurrently
+  common::SpinLatch actions_latch_;
+  bool concurrent_ = false;
 
   // We need to know if the transaction is aborted. Even aborted transactions need an "abort" timestamp in order to
   // eliminate the a-b-a race described in DataTable::Select.
@@ -275,5 +286,15 @@ class TransactionContext {
     new_record->txn_begin_ = start_time_;
     return new_record->GetUnderlyingRecordBodyAs<storage::RedoRecord>();
   }
+
+  // Adds an action to the front of the given list, latching only while actions may be registered concurrently
+  void RegisterAction(std::forward_list<TransactionEndAction> *const actions, const TransactionEndAction &a) {
+    if (concurrent_) {
+      common::SpinLatch::ScopedSpinLatch guard(&actions_latch_);
+      actions->push_front(a);
+      return;
+    }
+    actions->push_front(a);
+  }
 };
 }  // namespace noisepage::transaction
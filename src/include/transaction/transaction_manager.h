@@ -40,19 +40,7 @@ class TransactionManager {
   TransactionManager(const common::ManagedPointer<TimestampManager> timestamp_manager,
                      const common::ManagedPointer<DeferredActionManager> deferred_action_manager,
                      const common::ManagedPointer<storage::RecordBufferSegmentPool> buffer_pool, const bool gc_enabled,
-                     const bool wal_async_commit_enable, const common::ManagedPointer<storage::LogManager> log_manager)
-      : timestamp_manager_(timestamp_manager),
-        deferred_action_manager_(deferred_action_manager),
-        buffer_pool_(buffer_pool),
-        gc_enabled_(gc_enabled),
-        log_manager_(log_manager) {
-    NOISEPAGE_ASSERT(timestamp_manager_ != DISABLED, "transaction manager cannot function without a timestamp manager");
-    NOISEPAGE_ASSERT(!wal_async_commit_enable || (wal_async_commit_enable && log_manager_ != DISABLED),
-                     "Doesn't make sense to enable async commit without enabling logging.");
-    if (wal_async_commit_enable) {
-      SetDefaultTransactionDurabilityPolicy(transaction::DurabilityPolicy::ASYNC);
-    }
-  }
+                     const bool wal_async_commit_enable, const common::ManagedPointer<storage::LogManager> log_manager);
 
   /**
    * Begins a transaction.
@@ -115,6 +103,8 @@ class TransactionManager {
 
   common::Gate txn_gate_;
 
+  // Guards completed_txns_
+  common::SpinLatch completed_txns_latch_;
   TransactionQueue completed_txns_;
   const common::ManagedPointer<storage::LogManager> log_manager_;
 
@@ -10,7 +10,9 @@
 #include "network/postgres/postgres_packet_util.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
 #include "network/postgres/statement.h"
+#include "parser/copy_statement.h"
 #include "parser/variable_show_statement.h"
+#include "traffic_cop/copy_loader.h"
 #include "traffic_cop/traffic_cop.h"
 
 namespace noisepage::network {
@@ -46,6 +48,36 @@ static Transition FinishSimpleQueryCommand(const common::ManagedPointer<Postgres
   return Transition::PROCEED;
 }
 
+/**
+ * @return the COPY statement if it copies a table from STDIN or to STDOUT in CSV format, nullptr otherwise
+ */
+static common::ManagedPointer<parser::CopyStatement> GetStdioCopyStatement(
+    const common::ManagedPointer<network::Statement> statement) {
+  const auto copy_stmt = statement->RootStatement().CastManagedPointerTo<parser::CopyStatement>();
+  if (copy_stmt->GetCopyTable() == nullptr || !copy_stmt->GetFilePath().empty() ||
+      copy_stmt->GetExternalFileFormat() != parser::ExternalFileFormat::CSV) {
+    return nullptr;
+  }
+  return copy_stmt;
+}
+
+/**
+ * Leave the copy-in mode, end the transaction unless it's an explicit transaction block, and tell the client that the
+ * next query can be sent.
+ */
+static Transition FinishCopyInCommand(const common::ManagedPointer<network::PostgresProtocolInterpreter> interpreter,
+                                      const common::ManagedPointer<PostgresPacketWriter> out,
+                                      const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                      const common::ManagedPointer<ConnectionContext> connection) {
+  interpreter->EndCopy();
+  if (!interpreter->ExplicitTransactionBlock()) {
+    t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
+                                                                             : network::QueryType::QUERY_COMMIT);
+    interpreter->ResetTransactionState();
+  }
+  return FinishSimpleQueryCommand(out, connection);
+}
+
 static void ExecutePortal(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
                           const common::ManagedPointer<Portal> portal,
                           const common::ManagedPointer<network::PostgresPacketWriter> out,
@@ -201,8 +233,33 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
     return FinishSimpleQueryCommand(out, connection);
   }
 
-  // This logic relies on ordering of values in the enum's definition and is documented there as well.
-  if (NetworkUtil::UnsupportedQueryType(query_type)) {
+  // COPY of a table from STDIN or to STDOUT bypasses the binder and the optimizer. Everything else about COPY is
+  // unsupported.
+  const auto copy_stmt = query_type == network::QueryType::QUERY_COPY
+                             ? GetStdioCopyStatement(common::ManagedPointer(statement))
+                             : common::ManagedPointer<parser::CopyStatement>(nullptr);
+
+  if (copy_stmt != nullptr && copy_stmt->IsFrom()) {
+    auto begin_result = t_cop->BeginCopyFrom(connection, copy_stmt);
+    if (std::holds_alternative<std::unique_ptr<trafficcop::CopyLoader>>(begin_result)) {
+      auto &loader = std::get<std::unique_ptr<trafficcop::CopyLoader>>(begin_result);
+      out->WriteCopyInResponse(loader->NumColumns());
+      postgres_interpreter->BeginCopy(std::move(loader));
+      // The transaction stays open and ReadyForQuery is held back until the client sends CopyDone or CopyFail
+      return Transition::PROCEED;
+    }
+    connection->Transaction()->SetMustAbort();
+    out->WriteError(std::get<common::ErrorData>(begin_result));
+  } else if (copy_stmt != nullptr) {
+    const auto copy_result = t_cop->ExecuteCopyToStatement(connection, out, copy_stmt);
+    if (copy_result.type_ == trafficcop::ResultType::COMPLETE) {
+      out->WriteCommandComplete(query_type, std::get<uint32_t>(copy_result.extra_));
+    } else {
+      connection->Transaction()->SetMustAbort();
+      out->WriteError(std::get<common::ErrorData>(copy_result.extra_));
+    }
+  } else if (NetworkUtil::UnsupportedQueryType(query_type)) {
+    // This logic relies on ordering of values in the enum's definition and is documented there as well.
     out->WriteError({common::ErrorSeverity::NOTICE, "we don't yet support that query type.",
                      common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED});
     out->WriteCommandComplete(query_type, 0);
@@ -663,6 +720,55 @@ Transition CloseCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
   return Transition::PROCEED;
 }
 
+Transition CopyDataCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  // After an error, the client keeps sending the data it has already queued until it reads our ErrorResponse
+  if (!postgres_interpreter->CopyInProgress()) return Transition::PROCEED;
+
+  const auto result = postgres_interpreter->GetCopyLoader()->Append(in_.ReadRemaining());
+  if (result.type_ == trafficcop::ResultType::COMPLETE) return Transition::PROCEED;
+
+  NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(result.extra_), "We're expecting a message here.");
+  connection->Transaction()->SetMustAbort();
+  out->WriteError(std::get<common::ErrorData>(result.extra_));
+  return FinishCopyInCommand(postgres_interpreter, out, t_cop, connection);
+}
+
+Transition CopyDoneCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  if (!postgres_interpreter->CopyInProgress()) return Transition::PROCEED;
+
+  const auto result = postgres_interpreter->GetCopyLoader()->Finish();
+  if (result.type_ == trafficcop::ResultType::COMPLETE) {
+    out->WriteCommandComplete(QueryType::QUERY_COPY, std::get<uint32_t>(result.extra_));
+  } else {
+    NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(result.extra_), "We're expecting a message here.");
+    connection->Transaction()->SetMustAbort();
+    out->WriteError(std::get<common::ErrorData>(result.extra_));
+  }
+  return FinishCopyInCommand(postgres_interpreter, out, t_cop, connection);
+}
+
+Transition CopyFailCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  if (!postgres_interpreter->CopyInProgress()) return Transition::PROCEED;
+
+  const auto message = in_.ReadString();
+  connection->Transaction()->SetMustAbort();
+  out->WriteError({common::ErrorSeverity::ERROR, "COPY from stdin failed: " + message,
+                   common::ErrorCode::ERRCODE_QUERY_CANCELED});
+  return FinishCopyInCommand(postgres_interpreter, out, t_cop, connection);
+}
+
 Transition TerminateCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
                                   const common::ManagedPointer<PostgresPacketWriter> out,
                                   const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
@@ -186,6 +186,9 @@ void PostgresPacketWriter::WriteCommandComplete(const QueryType query_type, cons
     case QueryType::QUERY_ANALYZE:
       WriteCommandComplete("ANALYZE");
       break;
+    case QueryType::QUERY_COPY:
+      WriteCommandComplete("COPY ", num_rows);
+      break;
     default:
       WriteCommandComplete("This QueryType needs a completion message!");
       break;
@@ -257,6 +260,29 @@ void PostgresPacketWriter::WriteCloseComplete() { BeginPacket(NetworkMessageType
 
 void PostgresPacketWriter::WriteBindComplete() { BeginPacket(NetworkMessageType::PG_BIND_COMPLETE).EndPacket(); }
 
+void PostgresPacketWriter::WriteCopyInResponse(const uint16_t num_columns) {
+  // Overall format and the format of each column, 0 is text
+  BeginPacket(NetworkMessageType::PG_COPY_IN_RESPONSE)
+      .AppendValue<int8_t>(0)
+      .AppendValue<int16_t>(static_cast<int16_t>(num_columns));
+  for (uint16_t i = 0; i < num_columns; i++) AppendValue<int16_t>(0);
+  EndPacket();
+}
+
+void PostgresPacketWriter::WriteCopyOutResponse(const uint16_t num_columns) {
+  BeginPacket(NetworkMessageType::PG_COPY_OUT_RESPONSE)
+      .AppendValue<int8_t>(0)
+      .AppendValue<int16_t>(static_cast<int16_t>(num_columns));
+  for (uint16_t i = 0; i < num_columns; i++) AppendValue<int16_t>(0);
+  EndPacket();
+}
+
+void PostgresPacketWriter::WriteCopyData(const std::string_view data) {
+  BeginPacket(NetworkMessageType::PG_COPY_DATA).AppendStringView(data, false).EndPacket();
+}
+
+void PostgresPacketWriter::WriteCopyDone() { BeginPacket(NetworkMessageType::PG_COPY_DONE).EndPacket(); }
+
 void PostgresPacketWriter::WriteDataRow(const byte *const tuple,
                                         const std::vector<planner::OutputSchema::Column> &columns,
                                         const std::vector<FieldFormat> &field_formats) {
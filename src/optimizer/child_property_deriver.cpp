@@ -130,6 +130,19 @@ void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) {}
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) {}
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const LeftSemiHashJoin *op) { DeriveForJoin(); }
 
+void ChildPropertyDeriver::Visit(const InnerMergeJoin *op) {
+  // Each child must be sorted ascending on its join keys
+  std::vector<OrderByOrderingType> sort_ascending(op->GetLeftKeys().size(), OrderByOrderingType::ASC);
+  auto left_sort = new PropertySort(op->GetLeftKeys(), sort_ascending);
+  auto right_sort = new PropertySort(op->GetRightKeys(), sort_ascending);
+
+  // The right child is streamed in order against the buffered left child, so the output keeps the right sort order
+  auto provided_prop = new PropertySet(std::vector<Property *>{right_sort->Copy()});
+  std::vector<PropertySet *> child_input_properties{new PropertySet(std::vector<Property *>{left_sort}),
+                                                    new PropertySet(std::vector<Property *>{right_sort})};
+  output_.emplace_back(provided_prop, std::move(child_input_properties));
+}
+
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const Insert *op) {
   std::vector<PropertySet *> child_input_properties;
   output_.emplace_back(requirements_->Copy(), std::move(child_input_properties));
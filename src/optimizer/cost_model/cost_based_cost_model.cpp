@@ -0,0 +1,180 @@
+#include "optimizer/cost_model/cost_based_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "catalog/catalog_accessor.h"
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/memo.h"
+#include "optimizer/physical_operators.h"
+#include "parser/expression/column_value_expression.h"
+
+namespace noisepage::optimizer {
+
+double CostBasedCostModel::CalculateCost(transaction::TransactionContext *txn, catalog::CatalogAccessor *accessor,
+                                         Memo *memo, GroupExpression *gexpr) {
+  gexpr_ = gexpr;
+  memo_ = memo;
+  txn_ = txn;
+  accessor_ = accessor;
+  output_cost_ = 0;
+  gexpr_->Contents()->Accept(common::ManagedPointer<OperatorVisitor>(this));
+  return output_cost_;
+}
+
+void CostBasedCostModel::Visit(const SeqScan *op) {
+  // Every tuple of the table is read in storage order and every predicate is evaluated on it
+  const auto table_rows = GetTableRows();
+  const auto num_predicates = static_cast<double>(op->GetPredicates().size());
+  output_cost_ = table_rows * (SEQ_ACCESS_COST + CPU_TUPLE_COST + num_predicates * CPU_OPERATOR_COST);
+}
+
+void CostBasedCostModel::Visit(const IndexScan *op) {
+  const auto table_rows = GetTableRows();
+
+  // Only the index key columns with bounds narrow down the index entries to visit. Their selectivities were already
+  // estimated from the column statistics when the stats of the group were derived.
+  double selectivity = 1.0;
+  if (!op->GetBounds().empty() && accessor_ != nullptr) {
+    const auto &selectivities = memo_->GetGroupByID(gexpr_->GetGroupID())->GetFilterColumnSelectivities();
+    const auto default_selectivity = op->GetIndexScanType() == planner::IndexScanType::Exact
+                                         ? DEFAULT_EQUALITY_SELECTIVITY
+                                         : DEFAULT_RANGE_SELECTIVITY;
+    for (const auto &column : accessor_->GetIndexSchema(op->GetIndexOID()).GetColumns()) {
+      if (op->GetBounds().count(column.Oid()) == 0) continue;
+      auto col_oid = catalog::INVALID_COLUMN_OID;
+      if (column.StoredExpression()->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+        col_oid = column.StoredExpression().CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid();
+      }
+      const auto it = selectivities.find(col_oid);
+      selectivity *= it != selectivities.end() ? it->second : default_selectivity;
+    }
+  }
+
+  // Descend the index once, then visit every matching entry and fetch its tuple through a random access. The remaining
+  // predicates are evaluated on each fetched tuple.
+  const auto matched_rows = table_rows * selectivity;
+  const auto num_predicates = static_cast<double>(op->GetPredicates().size());
+  output_cost_ = INDEX_DESCENT_COST + std::log2(table_rows + 1) * CPU_INDEX_TUPLE_COST +
+                 matched_rows * (CPU_INDEX_TUPLE_COST + RANDOM_ACCESS_COST + CPU_TUPLE_COST +
+                                 num_predicates * CPU_OPERATOR_COST);
+}
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const QueryDerivedScan *op) {
+  output_cost_ = GetChildRows(0) * CPU_TUPLE_COST;
+}
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const OrderBy *op) {
+  // The sort enforcer is part of the group it sorts, so its input has the cardinality of that group
+  const auto rows = GetOutputRows();
+  output_cost_ = rows * (MEMORY_TUPLE_COST + CPU_TUPLE_COST) + rows * std::log2(rows + 1) * CPU_OPERATOR_COST;
+}
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const Limit *op) { output_cost_ = GetOutputRows() * CPU_TUPLE_COST; }
+
+void CostBasedCostModel::Visit(const InnerIndexJoin *op) {
+  // Every outer tuple descends the index, and every match is fetched from the inner table
+  const auto outer_rows = GetChildRows(0);
+  const auto output_rows = GetOutputRows();
+  const auto num_predicates = static_cast<double>(op->GetJoinPredicates().size());
+  output_cost_ = outer_rows * (INDEX_DESCENT_COST + num_predicates * CPU_OPERATOR_COST) +
+                 output_rows * (CPU_INDEX_TUPLE_COST + RANDOM_ACCESS_COST + CPU_TUPLE_COST);
+}
+
+void CostBasedCostModel::Visit(const InnerNLJoin *op) { CostNLJoin(op->GetJoinPredicates().size()); }
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const LeftNLJoin *op) { CostNLJoin(1); }
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const RightNLJoin *op) { CostNLJoin(1); }
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const OuterNLJoin *op) { CostNLJoin(1); }
+
+void CostBasedCostModel::Visit(const InnerHashJoin *op) { CostHashJoin(op->GetLeftKeys().size()); }
+
+void CostBasedCostModel::Visit(const LeftHashJoin *op) { CostHashJoin(op->GetLeftKeys().size()); }
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) { CostHashJoin(1); }
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) { CostHashJoin(1); }
+
+void CostBasedCostModel::Visit(const LeftSemiHashJoin *op) { CostHashJoin(op->GetLeftKeys().size()); }
+
+void CostBasedCostModel::Visit(const InnerMergeJoin *op) {
+  // The left input is buffered, the right input is streamed, and both are compared on every merge key. The cost of
+  // sorting the inputs, if they are not already sorted, is charged to the OrderBy enforcers below the join.
+  const auto left_rows = GetChildRows(0);
+  const auto right_rows = GetChildRows(1);
+  const auto num_keys = static_cast<double>(std::max<size_t>(op->GetLeftKeys().size(), 1));
+  output_cost_ = left_rows * MEMORY_TUPLE_COST + (left_rows + right_rows) * num_keys * CPU_OPERATOR_COST +
+                 GetOutputRows() * CPU_TUPLE_COST;
+}
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const Insert *op) { output_cost_ = GetOutputRows() * CPU_TUPLE_COST; }
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const InsertSelect *op) {
+  output_cost_ = GetChildRows(0) * CPU_TUPLE_COST;
+}
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const Delete *op) {
+  output_cost_ = GetChildRows(0) * (RANDOM_ACCESS_COST + CPU_TUPLE_COST);
+}
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const Update *op) {
+  output_cost_ = GetChildRows(0) * (RANDOM_ACCESS_COST + CPU_TUPLE_COST);
+}
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const HashGroupBy *op) {
+  // Every input tuple is hashed into the aggregation table, which holds one entry per group
+  output_cost_ = GetChildRows(0) * HASH_BUILD_COST + GetOutputRows() * (MEMORY_TUPLE_COST + CPU_TUPLE_COST);
+}
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const SortGroupBy *op) {
+  // The input arrives sorted on the grouping columns, so groups are formed by comparing adjacent tuples
+  output_cost_ = GetChildRows(0) * CPU_OPERATOR_COST + GetOutputRows() * CPU_TUPLE_COST;
+}
+
+void CostBasedCostModel::Visit(UNUSED_ATTRIBUTE const Aggregate *op) {
+  output_cost_ = GetChildRows(0) * CPU_OPERATOR_COST + CPU_TUPLE_COST;
+}
+
+double CostBasedCostModel::GetOutputRows() const { return GetGroupRows(gexpr_->GetGroupID()); }
+
+double CostBasedCostModel::GetChildRows(const int child_idx) const {
+  if (gexpr_->GetChildrenGroupsSize() <= static_cast<size_t>(child_idx)) return 0;
+  return GetGroupRows(gexpr_->GetChildGroupId(child_idx));
+}
+
+double CostBasedCostModel::GetTableRows() const {
+  // TableStats report zero rows for tables that have never been analyzed, which would make every access path free
+  const auto table_rows = memo_->GetGroupByID(gexpr_->GetGroupID())->GetTableNumRows();
+  if (table_rows == Group::UNINITIALIZED_NUM_ROWS || table_rows == 0) return DEFAULT_NUM_ROWS;
+  return static_cast<double>(table_rows);
+}
+
+double CostBasedCostModel::GetGroupRows(const group_id_t group_id) const {
+  auto *group = memo_->GetGroupByID(group_id);
+  if (!group->HasNumRows()) return DEFAULT_NUM_ROWS;
+  return static_cast<double>(group->GetNumRows());
+}
+
+void CostBasedCostModel::CostNLJoin(const size_t num_predicates) {
+  // The right input is re-iterated for every left tuple
+  const auto left_rows = GetChildRows(0);
+  const auto right_rows = GetChildRows(1);
+  const auto pairs = left_rows * right_rows;
+  output_cost_ = pairs * (CPU_TUPLE_COST + static_cast<double>(std::max<size_t>(num_predicates, 1)) *
+                                               CPU_OPERATOR_COST) +
+                 GetOutputRows() * CPU_TUPLE_COST;
+}
+
+void CostBasedCostModel::CostHashJoin(const size_t num_keys) {
+  // The left input is materialized in the hash table, so building on the smaller input is cheaper
+  const auto left_rows = GetChildRows(0);
+  const auto right_rows = GetChildRows(1);
+  const auto key_cost = static_cast<double>(std::max<size_t>(num_keys, 1)) * CPU_OPERATOR_COST;
+  output_cost_ = left_rows * (HASH_BUILD_COST + MEMORY_TUPLE_COST + key_cost) +
+                 right_rows * (HASH_PROBE_COST + key_cost) + GetOutputRows() * CPU_TUPLE_COST;
+}
+
+}  // namespace noisepage::optimizer
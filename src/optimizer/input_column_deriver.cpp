@@ -293,6 +293,8 @@ void InputColumnDeriver::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) {
   NOISEPAGE_ASSERT(0, "OuterHashJoin not supported");
 }
 
+void InputColumnDeriver::Visit(const InnerMergeJoin *op) { JoinHelper(op); }
+
 void InputColumnDeriver::Visit(UNUSED_ATTRIBUTE const Insert *op) {
   auto input = std::vector<std::vector<common::ManagedPointer<parser::AbstractExpression>>>{};
   output_input_cols_ = std::make_pair(std::move(required_cols_), std::move(input));
@@ -448,6 +450,11 @@ void InputColumnDeriver::JoinHelper(const BaseOperatorNodeContents *op) {
     join_conds = join_op->GetJoinPredicates();
     left_keys = join_op->GetLeftKeys();
     right_keys = join_op->GetRightKeys();
+  } else if (op->GetOpType() == OpType::INNERMERGEJOIN) {
+    auto join_op = reinterpret_cast<const InnerMergeJoin *>(op);
+    join_conds = join_op->GetJoinPredicates();
+    left_keys = join_op->GetLeftKeys();
+    right_keys = join_op->GetRightKeys();
   }
 
   ExprSet input_cols_set;
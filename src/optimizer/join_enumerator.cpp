@@ -0,0 +1,274 @@
+#include "optimizer/join_enumerator.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "loggers/optimizer_logger.h"
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/logical_operators.h"
+#include "optimizer/memo.h"
+#include "optimizer/optimizer_context.h"
+#include "optimizer/rule.h"
+#include "optimizer/statistics/stats_calculator.h"
+
+namespace noisepage::optimizer {
+
+namespace {
+
+// Relation sets are bitmasks, so a set with a single bit set is a single relation
+bool IsSingleRelation(const uint64_t relations) { return (relations & (relations - 1)) == 0; }
+
+// Iterate over all non-empty subsets of 'relations' in increasing numeric order, which visits every subset of a set
+// before the set itself
+template <typename F>
+void ForEachSubset(const uint64_t relations, F f) {
+  for (uint64_t subset = (0 - relations) & relations; subset != 0; subset = (subset - relations) & relations) {
+    f(subset);
+  }
+}
+
+}  // namespace
+
+void JoinEnumerator::EnumerateJoins(const group_id_t group_id) {
+  auto *gexpr = context_->GetMemo().GetGroupByID(group_id)->GetLogicalExpressions()[0];
+  if (gexpr->Contents()->GetOpType() == OpType::LOGICALINNERJOIN) {
+    EnumerateJoinTree(group_id);
+    return;
+  }
+  for (const auto child_group_id : gexpr->GetChildGroupIDs()) {
+    EnumerateJoins(child_group_id);
+  }
+}
+
+void JoinEnumerator::EnumerateJoinTree(const group_id_t group_id) {
+  auto &memo = context_->GetMemo();
+  CollectJoinTree(group_id);
+  const auto num_relations = relations_.size();
+
+  if (num_relations <= MAX_JOIN_RELATIONS) {
+    const RelationSet all_relations = num_relations == 64 ? ~RelationSet{0} : (RelationSet{1} << num_relations) - 1;
+
+    // Find the relations that each predicate references. Predicates that reference tables outside of the join tree
+    // can only be evaluated once all relations are joined.
+    neighbors_.assign(num_relations, 0);
+    for (auto &predicate : predicates_) {
+      size_t num_found = 0;
+      for (const auto &alias : predicate.predicate_.GetTableAliasSet()) {
+        bool found = false;
+        for (size_t i = 0; i < num_relations; i++) {
+          if (memo.GetGroupByID(relations_[i])->GetTableAliases().count(alias) == 0) continue;
+          predicate.relations_ |= RelationSet{1} << i;
+          found = true;
+        }
+        if (found) num_found++;
+      }
+      if (num_found != predicate.predicate_.GetTableAliasSet().size()) predicate.relations_ = all_relations;
+
+      // A predicate connects every pair of relations it references
+      if (IsSingleRelation(predicate.relations_)) continue;
+      for (size_t i = 0; i < num_relations; i++) {
+        const RelationSet relation = RelationSet{1} << i;
+        if ((predicate.relations_ & relation) != 0) neighbors_[i] |= predicate.relations_ & ~relation;
+      }
+    }
+
+    if (num_relations <= dp_threshold_) {
+      // DPccp only enumerates connected subgraphs. If the join graph is not connected, the query has a cross product
+      // somewhere, so consider cross products between any relations and let the cost model pick where to put it.
+      RelationSet reachable = 1;
+      for (RelationSet frontier = 1; frontier != 0;) {
+        frontier = GetNeighbors(reachable, 0);
+        reachable |= frontier;
+      }
+      if (reachable != all_relations) {
+        for (size_t i = 0; i < num_relations; i++) neighbors_[i] = all_relations & ~(RelationSet{1} << i);
+      }
+      EnumerateDPccp();
+    } else {
+      EnumerateGreedy();
+    }
+
+    // The join orders of the tree are complete, so there is nothing left for the join transformation rules to explore
+    for (const auto &join_group : join_groups_) {
+      if (IsSingleRelation(join_group.first)) continue;
+      for (auto *join_expr : memo.GetGroupByID(join_group.second)->GetLogicalExpressions()) {
+        MarkJoinRulesExplored(join_expr);
+      }
+    }
+    OPTIMIZER_LOG_DEBUG("Enumerated {0} join groups for {1} relations", join_groups_.size() - num_relations,
+                        num_relations);
+  } else {
+    OPTIMIZER_LOG_DEBUG("Join tree with {0} relations is left to the transformation rules", num_relations);
+  }
+
+  // The relations may contain join trees of their own, e.g. in derived tables
+  auto relations = std::move(relations_);
+  relations_.clear();
+  predicates_.clear();
+  neighbors_.clear();
+  join_groups_.clear();
+  for (const auto relation : relations) {
+    EnumerateJoins(relation);
+  }
+}
+
+JoinEnumerator::RelationSet JoinEnumerator::CollectJoinTree(const group_id_t group_id) {
+  auto *gexpr = context_->GetMemo().GetGroupByID(group_id)->GetLogicalExpressions()[0];
+  if (gexpr->Contents()->GetOpType() != OpType::LOGICALINNERJOIN) {
+    // Any other operator is a relation of the join graph. Relations beyond the capacity of a RelationSet are collected
+    // without a set so that the caller can detect it.
+    const RelationSet relation = relations_.size() < MAX_JOIN_RELATIONS ? RelationSet{1} << relations_.size() : 0;
+    relations_.push_back(group_id);
+    join_groups_[relation] = group_id;
+    return relation;
+  }
+
+  for (const auto &predicate : gexpr->Contents()->GetContentsAs<LogicalInnerJoin>()->GetJoinPredicates()) {
+    predicates_.push_back({predicate, 0});
+  }
+  const auto relations = CollectJoinTree(gexpr->GetChildGroupId(0)) | CollectJoinTree(gexpr->GetChildGroupId(1));
+  join_groups_[relations] = group_id;
+  return relations;
+}
+
+void JoinEnumerator::EnumerateDPccp() {
+  // Start from every relation in descending order, and only extend it with relations that come after it. This emits
+  // every connected subgraph exactly once, and after all of its own subgraphs.
+  for (auto i = relations_.size(); i-- > 0;) {
+    const RelationSet relation = RelationSet{1} << i;
+    EmitCsg(relation);
+    EnumerateCsgRec(relation, (relation << 1) - 1);
+  }
+}
+
+void JoinEnumerator::EnumerateCsgRec(const RelationSet csg, const RelationSet excluded) {
+  const auto neighbors = GetNeighbors(csg, excluded);
+  ForEachSubset(neighbors, [&](RelationSet subset) { EmitCsg(csg | subset); });
+  ForEachSubset(neighbors, [&](RelationSet subset) { EnumerateCsgRec(csg | subset, excluded | neighbors); });
+}
+
+void JoinEnumerator::EmitCsg(const RelationSet csg) {
+  // Complements may only contain relations after the first relation of the subgraph, so every pair is emitted once
+  const RelationSet lowest = csg & (0 - csg);
+  const RelationSet excluded = csg | ((lowest << 1) - 1);
+  const auto neighbors = GetNeighbors(csg, excluded);
+
+  // Start from the highest neighbor, which restricts its complements the least
+  for (auto remaining = neighbors; remaining != 0;) {
+    const RelationSet relation = RelationSet{1} << (MAX_JOIN_RELATIONS - 1 - __builtin_clzll(remaining));
+    remaining &= ~relation;
+    EmitJoin(csg, relation);
+    EnumerateCmpRec(csg, relation, excluded | (neighbors & ((relation << 1) - 1)));
+  }
+}
+
+void JoinEnumerator::EnumerateCmpRec(const RelationSet csg, const RelationSet cmp, const RelationSet excluded) {
+  const auto neighbors = GetNeighbors(cmp, excluded);
+  ForEachSubset(neighbors, [&](RelationSet subset) { EmitJoin(csg, cmp | subset); });
+  ForEachSubset(neighbors, [&](RelationSet subset) { EnumerateCmpRec(csg, cmp | subset, excluded | neighbors); });
+}
+
+void JoinEnumerator::EnumerateGreedy() {
+  auto &memo = context_->GetMemo();
+  // Relations without derived stats are estimated with a default by the stats calculator, rather than counting as
+  // empty and being joined first
+  const auto get_num_rows = [&](RelationSet relations) {
+    return memo.GetGroupByID(join_groups_.at(relations))->GetNumRows();
+  };
+
+  std::vector<RelationSet> trees;
+  for (size_t i = 0; i < relations_.size(); i++) trees.push_back(RelationSet{1} << i);
+
+  while (trees.size() > 1) {
+    // Join the pair of trees with the smallest result, preferring pairs connected by a join predicate
+    size_t best_left = 0, best_right = 1;
+    size_t best_num_rows = std::numeric_limits<size_t>::max();
+    bool best_connected = false;
+    for (size_t left = 0; left < trees.size(); left++) {
+      for (size_t right = left + 1; right < trees.size(); right++) {
+        const bool connected = (GetNeighbors(trees[left], 0) & trees[right]) != 0;
+        if (best_connected && !connected) continue;
+        const auto num_rows = StatsCalculator::EstimateCardinalityForJoin(
+            get_num_rows(trees[left]), get_num_rows(trees[right]), GetJoinPredicates(trees[left], trees[right]));
+        if ((connected && !best_connected) || num_rows < best_num_rows) {
+          best_left = left;
+          best_right = right;
+          best_num_rows = num_rows;
+          best_connected = connected;
+        }
+      }
+    }
+
+    EmitJoin(trees[best_left], trees[best_right]);
+    trees[best_left] |= trees[best_right];
+    trees.erase(trees.begin() + best_right);
+  }
+}
+
+group_id_t JoinEnumerator::EmitJoin(const RelationSet left, const RelationSet right) {
+  NOISEPAGE_ASSERT(join_groups_.count(left) != 0 && join_groups_.count(right) != 0,
+                   "Both sides of a join should be emitted before the join itself");
+  auto &memo = context_->GetMemo();
+  auto *txn = context_->GetTxn();
+  const auto relations = left | right;
+  const auto it = join_groups_.find(relations);
+  auto group_id = it == join_groups_.end() ? UNDEFINED_GROUP : it->second;
+
+  // The cost model decides which side is built or iterated on, so add both orders
+  for (const auto &children : {std::make_pair(left, right), std::make_pair(right, left)}) {
+    std::vector<group_id_t> child_groups{join_groups_.at(children.first), join_groups_.at(children.second)};
+    auto *gexpr = new GroupExpression(
+        LogicalInnerJoin::Make(GetJoinPredicates(children.first, children.second)).RegisterWithTxnContext(txn),
+        std::move(child_groups), txn);
+    auto *memo_expr = memo.InsertExpression(gexpr, group_id, false);
+    NOISEPAGE_ASSERT(memo_expr != nullptr, "Joins are never leaves");
+
+    if (group_id == UNDEFINED_GROUP) {
+      // The first join of a new set of relations creates its group. Derive its stats right away, since its stats are
+      // needed by the joins above it.
+      group_id = memo_expr->GetGroupID();
+      join_groups_[relations] = group_id;
+      StatsCalculator calculator;
+      calculator.CalculateStats(memo_expr, context_);
+      memo_expr->SetDerivedStats();
+    }
+  }
+  return group_id;
+}
+
+std::vector<AnnotatedExpression> JoinEnumerator::GetJoinPredicates(const RelationSet left,
+                                                                   const RelationSet right) const {
+  // A predicate is evaluated by the lowest join that has all of its relations. If one side already has all of them,
+  // it was evaluated below, unless that side is a single relation.
+  const auto relations = left | right;
+  std::vector<AnnotatedExpression> predicates;
+  for (const auto &predicate : predicates_) {
+    if ((predicate.relations_ & ~relations) != 0) continue;
+    if ((predicate.relations_ & ~left) == 0 && !IsSingleRelation(left)) continue;
+    if ((predicate.relations_ & ~right) == 0 && !IsSingleRelation(right)) continue;
+    predicates.emplace_back(predicate.predicate_);
+  }
+  return predicates;
+}
+
+JoinEnumerator::RelationSet JoinEnumerator::GetNeighbors(const RelationSet relations,
+                                                         const RelationSet excluded) const {
+  RelationSet neighbors = 0;
+  for (auto remaining = relations; remaining != 0; remaining &= remaining - 1) {
+    neighbors |= neighbors_[__builtin_ctzll(remaining)];
+  }
+  return neighbors & ~relations & ~excluded;
+}
+
+void JoinEnumerator::MarkJoinRulesExplored(GroupExpression *gexpr) {
+  if (gexpr->Contents()->GetOpType() != OpType::LOGICALINNERJOIN) return;
+  for (auto *rule : context_->GetRuleSet().GetRulesByName(RuleSetName::LOGICAL_TRANSFORMATION)) {
+    if (rule->GetType() == RuleType::INNER_JOIN_COMMUTE || rule->GetType() == RuleType::INNER_JOIN_ASSOCIATE) {
+      gexpr->SetRuleExplored(rule);
+    }
+  }
+}
+
+}  // namespace noisepage::optimizer
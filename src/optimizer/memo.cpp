@@ -23,6 +23,14 @@ GroupExpression *Memo::InsertExpression(GroupExpression *gexpr, group_id_t targe
   }
  
   gexpr->SetGroupID(target_group);
+  if (concurrent_) {
+    common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+    return InsertExpressionUnlocked(gexpr, target_group, enforced);
+  }
+  return InsertExpressionUnlocked(gexpr, target_group, enforced);
+}
+
+GroupExpression *Memo::InsertExpressionUnlocked(GroupExpression *gexpr, group_id_t target_group, bool enforced) {
   // Lookup in hash table
   auto it = group_expressions_.find(gexpr);
   if (it != group_expressions_.end()) {
@@ -42,7 +50,7 @@ GroupExpression *Memo::InsertExpression(GroupExpression *gexpr, group_id_t targe
     group_id = target_group;
   }
 
-  Group *group = GetGroupByID(group_id);
+  Group *group = GetGroupByIDUnlocked(group_id);
   group->AddExpression(gexpr, enforced);
   return gexpr;
 }
@@ -67,7 +75,7 @@ group_id_t Memo::AddNewGroup(GroupExpression *gexpr) {
   } else {
     // For other groups, need to aggregate the table alias from children
     for (auto child_group_id : gexpr->GetChildGroupIDs()) {
-      Group *child_group = GetGroupByID(child_group_id);
+      Group *child_group = GetGroupByIDUnlocked(child_group_id);
       for (auto &table_alias : child_group->GetTableAliases()) {
         table_aliases.insert(table_alias);
       }
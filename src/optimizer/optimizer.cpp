@@ -1,6 +1,9 @@
 #include "optimizer/optimizer.h"
 
+#include <algorithm>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -221,23 +224,154 @@ void Optimizer::OptimizeLoop(group_id_t root_group_id, PropertySet *required_pro
   task_stack->Push(new BottomUpRewrite(root_group_id, root_context, RuleSetName::UNNEST_SUBQUERY, false));
   ExecuteTaskStack(task_stack, root_group_id, root_context);
 
-  // Perform optimization after the rewrite
+  // Enumerate the join orders once the stats of their relations are known
   Memo &memo = context_->GetMemo();
-  task_stack->Push(new OptimizeGroup(memo.GetGroupByID(root_group_id), root_context));
+  task_stack->Push(new EnumerateJoins(root_group_id, join_enumeration_threshold_, root_context));
 
   // Derive stats for the only one logical expression before optimizing
   task_stack->Push(new DeriveStats(memo.GetGroupByID(root_group_id)->GetLogicalExpression(), root_context));
-
   ExecuteTaskStack(task_stack, root_group_id, root_context);
+
+  // The parallel pass and the root pass share the time limit
+  uint64_t parallel_time = 0;
+  if (workers_ != nullptr) {
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&parallel_time);
+      OptimizeIndependentGroups(root_group_id, task_execution_timeout_);
+    }
+    task_stack = new OptimizerTaskStack();
+    context_->SetTaskPool(task_stack);
+  }
+
+  // Perform optimization after the rewrite
+  task_stack->Push(new OptimizeGroup(memo.GetGroupByID(root_group_id), root_context));
+  ExecuteTaskStack(task_stack, root_group_id, root_context, parallel_time);
+}
+
+void Optimizer::OptimizeIndependentGroups(group_id_t root_group_id, const uint64_t budget) {
+  auto groups = CollectIndependentGroups(root_group_id);
+  if (groups.size() < 2) return;
+
+  auto task_pool = new ConcurrentOptimizerTaskPool(workers_);
+  context_->SetTaskPool(task_pool);
+  for (auto group_id : groups) {
+    auto ctx = new OptimizationContext(context_.get(), new PropertySet());
+    context_->AddOptimizationContext(ctx);
+    task_pool->Push(new OptimizeGroup(context_->GetMemo().GetGroupByID(group_id), ctx));
+  }
+  context_->SetConcurrent(true);
+  try {
+    task_pool->Execute(budget);
+  } catch (...) {
+    context_->SetConcurrent(false);
+    throw;
+  }
+  context_->SetConcurrent(false);
+}
+
+std::vector<group_id_t> Optimizer::CollectIndependentGroups(group_id_t root_group_id) {
+  Memo &memo = context_->GetMemo();
+
+  // Number the groups reachable from the root, the root is 0
+  std::vector<group_id_t> groups{root_group_id};
+  std::unordered_map<group_id_t, size_t> index{{root_group_id, 0}};
+  std::vector<std::vector<size_t>> children;
+  for (size_t node = 0; node < groups.size(); node++) {
+    children.emplace_back();
+    for (auto *gexpr : memo.GetGroupByID(groups[node])->GetLogicalExpressions()) {
+      for (auto child : gexpr->GetChildGroupIDs()) {
+        auto it = index.find(child);
+        if (it == index.end()) {
+          it = index.emplace(child, groups.size()).first;
+          groups.push_back(child);
+        }
+        children[node].push_back(it->second);
+      }
+    }
+  }
+
+  // Order the groups topologically, parents before children
+  const auto num_groups = groups.size();
+  std::vector<std::vector<size_t>> parents(num_groups);
+  for (size_t node = 0; node < num_groups; node++) {
+    for (auto child : children[node]) parents[child].push_back(node);
+  }
+  std::vector<size_t> topological{0};
+  std::vector<size_t> pending_parents(num_groups);
+  for (size_t node = 0; node < num_groups; node++) pending_parents[node] = parents[node].size();
+  for (size_t i = 0; i < topological.size(); i++) {
+    for (auto child : children[topological[i]]) {
+      if (--pending_parents[child] == 0) topological.push_back(child);
+    }
+  }
+
+  // The Memo is a DAG, so the immediate dominator of a group is the closest common dominator of its parents
+  std::vector<size_t> idom(num_groups, 0);
+  std::vector<size_t> depth(num_groups, 0);
+  auto common_dominator = [&](size_t a, size_t b) {
+    while (a != b) {
+      if (depth[a] < depth[b]) std::swap(a, b);
+      a = idom[a];
+    }
+    return a;
+  };
+  for (auto node : topological) {
+    if (node == 0) continue;
+    auto dominator = parents[node][0];
+    for (auto parent : parents[node]) dominator = common_dominator(dominator, parent);
+    idom[node] = dominator;
+    depth[node] = depth[dominator] + 1;
+  }
+
+  // A group is independent if every group in its subtree is dominated by it. For every edge u->v, the dominators of u
+  // that do not dominate v have an edge leaving their subtree, so they are not independent.
+  std::vector<bool> independent(num_groups, true);
+  independent[0] = false;
+  for (size_t node = 0; node < num_groups; node++) {
+    for (auto child : children[node]) {
+      const auto stop = common_dominator(node, child);
+      for (auto dominator = node; dominator != stop; dominator = idom[dominator]) independent[dominator] = false;
+    }
+  }
+
+  // Topmost independent groups strictly below the given group
+  auto topmost_independent = [&](size_t top) {
+    std::vector<size_t> result;
+    std::unordered_set<size_t> seen{top};
+    std::vector<size_t> frontier{top};
+    while (!frontier.empty()) {
+      const auto node = frontier.back();
+      frontier.pop_back();
+      for (auto child : children[node]) {
+        if (!seen.insert(child).second) continue;
+        if (independent[child]) {
+          result.push_back(child);
+        } else {
+          frontier.push_back(child);
+        }
+      }
+    }
+    return result;
+  };
+
+  std::vector<size_t> jobs{0};
+  while (jobs.size() == 1) {
+    auto below = topmost_independent(jobs[0]);
+    if (below.empty()) break;
+    jobs = std::move(below);
+  }
+
+  std::vector<group_id_t> result;
+  if (jobs.size() < 2) return result;
+  for (auto job : jobs) result.push_back(groups[job]);
+  return result;
 }
 
 void Optimizer::ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id,
-                                 OptimizationContext *root_context) {
+                                 OptimizationContext *root_context, uint64_t elapsed_time) {
   auto root_group = context_->GetMemo().GetGroupByID(root_group_id);
   const auto &required_props = root_context->GetRequiredProperties();
 
-  uint64_t elapsed_time = 0;
-
   // Iterate through the task stack
   while (!task_stack->Empty()) {
     // Check to see if we have at least one plan, and if we have exceeded our
@@ -1,9 +1,16 @@
 #include "optimizer/optimizer_context.h"
 
 #include "optimizer/logical_operators.h"
+#include "transaction/transaction_context.h"
 
 namespace noisepage::optimizer {
 
+void OptimizerContext::SetConcurrent(const bool concurrent) {
+  concurrent_ = concurrent;
+  memo_.SetConcurrent(concurrent);
+  txn_->SetConcurrent(concurrent);
+}
+
 GroupExpression *OptimizerContext::MakeGroupExpression(common::ManagedPointer<AbstractOptimizerNode> node) {
   std::vector<group_id_t> child_groups;
   for (auto &child : node->GetChildren()) {
@@ -8,6 +8,7 @@
 #include "loggers/optimizer_logger.h"
 #include "optimizer/binding.h"
 #include "optimizer/child_property_deriver.h"
+#include "optimizer/join_enumerator.h"
 #include "optimizer/optimizer_context.h"
 #include "optimizer/property_enforcer.h"
 #include "optimizer/statistics/stats_calculator.h"
@@ -218,6 +219,15 @@ void DeriveStats::Execute() {
   }
 }
 
+//===--------------------------------------------------------------------===//
+// EnumerateJoins
+//===--------------------------------------------------------------------===//
+void EnumerateJoins::Execute() {
+  OPTIMIZER_LOG_TRACE("EnumerateJoins::Execute() group " + std::to_string(group_id_.UnderlyingValue()));
+  JoinEnumerator enumerator(context_->GetOptimizerContext(), dp_threshold_);
+  enumerator.EnumerateJoins(group_id_);
+}
+
 //===--------------------------------------------------------------------===//
 // OptimizeExpressionCostWithEnforcedProperty
 //===--------------------------------------------------------------------===//
@@ -258,9 +268,7 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
       // Compute the cost of the root operator 计算根操作符的代价
       // 1. Collect stats needed and cache them in the group 收集并缓存所需的统计信息
       // 2. Calculate cost based on children's stats 基于子表达式的统计信息计算代价
-      cur_total_cost_ += context_->GetOptimizerContext()->GetCostModel()->CalculateCost(
-          context_->GetOptimizerContext()->GetTxn(), context_->GetOptimizerContext()->GetCatalogAccessor(),
-          &context_->GetOptimizerContext()->GetMemo(), group_expr_);
+      cur_total_cost_ += context_->GetOptimizerContext()->CalculateCost(group_expr_);
     }
 
     for (; cur_child_idx_ < static_cast<int>(group_expr_->GetChildrenGroupsSize()); cur_child_idx_++) {
@@ -332,9 +340,7 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
           // Cost the enforced expression
           auto extended_prop_set = output_prop->Copy();
           extended_prop_set->AddProperty(prop->Copy());
-          cur_total_cost_ += context_->GetOptimizerContext()->GetCostModel()->CalculateCost(
-              context_->GetOptimizerContext()->GetTxn(), context_->GetOptimizerContext()->GetCatalogAccessor(),
-              &context_->GetOptimizerContext()->GetMemo(), memo_enforced_expr);
+          cur_total_cost_ += context_->GetOptimizerContext()->CalculateCost(memo_enforced_expr);
 
           // Update hash tables for group and group expression
           memo_enforced_expr->SetLocalHashTable(extended_prop_set, {pre_output_prop_set}, cur_total_cost_);
@@ -0,0 +1,153 @@
+#include "optimizer/optimizer_task_pool.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace noisepage::optimizer {
+
+namespace {
+// Private stack of the job that the current thread is running, nullptr if the thread is not a worker
+thread_local std::stack<OptimizerTask *> *worker_stack = nullptr;
+}  // namespace
+
+ConcurrentOptimizerTaskPool::ConcurrentOptimizerTaskPool(const common::ManagedPointer<common::WorkerPool> workers)
+    : workers_(workers), num_workers_(workers == nullptr ? 1 : workers->NumWorkers() + 1), queues_(num_workers_) {}
+
+ConcurrentOptimizerTaskPool::~ConcurrentOptimizerTaskPool() {
+  for (auto &queue : queues_) {
+    for (auto *job : queue.jobs_) delete job;
+  }
+}
+
+OptimizerTask *ConcurrentOptimizerTaskPool::Pop() {
+  if (worker_stack != nullptr) {
+    // ownership handed off to caller
+    auto task = worker_stack->top();
+    worker_stack->pop();
+    return task;
+  }
+  for (auto &queue : queues_) {
+    common::SpinLatch::ScopedSpinLatch guard(&queue.latch_);
+    if (queue.jobs_.empty()) continue;
+    auto job = queue.jobs_.front();
+    queue.jobs_.pop_front();
+    return job;
+  }
+  return nullptr;
+}
+
+void ConcurrentOptimizerTaskPool::Push(OptimizerTask *task) {
+  if (worker_stack != nullptr) {
+    worker_stack->push(task);
+    return;
+  }
+  auto &queue = queues_[next_queue_];
+  next_queue_ = (next_queue_ + 1) % num_workers_;
+  common::SpinLatch::ScopedSpinLatch guard(&queue.latch_);
+  queue.jobs_.push_back(task);
+}
+
+bool ConcurrentOptimizerTaskPool::Empty() {
+  if (worker_stack != nullptr) return worker_stack->empty();
+  for (auto &queue : queues_) {
+    common::SpinLatch::ScopedSpinLatch guard(&queue.latch_);
+    if (!queue.jobs_.empty()) return false;
+  }
+  return true;
+}
+
+void ConcurrentOptimizerTaskPool::Execute(const uint64_t budget) {
+  deadline_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(budget);
+
+  // Jobs are never added while the workers run, so there is no point in starting more workers than there are jobs
+  uint32_t num_jobs = 0;
+  for (auto &queue : queues_) num_jobs += static_cast<uint32_t>(queue.jobs_.size());
+  const auto num_threads = std::min(num_workers_, num_jobs);
+
+  // The calling thread is worker 0, the shared pool runs the others whenever it has a free thread
+  auto state = std::make_shared<WorkerState>();
+  for (uint32_t i = 1; i < num_threads; i++) {
+    workers_->SubmitTask([this, state, i] {
+      {
+        std::lock_guard<std::mutex> lock(state->latch_);
+        if (state->closed_) return;
+        state->running_++;
+      }
+      RunWorker(i);
+      std::lock_guard<std::mutex> lock(state->latch_);
+      state->running_--;
+      state->stopped_.notify_all();
+    });
+  }
+  if (num_threads > 0) RunWorker(0);
+
+  // Worker 0 only stops once no job is left to start, so workers that have not started yet have nothing to do
+  {
+    std::unique_lock<std::mutex> lock(state->latch_);
+    state->closed_ = true;
+    state->stopped_.wait(lock, [&] { return state->running_ == 0; });
+  }
+
+  if (error_ != nullptr) std::rethrow_exception(error_);
+}
+
+void ConcurrentOptimizerTaskPool::RunWorker(const uint32_t worker_id) {
+  std::stack<OptimizerTask *> stack;
+  worker_stack = &stack;
+
+  while (!aborted_.load() && std::chrono::steady_clock::now() < deadline_) {
+    auto *job = NextJob(worker_id);
+    if (job == nullptr) break;
+
+    stack.push(job);
+    OptimizerTask *task = nullptr;
+    try {
+      while (!stack.empty()) {
+        task = stack.top();
+        stack.pop();
+        task->Execute();
+        delete task;
+        task = nullptr;
+      }
+    } catch (...) {
+      {
+        common::SpinLatch::ScopedSpinLatch guard(&error_latch_);
+        if (error_ == nullptr) error_ = std::current_exception();
+      }
+      aborted_.store(true);
+      delete task;
+      while (!stack.empty()) {
+        delete stack.top();
+        stack.pop();
+      }
+    }
+  }
+
+  worker_stack = nullptr;
+}
+
+OptimizerTask *ConcurrentOptimizerTaskPool::NextJob(const uint32_t worker_id) {
+  {
+    auto &own = queues_[worker_id];
+    common::SpinLatch::ScopedSpinLatch guard(&own.latch_);
+    if (!own.jobs_.empty()) {
+      auto job = own.jobs_.back();
+      own.jobs_.pop_back();
+      return job;
+    }
+  }
+
+  for (uint32_t i = 1; i < num_workers_; i++) {
+    auto &victim = queues_[(worker_id + i) % num_workers_];
+    common::SpinLatch::ScopedSpinLatch guard(&victim.latch_);
+    if (!victim.jobs_.empty()) {
+      auto job = victim.jobs_.front();
+      victim.jobs_.pop_front();
+      return job;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace noisepage::optimizer
@@ -1,5 +1,7 @@
 #include "optimizer/plan_generator.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -16,7 +18,9 @@
 #include "optimizer/property_set.h"
 #include "optimizer/util.h"
 #include "parser/expression/abstract_expression.h"
+#include "parser/expression/column_value_expression.h"
 #include "parser/expression/constant_value_expression.h"
+#include "parser/expression/derived_value_expression.h"
 #include "parser/expression_util.h"
 #include "planner/plannodes/aggregate_plan_node.h"
 #include "planner/plannodes/analyze_plan_node.h"
@@ -42,17 +46,28 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
 #include "settings/settings_manager.h"
+#include "storage/index/index.h"
 #include "storage/sql_table.h"
 #include "transaction/transaction_context.h"
 
 namespace noisepage::optimizer {
 
+namespace {
+// A hash join pushes a bloom filter into its probe-side scan only if the probe side has at least this many rows,
+constexpr size_t BLOOM_FILTER_MIN_PROBE_ROWS = 10000;
+// the build side has at most this many rows (bounding the filter's size),
+constexpr size_t BLOOM_FILTER_MAX_BUILD_ROWS = size_t{1} << 26;
+// and the build side is at most this fraction of the probe side.
+constexpr double BLOOM_FILTER_MAX_BUILD_PROBE_RATIO = 0.5;
+}  // namespace
+
 PlanGenerator::PlanGenerator(common::ManagedPointer<planner::PlanMetaData> plan_meta_data)
     : plan_id_counter_(0), plan_meta_data_(plan_meta_data) {}
 
@@ -161,6 +176,27 @@ std::vector<catalog::col_oid_t> PlanGenerator::GenerateColumnsForScan(const pars
   return column_ids;
 }
 
+bool PlanGenerator::IsIndexOnlyScan(catalog::index_oid_t index_oid, planner::IndexScanType scan_type,
+                                    const std::vector<catalog::col_oid_t> &column_ids) {
+  if (column_ids.empty()) return false;
+  // Only ascending key scans return the keys in the order of the results
+  if (scan_type == planner::IndexScanType::Descending || scan_type == planner::IndexScanType::DescendingLimit) {
+    return false;
+  }
+  // Exact scans know the key of every result from the lookup, range scans need the index to return the keys
+  if (scan_type != planner::IndexScanType::Exact && !accessor_->GetIndex(index_oid)->SupportsKeyScans()) return false;
+
+  std::unordered_set<catalog::col_oid_t> key_oids;
+  for (const auto &key_col : accessor_->GetIndexSchema(index_oid).GetColumns()) {
+    const auto expr = key_col.StoredExpression();
+    if (expr->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+      key_oids.emplace(expr.CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid());
+    }
+  }
+  return std::all_of(column_ids.cbegin(), column_ids.cend(),
+                     [&key_oids](const catalog::col_oid_t col_oid) { return key_oids.count(col_oid) != 0; });
+}
+
 void PlanGenerator::GenerateColumnsFromExpression(std::unordered_set<catalog::col_oid_t> *oids,
                                                   const parser::AbstractExpression *expr) {
   if (expr == nullptr) return;
@@ -225,6 +261,9 @@ void PlanGenerator::Visit(const IndexScan *op) {
   // Generate ouptut column IDs for plan
   // An IndexScan (for now at least) will output all columns of its table
   std::vector<catalog::col_oid_t> column_ids = GenerateColumnsForScan(predicate);
+  // Scans for updates read the tuples they change anyway
+  const bool index_only =
+      !op->GetIsForUpdate() && IsIndexOnlyScan(op->GetIndexOID(), op->GetIndexScanType(), column_ids);
 
   auto builder = planner::IndexScanPlanNode::Builder();
   builder.SetOutputSchema(std::move(output_schema));
@@ -238,6 +277,7 @@ void PlanGenerator::Visit(const IndexScan *op) {
   builder.SetTableNumTuple(table_num_tuple);
   builder.SetIndexSize(accessor_->GetTable(tbl_oid)->GetNumTuple());
   builder.SetCoverAllColumns(op->GetCoverAllColumns());
+  builder.SetIndexOnly(index_only);
 
   auto type = op->GetIndexScanType();
   builder.SetScanType(type);
@@ -607,6 +647,52 @@ void PlanGenerator::Visit(UNUSED_ATTRIBUTE const OuterNLJoin *op) {
 // A hashjoin B (what you should do for large relations.....)
 ///////////////////////////////////////////////////////////////////////////////
 
+bool PlanGenerator::ShouldPushDownBloomFilter(
+    const planner::AbstractPlanNode &build_plan, const planner::AbstractPlanNode &probe_plan,
+    const std::vector<common::ManagedPointer<parser::AbstractExpression>> &probe_keys) {
+  // The filter is applied by the probe-side scan, so the probe keys must be plain columns of that scan.
+  if (probe_plan.GetPlanNodeType() != planner::PlanNodeType::SEQSCAN) {
+    return false;
+  }
+  const auto &probe_schema = *probe_plan.GetOutputSchema();
+  for (const auto &key : probe_keys) {
+    if (key->GetExpressionType() != parser::ExpressionType::VALUE_TUPLE) {
+      return false;
+    }
+    const auto dve = key.CastManagedPointerTo<parser::DerivedValueExpression>();
+    const auto &col = probe_schema.GetColumn(dve->GetValueIdx());
+    if (col.GetExpr()->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+      return false;
+    }
+    // The vectorized probe must hash keys exactly like the scalar join build does.
+    switch (col.GetType()) {
+      case execution::sql::SqlTypeId::Boolean:
+      case execution::sql::SqlTypeId::TinyInt:
+      case execution::sql::SqlTypeId::SmallInt:
+      case execution::sql::SqlTypeId::Integer:
+      case execution::sql::SqlTypeId::BigInt:
+      case execution::sql::SqlTypeId::Date:
+      case execution::sql::SqlTypeId::Timestamp:
+      case execution::sql::SqlTypeId::Varchar:
+        break;
+      default:
+        return false;
+    }
+  }
+
+  // Only worth it when the build side is known to be much smaller than a large probe side.
+  const auto build_rows = plan_meta_data_->GetPlanNodeMetaData(build_plan.GetPlanNodeId()).GetCardinality();
+  const auto probe_rows = plan_meta_data_->GetPlanNodeMetaData(probe_plan.GetPlanNodeId()).GetCardinality();
+  constexpr size_t unknown_rows = std::numeric_limits<size_t>::max();
+  if (build_rows == 0 || build_rows == unknown_rows || probe_rows == unknown_rows) {
+    return false;
+  }
+  if (probe_rows < BLOOM_FILTER_MIN_PROBE_ROWS || build_rows > BLOOM_FILTER_MAX_BUILD_ROWS) {
+    return false;
+  }
+  return static_cast<double>(build_rows) <= BLOOM_FILTER_MAX_BUILD_PROBE_RATIO * static_cast<double>(probe_rows);
+}
+
 void PlanGenerator::Visit(const InnerHashJoin *op) {
   auto proj_schema = GenerateProjectionForJoin();
 
@@ -627,12 +713,15 @@ void PlanGenerator::Visit(const InnerHashJoin *op) {
     builder.AddLeftHashKey(common::ManagedPointer(left_key));
   }
 
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
   for (auto &expr : op->GetRightKeys()) {
     auto right_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
     RegisterPointerCleanup<parser::AbstractExpression>(right_key, true, true);
     builder.AddRightHashKey(common::ManagedPointer(right_key));
+    right_keys.emplace_back(right_key);
   }
 
+  builder.SetBloomFilterPushdown(ShouldPushDownBloomFilter(*children_plans_[0], *children_plans_[1], right_keys));
   builder.AddChild(std::move(children_plans_[0]));
   builder.AddChild(std::move(children_plans_[1]));
   builder.SetJoinPredicate(common::ManagedPointer(join_predicate));
@@ -660,12 +749,15 @@ void PlanGenerator::Visit(const LeftHashJoin *op) {
     builder.AddLeftHashKey(common::ManagedPointer(left_key));
   }
 
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
   for (auto &expr : op->GetRightKeys()) {
     auto right_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
     RegisterPointerCleanup<parser::AbstractExpression>(right_key, true, true);
     builder.AddRightHashKey(common::ManagedPointer(right_key));
+    right_keys.emplace_back(right_key);
   }
 
+  builder.SetBloomFilterPushdown(ShouldPushDownBloomFilter(*children_plans_[0], *children_plans_[1], right_keys));
   builder.AddChild(std::move(children_plans_[0]));
   builder.AddChild(std::move(children_plans_[1]));
   builder.SetJoinPredicate(common::ManagedPointer(join_predicate));
@@ -705,12 +797,15 @@ void PlanGenerator::Visit(const LeftSemiHashJoin *op) {
     builder.AddLeftHashKey(common::ManagedPointer(left_key));
   }
 
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
   for (auto &expr : op->GetRightKeys()) {
     auto right_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
     RegisterPointerCleanup<parser::AbstractExpression>(right_key, true, true);
     builder.AddRightHashKey(common::ManagedPointer(right_key));
+    right_keys.emplace_back(right_key);
   }
 
+  builder.SetBloomFilterPushdown(ShouldPushDownBloomFilter(*children_plans_[0], *children_plans_[1], right_keys));
   builder.AddChild(std::move(children_plans_[0]));
   builder.AddChild(std::move(children_plans_[1]));
   builder.SetJoinPredicate(common::ManagedPointer(join_predicate));
@@ -718,6 +813,39 @@ void PlanGenerator::Visit(const LeftSemiHashJoin *op) {
   output_plan_ = builder.Build();
 }
 
+void PlanGenerator::Visit(const InnerMergeJoin *op) {
+  auto proj_schema = GenerateProjectionForJoin();
+
+  auto comb_pred = parser::ExpressionUtil::JoinAnnotatedExprs(op->GetJoinPredicates());
+  auto eval_pred =
+      parser::ExpressionUtil::EvaluateExpression(children_expr_map_, common::ManagedPointer(comb_pred.get()));
+  auto join_predicate =
+      parser::ExpressionUtil::ConvertExprCVNodes(common::ManagedPointer(eval_pred.get()), children_expr_map_).release();
+  RegisterPointerCleanup<parser::AbstractExpression>(join_predicate, true, true);
+
+  auto builder = planner::MergeJoinPlanNode::Builder();
+  builder.SetOutputSchema(std::move(proj_schema));
+  builder.SetPlanNodeId(GetNextPlanNodeID());
+
+  for (auto &expr : op->GetLeftKeys()) {
+    auto left_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
+    RegisterPointerCleanup<parser::AbstractExpression>(left_key, true, true);
+    builder.AddLeftMergeKey(common::ManagedPointer(left_key));
+  }
+
+  for (auto &expr : op->GetRightKeys()) {
+    auto right_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
+    RegisterPointerCleanup<parser::AbstractExpression>(right_key, true, true);
+    builder.AddRightMergeKey(common::ManagedPointer(right_key));
+  }
+
+  builder.AddChild(std::move(children_plans_[0]));
+  builder.AddChild(std::move(children_plans_[1]));
+  builder.SetJoinPredicate(common::ManagedPointer(join_predicate));
+  builder.SetJoinType(planner::LogicalJoinType::INNER);
+  output_plan_ = builder.Build();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Aggregations (when the groups are greater than individuals)
 ///////////////////////////////////////////////////////////////////////////////
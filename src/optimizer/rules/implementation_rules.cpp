@@ -624,6 +624,106 @@ void LogicalInnerJoinToPhysicalInnerHashJoin::Transform(
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalInnerJoinToPhysicalInnerMergeJoin
+///////////////////////////////////////////////////////////////////////////////
+LogicalInnerJoinToPhysicalInnerMergeJoin::LogicalInnerJoinToPhysicalInnerMergeJoin() {
+  type_ = RuleType::INNER_JOIN_TO_MERGE_JOIN;
+
+  // Make three node types for pattern matching
+  auto left_child(new Pattern(OpType::LEAF));
+  auto right_child(new Pattern(OpType::LEAF));
+
+  // Initialize a pattern for optimizer to match
+  match_pattern_ = new Pattern(OpType::LOGICALINNERJOIN);
+
+  // Add node - we match join relation R and S as well as the predicate exp
+  match_pattern_->AddChild(left_child);
+  match_pattern_->AddChild(right_child);
+}
+
+bool LogicalInnerJoinToPhysicalInnerMergeJoin::Check(common::ManagedPointer<AbstractOptimizerNode> plan,
+                                                     OptimizationContext *context) const {
+  // Both inputs are sorted on their keys and merged by comparing the keys with '<' and '>'. Every
+  // key pair must therefore be ordered the same way on both sides.
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys;
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
+  ExtractMergeJoinKeys(plan, context, &left_keys, &right_keys);
+  if (left_keys.empty()) {
+    return false;
+  }
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    const auto ordering = MergeKeyOrdering(left_keys[i]->GetReturnValueType());
+    if (ordering == execution::sql::SqlTypeId::Invalid ||
+        ordering != MergeKeyOrdering(right_keys[i]->GetReturnValueType())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+execution::sql::SqlTypeId LogicalInnerJoinToPhysicalInnerMergeJoin::MergeKeyOrdering(
+    const execution::sql::SqlTypeId type) {
+  switch (type) {
+    case execution::sql::SqlTypeId::TinyInt:
+    case execution::sql::SqlTypeId::SmallInt:
+    case execution::sql::SqlTypeId::Integer:
+    case execution::sql::SqlTypeId::BigInt:
+      return execution::sql::SqlTypeId::BigInt;
+    case execution::sql::SqlTypeId::Real:
+    case execution::sql::SqlTypeId::Double:
+      return execution::sql::SqlTypeId::Double;
+    case execution::sql::SqlTypeId::Date:
+    case execution::sql::SqlTypeId::Timestamp:
+    case execution::sql::SqlTypeId::Varchar:
+      return type;
+    default:
+      return execution::sql::SqlTypeId::Invalid;
+  }
+}
+
+std::vector<AnnotatedExpression> LogicalInnerJoinToPhysicalInnerMergeJoin::ExtractMergeJoinKeys(
+    common::ManagedPointer<AbstractOptimizerNode> plan, OptimizationContext *context,
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> *left_keys,
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> *right_keys) {
+  const auto inner_join = plan->Contents()->GetContentsAs<LogicalInnerJoin>();
+
+  auto children = plan->GetChildren();
+  NOISEPAGE_ASSERT(children.size() == 2, "Inner Join should have two children");
+  auto left_group_id = children[0]->Contents()->GetContentsAs<LeafOperator>()->GetOriginGroup();
+  auto right_group_id = children[1]->Contents()->GetContentsAs<LeafOperator>()->GetOriginGroup();
+  auto &left_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(left_group_id)->GetTableAliases();
+  auto &right_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(right_group_id)->GetTableAliases();
+
+  std::vector<AnnotatedExpression> join_preds = inner_join->GetJoinPredicates();
+  OptimizerUtil::ExtractEquiJoinKeys(join_preds, left_keys, right_keys, left_group_alias, right_group_alias);
+  return join_preds;
+}
+
+void LogicalInnerJoinToPhysicalInnerMergeJoin::Transform(
+    common::ManagedPointer<AbstractOptimizerNode> input,
+    std::vector<std::unique_ptr<AbstractOptimizerNode>> *transformed,
+    UNUSED_ATTRIBUTE OptimizationContext *context) const {
+  auto children = input->GetChildren();
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys;
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
+  std::vector<AnnotatedExpression> join_preds = ExtractMergeJoinKeys(input, context, &left_keys, &right_keys);
+
+  NOISEPAGE_ASSERT(right_keys.size() == left_keys.size(), "# left/right keys should equal");
+  std::vector<std::unique_ptr<AbstractOptimizerNode>> child;
+  child.emplace_back(children[0]->Copy());
+  child.emplace_back(children[1]->Copy());
+
+  // The sort order each child must provide is derived from the keys by the ChildPropertyDeriver
+  if (!left_keys.empty()) {
+    auto result = std::make_unique<OperatorNode>(
+        InnerMergeJoin::Make(std::move(join_preds), std::move(left_keys), std::move(right_keys))
+            .RegisterWithTxnContext(context->GetOptimizerContext()->GetTxn()),
+        std::move(child), context->GetOptimizerContext()->GetTxn());
+    transformed->emplace_back(std::move(result));
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LogicalSemiJoinToPhysicalSemiLeftHashJoin
 ///////////////////////////////////////////////////////////////////////////////
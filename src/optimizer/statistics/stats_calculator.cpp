@@ -90,23 +90,8 @@ void StatsCalculator::Visit(const LogicalInnerJoin *op) {
 
   // Calculate output num rows first
   if (root_group->GetNumRows() == Group::UNINITIALIZED_NUM_ROWS) {
-    size_t curr_rows = left_child_group->GetNumRows() * right_child_group->GetNumRows();
-    for (const auto &annotated_expr : op->GetJoinPredicates()) {
-      // See if there are join conditions
-      if (annotated_expr.GetExpr()->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL &&
-          annotated_expr.GetExpr()->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
-          annotated_expr.GetExpr()->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
-        NOISEPAGE_ASSERT(left_child_group->HasNumRows() && right_child_group->HasNumRows(),
-                         "Child groups should have their stats derived");
-        /*
-         * TODO(Joseph Koshakow) This isn't really that accurate, it doesn't take into account overlap of predicates
-         *  i.e. if predicate 1 matches two rows and predicate 2 matches the same two rows, then predicate 2 will have
-         *  no affect on the total row count but we will unnecessary lower the total row count.
-         */
-        curr_rows /= std::max(std::max(left_child_group->GetNumRows(), right_child_group->GetNumRows()), 1UL);
-      }
-    }
-    root_group->SetNumRows(static_cast<size_t>(curr_rows));
+    root_group->SetNumRows(EstimateCardinalityForJoin(left_child_group->GetNumRows(),
+                                                      right_child_group->GetNumRows(), op->GetJoinPredicates()));
   }
 
   // TODO(boweic): calculate stats based on predicates other than join conditions
@@ -121,24 +106,32 @@ void StatsCalculator::Visit(const LogicalSemiJoin *op) {
 
   // Calculate output num rows first
   if (root_group->GetNumRows() == Group::UNINITIALIZED_NUM_ROWS) {
-    size_t curr_rows = left_child_group->GetNumRows() * right_child_group->GetNumRows();
-    for (const auto &annotated_expr : op->GetJoinPredicates()) {
-      // See if there are join conditions
-      if (annotated_expr.GetExpr()->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL &&
-          annotated_expr.GetExpr()->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
-          annotated_expr.GetExpr()->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
-        NOISEPAGE_ASSERT(left_child_group->HasNumRows() && right_child_group->HasNumRows(),
-                         "Child groups should have their stats derived");
-        /*
-         * TODO(Joseph Koshakow) This isn't really that accurate, it doesn't take into account overlap of predicates
-         *  i.e. if predicate 1 matches two rows and predicate 2 matches the same two rows, then predicate 2 will have
-         *  no affect on the total row count but we will unnecessary lower the total row count.
-         */
-        curr_rows /= std::max(std::max(left_child_group->GetNumRows(), right_child_group->GetNumRows()), 1UL);
-      }
+    root_group->SetNumRows(EstimateCardinalityForJoin(left_child_group->GetNumRows(),
+                                                      right_child_group->GetNumRows(), op->GetJoinPredicates()));
+  }
+}
+
+size_t StatsCalculator::EstimateCardinalityForJoin(size_t left_num_rows, size_t right_num_rows,
+                                                   const std::vector<AnnotatedExpression> &join_predicates) {
+  // Inputs whose stats are missing, e.g. groups whose operator has no stats derivation yet, get a default estimate
+  if (left_num_rows == Group::UNINITIALIZED_NUM_ROWS) left_num_rows = DEFAULT_NUM_ROWS;
+  if (right_num_rows == Group::UNINITIALIZED_NUM_ROWS) right_num_rows = DEFAULT_NUM_ROWS;
+
+  size_t curr_rows = left_num_rows * right_num_rows;
+  for (const auto &annotated_expr : join_predicates) {
+    // See if there are join conditions
+    if (annotated_expr.GetExpr()->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL &&
+        annotated_expr.GetExpr()->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
+        annotated_expr.GetExpr()->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+      /*
+       * TODO(Joseph Koshakow) This isn't really that accurate, it doesn't take into account overlap of predicates
+       *  i.e. if predicate 1 matches two rows and predicate 2 matches the same two rows, then predicate 2 will have
+       *  no affect on the total row count but we will unnecessary lower the total row count.
+       */
+      curr_rows /= std::max(std::max(left_num_rows, right_num_rows), 1UL);
     }
-    root_group->SetNumRows(static_cast<size_t>(curr_rows));
   }
+  return curr_rows;
 }
 
 void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalAggregateAndGroupBy *op) {
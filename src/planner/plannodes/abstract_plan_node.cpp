@@ -28,6 +28,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
@@ -231,6 +232,11 @@ JSONDeserializeNodeIntermediate DeserializePlanNode(const nlohmann::json &json)
       break;
     }
 
+    case PlanNodeType::MERGEJOIN: {
+      plan_node = std::make_unique<MergeJoinPlanNode>();
+      break;
+    }
+
     case PlanNodeType::INSERT: {
       plan_node = std::make_unique<InsertPlanNode>();
       break;
@@ -12,7 +12,8 @@ namespace noisepage::planner {
 std::unique_ptr<HashJoinPlanNode> HashJoinPlanNode::Builder::Build() {
   return std::unique_ptr<HashJoinPlanNode>(new HashJoinPlanNode(std::move(children_), std::move(output_schema_),
                                                                 join_type_, join_predicate_, std::move(left_hash_keys_),
-                                                                std::move(right_hash_keys_), plan_node_id_));
+                                                                std::move(right_hash_keys_), bloom_filter_pushdown_,
+                                                                plan_node_id_));
 }
 
 HashJoinPlanNode::HashJoinPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
@@ -20,10 +21,11 @@ HashJoinPlanNode::HashJoinPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>
                                    common::ManagedPointer<parser::AbstractExpression> predicate,
                                    std::vector<common::ManagedPointer<parser::AbstractExpression>> &&left_hash_keys,
                                    std::vector<common::ManagedPointer<parser::AbstractExpression>> &&right_hash_keys,
-                                   plan_node_id_t plan_node_id)
+                                   bool bloom_filter_pushdown, plan_node_id_t plan_node_id)
     : AbstractJoinPlanNode(std::move(children), std::move(output_schema), join_type, predicate, plan_node_id),
       left_hash_keys_(std::move(left_hash_keys)),
-      right_hash_keys_(std::move(right_hash_keys)) {}
+      right_hash_keys_(std::move(right_hash_keys)),
+      bloom_filter_pushdown_(bloom_filter_pushdown) {}
 
 common::hash_t HashJoinPlanNode::Hash() const {
   common::hash_t hash = AbstractJoinPlanNode::Hash();
@@ -38,6 +40,8 @@ common::hash_t HashJoinPlanNode::Hash() const {
     hash = common::HashUtil::CombineHashes(hash, right_hash_key->Hash());
   }
 
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(bloom_filter_pushdown_));
+
   return hash;
 }
 
@@ -58,6 +62,8 @@ bool HashJoinPlanNode::operator==(const AbstractPlanNode &rhs) const {
     if (*right_hash_keys_[i] != *other.right_hash_keys_[i]) return false;
   }
 
+  if (bloom_filter_pushdown_ != other.bloom_filter_pushdown_) return false;
+
   return true;
 }
 
@@ -65,6 +71,7 @@ nlohmann::json HashJoinPlanNode::ToJson() const {
   nlohmann::json j = AbstractJoinPlanNode::ToJson();
   j["left_hash_keys"] = left_hash_keys_;
   j["right_hash_keys"] = right_hash_keys_;
+  j["bloom_filter_pushdown"] = bloom_filter_pushdown_;
   return j;
 }
 
@@ -97,6 +104,8 @@ std::vector<std::unique_ptr<parser::AbstractExpression>> HashJoinPlanNode::FromJ
     }
   }
 
+  bloom_filter_pushdown_ = j.at("bloom_filter_pushdown").get<bool>();
+
   return exprs;
 }
 
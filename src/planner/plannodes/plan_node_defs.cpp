@@ -20,6 +20,8 @@ std::string PlanNodeTypeToString(PlanNodeType type) {
       return "HashJoin";
     case PlanNodeType::INDEXNLJOIN:
       return "IndexNestedLoopJoin";
+    case PlanNodeType::MERGEJOIN:
+      return "MergeJoin";
     case PlanNodeType::UPDATE:
       return "Update";
     case PlanNodeType::INSERT:
@@ -76,14 +76,7 @@ void PrimaryReplicationManager::ReplicateBatchOfRecords(storage::BufferedLogWrit
     ReplicationMessageMetadata metadata(GetNextMessageId());
     RecordsBatchMsg msg(metadata, GetNextBatchId(), records_batch);
     REPLICATION_LOG_TRACE(fmt::format("[SEND] BATCH {}", msg.GetBatchId()));
-
-    messenger::callback_id_t destination_cb =
-        messenger::Messenger::GetBuiltinCallback(messenger::Messenger::BuiltinCallback::NOOP);
-    const msg_id_t msg_id = msg.GetMessageId();
-    const std::string msg_string = msg.Serialize();
-    for (const auto &replica : replicas_) {
-      Send(replica.first, msg_id, msg_string, messenger::CallbackFns::Noop, destination_cb);
-    }
+    SendToReplicas(msg);
 
     NOISEPAGE_ASSERT(newest_buffer_txn >= newest_txn_sent_,
                      "The assumption is that transactions are monotonically increasing.");
@@ -100,14 +93,23 @@ void PrimaryReplicationManager::NotifyReplicasOfOAT(transaction::timestamp_t old
   ReplicationMessageMetadata metadata(GetNextMessageId());
   NotifyOATMsg msg(metadata, last_sent_batch_id_, oldest_active_txn);
   REPLICATION_LOG_TRACE(fmt::format("[SEND] BATCH {} OAT {}", msg.GetBatchId(), msg.GetOldestActiveTxn()));
+  SendToReplicas(msg);
+}
 
+void PrimaryReplicationManager::SendToReplicas(const BaseReplicationMessage &msg) {
   messenger::callback_id_t destination_cb =
       messenger::Messenger::GetBuiltinCallback(messenger::Messenger::BuiltinCallback::NOOP);
 
-  const msg_id_t msg_id = msg.GetMessageId();
-  const std::string msg_string = msg.Serialize();
+  // The message is serialized at most once per format, however many replicas asked for it.
+  std::string msgpack_string;
+  std::string binary_string;
   for (const auto &replica : replicas_) {
-    Send(replica.first, msg_id, msg_string, messenger::CallbackFns::Noop, destination_cb);
+    const ReplicationMessageFormat format = GetNodeFormat(replica.first);
+    std::string &msg_string = format == ReplicationMessageFormat::BINARY ? binary_string : msgpack_string;
+    if (msg_string.empty()) {
+      msg_string = msg.Serialize(format);
+    }
+    Send(replica.first, msg.GetMessageId(), msg_string, messenger::CallbackFns::Noop, destination_cb);
   }
 }
 
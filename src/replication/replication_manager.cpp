@@ -22,6 +22,11 @@ ReplicationManager::ReplicationManager(
       listen_destination, network_identity,
       [this](common::ManagedPointer<messenger::Messenger> messenger, const messenger::ZmqMessage &msg) {
         auto replication_msg = BaseReplicationMessage::ParseFromString(msg.GetMessage());
+        {
+          // Reply to the node in whichever format it asked for.
+          std::unique_lock lock(node_formats_mutex_);
+          node_formats_[std::string(msg.GetRoutingId())] = replication_msg->GetMetadata().GetRequestedFormat();
+        }
         EventLoop(messenger, msg, common::ManagedPointer(replication_msg));
       });
   // Connect to all of the other nodes.
@@ -44,6 +49,12 @@ void ReplicationManager::NodeConnect(const std::string &node_name, const std::st
   NOISEPAGE_ASSERT(result.second, "Failed to connect to a replica?");
 }
 
+ReplicationMessageFormat ReplicationManager::GetNodeFormat(const std::string &node_name) {
+  std::unique_lock lock(node_formats_mutex_);
+  const auto it = node_formats_.find(node_name);
+  return it != node_formats_.end() ? it->second : ReplicationMessageFormat::MSGPACK;
+}
+
 messenger::connection_id_t ReplicationManager::GetNodeConnection(const std::string &replica_name) {
   return replicas_.at(replica_name).GetConnectionId();
 }
@@ -1,6 +1,7 @@
 #include "replication/replication_messages.h"
 
 #include "common/json.h"
+#include "spdlog/fmt/fmt.h"
 #include "storage/write_ahead_log/log_io.h"
 
 namespace noisepage::replication {
@@ -8,12 +9,14 @@ namespace noisepage::replication {
 // All the string keys. Hopefully having them in one place minimizes conflict.
 
 const char *ReplicationMessageMetadata::key_message_id = "message_id";
+const char *ReplicationMessageMetadata::key_requested_format = "requested_format";
 const char *BaseReplicationMessage::key_message_type = "message_type";
 const char *BaseReplicationMessage::key_metadata = "metadata";
 const char *NotifyOATMsg::key_batch_id = "oat_batch";
 const char *NotifyOATMsg::key_oldest_active_txn = "oat_ts";
 const char *RecordsBatchMsg::key_batch_id = "batch_id";
 const char *RecordsBatchMsg::key_contents = "contents";
+const char *RecordsBatchMsg::key_compressed = "compressed";
 const char *TxnAppliedMsg::key_applied_txn_id = "applied_txn_id";
 
 // MessageWrapper
@@ -27,6 +30,8 @@ template <typename T>
 void MessageWrapper::Put(const char *key, T value) {
   (*underlying_message_)[key] = value;
 }
+template void MessageWrapper::Put<bool>(const char *key, bool value);
+template void MessageWrapper::Put<uint8_t>(const char *key, uint8_t value);
 template void MessageWrapper::Put<std::string>(const char *key, std::string value);
 template void MessageWrapper::Put<std::vector<uint8_t>>(const char *key, std::vector<uint8_t> value);
 template void MessageWrapper::Put<MessageWrapper>(const char *key, MessageWrapper value);
@@ -38,6 +43,8 @@ template <typename T>
 T MessageWrapper::Get(const char *key) const {
   return underlying_message_->at(key).get<T>();
 }
+template bool MessageWrapper::Get<bool>(const char *key) const;
+template uint8_t MessageWrapper::Get<uint8_t>(const char *key) const;
 template std::string MessageWrapper::Get<std::string>(const char *key) const;
 template std::vector<uint8_t> MessageWrapper::Get<std::vector<uint8_t>>(const char *key) const;
 template MessageWrapper MessageWrapper::Get<MessageWrapper>(const char *key) const;
@@ -45,6 +52,8 @@ template record_batch_id_t MessageWrapper::Get<record_batch_id_t>(const char *ke
 template msg_id_t MessageWrapper::Get<msg_id_t>(const char *key) const;
 template transaction::timestamp_t MessageWrapper::Get<transaction::timestamp_t>(const char *key) const;
 
+bool MessageWrapper::Contains(const char *key) const { return underlying_message_->contains(key); }
+
 std::string MessageWrapper::Serialize() const {
   const auto msg_pack = common::json::to_msgpack(*underlying_message_);
   return std::string(reinterpret_cast<const char *>(msg_pack.data()), msg_pack.size());
@@ -59,13 +68,36 @@ void MessageWrapper::FromJson(const common::json &j) { *(this->underlying_messag
 MessageWrapper ReplicationMessageMetadata::ToMessageWrapper() const {
   MessageWrapper message;
   message.Put(key_message_id, msg_id_);
+  message.Put(key_requested_format, static_cast<uint8_t>(requested_format_));
   return message;
 }
 
 ReplicationMessageMetadata::ReplicationMessageMetadata(const MessageWrapper &message)
-    : msg_id_(message.Get<msg_id_t>(key_message_id)) {}
+    : msg_id_(message.Get<msg_id_t>(key_message_id)),
+      // Nodes that predate BINARY do not ask for a format, and only read MSGPACK.
+      requested_format_(message.Contains(key_requested_format)
+                            ? ToRequestedFormat(message.Get<uint8_t>(key_requested_format))
+                            : ReplicationMessageFormat::MSGPACK) {}
+
+ReplicationMessageMetadata::ReplicationMessageMetadata(msg_id_t msg_id)
+    : ReplicationMessageMetadata(msg_id, PREFERRED_FORMAT) {}
+
+ReplicationMessageMetadata::ReplicationMessageMetadata(msg_id_t msg_id, ReplicationMessageFormat requested_format)
+    : msg_id_(msg_id), requested_format_(requested_format) {}
+
+ReplicationMessageMetadata::ReplicationMessageMetadata(BinaryMessageReader *reader)
+    : msg_id_(reader->Read<msg_id_t>()), requested_format_(ToRequestedFormat(reader->Read<uint8_t>())) {}
 
-ReplicationMessageMetadata::ReplicationMessageMetadata(msg_id_t msg_id) : msg_id_(msg_id) {}
+void ReplicationMessageMetadata::ToBinary(BinaryMessageWriter *writer) const {
+  writer->Write(msg_id_);
+  writer->Write(static_cast<uint8_t>(requested_format_));
+}
+
+ReplicationMessageFormat ReplicationMessageMetadata::ToRequestedFormat(const uint8_t requested_format) {
+  // A format this node does not know of comes from a newer node, which still reads BINARY.
+  return requested_format == static_cast<uint8_t>(ReplicationMessageFormat::MSGPACK) ? ReplicationMessageFormat::MSGPACK
+                                                                                     : ReplicationMessageFormat::BINARY;
+}
 
 // BaseReplicationMessage
 
@@ -78,7 +110,18 @@ MessageWrapper BaseReplicationMessage::ToMessageWrapper() const {
   return message;
 }
 
-std::string BaseReplicationMessage::Serialize() const { return ToMessageWrapper().Serialize(); }
+void BaseReplicationMessage::ToBinary(BinaryMessageWriter *writer) const { metadata_.ToBinary(writer); }
+
+std::string BaseReplicationMessage::Serialize(ReplicationMessageFormat format) const {
+  if (format == ReplicationMessageFormat::MSGPACK) {
+    return ToMessageWrapper().Serialize();
+  }
+  BinaryMessageWriter writer(BinarySizeHint());
+  writer.Write(BINARY_FORMAT_VERSION);
+  writer.Write(type_);
+  ToBinary(&writer);
+  return writer.Finish();
+}
 
 BaseReplicationMessage::BaseReplicationMessage(const MessageWrapper &message)
     : type_(ReplicationMessageTypeFromString(message.Get<std::string>(key_message_type))),
@@ -87,6 +130,9 @@ BaseReplicationMessage::BaseReplicationMessage(const MessageWrapper &message)
 BaseReplicationMessage::BaseReplicationMessage(ReplicationMessageType type, ReplicationMessageMetadata metadata)
     : type_(type), metadata_(metadata) {}
 
+BaseReplicationMessage::BaseReplicationMessage(ReplicationMessageType type, BinaryMessageReader *reader)
+    : type_(type), metadata_(reader) {}
+
 DEFINE_JSON_BODY_DECLARATIONS(MessageWrapper);
 
 // NotifyOATMsg
@@ -103,6 +149,17 @@ NotifyOATMsg::NotifyOATMsg(const MessageWrapper &message)
       batch_id_(message.Get<record_batch_id_t>(key_batch_id)),
       oldest_active_txn_(message.Get<transaction::timestamp_t>(key_oldest_active_txn)) {}
 
+NotifyOATMsg::NotifyOATMsg(BinaryMessageReader *reader)
+    : BaseReplicationMessage(ReplicationMessageType::NOTIFY_OAT, reader),
+      batch_id_(reader->Read<record_batch_id_t>()),
+      oldest_active_txn_(reader->Read<transaction::timestamp_t>()) {}
+
+void NotifyOATMsg::ToBinary(BinaryMessageWriter *writer) const {
+  BaseReplicationMessage::ToBinary(writer);
+  writer->Write(batch_id_);
+  writer->Write(oldest_active_txn_);
+}
+
 NotifyOATMsg::NotifyOATMsg(ReplicationMessageMetadata metadata, record_batch_id_t batch_id,
                            transaction::timestamp_t oldest_active_txn)
     : BaseReplicationMessage(ReplicationMessageType::NOTIFY_OAT, metadata),
@@ -114,20 +171,49 @@ NotifyOATMsg::NotifyOATMsg(ReplicationMessageMetadata metadata, record_batch_id_
 MessageWrapper RecordsBatchMsg::ToMessageWrapper() const {
   MessageWrapper message = BaseReplicationMessage::ToMessageWrapper();
   message.Put(key_batch_id, batch_id_);
-  message.Put(key_contents, contents_);
+  message.Put(key_contents, std::string(GetContents()));
+  message.Put(key_compressed, IsCompressed());
   return message;
 }
 
 RecordsBatchMsg::RecordsBatchMsg(const MessageWrapper &message)
     : BaseReplicationMessage(message),
       batch_id_(message.Get<record_batch_id_t>(key_batch_id)),
-      contents_(message.Get<std::string>(key_contents)) {}
+      contents_(message.Get<std::string>(key_contents)),
+      // Nodes that predate log compression never compress their batches.
+      compressed_(message.Contains(key_compressed) && message.Get<bool>(key_compressed)),
+      buffer_(nullptr) {}
+
+RecordsBatchMsg::RecordsBatchMsg(BinaryMessageReader *reader)
+    : BaseReplicationMessage(ReplicationMessageType::RECORDS_BATCH, reader),
+      batch_id_(reader->Read<record_batch_id_t>()),
+      compressed_(reader->Read<uint8_t>() != 0),
+      buffer_(nullptr) {
+  contents_ = reader->ReadBytes();
+}
 
 RecordsBatchMsg::RecordsBatchMsg(ReplicationMessageMetadata metadata, record_batch_id_t batch_id,
                                  storage::BufferedLogWriter *buffer)
     : BaseReplicationMessage(ReplicationMessageType::RECORDS_BATCH, metadata),
       batch_id_(batch_id),
-      contents_(std::string(buffer->buffer_, buffer->buffer_size_)) {}
+      compressed_(false),
+      buffer_(buffer) {}
+
+std::string_view RecordsBatchMsg::GetContents() const {
+  return buffer_ != nullptr ? std::string_view(buffer_->buffer_, buffer_->buffer_size_) : std::string_view(contents_);
+}
+
+bool RecordsBatchMsg::IsCompressed() const { return buffer_ != nullptr ? buffer_->IsBlock() : compressed_; }
+
+void RecordsBatchMsg::ToBinary(BinaryMessageWriter *writer) const {
+  BaseReplicationMessage::ToBinary(writer);
+  writer->Write(batch_id_);
+  writer->Write(static_cast<uint8_t>(IsCompressed()));
+  // The log records are copied straight from the buffer into the serialized message.
+  writer->WriteBytes(GetContents());
+}
+
+size_t RecordsBatchMsg::BinarySizeHint() const { return BINARY_HEADER_SIZE_HINT + GetContents().size(); }
 
 // TxnAppliedMsg
 
@@ -140,24 +226,65 @@ MessageWrapper TxnAppliedMsg::ToMessageWrapper() const {
 TxnAppliedMsg::TxnAppliedMsg(const MessageWrapper &message)
     : BaseReplicationMessage(message), applied_txn_id_(message.Get<transaction::timestamp_t>(key_applied_txn_id)) {}
 
+TxnAppliedMsg::TxnAppliedMsg(BinaryMessageReader *reader)
+    : BaseReplicationMessage(ReplicationMessageType::TXN_APPLIED, reader),
+      applied_txn_id_(reader->Read<transaction::timestamp_t>()) {}
+
+void TxnAppliedMsg::ToBinary(BinaryMessageWriter *writer) const {
+  BaseReplicationMessage::ToBinary(writer);
+  writer->Write(applied_txn_id_);
+}
+
 TxnAppliedMsg::TxnAppliedMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t applied_txn_id)
     : BaseReplicationMessage(ReplicationMessageType::TXN_APPLIED, metadata), applied_txn_id_(applied_txn_id) {}
 
 std::unique_ptr<BaseReplicationMessage> BaseReplicationMessage::ParseFromString(std::string_view str) {
-  MessageWrapper message(str);
-  // BaseReplicationMessage switches on the message's key_message_type to figure out what type of message to create.
-  ReplicationMessageType msg_type = ReplicationMessageTypeFromString(message.Get<std::string>(key_message_type));
-  switch (msg_type) {
-    // clang-format off
-    case ReplicationMessageType::NOTIFY_OAT:          { return std::make_unique<NotifyOATMsg>(message); }
-    case ReplicationMessageType::RECORDS_BATCH:       { return std::make_unique<RecordsBatchMsg>(message); }
-    case ReplicationMessageType::TXN_APPLIED:         { return std::make_unique<TxnAppliedMsg>(message); }
-    case ReplicationMessageType::INVALID:             // Fall-through.
-    case ReplicationMessageType::NUM_ENUM_ENTRIES:
-      throw REPLICATION_EXCEPTION("Got an INVALID ReplicationMessage?");
-      // clang-format on
+  if (str.empty()) {
+    throw REPLICATION_EXCEPTION("Got an empty ReplicationMessage?");
+  }
+
+  // A msgpack message starts with a map header, which is never a valid BINARY format version.
+  const auto version = static_cast<uint8_t>(str[0]);
+  if (version != 0 && version <= BINARY_FORMAT_VERSION) {
+    // Every BINARY format version so far shares the same layout.
+    BinaryMessageReader reader(str);
+    reader.Read<uint8_t>();
+    const auto msg_type = reader.Read<ReplicationMessageType>();
+    switch (msg_type) {
+      // clang-format off
+      case ReplicationMessageType::NOTIFY_OAT:          { return std::make_unique<NotifyOATMsg>(&reader); }
+      case ReplicationMessageType::RECORDS_BATCH:       { return std::make_unique<RecordsBatchMsg>(&reader); }
+      case ReplicationMessageType::TXN_APPLIED:         { return std::make_unique<TxnAppliedMsg>(&reader); }
+      case ReplicationMessageType::INVALID:             // Fall-through.
+      case ReplicationMessageType::NUM_ENUM_ENTRIES:
+        break;
+        // clang-format on
+    }
+    throw REPLICATION_EXCEPTION("Got an INVALID ReplicationMessage?");
+  }
+  if (version < 0x80) {
+    throw REPLICATION_EXCEPTION(fmt::format("Unsupported replication message format version {}.", version));
+  }
+
+  // A truncated or garbled msgpack message fails to parse, or lacks some of its keys.
+  try {
+    MessageWrapper message(str);
+    // BaseReplicationMessage switches on the message's key_message_type to figure out what type of message to create.
+    ReplicationMessageType msg_type = ReplicationMessageTypeFromString(message.Get<std::string>(key_message_type));
+    switch (msg_type) {
+      // clang-format off
+      case ReplicationMessageType::NOTIFY_OAT:          { return std::make_unique<NotifyOATMsg>(message); }
+      case ReplicationMessageType::RECORDS_BATCH:       { return std::make_unique<RecordsBatchMsg>(message); }
+      case ReplicationMessageType::TXN_APPLIED:         { return std::make_unique<TxnAppliedMsg>(message); }
+      case ReplicationMessageType::INVALID:             // Fall-through.
+      case ReplicationMessageType::NUM_ENUM_ENTRIES:
+        break;
+        // clang-format on
+    }
+  } catch (const common::json::exception &e) {
+    throw REPLICATION_EXCEPTION(fmt::format("Malformed replication message: {}", e.what()));
   }
-  throw REPLICATION_EXCEPTION("This case is impossible but GCC can't figure it out.");
+  throw REPLICATION_EXCEPTION("Got an INVALID ReplicationMessage?");
 }
 
 }  // namespace noisepage::replication
@@ -8,6 +8,7 @@
 #include "execution/compiler/operator/hash_aggregation_translator.h"
 #include "execution/compiler/operator/hash_join_translator.h"
 #include "execution/compiler/operator/index_create_translator.h"
+#include "execution/compiler/operator/merge_join_translator.h"
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/operator/sort_translator.h"
 #include "execution/compiler/operator/static_aggregation_translator.h"
@@ -44,6 +45,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/plan_meta_data.h"
@@ -640,6 +642,23 @@ void OperatingUnitRecorder::Visit(const planner::NestedLoopJoinPlanNode *plan) {
   RecordArithmeticFeatures(c_plan, outer_num);
 }
 
+void OperatingUnitRecorder::Visit(const planner::MergeJoinPlanNode *plan) {
+  auto translator = current_translator_.CastManagedPointerTo<execution::compiler::MergeJoinTranslator>();
+
+  // The merge is performed by the right pipeline, which drives the join output.
+  if (translator->IsRightPipeline(*current_pipeline_)) {
+    for (auto key : plan->GetRightMergeKeys()) {
+      auto features = OperatingUnitUtil::ExtractFeaturesFromExpression(key);
+      arithmetic_feature_types_.insert(arithmetic_feature_types_.end(), std::make_move_iterator(features.begin()),
+                                       std::make_move_iterator(features.end()));
+    }
+    RecordArithmeticFeatures(plan->GetChild(1), 1);
+
+    VisitAbstractJoinPlanNode(plan);
+    RecordArithmeticFeatures(plan, 1);
+  }
+}
+
 void OperatingUnitRecorder::Visit(const planner::IndexJoinPlanNode *plan) {
   // Scale by num_rows - 1 of the child
   UNUSED_ATTRIBUTE auto *c_plan = plan->GetChild(0);
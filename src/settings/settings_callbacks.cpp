@@ -4,6 +4,7 @@
 
 #include "loggers/loggers_util.h"
 #include "main/db_main.h"
+#include "optimizer/cost_model/cost_model_util.h"
 
 namespace noisepage::settings {
 
@@ -186,6 +187,26 @@ void Callbacks::MetricsQueryTraceOutput(void *const old_value, void *const new_v
   action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::OptimizerCostModel(void *const old_value, void *const new_value, DBMain *const db_main,
+                                   common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  auto cost_model = optimizer::CostModelUtil::FromCostModelString(*static_cast<std::string_view *>(new_value));
+  if (cost_model == std::nullopt) {
+    action_context->SetState(common::ActionState::FAILURE);
+    return;
+  }
+  db_main->GetTrafficCop()->SetCostModel(*cost_model);
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
+void Callbacks::OptimizerJoinEnumerationThreshold(void *const old_value, void *const new_value, DBMain *const db_main,
+                                                  common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  int threshold = *static_cast<int *>(new_value);
+  db_main->GetTrafficCop()->SetJoinEnumerationThreshold(static_cast<uint32_t>(threshold));
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::CompiledQueryExecution(void *const old_value, void *const new_value, DBMain *const db_main,
                                        common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
@@ -1,6 +1,7 @@
 #include "storage/block_compactor.h"
 
 #include <algorithm>
+#include <limits>
 #include <queue>
 #include <unordered_map>
 #include <utility>
@@ -245,9 +246,21 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
     common::RawConcurrentBitmap *column_bitmap = accessor.ColumnNullBitmap(block, col_id);
     if (!layout.IsVarlen(col_id)) {
       metadata.NullCount(col_id) = 0;
-      // Only need to count null for non-varlens
-      for (uint32_t i = 0; i < metadata.NumRecords(); i++)
-        if (!column_bitmap->Test(i)) metadata.NullCount(col_id)++;
+      // Only need to count null for non-varlens, and make the zone map exact while at it. Writers have been shut out
+      // by the block state, and no version is left that holds a value outside of the block.
+      int64_t min = std::numeric_limits<int64_t>::max(), max = std::numeric_limits<int64_t>::min();
+      const byte *values = accessor.ColumnStart(block, col_id);
+      const uint16_t size = layout.AttrSize(col_id);
+      for (uint32_t i = 0; i < metadata.NumRecords(); i++) {
+        if (!column_bitmap->Test(i)) {
+          metadata.NullCount(col_id)++;
+          continue;
+        }
+        const int64_t value = ZoneMap::ReadValue(values + size * i, size);
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+      accessor.GetZoneMap(block, col_id).Set(min, max, metadata.NullCount(col_id));
       continue;
     }
 
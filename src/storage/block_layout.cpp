@@ -7,6 +7,7 @@
 #include "common/container/bitmap.h"
 #include "storage/arrow_block_metadata.h"
 #include "storage/storage_util.h"
+#include "storage/zone_map.h"
 
 namespace noisepage::storage {
 BlockLayout::BlockLayout(std::vector<uint16_t> attr_sizes)
@@ -38,8 +39,10 @@ uint32_t BlockLayout::ComputeStaticHeaderSize() const {
   auto unpadded_size = static_cast<uint32_t>(
       sizeof(uintptr_t) + sizeof(uint16_t) + sizeof(layout_version_t) +  // datatable pointer, padding, layout_version
       sizeof(uint32_t)                                                   // insert_head
-      + sizeof(BlockAccessController) + ArrowBlockMetadata::Size(NumColumns())  // access controller and metadata
-      + NumColumns() * sizeof(uint32_t));                                       // attr_offsets
+      + sizeof(BlockAccessController) + sizeof(BlockVisibility)          // access controller and visibility
+      + ArrowBlockMetadata::Size(NumColumns())                           // metadata
+      + StorageUtil::PadUpToSize(sizeof(uint64_t), NumColumns() * sizeof(uint32_t))  // padded attr_offsets
+      + NumColumns() * sizeof(ZoneMap));                                               // zone maps
   return StorageUtil::PadUpToSize(sizeof(uint64_t), unpadded_size);
 }
 
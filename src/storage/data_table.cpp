@@ -102,6 +102,9 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     // Update the next pointer of the new head of the version chain
     undo->Next() = version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
+  // The block has a version in flight now, which index-only scans need to know before the tuple or an index changes
+  if (version_ptr == nullptr) slot.GetBlock()->visibility_.AddVersionChain();
+  slot.GetBlock()->visibility_.Clear();
 
   // Update in place with the new value.
   for (uint16_t i = 0; i < redo.NumColumns(); i++) {
@@ -110,6 +113,8 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     // TODO(Matt): It would be nice to check that a ProjectedRow that modifies the logical delete column only originated
     // from the DataTable calling Update() within Delete(), rather than an outside soure modifying this column, but
     // that's difficult with this implementation
+    // Widen the zone map first, so that it covers the new value by the time anyone could see it
+    accessor_.WidenZoneMap(slot.GetBlock(), redo.ColumnIds()[i], redo.AccessWithNullCheck(i));
     StorageUtil::CopyAttrFromProjection(accessor_, slot, redo, i);
   }
 
@@ -187,13 +192,18 @@ void DataTable::InsertInto(const common::ManagedPointer<transaction::Transaction
   UndoRecord *undo = txn->UndoRecordForInsert(this, dest);
   NOISEPAGE_ASSERT(dest.GetBlock()->controller_.GetBlockState()->load() == BlockState::HOT,
                    "Should only be able to insert into hot blocks");
+  // A reclaimed slot can still hold the chain of an aborted insert that the GC has not truncated yet
+  const bool new_chain = AtomicallyReadVersionPtr(dest, accessor_) == nullptr;
   AtomicallyWriteVersionPtr(dest, accessor_, undo);
+  if (new_chain) dest.GetBlock()->visibility_.AddVersionChain();
+  dest.GetBlock()->visibility_.Clear();
   // Set the logically deleted bit to present as the undo record is ready
   accessor_.AccessForceNotNull(dest, VERSION_POINTER_COLUMN_ID);
   // Update in place with the new value.
   for (uint16_t i = 0; i < redo.NumColumns(); i++) {
     NOISEPAGE_ASSERT(redo.ColumnIds()[i] != VERSION_POINTER_COLUMN_ID,
                      "Insert buffer should not change the version pointer column.");
+    accessor_.WidenZoneMap(dest.GetBlock(), redo.ColumnIds()[i], redo.AccessWithNullCheck(i));
     StorageUtil::CopyAttrFromProjection(accessor_, dest, redo, i);
   }
 }
@@ -216,6 +226,8 @@ bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionCont
     // Update the next pointer of the new head of the version chain
     undo->Next() = version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
+  if (version_ptr == nullptr) slot.GetBlock()->visibility_.AddVersionChain();
+  slot.GetBlock()->visibility_.Clear();
 
   // We have the write lock. Go ahead and flip the logically deleted bit to true
   accessor_.SetNull(slot, VERSION_POINTER_COLUMN_ID);
@@ -1,7 +1,9 @@
 #include "storage/garbage_collector.h"
 
+#include <memory>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/macros.h"
 #include "common/thread_context.h"
@@ -18,17 +20,28 @@
 
 namespace noisepage::storage {
 
+namespace {
+// Version chains are split into more partitions than there are workers, so that a few hot partitions do not hold up
+// the whole pass
+constexpr uint32_t PARTITIONS_PER_WORKER = 4;
+}  // namespace
+
 GarbageCollector::GarbageCollector(
     const common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
     const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer)
+    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+    const uint32_t num_workers)
     : timestamp_manager_(timestamp_manager),
       deferred_action_manager_(deferred_action_manager),
       txn_manager_(txn_manager),
       observer_(observer),
-      last_unlinked_{0} {
+      last_unlinked_{0},
+      num_workers_(num_workers) {
   NOISEPAGE_ASSERT(txn_manager_->GCEnabled(),
                    "The TransactionManager needs to be instantiated with gc_enabled true for GC to work!");
+  NOISEPAGE_ASSERT(num_workers_ > 0, "The GC needs at least one worker.");
+  // The thread that invokes the GC joins the arena, so it only needs to reserve the other workers
+  if (num_workers_ > 1) workers_ = std::make_unique<tbb::task_arena>(static_cast<int>(num_workers_), 1);
 }
 
 std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
@@ -54,13 +67,15 @@ std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
   ProcessDeferredActions(oldest_txn);
   ProcessIndexes();
 
-  if ((txns_deallocated > 0 || txns_unlinked > 0) && gc_metrics_enabled) {
+  // A backlog is worth recording even if nothing could be collected, since that is when the GC falls behind
+  if ((txns_deallocated > 0 || txns_unlinked > 0 || unlink_backlog_ > 0) && gc_metrics_enabled) {
     if (common::thread_context.resource_tracker_.IsRunning()) {
       // Stop the resource tracker for this operating unit
       common::thread_context.resource_tracker_.Stop();
       auto &resource_metrics = common::thread_context.resource_tracker_.GetMetrics();
       common::thread_context.metrics_store_->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked,
-                                                          readonly_unlinked, gc_interval_, resource_metrics);
+                                                          readonly_unlinked, gc_interval_, unlink_backlog_,
+                                                          deallocate_backlog_, num_workers_, resource_metrics);
     }
     common::thread_context.resource_tracker_.Start();
   }
@@ -80,6 +95,7 @@ uint32_t GarbageCollector::ProcessDeallocateQueue(transaction::timestamp_t oldes
       txns_processed++;
     }
     txns_to_deallocate_.clear();
+    deallocate_backlog_ = 0;
   }
 
   return txns_processed;
@@ -98,10 +114,14 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
   uint32_t txns_processed = 0, buffer_processed = 0, readonly_processed = 0;
   // Certain transactions might not be yet safe to gc. Need to requeue them
   transaction::TransactionQueue requeue;
+  uint32_t requeued = 0;
+  // Transactions that are safe to gc, their UndoRecords are reclaimed once the version chains are truncated
+  transaction::TransactionQueue unlinked;
   // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
-  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
-  // wasteful traversals of the version chain.
-  std::unordered_set<TupleSlot> visited_slots;
+  // timestamp once, and the version chain is sorted by timestamp. The tuples to truncate are partitioned by slot, so
+  // each version chain lands in a single partition, which keeps a set of slots to avoid wasteful traversals.
+  std::vector<std::vector<std::pair<DataTable *, TupleSlot>>> partitions(
+      num_workers_ == 1 ? 1 : num_workers_ * PARTITIONS_PER_WORKER);
 
   // Process every transaction in the unlink queue
   while (!txns_to_unlink_.empty()) {
@@ -117,34 +137,59 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
       // Safe to garbage collect.
       for (auto &undo_record : txn->undo_buffer_) {
         // It is possible for the table field to be null, for aborted transaction's last conflicting record
-        DataTable *&table = undo_record.Table();
-        // Each version chain needs to be traversed and truncated at most once every GC period. Check
-        // if we have already visited this tuple slot; if not, proceed to prune the version chain.
-        if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
-          TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
-        // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
-        // unless the transaction is aborted, and the record holds a version that is still visible.
-        if (!txn->Aborted()) {
-          ReclaimBufferIfVarlen(txn, &undo_record);
-          ReclaimSlotIfDeleted(&undo_record);
+        DataTable *const table = undo_record.Table();
+        if (table != nullptr) {
+          const TupleSlot slot = undo_record.Slot();
+          partitions[std::hash<TupleSlot>()(slot) % partitions.size()].emplace_back(table, slot);
         }
-        if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
-        buffer_processed++;
       }
-      txns_to_deallocate_.push_front(txn);
-      txns_processed++;
+      unlinked.push_front(txn);
     } else {
       // This is a committed txn that is still visible, requeue for next GC run
       requeue.push_front(txn);
+      requeued++;
+    }
+  }
+
+  TruncateVersionChains(partitions, oldest_txn);
+
+  for (auto *const unlinked_txn : unlinked) {
+    for (auto &undo_record : unlinked_txn->undo_buffer_) {
+      // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
+      // unless the transaction is aborted, and the record holds a version that is still visible.
+      if (!unlinked_txn->Aborted()) {
+        ReclaimBufferIfVarlen(unlinked_txn, &undo_record);
+        ReclaimSlotIfDeleted(&undo_record);
+      }
+      if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
+      buffer_processed++;
     }
+    txns_processed++;
+    deallocate_backlog_++;
   }
+  MarkBlocksAllVisible(partitions);
+  txns_to_deallocate_.splice_after(txns_to_deallocate_.cbefore_begin(), std::move(unlinked));
 
   // Requeue any txns that we were still visible to running transactions
   txns_to_unlink_ = transaction::TransactionQueue(std::move(requeue));
+  unlink_backlog_ = requeued;
 
   return std::make_tuple(txns_processed, buffer_processed, readonly_processed);
 }
 
+void GarbageCollector::TruncateVersionChains(
+    const std::vector<std::vector<std::pair<DataTable *, TupleSlot>>> &partitions,
+    const transaction::timestamp_t oldest) {
+  ForEachOnWorkers(partitions.size(), [&](const std::size_t i) {
+    std::unordered_set<TupleSlot> visited_slots;
+    for (const auto &[table, slot] : partitions[i]) {
+      // Each version chain needs to be traversed and truncated at most once every GC period. Check
+      // if we have already visited this tuple slot; if not, proceed to prune the version chain.
+      if (visited_slots.insert(slot).second) TruncateVersionChain(table, slot, oldest);
+    }
+  });
+}
+
 void GarbageCollector::ProcessDeferredActions(transaction::timestamp_t oldest_txn) {
   if (deferred_action_manager_ != DISABLED) {
     // TODO(Tianyu): Eventually we will remove the GC and implement version chain pruning with deferred actions
@@ -168,11 +213,13 @@ void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleS
       // Keep retrying while there are conflicts, since we only invoke truncate once per GC period for every
       // version chain.
       TruncateVersionChain(table, slot, oldest);
+    else
+      slot.GetBlock()->visibility_.RemoveVersionChain();
     return;
   }
 
-  // a version chain is guaranteed to not change when not at the head (assuming single-threaded GC), so we are safe
-  // to traverse and update pointers without CAS
+  // a version chain is guaranteed to not change when not at the head (only one GC worker truncates a given chain), so
+  // we are safe to traverse and update pointers without CAS
   UndoRecord *curr = version_ptr;
   UndoRecord *next;
   // Traverse until we find the earliest UndoRecord that can be unlinked.
@@ -194,6 +241,30 @@ void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleS
     TruncateVersionChain(table, slot, oldest);
 }
 
+void GarbageCollector::MarkBlocksAllVisible(
+    const std::vector<std::vector<std::pair<DataTable *, TupleSlot>>> &partitions) {
+  // Without deferred actions, the mark could not wait for the index deletes of the unlinked versions
+  if (deferred_action_manager_ == DISABLED) return;
+
+  std::unordered_set<RawBlock *> touched_blocks;
+  for (const auto &partition : partitions) {
+    for (const auto &entry : partition) touched_blocks.emplace(entry.second.GetBlock());
+  }
+
+  for (RawBlock *const block : touched_blocks) {
+    uint64_t mark;
+    if (!block->visibility_.BeginMark(&mark)) continue;
+    // The mark begins before the chain count is read, so a writer that adds a chain the check misses is guaranteed
+    // to see the mark and clear it
+    if (block->visibility_.HasVersionChains()) {
+      block->visibility_.CancelMark(mark);
+      continue;
+    }
+    // The block outlives the action, since tables are only deleted by deferred actions registered after this one
+    deferred_action_manager_->RegisterDeferredAction([block, mark]() { block->visibility_.FinishMark(mark); });
+  }
+}
+
 void GarbageCollector::ReclaimSlotIfDeleted(UndoRecord *const undo_record) const {
   if (undo_record->Type() == DeltaRecordType::DELETE) undo_record->Table()->accessor_.Deallocate(undo_record->Slot());
 }
@@ -247,7 +318,12 @@ void GarbageCollector::UnregisterIndexForGC(const common::ManagedPointer<index::
 
 void GarbageCollector::ProcessIndexes() {
   common::SharedLatch::ScopedSharedLatch guard(&indexes_latch_);
-  for (const auto &index : indexes_) index->PerformGarbageCollection();
+  if (workers_ == nullptr) {
+    for (const auto &index : indexes_) index->PerformGarbageCollection();
+    return;
+  }
+  const std::vector<common::ManagedPointer<index::Index>> indexes(indexes_.cbegin(), indexes_.cend());
+  ForEachOnWorkers(indexes.size(), [&](const std::size_t i) { indexes[i]->PerformGarbageCollection(); });
 }
 
 }  // namespace noisepage::storage
@@ -32,6 +32,16 @@ int BPlusTreeIndex<KeyType>::GetInnerNodeSizeLowerThreshold() const {
   return bplustree_->GetInnerNodeSizeLowerThreshold();
 }
 
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::SetBulkLoadFillFactor(int fill_factor) {
+  bplustree_->SetBulkLoadFillFactor(fill_factor);
+}
+
+template <typename KeyType>
+int BPlusTreeIndex<KeyType>::GetBulkLoadFillFactor() const {
+  return bplustree_->GetBulkLoadFillFactor();
+}
+
 template <typename KeyType>
 size_t BPlusTreeIndex<KeyType>::EstimateHeapUsage() const {
   return bplustree_->EstimateHeapUsage();
@@ -95,6 +105,39 @@ bool BPlusTreeIndex<KeyType>::InsertUnique(common::ManagedPointer<transaction::T
   return result;
 }
 
+template <typename KeyType>
+int32_t BPlusTreeIndex<KeyType>::CompareBulkLoadEntries(const void *lhs, const void *rhs) {
+  const auto &lhs_key = reinterpret_cast<const BulkLoadEntry *>(lhs)->first;
+  const auto &rhs_key = reinterpret_cast<const BulkLoadEntry *>(rhs)->first;
+  const std::less<KeyType> less;
+  if (less(lhs_key, rhs_key)) return -1;
+  return less(rhs_key, lhs_key) ? 1 : 0;
+}
+
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::SetBulkLoadEntry(const ProjectedRow &tuple, TupleSlot location, byte *entry) const {
+  auto *bulk_load_entry = new (entry) BulkLoadEntry;
+  bulk_load_entry->first.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+  bulk_load_entry->second = location;
+}
+
+template <typename KeyType>
+bool BPlusTreeIndex<KeyType>::BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                                       const std::function<const byte *()> &next_entry) {
+  NOISEPAGE_ASSERT(bplustree_->GetSize() == 0, "Bulk loading requires an empty index.");
+  auto next_element = [&next_entry]() { return reinterpret_cast<const BulkLoadEntry *>(next_entry()); };
+
+  if (!bplustree_->BulkLoad(next_element, metadata_.GetSchema().Unique())) {
+    // The index found a constraint violation, see InsertUnique()
+    txn->SetMustAbort();
+    return false;
+  }
+
+  // Register an abort action with the txn context in case of rollback
+  txn->RegisterAbortAction([=]() { bplustree_->Clear(); });
+  return true;
+}
+
 template <typename KeyType>
 void BPlusTreeIndex<KeyType>::Delete(common::ManagedPointer<transaction::TransactionContext> txn,
                                      const ProjectedRow &tuple, TupleSlot location) {
@@ -141,10 +184,60 @@ void BPlusTreeIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn
                    "Invalid number of results for unique index.");
 }
 
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::ScanKeyBatch(const transaction::TransactionContext &txn,
+                                           const std::vector<const ProjectedRow *> &keys,
+                                           std::vector<std::vector<TupleSlot>> *value_lists) {
+  value_lists->clear();
+  value_lists->resize(keys.size());
+
+  // Build all search keys first, so that the tree can visit them in key order
+  std::vector<KeyType> index_keys(keys.size());
+  for (uint32_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromProjectedRow(*keys[i], metadata_, metadata_.GetSchema().GetColumns().size());
+  }
+
+  bplustree_->FindValuesOfKeys(index_keys, [value_lists, &txn](const uint32_t key_idx, const TupleSlot location) {
+    if (IsVisible(txn, location)) (*value_lists)[key_idx].emplace_back(location);
+  });
+
+  NOISEPAGE_ASSERT(!(metadata_.GetSchema().Unique()) ||
+                       std::all_of(value_lists->cbegin(), value_lists->cend(),
+                                   [](const std::vector<TupleSlot> &value_list) { return value_list.size() <= 1; }),
+                   "Invalid number of results for unique index.");
+}
+
 template <typename KeyType>
 void BPlusTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type,
                                             uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
                                             uint32_t limit, std::vector<TupleSlot> *value_list) {
+  ScanAscendingInternal(txn, scan_type, num_attrs, low_key, high_key, limit, value_list, nullptr);
+}
+
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::ScanAscendingWithKeys(const transaction::TransactionContext &txn, ScanType scan_type,
+                                                    uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
+                                                    uint32_t limit, std::vector<TupleSlot> *value_list,
+                                                    std::vector<uint64_t> *key_list) {
+  NOISEPAGE_ASSERT(SupportsKeyScans(), "Keys with inlined varlens cannot be copied out.");
+  std::vector<KeyType> keys;
+  ScanAscendingInternal(txn, scan_type, num_attrs, low_key, high_key, limit, value_list, &keys);
+
+  // Lay the keys out as ProjectedRows, so that they can be read like the tuples they were built from
+  const auto &initializer = GetProjectedRowInitializer();
+  const uint32_t key_words = KeyScanWords();
+  key_list->clear();
+  key_list->resize(keys.size() * key_words);
+  for (uint32_t i = 0; i < keys.size(); i++) {
+    keys[i].CopyToProjectedRow(initializer.InitializeRow(key_list->data() + i * key_words), metadata_);
+  }
+}
+
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::ScanAscendingInternal(const transaction::TransactionContext &txn, ScanType scan_type,
+                                                    uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
+                                                    uint32_t limit, std::vector<TupleSlot> *value_list,
+                                                    std::vector<KeyType> *key_list) {
   NOISEPAGE_ASSERT(value_list->empty(), "Result set should begin empty.");
   NOISEPAGE_ASSERT(scan_type == ScanType::Closed || scan_type == ScanType::OpenLow || scan_type == ScanType::OpenHigh ||
                        scan_type == ScanType::OpenBoth,
@@ -165,8 +258,9 @@ void BPlusTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContex
 
   while (!scan_completed) {
     value_list->clear();
+    if (key_list != nullptr) key_list->clear();
     scan_completed = bplustree_->ScanAscending(index_low_key, index_high_key, low_key_exists, num_attrs,
-                                               high_key_exists, limit, value_list, &metadata_, predicate);
+                                               high_key_exists, limit, value_list, &metadata_, predicate, key_list);
   }
 }
 
@@ -224,6 +224,12 @@ void IndexBuilder::ApplyIndexOptions(Index *index) const {
       auto cve = reinterpret_cast<parser::ConstantValueExpression *>(expr);
       reinterpret_cast<BPlusTreeIndex<Key> *>(index)->SetInnerNodeSizeLowerThreshold(cve->Peek<int32_t>());
     }
+
+    if (options.find(catalog::IndexOptions::Knob::BPLUSTREE_FILL_FACTOR) != options.end()) {
+      auto expr = options.find(catalog::IndexOptions::Knob::BPLUSTREE_FILL_FACTOR)->second.get();
+      auto cve = reinterpret_cast<parser::ConstantValueExpression *>(expr);
+      reinterpret_cast<BPlusTreeIndex<Key> *>(index)->SetBulkLoadFillFactor(cve->Peek<int32_t>());
+    }
   }
 }
 
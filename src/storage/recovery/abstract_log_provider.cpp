@@ -13,9 +13,14 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
   std::vector<byte *> varlen_contents;
   // Read in LogRecord header data
   auto size = ReadValue<uint32_t>();
-  byte *buf = common::AllocationUtil::AllocateAligned(size);
   auto record_type = ReadValue<storage::LogRecordType>();
   auto txn_begin = ReadValue<transaction::timestamp_t>();
+  if (record_type == storage::LogRecordType::WATERMARK) {
+    // A watermark has no record to hand out, so nothing is allocated for it
+    ReadWatermark(ReadValue<transaction::timestamp_t>());
+    return {nullptr, varlen_contents};
+  }
+  byte *buf = common::AllocationUtil::AllocateAligned(size);
 
   switch (record_type) {
     case (storage::LogRecordType::COMMIT): {
@@ -0,0 +1,364 @@
+#include "storage/recovery/checkpoint_manager.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/database_catalog.h"
+#include "catalog/postgres/pg_class.h"
+#include "catalog/postgres/pg_database.h"
+#include "loggers/storage_logger.h"
+#include "storage/recovery/disk_log_provider.h"
+#include "storage/sql_table.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/log_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+// Write the given bytes to the checkpoint file, flushing the writer's buffer whenever it fills up.
+void WriteBytes(BufferedLogWriter *out, const void *data, uint32_t size) {
+  const auto *bytes = reinterpret_cast<const byte *>(data);
+  uint32_t written = 0;
+  while (written < size) {
+    if (out->IsBufferFull()) out->FlushBuffer();
+    written += out->BufferWrite(bytes + written, size - written);
+  }
+}
+
+template <class T>
+void WriteValue(BufferedLogWriter *out, const T &val) {
+  WriteBytes(out, &val, sizeof(T));
+}
+
+}  // namespace
+
+transaction::timestamp_t CheckpointManager::TakeCheckpoint(const std::string &checkpoint_file_path) {
+  // The snapshot transaction is read-only, so concurrent writers are never blocked. Every row it sees was written by a
+  // transaction that committed before its start time, which becomes the checkpoint timestamp.
+  auto *txn = txn_manager_->BeginTransaction();
+  const auto checkpoint_ts = txn->StartTime();
+
+  // BufferedLogWriter appends, so start from an empty temporary file and only replace the old checkpoint at the end.
+  const std::string tmp_file_path = checkpoint_file_path + ".tmp";
+  unlink(tmp_file_path.c_str());
+  std::unique_ptr<BufferedLogWriter> out;
+  uint64_t num_tables = 0;
+  try {
+    out = std::make_unique<BufferedLogWriter>(tmp_file_path.c_str());
+
+    WriteValue(out.get(), CHECKPOINT_MAGIC);
+    WriteValue(out.get(), CHECKPOINT_FORMAT_VERSION);
+    WriteValue(out.get(), checkpoint_ts);
+
+    for (const auto &database : GetDatabases(common::ManagedPointer(txn))) {
+      const auto dbc = common::ManagedPointer(database.second);
+      for (const auto &table : GetUserTables(common::ManagedPointer(txn), dbc)) {
+        CheckpointTable(common::ManagedPointer(txn), database.first, table.first, dbc,
+                        common::ManagedPointer(table.second), out.get());
+        num_tables++;
+      }
+    }
+    WriteValue(out.get(), CheckpointMarker::END);
+
+    out->FlushBuffer();
+    out->Persist();
+    out->Close();
+    out = nullptr;
+  } catch (...) {
+    // Leave the previous checkpoint as it is, and nothing of this one behind
+    if (out != nullptr) out->Close();
+    unlink(tmp_file_path.c_str());
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    throw;
+  }
+
+  // The snapshot transaction was read-only and we do not need any side-effects
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Recovery still needs the catalog changes of the checkpointed transactions from the log, so make sure their commit
+  // records are on disk before the checkpoint is published.
+  if (log_manager_ != DISABLED) log_manager_->ForceFlush();
+
+  if (std::rename(tmp_file_path.c_str(), checkpoint_file_path.c_str()) != 0) {
+    const auto rename_errno = errno;
+    unlink(tmp_file_path.c_str());
+    throw std::runtime_error("Failed to publish checkpoint " + checkpoint_file_path + " with errno " +
+                             std::to_string(rename_errno));
+  }
+  last_checkpoint_ts_.store(checkpoint_ts);
+  STORAGE_LOG_INFO("Checkpointed {} tables at timestamp {}", num_tables, checkpoint_ts.UnderlyingValue());
+  return checkpoint_ts;
+}
+
+void CheckpointManager::StartCheckpointThread(const std::string &checkpoint_file_path,
+                                              const std::chrono::seconds checkpoint_period) {
+  NOISEPAGE_ASSERT(!run_checkpoints_, "Checkpoint thread should not already be running.");
+  checkpoint_file_path_ = checkpoint_file_path;
+  checkpoint_period_ = checkpoint_period;
+  run_checkpoints_ = true;
+  checkpoint_thread_ = std::thread([this] { CheckpointThreadLoop(); });
+}
+
+void CheckpointManager::StopCheckpointThread() {
+  NOISEPAGE_ASSERT(run_checkpoints_, "Checkpoint thread should already be running.");
+  run_checkpoints_ = false;
+  checkpoint_thread_.join();
+}
+
+void CheckpointManager::CheckpointThreadLoop() {
+  // Sleep in short steps so that stopping the thread does not have to wait for a whole checkpoint period
+  const auto step = std::chrono::milliseconds(100);
+  auto next_checkpoint = std::chrono::steady_clock::now() + checkpoint_period_;
+  while (run_checkpoints_) {
+    std::this_thread::sleep_for(step);
+    if (std::chrono::steady_clock::now() < next_checkpoint) continue;
+    // A failed checkpoint leaves the previous one in place, so it is retried in the next period
+    try {
+      const auto checkpoint_ts = TakeCheckpoint(checkpoint_file_path_);
+      if (log_manager_ != DISABLED) TruncateLog(checkpoint_ts);
+    } catch (const std::exception &e) {
+      STORAGE_LOG_ERROR("Checkpoint failed: {}", e.what());
+    }
+    next_checkpoint = std::chrono::steady_clock::now() + checkpoint_period_;
+  }
+}
+
+uint64_t CheckpointManager::TruncateLog(const transaction::timestamp_t checkpoint_ts) {
+  NOISEPAGE_ASSERT(log_manager_ != DISABLED, "Truncating the log requires logging to be enabled.");
+  // Seal the log files, so that the records of every transaction the checkpoint covers are in segments
+  log_manager_->RotateLogFile();
+  uint64_t num_deleted = 0;
+  for (uint32_t partition = 0; partition < log_manager_->GetNumPartitions(); partition++) {
+    num_deleted += TruncateLogPartition(LogPartitionFilePath(log_manager_->GetLogFilePath(), partition), checkpoint_ts);
+  }
+  if (num_deleted > 0) {
+    STORAGE_LOG_INFO("Deleted {} log segments covered by the checkpoint at timestamp {}", num_deleted,
+                     checkpoint_ts.UnderlyingValue());
+  }
+  return num_deleted;
+}
+
+uint64_t CheckpointManager::TruncateLogPartition(const std::string &log_file_path,
+                                                 const transaction::timestamp_t checkpoint_ts) {
+  // What the segments tell about a transaction
+  struct SegmentedTxn {
+    std::vector<uint64_t> segments_;  // Segments with records of the transaction, in order
+    bool finished_ = false;           // Whether its commit or abort record is in a segment
+    bool aborted_ = false;            // Whether it aborted
+    bool covered_ = false;            // Whether it committed before the checkpoint timestamp
+    bool changed_catalog_ = false;    // Whether it has records of catalog tables, which are not checkpointed
+  };
+  std::unordered_map<transaction::timestamp_t, SegmentedTxn> txns;
+
+  const auto segments = LogSegments(log_file_path);
+  for (const auto segment : segments) {
+    DiskLogProvider provider(LogSegmentFilePath(log_file_path, segment));
+    while (true) {
+      const auto record_and_varlens = provider.GetNextRecord();
+      LogRecord *const record = record_and_varlens.first;
+      if (record == nullptr) break;
+
+      auto &txn = txns[record->TxnBegin()];
+      if (txn.segments_.empty() || txn.segments_.back() != segment) txn.segments_.emplace_back(segment);
+      switch (record->RecordType()) {
+        case LogRecordType::COMMIT:
+          txn.finished_ = true;
+          txn.covered_ = record->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime() < checkpoint_ts;
+          break;
+        case LogRecordType::ABORT:
+          txn.finished_ = true;
+          txn.aborted_ = true;
+          break;
+        default: {
+          const auto table_oid = record->RecordType() == LogRecordType::REDO
+                                     ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid()
+                                     : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+          // All catalog tables have OIDs less than START_OID
+          if (table_oid.UnderlyingValue() < catalog::START_OID) txn.changed_catalog_ = true;
+        }
+      }
+
+      delete[] reinterpret_cast<byte *>(record);
+      for (auto *varlen : record_and_varlens.second) delete[] varlen;
+    }
+  }
+
+  // Keep the segments of every transaction recovery still replays. Catalog changes are replayed from the very start of
+  // the log, even for transactions the checkpoint covers.
+  std::unordered_set<uint64_t> kept;
+  for (const auto &txn : txns) {
+    const auto &info = txn.second;
+    if (!info.finished_ || (!info.aborted_ && (!info.covered_ || info.changed_catalog_))) {
+      kept.insert(info.segments_.cbegin(), info.segments_.cend());
+    }
+  }
+  // The records of a transaction are deleted all at once or not at all, so that no commit record is left without the
+  // records before it, and no records are left without their commit record to be truncated in the future
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (const auto &txn : txns) {
+      const auto &txn_segments = txn.second.segments_;
+      const auto is_kept = [&](const uint64_t segment) { return kept.count(segment) > 0; };
+      if (std::any_of(txn_segments.cbegin(), txn_segments.cend(), is_kept) &&
+          !std::all_of(txn_segments.cbegin(), txn_segments.cend(), is_kept)) {
+        kept.insert(txn_segments.cbegin(), txn_segments.cend());
+        changed = true;
+      }
+    }
+  }
+
+  uint64_t num_deleted = 0;
+  for (const auto segment : segments) {
+    if (kept.count(segment) > 0) continue;
+    const std::string segment_path = LogSegmentFilePath(log_file_path, segment);
+    if (unlink(segment_path.c_str()) != 0) {
+      STORAGE_LOG_ERROR("Failed to delete log segment {} with errno {}", segment_path, errno);
+      continue;
+    }
+    num_deleted++;
+  }
+  return num_deleted;
+}
+
+std::vector<std::pair<catalog::db_oid_t, catalog::DatabaseCatalog *>> CheckpointManager::GetDatabases(
+    const common::ManagedPointer<transaction::TransactionContext> txn) {
+  const auto databases = common::ManagedPointer(catalog_->databases_);
+  const std::vector<catalog::col_oid_t> cols{catalog::postgres::PgDatabase::DATOID.oid_,
+                                             catalog::postgres::PgDatabase::DAT_CATALOG.oid_};
+  const auto pci = databases->InitializerForProjectedColumns(cols, CHECKPOINT_BATCH_SIZE);
+  auto pm = databases->ProjectionMapForOids(cols);
+
+  byte *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+  auto pc = pci.Initialize(buffer);
+  auto db_oids = reinterpret_cast<catalog::db_oid_t *>(pc->ColumnStart(pm[catalog::postgres::PgDatabase::DATOID.oid_]));
+  auto db_cats = reinterpret_cast<catalog::DatabaseCatalog **>(
+      pc->ColumnStart(pm[catalog::postgres::PgDatabase::DAT_CATALOG.oid_]));
+
+  std::vector<std::pair<catalog::db_oid_t, catalog::DatabaseCatalog *>> result;
+  auto table_iter = databases->begin();
+  while (table_iter != databases->end()) {
+    databases->Scan(txn, &table_iter, pc);
+    for (uint32_t i = 0; i < pc->NumTuples(); i++) result.emplace_back(db_oids[i], db_cats[i]);
+  }
+
+  delete[] buffer;
+  return result;
+}
+
+std::vector<std::pair<catalog::table_oid_t, SqlTable *>> CheckpointManager::GetUserTables(
+    const common::ManagedPointer<transaction::TransactionContext> txn,
+    const common::ManagedPointer<catalog::DatabaseCatalog> dbc) {
+  const auto classes = common::ManagedPointer(dbc->pg_core_.classes_);
+  const std::vector<catalog::col_oid_t> cols{catalog::postgres::PgClass::RELOID.oid_,
+                                             catalog::postgres::PgClass::RELKIND.oid_,
+                                             catalog::postgres::PgClass::REL_PTR.oid_};
+  const auto pci = classes->InitializerForProjectedColumns(cols, CHECKPOINT_BATCH_SIZE);
+  auto pm = classes->ProjectionMapForOids(cols);
+
+  byte *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+  auto pc = pci.Initialize(buffer);
+  auto class_oids = reinterpret_cast<uint32_t *>(pc->ColumnStart(pm[catalog::postgres::PgClass::RELOID.oid_]));
+  auto class_kinds = reinterpret_cast<catalog::postgres::PgClass::RelKind *>(
+      pc->ColumnStart(pm[catalog::postgres::PgClass::RELKIND.oid_]));
+  auto objects = reinterpret_cast<SqlTable **>(pc->ColumnStart(pm[catalog::postgres::PgClass::REL_PTR.oid_]));
+
+  std::vector<std::pair<catalog::table_oid_t, SqlTable *>> result;
+  auto table_iter = classes->begin();
+  while (table_iter != classes->end()) {
+    classes->Scan(txn, &table_iter, pc);
+    for (uint32_t i = 0; i < pc->NumTuples(); i++) {
+      // Catalog tables are rebuilt from the log, so only user tables are checkpointed. All catalog tables have OIDs
+      // less than START_OID.
+      if (class_kinds[i] != catalog::postgres::PgClass::RelKind::REGULAR_TABLE || class_oids[i] < catalog::START_OID) {
+        continue;
+      }
+      NOISEPAGE_ASSERT(objects[i] != nullptr, "Committed tables should have their pointer set in pg_class");
+      result.emplace_back(catalog::table_oid_t(class_oids[i]), objects[i]);
+    }
+  }
+
+  delete[] buffer;
+  return result;
+}
+
+void CheckpointManager::CheckpointTable(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                        const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                                        const common::ManagedPointer<catalog::DatabaseCatalog> dbc,
+                                        const common::ManagedPointer<SqlTable> table, BufferedLogWriter *const out) {
+  const auto &schema = dbc->GetSchema(txn, table_oid);
+  std::vector<catalog::col_oid_t> col_oids;
+  std::vector<uint16_t> attr_sizes;
+  for (const auto &col : schema.GetColumns()) {
+    col_oids.emplace_back(col.Oid());
+    attr_sizes.emplace_back(col.AttributeLength());
+  }
+  const auto num_cols = static_cast<uint16_t>(col_oids.size());
+
+  // Table header: which table the following batches belong to, and how to interpret each of their columns
+  WriteValue(out, CheckpointMarker::TABLE);
+  WriteValue(out, db_oid);
+  WriteValue(out, table_oid);
+  WriteValue(out, num_cols);
+  for (uint16_t i = 0; i < num_cols; i++) {
+    WriteValue(out, col_oids[i]);
+    WriteValue(out, attr_sizes[i]);
+  }
+
+  const auto pci = table->InitializerForProjectedColumns(col_oids, CHECKPOINT_BATCH_SIZE);
+  auto pm = table->ProjectionMapForOids(col_oids);
+  byte *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+  auto pc = pci.Initialize(buffer);
+  std::vector<int32_t> varlen_offsets(CHECKPOINT_BATCH_SIZE + 1);
+
+  auto table_iter = table->begin();
+  while (table_iter != table->end()) {
+    table->Scan(txn, &table_iter, pc);
+    const uint32_t num_tuples = pc->NumTuples();
+    if (num_tuples == 0) continue;
+
+    WriteValue(out, CheckpointMarker::BATCH);
+    WriteValue(out, num_tuples);
+    WriteBytes(out, pc->TupleSlots(), static_cast<uint32_t>(sizeof(TupleSlot)) * num_tuples);
+
+    for (uint16_t i = 0; i < num_cols; i++) {
+      const auto col_idx = pm[col_oids[i]];
+      const auto *validity = pc->ColumnNullBitmap(col_idx);
+      WriteBytes(out, validity, common::RawBitmap::SizeInBytes(num_tuples));
+
+      if (attr_sizes[i] != VARLEN_COLUMN) {
+        WriteBytes(out, pc->ColumnStart(col_idx), attr_sizes[i] * num_tuples);
+        continue;
+      }
+
+      // Varlens follow Arrow's variable-size binary layout: num_tuples + 1 offsets, then the concatenated values
+      const auto *entries = reinterpret_cast<const VarlenEntry *>(pc->ColumnStart(col_idx));
+      varlen_offsets[0] = 0;
+      for (uint32_t row = 0; row < num_tuples; row++) {
+        const auto size = validity->Test(row) ? entries[row].Size() : 0;
+        varlen_offsets[row + 1] = varlen_offsets[row] + static_cast<int32_t>(size);
+      }
+      WriteBytes(out, varlen_offsets.data(), static_cast<uint32_t>(sizeof(int32_t)) * (num_tuples + 1));
+      for (uint32_t row = 0; row < num_tuples; row++) {
+        if (validity->Test(row)) WriteBytes(out, entries[row].Content(), entries[row].Size());
+      }
+    }
+  }
+  WriteValue(out, CheckpointMarker::TABLE_END);
+
+  delete[] buffer;
+}
+
+}  // namespace noisepage::storage
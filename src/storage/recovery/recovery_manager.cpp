@@ -1,7 +1,10 @@
 #include "storage/recovery/recovery_manager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -22,6 +25,7 @@
 #include "storage/index/index.h"
 #include "storage/index/index_builder.h"
 #include "storage/index/index_metadata.h"
+#include "storage/recovery/checkpoint_manager.h"
 #include "storage/recovery/replication_log_provider.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "transaction/deferred_action_manager.h"
@@ -45,6 +49,26 @@ void RecoveryManager::WaitForRecoveryToFinish() {
   recovery_task_ = nullptr;
 }
 
+void RecoveryManager::SetReplayThreads(const uint32_t num_workers) {
+  NOISEPAGE_ASSERT(recovery_task_ == nullptr, "The replay threads must be set before recovery starts");
+  if (num_workers == 0) {
+    replay_workers_ = nullptr;
+    return;
+  }
+  replay_workers_ = std::make_unique<common::WorkerPool>(num_workers, common::TaskQueue{});
+  replay_workers_->Startup();
+}
+
+void RecoveryManager::UseCheckpoint(const std::string &checkpoint_file_path) {
+  NOISEPAGE_ASSERT(recovery_task_ == nullptr, "The checkpoint must be set before recovery starts");
+  checkpoint_reader_ = std::make_unique<BufferedLogReader>(checkpoint_file_path.c_str());
+  if (ReadCheckpointValue<uint32_t>() != CheckpointManager::CHECKPOINT_MAGIC ||
+      ReadCheckpointValue<uint8_t>() != CheckpointManager::CHECKPOINT_FORMAT_VERSION) {
+    throw std::runtime_error("Unsupported checkpoint file " + checkpoint_file_path);
+  }
+  checkpoint_ts_ = ReadCheckpointValue<transaction::timestamp_t>();
+}
+
 void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogProvider> log_provider) {
   uint64_t num_records = 0, num_txns = 0;
 
@@ -80,7 +104,10 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
     if (replication_manager_ != DISABLED && replication_manager_->IsReplica() &&
         log_provider->GetType() == AbstractLogProvider::LogProviderType::REPLICATION) {
       auto rlp = log_provider.CastManagedPointerTo<ReplicationLogProvider>();
-      auto event = rlp->WaitUntilEvent();
+      // Parallel replay holds deferred transactions back for a batch, but no longer than PARALLEL_REPLAY_MAX_DELAY
+      auto event = replay_workers_ != nullptr && !deferred_txns_.empty()
+                       ? rlp->WaitUntilEvent(last_replay_ + PARALLEL_REPLAY_MAX_DELAY)
+                       : rlp->WaitUntilEvent();
 
       if (event == ReplicationLogProvider::ReplicationEvent::END) {
         break;
@@ -88,10 +115,17 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
 
       if (event == ReplicationLogProvider::ReplicationEvent::OAT) {
         auto oat = rlp->PopOAT();
+        replayable_up_to_ = oat;
         std::tie(num_txns, num_records) = ProcessDeferredTransactions(oat);
         recovered_txns_ += num_txns;
         continue;
       }
+
+      if (event == ReplicationLogProvider::ReplicationEvent::TIMEOUT) {
+        std::tie(num_txns, num_records) = ProcessDeferredTransactions(replayable_up_to_);
+        recovered_txns_ += num_txns;
+        continue;
+      }
       NOISEPAGE_ASSERT(event == ReplicationLogProvider::ReplicationEvent::LOGS,
                        "What other replication events have been added?");
     }
@@ -117,11 +151,33 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
         NOISEPAGE_ASSERT(pair.second.empty(), "Commit records should not have any varlen pointers");
         auto *commit_record = log_record->GetUnderlyingRecordBodyAs<CommitRecord>();
 
-        // We defer all transactions initially
-        deferred_txns_.insert(log_record->TxnBegin());
-        // Process any deferred transactions that are safe to execute
-        std::tie(num_txns, num_records) = ProcessDeferredTransactions(commit_record->OldestActiveTxn());
-        recovered_txns_ += num_txns;
+        // A transaction of a partitioned log is held back until every commit before it is known to be durable
+        const auto durable_before = log_provider->DurableCommitsBefore();
+        if (commit_record->CommitTime() < durable_before) {
+          DeferCommittedTransaction(log_record->TxnBegin(), commit_record->CommitTime());
+        } else {
+          undurable_txns_.emplace(commit_record->CommitTime(), log_record->TxnBegin());
+        }
+        DeferDurableTransactions(durable_before);
+        // Process any deferred transactions that are safe to execute. Parallel replay waits for a batch of them.
+        const auto provided_txns_up_to = log_provider->ProvidedTxnsUpTo(commit_record->OldestActiveTxn());
+        replayable_up_to_ = provided_txns_up_to;
+        // Every transaction the checkpoint covers started before the checkpoint timestamp, so once the log has provided
+        // all of them, the checkpoint can be loaded and the rest of the log streamed on top of it. None of them may be
+        // held back still.
+        const bool load_checkpoint =
+            checkpoint_reader_ != nullptr && provided_txns_up_to > checkpoint_ts_ &&
+            (undurable_txns_.empty() || undurable_txns_.cbegin()->first > checkpoint_ts_);
+        if (load_checkpoint || replay_workers_ == nullptr || deferred_txns_.size() >= PARALLEL_REPLAY_MIN_BATCH_SIZE ||
+            std::chrono::steady_clock::now() - last_replay_ >= PARALLEL_REPLAY_MAX_DELAY) {
+          std::tie(num_txns, num_records) = ProcessDeferredTransactions(provided_txns_up_to);
+          recovered_txns_ += num_txns;
+        }
+        if (load_checkpoint) {
+          LoadCheckpointAndTail();
+          std::tie(num_txns, num_records) = ProcessDeferredTransactions(provided_txns_up_to);
+          recovered_txns_ += num_txns;
+        }
         // Record the current commit txn
         num_records++;
 
@@ -137,8 +193,18 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
         buffered_changes_map_[log_record->TxnBegin()].push_back(pair);
     }
   }
+  // The transactions still held back were never durable in every partition, so they are left in buffered_changes_map_
+  // to be cleaned up below like the transactions that never committed
+  DeferDurableTransactions(log_provider->DurableCommitsBefore());
+  undurable_txns_.clear();
+
   // Process all deferred txns
   ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
+  if (checkpoint_reader_ != nullptr) {
+    // The log ended before it got past the checkpoint
+    LoadCheckpointAndTail();
+    ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
+  }
   NOISEPAGE_ASSERT(deferred_txns_.empty(),
                    "We should have no unprocessed deferred transactions at the end of recovery");
 
@@ -152,8 +218,39 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
   }
 }
 
+void RecoveryManager::LoadCheckpointAndTail() {
+  // Every transaction the checkpoint covers has been replayed, so the checkpointed tables exist. Load their rows, and
+  // defer the transactions read so far that come after the checkpoint, so that they are replayed on top of them.
+  NOISEPAGE_ASSERT(checkpointed_txns_.empty(), "All checkpointed transactions should have been replayed");
+  RecoverFromCheckpoint();
+  deferred_txns_.insert(checkpoint_tail_txns_.cbegin(), checkpoint_tail_txns_.cend());
+  checkpoint_tail_txns_.clear();
+}
+
+void RecoveryManager::DeferCommittedTransaction(const transaction::timestamp_t txn_id,
+                                                const transaction::timestamp_t commit_time) {
+  if (checkpoint_reader_ != nullptr && commit_time > checkpoint_ts_) {
+    // The transaction is not in the checkpoint, so it has to be replayed after the checkpoint is loaded
+    checkpoint_tail_txns_.insert(txn_id);
+  } else {
+    // We defer all transactions initially
+    deferred_txns_.insert(txn_id);
+    if (checkpoint_reader_ != nullptr) checkpointed_txns_.insert(txn_id);
+  }
+}
+
+void RecoveryManager::DeferDurableTransactions(const transaction::timestamp_t durable_before) {
+  auto it = undurable_txns_.begin();
+  for (; it != undurable_txns_.end() && it->first < durable_before; ++it) {
+    DeferCommittedTransaction(it->second, it->first);
+  }
+  undurable_txns_.erase(undurable_txns_.begin(), it);
+}
+
 uint32_t RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timestamp_t txn_id) {
   auto records_processed = 0;
+  // The changes of a checkpointed transaction to user tables are loaded from the checkpoint instead
+  const bool checkpointed = checkpointed_txns_.erase(txn_id) > 0;
   // Begin a txn to replay changes with.
   auto *txn = txn_manager_->BeginTransaction();
 
@@ -164,6 +261,13 @@ uint32_t RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::ti
         buffered_record->RecordType() == LogRecordType::REDO || buffered_record->RecordType() == LogRecordType::DELETE,
         "Buffered record must be a redo or delete.");
 
+    if (checkpointed && IsUserTableRecord(buffered_record)) {
+      // The varlens of a skipped record are never handed over to a table, so they are freed here
+      for (auto *varlen_entry : buffered_changes_map_[txn_id][idx].second) delete[] varlen_entry;
+      buffered_changes_map_[txn_id][idx].second.clear();
+      continue;
+    }
+
     if (IsSpecialCaseCatalogRecord(buffered_record)) {
       idx += ProcessSpecialCaseCatalogRecord(txn, &buffered_changes_map_[txn_id], idx);
     } else if (buffered_record->RecordType() == LogRecordType::REDO) {
@@ -174,13 +278,18 @@ uint32_t RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::ti
     records_processed++;
   }
 
+  // Commit the txn
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  FinishCommittedTransaction(txn_id);
+
+  return records_processed;
+}
+
+void RecoveryManager::FinishCommittedTransaction(const transaction::timestamp_t txn_id) {
   // Defer deletes of the log records
   DeferRecordDeletes(txn_id, false);
   buffered_changes_map_.erase(txn_id);
 
-  // Commit the txn
-  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
-
   last_applied_txn_id_ = std::max(last_applied_txn_id_, txn_id);
   if (replication_manager_ != DISABLED) {
     // Replicas have to send back their list of deferred transactions that were processed, periodically.
@@ -191,10 +300,111 @@ uint32_t RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::ti
       replication_manager_->GetAsReplica()->NotifyPrimaryTransactionApplied(txn_id);
     }
   }
+}
+
+uint32_t RecoveryManager::ProcessCommittedTransactionsInParallel(
+    const std::vector<transaction::timestamp_t> &txn_ids) {
+  uint32_t records_processed = 0;
+
+  // The current round of non-conflicting transactions, and what they touch. Two transactions conflict if they write the
+  // same tuple slot, or if one of them deletes from a table the other one writes to. Deletes are treated at the table
+  // level so that a delete and an insert of the same unique key are never applied concurrently.
+  std::vector<transaction::timestamp_t> round;
+  std::unordered_set<TupleSlot> round_slots;
+  std::unordered_set<catalog::table_oid_t> round_written_tables, round_deleted_tables;
+  const auto flush_round = [&] {
+    if (round.empty()) return;
+    records_processed += round.size() == 1 ? ProcessCommittedTransaction(round[0]) : ProcessReplayRound(round);
+    round.clear();
+    round_slots.clear();
+    round_written_tables.clear();
+    round_deleted_tables.clear();
+  };
+
+  std::unordered_set<TupleSlot> txn_slots;
+  std::unordered_set<catalog::table_oid_t> txn_written_tables, txn_deleted_tables;
+  for (const auto txn_id : txn_ids) {
+    txn_slots.clear();
+    txn_written_tables.clear();
+    txn_deleted_tables.clear();
+
+    // Catalog changes and transactions covered by a checkpoint go through the serial path
+    bool serial = checkpointed_txns_.count(txn_id) > 0;
+    for (const auto &buffered_pair : buffered_changes_map_[txn_id]) {
+      const auto *record = buffered_pair.first;
+      if (!IsUserTableRecord(record)) {
+        serial = true;
+        break;
+      }
+      if (record->RecordType() == LogRecordType::REDO) {
+        const auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+        txn_slots.insert(redo_record->GetTupleSlot());
+        txn_written_tables.insert(redo_record->GetTableOid());
+      } else {
+        const auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
+        txn_slots.insert(delete_record->GetTupleSlot());
+        txn_deleted_tables.insert(delete_record->GetTableOid());
+      }
+    }
+
+    if (serial) {
+      flush_round();
+      records_processed += ProcessCommittedTransaction(txn_id);
+      continue;
+    }
+
+    const auto intersects = [](const auto &lhs, const auto &rhs) {
+      return std::any_of(lhs.cbegin(), lhs.cend(), [&](const auto &elem) { return rhs.count(elem) > 0; });
+    };
+    if (intersects(txn_slots, round_slots) || intersects(txn_deleted_tables, round_written_tables) ||
+        intersects(txn_deleted_tables, round_deleted_tables) || intersects(txn_written_tables, round_deleted_tables)) {
+      flush_round();
+    }
+    round.push_back(txn_id);
+    round_slots.insert(txn_slots.cbegin(), txn_slots.cend());
+    round_written_tables.insert(txn_written_tables.cbegin(), txn_written_tables.cend());
+    round_deleted_tables.insert(txn_deleted_tables.cbegin(), txn_deleted_tables.cend());
+  }
+  flush_round();
 
   return records_processed;
 }
 
+uint32_t RecoveryManager::ProcessReplayRound(const std::vector<transaction::timestamp_t> &txn_ids) {
+  // Workers only touch their own transaction's buffered changes. References to the values of buffered_changes_map_
+  // stay valid as long as no entries are erased, which only happens after the round has finished.
+  std::vector<std::vector<std::pair<LogRecord *, std::vector<byte *>>> *> buffered_changes;
+  buffered_changes.reserve(txn_ids.size());
+  for (const auto txn_id : txn_ids) buffered_changes.push_back(&buffered_changes_map_[txn_id]);
+
+  std::atomic<uint32_t> records_processed = 0;
+  std::atomic<uint32_t> next_commit = 0;
+  for (uint32_t i = 0; i < txn_ids.size(); i++) {
+    replay_workers_->SubmitTask([&, i] {
+      // Begin a txn to replay changes with.
+      auto *txn = txn_manager_->BeginTransaction();
+      for (const auto &buffered_pair : *buffered_changes[i]) {
+        if (buffered_pair.first->RecordType() == LogRecordType::REDO) {
+          ReplayRedoRecord(txn, buffered_pair.first);
+        } else {
+          ReplayDeleteRecord(txn, buffered_pair.first);
+        }
+      }
+      records_processed += static_cast<uint32_t>(buffered_changes[i]->size());
+
+      // Commit in the serial replay order, so that a reader never sees a transaction without the ones before it. Tasks
+      // are dequeued in order, so the transaction before this one is already running and this cannot deadlock.
+      while (next_commit.load() != i) std::this_thread::yield();
+      txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      next_commit.store(i + 1);
+    });
+  }
+  replay_workers_->WaitUntilAllFinished();
+
+  for (const auto txn_id : txn_ids) FinishCommittedTransaction(txn_id);
+  return records_processed.load();
+}
+
 void RecoveryManager::DeferRecordDeletes(noisepage::transaction::timestamp_t txn_id, bool delete_varlens) {
   // Capture the changes by value except for changes which we can move
   deferred_action_manager_->RegisterDeferredAction([=, buffered_changes{std::move(buffered_changes_map_[txn_id])}]() {
@@ -219,9 +429,16 @@ std::pair<uint32_t, uint32_t> RecoveryManager::ProcessDeferredTransactions(
       (upper_bound_ts == transaction::INVALID_TXN_TIMESTAMP) ? transaction::timestamp_t(INT64_MAX) : upper_bound_ts;
   auto upper_bound_it = deferred_txns_.upper_bound(upper_bound_ts);
 
-  for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
-    records_processed += ProcessCommittedTransaction(*it);
-    txns_processed++;
+  if (replay_workers_ != nullptr) {
+    const std::vector<transaction::timestamp_t> txn_ids(deferred_txns_.begin(), upper_bound_it);
+    records_processed += ProcessCommittedTransactionsInParallel(txn_ids);
+    txns_processed += txn_ids.size();
+    last_replay_ = std::chrono::steady_clock::now();
+  } else {
+    for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
+      records_processed += ProcessCommittedTransaction(*it);
+      txns_processed++;
+    }
   }
 
   // If we actually processed some txns, remove them from the set
@@ -230,6 +447,103 @@ std::pair<uint32_t, uint32_t> RecoveryManager::ProcessDeferredTransactions(
   return {txns_processed, records_processed};
 }
 
+void RecoveryManager::RecoverFromCheckpoint() {
+  while (true) {
+    const auto marker = ReadCheckpointValue<CheckpointManager::CheckpointMarker>();
+    if (marker == CheckpointManager::CheckpointMarker::END) break;
+    if (marker != CheckpointManager::CheckpointMarker::TABLE) throw std::runtime_error("Malformed checkpoint file");
+
+    // Table header
+    const auto db_oid = ReadCheckpointValue<catalog::db_oid_t>();
+    const auto table_oid = ReadCheckpointValue<catalog::table_oid_t>();
+    const auto num_cols = ReadCheckpointValue<uint16_t>();
+    std::vector<catalog::col_oid_t> col_oids;
+    std::vector<uint16_t> attr_sizes;
+    for (uint16_t i = 0; i < num_cols; i++) {
+      col_oids.emplace_back(ReadCheckpointValue<catalog::col_oid_t>());
+      attr_sizes.emplace_back(ReadCheckpointValue<uint16_t>());
+    }
+
+    // Batches of rows, until the end of the table
+    while (true) {
+      const auto batch_marker = ReadCheckpointValue<CheckpointManager::CheckpointMarker>();
+      if (batch_marker == CheckpointManager::CheckpointMarker::TABLE_END) break;
+      if (batch_marker != CheckpointManager::CheckpointMarker::BATCH) {
+        throw std::runtime_error("Malformed checkpoint file");
+      }
+      RecoverCheckpointBatch(db_oid, table_oid, col_oids, attr_sizes);
+    }
+  }
+  checkpoint_reader_ = nullptr;
+}
+
+void RecoveryManager::RecoverCheckpointBatch(const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                                             const std::vector<catalog::col_oid_t> &col_oids,
+                                             const std::vector<uint16_t> &attr_sizes) {
+  const auto num_tuples = ReadCheckpointValue<uint32_t>();
+  std::vector<TupleSlot> old_tuple_slots(num_tuples);
+  ReadCheckpoint(old_tuple_slots.data(), static_cast<uint32_t>(sizeof(TupleSlot)) * num_tuples);
+
+  // Read in the columns of the batch. For varlens, the values are preceded by their offsets.
+  std::vector<std::vector<byte>> validities(col_oids.size()), values(col_oids.size());
+  std::vector<std::vector<int32_t>> varlen_offsets(col_oids.size());
+  for (uint32_t i = 0; i < col_oids.size(); i++) {
+    validities[i].resize(common::RawBitmap::SizeInBytes(num_tuples));
+    ReadCheckpoint(validities[i].data(), static_cast<uint32_t>(validities[i].size()));
+    if (attr_sizes[i] == VARLEN_COLUMN) {
+      varlen_offsets[i].resize(num_tuples + 1);
+      ReadCheckpoint(varlen_offsets[i].data(), static_cast<uint32_t>(sizeof(int32_t)) * (num_tuples + 1));
+      values[i].resize(varlen_offsets[i][num_tuples]);
+    } else {
+      values[i].resize(attr_sizes[i] * num_tuples);
+    }
+    ReadCheckpoint(values[i].data(), static_cast<uint32_t>(values[i].size()));
+  }
+
+  // Every batch is inserted by its own transaction, so loading a large table does not build up one huge transaction.
+  auto *txn = txn_manager_->BeginTransaction();
+  auto sql_table_ptr = GetSqlTable(txn, db_oid, table_oid);
+  const auto initializer = sql_table_ptr->InitializerForProjectedRow(col_oids);
+  auto pr_map = sql_table_ptr->ProjectionMapForOids(col_oids);
+
+  for (uint32_t row = 0; row < num_tuples; row++) {
+    // Stage the write. This way the recovery operation is logged if logging is enabled.
+    auto *redo_record = txn->StageWrite(db_oid, table_oid, initializer);
+    auto *delta = redo_record->Delta();
+    for (uint32_t i = 0; i < col_oids.size(); i++) {
+      const auto pr_idx = pr_map[col_oids[i]];
+      if (!reinterpret_cast<const common::RawBitmap *>(validities[i].data())->Test(row)) {
+        delta->SetNull(pr_idx);
+        continue;
+      }
+      if (attr_sizes[i] != VARLEN_COLUMN) {
+        std::memcpy(delta->AccessForceNotNull(pr_idx), values[i].data() + row * attr_sizes[i], attr_sizes[i]);
+        continue;
+      }
+      const auto *content = values[i].data() + varlen_offsets[i][row];
+      const auto size = static_cast<uint32_t>(varlen_offsets[i][row + 1] - varlen_offsets[i][row]);
+      VarlenEntry varlen;
+      if (size <= VarlenEntry::InlineThreshold()) {
+        varlen = VarlenEntry::CreateInline(content, size);
+      } else {
+        // The table takes ownership of the copy
+        auto *copy = common::AllocationUtil::AllocateAligned(size);
+        std::memcpy(copy, content, size);
+        varlen = VarlenEntry::Create(copy, size, true);
+      }
+      *reinterpret_cast<VarlenEntry *>(delta->AccessForceNotNull(pr_idx)) = varlen;
+    }
+
+    // Insert will always succeed
+    const auto new_tuple_slot = sql_table_ptr->Insert(common::ManagedPointer(txn), redo_record);
+    UpdateIndexesOnTable(txn, db_oid, table_oid, sql_table_ptr, new_tuple_slot, delta, true /* insert */);
+    // The original tuple slot is used by the log records written after the checkpoint
+    tuple_slot_map_[old_tuple_slots[row]] = new_tuple_slot;
+  }
+
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, LogRecord *record) {
   auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
   auto sql_table_ptr = GetSqlTable(txn, redo_record->GetDatabaseOid(), redo_record->GetTableOid());
@@ -250,9 +564,10 @@ void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, Log
     NOISEPAGE_ASSERT(staged_record->GetTupleSlot() == new_tuple_slot,
                      "Insert should update redo record with new tuple slot");
     // Create a mapping of the old to new tuple. The new tuple slot should be used for future updates and deletes.
+    common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
     tuple_slot_map_[old_tuple_slot] = new_tuple_slot;
   } else {
-    auto new_tuple_slot = tuple_slot_map_[redo_record->GetTupleSlot()];
+    auto new_tuple_slot = GetTupleSlotMapping(redo_record->GetTupleSlot());
     redo_record->SetTupleSlot(new_tuple_slot);
     // Stage the write. This way the recovery operation is logged if logging is enabled
     auto staged_record = txn->StageRecoveryWrite(record);
@@ -266,7 +581,8 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
   // Get tuple slot
   auto new_tuple_slot = GetTupleSlotMapping(delete_record->GetTupleSlot());
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, delete_record->GetDatabaseOid());
+  auto db_catalog_ptr =
+      GetDatabaseCatalog(txn, delete_record->GetDatabaseOid(), IsCatalogTable(delete_record->GetTableOid()));
   auto sql_table_ptr = db_catalog_ptr->GetTable(common::ManagedPointer(txn), delete_record->GetTableOid());
   const auto &schema = GetTableSchema(txn, db_catalog_ptr, delete_record->GetTableOid());
 
@@ -291,7 +607,10 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   UpdateIndexesOnTable(txn, delete_record->GetDatabaseOid(), delete_record->GetTableOid(), sql_table_ptr,
                        new_tuple_slot, pr, false /* delete */);
   // We can delete the TupleSlot from the map
-  tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&tuple_slot_map_latch_);
+    tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  }
   delete[] buffer;
 }
 
@@ -299,7 +618,7 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
                                            catalog::table_oid_t table_oid,
                                            common::ManagedPointer<storage::SqlTable> table_ptr,
                                            const TupleSlot &tuple_slot, ProjectedRow *table_pr, const bool insert) {
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid, IsCatalogTable(table_oid));
 
   // Stores index objects and schemas
   std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> index_objects;
@@ -920,7 +1239,7 @@ common::ManagedPointer<storage::SqlTable> RecoveryManager::GetSqlTable(transacti
     return common::ManagedPointer(catalog_->databases_);
   }
 
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid, IsCatalogTable(table_oid));
 
   common::ManagedPointer<storage::SqlTable> table_ptr = nullptr;
 
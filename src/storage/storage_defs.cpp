@@ -1,10 +1,147 @@
 #include "storage/storage_defs.h"
 
+#include <sys/mman.h>
+
+#include <new>
+
 #include "common/strong_typedef_body.h"
 
+// Needed for some Darwin machine that don't have MAP_ANONYMOUS
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
 namespace noisepage::storage {
 
 STRONG_TYPEDEF_BODY(col_id_t, uint16_t);
 STRONG_TYPEDEF_BODY(layout_version_t, uint16_t);
 
+BlockAllocator::~BlockAllocator() {
+  // Blocks that were never deleted may still be in use, so only chunks without any of them are unmapped
+  std::unordered_map<uintptr_t, uint64_t> num_unused;
+  for (const auto &unused : unused_) {
+    for (RawBlock *const block : unused) num_unused[reinterpret_cast<uintptr_t>(block) & ~(CHUNK_SIZE - 1)]++;
+  }
+  for (void *const chunk : chunks_) {
+    if (num_unused[reinterpret_cast<uintptr_t>(chunk)] == CHUNK_SIZE / common::Constants::BLOCK_SIZE) {
+      munmap(chunk, CHUNK_SIZE);
+    }
+  }
+}
+
+RawBlock *BlockAllocator::New(const uint32_t node) {
+  auto &unused = unused_[node];
+  if (unused.empty() && !MapChunk(node)) return nullptr;
+  auto *const block = new (unused.back()) RawBlock;
+  unused.pop_back();
+  block->numa_node_ = static_cast<uint16_t>(node);
+  return block;
+}
+
+void BlockAllocator::Delete(RawBlock *const block) {
+  const uint32_t node = block->numa_node_;
+  block->~RawBlock();
+#if !defined(__APPLE__)
+  // Fails on hugetlb chunks, which cannot give back less than a huge page, and then the memory stays with the block
+  madvise(block, common::Constants::BLOCK_SIZE, MADV_DONTNEED);
+#endif
+  unused_[node].push_back(block);
+}
+
+bool BlockAllocator::MapChunk(const uint32_t node) {
+  void *chunk = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  chunk = mmap(nullptr, CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+  if (chunk == MAP_FAILED) {
+    // No huge pages are reserved. Map twice the size to find a chunk aligned to the huge page size in it.
+    auto *const mapped = static_cast<byte *>(
+        mmap(nullptr, 2 * CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (mapped == MAP_FAILED) return false;
+    auto *const aligned = reinterpret_cast<byte *>((reinterpret_cast<uintptr_t>(mapped) + CHUNK_SIZE - 1) &
+                                                   ~static_cast<uintptr_t>(CHUNK_SIZE - 1));
+    if (aligned != mapped) munmap(mapped, aligned - mapped);
+    munmap(aligned + CHUNK_SIZE, mapped + CHUNK_SIZE - aligned);
+    chunk = aligned;
+#if !defined(__APPLE__)
+    madvise(chunk, CHUNK_SIZE, MADV_HUGEPAGE);
+#endif
+  }
+  common::NumaUtil::BindToNode(chunk, CHUNK_SIZE, node);
+  chunks_.push_back(chunk);
+  // Hand out the blocks of the chunk in address order
+  for (uint64_t offset = CHUNK_SIZE; offset > 0; offset -= common::Constants::BLOCK_SIZE) {
+    unused_[node].push_back(reinterpret_cast<RawBlock *>(static_cast<byte *>(chunk) + offset -
+                                                         common::Constants::BLOCK_SIZE));
+  }
+  return true;
+}
+
+BlockStore::BlockStore(const uint64_t size_limit, const uint64_t reuse_limit)
+    : size_limit_(size_limit), reuse_limit_(reuse_limit) {}
+
+BlockStore::~BlockStore() {
+  for (auto &reuse_list : reuse_lists_) {
+    for (RawBlock *const block : reuse_list) alloc_.Delete(block);
+  }
+}
+
+RawBlock *BlockStore::Get() {
+  const uint32_t node = common::NumaUtil::CurrentNode();
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  auto *reuse_list = &reuse_lists_[node];
+  if (reuse_list->empty()) {
+    if (current_size_ < size_limit_) {
+      RawBlock *const result = alloc_.New(node);
+      // The allocator can't allocate more memory from the system
+      if (result == nullptr) throw common::AllocatorFailureException();
+      current_size_++;
+      return result;
+    }
+    // Out of new blocks, so reuse a block of another node
+    reuse_list = std::find_if(std::begin(reuse_lists_), std::end(reuse_lists_),
+                              [](const std::vector<RawBlock *> &list) { return !list.empty(); });
+    if (reuse_list == std::end(reuse_lists_)) throw common::NoMoreObjectException(size_limit_);
+  }
+  RawBlock *const result = reuse_list->back();
+  reuse_list->pop_back();
+  num_reusable_--;
+  NOISEPAGE_ASSERT(current_size_ <= size_limit_, "Block store has exceeded its size limit.");
+  return result;
+}
+
+void BlockStore::Release(RawBlock *const block) {
+  NOISEPAGE_ASSERT(block != nullptr, "releasing a null pointer");
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (num_reusable_ >= reuse_limit_) {
+    alloc_.Delete(block);
+    current_size_--;
+  } else {
+    reuse_lists_[NodeOf(block)].push_back(block);
+    num_reusable_++;
+  }
+}
+
+bool BlockStore::SetSizeLimit(const uint64_t new_size) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (new_size < current_size_) return false;
+  size_limit_ = new_size;
+  return true;
+}
+
+void BlockStore::SetReuseLimit(const uint64_t new_reuse_limit) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  reuse_limit_ = new_reuse_limit;
+  while (num_reusable_ > reuse_limit_) {
+    // Free from the node with the most reusable blocks, to keep some on every node
+    auto *const reuse_list = std::max_element(
+        std::begin(reuse_lists_), std::end(reuse_lists_),
+        [](const std::vector<RawBlock *> &l, const std::vector<RawBlock *> &r) { return l.size() < r.size(); });
+    alloc_.Delete(reuse_list->back());
+    reuse_list->pop_back();
+    num_reusable_--;
+    current_size_--;
+  }
+}
+
 }  // namespace noisepage::storage
@@ -1,9 +1,13 @@
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <string>
 #include <thread>  // NOLINT
 
 #include "common/scoped_timer.h"
 #include "common/thread_context.h"
+#include "loggers/storage_logger.h"
 #include "metrics/metrics_store.h"
 
 namespace noisepage::storage {
@@ -23,15 +27,23 @@ void DiskLogConsumerTask::Terminate() {
 }
 
 void DiskLogConsumerTask::WriteBuffersToLogFile() {
+  // Every transaction that committed before this has been handed over to its partition already, so it is in the log
+  // file once the queue is drained
+  const auto serialized_before =
+      watermark_ != nullptr ? watermark_->SerializedCommitsBefore() : transaction::INITIAL_TXN_TIMESTAMP;
   // Persist all the filled buffers to the disk
   SerializedLogs logs;
   while (!filled_buffer_queue_->Empty()) {
+    // Leave the batches handed over after a pending rotation was asked for to the next log file
+    if (RotationDue()) return;
     // Dequeue filled buffers and flush them to disk, as well as storing commit callbacks
     filled_buffer_queue_->Dequeue(&logs);
     if (logs.first != nullptr) {
       // Need the nullptr check because read-only txns don't serialize any buffers, but generate callbacks to be invoked
       current_data_written_ += logs.first->FlushBuffer();
+      current_buffers_written_++;
     }
+    num_batches_written_++;
     commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
     // Enqueue the flushed buffer to the empty buffer queue if all serializers are done with it.
     if (logs.first != nullptr && logs.first->MarkSerialized()) {
@@ -39,24 +51,85 @@ void DiskLogConsumerTask::WriteBuffersToLogFile() {
       empty_buffer_queue_->Enqueue(logs.first);
     }
   }
+  written_up_to_ = std::max(written_up_to_, serialized_before);
 }
 
 uint64_t DiskLogConsumerTask::PersistLogFile() {
-  if (current_data_written_ > 0) {
+  // Without anything else to persist, the watermark costs a persist of its own, so it is only written if anyone waits
+  const bool write_watermark = watermark_ != nullptr && written_up_to_ > persisted_up_to_ &&
+                               (current_data_written_ > 0 || !commit_callbacks_.empty() || force_flush_ ||
+                                !run_task_ || watermark_->IsWaitingOn(partition_));
+  if (write_watermark) WriteWatermark(written_up_to_);
+  if (current_data_written_ > 0 || write_watermark) {
     // Force the buffers to be written to disk. Because all buffers log to the same file, it suffices to call persist on
     // any buffer.
     buffers_->front().Persist();
   }
-  const auto num_buffers = commit_callbacks_.size();
+  if (write_watermark) persisted_up_to_ = written_up_to_;
+  const auto num_commits = commit_callbacks_.size();
+  // Counted before the callbacks run, so that the counts are up to date once a committer hears back
+  if (num_commits > 0) {
+    num_commit_batches_++;
+    num_commits_persisted_ += num_commits;
+  }
+  if (watermark_ != nullptr) {
+    // The callbacks are invoked once the transactions that committed before them are durable in every partition
+    watermark_->Persisted(partition_, persisted_up_to_, &commit_callbacks_);
+    return num_commits;
+  }
   // Execute the callbacks for the transactions that have been persisted
   for (auto &callback : commit_callbacks_) callback.fn_(callback.arg_);
   commit_callbacks_.clear();
-  return num_buffers;
+  return num_commits;
+}
+
+void DiskLogConsumerTask::RotateLogFile() {
+  // Everything handed over before the rotation is written by now, and goes into the sealed segment
+  PersistLogFile();
+  current_data_written_ = 0;
+  current_buffers_written_ = 0;
+
+  const auto segments = LogSegments(log_file_path_);
+  const std::string segment_path = LogSegmentFilePath(log_file_path_, segments.empty() ? 0 : segments.back() + 1);
+  // The buffers keep writing to the sealed segment until they are reopened. Only this thread flushes them, so no write
+  // can land in between.
+  if (std::rename(log_file_path_.c_str(), segment_path.c_str()) != 0) {
+    // The log file stays as it is, and is sealed by a later rotation
+    STORAGE_LOG_ERROR("Failed to seal log file {} with errno {}", log_file_path_, errno);
+    return;
+  }
+  for (auto &buffer : *buffers_) buffer.Reopen(log_file_path_.c_str());
+  if (watermark_writer_ != nullptr) {
+    watermark_writer_->Reopen(log_file_path_.c_str());
+    // Once the segments are truncated, recovery learns the watermark of the partition from the new log file alone
+    if (persisted_up_to_ != transaction::INITIAL_TXN_TIMESTAMP) {
+      WriteWatermark(persisted_up_to_);
+      watermark_writer_->Persist();
+    }
+  }
+}
+
+void DiskLogConsumerTask::WriteWatermark(const transaction::timestamp_t watermark) {
+  // Laid out like the header of a serialized record (see LogSerializerTask::SerializeRecord), followed by the
+  // watermark. There is no record in memory for it, so its size is 0.
+  const uint32_t size = 0;
+  const LogRecordType type = LogRecordType::WATERMARK;
+  const transaction::timestamp_t txn_begin = transaction::INVALID_TXN_TIMESTAMP;
+  watermark_writer_->BufferWrite(&size, sizeof(size));
+  watermark_writer_->BufferWrite(&type, sizeof(type));
+  watermark_writer_->BufferWrite(&txn_begin, sizeof(txn_begin));
+  watermark_writer_->BufferWrite(&watermark, sizeof(watermark));
+  if (compressor_ != nullptr) {
+    // A compressed log file holds nothing but blocks
+    char scratch[sizeof(LogBlockHeader) + sizeof(size) + sizeof(type) + sizeof(txn_begin) + sizeof(watermark)];
+    watermark_writer_->CompressBuffer(*compressor_, scratch);
+  }
+  watermark_writer_->FlushBuffer();
 }
 
 void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   // input for this operating unit
-  uint64_t num_bytes = 0, num_buffers = 0;
+  uint64_t num_bytes = 0, num_buffers = 0, num_commits = 0;
 
   // Keeps track of how much data we've written to the log file since the last persist
   current_data_written_ = 0;
@@ -64,7 +137,7 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   auto curr_sleep = persist_interval_;
   auto next_sleep = curr_sleep;
   const std::chrono::microseconds max_sleep = std::chrono::microseconds(10000);
-  // Time since last log file persist
+  // Time since last log file persist, with group commit this is when the last persist began
   auto last_persist = std::chrono::high_resolution_clock::now();
 
   // Initialize whether to collect metrics outside of the spin loop so as not to count each loop iteration as a sample
@@ -82,17 +155,28 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
     }
 
     curr_sleep = next_sleep;
+    auto wait = curr_sleep;
+    if (group_commit_ && CommittersWaiting()) {
+      // Committers are already waiting on a deferred persist, so only sleep until the persist is due
+      const auto since_persist = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::high_resolution_clock::now() - last_persist);
+      wait = std::max(group_commit_gap_ - since_persist, std::chrono::microseconds(0));
+    }
     {
       // Wait until we are told to flush buffers
       std::unique_lock<std::mutex> lock(persist_lock_);
       // Wake up the task thread if:
       // 1) The serializer thread has signalled to persist all non-empty buffers to disk
       // 2) There is a filled buffer to write to the disk
-      // 3) LogManager has shut down the task
-      // 4) Our persist interval timed out
-
-      bool signaled = disk_log_writer_thread_cv_.wait_for(
-          lock, curr_sleep, [&] { return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_; });
+      // 3) LogManager has shut down the task, or asked to rotate the log file
+      // 4) The durable watermark has started to wait on this partition
+      // 5) Our persist interval timed out
+
+      bool signaled = disk_log_writer_thread_cv_.wait_for(lock, wait, [&] {
+        return force_flush_ || rotate_log_file_ || !filled_buffer_queue_->Empty() || !run_task_ ||
+               watermark_wakeup_.load();
+      });
+      watermark_wakeup_ = false;
       next_sleep = signaled ? persist_interval_ : curr_sleep * 2;
       next_sleep = std::min(next_sleep, max_sleep);
     }
@@ -101,35 +185,51 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
     WriteBuffersToLogFile();
 
     // We persist the log file if the following conditions are met
-    // 1) The persist interval amount of time has passed since the last persist
+    // 1) The persist interval amount of time has passed since the last persist, or with group commit, a committer or
+    //    the durable watermark is waiting and at least the group commit gap has passed since the last persist began
     // 2) We have written more data since the last persist than the threshold
     // 3) We are signaled to persist
     // 4) We are shutting down this task
-    bool timeout = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
-                                                                         last_persist) > curr_sleep;
+    const auto since_persist = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - last_persist);
+    bool timeout = group_commit_ ? CommittersWaiting() && since_persist >= group_commit_gap_
+                                 : since_persist > curr_sleep;
 
     if (timeout || current_data_written_ > persist_threshold_ || force_flush_ || !run_task_) {
       std::unique_lock<std::mutex> lock(persist_lock_);
-      num_buffers = PersistLogFile();
+      // With group commit, the gap is measured from the start of the persist, so that a persist taking longer than the
+      // gap is followed by the next one right away
+      if (group_commit_) last_persist = std::chrono::high_resolution_clock::now();
+      num_commits = PersistLogFile();
+      num_buffers = current_buffers_written_;
       num_bytes = current_data_written_;
       // Reset meta data
-      last_persist = std::chrono::high_resolution_clock::now();
+      if (!group_commit_) last_persist = std::chrono::high_resolution_clock::now();
       current_data_written_ = 0;
+      current_buffers_written_ = 0;
       force_flush_ = false;
 
       // Signal anyone who forced a persist that the persist has finished
       persist_cv_.notify_all();
     }
 
-    if (num_buffers > 0) {
+    if (RotationDue()) {
+      std::unique_lock<std::mutex> lock(persist_lock_);
+      RotateLogFile();
+      rotate_log_file_ = false;
+      persist_cv_.notify_all();
+    }
+
+    if (num_buffers > 0 || num_commits > 0) {
       if (common::thread_context.resource_tracker_.IsRunning()) {
         // Stop the resource tracker for this operating unit
         common::thread_context.resource_tracker_.Stop();
         auto &resource_metrics = common::thread_context.resource_tracker_.GetMetrics();
-        common::thread_context.metrics_store_->RecordConsumerData(num_bytes, num_buffers, persist_interval_.count(),
-                                                                  resource_metrics);
+        common::thread_context.metrics_store_->RecordConsumerData(
+            num_bytes, num_buffers, num_commits, (group_commit_ ? group_commit_gap_ : persist_interval_).count(),
+            resource_metrics);
       }
-      num_bytes = num_buffers = 0;
+      num_bytes = num_buffers = num_commits = 0;
       // Update whether to collect metrics only if we did work (starting a new event) so as not to count each loop
       // iteration as a sample (by calling ComponentToRecord this increments the sample count)
       logging_metrics_enabled =
@@ -140,5 +240,6 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   // Be extra sure we processed everything
   WriteBuffersToLogFile();
   PersistLogFile();
+  if (watermark_writer_ != nullptr) watermark_writer_->Close();
 }
 }  // namespace noisepage::storage
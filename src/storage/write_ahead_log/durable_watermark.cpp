@@ -0,0 +1,57 @@
+#include "storage/write_ahead_log/durable_watermark.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "storage/write_ahead_log/disk_log_consumer_task.h"
+#include "transaction/timestamp_manager.h"
+
+namespace noisepage::storage {
+
+transaction::timestamp_t DurableWatermark::SerializedCommitsBefore() const {
+  transaction::TimestampManager *const timestamp_manager = timestamp_manager_;
+  return timestamp_manager == nullptr ? transaction::INITIAL_TXN_TIMESTAMP
+                                      : timestamp_manager->SerializedCommitsBefore();
+}
+
+void DurableWatermark::SetConsumer(const uint32_t partition, DiskLogConsumerTask *const consumer) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  consumers_[partition] = consumer;
+}
+
+void DurableWatermark::Persisted(const uint32_t partition, const transaction::timestamp_t frontier,
+                                 std::vector<CommitCallback> *const callbacks) {
+  std::vector<CommitCallback> durable;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    frontiers_[partition] = std::max(frontiers_[partition], frontier);
+    for (const auto &callback : *callbacks) pending_.emplace(callback.commit_time_, callback);
+
+    const auto watermark = *std::min_element(frontiers_.cbegin(), frontiers_.cend());
+    const auto end = pending_.lower_bound(watermark);
+    for (auto it = pending_.cbegin(); it != end; ++it) durable.push_back(it->second);
+    pending_.erase(pending_.cbegin(), end);
+
+    if (!pending_.empty()) {
+      // Wake up the partitions the watermark waits on, so that they persist without waiting for a committer of their
+      // own. The disk log consumer task may miss the notification while it is about to sleep, in which case it sees
+      // the request once it wakes up on its own.
+      const auto oldest_pending = pending_.cbegin()->first;
+      for (uint32_t lagging = 0; lagging < frontiers_.size(); lagging++) {
+        if (frontiers_[lagging] > oldest_pending || consumers_[lagging] == nullptr) continue;
+        consumers_[lagging]->watermark_wakeup_ = true;
+        consumers_[lagging]->disk_log_writer_thread_cv_.notify_one();
+      }
+    }
+  }
+  callbacks->clear();
+  // Execute the callbacks for the transactions that are durable in every partition
+  for (auto &callback : durable) callback.fn_(callback.arg_);
+}
+
+bool DurableWatermark::IsWaitingOn(const uint32_t partition) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  return !pending_.empty() && frontiers_[partition] <= pending_.cbegin()->first;
+}
+
+}  // namespace noisepage::storage
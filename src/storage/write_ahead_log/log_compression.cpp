@@ -0,0 +1,180 @@
+#include "storage/write_ahead_log/log_compression.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace noisepage::storage {
+
+namespace {
+
+// A length nibble of this value means that the rest of the length follows in bytes of 255, ended by a smaller byte
+constexpr uint32_t LENGTH_CONTINUES = 15;
+
+uint32_t ExtraLengthBytes(const uint32_t length) {
+  return length < LENGTH_CONTINUES ? 0 : (length - LENGTH_CONTINUES) / UINT8_MAX + 1;
+}
+
+char *WriteExtraLength(char *out, uint32_t length) {
+  if (length < LENGTH_CONTINUES) return out;
+  for (length -= LENGTH_CONTINUES; length >= UINT8_MAX; length -= UINT8_MAX) *out++ = static_cast<char>(UINT8_MAX);
+  *out++ = static_cast<char>(length);
+  return out;
+}
+
+void ReadExtraLength(const uint8_t **in, const uint8_t *const end, const uint32_t capacity, uint32_t *length) {
+  if (*length < LENGTH_CONTINUES) return;
+  uint8_t next;
+  do {
+    if (*in == end || *length > capacity) throw std::runtime_error("Corrupted LZ block in the log");
+    next = *(*in)++;
+    *length += next;
+  } while (next == UINT8_MAX);
+}
+
+/**
+ * Append a literal run and the back reference that follows it. The last run of the block has no back reference,
+ * which is given by a match length of 0.
+ * @return false if the sequence does not fit in capacity
+ */
+bool EmitSequence(const char *const literals, const uint32_t num_literals, const uint32_t offset,
+                  const uint32_t match_length, char *const dest, const uint32_t capacity, uint32_t *const size) {
+  const uint32_t match_code = match_length == 0 ? 0 : match_length - LZLogCompressor::MIN_MATCH;
+  uint32_t needed = 1 + ExtraLengthBytes(num_literals) + num_literals;
+  if (match_length != 0) needed += sizeof(uint16_t) + ExtraLengthBytes(match_code);
+  if (capacity - *size < needed) return false;
+
+  char *out = dest + *size;
+  *out++ = static_cast<char>((std::min(num_literals, LENGTH_CONTINUES) << 4) | std::min(match_code, LENGTH_CONTINUES));
+  out = WriteExtraLength(out, num_literals);
+  std::memcpy(out, literals, num_literals);
+  out += num_literals;
+  if (match_length != 0) {
+    const auto encoded_offset = static_cast<uint16_t>(offset);
+    std::memcpy(out, &encoded_offset, sizeof(uint16_t));
+    out += sizeof(uint16_t);
+    out = WriteExtraLength(out, match_code);
+  }
+  *size = static_cast<uint32_t>(out - dest);
+  return true;
+}
+
+}  // namespace
+
+uint32_t LogCompressor::EncodeBlock(const char *const src, const uint32_t size, char *const dest) const {
+  LogBlockHeader header{LogBlockHeader::MAGIC, size, 0, static_cast<uint32_t>(GetType())};
+  char *const payload = dest + sizeof(LogBlockHeader);
+  // Keep the compressed bytes only if they take up less room than the buffer itself
+  header.stored_size_ = Compress(src, size, payload, size);
+  if (header.stored_size_ == 0) {
+    header.stored_size_ = size;
+    header.codec_ = static_cast<uint32_t>(LogCompressionType::NONE);
+    std::memcpy(payload, src, size);
+  }
+  std::memcpy(dest, &header, sizeof(LogBlockHeader));
+  return static_cast<uint32_t>(sizeof(LogBlockHeader)) + header.stored_size_;
+}
+
+uint32_t LogCompressor::DecodeBlock(const LogBlockHeader &header, const char *const payload, char *const dest,
+                                    const uint32_t capacity) {
+  if (header.magic_ != LogBlockHeader::MAGIC) {
+    throw std::runtime_error("Log block header has no magic, the log was not written with the same wal_compression");
+  }
+  if (header.raw_size_ > capacity) throw std::runtime_error("Log block does not fit in the buffer");
+  const auto codec = static_cast<LogCompressionType>(header.codec_);
+  if (codec == LogCompressionType::NONE) {
+    if (header.stored_size_ != header.raw_size_) throw std::runtime_error("Corrupted log block header");
+    std::memcpy(dest, payload, header.stored_size_);
+    return header.stored_size_;
+  }
+  if (header.codec_ > static_cast<uint32_t>(LogCompressionType::LZ)) {
+    throw std::runtime_error("Unknown codec " + std::to_string(header.codec_) + " in log block header");
+  }
+  const uint32_t size = Get(codec)->Decompress(payload, header.stored_size_, dest, header.raw_size_);
+  if (size != header.raw_size_) throw std::runtime_error("Corrupted log block");
+  return size;
+}
+
+const LogCompressor *LogCompressor::Get(const LogCompressionType type) {
+  static const LZLogCompressor lz;
+  switch (type) {
+    case LogCompressionType::LZ:
+      return &lz;
+    default:
+      return nullptr;
+  }
+}
+
+uint32_t LZLogCompressor::Compress(const char *const src, const uint32_t size, char *const dest,
+                                   const uint32_t capacity) const {
+  // Most recent position + 1 of each hash of MIN_MATCH bytes, or 0 if the hash has not been seen yet
+  std::array<uint32_t, 1U << HASH_BITS> table{};
+  uint32_t compressed_size = 0;
+  uint32_t anchor = 0;  // Start of the pending literal run
+  uint32_t pos = 0;
+  while (pos + MIN_MATCH <= size) {
+    uint32_t word;
+    std::memcpy(&word, src + pos, MIN_MATCH);
+    const uint32_t hash = (word * 2654435761U) >> (32 - HASH_BITS);
+    const uint32_t candidate = table[hash];
+    table[hash] = pos + 1;
+    if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET ||
+        std::memcmp(src + candidate - 1, src + pos, MIN_MATCH) != 0) {
+      pos++;
+      continue;
+    }
+    const uint32_t match = candidate - 1;
+    uint32_t match_length = MIN_MATCH;
+    while (pos + match_length < size && src[match + match_length] == src[pos + match_length]) match_length++;
+    if (!EmitSequence(src + anchor, pos - anchor, pos - match, match_length, dest, capacity, &compressed_size)) {
+      return 0;
+    }
+    pos += match_length;
+    anchor = pos;
+  }
+  if (!EmitSequence(src + anchor, size - anchor, 0, 0, dest, capacity, &compressed_size)) return 0;
+  return compressed_size;
+}
+
+uint32_t LZLogCompressor::Decompress(const char *const src, const uint32_t size, char *const dest,
+                                     const uint32_t capacity) const {
+  const auto *in = reinterpret_cast<const uint8_t *>(src);
+  const auto *const end = in + size;
+  uint32_t decompressed_size = 0;
+  while (true) {
+    // Every block ends with a literal run without a back reference, which is missing from a block that was cut short
+    if (in == end) throw std::runtime_error("Corrupted LZ block in the log");
+    const uint8_t token = *in++;
+
+    uint32_t num_literals = token >> 4;
+    ReadExtraLength(&in, end, capacity, &num_literals);
+    if (num_literals > static_cast<uint32_t>(end - in) || num_literals > capacity - decompressed_size) {
+      throw std::runtime_error("Corrupted LZ block in the log");
+    }
+    std::memcpy(dest + decompressed_size, in, num_literals);
+    in += num_literals;
+    decompressed_size += num_literals;
+    // The last run has no back reference
+    if (in == end) break;
+
+    if (end - in < static_cast<int64_t>(sizeof(uint16_t))) throw std::runtime_error("Corrupted LZ block in the log");
+    uint16_t offset;
+    std::memcpy(&offset, in, sizeof(uint16_t));
+    in += sizeof(uint16_t);
+    uint32_t match_length = token & LENGTH_CONTINUES;
+    ReadExtraLength(&in, end, capacity, &match_length);
+    match_length += MIN_MATCH;
+    if (offset == 0 || offset > decompressed_size || match_length > capacity - decompressed_size) {
+      throw std::runtime_error("Corrupted LZ block in the log");
+    }
+    // The reference may overlap the bytes it produces, so it is copied a byte at a time
+    for (uint32_t i = 0; i < match_length; i++, decompressed_size++) {
+      dest[decompressed_size] = dest[decompressed_size - offset];
+    }
+  }
+  return decompressed_size;
+}
+
+}  // namespace noisepage::storage
@@ -1,8 +1,21 @@
 #include "storage/write_ahead_log/log_io.h"
 
+#include <dirent.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <string>
+#include <vector>
 namespace noisepage::storage {
 
+BufferedLogReader::BufferedLogReader(const char *const log_file_path)
+    : in_(PosixIoWrappers::Open(log_file_path, O_RDONLY)) {
+  char magic[sizeof(LogBlockHeader::MAGIC)];
+  if (pread(in_, magic, sizeof(magic), 0) == sizeof(magic) && LogCompressor::IsBlock(magic, sizeof(magic))) {
+    block_ = std::make_unique<char[]>(common::Constants::LOG_BUFFER_SIZE);
+  }
+}
+
 bool BufferedLogReader::Read(void *dest, uint32_t size) {
   if (read_head_ + size <= filled_size_) {
     // bytes to read are already buffered.
@@ -25,6 +38,10 @@ void BufferedLogReader::RefillBuffer() {
   NOISEPAGE_ASSERT(read_head_ == filled_size_, "Refilling a buffer that is not fully read results in loss of data");
   if (in_ == -1) throw std::runtime_error("No more bytes left in the log file");
   read_head_ = 0;
+  if (block_ != nullptr) {
+    RefillBufferFromBlock();
+    return;
+  }
   filled_size_ = PosixIoWrappers::ReadFully(in_, buffer_, common::Constants::LOG_BUFFER_SIZE);
   if (filled_size_ < common::Constants::LOG_BUFFER_SIZE) {
     // TODO(Tianyu): Is it better to make this an explicit close?
@@ -33,4 +50,46 @@ void BufferedLogReader::RefillBuffer() {
   }
 }
 
+void BufferedLogReader::RefillBufferFromBlock() {
+  filled_size_ = 0;
+  // Skip over empty blocks, so that the buffer is only left empty at the end of the log file
+  while (filled_size_ == 0 && in_ != -1) {
+    LogBlockHeader header;
+    const bool header_read = PosixIoWrappers::ReadFully(in_, &header, sizeof(LogBlockHeader)) == sizeof(LogBlockHeader);
+    if (header_read &&
+        (header.magic_ != LogBlockHeader::MAGIC || header.stored_size_ > common::Constants::LOG_BUFFER_SIZE)) {
+      throw std::runtime_error("Corrupted log block header");
+    }
+    // A block cut short by a crash was never persisted, so the log ends right before it
+    if (!header_read || PosixIoWrappers::ReadFully(in_, block_.get(), header.stored_size_) < header.stored_size_) {
+      PosixIoWrappers::Close(in_);
+      in_ = -1;
+      return;
+    }
+    filled_size_ = LogCompressor::DecodeBlock(header, block_.get(), buffer_, common::Constants::LOG_BUFFER_SIZE);
+  }
+}
+
+std::vector<uint64_t> LogSegments(const std::string &log_file_path) {
+  const auto slash = log_file_path.rfind('/');
+  const std::string directory = slash == std::string::npos ? "." : log_file_path.substr(0, slash + 1);
+  const std::string prefix = LogSegmentFilePath(log_file_path.substr(slash + 1), 0);
+  // Every segment name is the prefix with its number in place of the trailing 0
+  const std::string name_prefix = prefix.substr(0, prefix.size() - 1);
+
+  std::vector<uint64_t> segments;
+  DIR *const dir = opendir(directory.c_str());
+  if (dir == nullptr) return segments;
+  while (const dirent *entry = readdir(dir)) {
+    const std::string name = entry->d_name;
+    if (name.size() <= name_prefix.size() || name.compare(0, name_prefix.size(), name_prefix) != 0) continue;
+    const std::string number = name.substr(name_prefix.size());
+    if (!std::all_of(number.cbegin(), number.cend(), [](const char c) { return c >= '0' && c <= '9'; })) continue;
+    segments.emplace_back(std::stoull(number));
+  }
+  closedir(dir);
+  std::sort(segments.begin(), segments.end());
+  return segments;
+}
+
 }  // namespace noisepage::storage
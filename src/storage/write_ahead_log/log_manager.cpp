@@ -21,18 +21,31 @@ void LogManager::Start() {
 
   // Register DiskLogConsumerTask
   disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
-      this /* requester */, persist_interval_, persist_threshold_, &buffers_, empty_buffer_queue_.Get(),
-      &filled_buffer_queue_);
+      this /* requester */, persist_interval_, persist_threshold_, group_commit_target_iops_, &buffers_,
+      empty_buffer_queue_.Get(), &filled_buffer_queue_, log_file_path_, watermark_, partition_,
+      LogCompressor::Get(compression_));
+  if (watermark_ != nullptr) watermark_->SetConsumer(partition_, disk_log_writer_task_.Get());
 
   // Register LogSerializerTask
   log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
       this /* requester */, serialization_interval_, buffer_pool_, empty_buffer_queue_, &filled_buffer_queue_,
-      &disk_log_writer_task_->disk_log_writer_thread_cv_, primary_replication_manager_);
+      &disk_log_writer_task_->disk_log_writer_thread_cv_, primary_replication_manager_,
+      LogCompressor::Get(compression_));
+
+  for (auto &partition : partitions_) partition->Start();
 }
 
 void LogManager::ForceFlush() {
-  // Force the serializer task to serialize buffers
+  // Force the serializer tasks to serialize buffers. Every partition does so before any of them persists, so that the
+  // frontier each of them persists covers the transactions handed over to the others as well.
   log_serializer_task_->Process();
+  for (auto &partition : partitions_) partition->log_serializer_task_->Process();
+
+  FlushDiskLogConsumerTask();
+  for (auto &partition : partitions_) partition->FlushDiskLogConsumerTask();
+}
+
+void LogManager::FlushDiskLogConsumerTask() {
   // Signal the disk log consumer task thread to persist the buffers to disk
   std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
   disk_log_writer_task_->force_flush_ = true;
@@ -42,18 +55,54 @@ void LogManager::ForceFlush() {
   disk_log_writer_task_->persist_cv_.wait(lock, [&] { return !disk_log_writer_task_->force_flush_; });
 }
 
+void LogManager::RotateLogFile() {
+  // Serialize what transactions handed over so far, so that it goes into the sealed segment
+  log_serializer_task_->Process();
+  {
+    // Sealing the log file right after the last batch handed over keeps every record within a single segment. No more
+    // batches are handed over until the disk log consumer task knows where to seal. The serializer may wait on the
+    // disk log consumer task for an empty buffer, so the latch is taken before the persist lock.
+    common::SpinLatch::ScopedSpinLatch serialization_guard(&log_serializer_task_->serialization_latch_);
+    std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
+    disk_log_writer_task_->rotate_after_batches_ = log_serializer_task_->num_batches_handed_;
+    disk_log_writer_task_->rotate_log_file_ = true;
+  }
+  disk_log_writer_task_->disk_log_writer_thread_cv_.notify_one();
+
+  std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
+
+  // Wait for the disk log consumer task thread to seal the log file
+  disk_log_writer_task_->persist_cv_.wait(lock, [&] { return !disk_log_writer_task_->rotate_log_file_; });
+  lock.unlock();
+
+  for (auto &partition : partitions_) partition->RotateLogFile();
+}
+
 void LogManager::PersistAndStop() {
   NOISEPAGE_ASSERT(run_log_manager_, "Can't call PersistAndStop on an un-started LogManager");
-  run_log_manager_ = false;
 
   // Signal all tasks to stop. The shutdown of the tasks will trigger any remaining logs to be serialized, writen to the
   // log file, and persisted. The order in which we shut down the tasks is important, we must first serialize, then
-  // shutdown the disk consumer task (reverse order of Start())
+  // shutdown the disk consumer task (reverse order of Start()). Every partition serializes what it was handed before
+  // any of them stops persisting, so that the last frontiers they persist cover every transaction.
+  StopLogSerializerTask();
+  for (auto &partition : partitions_) partition->StopLogSerializerTask();
+  StopDiskLogConsumerTask();
+  for (auto &partition : partitions_) partition->StopDiskLogConsumerTask();
+}
+
+void LogManager::StopLogSerializerTask() {
+  run_log_manager_ = false;
   auto result UNUSED_ATTRIBUTE =
       thread_registry_->StopTask(this, log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
   NOISEPAGE_ASSERT(result, "LogSerializerTask should have been stopped");
+}
 
-  result = thread_registry_->StopTask(this, disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+void LogManager::StopDiskLogConsumerTask() {
+  // The durable watermark must not wake up the task once it is gone
+  if (watermark_ != nullptr) watermark_->SetConsumer(partition_, nullptr);
+  auto result UNUSED_ATTRIBUTE =
+      thread_registry_->StopTask(this, disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
   NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
   NOISEPAGE_ASSERT(filled_buffer_queue_.Empty(), "disk log consumer task should have processed all filled buffers\n");
 
@@ -70,15 +119,46 @@ void LogManager::PersistAndStop() {
 void LogManager::AddBufferToFlushQueue(RecordBufferSegment *const buffer_segment,
                                        const transaction::TransactionPolicy &policy) {
   NOISEPAGE_ASSERT(run_log_manager_, "Must call Start on log manager before handing it buffers");
-  log_serializer_task_->AddBufferToFlushQueue(buffer_segment, policy);
+  const uint32_t partition = partitions_.empty() ? 0 : PartitionOf(buffer_segment);
+  if (partition == 0) {
+    log_serializer_task_->AddBufferToFlushQueue(buffer_segment, policy);
+  } else {
+    partitions_[partition - 1]->AddBufferToFlushQueue(buffer_segment, policy);
+  }
+}
+
+uint32_t LogManager::PartitionOf(RecordBufferSegment *const buffer_segment) const {
+  // All of the records in a buffer belong to the same transaction, so the first one tells which transaction it is
+  IterableBufferSegment<LogRecord> records(buffer_segment);
+  const auto first = records.begin();
+  if (first == records.end()) return 0;
+  return static_cast<uint32_t>(first->TxnBegin().UnderlyingValue() % GetNumPartitions());
+}
+
+void LogManager::SetTimestampManager(const common::ManagedPointer<transaction::TimestampManager> timestamp_manager) {
+  NOISEPAGE_ASSERT(durable_watermark_ != nullptr, "Only a partitioned WAL learns its frontiers from commits");
+  durable_watermark_->SetTimestampManager(timestamp_manager);
 }
 
 void LogManager::SetSerializationInterval(int32_t interval) {
   NOISEPAGE_ASSERT(interval > 0, "Log serialization interval should be greater than 0");
   serialization_interval_ = std::chrono::microseconds(interval);
   if (log_serializer_task_ != nullptr) log_serializer_task_->SetSerializationInterval(interval);
+  for (auto &partition : partitions_) partition->SetSerializationInterval(interval);
 }
 
 void LogManager::EndReplication() { log_serializer_task_->EndReplication(); }
 
+uint64_t LogManager::TestGetNumCommitBatches() {
+  uint64_t num_commit_batches = disk_log_writer_task_->num_commit_batches_;
+  for (auto &partition : partitions_) num_commit_batches += partition->TestGetNumCommitBatches();
+  return num_commit_batches;
+}
+
+uint64_t LogManager::TestGetNumCommitsPersisted() {
+  uint64_t num_commits = disk_log_writer_task_->num_commits_persisted_;
+  for (auto &partition : partitions_) num_commits += partition->TestGetNumCommitsPersisted();
+  return num_commits;
+}
+
 }  // namespace noisepage::storage
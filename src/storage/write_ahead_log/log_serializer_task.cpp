@@ -186,6 +186,8 @@ void LogSerializerTask::HandFilledBufferToWriter() {
 
   // If the buffer exists, mark the buffer as ready for serialization.
   if (filled_buffer_ != nullptr) {
+    // Compress the buffer once here, so that both the log file and the replicas receive the compressed block
+    if (compressor_ != nullptr) filled_buffer_->CompressBuffer(*compressor_, compression_buffer_.get());
     // Prepare the buffer for serialization. This initializes a reference count on the batch of logs within.
     filled_buffer_->PrepareForSerialization(txn_policy);
   }
@@ -199,6 +201,7 @@ void LogSerializerTask::HandFilledBufferToWriter() {
   }
   // Hand over the filled buffer
   filled_buffer_queue_->Enqueue(std::make_pair(filled_buffer_, commits_in_buffer_));
+  num_batches_handed_++;
   // Signal disk log consumer task thread that a buffer has been handed over
   disk_log_writer_thread_cv_->notify_one();
   // Mark that the task doesn't have a buffer in its possession to which it can write to
@@ -223,7 +226,7 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
         if (!commit_record->IsReadOnly()) num_bytes += SerializeRecord(record);
         commits_in_buffer_.emplace_back(CommitCallback{commit_record->CommitCallback(),
                                                        commit_record->CommitCallbackArg(), record.TxnBegin(),
-                                                       commit_record->IsReadOnly()});
+                                                       commit_record->CommitTime(), commit_record->IsReadOnly()});
         // Once serialization is done, we notify the txn manager to let GC know this txn is ready to clean up
         serialized_txns_[commit_record->TimestampManager()].push_back(record.TxnBegin());
         num_txns++;
@@ -336,6 +339,10 @@ uint64_t LogSerializerTask::SerializeRecord(const noisepage::storage::LogRecord
       // AbortRecord does not hold any additional metadata
       break;
     }
+    case LogRecordType::WATERMARK:
+      // Watermarks are written by the disk log consumer task, transactions never hand them over
+      NOISEPAGE_ASSERT(false, "Transactions should not log watermarks");
+      break;
   }
 
   return num_bytes;
@@ -0,0 +1,349 @@
+#include "traffic_cop/copy_loader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_accessor.h"
+#include "catalog/index_schema.h"
+#include "catalog/schema.h"
+#include "common/allocator.h"
+#include "common/error/exception.h"
+#include "execution/sql/runtime_types.h"
+#include "fast_float/fast_float.h"
+#include "parser/expression/column_value_expression.h"
+#include "spdlog/fmt/fmt.h"
+#include "storage/block_layout.h"
+#include "storage/index/index.h"
+#include "storage/sql_table.h"
+#include "storage/storage_util.h"
+#include "storage/write_ahead_log/log_record.h"
+#include "transaction/transaction_context.h"
+
+namespace noisepage::trafficcop {
+
+namespace {
+
+using CSVCell = execution::util::CSVReader::CSVCell;
+
+std::vector<catalog::col_oid_t> AllColumnOids(const catalog::Schema &schema) {
+  std::vector<catalog::col_oid_t> col_oids;
+  col_oids.reserve(schema.GetColumns().size());
+  for (const auto &column : schema.GetColumns()) col_oids.emplace_back(column.Oid());
+  return col_oids;
+}
+
+/** @return the unescaped contents of the cell, only copied if the cell contains escape characters */
+std::string_view CellContents(const CSVCell &cell, std::string *unescaped) {
+  if (!cell.escaped_) return {cell.ptr_, cell.len_};
+  *unescaped = cell.AsString();
+  return *unescaped;
+}
+
+/** @return the cell parsed as an integer in [min, max] */
+int64_t ParseInteger(const CSVCell &cell, const int64_t min, const int64_t max, const std::string &column) {
+  const std::string_view contents(cell.ptr_, cell.len_);
+  const auto invalid = [&] {
+    return EXECUTION_EXCEPTION(
+        fmt::format("invalid input syntax for integer: \"{}\" in column \"{}\"", contents, column),
+        common::ErrorCode::ERRCODE_INVALID_TEXT_REPRESENTATION);
+  };
+  const auto out_of_range = [&] {
+    return EXECUTION_EXCEPTION(fmt::format("value \"{}\" is out of range for column \"{}\"", contents, column),
+                               common::ErrorCode::ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE);
+  };
+
+  const char *p = cell.ptr_, *end = cell.ptr_ + cell.len_;
+  const bool negative = p != end && *p == '-';
+  if (p != end && (*p == '-' || *p == '+')) p++;
+  if (p == end) throw invalid();
+
+  // Accumulate negatively, so that the smallest value does not overflow
+  int64_t value = 0;
+  for (; p != end; p++) {
+    if (*p < '0' || *p > '9') throw invalid();
+    if (__builtin_mul_overflow(value, 10, &value) || __builtin_sub_overflow(value, *p - '0', &value)) {
+      throw out_of_range();
+    }
+  }
+  if (!negative) {
+    if (value == std::numeric_limits<int64_t>::min()) throw out_of_range();
+    value = -value;
+  }
+  if (value < min || value > max) throw out_of_range();
+  return value;
+}
+
+/** @return the cell parsed as a boolean, accepting the same spellings as Postgres */
+bool ParseBoolean(const CSVCell &cell, const std::string &column) {
+  std::string value(cell.ptr_, cell.len_);
+  std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+  if (value == "t" || value == "true" || value == "y" || value == "yes" || value == "on" || value == "1") return true;
+  if (value == "f" || value == "false" || value == "n" || value == "no" || value == "off" || value == "0") return false;
+  throw EXECUTION_EXCEPTION(fmt::format("invalid input syntax for type boolean: \"{}\" in column \"{}\"",
+                                        std::string_view(cell.ptr_, cell.len_), column),
+                            common::ErrorCode::ERRCODE_INVALID_TEXT_REPRESENTATION);
+}
+
+}  // namespace
+
+CopyLoader::CopyLoader(const common::ManagedPointer<transaction::TransactionContext> txn,
+                       const common::ManagedPointer<catalog::CatalogAccessor> accessor, const catalog::db_oid_t db_oid,
+                       const catalog::table_oid_t table_oid, const char delimiter, const char quote, const char escape)
+    : txn_(txn),
+      db_oid_(db_oid),
+      table_oid_(table_oid),
+      table_(accessor->GetTable(table_oid)),
+      row_initializer_(table_->InitializerForProjectedRow(AllColumnOids(accessor->GetSchema(table_oid)))),
+      stream_(new execution::util::CSVStream()),
+      reader_(std::unique_ptr<execution::util::CSVSource>(stream_), delimiter, quote, escape) {
+  const auto &schema = accessor->GetSchema(table_oid);
+  auto projection_map = table_->ProjectionMapForOids(AllColumnOids(schema));
+
+  for (const auto &column : schema.GetColumns()) {
+    columns_.push_back({column.Name(), column.Type(), column.Nullable(), projection_map.at(column.Oid())});
+  }
+
+  // Index keys are copied from the table's ProjectedRow, so they can only be column references
+  uint32_t max_key_size = 0;
+  for (const auto &[index, index_schema] : accessor->GetIndexes(table_oid)) {
+    const auto &key_offsets = index->GetKeyOidToOffsetMap();
+    CopyIndex copy_index{index, index_schema.Unique(), {}, {}};
+    for (const auto &key : index_schema.GetColumns()) {
+      NOISEPAGE_ASSERT(key.StoredExpression()->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE,
+                       "SupportsIndexes() should have been checked before loading the table.");
+      const auto col_oid =
+          key.StoredExpression().CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid();
+      copy_index.key_offsets_.emplace_back(projection_map.at(col_oid), key_offsets.at(key.Oid()));
+      copy_index.key_sizes_.emplace_back(storage::AttrSizeBytes(key.AttributeLength()));
+    }
+    max_key_size = std::max(max_key_size, index->GetProjectedRowInitializer().ProjectedRowSize());
+    indexes_.emplace_back(std::move(copy_index));
+  }
+  if (!indexes_.empty()) key_buffer_ = common::AllocationUtil::AllocateAligned(max_key_size);
+
+  // The rows of a batch are laid out back to back, each aligned for its ProjectedRow
+  const auto row_size = storage::StorageUtil::PadUpToSize(sizeof(uint64_t), row_initializer_.ProjectedRowSize());
+  batch_buffer_ = common::AllocationUtil::AllocateAligned(static_cast<uint64_t>(row_size) * BATCH_SIZE);
+  batch_.reserve(BATCH_SIZE);
+  for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+    batch_.emplace_back(reinterpret_cast<storage::ProjectedRow *>(batch_buffer_ + static_cast<uint64_t>(i) * row_size));
+  }
+  batch_slots_.resize(BATCH_SIZE);
+
+  reader_.Initialize();
+}
+
+CopyLoader::~CopyLoader() {
+  ReleaseBatch();
+  delete[] batch_buffer_;
+  delete[] key_buffer_;
+}
+
+bool CopyLoader::SupportsIndexes(const common::ManagedPointer<catalog::CatalogAccessor> accessor,
+                                 const catalog::table_oid_t table_oid) {
+  for (const auto &index : accessor->GetIndexes(table_oid)) {
+    for (const auto &key : index.second.GetColumns()) {
+      if (key.StoredExpression()->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) return false;
+    }
+  }
+  return true;
+}
+
+TrafficCopResult CopyLoader::Append(const std::string_view data) {
+  try {
+    stream_->Append(data.data(), data.size());
+    LoadRows();
+  } catch (ExecutionException &e) {
+    ReleaseBatch();
+    return {ResultType::ERROR, common::ErrorData(common::ErrorSeverity::ERROR, e.what(), e.code_)};
+  }
+  return {ResultType::COMPLETE, num_rows_loaded_};
+}
+
+TrafficCopResult CopyLoader::Finish() {
+  try {
+    stream_->Finish();
+    LoadRows();
+    if (stream_->GetSize() > 0) {
+      throw EXECUTION_EXCEPTION(fmt::format("unterminated CSV quoted field after line {}", reader_.GetRecordNumber()),
+                                common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+    }
+    FlushBatch();
+  } catch (ExecutionException &e) {
+    ReleaseBatch();
+    return {ResultType::ERROR, common::ErrorData(common::ErrorSeverity::ERROR, e.what(), e.code_)};
+  }
+  return {ResultType::COMPLETE, num_rows_loaded_};
+}
+
+void CopyLoader::LoadRows() {
+  while (reader_.Advance()) {
+    const auto *row = reader_.GetRow();
+    // Empty lines are skipped, and so is the end-of-data marker. A quoted
+    // cell is data, even if it is empty or looks like the marker.
+    const auto &first = row->cells_[0];
+    if (row->count_ == 1 && !first.quoted_ && (first.IsEmpty() || std::string_view(first.ptr_, first.len_) == "\\.")) {
+      continue;
+    }
+    ParseRow();
+    if (batch_size_ == BATCH_SIZE) FlushBatch();
+  }
+}
+
+void CopyLoader::ParseRow() {
+  const auto *row = reader_.GetRow();
+  if (row->count_ != columns_.size()) {
+    throw EXECUTION_EXCEPTION(fmt::format("line {}: expected {} columns, found {}", reader_.GetRecordNumber(),
+                                          columns_.size(), row->count_),
+                              common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+  }
+
+  // The row is counted in the batch before it is filled, so that its varlens are released if a later cell is invalid
+  auto *const pr = row_initializer_.InitializeRow(batch_[batch_size_++]);
+  try {
+    for (uint32_t i = 0; i < columns_.size(); i++) SetAttribute(pr, columns_[i], row->cells_[i]);
+  } catch (ExecutionException &e) {
+    throw EXECUTION_EXCEPTION(fmt::format("line {}: {}", reader_.GetRecordNumber(), e.what()), e.code_);
+  }
+}
+
+void CopyLoader::SetAttribute(storage::ProjectedRow *const row, const CopyColumn &column, const CSVCell &cell) {
+  // Only an unquoted empty cell is NULL, a quoted one is the empty string
+  if (cell.IsNull()) {
+    if (!column.nullable_) {
+      throw EXECUTION_EXCEPTION(fmt::format("null value in column \"{}\" violates not-null constraint", column.name_),
+                                common::ErrorCode::ERRCODE_NOT_NULL_VIOLATION);
+    }
+    row->SetNull(column.offset_);
+    return;
+  }
+
+  auto *const value = row->AccessForceNotNull(column.offset_);
+  switch (column.type_) {
+    case execution::sql::SqlTypeId::Boolean:
+      *reinterpret_cast<bool *>(value) = ParseBoolean(cell, column.name_);
+      break;
+    case execution::sql::SqlTypeId::TinyInt:
+      *reinterpret_cast<int8_t *>(value) = static_cast<int8_t>(ParseInteger(
+          cell, std::numeric_limits<int8_t>::min(), std::numeric_limits<int8_t>::max(), column.name_));
+      break;
+    case execution::sql::SqlTypeId::SmallInt:
+      *reinterpret_cast<int16_t *>(value) = static_cast<int16_t>(ParseInteger(
+          cell, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max(), column.name_));
+      break;
+    case execution::sql::SqlTypeId::Integer:
+      *reinterpret_cast<int32_t *>(value) = static_cast<int32_t>(ParseInteger(
+          cell, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(), column.name_));
+      break;
+    case execution::sql::SqlTypeId::BigInt:
+      *reinterpret_cast<int64_t *>(value) = ParseInteger(cell, std::numeric_limits<int64_t>::min(),
+                                                         std::numeric_limits<int64_t>::max(), column.name_);
+      break;
+    case execution::sql::SqlTypeId::Double: {
+      double result = 0;
+      const auto [ptr, ec] = fast_float::from_chars(cell.ptr_, cell.ptr_ + cell.len_, result);
+      if (ec != std::errc() || ptr != cell.ptr_ + cell.len_) {
+        throw EXECUTION_EXCEPTION(fmt::format("invalid input syntax for type double: \"{}\" in column \"{}\"",
+                                              std::string_view(cell.ptr_, cell.len_), column.name_),
+                                  common::ErrorCode::ERRCODE_INVALID_TEXT_REPRESENTATION);
+      }
+      *reinterpret_cast<double *>(value) = result;
+      break;
+    }
+    case execution::sql::SqlTypeId::Date:
+    case execution::sql::SqlTypeId::Timestamp: {
+      std::string unescaped;
+      const auto contents = CellContents(cell, &unescaped);
+      try {
+        if (column.type_ == execution::sql::SqlTypeId::Date) {
+          *reinterpret_cast<uint32_t *>(value) = execution::sql::Date::FromString(contents).ToNative();
+        } else {
+          *reinterpret_cast<uint64_t *>(value) = execution::sql::Timestamp::FromString(contents).ToNative();
+        }
+      } catch (ConversionException &e) {
+        throw EXECUTION_EXCEPTION(fmt::format("{} in column \"{}\"", e.what(), column.name_),
+                                  common::ErrorCode::ERRCODE_INVALID_DATETIME_FORMAT);
+      }
+      break;
+    }
+    case execution::sql::SqlTypeId::Varchar:
+    case execution::sql::SqlTypeId::Varbinary: {
+      std::string unescaped;
+      const auto contents = CellContents(cell, &unescaped);
+      const auto size = static_cast<uint32_t>(contents.size());
+      if (size <= storage::VarlenEntry::InlineThreshold()) {
+        *reinterpret_cast<storage::VarlenEntry *>(value) =
+            storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(contents.data()), size);
+      } else {
+        // The table takes ownership of the contents once the row is inserted
+        byte *const contents_copy = common::AllocationUtil::AllocateAligned(size);
+        std::memcpy(contents_copy, contents.data(), size);
+        *reinterpret_cast<storage::VarlenEntry *>(value) = storage::VarlenEntry::Create(contents_copy, size, true);
+      }
+      break;
+    }
+    default:
+      // Mark the attribute NULL again so that ReleaseBatch does not interpret it
+      row->SetNull(column.offset_);
+      throw EXECUTION_EXCEPTION(fmt::format("COPY does not support the type of column \"{}\"", column.name_),
+                                common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+  }
+}
+
+void CopyLoader::FlushBatch() {
+  // Insert the whole batch into the table first. StageWrite may reuse the buffer of the previous redo record, which is
+  // why the rows are parsed into the loader's own buffer and copied into their redo records here.
+  const auto num_rows = batch_size_;
+  for (uint32_t i = 0; i < num_rows; i++) {
+    auto *const redo = txn_->StageWrite(db_oid_, table_oid_, row_initializer_);
+    std::memcpy(redo->Delta(), batch_[i], row_initializer_.ProjectedRowSize());
+    batch_slots_[i] = table_->Insert(txn_, redo);
+  }
+  // The varlens of the batch are owned by the table now
+  batch_size_ = 0;
+
+  // Then maintain one index at a time, which keeps each index's working set hot in the cache
+  for (const auto &index : indexes_) {
+    auto *const key = index.index_->GetProjectedRowInitializer().InitializeRow(key_buffer_);
+    for (uint32_t i = 0; i < num_rows; i++) {
+      const auto *const row = batch_[i];
+      for (uint32_t k = 0; k < index.key_offsets_.size(); k++) {
+        const auto [row_offset, key_offset] = index.key_offsets_[k];
+        if (row->IsNull(row_offset)) {
+          key->SetNull(key_offset);
+        } else {
+          std::memcpy(key->AccessForceNotNull(key_offset), row->AccessWithNullCheck(row_offset), index.key_sizes_[k]);
+        }
+      }
+      const bool inserted = index.unique_ ? index.index_->InsertUnique(txn_, *key, batch_slots_[i])
+                                          : index.index_->Insert(txn_, *key, batch_slots_[i]);
+      if (!inserted) {
+        throw EXECUTION_EXCEPTION("duplicate key value violates unique constraint",
+                                  common::ErrorCode::ERRCODE_UNIQUE_VIOLATION);
+      }
+    }
+  }
+
+  num_rows_loaded_ += num_rows;
+}
+
+void CopyLoader::ReleaseBatch() {
+  for (uint32_t i = 0; i < batch_size_; i++) {
+    for (const auto &column : columns_) {
+      if (column.type_ != execution::sql::SqlTypeId::Varchar && column.type_ != execution::sql::SqlTypeId::Varbinary) {
+        continue;
+      }
+      const auto *const varlen =
+          reinterpret_cast<const storage::VarlenEntry *>(batch_[i]->AccessWithNullCheck(column.offset_));
+      if (varlen != nullptr && varlen->NeedReclaim()) delete[] varlen->Content();
+    }
+  }
+  batch_size_ = 0;
+}
+
+}  // namespace noisepage::trafficcop
@@ -10,6 +10,8 @@
 #include "binder/binder_util.h"
 #include "catalog/catalog.h"
 #include "catalog/catalog_accessor.h"
+#include "common/allocator.h"
+#include "common/constants.h"
 #include "common/error/error_data.h"
 #include "common/error/exception.h"
 #include "common/thread_context.h"
@@ -25,8 +27,9 @@
 #include "network/postgres/portal.h"
 #include "network/postgres/postgres_packet_writer.h"
 #include "network/postgres/statement.h"
-#include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/cost_model/cost_model_util.h"
 #include "optimizer/statistics/stats_storage.h"
+#include "parser/copy_statement.h"
 #include "parser/drop_statement.h"
 #include "parser/explain_statement.h"
 #include "parser/expression/constant_value_expression.h"
@@ -45,7 +48,10 @@
 #include "planner/plannodes/drop_table_plan_node.h"
 #include "settings/settings_manager.h"
 #include "settings/settings_param.h"
+#include "spdlog/fmt/fmt.h"
 #include "storage/recovery/replication_log_provider.h"
+#include "storage/sql_table.h"
+#include "traffic_cop/copy_loader.h"
 #include "traffic_cop/traffic_cop_defs.h"
 #include "traffic_cop/traffic_cop_util.h"
 #include "transaction/transaction_manager.h"
@@ -102,6 +108,89 @@ static void CommitCallback(void *const callback_arg) {
   }
 }
 
+/**
+ * Look up the table of a COPY statement, in the same way as the binder looks up a table reference.
+ * @return the table, or the error if it does not exist
+ */
+static std::variant<catalog::table_oid_t, common::ErrorData> ResolveCopyTable(
+    const common::ManagedPointer<catalog::CatalogAccessor> accessor,
+    const common::ManagedPointer<parser::TableRef> table_ref) {
+  const auto &namespace_name = table_ref->GetNamespaceName();
+  catalog::table_oid_t table_oid;
+  if (!namespace_name.empty()) {
+    const auto namespace_oid = accessor->GetNamespaceOid(namespace_name);
+    if (namespace_oid == catalog::INVALID_NAMESPACE_OID) {
+      return common::ErrorData(common::ErrorSeverity::ERROR,
+                               fmt::format("Unknown namespace name \"{}\"", namespace_name),
+                               common::ErrorCode::ERRCODE_UNDEFINED_SCHEMA);
+    }
+    table_oid = accessor->GetTableOid(namespace_oid, table_ref->GetTableName());
+  } else {
+    table_oid = accessor->GetTableOid(table_ref->GetTableName());
+  }
+  if (table_oid == catalog::INVALID_TABLE_OID) {
+    return common::ErrorData(common::ErrorSeverity::ERROR,
+                             fmt::format("relation \"{}\" does not exist", table_ref->GetTableName()),
+                             common::ErrorCode::ERRCODE_UNDEFINED_TABLE);
+  }
+  return table_oid;
+}
+
+/**
+ * Append a value to a row in CSV format. Strings are quoted if they contain a special character, if they are empty,
+ * which tells them apart from NULL, or if they would be read back as the end-of-data marker.
+ */
+static void AppendCopyValue(std::string *const line, const byte *const value, const execution::sql::SqlTypeId type,
+                            const char delimiter, const char quote, const char escape) {
+  switch (type) {
+    case execution::sql::SqlTypeId::Boolean:
+      line->append(*reinterpret_cast<const bool *>(value) ? "t" : "f");
+      break;
+    case execution::sql::SqlTypeId::TinyInt:
+      line->append(std::to_string(*reinterpret_cast<const int8_t *>(value)));
+      break;
+    case execution::sql::SqlTypeId::SmallInt:
+      line->append(std::to_string(*reinterpret_cast<const int16_t *>(value)));
+      break;
+    case execution::sql::SqlTypeId::Integer:
+      line->append(std::to_string(*reinterpret_cast<const int32_t *>(value)));
+      break;
+    case execution::sql::SqlTypeId::BigInt:
+      line->append(std::to_string(*reinterpret_cast<const int64_t *>(value)));
+      break;
+    case execution::sql::SqlTypeId::Double:
+      line->append(fmt::to_string(*reinterpret_cast<const double *>(value)));
+      break;
+    case execution::sql::SqlTypeId::Date:
+      line->append(execution::sql::Date::FromNative(*reinterpret_cast<const execution::sql::Date::NativeType *>(value))
+                       .ToString());
+      break;
+    case execution::sql::SqlTypeId::Timestamp:
+      line->append(execution::sql::Timestamp::FromNative(
+                       *reinterpret_cast<const execution::sql::Timestamp::NativeType *>(value))
+                       .ToString());
+      break;
+    case execution::sql::SqlTypeId::Varchar:
+    case execution::sql::SqlTypeId::Varbinary: {
+      const auto str = reinterpret_cast<const storage::VarlenEntry *>(value)->StringView();
+      const char special[] = {delimiter, quote, escape, '\r', '\n'};
+      if (!str.empty() && str != "\\." && str.find_first_of(special, 0, sizeof(special)) == std::string_view::npos) {
+        line->append(str);
+        break;
+      }
+      line->push_back(quote);
+      for (const char c : str) {
+        if (c == quote || c == escape) line->push_back(escape);
+        line->push_back(c);
+      }
+      line->push_back(quote);
+      break;
+    }
+    default:
+      UNREACHABLE("Unsupported types are rejected before the table is scanned.");
+  }
+}
+
 void TrafficCop::BeginTransaction(const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
   NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::IDLE,
                    "Invalid ConnectionContext state, already in a transaction.");
@@ -191,7 +280,9 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCop::OptimizeBoundQuery(
 
   return TrafficCopUtil::Optimize(connection_ctx->Transaction(), connection_ctx->Accessor(), query,
                                   connection_ctx->GetDatabaseOid(), stats_storage_,
-                                  std::make_unique<optimizer::TrivialCostModel>(), optimizer_timeout_, parameters);
+                                  optimizer::CostModelUtil::CreateCostModel(cost_model_type_), optimizer_timeout_,
+                                  parameters, join_enumeration_threshold_,
+                                  common::ManagedPointer(optimizer_workers_));
 }
 
 TrafficCopResult TrafficCop::ExecuteSetStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
@@ -248,6 +339,112 @@ TrafficCopResult TrafficCop::ExecuteShowStatement(common::ManagedPointer<network
   return {ResultType::COMPLETE, 0u};
 }
 
+std::variant<std::unique_ptr<CopyLoader>, common::ErrorData> TrafficCop::BeginCopyFrom(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<parser::CopyStatement> copy_stmt) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  NOISEPAGE_ASSERT(copy_stmt->IsFrom() && copy_stmt->GetCopyTable() != nullptr,
+                   "BeginCopyFrom called with invalid COPY.");
+
+  const auto accessor = connection_ctx->Accessor();
+  auto resolved = ResolveCopyTable(accessor, copy_stmt->GetCopyTable());
+  if (std::holds_alternative<common::ErrorData>(resolved)) return std::move(std::get<common::ErrorData>(resolved));
+  const auto table_oid = std::get<catalog::table_oid_t>(resolved);
+
+  if (!CopyLoader::SupportsIndexes(accessor, table_oid)) {
+    return common::ErrorData(common::ErrorSeverity::ERROR, "COPY FROM into tables with expression indexes",
+                             common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+  }
+
+  return std::make_unique<CopyLoader>(connection_ctx->Transaction(), accessor, connection_ctx->GetDatabaseOid(),
+                                      table_oid, copy_stmt->GetDelimiter(), copy_stmt->GetQuoteChar(),
+                                      copy_stmt->GetEscapeChar());
+}
+
+TrafficCopResult TrafficCop::ExecuteCopyToStatement(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<network::PostgresPacketWriter> out,
+    const common::ManagedPointer<parser::CopyStatement> copy_stmt) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  NOISEPAGE_ASSERT(!copy_stmt->IsFrom() && copy_stmt->GetCopyTable() != nullptr,
+                   "ExecuteCopyToStatement called with invalid COPY.");
+
+  const auto accessor = connection_ctx->Accessor();
+  auto resolved = ResolveCopyTable(accessor, copy_stmt->GetCopyTable());
+  if (std::holds_alternative<common::ErrorData>(resolved)) {
+    return {ResultType::ERROR, std::move(std::get<common::ErrorData>(resolved))};
+  }
+  const auto table_oid = std::get<catalog::table_oid_t>(resolved);
+  const auto &schema = accessor->GetSchema(table_oid);
+  const auto table = accessor->GetTable(table_oid);
+
+  std::vector<catalog::col_oid_t> col_oids;
+  std::vector<execution::sql::SqlTypeId> col_types;
+  for (const auto &column : schema.GetColumns()) {
+    switch (column.Type()) {
+      case execution::sql::SqlTypeId::Boolean:
+      case execution::sql::SqlTypeId::TinyInt:
+      case execution::sql::SqlTypeId::SmallInt:
+      case execution::sql::SqlTypeId::Integer:
+      case execution::sql::SqlTypeId::BigInt:
+      case execution::sql::SqlTypeId::Double:
+      case execution::sql::SqlTypeId::Date:
+      case execution::sql::SqlTypeId::Timestamp:
+      case execution::sql::SqlTypeId::Varchar:
+      case execution::sql::SqlTypeId::Varbinary:
+        break;
+      default:
+        return {ResultType::ERROR,
+                common::ErrorData(common::ErrorSeverity::ERROR,
+                                  fmt::format("COPY TO of column \"{}\" of this type", column.Name()),
+                                  common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED)};
+    }
+    col_oids.emplace_back(column.Oid());
+    col_types.emplace_back(column.Type());
+  }
+
+  // The projection may reorder the columns, the rows are written in schema order
+  auto pci = table->InitializerForProjectedColumns(col_oids, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  auto pm = table->ProjectionMapForOids(col_oids);
+  std::vector<uint16_t> col_offsets;
+  col_offsets.reserve(col_oids.size());
+  for (const auto col_oid : col_oids) col_offsets.emplace_back(pm.at(col_oid));
+
+  byte *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+  auto pc = pci.Initialize(buffer);
+
+  const char delimiter = copy_stmt->GetDelimiter();
+  const char quote = copy_stmt->GetQuoteChar();
+  const char escape = copy_stmt->GetEscapeChar();
+
+  out->WriteCopyOutResponse(static_cast<uint16_t>(col_oids.size()));
+  uint32_t num_rows = 0;
+  std::string line;
+  auto it = table->begin();
+  while (it != table->end()) {
+    table->Scan(connection_ctx->Transaction(), &it, pc);
+    for (uint32_t i = 0; i < pc->NumTuples(); i++) {
+      const auto row = pc->InterpretAsRow(i);
+      line.clear();
+      for (uint16_t col = 0; col < col_offsets.size(); col++) {
+        if (col > 0) line.push_back(delimiter);
+        // NULL is an empty cell
+        const byte *const value = row.AccessWithNullCheck(col_offsets[col]);
+        if (value != nullptr) AppendCopyValue(&line, value, col_types[col], delimiter, quote, escape);
+      }
+      line.push_back('\n');
+      out->WriteCopyData(line);
+    }
+    num_rows += pc->NumTuples();
+  }
+  out->WriteCopyDone();
+
+  delete[] buffer;
+  return {ResultType::COMPLETE, num_rows};
+}
+
 TrafficCopResult TrafficCop::ExecuteCreateStatement(
     const common::ManagedPointer<network::ConnectionContext> connection_ctx,
     const common::ManagedPointer<planner::AbstractPlanNode> physical_plan,
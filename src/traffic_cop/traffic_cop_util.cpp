@@ -27,7 +27,9 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
     const common::ManagedPointer<parser::ParseResult> query, const catalog::db_oid_t db_oid,
     common::ManagedPointer<optimizer::StatsStorage> stats_storage,
     std::unique_ptr<optimizer::AbstractCostModel> cost_model, const uint64_t optimizer_timeout,
-    common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) {
+    common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters,
+    const uint32_t join_enumeration_threshold,
+    const common::ManagedPointer<common::WorkerPool> optimizer_workers) {
   // Optimizer transforms annotated ParseResult to logical expressions (ephemeral Optimizer structure)
   optimizer::QueryToOperatorTransformer transformer(accessor, db_oid);
   auto query_statement = query->GetStatement(0);
@@ -42,7 +44,8 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
   auto logical_exprs = transformer.ConvertToOpExpression(query_statement, query);
 
   // TODO(Matt): is the cost model to use going to become an arg to this function eventually?
-  optimizer::Optimizer optimizer(std::move(cost_model), optimizer_timeout);
+  optimizer::Optimizer optimizer(std::move(cost_model), optimizer_timeout, join_enumeration_threshold,
+                                 optimizer_workers);
   optimizer::PropertySet property_set;
   std::vector<common::ManagedPointer<parser::AbstractExpression>> output;
 
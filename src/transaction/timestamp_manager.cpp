@@ -6,28 +6,81 @@
 namespace noisepage::transaction {
 
 timestamp_t TimestampManager::OldestTransactionStartTime() {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const auto &oldest_txn = std::min_element(curr_running_txns_.cbegin(), curr_running_txns_.cend());
-  timestamp_t result = (oldest_txn != curr_running_txns_.end()) ? *oldest_txn : time_.load();
+  // Every transaction that begins after this read gets a newer timestamp than the result, so it can be ignored
+  timestamp_t result = time_.load();
+  // Any begin still holding a begin latch once we get it has a timestamp no older than the one read above.
+  WaitForBeginningTransactions();
+  for (auto &shard : shards_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.running_txns_latch_);
+    const auto &oldest_txn = std::min_element(shard.running_txns_.cbegin(), shard.running_txns_.cend());
+    if (oldest_txn != shard.running_txns_.cend()) result = std::min(result, *oldest_txn);
+  }
   cached_oldest_txn_start_time_.store(result);  // Cache the timestamp
   return result;
 }
 
 timestamp_t TimestampManager::CachedOldestTransactionStartTime() { return cached_oldest_txn_start_time_.load(); }
 
+timestamp_t TimestampManager::SerializedCommitsBefore() {
+  // Every transaction that commits after this read gets a newer timestamp than the result, so it can be ignored
+  timestamp_t result = time_.load();
+  // Any commit still holding a begin latch once we get it has a timestamp no older than the one read above.
+  WaitForBeginningTransactions();
+  for (auto &shard : shards_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.running_txns_latch_);
+    for (const auto &txn : shard.committing_txns_) result = std::min(result, txn.second);
+  }
+  return result;
+}
+
 void TimestampManager::RemoveTransaction(timestamp_t timestamp) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
+  Shard &shard = TimestampShard(timestamp);
+  common::SpinLatch::ScopedSpinLatch guard(&shard.running_txns_latch_);
+  const size_t ret UNUSED_ATTRIBUTE = shard.running_txns_.erase(timestamp);
   NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+  shard.committing_txns_.erase(timestamp);
 }
 
 bool TimestampManager::RemoveTransactions(const std::vector<noisepage::transaction::timestamp_t> &timestamps) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  for (const auto &timestamp : timestamps) {
-    const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-    NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+  // Group the timestamps by shard, so that each shard is latched once
+  std::vector<timestamp_t> sorted(timestamps);
+  std::sort(sorted.begin(), sorted.end(), [](const timestamp_t a, const timestamp_t b) {
+    return (a.UnderlyingValue() & (NUM_SHARDS - 1)) < (b.UnderlyingValue() & (NUM_SHARDS - 1));
+  });
+  for (auto it = sorted.cbegin(); it != sorted.cend();) {
+    Shard &shard = TimestampShard(*it);
+    common::SpinLatch::ScopedSpinLatch guard(&shard.running_txns_latch_);
+    for (; it != sorted.cend() && &TimestampShard(*it) == &shard; ++it) {
+      const size_t ret UNUSED_ATTRIBUTE = shard.running_txns_.erase(*it);
+      NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+      shard.committing_txns_.erase(*it);
+    }
   }
-  return curr_running_txns_.empty();
+  return NoRunningTransactions();
+}
+
+bool TimestampManager::NoRunningTransactions() {
+  // A begin that has checked out its timestamp but is not in a shard yet is still running. Without waiting for it, the
+  // caller could conclude that every transaction up to a newer timestamp has finished.
+  WaitForBeginningTransactions();
+  for (auto &shard : shards_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.running_txns_latch_);
+    if (!shard.running_txns_.empty()) return false;
+  }
+  return true;
+}
+
+void TimestampManager::WaitForBeginningTransactions() {
+  for (auto &shard : shards_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.begin_latch_);
+  }
+}
+
+uint32_t TimestampManager::ThreadShard() {
+  // Threads are handed begin latches round-robin the first time they begin a transaction
+  static std::atomic<uint32_t> next_shard{0};
+  thread_local const uint32_t shard = next_shard.fetch_add(1) & (NUM_SHARDS - 1);
+  return shard;
 }
 
 }  // namespace noisepage::transaction
@@ -7,8 +7,33 @@
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/log_manager.h"
 
 namespace noisepage::transaction {
+TransactionManager::TransactionManager(const common::ManagedPointer<TimestampManager> timestamp_manager,
+                                       const common::ManagedPointer<DeferredActionManager> deferred_action_manager,
+                                       const common::ManagedPointer<storage::RecordBufferSegmentPool> buffer_pool,
+                                       const bool gc_enabled, const bool wal_async_commit_enable,
+                                       const common::ManagedPointer<storage::LogManager> log_manager)
+    : timestamp_manager_(timestamp_manager),
+      deferred_action_manager_(deferred_action_manager),
+      buffer_pool_(buffer_pool),
+      gc_enabled_(gc_enabled),
+      log_manager_(log_manager) {
+  NOISEPAGE_ASSERT(timestamp_manager_ != DISABLED, "transaction manager cannot function without a timestamp manager");
+  NOISEPAGE_ASSERT(!wal_async_commit_enable || (wal_async_commit_enable && log_manager_ != DISABLED),
+                   "Doesn't make sense to enable async commit without enabling logging.");
+  if (wal_async_commit_enable) {
+    SetDefaultTransactionDurabilityPolicy(transaction::DurabilityPolicy::ASYNC);
+  }
+  if (log_manager_ != DISABLED && log_manager_->GetNumPartitions() > 1) {
+    // A partitioned WAL only acknowledges a commit once every commit before it is durable in all partitions, which it
+    // learns from the commits that are not serialized yet
+    timestamp_manager_->TrackCommits();
+    log_manager_->SetTimestampManager(timestamp_manager_);
+  }
+}
+
 TransactionContext *TransactionManager::BeginTransaction() {
   timestamp_t start_time;
   TransactionContext *result;
@@ -97,7 +122,7 @@ timestamp_t TransactionManager::UpdatingCommitCriticalSection(TransactionContext
   //  the correct version the second time, violating snapshot isolation.
   //  Make sure you solve this problem before you remove this gate for whatever reason.
   common::Gate::ScopedLock gate(&txn_gate_);
-  const timestamp_t commit_time = timestamp_manager_->CheckOutTimestamp();
+  const timestamp_t commit_time = timestamp_manager_->CheckOutCommitTimestamp(txn->StartTime());
 
   // flip all timestamps to be committed
   for (auto &it : txn->undo_buffer_) it.Timestamp().store(commit_time);
@@ -118,7 +143,8 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
       !txn->must_abort_,
       "This txn was marked that it must abort. Set a breakpoint at TransactionContext::MustAbort() to see a "
       "stack trace for when this flag is getting tripped.");
-  result = txn->IsReadOnly() ? timestamp_manager_->CheckOutTimestamp() : UpdatingCommitCriticalSection(txn);
+  result = txn->IsReadOnly() ? timestamp_manager_->CheckOutCommitTimestamp(txn->StartTime())
+                             : UpdatingCommitCriticalSection(txn);
 
   txn->finish_time_.store(result);
 
@@ -160,7 +186,7 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -237,7 +263,7 @@ timestamp_t TransactionManager::Abort(TransactionContext *const txn) {
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -283,7 +309,7 @@ void TransactionManager::GCLastUpdateOnAbort(TransactionContext *const txn) {
 }
 
 TransactionQueue TransactionManager::CompletedTransactionsForGC() {
-  common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+  common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
   return std::move(completed_txns_);
 }
 
@@ -86,12 +86,9 @@ class ObjectPoolTestType {
   std::atomic<uint32_t> user_;
 };
 
-// This test generates random workload and sees if the pool gives out
-// the same pointer to two threads at the same time.
-// NOLINTNEXTLINE
-TEST(ObjectPoolTests, ConcurrentCorrectnessTest) {
-  const uint64_t size_limit = 100;
-  const uint64_t reuse_limit = 100;
+// Generates random workload on a pool with the given limits, and sees if the pool gives out the same pointer to two
+// threads at the same time.
+void RunConcurrentWorkload(const uint64_t size_limit, const uint64_t reuse_limit) {
   common::ObjectPool<ObjectPoolTestType> tested(size_limit, reuse_limit);
   auto workload = [&](uint32_t tid) {
     std::uniform_int_distribution<uint64_t> size_dist(1, reuse_limit);
@@ -128,4 +125,46 @@ TEST(ObjectPoolTests, ConcurrentCorrectnessTest) {
   common::WorkerPool thread_pool(MultiThreadTestUtil::HardwareConcurrency(), {});
   MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, MultiThreadTestUtil::HardwareConcurrency(), workload, 100);
 }
+
+// This test generates random workload and sees if the pool gives out
+// the same pointer to two threads at the same time.
+// NOLINTNEXTLINE
+TEST(ObjectPoolTests, ConcurrentCorrectnessTest) { RunConcurrentWorkload(100, 100); }
+
+// Same as above, but with limits that are large enough for the pool to cache objects in the threads
+// NOLINTNEXTLINE
+TEST(ObjectPoolTests, CachedConcurrentCorrectnessTest) { RunConcurrentWorkload(100000, 100000); }
+
+// Objects that sit in the caches of other threads are handed out once the pool is full, and count against the limits
+// NOLINTNEXTLINE
+TEST(ObjectPoolTests, CachedLimitTest) {
+  const uint64_t size_limit = 100000;
+  common::ObjectPool<uint32_t> tested(size_limit, size_limit);
+
+  // Every thread leaves the objects it used in its cache
+  const uint32_t num_threads = 4;
+  const uint64_t per_thread = 2 * common::ObjectPool<uint32_t>::MAGAZINE_SIZE;
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < num_threads; i++) {
+    threads.emplace_back([&] {
+      std::vector<uint32_t *> ptrs;
+      for (uint64_t j = 0; j < per_thread; j++) ptrs.push_back(tested.Get());
+      for (auto *ptr : ptrs) tested.Release(ptr);
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  // All of the objects are still allocated, and are reused when this thread runs out of room
+  EXPECT_FALSE(tested.SetSizeLimit(num_threads * per_thread - 1));
+  EXPECT_TRUE(tested.SetSizeLimit(num_threads * per_thread));
+  std::unordered_set<uint32_t *> ptrs;
+  for (uint64_t i = 0; i < num_threads * per_thread; i++) ptrs.insert(tested.Get());
+  EXPECT_EQ(ptrs.size(), num_threads * per_thread);
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+
+  // Shrinking the reuse limit frees the objects that are cached beyond it
+  for (auto *ptr : ptrs) tested.Release(ptr);
+  tested.SetReuseLimit(per_thread);
+  EXPECT_TRUE(tested.SetSizeLimit(per_thread));
+}
 }  // namespace noisepage
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/allocator.h"
 #include "execution/ast/ast_dump.h"
 #include "execution/ast/context.h"
 #include "execution/compiler/compilation_context.h"
@@ -33,12 +34,15 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "storage/index/index.h"
+#include "storage/sql_table.h"
 
 namespace noisepage::execution::compiler::test {
 class CompilerTest : public SqlBasedTest {
@@ -819,6 +823,91 @@ TEST_F(CompilerTest, SimpleIndexScanLimitDescendingTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec, exp_vec));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleIndexOnlyScanTest) {
+  // SELECT colA FROM test_1 WHERE colA BETWEEN 495 AND 505 ORDER BY colA, answered from the keys of index_1
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto index_oid = accessor->GetIndexOid(NSOid(), "index_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  auto cola_oid = table_schema.GetColumn("colA").Oid();
+  std::unique_ptr<planner::AbstractPlanNode> index_scan;
+  OutputSchemaHelper index_scan_out{0, &expr_maker};
+  {
+    auto col1 = expr_maker.CVE(cola_oid, execution::sql::SqlTypeId::Integer);
+    index_scan_out.AddOutput("col1", col1);
+    auto schema = index_scan_out.MakeSchema();
+    planner::IndexScanPlanNode::Builder builder;
+    index_scan = builder.SetTableOid(table_oid)
+                     .SetColumnOids({cola_oid})
+                     .SetIndexOid(index_oid)
+                     .AddLoIndexColumn(catalog::indexkeycol_oid_t(1), expr_maker.Constant(495))
+                     .AddHiIndexColumn(catalog::indexkeycol_oid_t(1), expr_maker.Constant(505))
+                     .SetOutputSchema(std::move(schema))
+                     .SetScanType(planner::IndexScanType::AscendingClosed)
+                     .SetScanLimit(0)
+                     .SetScanPredicate(nullptr)
+                     .SetIndexOnly(true)
+                     .Build();
+  }
+  const auto run_scan = [&]() {
+    std::vector<int32_t> col1_vals;
+    RowChecker row_checker = [&col1_vals](const std::vector<sql::Val *> &vals) {
+      auto col1 = static_cast<sql::Integer *>(vals[0]);
+      ASSERT_FALSE(col1->is_null_);
+      col1_vals.emplace_back(col1->val_);
+    };
+    GenericChecker checker(row_checker, []() {});
+    OutputStore store{&checker, index_scan->GetOutputSchema().Get()};
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+    exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+    auto exec_ctx = MakeExecCtx(&callback_fn, index_scan->GetOutputSchema().Get());
+    auto executable = execution::compiler::CompilationContext::Compile(*index_scan, exec_ctx->GetExecutionSettings(),
+                                                                       exec_ctx->GetAccessor());
+    executable->Run(common::ManagedPointer(exec_ctx), MODE);
+    return col1_vals;
+  };
+
+  // Change colA of the tuple with key 500 in the table only, so that the tuple and its index key disagree. Reading
+  // the tuple returns -500, reading the key returns 500.
+  auto sql_table = accessor->GetTable(table_oid);
+  auto index = accessor->GetIndex(index_oid);
+  std::vector<storage::TupleSlot> slots;
+  {
+    const auto &key_initializer = index->GetProjectedRowInitializer();
+    auto *const key_buffer = common::AllocationUtil::AllocateAligned(key_initializer.ProjectedRowSize());
+    auto *const key = key_initializer.InitializeRow(key_buffer);
+    key->Set<int32_t, false>(0, 500, false);
+    index->ScanKey(*test_txn_, *key, &slots);
+    delete[] key_buffer;
+  }
+  ASSERT_EQ(slots.size(), 1);
+  auto *const redo = test_txn_->StageWrite(test_db_oid_, table_oid, sql_table->InitializerForProjectedRow({cola_oid}));
+  redo->Delta()->Set<int32_t, false>(0, -500, false);
+  redo->SetTupleSlot(slots[0]);
+  ASSERT_TRUE(sql_table->Update(common::ManagedPointer(test_txn_), redo));
+
+  // The test transaction still holds the versions of its inserts and of the update, so no block is all-visible and
+  // every result is read from its tuple
+  std::vector<int32_t> expected_tuple_vals{495, 496, 497, 498, 499, -500, 501, 502, 503, 504, 505};
+  EXPECT_EQ(run_scan(), expected_tuple_vals);
+
+  // Mark the blocks all-visible by hand, as the GC would once the versions are gone. The results are now read from
+  // the index keys.
+  for (auto iter = sql_table->begin(); iter != sql_table->end(); iter++) {
+    auto *const block = (*iter).GetBlock();
+    uint64_t mark;
+    if (block->visibility_.BeginMark(&mark)) ASSERT_TRUE(block->visibility_.FinishMark(mark));
+  }
+  std::vector<int32_t> expected_key_vals{495, 496, 497, 498, 499, 500, 501, 502, 503, 504, 505};
+  EXPECT_EQ(run_scan(), expected_key_vals);
+
+  // A write to the block makes the scan read the tuples again
+  slots[0].GetBlock()->visibility_.Clear();
+  EXPECT_EQ(run_scan(), expected_tuple_vals);
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleAggregateTest) {
   // SELECT col2, SUM(col1) FROM test_1 WHERE col1 < 1000 GROUP BY col2;
@@ -1729,6 +1818,118 @@ TEST_F(CompilerTest, MultiWayHashJoinTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec2, exp_vec2));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleMergeJoinTest) {
+  // SELECT t1.colA, t2.col1, t1.colA / 10 FROM
+  //   (SELECT colA, colA / 10 AS k FROM test_1 ORDER BY k) t1 INNER JOIN
+  //   (SELECT col1, col1 / 4 AS k FROM test_2 ORDER BY k) t2 ON t1.k = t2.k
+  // Every left key has 10 duplicates and every right key has 4, so each joined group is a cross product.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
+  auto table_schema1 = accessor->GetSchema(table_oid1);
+  auto table_schema2 = accessor->GetSchema(table_oid2);
+
+  // Scan a table's serial column and sort it on the column divided by the given value.
+  const auto make_sorted_input = [&](catalog::table_oid_t table_oid, catalog::col_oid_t col_oid,
+                                     execution::sql::SqlTypeId col_type, int32_t divisor,
+                                     OutputSchemaHelper *order_by_out) {
+    OutputSchemaHelper seq_scan_out{0, &expr_maker};
+    std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+    {
+      auto col = expr_maker.CVE(col_oid, col_type);
+      seq_scan_out.AddOutput("col", col);
+      planner::SeqScanPlanNode::Builder builder;
+      seq_scan = builder.SetOutputSchema(seq_scan_out.MakeSchema())
+                     .SetColumnOids({col_oid})
+                     .SetScanPredicate(nullptr)
+                     .SetIsForUpdateFlag(false)
+                     .SetTableOid(table_oid)
+                     .Build();
+    }
+    auto col = seq_scan_out.GetOutput("col");
+    auto key = expr_maker.OpDiv(col, expr_maker.Constant(divisor));
+    order_by_out->AddOutput("col", col);
+    order_by_out->AddOutput("key", key);
+    planner::OrderByPlanNode::Builder builder;
+    return builder.SetOutputSchema(order_by_out->MakeSchema())
+        .AddChild(std::move(seq_scan))
+        .AddSortKey(key, optimizer::OrderByOrderingType::ASC)
+        .Build();
+  };
+
+  OutputSchemaHelper order_by_out1{0, &expr_maker};
+  auto order_by1 = make_sorted_input(table_oid1, table_schema1.GetColumn("colA").Oid(),
+                                     execution::sql::SqlTypeId::Integer, 10, &order_by_out1);
+  OutputSchemaHelper order_by_out2{1, &expr_maker};
+  auto order_by2 = make_sorted_input(table_oid2, table_schema2.GetColumn("col1").Oid(),
+                                     execution::sql::SqlTypeId::SmallInt, 4, &order_by_out2);
+
+  // Make merge join
+  std::unique_ptr<planner::AbstractPlanNode> merge_join;
+  OutputSchemaHelper merge_join_out{0, &expr_maker};
+  {
+    auto t1_col = order_by_out1.GetOutput("col");
+    auto t1_key = order_by_out1.GetOutput("key");
+    auto t2_col = order_by_out2.GetOutput("col");
+    auto t2_key = order_by_out2.GetOutput("key");
+    merge_join_out.AddOutput("t1.col", t1_col);
+    merge_join_out.AddOutput("t2.col", t2_col);
+    merge_join_out.AddOutput("t1.key", t1_key);
+    planner::MergeJoinPlanNode::Builder builder;
+    merge_join = builder.AddChild(std::move(order_by1))
+                     .AddChild(std::move(order_by2))
+                     .SetOutputSchema(merge_join_out.MakeSchema())
+                     .AddLeftMergeKey(t1_key)
+                     .AddRightMergeKey(t2_key)
+                     .SetJoinType(planner::LogicalJoinType::INNER)
+                     .SetJoinPredicate(expr_maker.ComparisonEq(t1_key, t2_key))
+                     .Build();
+  }
+
+  // Run the join with the buffered left input in memory, then with a budget so small that the
+  // buffer spills to disk. Right keys are in [0, 250), so left rows with colA < 2500 are each
+  // joined with the 4 right rows of their key, and all other left rows are dropped.
+  for (const uint64_t memory_budget : {0, 1}) {
+    SetQueryMemoryBudget(memory_budget);
+
+    std::vector<uint32_t> matches(sql::TEST1_SIZE, 0);
+    uint32_t num_output_rows{0};
+    uint32_t num_expected_rows{2500 * 4};
+    RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+      auto t1_col = static_cast<sql::Integer *>(vals[0]);
+      auto t2_col = static_cast<sql::Integer *>(vals[1]);
+      auto t1_key = static_cast<sql::Integer *>(vals[2]);
+      ASSERT_FALSE(t1_col->is_null_ || t2_col->is_null_ || t1_key->is_null_);
+      ASSERT_EQ(t1_col->val_ / 10, t2_col->val_ / 4);
+      ASSERT_EQ(t1_col->val_ / 10, t1_key->val_);
+      ASSERT_LT(t1_col->val_, sql::TEST1_SIZE);
+      matches[t1_col->val_]++;
+      num_output_rows++;
+      ASSERT_LE(num_output_rows, num_expected_rows);
+    };
+    CorrectnessFn correctness_fn = [&]() {
+      ASSERT_EQ(num_output_rows, num_expected_rows);
+      for (uint32_t i = 0; i < matches.size(); i++) {
+        ASSERT_EQ(i < 2500 ? 4u : 0u, matches[i]) << "Left row " << i << " was joined with the wrong number of rows";
+      }
+    };
+    GenericChecker checker(row_checker, correctness_fn);
+
+    OutputStore store{&checker, merge_join->GetOutputSchema().Get()};
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+    exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+    auto exec_ctx = MakeExecCtx(&callback_fn, merge_join->GetOutputSchema().Get());
+
+    // Run & Check
+    auto executable = execution::compiler::CompilationContext::Compile(*merge_join, exec_ctx->GetExecutionSettings(),
+                                                                       exec_ctx->GetAccessor());
+    executable->Run(common::ManagedPointer(exec_ctx), MODE);
+    checker.CheckCorrectness();
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleSortTest) {
   // SELECT col1, col2, col1 + col2 FROM test_1 WHERE col1 < 500 ORDER BY col2 ASC, col1 - col2 DESC
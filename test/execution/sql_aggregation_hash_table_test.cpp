@@ -1,5 +1,6 @@
 #include <tbb/tbb.h>
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <random>
@@ -70,6 +71,19 @@ static bool AggAggKeyEq(const void *agg_tuple_1, const void *agg_tuple_2) {
   return lhs->key_ == rhs->key_;
 }
 
+// The function to merge a set of partial aggregates into a table.
+static void MergeAggTuples(void *query_state, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+  for (; iter->HasNext(); iter->Next()) {
+    auto *partial_agg = iter->GetRowAs<AggTuple>();
+    auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetRowHash(), AggAggKeyEq, partial_agg));
+    if (existing != nullptr) {
+      existing->Merge(*partial_agg);
+    } else {
+      table->Insert(iter->GetEntryForRow());
+    }
+  }
+}
+
 class AggregationHashTableTest : public SqlBasedTest {
  public:
   AggregationHashTableTest() = default;
@@ -158,7 +172,7 @@ TEST_F(AggregationHashTableTest, IterationTest) {
 
   {
     uint32_t group_count = 0;
-    for (AHTIterator iter(*AggTable()); iter.HasNext(); iter.Next()) {
+    for (AHTIterator iter(AggTable()); iter.HasNext(); iter.Next()) {
       auto *agg_tuple = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
       EXPECT_EQ(tuples_per_group, agg_tuple->count1_);
       EXPECT_EQ(tuples_per_group * 2, agg_tuple->count2_);
@@ -259,7 +273,7 @@ TEST_F(AggregationHashTableTest, BatchProcessTest) {
   }
 
   EXPECT_EQ(num_groups - 1, AggTable()->GetTupleCount());
-  for (auto iter = AHTIterator(*AggTable()); iter.HasNext(); iter.Next()) {
+  for (auto iter = AHTIterator(AggTable()); iter.HasNext(); iter.Next()) {
     auto agg = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
     EXPECT_EQ(num_group_updates_per_batch * num_batches * count1_scale, agg->count1_);
     EXPECT_EQ(num_group_updates_per_batch * num_batches * count2_scale, agg->count2_);
@@ -438,4 +452,106 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
   EXPECT_EQ(num_aggs, query_state.row_count_.load(std::memory_order_seq_cst));
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, SerialSpillTest) {
+  constexpr uint32_t num_aggs = 50000;
+  constexpr uint32_t num_inputs_per_agg = 3;
+
+  // A tiny budget makes the table spill instead of growing once the tracker has published its
+  // allocations. Enough aggregates are built for them to exceed MemoryTracker::PUBLISH_THRESHOLD.
+  SetQueryMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  AggregationHashTable agg_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+  agg_table.EnableSpilling(nullptr, MergeAggTuples);
+
+  // Feed each key several times, in random order. Keys whose aggregate was spilled get a new one.
+  std::vector<uint64_t> keys;
+  for (uint32_t i = 0; i < num_aggs * num_inputs_per_agg; i++) {
+    keys.push_back(i % num_aggs);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937{});
+  for (const auto key : keys) {
+    InputTuple input(key, 1);
+    auto *existing = reinterpret_cast<AggTuple *>(agg_table.Lookup(input.Hash(), AggTupleKeyEq, &input));
+    if (existing != nullptr) {
+      existing->Advance(input);
+    } else {
+      new (agg_table.AllocInputTuple(input.Hash())) AggTuple(input);
+    }
+  }
+
+  EXPECT_TRUE(agg_table.HasSpilled());
+
+  // The iterator merges the spilled aggregates, producing one full aggregate per key.
+  std::vector<uint32_t> seen(num_aggs, 0);
+  for (AHTIterator iter(&agg_table); iter.HasNext(); iter.Next()) {
+    auto *agg = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
+    ASSERT_LT(agg->key_, num_aggs);
+    EXPECT_EQ(num_inputs_per_agg, agg->count1_);
+    EXPECT_EQ(num_inputs_per_agg * 10, agg->count3_);
+    seen[agg->key_]++;
+  }
+  EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](auto count) { return count == 1; }));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, ParallelSpillTest) {
+  constexpr uint32_t num_aggs = 50000;
+  constexpr uint32_t num_threads = 4;
+
+  // A tiny budget makes the thread-local tables spill their overflow partitions on every flush.
+  SetQueryMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  struct QueryState {
+    std::atomic<uint32_t> row_count_;
+    std::atomic<uint64_t> input_count_;
+  };
+
+  QueryState query_state{{0}, {0}};
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+  container.Reset(
+      sizeof(AggregationHashTable),
+      [](void *ctx, void *aht) {
+        auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+        new (aht) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(AggTuple));
+      },
+      [](void *ctx, void *aht) { std::destroy_at(reinterpret_cast<AggregationHashTable *>(aht)); }, exec_ctx.get());
+
+  // Each thread aggregates every key once.
+  LaunchParallel(num_threads, [&](auto tid) {
+    auto agg_table = container.AccessCurrentThreadStateAs<AggregationHashTable>();
+    for (uint32_t key = 0; key < num_aggs; key++) {
+      InputTuple input(key, 1);
+      auto *existing = reinterpret_cast<AggTuple *>(agg_table->Lookup(input.Hash(), AggTupleKeyEq, &input));
+      if (existing != nullptr) {
+        existing->Advance(input);
+      } else {
+        new (agg_table->AllocInputTuplePartitioned(input.Hash())) AggTuple(input);
+      }
+    }
+  });
+
+  AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+  main_table.TransferMemoryAndPartitions(&container, 0, MergeAggTuples);
+  container.Clear();
+
+  EXPECT_TRUE(main_table.HasSpilled());
+
+  // Each partition merges its spilled and in-memory partial aggregates.
+  main_table.ExecuteParallelPartitionedScan(
+      &query_state, &container, [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+        auto *qs = reinterpret_cast<QueryState *>(query_state);
+        qs->row_count_ += agg_table->GetTupleCount();
+        for (AHTIterator iter(const_cast<AggregationHashTable *>(agg_table)); iter.HasNext(); iter.Next()) {
+          qs->input_count_ += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+        }
+      });
+
+  EXPECT_EQ(num_aggs, query_state.row_count_.load());
+  EXPECT_EQ(num_aggs * num_threads, query_state.input_count_.load());
+}
+
 }  // namespace noisepage::execution::sql
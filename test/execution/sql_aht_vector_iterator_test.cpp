@@ -227,7 +227,7 @@ TEST_F(AggregationHashTableVectorIteratorTest, DISABLED_Perf) {
 
     UNUSED_ATTRIBUTE auto taat_ms = Bench(4, [&]() {
       taat_ret = 0;
-      AHTIterator iter(agg_ht);
+      AHTIterator iter(&agg_ht);
       for (; iter.HasNext(); iter.Next()) {
         auto *agg_row = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
         if (agg_row->key_ < filter_val) {
@@ -1,85 +1,108 @@
-#if 0
-#include <tbb/tbb.h>
+#include <unistd.h>
 
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
 
-#include "catalog/schema.h"
 #include "execution/compiler/compilation_context.h"
+#include "execution/compiler/executable_query.h"
 #include "execution/compiler/expression_maker.h"
 #include "execution/compiler/output_checker.h"
 #include "execution/compiler/output_schema_util.h"
 #include "execution/exec/execution_context.h"
+#include "execution/exec/output.h"
+#include "execution/sql/csv_scanner.h"
+#include "execution/sql/value.h"
 #include "execution/sql_test.h"
-#include "execution/vm/llvm_engine.h"
 #include "planner/plannodes/csv_scan_plan_node.h"
 
-namespace noisepage::execution::sql::codegen::test {
-
-using namespace std::chrono_literals;  // NOLINT
+namespace noisepage::execution::compiler::test {
 
 class CSVScanTranslatorTest : public SqlBasedTest {
  protected:
-  void SetUp() override { SqlBasedTest::SetUp(); }
-  static void SetUpTestSuite() {
-    auto settings = std::make_unique<noisepage::execution::vm::LLVMEngine::Settings>(bytecode_handlers_path_);
-    noisepage::execution::vm::LLVMEngine::Initialize(std::move(settings));
+  void SetUp() override {
+    SqlBasedTest::SetUp();
+    // Each process writes its own file, so that concurrent test runs don't read each other's data
+    path_ = "/tmp/noisepage-csv-scan-translator-test." + std::to_string(getpid()) + ".csv";
+  }
+
+  void TearDown() override {
+    std::remove(path_.c_str());
+    SqlBasedTest::TearDown();
   }
-  static void TearDownTestSuite() { noisepage::execution::vm::LLVMEngine::Shutdown(); }
 
- private:
-  tbb::task_scheduler_init anonymous_;
-  static constexpr const char* const bytecode_handlers_path_{"../bin/bytecode_handlers_ir.bc"};
+  std::string path_;
+
+  static constexpr vm::ExecutionMode MODE = vm::ExecutionMode::Interpret;
 };
 
 // NOLINTNEXTLINE
-TEST_F(CSVScanTranslatorTest, ManyTypesTest) {
-  compiler::test::ExpressionMaker expr_maker;
+TEST_F(CSVScanTranslatorTest, ParallelScanTest) {
+  // Rows of (id, text, id * 3), where the text is quoted and holds delimiters, escaped quotes and new lines. Rows end
+  // in \n or \r\n. The file is large enough to be split into several chunks that are scanned in parallel.
+  const uint32_t num_rows = 400000;
+  const auto make_text = [](uint32_t id) { return "a,\n\"" + std::to_string(id) + "\"\r\nb"; };
+  {
+    std::ofstream file(path_, std::ios::binary);
+    for (uint32_t id = 0; id < num_rows; id++) {
+      file << id << ",\"a,\n\"\"" << id << "\"\"\r\nb\"," << id * 3 << (id % 2 == 0 ? "\n" : "\r\n");
+    }
+    ASSERT_GT(static_cast<std::size_t>(file.tellp()), 2 * sql::CSVScanner::K_MIN_CHUNK_SIZE);
+  }
 
+  ExpressionMaker expr_maker;
   std::unique_ptr<planner::AbstractPlanNode> csv_scan;
-  compiler::test::OutputSchemaHelper seq_scan_out(0, &expr_maker);
+  OutputSchemaHelper csv_scan_out{0, &expr_maker};
   {
-    auto col1 = expr_maker.CVE(catalog::col_oid_t(0), execution::sql::SqlTypeId::TinyInt);
-    auto col2 = expr_maker.CVE(catalog::col_oid_t(1), execution::sql::SqlTypeId::SmallInt);
-    auto col3 = expr_maker.CVE(catalog::col_oid_t(2), execution::sql::SqlTypeId::Integer);
-    auto col4 = expr_maker.CVE(catalog::col_oid_t(3), execution::sql::SqlTypeId::BigInt);
-    auto col5 = expr_maker.CVE(catalog::col_oid_t(4), execution::sql::SqlTypeId::Double);
-    auto col6 = expr_maker.CVE(catalog::col_oid_t(5), execution::sql::SqlTypeId::Varchar);
-
-    seq_scan_out.AddOutput("col1", col1);
-    seq_scan_out.AddOutput("col2", col2);
-    seq_scan_out.AddOutput("col3", col3);
-    seq_scan_out.AddOutput("col4", col4);
-    seq_scan_out.AddOutput("col5", col5);
-    seq_scan_out.AddOutput("col6", col6);
-
-    auto schema = seq_scan_out.MakeSchema();
-    // Build
-    csv_scan = planner::CSVScanPlanNode::Builder()
-                   .SetOutputSchema(std::move(schema))
-                   .SetFileName("/home/pmenon/work/tpl/test.csv")
+    csv_scan_out.AddOutput("id", expr_maker.CVE(catalog::col_oid_t(0), sql::SqlTypeId::Integer));
+    csv_scan_out.AddOutput("text", expr_maker.CVE(catalog::col_oid_t(1), sql::SqlTypeId::Varchar));
+    csv_scan_out.AddOutput("id3", expr_maker.CVE(catalog::col_oid_t(2), sql::SqlTypeId::BigInt));
+    planner::CSVScanPlanNode::Builder builder;
+    csv_scan = builder.SetOutputSchema(csv_scan_out.MakeSchema())
+                   .SetFileName(path_)
+                   .SetDelimiter(',')
+                   .SetQuote('"')
+                   .SetEscape('"')
+                   .SetValueTypes({sql::SqlTypeId::Integer, sql::SqlTypeId::Varchar, sql::SqlTypeId::BigInt})
                    .SetScanPredicate(nullptr)
                    .Build();
   }
 
-  // Make the checkers:
-  // 1. There should be only one output.
-  // 2. The count should be size of the table.
-  // 3. The sum should be sum from [1,N] where N=num_tuples.
-  compiler::test::MultiChecker multi_checker({});
+  // Every row is read exactly once, whichever chunk it falls into
+  SetNumParallelExecutionThreads(4);
+  std::vector<uint32_t> seen(num_rows, 0);
+  uint32_t num_output_rows{0};
+  RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+    auto id = static_cast<sql::Integer *>(vals[0]);
+    auto text = static_cast<sql::StringVal *>(vals[1]);
+    auto id3 = static_cast<sql::Integer *>(vals[2]);
+    ASSERT_FALSE(id->is_null_ || text->is_null_ || id3->is_null_);
+    ASSERT_GE(id->val_, 0);
+    ASSERT_LT(id->val_, num_rows);
+    EXPECT_EQ(make_text(id->val_), text->StringView());
+    EXPECT_EQ(id->val_ * 3, id3->val_);
+    seen[id->val_]++;
+    num_output_rows++;
+  };
+  CorrectnessFn correctness_fn = [&]() {
+    ASSERT_EQ(num_rows, num_output_rows);
+    for (uint32_t id = 0; id < num_rows; id++) {
+      ASSERT_EQ(1u, seen[id]) << "Row " << id << " was read the wrong number of times";
+    }
+  };
+  GenericChecker checker(row_checker, correctness_fn);
 
-  // Compile and Run
-  OutputCollectorAndChecker store(&multi_checker, csv_scan->GetOutputSchema());
-  PrintingConsumer consumer(std::cout, csv_scan->GetOutputSchema());  // NOLINT
-  MultiOutputCallback callback({&store});
-  sql::MemoryPool memory(nullptr);
-  sql::ExecutionContext exec_ctx(&memory, csv_scan->GetOutputSchema(), &callback);
+  OutputStore store{&checker, csv_scan->GetOutputSchema().Get()};
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+  exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+  auto exec_ctx = MakeExecCtx(&callback_fn, csv_scan->GetOutputSchema().Get());
 
   // Run & Check
-  auto query = CompilationContext::Compile(*csv_scan);
-  query->Run(&exec_ctx);
-
-  multi_checker.CheckCorrectness();
+  auto executable = CompilationContext::Compile(*csv_scan, exec_ctx->GetExecutionSettings(), exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
 }
 
-}  // namespace noisepage::execution::sql::codegen::test
-#endif
+}  // namespace noisepage::execution::compiler::test
@@ -1,4 +1,5 @@
 #include <chrono>  // NOLINT
+#include <limits>
 #include <vector>
 
 #include "common/settings.h"
@@ -189,4 +190,33 @@ TEST_F(FilterManagerTest, AdaptiveCheckTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(FilterManagerTest, ZoneMapTermTest) {
+  using Cmp = FilterManager::ZoneMapComparison;
+  const auto may_match = [](Cmp cmp, int64_t value, int64_t min, int64_t max) {
+    return FilterManager::ZoneMapTerm{Col::A, cmp, value}.MayMatch(min, max);
+  };
+
+  // A block with the values [10, 20]
+  EXPECT_TRUE(may_match(Cmp::Equal, 15, 10, 20));
+  EXPECT_FALSE(may_match(Cmp::Equal, 21, 10, 20));
+  EXPECT_TRUE(may_match(Cmp::NotEqual, 10, 10, 20));
+  EXPECT_FALSE(may_match(Cmp::NotEqual, 10, 10, 10));
+  EXPECT_TRUE(may_match(Cmp::LessThan, 11, 10, 20));
+  EXPECT_FALSE(may_match(Cmp::LessThan, 10, 10, 20));
+  EXPECT_TRUE(may_match(Cmp::LessThanEqual, 10, 10, 20));
+  EXPECT_FALSE(may_match(Cmp::LessThanEqual, 9, 10, 20));
+  EXPECT_TRUE(may_match(Cmp::GreaterThan, 19, 10, 20));
+  EXPECT_FALSE(may_match(Cmp::GreaterThan, 20, 10, 20));
+  EXPECT_TRUE(may_match(Cmp::GreaterThanEqual, 20, 10, 20));
+  EXPECT_FALSE(may_match(Cmp::GreaterThanEqual, 21, 10, 20));
+
+  // A block without non-null values matches no comparison
+  const auto empty_min = std::numeric_limits<int64_t>::max(), empty_max = std::numeric_limits<int64_t>::min();
+  for (const auto cmp : {Cmp::Equal, Cmp::NotEqual, Cmp::LessThan, Cmp::LessThanEqual, Cmp::GreaterThan,
+                         Cmp::GreaterThanEqual}) {
+    EXPECT_FALSE(may_match(cmp, 0, empty_min, empty_max));
+  }
+}
+
 }  // namespace noisepage::execution::sql::test
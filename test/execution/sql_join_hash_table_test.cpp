@@ -1,5 +1,7 @@
 #include <tbb/tbb.h>
 
+#include <algorithm>
+#include <numeric>
 #include <random>
 #include <vector>
 
@@ -7,6 +9,8 @@
 #include "execution/exec/execution_settings.h"
 #include "execution/sql/join_hash_table.h"
 #include "execution/sql/thread_state_container.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector_projection.h"
 #include "execution/sql_test.h"
 
 // TODO(WAN): can't FRIEND_TEST unless in the same namespace
@@ -217,6 +221,276 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
   }
 }
 
+// Check that all keys in [0, num_tuples) find exactly 'num_dups' matches in a built table, both
+// through tuple-at-a-time and batched lookups.
+void CheckPartitionedTable(const JoinHashTable &jht, const uint32_t num_tuples, const uint32_t num_dups) {
+  EXPECT_TRUE(jht.UsingPartitionedBuild());
+  EXPECT_EQ(num_tuples * num_dups, jht.GetTupleCount());
+
+  uint32_t num_iterated = 0;
+  for (JoinHashTableIterator iter(jht); iter.HasNext(); iter.Next()) {
+    EXPECT_LT(iter.GetCurrentRowAs<Tuple>()->a_, num_tuples);
+    num_iterated++;
+  }
+  EXPECT_EQ(num_tuples * num_dups, num_iterated);
+
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    auto probe = Tuple{i, 1, 2, 3};
+    uint32_t count = 0;
+    for (auto iter = jht.Lookup<false>(probe.Hash()); iter.HasNext();) {
+      auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+      if (matched->a_ == probe.a_) {
+        count++;
+      }
+    }
+    EXPECT_EQ(num_dups, count);
+  }
+
+  // Batched lookups of keys in [0, 2*num_tuples). Only the first half should find a chain.
+  Vector hashes(TypeId::Hash, true, true), results(TypeId::Pointer, true, true);
+  for (uint32_t offset = 0; offset < 2 * num_tuples; offset += common::Constants::K_DEFAULT_VECTOR_SIZE) {
+    const uint32_t count = std::min(2 * num_tuples - offset, common::Constants::K_DEFAULT_VECTOR_SIZE);
+    hashes.Resize(count);
+    results.Resize(count);
+    auto *raw_hashes = reinterpret_cast<hash_t *>(hashes.GetData());
+    for (uint32_t i = 0; i < count; i++) {
+      raw_hashes[i] = Tuple{offset + i, 0, 0, 0}.Hash();
+    }
+    jht.LookupBatch(hashes, &results);
+    auto *raw_results = reinterpret_cast<const HashTableEntry **>(results.GetData());
+    for (uint32_t i = 0; i < count; i++) {
+      if (offset + i < num_tuples) {
+        EXPECT_NE(nullptr, raw_results[i]) << "Key [" << offset + i << "] did not find its chain";
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, PartitionedBuildTest) {
+  auto exec_ctx = MakeExecCtx();
+  exec::ExecutionSettings exec_settings{};
+
+  const uint32_t num_tuples = 10000;
+  const uint32_t num_dups = 3;
+
+  // Force a radix-partitioned build with small partitions so multiple passes are required.
+  JoinHashTable join_hash_table(exec_settings, exec_ctx.get(), sizeof(Tuple), false);
+  join_hash_table.min_partitioned_build_size_ = 0;
+  join_hash_table.target_partition_size_ = 1024;
+
+  PopulateJoinHashTable(&join_hash_table, num_tuples, num_dups);
+  join_hash_table.Build();
+
+  EXPECT_EQ(num_tuples * num_dups, join_hash_table.chaining_hash_table_.GetElementCount());
+  EXPECT_GT(join_hash_table.num_radix_bits_, 6u);
+  // Tuples are inserted where they were buffered, never copied into partitions.
+  EXPECT_TRUE(join_hash_table.owned_.empty());
+  EXPECT_EQ(num_tuples * num_dups, join_hash_table.entries_.size());
+  CheckPartitionedTable(join_hash_table, num_tuples, num_dups);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, ParallelPartitionedBuildTest) {
+  auto exec_ctx = MakeExecCtx();
+  exec::ExecutionSettings exec_settings{};
+  tbb::task_scheduler_init sched;
+
+  const uint32_t num_tuples = 10000;
+  const uint32_t num_thread_local_tables = 4;
+
+  ThreadStateContainer container(exec_ctx->GetMemoryPool());
+
+  struct Context {
+    exec::ExecutionContext *exec_ctx_;
+    exec::ExecutionSettings *settings_;
+  };
+
+  Context ctx{exec_ctx.get(), &exec_settings};
+
+  container.Reset(
+      sizeof(JoinHashTable),
+      [](auto *ctx, auto *s) {
+        auto context = reinterpret_cast<Context *>(ctx);
+        new (s) JoinHashTable(*context->settings_, context->exec_ctx_, sizeof(Tuple), false);
+      },
+      [](auto *ctx, auto *s) { reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable(); }, &ctx);
+
+  LaunchParallel(num_thread_local_tables, [&](auto tid) {
+    auto *jht = container.AccessCurrentThreadStateAs<JoinHashTable>();
+    PopulateJoinHashTable(jht, num_tuples, 1);
+  });
+
+  JoinHashTable main_jht(exec_settings, exec_ctx.get(), sizeof(Tuple), false);
+  main_jht.min_partitioned_build_size_ = 0;
+  main_jht.target_partition_size_ = 1024;
+  main_jht.MergeParallel(&container, 0);
+
+  EXPECT_EQ(num_tuples * num_thread_local_tables, main_jht.chaining_hash_table_.GetElementCount());
+  // The global table owns the thread-local entry lists rather than copies of their tuples.
+  EXPECT_EQ(num_thread_local_tables, main_jht.owned_.size());
+  CheckPartitionedTable(main_jht, num_tuples, num_thread_local_tables);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, BloomFilterProbeTest) {
+  auto exec_ctx = MakeExecCtx();
+  exec::ExecutionSettings exec_settings{};
+
+  const uint32_t num_tuples = 1000;
+
+  JoinHashTable join_hash_table(exec_settings, exec_ctx.get(), sizeof(Tuple), false);
+  PopulateJoinHashTable(&join_hash_table, num_tuples, 1);
+  join_hash_table.Build();
+
+  EXPECT_FALSE(join_hash_table.HasBloomFilter());
+  join_hash_table.BuildBloomFilter();
+  EXPECT_TRUE(join_hash_table.HasBloomFilter());
+
+  // Probe with keys in the range [0, 2*num_tuples). The first half exist in
+  // the table and must survive, the second half should mostly be filtered.
+  const uint32_t num_probes = 2 * num_tuples;
+  std::vector<int64_t> keys(num_probes);
+  std::iota(keys.begin(), keys.end(), 0);
+
+  uint32_t survivors = 0;
+  for (uint32_t offset = 0; offset < num_probes; offset += common::Constants::K_DEFAULT_VECTOR_SIZE) {
+    const uint32_t count = std::min(num_probes - offset, common::Constants::K_DEFAULT_VECTOR_SIZE);
+
+    VectorProjection vp;
+    vp.Initialize({TypeId::BigInt});
+    vp.Reset(count);
+    auto *col_data = reinterpret_cast<int64_t *>(vp.GetColumn(0)->GetData());
+    std::copy(keys.begin() + offset, keys.begin() + offset + count, col_data);
+
+    TupleIdList tids(count);
+    tids.AddAll();
+
+    const uint32_t key_cols[] = {0};
+    join_hash_table.ProbeBloomFilter(vp, &tids, key_cols, 1);
+
+    // No false negatives
+    for (uint32_t i = 0; i < count; i++) {
+      if (keys[offset + i] < static_cast<int64_t>(num_tuples)) {
+        EXPECT_TRUE(tids.Contains(i)) << "Key [" << keys[offset + i] << "] was incorrectly filtered";
+      }
+    }
+    survivors += tids.GetTupleCount();
+  }
+
+  // All matching keys survive, and the filter should remove most non-matching keys.
+  EXPECT_GE(survivors, num_tuples);
+  EXPECT_LT(survivors - num_tuples, num_tuples / 10);
+}
+
+// Probe a table that may have spilled with all keys in [0, 2*num_tuples), deferring the probes of
+// spilled partitions. Check that keys in [0, num_tuples) find exactly 'num_dups' matches, either in
+// memory or once their partition is loaded, and that all other keys find none.
+void CheckSpilledTable(JoinHashTable *jht, const uint32_t num_tuples, const uint32_t num_dups) {
+  std::vector<uint32_t> matches(2 * num_tuples, 0);
+  const auto count_matches = [](const JoinHashTable &table, const Tuple &probe, std::vector<uint32_t> *matches) {
+    for (auto iter = table.Lookup<false>(probe.Hash()); iter.HasNext();) {
+      auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+      if (matched->a_ == probe.a_) {
+        (*matches)[probe.a_]++;
+      }
+    }
+  };
+
+  uint32_t num_deferred = 0;
+  for (uint32_t i = 0; i < 2 * num_tuples; i++) {
+    auto probe = Tuple{i, 1, 2, 3};
+    if (jht->IsPartitionSpilled(probe.Hash())) {
+      jht->DeferProbe(probe.Hash(), reinterpret_cast<const byte *>(&probe));
+      num_deferred++;
+    } else {
+      count_matches(*jht, probe, &matches);
+    }
+  }
+  EXPECT_GT(num_deferred, 0u);
+
+  jht->ProbeSpilledPartitions(&matches, nullptr, [](void *query_state, void *, JoinHashTable *table, const byte *row) {
+    auto *matches = reinterpret_cast<std::vector<uint32_t> *>(query_state);
+    auto probe = *reinterpret_cast<const Tuple *>(row);
+    EXPECT_FALSE(table->HasSpilled());
+    for (auto iter = table->Lookup<false>(probe.Hash()); iter.HasNext();) {
+      auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+      if (matched->a_ == probe.a_) {
+        (*matches)[probe.a_]++;
+      }
+    }
+  });
+
+  for (uint32_t i = 0; i < 2 * num_tuples; i++) {
+    EXPECT_EQ(i < num_tuples ? num_dups : 0, matches[i]) << "Key [" << i << "] found the wrong number of matches";
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillTest) {
+  const uint32_t num_tuples = 20000;
+  const uint32_t num_dups = 2;
+
+  // A tiny budget makes the table spill partitions on every check once the tracker has published
+  // its allocations. Enough tuples are inserted to exceed MemoryTracker::PUBLISH_THRESHOLD.
+  SetQueryMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  JoinHashTable join_hash_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple));
+  join_hash_table.EnableSpilling(sizeof(Tuple));
+
+  PopulateJoinHashTable(&join_hash_table, num_tuples, num_dups);
+  join_hash_table.Build();
+
+  // Only the resident partitions remain in memory, and they're all in the built table.
+  EXPECT_TRUE(join_hash_table.HasSpilled());
+  EXPECT_LT(join_hash_table.GetTupleCount(), num_tuples * num_dups);
+  EXPECT_EQ(join_hash_table.entries_.size(), join_hash_table.chaining_hash_table_.GetElementCount());
+  EXPECT_TRUE(join_hash_table.staged_entries_.empty());
+
+  // Spilled tuples aren't in memory, so their probes mustn't be filtered.
+  join_hash_table.BuildBloomFilter();
+  EXPECT_FALSE(join_hash_table.HasBloomFilter());
+
+  CheckSpilledTable(&join_hash_table, num_tuples, num_dups);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, ParallelSpillTest) {
+  const uint32_t num_tuples = 20000;
+  const uint32_t num_thread_local_tables = 4;
+
+  SetQueryMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  ThreadStateContainer container(exec_ctx->GetMemoryPool());
+  container.Reset(
+      sizeof(JoinHashTable),
+      [](auto *ctx, auto *s) {
+        auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+        auto *jht = new (s) JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Tuple));
+        jht->EnableSpilling(sizeof(Tuple));
+      },
+      [](auto *ctx, auto *s) { reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable(); }, exec_ctx.get());
+
+  LaunchParallel(num_thread_local_tables, [&](auto tid) {
+    auto *jht = container.AccessCurrentThreadStateAs<JoinHashTable>();
+    PopulateJoinHashTable(jht, num_tuples, 1);
+  });
+
+  JoinHashTable main_jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple));
+  main_jht.EnableSpilling(sizeof(Tuple));
+  main_jht.MergeParallel(&container, 0);
+
+  // All thread-local tables keep the same partitions in memory after the merge.
+  EXPECT_TRUE(main_jht.HasSpilled());
+  container.ForEach<JoinHashTable>([&](JoinHashTable *jht) {
+    EXPECT_EQ(main_jht.num_resident_partitions_, jht->num_resident_partitions_);
+  });
+
+  CheckSpilledTable(&main_jht, num_tuples, num_thread_local_tables);
+}
+
 #if 0
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, PerfTest) {
@@ -0,0 +1,103 @@
+#include <algorithm>
+
+#include "execution/sql/row_buffer.h"
+#include "execution/sql_test.h"
+
+namespace noisepage::execution::sql::test {
+
+class RowBufferTest : public SqlBasedTest {
+ protected:
+  // Append the values [0, num_rows) to the buffer and finish it.
+  static void Fill(RowBuffer *buffer, const uint64_t num_rows) {
+    for (uint64_t i = 0; i < num_rows; i++) {
+      *reinterpret_cast<uint64_t *>(buffer->AllocInputRow()) = i;
+    }
+    buffer->Finish();
+  }
+
+  // Check that the iterator reads the values [from, to) and is then exhausted.
+  static void CheckRange(RowBufferIterator *iter, const uint64_t from, const uint64_t to) {
+    for (uint64_t i = from; i < to; i++) {
+      ASSERT_TRUE(iter->HasNext());
+      EXPECT_EQ(i, *reinterpret_cast<const uint64_t *>(iter->GetRow()));
+      iter->Next();
+    }
+    EXPECT_FALSE(iter->HasNext());
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(RowBufferTest, EmptyBufferTest) {
+  auto exec_ctx = MakeExecCtx();
+  RowBuffer buffer(exec_ctx.get(), sizeof(uint64_t));
+  buffer.Finish();
+
+  EXPECT_EQ(0u, buffer.GetRowCount());
+  RowBufferIterator iter(buffer);
+  EXPECT_FALSE(iter.HasNext());
+  iter.Rewind();
+  EXPECT_FALSE(iter.HasNext());
+}
+
+// NOLINTNEXTLINE
+TEST_F(RowBufferTest, InMemoryMarkAndRewindTest) {
+  const uint64_t num_rows = 5000;
+
+  auto exec_ctx = MakeExecCtx();
+  RowBuffer buffer(exec_ctx.get(), sizeof(uint64_t));
+  Fill(&buffer, num_rows);
+  EXPECT_FALSE(buffer.HasSpilled());
+  EXPECT_EQ(num_rows, buffer.GetRowCount());
+
+  RowBufferIterator iter(buffer);
+  CheckRange(&iter, 0, num_rows);
+
+  // Without a mark, rewinding returns to the first row.
+  iter.Rewind();
+  for (uint64_t i = 0; i < 100; i++) iter.Next();
+  iter.Mark();
+  CheckRange(&iter, 100, num_rows);
+  iter.Rewind();
+  CheckRange(&iter, 100, num_rows);
+}
+
+// NOLINTNEXTLINE
+TEST_F(RowBufferTest, SpilledMarkAndRewindTest) {
+  // Enough rows for the buffer's allocations to exceed MemoryTracker::PUBLISH_THRESHOLD, so the
+  // tiny budget is noticed and the buffer spills.
+  const uint64_t num_rows = 20 * RowBuffer::MEMORY_BUDGET_CHECK_INTERVAL + 17;
+
+  SetQueryMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  RowBuffer buffer(exec_ctx.get(), sizeof(uint64_t));
+  Fill(&buffer, num_rows);
+  EXPECT_TRUE(buffer.HasSpilled());
+  EXPECT_EQ(num_rows, buffer.GetRowCount());
+
+  RowBufferIterator iter(buffer);
+  CheckRange(&iter, 0, num_rows);
+
+  // Rewind to marks both near the start of the file and past the rows that were in memory when the
+  // buffer first spilled, re-reading a short group each time as a merge join would.
+  for (const uint64_t mark : {uint64_t{0}, uint64_t{3}, num_rows / 2, num_rows - 5}) {
+    iter.Rewind();
+    while (*reinterpret_cast<const uint64_t *>(iter.GetRow()) < mark) iter.Next();
+    iter.Mark();
+    for (uint32_t pass = 0; pass < 3; pass++) {
+      iter.Rewind();
+      for (uint64_t i = mark; i < std::min(mark + 5, num_rows); i++) {
+        ASSERT_TRUE(iter.HasNext());
+        EXPECT_EQ(i, *reinterpret_cast<const uint64_t *>(iter.GetRow()));
+        iter.Next();
+      }
+    }
+  }
+  iter.Rewind();
+  CheckRange(&iter, num_rows - 5, num_rows);
+
+  // Independent iterators over the same buffer do not interfere.
+  RowBufferIterator other(buffer);
+  CheckRange(&other, 0, num_rows);
+}
+
+}  // namespace noisepage::execution::sql::test
@@ -158,6 +158,93 @@ TEST_F(SorterTest, TopKTest) {
   TestAllIntegral(TestTopKRandomTupleSize, exec_ctx.get(), num_iters, max_elems, &generator_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, ExternalSortTest) {
+  const uint32_t num_elems = 100 * Sorter::MEMORY_BUDGET_CHECK_INTERVAL + 17;
+
+  // A tiny budget forces the sorter to spill whenever the tracker has published its allocations.
+  // Enough tuples are sorted for the allocations to exceed MemoryTracker::PUBLISH_THRESHOLD.
+  SetQueryMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto val_a = *reinterpret_cast<const uint32_t *>(a);
+    const auto val_b = *reinterpret_cast<const uint32_t *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+
+  std::uniform_int_distribution<uint32_t> rng;
+  std::vector<uint32_t> reference;
+  Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(uint32_t));
+  for (uint32_t i = 0; i < num_elems; i++) {
+    reference.push_back(rng(generator_));
+    *reinterpret_cast<uint32_t *>(sorter.AllocInputTuple()) = reference.back();
+  }
+
+  EXPECT_TRUE(sorter.HasSpilled());
+  EXPECT_EQ(num_elems, sorter.GetTupleCount());
+
+  std::sort(reference.begin(), reference.end());
+  sorter.Sort();
+
+  // The iterator merges the spilled runs with the tuples remaining in memory.
+  SorterIterator iter(sorter);
+  EXPECT_EQ(num_elems, iter.NumRemaining());
+  for (const auto expected : reference) {
+    ASSERT_TRUE(iter.HasNext());
+    EXPECT_EQ(expected, *iter.GetRowAs<uint32_t>());
+    iter.Next();
+  }
+  EXPECT_FALSE(iter.HasNext());
+
+  // Skipping rows must also work over merged runs.
+  SorterIterator skip_iter(sorter);
+  skip_iter.AdvanceBy(num_elems - 1);
+  ASSERT_TRUE(skip_iter.HasNext());
+  EXPECT_EQ(reference.back(), *skip_iter.GetRowAs<uint32_t>());
+  skip_iter.AdvanceBy(2);
+  EXPECT_FALSE(skip_iter.HasNext());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, MultiPassExternalSortTest) {
+  const uint32_t num_elems = 2000000;
+
+  // A tiny budget makes the sorter spill every time its allocations are published, producing many
+  // more runs than can be merged at once.
+  SetQueryMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto val_a = *reinterpret_cast<const uint32_t *>(a);
+    const auto val_b = *reinterpret_cast<const uint32_t *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+
+  std::uniform_int_distribution<uint32_t> rng;
+  std::vector<uint32_t> reference;
+  Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(uint32_t));
+  for (uint32_t i = 0; i < num_elems; i++) {
+    reference.push_back(rng(generator_));
+    *reinterpret_cast<uint32_t *>(sorter.AllocInputTuple()) = reference.back();
+  }
+  EXPECT_GE(sorter.GetSpilledRunCount(), Sorter::MAX_MERGE_FAN_IN);
+
+  // Sorting merges runs on disk until the final merge is within the fan-in limit.
+  sorter.Sort();
+  EXPECT_LT(sorter.GetSpilledRunCount(), Sorter::MAX_MERGE_FAN_IN);
+  EXPECT_EQ(num_elems, sorter.GetTupleCount());
+
+  std::sort(reference.begin(), reference.end());
+  SorterIterator iter(sorter);
+  for (const auto expected : reference) {
+    ASSERT_TRUE(iter.HasNext());
+    EXPECT_EQ(expected, *iter.GetRowAs<uint32_t>());
+    iter.Next();
+  }
+  EXPECT_FALSE(iter.HasNext());
+}
+
 template <uint32_t N>
 struct TestTuple {
   uint32_t key_;
@@ -249,6 +336,15 @@ TEST_F(SorterTest, SingleThreadLocalParallelSortTest) {
   TestParallelSort<2>(exec_ctx.get(), {1000});
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, ExternalParallelSortTest) {
+  // A tiny budget forces every thread-local sorter to spill once its allocations are published.
+  SetQueryMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  TestParallelSort<2>(exec_ctx.get(), {50000, 50000, 50000, 50000});
+  TestParallelSort<2>(exec_ctx.get(), {50000, 0, 100, 100000});
+}
+
 // NOLINTNEXTLINE
 TEST_F(SorterTest, UnbalancedParallelSortTest) {
   auto exec_ctx = MakeExecCtx();
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "execution/sql/spill_file.h"
+#include "execution/tpl_test.h"
+
+namespace noisepage::execution::sql::test {
+
+class SpillFileTest : public TplTest {};
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, WriteAndReadTest) {
+  const uint32_t num_tuples = 10000;
+
+  // Use a block size that isn't a multiple of the tuple size to force many partial blocks.
+  SpillFile file("/tmp", sizeof(uint64_t), 1000);
+  for (uint64_t i = 0; i < num_tuples; i++) {
+    file.Append(reinterpret_cast<const byte *>(&i));
+  }
+  file.Finish();
+  EXPECT_EQ(num_tuples, file.GetTupleCount());
+
+  // Multiple independent readers should all see every tuple, in order.
+  SpillFile::Reader reader1(file, 1000), reader2(file);
+  for (uint64_t i = 0; i < num_tuples; i++) {
+    const byte *tuple1 = reader1.Next();
+    const byte *tuple2 = reader2.Next();
+    ASSERT_NE(nullptr, tuple1);
+    ASSERT_NE(nullptr, tuple2);
+    EXPECT_EQ(i, *reinterpret_cast<const uint64_t *>(tuple1));
+    EXPECT_EQ(i, *reinterpret_cast<const uint64_t *>(tuple2));
+  }
+  EXPECT_EQ(nullptr, reader1.Next());
+  EXPECT_EQ(nullptr, reader2.Next());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, RangeReadTest) {
+  const uint32_t num_tuples = 10000;
+
+  SpillFile file("/tmp", sizeof(uint64_t), 1000);
+  for (uint64_t i = 0; i < num_tuples; i++) {
+    file.Append(reinterpret_cast<const byte *>(&i));
+  }
+  file.Finish();
+
+  // Read ranges that start and end in the middle of blocks, including empty ones.
+  for (const auto &[first, count] : std::vector<std::pair<uint64_t, uint64_t>>{
+           {0, 0}, {0, 1}, {17, 1000}, {5000, 5000}, {num_tuples - 1, 1}, {num_tuples, 0}}) {
+    SpillFile::Reader reader(file, first, count, 1000);
+    for (uint64_t i = first; i < first + count; i++) {
+      const byte *tuple = reader.Next();
+      ASSERT_NE(nullptr, tuple);
+      EXPECT_EQ(i, *reinterpret_cast<const uint64_t *>(tuple));
+    }
+    EXPECT_EQ(nullptr, reader.Next());
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, SeekTest) {
+  const uint32_t num_tuples = 10000;
+
+  SpillFile file("/tmp", sizeof(uint64_t), 1000);
+  for (uint64_t i = 0; i < num_tuples; i++) {
+    file.Append(reinterpret_cast<const byte *>(&i));
+  }
+  file.Finish();
+
+  // Seek backwards within the current block, to an earlier block, forwards past unread blocks, and
+  // to the end of the file.
+  SpillFile::Reader reader(file, 1000);
+  for (const uint64_t target : {0, 5, 3, 500, 200, 9000, 9999, 42}) {
+    reader.Seek(target);
+    for (uint64_t i = target; i < std::min<uint64_t>(target + 200, num_tuples); i++) {
+      const byte *tuple = reader.Next();
+      ASSERT_NE(nullptr, tuple);
+      EXPECT_EQ(i, *reinterpret_cast<const uint64_t *>(tuple));
+    }
+  }
+  reader.Seek(num_tuples);
+  EXPECT_EQ(nullptr, reader.Next());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, EmptyFileTest) {
+  SpillFile file("/tmp", sizeof(uint64_t));
+  file.Finish();
+  EXPECT_EQ(0u, file.GetTupleCount());
+
+  SpillFile::Reader reader(file);
+  EXPECT_EQ(nullptr, reader.Next());
+}
+
+}  // namespace noisepage::execution::sql::test
@@ -1,11 +1,22 @@
+#include <algorithm>
 #include <array>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
 #include <vector>
 
+#include "catalog/catalog_accessor.h"
 #include "catalog/catalog_defs.h"
+#include "common/numa_util.h"
+#include "execution/sql/filter_manager.h"
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql_test.h"
+#include "execution/util/fast_rand.h"
 #include "execution/util/timer.h"
+#include "storage/sql_table.h"
 
 namespace noisepage::execution::sql::test {
 
@@ -131,6 +142,57 @@ TEST_F(TableVectorIteratorTest, IteratorColOidsTest) {
   EXPECT_EQ(sql::TEST2_SIZE, num_tuples);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, SkipBlocksTest) {
+  //
+  // Check that blocks whose zone maps rule out every clause are skipped, and that all other blocks are still scanned
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  std::array<uint32_t, 1> col_oids{1};
+  const auto scan = [&](const FilterManager &filter) {
+    TableVectorIterator iter(exec_ctx_.get(), table_oid.UnderlyingValue(), col_oids.data(),
+                             static_cast<uint32_t>(col_oids.size()));
+    iter.Init();
+    iter.SkipBlocks(&filter);
+    std::vector<int32_t> vals;
+    while (iter.Advance()) {
+      for (auto *vpi = iter.GetVectorProjectionIterator(); vpi->HasNext(); vpi->Advance()) {
+        vals.push_back(*vpi->GetValue<int32_t, false>(0, nullptr));
+      }
+    }
+    return vals;
+  };
+
+  // colA holds the values [0, TEST1_SIZE), no block can hold a larger value
+  {
+    FilterManager filter{exec_ctx_->GetExecutionSettings()};
+    filter.StartNewClause();
+    filter.InsertClauseZoneMapTerm(0, FilterManager::ZoneMapComparison::GreaterThanEqual, sql::TEST1_SIZE);
+    EXPECT_TRUE(scan(filter).empty());
+  }
+
+  // Every block may hold a non-negative value
+  {
+    FilterManager filter{exec_ctx_->GetExecutionSettings()};
+    filter.StartNewClause();
+    filter.InsertClauseZoneMapTerm(0, FilterManager::ZoneMapComparison::GreaterThanEqual, 0);
+    EXPECT_EQ(sql::TEST1_SIZE, scan(filter).size());
+  }
+
+  // colA < 0 OR colA == TEST1_SIZE - 1: the block holding the last value is not skipped
+  {
+    FilterManager filter{exec_ctx_->GetExecutionSettings()};
+    filter.StartNewClause();
+    filter.InsertClauseZoneMapTerm(0, FilterManager::ZoneMapComparison::LessThan, 0);
+    filter.StartNewClause();
+    filter.InsertClauseZoneMapTerm(0, FilterManager::ZoneMapComparison::Equal, sql::TEST1_SIZE - 1);
+    const auto vals = scan(filter);
+    const auto last_val = static_cast<int32_t>(sql::TEST1_SIZE - 1);
+    EXPECT_NE(std::find(vals.begin(), vals.end(), last_val), vals.end());
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(TableVectorIteratorTest, ParallelScanTest) {
   //
@@ -168,4 +230,66 @@ TEST_F(TableVectorIteratorTest, ParallelScanTest) {
   EXPECT_EQ(sql::TEST1_SIZE, aggregate_tuple_count);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, NumaParallelScanTest) {
+  //
+  // Check that a parallel scan of a table whose blocks are spread over NUMA nodes sees every tuple exactly once. The
+  // machine is emulated to have the nodes 0 and 2 but no node 1, as a kernel may report them.
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "index_test_table");
+  auto table = exec_ctx_->GetAccessor()->GetTable(table_oid);
+  std::unordered_map<storage::RawBlock *, uint16_t> block_nodes;
+  for (const auto &slot : *table) {
+    auto *block = slot.GetBlock();
+    if (block_nodes.count(block) == 0) block_nodes.emplace(block, block->numa_node_);
+  }
+  ASSERT_GT(block_nodes.size(), 1u);
+
+  const auto node_dir =
+      std::filesystem::path("/tmp/noisepage-numa.TEMP." + std::to_string(execution::util::FastRand().Next()));
+  for (const auto node : {"node0", "node2"}) {
+    std::filesystem::create_directories(node_dir / node);
+    std::ofstream(node_dir / node / "cpulist") << "0-" << std::max(std::thread::hardware_concurrency(), 1u) - 1;
+  }
+  std::ofstream(node_dir / "online") << "0,2";
+  common::NumaUtil::LoadTopology(node_dir);
+  std::filesystem::remove_all(node_dir);
+  EXPECT_EQ(3u, common::NumaUtil::NumNodes());
+  EXPECT_FALSE(common::NumaUtil::PinThreadToNode(1));
+
+  // Place every other block of the table on node 2
+  uint16_t node = 0;
+  for (auto &block_node : block_nodes) {
+    block_node.first->numa_node_ = node;
+    node = 2 - node;
+  }
+
+  struct Counter {
+    uint32_t c_;
+  };
+  auto init_count = [](void *ctx, void *tls) { reinterpret_cast<Counter *>(tls)->c_ = 0; };
+  auto scanner = [](UNUSED_ATTRIBUTE void *state, void *tls, TableVectorIterator *tvi) {
+    auto *counter = reinterpret_cast<Counter *>(tls);
+    while (tvi->Advance()) {
+      for (auto *vpi = tvi->GetVectorProjectionIterator(); vpi->HasNext(); vpi->Advance()) {
+        counter->c_++;
+      }
+    }
+  };
+  exec_ctx_->GetThreadStateContainer()->Reset(sizeof(Counter), init_count, nullptr, exec_ctx_.get());
+  std::array<uint32_t, 1> col_oids{1};
+  TableVectorIterator::ParallelScan(table_oid.UnderlyingValue(), col_oids.data(), col_oids.size(), nullptr,
+                                    exec_ctx_.get(), 0, scanner);
+
+  uint32_t aggregate_tuple_count = 0;
+  exec_ctx_->GetThreadStateContainer()->ForEach<Counter>(
+      [&](Counter *counter) { aggregate_tuple_count += counter->c_; });
+  EXPECT_EQ(sql::INDEX_TEST_SIZE, aggregate_tuple_count);
+
+  // Give the blocks and the machine back their own nodes
+  for (auto &[block, original_node] : block_nodes) block->numa_node_ = original_node;
+  common::NumaUtil::LoadTopology(common::NumaUtil::SYSFS_NODE_DIR);
+}
+
 }  // namespace noisepage::execution::sql::test
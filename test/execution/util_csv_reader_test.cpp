@@ -1,9 +1,12 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "execution/tpl_test.h"
-// #include "execution/util/csv_reader.h" Fix later.
+#include "execution/util/csv_reader.h"
 #include "execution/util/file.h"
 
-// TODO(WAN): csv is broken.
-#if 0
 namespace noisepage::execution::util::test {
 
 class CSVReaderTest : public TplTest {
@@ -72,6 +75,22 @@ TEST_F(CSVReaderTest, Emptycells_AndRows) {
   EXPECT_EQ("six", reader.GetRow()->cells_[2].AsString());
 }
 
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, QuotedEmptyCells) {
+  CSVReader reader(MakeSource("\"\",,\"x\",y\n"));
+  reader.Initialize();
+
+  // Only the unquoted empty cell is NULL
+  EXPECT_TRUE(reader.Advance());
+  EXPECT_EQ(4u, reader.GetRow()->count_);
+  EXPECT_TRUE(reader.GetRow()->cells_[0].IsEmpty());
+  EXPECT_FALSE(reader.GetRow()->cells_[0].IsNull());
+  EXPECT_TRUE(reader.GetRow()->cells_[1].IsNull());
+  EXPECT_TRUE(reader.GetRow()->cells_[2].quoted_);
+  EXPECT_FALSE(reader.GetRow()->cells_[2].IsNull());
+  EXPECT_FALSE(reader.GetRow()->cells_[3].quoted_);
+}
+
 // NOLINTNEXTLINE
 TEST_F(CSVReaderTest, CheckUnquoted) {
   CSVReader reader(
@@ -138,5 +157,139 @@ TEST_F(CSVReaderTest, CheckUnquoted) {
   EXPECT_FALSE(reader.Advance());
 }
 
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, CheckStream) {
+  auto source = std::make_unique<CSVStream>();
+  auto *stream = source.get();
+  CSVReader reader(std::move(source));
+  ASSERT_TRUE(reader.Initialize());
+
+  // Nothing to read yet
+  EXPECT_FALSE(reader.Advance());
+
+  // Chunks end in the middle of a row and in the middle of a quoted cell
+  stream->Append("1,one\n2,\"tw", 11);
+  EXPECT_TRUE(reader.Advance());
+  EXPECT_EQ(1, reader.GetRow()->cells_[0].AsInteger());
+  EXPECT_EQ("one", reader.GetRow()->cells_[1].AsString());
+  EXPECT_FALSE(reader.Advance());
+
+  stream->Append("o\n\"\n-3,three", 12);
+  EXPECT_TRUE(reader.Advance());
+  EXPECT_EQ(2, reader.GetRow()->cells_[0].AsInteger());
+  EXPECT_EQ("two\n", reader.GetRow()->cells_[1].AsString());
+  EXPECT_FALSE(reader.Advance());
+
+  // The last row is only complete once the stream is finished
+  stream->Finish();
+  EXPECT_TRUE(reader.Advance());
+  EXPECT_EQ(-3, reader.GetRow()->cells_[0].AsInteger());
+  EXPECT_EQ("three", reader.GetRow()->cells_[1].AsString());
+  EXPECT_FALSE(reader.Advance());
+  EXPECT_EQ(3u, reader.GetRecordNumber());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, CheckMappedFileSplit) {
+  // Rows with quoted new lines and escaped quotes, so that many split points fall inside quoted values. The last row
+  // isn't terminated.
+  std::string data;
+  std::vector<std::string> expected;
+  for (uint32_t i = 0; i < 200; i++) {
+    const auto value = "line " + std::to_string(i) + "\n\"quoted\"\n";
+    data += std::to_string(i) + ",\"" + "line " + std::to_string(i) + "\n\"\"quoted\"\"\n\"";
+    if (i < 199) data += "\n";
+    expected.push_back(value);
+  }
+
+  const std::string path = "/tmp/noisepage_csv_reader_test.csv";
+  std::ofstream(path, std::ios::binary) << data;
+
+  {
+    CSVMappedFile file(path);
+    ASSERT_TRUE(file.Initialize());
+    EXPECT_EQ(data.size() + 1, file.GetDataSize());
+
+    for (const std::size_t num_chunks : {1, 2, 3, 7, 64, 1000}) {
+      const auto offsets = file.Split(num_chunks, ',', '"', '"');
+      ASSERT_GE(offsets.size(), 2u);
+      EXPECT_LE(offsets.size(), num_chunks + 1);
+      EXPECT_EQ(0u, offsets.front());
+      EXPECT_EQ(file.GetDataSize(), offsets.back());
+
+      // Every row is read by exactly one chunk, in order
+      uint32_t row = 0;
+      for (std::size_t i = 0; i + 1 < offsets.size(); i++) {
+        const char *begin = file.GetData() + offsets[i], *end = file.GetData() + offsets[i + 1];
+        CSVReader reader(std::make_unique<CSVMappedChunk>(begin, end));
+        EXPECT_EQ('\n', *(end - 1));
+        ASSERT_TRUE(reader.Initialize());
+        while (reader.Advance()) {
+          ASSERT_LT(row, expected.size());
+          ASSERT_EQ(2u, reader.GetRow()->count_);
+          EXPECT_EQ(static_cast<int64_t>(row), reader.GetRowCell(0)->AsInteger());
+          EXPECT_EQ(expected[row], reader.GetRowCellString(1));
+          row++;
+        }
+      }
+      EXPECT_EQ(expected.size(), row);
+    }
+  }
+
+  std::remove(path.c_str());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVReaderTest, CheckMappedFileSplitMatchesReader) {
+  // Quotes inside unquoted values, escaped quotes and delimiters inside quoted values, and rows ending in \n, \r\n
+  // and a bare \r. A split must never fall where the reader doesn't end a row.
+  std::string data;
+  for (uint32_t i = 0; i < 500; i++) {
+    data += std::to_string(i) + ",5\"6 and \"\"7,\"a,\r\nb \"\"" + std::to_string(i) + "\"\"\",\"\"";
+    data += i % 3 == 0 ? "\n" : (i % 3 == 1 ? "\r\n" : "\r");
+  }
+
+  const std::string path = "/tmp/noisepage_csv_reader_split_test.csv";
+  std::ofstream(path, std::ios::binary) << data;
+
+  {
+    CSVMappedFile file(path);
+    ASSERT_TRUE(file.Initialize());
+    const char *begin = file.GetData(), *end = file.GetData() + file.GetDataSize();
+
+    // Read every row through a single reader first
+    std::vector<std::vector<std::string>> expected;
+    CSVReader whole(std::make_unique<CSVMappedChunk>(begin, end));
+    ASSERT_TRUE(whole.Initialize());
+    while (whole.Advance()) {
+      std::vector<std::string> cells;
+      for (uint32_t i = 0; i < whole.GetRow()->count_; i++) cells.emplace_back(whole.GetRowCellString(i));
+      expected.emplace_back(std::move(cells));
+    }
+    ASSERT_EQ(500u, expected.size());
+    EXPECT_EQ("a,\r\nb \"0\"", expected[0][2]);
+    EXPECT_EQ("", expected[0][3]);
+
+    for (const std::size_t num_chunks : {2, 3, 7, 64, 499, 5000}) {
+      const auto offsets = file.Split(num_chunks, ',', '"', '"');
+      uint32_t row = 0;
+      for (std::size_t i = 0; i + 1 < offsets.size(); i++) {
+        CSVReader reader(std::make_unique<CSVMappedChunk>(begin + offsets[i], begin + offsets[i + 1]));
+        ASSERT_TRUE(reader.Initialize());
+        while (reader.Advance()) {
+          ASSERT_LT(row, expected.size());
+          ASSERT_EQ(expected[row].size(), reader.GetRow()->count_);
+          for (uint32_t j = 0; j < reader.GetRow()->count_; j++) {
+            EXPECT_EQ(expected[row][j], reader.GetRowCellString(j)) << "row " << row << " cell " << j;
+          }
+          row++;
+        }
+      }
+      EXPECT_EQ(expected.size(), row) << num_chunks << " chunks";
+    }
+  }
+
+  std::remove(path.c_str());
+}
+
 }  // namespace noisepage::execution::util::test
-#endif
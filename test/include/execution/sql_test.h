@@ -75,6 +75,14 @@ class SqlBasedTest : public TplTest {
     return catalog_->GetAccessor(common::ManagedPointer(test_txn_), test_db_oid_, DISABLED);
   }
 
+  /** Set the memory budget of all execution contexts subsequently created through MakeExecCtx(). */
+  void SetQueryMemoryBudget(uint64_t budget) { exec_settings_->query_memory_budget_ = budget; }
+
+  /** Set the number of parallel execution threads of all execution contexts subsequently created by MakeExecCtx(). */
+  void SetNumParallelExecutionThreads(int num_threads) {
+    exec_settings_->number_of_parallel_execution_threads_ = num_threads;
+  }
+
  protected:
   std::unique_ptr<catalog::CatalogAccessor> accessor_;
   catalog::db_oid_t test_db_oid_{0};
@@ -0,0 +1,127 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "optimizer/cost_model/cost_model_util.h"
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/memo.h"
+#include "optimizer/physical_operators.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::optimizer {
+
+class CostModelTest : public TerrierTest {
+ protected:
+  void SetUp() override {
+    TerrierTest::SetUp();
+    deferred_action_manager_ =
+        std::make_unique<transaction::DeferredActionManager>(common::ManagedPointer(&timestamp_manager_));
+    buffer_pool_ = std::make_unique<storage::RecordBufferSegmentPool>(100, 2);
+    txn_manager_ = std::make_unique<transaction::TransactionManager>(
+        common::ManagedPointer(&timestamp_manager_), common::ManagedPointer(deferred_action_manager_),
+        common::ManagedPointer(buffer_pool_), false, false, nullptr);
+    txn_ = txn_manager_->BeginTransaction();
+  }
+
+  void TearDown() override {
+    // All operators created for the tests are cleaned up on abort
+    txn_manager_->Abort(txn_);
+    delete txn_;
+    TerrierTest::TearDown();
+  }
+
+  /** @return a sequential scan of a table of the given number of rows, -1 leaves the stats missing */
+  GroupExpression *Scan(const int64_t num_rows) {
+    const auto table_oid = catalog::table_oid_t(tables_++);
+    auto *gexpr = Insert(SeqScan::Make(catalog::db_oid_t(1), table_oid, {},
+                                       parser::AliasType("t" + std::to_string(table_oid.UnderlyingValue())), false),
+                         {}, num_rows);
+    if (num_rows >= 0) memo_.GetGroupByID(gexpr->GetGroupID())->SetTableNumRows(num_rows);
+    return gexpr;
+  }
+
+  /** @return the expression of the operator, in a new group that produces the given number of rows */
+  GroupExpression *Insert(Operator op, std::vector<group_id_t> &&children, const int64_t num_rows) {
+    auto *gexpr =
+        memo_.InsertExpression(new GroupExpression(op.RegisterWithTxnContext(txn_), std::move(children), txn_), false);
+    if (num_rows >= 0) memo_.GetGroupByID(gexpr->GetGroupID())->SetNumRows(num_rows);
+    return gexpr;
+  }
+
+  /** @return the cost of the expression under the cost-based model */
+  double Cost(GroupExpression *gexpr) { return CostBasedCostModel().CalculateCost(txn_, nullptr, &memo_, gexpr); }
+
+  /** @return the cost of a hash join of the two scans */
+  double HashJoinCost(GroupExpression *left, GroupExpression *right, const int64_t num_rows) {
+    return Cost(Insert(InnerHashJoin::Make({}, {}, {}), {left->GetGroupID(), right->GetGroupID()}, num_rows));
+  }
+
+  transaction::TimestampManager timestamp_manager_;
+  std::unique_ptr<transaction::DeferredActionManager> deferred_action_manager_;
+  std::unique_ptr<storage::RecordBufferSegmentPool> buffer_pool_;
+  std::unique_ptr<transaction::TransactionManager> txn_manager_;
+  transaction::TransactionContext *txn_;
+  Memo memo_;
+  uint32_t tables_ = 1;
+};
+
+// Tests that the names of the optimizer_cost_model setting select the cost models
+// NOLINTNEXTLINE
+TEST_F(CostModelTest, SelectionTest) {
+  EXPECT_EQ(CostModelType::TRIVIAL, CostModelUtil::FromCostModelString("TRIVIAL"));
+  EXPECT_EQ(CostModelType::COST_BASED, CostModelUtil::FromCostModelString("COST_BASED"));
+  EXPECT_EQ(std::nullopt, CostModelUtil::FromCostModelString("cost_based"));
+  EXPECT_EQ(std::nullopt, CostModelUtil::FromCostModelString(""));
+
+  auto trivial = CostModelUtil::CreateCostModel(CostModelType::TRIVIAL);
+  EXPECT_NE(nullptr, dynamic_cast<TrivialCostModel *>(trivial.get()));
+  auto cost_based = CostModelUtil::CreateCostModel(CostModelType::COST_BASED);
+  EXPECT_NE(nullptr, dynamic_cast<CostBasedCostModel *>(cost_based.get()));
+}
+
+// Tests that scans cost more on larger tables, and that an index scan that does not narrow down the table costs more
+// than a sequential scan of it
+// NOLINTNEXTLINE
+TEST_F(CostModelTest, ScanTest) {
+  auto *small = Scan(100), *large = Scan(100000);
+  EXPECT_LT(Cost(small), Cost(large));
+
+  auto *index_scan = Insert(IndexScan::Make(catalog::db_oid_t(1), catalog::table_oid_t(tables_++),
+                                            catalog::index_oid_t(1), {}, false,
+                                            planner::IndexScanType::AscendingOpenBoth, {}, false),
+                            {}, 100000);
+  memo_.GetGroupByID(index_scan->GetGroupID())->SetTableNumRows(100000);
+  EXPECT_LT(Cost(large), Cost(index_scan));
+}
+
+// Tests that a table that was never analyzed is costed with the default number of rows instead of being free
+// NOLINTNEXTLINE
+TEST_F(CostModelTest, MissingStatsTest) {
+  auto *unknown = Scan(-1), *empty = Scan(0);
+  auto *known = Scan(static_cast<int64_t>(CostBasedCostModel::DEFAULT_NUM_ROWS));
+  const auto known_cost = Cost(known);
+  EXPECT_GT(known_cost, 0);
+  EXPECT_DOUBLE_EQ(known_cost, Cost(unknown));
+  EXPECT_DOUBLE_EQ(known_cost, Cost(empty));
+
+  // Join inputs without stats count as the default number of rows too
+  auto *other = Scan(500);
+  EXPECT_DOUBLE_EQ(HashJoinCost(known, other, 10), HashJoinCost(unknown, other, 10));
+}
+
+// Tests that a hash join is cheaper when it builds its hash table on the smaller input, and that it beats a nested
+// loop join of large inputs
+// NOLINTNEXTLINE
+TEST_F(CostModelTest, JoinTest) {
+  auto *small = Scan(100), *large = Scan(100000);
+  const auto small_build_cost = HashJoinCost(small, large, 100);
+  EXPECT_LT(small_build_cost, HashJoinCost(large, small, 100));
+  EXPECT_LT(small_build_cost, Cost(Insert(InnerNLJoin::Make({}), {small->GetGroupID(), large->GetGroupID()}, 100)));
+}
+
+}  // namespace noisepage::optimizer
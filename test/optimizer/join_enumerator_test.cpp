@@ -0,0 +1,171 @@
+#include "optimizer/join_enumerator.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/logical_operators.h"
+#include "optimizer/operator_node.h"
+#include "optimizer/optimizer_context.h"
+#include "optimizer/statistics/stats_calculator.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/comparison_expression.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::optimizer {
+
+class JoinEnumeratorTest : public TerrierTest {
+ protected:
+  /** Tables joined by a plan, as the sets of table aliases of the two children of a join */
+  using JoinShape = std::pair<std::set<std::string>, std::set<std::string>>;
+
+  void SetUp() override {
+    TerrierTest::SetUp();
+    deferred_action_manager_ =
+        std::make_unique<transaction::DeferredActionManager>(common::ManagedPointer(&timestamp_manager_));
+    buffer_pool_ = std::make_unique<storage::RecordBufferSegmentPool>(100, 2);
+    txn_manager_ = std::make_unique<transaction::TransactionManager>(
+        common::ManagedPointer(&timestamp_manager_), common::ManagedPointer(deferred_action_manager_),
+        common::ManagedPointer(buffer_pool_), false, false, nullptr);
+    txn_ = txn_manager_->BeginTransaction();
+    context_.SetTxn(txn_);
+  }
+
+  void TearDown() override {
+    // All operators created during optimization are cleaned up on abort
+    txn_manager_->Abort(txn_);
+    delete txn_;
+    TerrierTest::TearDown();
+  }
+
+  /** @return a scan of the given table */
+  std::unique_ptr<OperatorNode> Get(const std::string &table) {
+    return std::make_unique<OperatorNode>(LogicalGet::Make(catalog::db_oid_t(1), catalog::table_oid_t(tables_++), {},
+                                                           parser::AliasType(table), false)
+                                              .RegisterWithTxnContext(txn_),
+                                          std::vector<std::unique_ptr<AbstractOptimizerNode>>{}, txn_);
+  }
+
+  /** @return a join of the two inputs on left.a = right.a */
+  std::unique_ptr<OperatorNode> Join(std::unique_ptr<OperatorNode> left, const std::string &left_table,
+                                     std::unique_ptr<OperatorNode> right, const std::string &right_table) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> columns;
+    columns.emplace_back(std::make_unique<parser::ColumnValueExpression>(parser::AliasType(left_table), "a"));
+    columns.emplace_back(std::make_unique<parser::ColumnValueExpression>(parser::AliasType(right_table), "a"));
+    predicates_.emplace_back(
+        std::make_unique<parser::ComparisonExpression>(parser::ExpressionType::COMPARE_EQUAL, std::move(columns)));
+    std::vector<AnnotatedExpression> join_predicates;
+    join_predicates.emplace_back(common::ManagedPointer(predicates_.back()),
+                                 std::unordered_set<parser::AliasType>{parser::AliasType(left_table),
+                                                                       parser::AliasType(right_table)});
+
+    std::vector<std::unique_ptr<AbstractOptimizerNode>> children;
+    children.emplace_back(std::move(left));
+    children.emplace_back(std::move(right));
+    return std::make_unique<OperatorNode>(
+        LogicalInnerJoin::Make(std::move(join_predicates)).RegisterWithTxnContext(txn_), std::move(children), txn_);
+  }
+
+  /** Record the tree into the Memo and set the number of rows of its scans, -1 leaves the stats missing */
+  group_id_t Record(std::unique_ptr<OperatorNode> tree, const std::vector<std::pair<std::string, int64_t>> &rows) {
+    GroupExpression *gexpr = nullptr;
+    context_.RecordOptimizerNodeIntoGroup(common::ManagedPointer<AbstractOptimizerNode>(tree.get()), &gexpr);
+    trees_.emplace_back(std::move(tree));
+    root_ = gexpr->GetGroupID();
+    for (const auto &[table, num_rows] : rows) {
+      if (num_rows >= 0) context_.GetMemo().GetGroupByID(FindGroup({table}))->SetNumRows(num_rows);
+    }
+    return root_;
+  }
+
+  /** @return the group below the root that scans exactly the given tables */
+  group_id_t FindGroup(const std::set<std::string> &tables) {
+    auto &memo = context_.GetMemo();
+    std::vector<group_id_t> groups{root_};
+    for (size_t i = 0; i < groups.size(); i++) {
+      auto *group = memo.GetGroupByID(groups[i]);
+      if (Aliases(group) == tables) return groups[i];
+      for (auto *gexpr : group->GetLogicalExpressions()) {
+        for (auto child : gexpr->GetChildGroupIDs()) groups.push_back(child);
+      }
+    }
+    return UNDEFINED_GROUP;
+  }
+
+  /** @return the names of the tables scanned by a group */
+  static std::set<std::string> Aliases(Group *group) {
+    std::set<std::string> aliases;
+    for (const auto &alias : group->GetTableAliases()) aliases.emplace(alias.GetName());
+    return aliases;
+  }
+
+  /** @return the shapes of the joins in the given group, with the smaller child first */
+  std::set<JoinShape> Shapes(const group_id_t group_id) {
+    std::set<JoinShape> shapes;
+    auto &memo = context_.GetMemo();
+    for (auto *gexpr : memo.GetGroupByID(group_id)->GetLogicalExpressions()) {
+      auto left = Aliases(memo.GetGroupByID(gexpr->GetChildGroupId(0)));
+      auto right = Aliases(memo.GetGroupByID(gexpr->GetChildGroupId(1)));
+      if (left.size() > right.size() || (left.size() == right.size() && left > right)) std::swap(left, right);
+      shapes.emplace(std::move(left), std::move(right));
+    }
+    return shapes;
+  }
+
+  transaction::TimestampManager timestamp_manager_;
+  std::unique_ptr<transaction::DeferredActionManager> deferred_action_manager_;
+  std::unique_ptr<storage::RecordBufferSegmentPool> buffer_pool_;
+  std::unique_ptr<transaction::TransactionManager> txn_manager_;
+  transaction::TransactionContext *txn_;
+  OptimizerContext context_{nullptr};
+  uint32_t tables_ = 1;
+  group_id_t root_ = UNDEFINED_GROUP;
+  std::vector<std::unique_ptr<parser::AbstractExpression>> predicates_;
+  std::vector<std::unique_ptr<OperatorNode>> trees_;
+};
+
+// Tests that DPccp enumerates every join order of a chain a - b - c, but never the cross product of a and c
+// NOLINTNEXTLINE
+TEST_F(JoinEnumeratorTest, DPccpChainTest) {
+  auto root = Record(Join(Join(Get("a"), "a", Get("b"), "b"), "b", Get("c"), "c"), {{"a", 10}, {"b", 10}, {"c", 10}});
+  JoinEnumerator(&context_, DEFAULT_JOIN_ENUMERATION_THRESHOLD).EnumerateJoins(root);
+
+  EXPECT_EQ((std::set<JoinShape>{{{"c"}, {"a", "b"}}, {{"a"}, {"b", "c"}}}), Shapes(root));
+  EXPECT_EQ((std::set<JoinShape>{{{"b"}, {"c"}}}), Shapes(FindGroup({"b", "c"})));
+  EXPECT_EQ(UNDEFINED_GROUP, FindGroup({"a", "c"}));
+}
+
+// Tests that the greedy enumeration joins the pair with the smallest estimated result first
+// NOLINTNEXTLINE
+TEST_F(JoinEnumeratorTest, GreedyTest) {
+  auto root = Record(Join(Get("a"), "a", Join(Get("b"), "b", Get("c"), "c"), "b"),
+                     {{"a", 10}, {"b", 1000}, {"c", 100000}});
+  JoinEnumerator(&context_, 0).EnumerateJoins(root);
+
+  // a joins b into 10 rows, b joins c into 1000 rows, so the greedy order only adds (a, b), c
+  EXPECT_EQ((std::set<JoinShape>{{{"a"}, {"b", "c"}}, {{"c"}, {"a", "b"}}}), Shapes(root));
+  EXPECT_EQ(10u, context_.GetMemo().GetGroupByID(FindGroup({"a", "b"}))->GetNumRows());
+}
+
+// Tests that a relation without stats is estimated with the default number of rows instead of being joined first
+// NOLINTNEXTLINE
+TEST_F(JoinEnumeratorTest, GreedyMissingStatsTest) {
+  auto root = Record(Join(Join(Get("a"), "a", Get("b"), "b"), "b", Get("c"), "c"), {{"a", -1}, {"b", 100}, {"c", 50}});
+  JoinEnumerator(&context_, 0).EnumerateJoins(root);
+
+  // Counting a as empty would join it with b first. With the default estimate, b joins c into fewer rows.
+  EXPECT_EQ((std::set<JoinShape>{{{"c"}, {"a", "b"}}, {{"a"}, {"b", "c"}}}), Shapes(root));
+  EXPECT_EQ(50u, context_.GetMemo().GetGroupByID(FindGroup({"b", "c"}))->GetNumRows());
+  EXPECT_EQ(StatsCalculator::DEFAULT_NUM_ROWS * 100,
+            StatsCalculator::EstimateCardinalityForJoin(Group::UNINITIALIZED_NUM_ROWS, 100, {}));
+}
+
+}  // namespace noisepage::optimizer
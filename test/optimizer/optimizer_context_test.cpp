@@ -1,10 +1,16 @@
 #include "optimizer/optimizer_context.h"
 
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <functional>
 #include <memory>
 #include <stack>
+#include <stdexcept>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
+#include "common/worker_pool.h"
 #include "optimizer/binding.h"
 #include "optimizer/logical_operators.h"
 #include "optimizer/optimizer_defs.h"
@@ -25,6 +31,38 @@ struct OptimizerContextTest : public TerrierTest {
   void TearDown() override { TerrierTest::TearDown(); }
 };
 
+/**
+ * Task that counts its executions and pushes children onto its task pool. Children check that they run on the thread
+ * of their parent, i.e. that a job is never split between workers.
+ */
+class CountingTask : public OptimizerTask {
+ public:
+  CountingTask(OptimizerTaskPool *pool, std::atomic<uint32_t> *count, uint32_t num_children,
+               std::function<void()> action = nullptr, std::thread::id parent = std::thread::id())
+      : OptimizerTask(nullptr, OptimizerTaskType::OPTIMIZE_GROUP),
+        pool_(pool),
+        count_(count),
+        num_children_(num_children),
+        action_(std::move(action)),
+        parent_(parent) {}
+
+  void Execute() override {
+    if (parent_ != std::thread::id()) EXPECT_EQ(parent_, std::this_thread::get_id());
+    if (action_) action_();
+    count_->fetch_add(1);
+    for (uint32_t i = 0; i < num_children_; i++) {
+      pool_->Push(new CountingTask(pool_, count_, 0, nullptr, std::this_thread::get_id()));
+    }
+  }
+
+ private:
+  OptimizerTaskPool *pool_;
+  std::atomic<uint32_t> *count_;
+  uint32_t num_children_;
+  std::function<void()> action_;
+  std::thread::id parent_;
+};
+
 // NOLINTNEXTLINE
 TEST_F(OptimizerContextTest, PatternTest) {
   // Creates a Pattern and makes sure everything is set correctly
@@ -114,6 +152,112 @@ TEST_F(OptimizerContextTest, OptimizerContextTaskStackNullptrTest) {
   context.SetTaskPool(nullptr);
 }
 
+// Tests that the concurrent task pool runs every job and the tasks they push on the calling thread and the workers
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, ConcurrentTaskPoolTest) {
+  common::WorkerPool workers(3, {});
+  workers.Startup();
+
+  ConcurrentOptimizerTaskPool task_pool{common::ManagedPointer(&workers)};
+  std::atomic<uint32_t> count{0};
+  for (uint32_t i = 0; i < 16; i++) task_pool.Push(new CountingTask(&task_pool, &count, 3));
+  EXPECT_FALSE(task_pool.Empty());
+
+  task_pool.Execute(60000);
+  EXPECT_EQ(64u, count.load());
+  EXPECT_TRUE(task_pool.Empty());
+  workers.Shutdown();
+}
+
+// Tests that the first exception thrown by a task is rethrown once the workers have stopped
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, ConcurrentTaskPoolErrorTest) {
+  common::WorkerPool workers(3, {});
+  workers.Startup();
+
+  ConcurrentOptimizerTaskPool task_pool{common::ManagedPointer(&workers)};
+  std::atomic<uint32_t> count{0};
+  for (uint32_t i = 0; i < 16; i++) {
+    task_pool.Push(new CountingTask(&task_pool, &count, 3, [i] {
+      if (i == 7) throw std::runtime_error("task failed");
+    }));
+  }
+
+  EXPECT_THROW(task_pool.Execute(60000), std::runtime_error);
+  EXPECT_LT(count.load(), 64u);
+  workers.Shutdown();
+}
+
+// Tests that no job is started once the budget is spent, and that jobs that did not start stay in the pool
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, ConcurrentTaskPoolBudgetTest) {
+  std::atomic<uint32_t> count{0};
+  const auto sleep = [] { std::this_thread::sleep_for(std::chrono::milliseconds(20)); };
+  {
+    ConcurrentOptimizerTaskPool task_pool(nullptr);
+    for (uint32_t i = 0; i < 10; i++) task_pool.Push(new CountingTask(&task_pool, &count, 0, sleep));
+    task_pool.Execute(0);
+    EXPECT_EQ(0u, count.load());
+    EXPECT_FALSE(task_pool.Empty());
+  }
+
+  {
+    ConcurrentOptimizerTaskPool task_pool(nullptr);
+    for (uint32_t i = 0; i < 10; i++) task_pool.Push(new CountingTask(&task_pool, &count, 2, sleep));
+    task_pool.Execute(30);
+    // Jobs that started ran to completion
+    EXPECT_GT(count.load(), 0u);
+    EXPECT_LT(count.load(), 30u);
+    EXPECT_EQ(0u, count.load() % 3);
+
+    uint32_t num_left = 0;
+    while (!task_pool.Empty()) {
+      delete task_pool.Pop();
+      num_left++;
+    }
+    EXPECT_EQ(10u, count.load() / 3 + num_left);
+  }
+}
+
+// Tests that queries share the worker pool, and that a query does not wait for the shared workers while they are busy
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, ConcurrentTaskPoolSharedWorkersTest) {
+  common::WorkerPool workers(2, {});
+  workers.Startup();
+
+  std::vector<std::thread> queries;
+  std::vector<std::atomic<uint32_t>> counts(4);
+  for (uint32_t i = 0; i < 4; i++) {
+    queries.emplace_back([&, i] {
+      ConcurrentOptimizerTaskPool task_pool{common::ManagedPointer(&workers)};
+      for (uint32_t j = 0; j < 32; j++) task_pool.Push(new CountingTask(&task_pool, &counts[i], 1));
+      task_pool.Execute(60000);
+    });
+  }
+  for (auto &query : queries) query.join();
+  for (auto &count : counts) EXPECT_EQ(64u, count.load());
+
+  // Occupy every shared worker, the query then runs all of its jobs on the calling thread
+  std::atomic<bool> release{false};
+  for (uint32_t i = 0; i < 2; i++) {
+    workers.SubmitTask([&] {
+      while (!release.load()) std::this_thread::yield();
+    });
+  }
+  std::atomic<uint32_t> count{0};
+  {
+    ConcurrentOptimizerTaskPool task_pool{common::ManagedPointer(&workers)};
+    for (uint32_t j = 0; j < 32; j++) task_pool.Push(new CountingTask(&task_pool, &count, 1));
+    task_pool.Execute(60000);
+  }
+  EXPECT_EQ(64u, count.load());
+
+  // The workers submitted for the query find it finished once they run
+  release.store(true);
+  workers.WaitUntilAllFinished();
+  workers.Shutdown();
+}
+
 // NOLINTNEXTLINE
 TEST_F(OptimizerContextTest, RecordOperatorNodeIntoGroupDuplicateSingleLayer) {
   auto context = OptimizerContext(nullptr);
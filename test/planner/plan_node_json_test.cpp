@@ -33,6 +33,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
@@ -616,6 +617,7 @@ TEST(PlanNodeJsonTest, HashJoinPlanNodeJoinTest) {
           .SetJoinPredicate(common::ManagedPointer(join_pred))
           .AddLeftHashKey(common::ManagedPointer(left_hash_key).CastManagedPointerTo<parser::AbstractExpression>())
           .AddRightHashKey(common::ManagedPointer(right_hash_key).CastManagedPointerTo<parser::AbstractExpression>())
+          .SetBloomFilterPushdown(true)
           .Build();
 
   // Serialize to Json
@@ -627,6 +629,7 @@ TEST(PlanNodeJsonTest, HashJoinPlanNodeJoinTest) {
   auto deserialized_plan = common::ManagedPointer(deserialized.result_).CastManagedPointerTo<HashJoinPlanNode>();
   EXPECT_TRUE(deserialized_plan != nullptr);
   EXPECT_EQ(PlanNodeType::HASHJOIN, deserialized_plan->GetPlanNodeType());
+  EXPECT_TRUE(deserialized_plan->IsBloomFilterPushdown());
   EXPECT_EQ(*plan_node, *deserialized_plan);
   EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
 }
@@ -742,6 +745,34 @@ TEST(PlanNodeJsonTest, LimitPlanNodeJsonTest) {
   EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
 }
 
+// NOLINTNEXTLINE
+TEST(PlanNodeJsonTest, MergeJoinPlanNodeJoinTest) {
+  // Construct MergeJoinPlanNode
+  auto left_merge_key = std::make_unique<parser::ColumnValueExpression>(parser::AliasType("table1"), "col1");
+  auto right_merge_key = std::make_unique<parser::ColumnValueExpression>(parser::AliasType("table2"), "col2");
+  auto join_pred = PlanNodeJsonTest::BuildDummyPredicate();
+  MergeJoinPlanNode::Builder builder;
+  auto plan_node =
+      builder.SetOutputSchema(PlanNodeJsonTest::BuildDummyOutputSchema())
+          .SetJoinType(LogicalJoinType::INNER)
+          .SetJoinPredicate(common::ManagedPointer(join_pred))
+          .AddLeftMergeKey(common::ManagedPointer(left_merge_key).CastManagedPointerTo<parser::AbstractExpression>())
+          .AddRightMergeKey(common::ManagedPointer(right_merge_key).CastManagedPointerTo<parser::AbstractExpression>())
+          .Build();
+
+  // Serialize to Json
+  auto json = plan_node->ToJson();
+  EXPECT_FALSE(json.is_null());
+
+  // Deserialize plan node
+  auto deserialized = DeserializePlanNode(json);
+  auto deserialized_plan = common::ManagedPointer(deserialized.result_).CastManagedPointerTo<MergeJoinPlanNode>();
+  EXPECT_TRUE(deserialized_plan != nullptr);
+  EXPECT_EQ(PlanNodeType::MERGEJOIN, deserialized_plan->GetPlanNodeType());
+  EXPECT_EQ(*plan_node, *deserialized_plan);
+  EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
+}
+
 // NOLINTNEXTLINE
 TEST(PlanNodeJsonTest, NestedLoopJoinPlanNodeJoinTest) {
   // Construct NestedLoopJoinPlanNode
@@ -0,0 +1,153 @@
+#include "replication/replication_messages.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/error/exception.h"
+#include "common/json.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::replication {
+
+class ReplicationMessagesTest : public TerrierTest {
+ protected:
+  /** @return the message, serialized in the given format and parsed back into the given type of message */
+  template <typename Msg>
+  static std::unique_ptr<Msg> RoundTrip(const BaseReplicationMessage &msg, const ReplicationMessageFormat format) {
+    auto parsed = BaseReplicationMessage::ParseFromString(msg.Serialize(format));
+    EXPECT_EQ(msg.GetMessageType(), parsed->GetMessageType());
+    EXPECT_EQ(msg.GetMessageId(), parsed->GetMessageId());
+    EXPECT_EQ(msg.GetMetadata().GetRequestedFormat(), parsed->GetMetadata().GetRequestedFormat());
+    return std::unique_ptr<Msg>(dynamic_cast<Msg *>(parsed.release()));
+  }
+
+  /** @return the metadata of a message from a node that predates the BINARY format */
+  static MessageWrapper LegacyMetadata(const msg_id_t msg_id) {
+    MessageWrapper metadata;
+    metadata.Put("message_id", msg_id);
+    return metadata;
+  }
+
+  /** @return the messages that every prefix of which should be rejected */
+  std::vector<std::unique_ptr<BaseReplicationMessage>> Messages() {
+    std::vector<std::unique_ptr<BaseReplicationMessage>> messages;
+    messages.emplace_back(std::make_unique<NotifyOATMsg>(ReplicationMessageMetadata(msg_id_t{1}), record_batch_id_t{2},
+                                                         transaction::timestamp_t{3}));
+    messages.emplace_back(
+        std::make_unique<RecordsBatchMsg>(ReplicationMessageMetadata(msg_id_t{4}), record_batch_id_t{5}, &buffer_));
+    messages.emplace_back(
+        std::make_unique<TxnAppliedMsg>(ReplicationMessageMetadata(msg_id_t{6}), transaction::timestamp_t{7}));
+    return messages;
+  }
+
+  void SetUp() override {
+    TerrierTest::SetUp();
+    const std::string records = "log records";
+    buffer_.BufferWrite(records.data(), records.size());
+  }
+
+  storage::BufferedLogWriter buffer_{"/dev/null"};
+};
+
+// Tests that every type of message reads back the same in both formats, including the format its sender asked for
+// NOLINTNEXTLINE
+TEST_F(ReplicationMessagesTest, RoundTripTest) {
+  for (const auto format : {ReplicationMessageFormat::BINARY, ReplicationMessageFormat::MSGPACK}) {
+    for (const auto requested_format : {ReplicationMessageFormat::BINARY, ReplicationMessageFormat::MSGPACK}) {
+      const NotifyOATMsg oat(ReplicationMessageMetadata(msg_id_t{1}, requested_format), record_batch_id_t{2},
+                             transaction::timestamp_t{3});
+      const auto parsed_oat = RoundTrip<NotifyOATMsg>(oat, format);
+      ASSERT_NE(nullptr, parsed_oat);
+      EXPECT_EQ(oat.GetBatchId(), parsed_oat->GetBatchId());
+      EXPECT_EQ(oat.GetOldestActiveTxn(), parsed_oat->GetOldestActiveTxn());
+
+      const RecordsBatchMsg batch(ReplicationMessageMetadata(msg_id_t{4}, requested_format), record_batch_id_t{5},
+                                  &buffer_);
+      const auto parsed_batch = RoundTrip<RecordsBatchMsg>(batch, format);
+      ASSERT_NE(nullptr, parsed_batch);
+      EXPECT_EQ(batch.GetBatchId(), parsed_batch->GetBatchId());
+      EXPECT_EQ("log records", parsed_batch->GetContents());
+      EXPECT_FALSE(parsed_batch->IsCompressed());
+
+      const TxnAppliedMsg applied(ReplicationMessageMetadata(msg_id_t{6}, requested_format),
+                                  transaction::timestamp_t{7});
+      const auto parsed_applied = RoundTrip<TxnAppliedMsg>(applied, format);
+      ASSERT_NE(nullptr, parsed_applied);
+      EXPECT_EQ(applied.GetAppliedTxnId(), parsed_applied->GetAppliedTxnId());
+    }
+  }
+
+  // Messages ask for this node's preferred format unless told otherwise
+  EXPECT_EQ(ReplicationMessageMetadata::PREFERRED_FORMAT,
+            ReplicationMessageMetadata(msg_id_t{1}).GetRequestedFormat());
+  const RecordsBatchMsg batch(ReplicationMessageMetadata(msg_id_t{1}), record_batch_id_t{1}, &buffer_);
+  EXPECT_LT(batch.Serialize(ReplicationMessageFormat::BINARY).size(),
+            batch.Serialize(ReplicationMessageFormat::MSGPACK).size());
+}
+
+// Tests that messages from nodes that predate the BINARY format are decoded, and that those nodes are taken to ask for
+// MSGPACK
+// NOLINTNEXTLINE
+TEST_F(ReplicationMessagesTest, LegacyDecodeTest) {
+  MessageWrapper oat;
+  oat.Put("message_type", std::string("NOTIFY_OAT"));
+  oat.Put("metadata", LegacyMetadata(msg_id_t{1}));
+  oat.Put("oat_batch", record_batch_id_t{2});
+  oat.Put("oat_ts", transaction::timestamp_t{3});
+  const auto parsed_oat = BaseReplicationMessage::ParseFromString(oat.Serialize());
+  ASSERT_EQ(ReplicationMessageType::NOTIFY_OAT, parsed_oat->GetMessageType());
+  EXPECT_EQ(msg_id_t{1}, parsed_oat->GetMessageId());
+  EXPECT_EQ(ReplicationMessageFormat::MSGPACK, parsed_oat->GetMetadata().GetRequestedFormat());
+  EXPECT_EQ(record_batch_id_t{2}, dynamic_cast<const NotifyOATMsg &>(*parsed_oat).GetBatchId());
+  EXPECT_EQ(transaction::timestamp_t{3}, dynamic_cast<const NotifyOATMsg &>(*parsed_oat).GetOldestActiveTxn());
+
+  // Legacy batches are never compressed, and say nothing about it
+  MessageWrapper batch;
+  batch.Put("message_type", std::string("RECORDS_BATCH"));
+  batch.Put("metadata", LegacyMetadata(msg_id_t{4}));
+  batch.Put("batch_id", record_batch_id_t{5});
+  batch.Put("contents", std::string("log records"));
+  const auto parsed_batch = BaseReplicationMessage::ParseFromString(batch.Serialize());
+  ASSERT_EQ(ReplicationMessageType::RECORDS_BATCH, parsed_batch->GetMessageType());
+  EXPECT_EQ(ReplicationMessageFormat::MSGPACK, parsed_batch->GetMetadata().GetRequestedFormat());
+  EXPECT_EQ(record_batch_id_t{5}, dynamic_cast<const RecordsBatchMsg &>(*parsed_batch).GetBatchId());
+  EXPECT_EQ("log records", dynamic_cast<const RecordsBatchMsg &>(*parsed_batch).GetContents());
+  EXPECT_FALSE(dynamic_cast<const RecordsBatchMsg &>(*parsed_batch).IsCompressed());
+
+  MessageWrapper applied;
+  applied.Put("message_type", std::string("TXN_APPLIED"));
+  applied.Put("metadata", LegacyMetadata(msg_id_t{6}));
+  applied.Put("applied_txn_id", transaction::timestamp_t{7});
+  const auto parsed_applied = BaseReplicationMessage::ParseFromString(applied.Serialize());
+  ASSERT_EQ(ReplicationMessageType::TXN_APPLIED, parsed_applied->GetMessageType());
+  EXPECT_EQ(ReplicationMessageFormat::MSGPACK, parsed_applied->GetMetadata().GetRequestedFormat());
+  EXPECT_EQ(transaction::timestamp_t{7}, dynamic_cast<const TxnAppliedMsg &>(*parsed_applied).GetAppliedTxnId());
+}
+
+// Tests that a message cut short anywhere is rejected in both formats instead of being read past its end
+// NOLINTNEXTLINE
+TEST_F(ReplicationMessagesTest, TruncatedMessageTest) {
+  for (const auto format : {ReplicationMessageFormat::BINARY, ReplicationMessageFormat::MSGPACK}) {
+    for (const auto &msg : Messages()) {
+      const std::string serialized = msg->Serialize(format);
+      for (size_t size = 0; size < serialized.size(); size++) {
+        EXPECT_THROW(BaseReplicationMessage::ParseFromString(std::string_view(serialized.data(), size)),
+                     ReplicationException)
+            << ReplicationMessageTypeToString(msg->GetMessageType()) << " cut down to " << size << " bytes";
+      }
+    }
+  }
+
+  // Neither are messages of a newer BINARY format version or of an unknown type read
+  std::string serialized = Messages()[0]->Serialize(ReplicationMessageFormat::BINARY);
+  serialized[0] = 0x7F;
+  EXPECT_THROW(BaseReplicationMessage::ParseFromString(serialized), ReplicationException);
+  serialized = Messages()[0]->Serialize(ReplicationMessageFormat::BINARY);
+  serialized[1] = static_cast<char>(ReplicationMessageType::NUM_ENUM_ENTRIES);
+  EXPECT_THROW(BaseReplicationMessage::ParseFromString(serialized), ReplicationException);
+}
+
+}  // namespace noisepage::replication
@@ -1,14 +1,17 @@
 #include <memory>
 #include <string>
+#include <string_view>
 #include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 
+#include "execution/sql/value_util.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
 #include "settings/settings_callbacks.h"
 #include "settings/settings_manager.h"
 #include "test_util/test_harness.h"
+#include "traffic_cop/traffic_cop.h"
 
 namespace noisepage::settings {
 
@@ -38,6 +41,25 @@ class SettingsTests : public TerrierTest {
     buffer_segment_pool_ = db_main_->GetBufferSegmentPool();
   }
 
+  /** @return a DBMain with a traffic cop, started with the given value of optimizer_cost_model */
+  static std::unique_ptr<DBMain> BuildWithCostModel(const std::string_view cost_model) {
+    std::unordered_map<Param, ParamInfo> param_map;
+    SettingsManager::ConstructParamMap(param_map);
+    auto string_val = execution::sql::ValueUtil::CreateStringVal(cost_model);
+    param_map.find(Param::optimizer_cost_model)->second.value_ = parser::ConstantValueExpression(
+        execution::sql::SqlTypeId::Varchar, string_val.first, std::move(string_val.second));
+    return DBMain::Builder()
+        .SetSettingsParameterMap(std::move(param_map))
+        .SetUseSettingsManager(true)
+        .SetUseGC(true)
+        .SetUseCatalog(true)
+        .SetUseTrafficCop(true)
+        .SetUseStatsStorage(true)
+        .SetUseLogging(true)
+        .SetUseExecution(true)
+        .Build();
+  }
+
   static void EmptySetterCallback(common::ManagedPointer<common::ActionContext> action_context UNUSED_ATTRIBUTE) {}
 
   /**
@@ -217,6 +239,34 @@ TEST_F(SettingsTests, LogManagerSettingsTest) {
   EXPECT_EQ(new_serializatio_interval, log_manager_->GetSerializationInterval());
 }
 
+// Tests that the optimizer_cost_model setting selects the cost model of the traffic cop, and that values that do not
+// name a cost model are rejected
+// NOLINTNEXTLINE
+TEST_F(SettingsTests, OptimizerCostModelTest) {
+  EXPECT_THROW(BuildWithCostModel("BOGUS"), SettingsException);
+
+  auto db_main = BuildWithCostModel("TRIVIAL");
+  auto settings_manager = db_main->GetSettingsManager();
+  auto traffic_cop = db_main->GetTrafficCop();
+  EXPECT_EQ(optimizer::CostModelType::TRIVIAL, traffic_cop->GetCostModel());
+
+  setter_callback_fn setter_callback = SettingsTests::EmptySetterCallback;
+  auto action_context = std::make_unique<common::ActionContext>(common::action_id_t(1));
+  settings_manager->SetString(Param::optimizer_cost_model, "COST_BASED", common::ManagedPointer(action_context),
+                              setter_callback);
+  EXPECT_EQ(common::ActionState::SUCCESS, action_context->GetState());
+  EXPECT_EQ(optimizer::CostModelType::COST_BASED, traffic_cop->GetCostModel());
+
+  // A failed update leaves both the setting and the cost model as they were
+  action_context = std::make_unique<common::ActionContext>(common::action_id_t(2));
+  EXPECT_THROW(settings_manager->SetString(Param::optimizer_cost_model, "BOGUS",
+                                           common::ManagedPointer(action_context), setter_callback),
+               SettingsException);
+  EXPECT_EQ(common::ActionState::FAILURE, action_context->GetState());
+  EXPECT_EQ("COST_BASED", settings_manager->GetString(Param::optimizer_cost_model));
+  EXPECT_EQ(optimizer::CostModelType::COST_BASED, traffic_cop->GetCostModel());
+}
+
 // Test concurrent modification to buffer pool size.
 // NOLINTNEXTLINE
 TEST_F(SettingsTests, ConcurrentModifyTest) {
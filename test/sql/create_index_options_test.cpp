@@ -50,4 +50,18 @@ TEST_F(CreateIndexOptionsTest, BPlusTreeOptions) {
   ASSERT_EQ(test_2_idx_both_bpt_index->GetInnerNodeSizeLowerThreshold(), 4);
 }
 
+// NOLINTNEXTLINE
+TEST_F(CreateIndexOptionsTest, BPlusTreeFillFactor) {
+  RunQuery("CREATE INDEX test_2_idx_fill ON test_2 (col1) WITH (BPLUSTREE_FILL_FACTOR = 50)");
+
+  auto test_2_idx_fill = accessor_->GetIndex(accessor_->GetIndexOid("test_2_idx_fill"));
+  ASSERT_TRUE(test_2_idx_fill);
+  ASSERT_EQ(test_2_idx_fill->Type(), storage::index::IndexType::BPLUSTREE);
+
+  auto test_2_idx_fill_bpt_index =
+      test_2_idx_fill.CastManagedPointerTo<storage::index::BPlusTreeIndex<storage::index::CompactIntsKey<8>>>();
+  ASSERT_EQ(test_2_idx_fill_bpt_index->GetBulkLoadFillFactor(), 50);
+  ASSERT_GT(test_2_idx_fill_bpt_index->GetSize(), 0);
+}
+
 }  // namespace noisepage::test
@@ -0,0 +1,68 @@
+#include <unordered_set>
+#include <vector>
+
+#include "common/numa_util.h"
+#include "storage/storage_defs.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage {
+
+struct BlockStoreTests : public TerrierTest {
+  // Blocks are placed on the node of the calling thread, so keep the thread on one node
+  void SetUp() override { common::NumaUtil::PinThreadToNode(0); }
+
+  void TearDown() override { common::NumaUtil::UnpinThread(); }
+};
+
+// Check that blocks are aligned, placed on a node, and reused on that node
+// NOLINTNEXTLINE
+TEST_F(BlockStoreTests, ReuseTest) {
+  const uint32_t repeat = 10;
+  BlockStore tested(repeat, repeat);
+
+  std::vector<RawBlock *> blocks;
+  for (uint32_t i = 0; i < repeat; i++) {
+    RawBlock *block = tested.Get();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % common::Constants::BLOCK_SIZE, 0);
+    EXPECT_LT(BlockStore::NodeOf(block), common::NumaUtil::NumNodes());
+    // The whole block is usable
+    block->content_[sizeof(block->content_) - 1] = std::byte{1};
+    blocks.push_back(block);
+  }
+
+  // Blocks come back in reverse order of their release
+  for (RawBlock *block : blocks) tested.Release(block);
+  for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
+    // clang-tidy thinks gtest-printers will DefaultPrintTo the released pointer
+    // NOLINTNEXTLINE
+    EXPECT_EQ(tested.Get(), *it);
+  }
+  for (RawBlock *block : blocks) tested.Release(block);
+}
+
+// Check that the size and reuse limits are honored
+// NOLINTNEXTLINE
+TEST_F(BlockStoreTests, LimitTest) {
+  const uint64_t size_limit = 4;
+  BlockStore tested(size_limit, size_limit);
+
+  std::unordered_set<RawBlock *> blocks;
+  for (uint64_t i = 0; i < size_limit; i++) blocks.insert(tested.Get());
+  EXPECT_EQ(blocks.size(), size_limit);
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+  EXPECT_FALSE(tested.SetSizeLimit(size_limit - 1));
+
+  // Only half of the blocks are kept for reuse, the others are freed
+  for (RawBlock *block : blocks) tested.Release(block);
+  tested.SetReuseLimit(size_limit / 2);
+  EXPECT_TRUE(tested.SetSizeLimit(size_limit / 2));
+  std::vector<RawBlock *> reused;
+  for (uint64_t i = 0; i < size_limit / 2; i++) {
+    reused.push_back(tested.Get());
+    EXPECT_EQ(blocks.count(reused.back()), 1);
+  }
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+  for (RawBlock *block : reused) tested.Release(block);
+}
+
+}  // namespace noisepage::storage
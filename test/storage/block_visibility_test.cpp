@@ -0,0 +1,100 @@
+#include "storage/block_visibility.h"
+
+#include "test_util/test_harness.h"
+
+namespace noisepage {
+
+// Tests that a mark nobody interferes with makes the block all-visible
+// NOLINTNEXTLINE
+TEST(BlockVisibilityTest, MarkAndClear) {
+  storage::BlockVisibility tested;
+  tested.Initialize();
+  EXPECT_FALSE(tested.AllVisible());
+
+  uint64_t mark;
+  ASSERT_TRUE(tested.BeginMark(&mark));
+  EXPECT_FALSE(tested.AllVisible());
+  // A pending mark cannot be started twice
+  uint64_t other_mark;
+  EXPECT_FALSE(tested.BeginMark(&other_mark));
+  EXPECT_TRUE(tested.FinishMark(mark));
+  EXPECT_TRUE(tested.AllVisible());
+  // Neither can an all-visible block be marked again
+  EXPECT_FALSE(tested.BeginMark(&other_mark));
+
+  tested.Clear();
+  EXPECT_FALSE(tested.AllVisible());
+}
+
+// Tests that a writer clearing the block between the start and the end of a mark keeps the mark from setting the bit
+// NOLINTNEXTLINE
+TEST(BlockVisibilityTest, ClearDuringMark) {
+  storage::BlockVisibility tested;
+  tested.Initialize();
+
+  uint64_t mark;
+  ASSERT_TRUE(tested.BeginMark(&mark));
+  tested.Clear();
+  EXPECT_FALSE(tested.FinishMark(mark));
+  EXPECT_FALSE(tested.AllVisible());
+}
+
+// Tests that a stale mark cannot finish once the block was cleared and marked again, even while the new mark is
+// pending
+// NOLINTNEXTLINE
+TEST(BlockVisibilityTest, StaleFinishMark) {
+  storage::BlockVisibility tested;
+  tested.Initialize();
+
+  uint64_t stale_mark;
+  ASSERT_TRUE(tested.BeginMark(&stale_mark));
+  tested.Clear();
+
+  uint64_t mark;
+  ASSERT_TRUE(tested.BeginMark(&mark));
+  EXPECT_NE(stale_mark, mark);
+  EXPECT_FALSE(tested.FinishMark(stale_mark));
+  EXPECT_FALSE(tested.AllVisible());
+  // The new mark is unaffected by the stale one
+  EXPECT_TRUE(tested.FinishMark(mark));
+  EXPECT_TRUE(tested.AllVisible());
+
+  // Nor can the stale mark clear the bit
+  tested.CancelMark(stale_mark);
+  EXPECT_TRUE(tested.AllVisible());
+}
+
+// Tests that a cancelled mark leaves the block free to be marked again
+// NOLINTNEXTLINE
+TEST(BlockVisibilityTest, CancelMark) {
+  storage::BlockVisibility tested;
+  tested.Initialize();
+
+  uint64_t mark;
+  ASSERT_TRUE(tested.BeginMark(&mark));
+  tested.CancelMark(mark);
+  EXPECT_FALSE(tested.FinishMark(mark));
+  EXPECT_FALSE(tested.AllVisible());
+
+  ASSERT_TRUE(tested.BeginMark(&mark));
+  EXPECT_TRUE(tested.FinishMark(mark));
+  EXPECT_TRUE(tested.AllVisible());
+}
+
+// Tests the count of version chains
+// NOLINTNEXTLINE
+TEST(BlockVisibilityTest, VersionChains) {
+  storage::BlockVisibility tested;
+  tested.Initialize();
+  EXPECT_FALSE(tested.HasVersionChains());
+
+  tested.AddVersionChain();
+  tested.AddVersionChain();
+  EXPECT_TRUE(tested.HasVersionChains());
+  tested.RemoveVersionChain();
+  EXPECT_TRUE(tested.HasVersionChains());
+  tested.RemoveVersionChain();
+  EXPECT_FALSE(tested.HasVersionChains());
+}
+
+}  // namespace noisepage
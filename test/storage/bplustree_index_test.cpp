@@ -246,6 +246,23 @@ TEST_F(BPlusTreeIndexTests, DefaultInsert) {
   default_index_->ScanAscending(*scan_txn, storage::index::ScanType::Closed, 1, low_key_pr, high_key_pr, 0, &results);
   EXPECT_EQ(results.size(), num_inserts * num_threads_);
 
+  // a batched scan of the keys in descending order, and of one key past them, should hit num_threads_ keys each
+  std::vector<byte *> batch_buffers;
+  std::vector<const ProjectedRow *> batch_keys;
+  for (auto key = static_cast<int32_t>(num_inserts); key >= 0; key--) {
+    batch_buffers.push_back(
+        common::AllocationUtil::AllocateAligned(default_index_->GetProjectedRowInitializer().ProjectedRowSize()));
+    auto *const batch_key = default_index_->GetProjectedRowInitializer().InitializeRow(batch_buffers.back());
+    *reinterpret_cast<int32_t *>(batch_key->AccessForceNotNull(0)) = key;
+    batch_keys.push_back(batch_key);
+  }
+  std::vector<std::vector<storage::TupleSlot>> batch_results;
+  default_index_->ScanKeyBatch(*scan_txn, batch_keys, &batch_results);
+  EXPECT_EQ(batch_results.size(), num_inserts + 1);
+  EXPECT_TRUE(batch_results[0].empty());
+  for (uint32_t i = 1; i < batch_results.size(); i++) EXPECT_EQ(batch_results[i].size(), num_threads_);
+  for (auto *const buffer : batch_buffers) delete[] buffer;
+
   txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
@@ -323,6 +340,58 @@ TEST_F(BPlusTreeIndexTests, ScanAscending) {
   txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+/**
+ * Tests that an ascending scan with keys returns the key of every value, laid out as index ProjectedRows
+ */
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeIndexTests, ScanAscendingWithKeys) {
+  EXPECT_TRUE(default_index_->SupportsKeyScans());
+
+  // populate index with [0..20] even keys
+  std::map<int32_t, storage::TupleSlot> reference;
+  auto *const insert_txn = txn_manager_->BeginTransaction();
+  for (int32_t i = 0; i <= 20; i += 2) {
+    auto *const insert_redo =
+        insert_txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    auto *const insert_tuple = insert_redo->Delta();
+    *reinterpret_cast<int32_t *>(insert_tuple->AccessForceNotNull(0)) = i;
+    const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(insert_txn), insert_redo);
+
+    auto *const insert_key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+    *reinterpret_cast<int32_t *>(insert_key->AccessForceNotNull(0)) = i;
+
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *insert_key, tuple_slot));
+    reference[i] = tuple_slot;
+  }
+  txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+
+  std::vector<storage::TupleSlot> results;
+  std::vector<uint64_t> keys;
+
+  auto *const low_key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+  auto *const high_key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_2_);
+
+  // scan[7,13] should hit keys 8, 10, 12
+  *reinterpret_cast<int32_t *>(low_key_pr->AccessForceNotNull(0)) = 7;
+  *reinterpret_cast<int32_t *>(high_key_pr->AccessForceNotNull(0)) = 13;
+  default_index_->ScanAscendingWithKeys(*scan_txn, storage::index::ScanType::Closed, 1, low_key_pr, high_key_pr, 0,
+                                        &results, &keys);
+  EXPECT_EQ(results.size(), 3);
+  EXPECT_EQ(keys.size(), results.size() * default_index_->KeyScanWords());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    const auto *const key =
+        reinterpret_cast<const storage::ProjectedRow *>(&keys[i * default_index_->KeyScanWords()]);
+    const int32_t expected = 8 + 2 * static_cast<int32_t>(i);
+    EXPECT_EQ(reference.at(expected), results[i]);
+    ASSERT_NE(key->AccessWithNullCheck(0), nullptr);
+    EXPECT_EQ(*reinterpret_cast<const int32_t *>(key->AccessWithNullCheck(0)), expected);
+  }
+
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 /**
  * Tests basic scan behavior using various windows to scan over (some out of of bounds of keyspace, some matching
  * exactly, etc.)
@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <random>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include "storage/index/bplustree.h"
 #include "storage/storage_defs.h"
@@ -1599,4 +1603,264 @@ TEST_F(BPlusTreeTests, MultiThreadedIteratorTest) {
   delete tree;
 }
 
+/**
+ * Looks up keys that stay in the tree while other threads keep inserting and deleting keys around them, so that the
+ * readers race with splits, merges and changes of the root. Runs with optimistic and with latched reads.
+ */
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeTests, MultiThreadedOptimisticReadTest) {
+  const int64_t key_num = 20000;
+  const uint32_t num_writers = num_threads_ / 2;
+  const int rounds = 3;
+  auto predicate = [](const int64_t slot) -> bool { return false; };
+
+  for (const bool optimistic_reads : {true, false}) {
+    auto *const tree = new BPlusTree<int64_t, int64_t>;
+    tree->SetInnerNodeSizeUpperThreshold(8);
+    tree->SetLeafNodeSizeUpperThreshold(8);
+    tree->SetInnerNodeSizeLowerThreshold(3);
+    tree->SetLeafNodeSizeLowerThreshold(3);
+    tree->SetOptimisticReads(optimistic_reads);
+
+    // Even keys stay in the tree, writers insert and delete the odd ones
+    for (int64_t key = 0; key < key_num; key += 2) tree->Insert({key, key}, predicate);
+
+    std::atomic<uint32_t> writers_done = 0;
+    auto workload = [&](uint32_t worker_id) {
+      if (worker_id < num_writers) {
+        for (int round = 0; round < rounds; round++) {
+          for (int64_t key = 2 * worker_id + 1; key < key_num; key += 2 * num_writers) {
+            tree->Insert({key, key}, predicate);
+          }
+          for (int64_t key = 2 * worker_id + 1; key < key_num; key += 2 * num_writers) {
+            tree->DeleteElement({key, key});
+          }
+        }
+        writers_done++;
+        return;
+      }
+
+      std::default_random_engine generator(worker_id);
+      std::uniform_int_distribution<int64_t> distribution(0, key_num / 2 - 1);
+      while (writers_done.load() < num_writers) {
+        const int64_t key = 2 * distribution(generator);
+        std::vector<int64_t> results;
+        tree->FindValueOfKey(key, &results);
+        EXPECT_EQ(results.size(), 1);
+        if (!results.empty()) EXPECT_EQ(results[0], key);
+
+        // Batches few enough keys for their leaves to be found ahead of time
+        std::vector<int64_t> batch(32);
+        for (auto &batch_key : batch) batch_key = 2 * distribution(generator);
+        std::vector<uint32_t> num_found(batch.size(), 0);
+        tree->FindValuesOfKeys(batch, [&](const uint32_t key_idx, const int64_t value) {
+          EXPECT_EQ(value, batch[key_idx]);
+          num_found[key_idx]++;
+        });
+        for (const uint32_t found : num_found) EXPECT_EQ(found, 1);
+      }
+    };
+
+    for (uint32_t i = 0; i < num_threads_; i++) {
+      thread_pool_.SubmitTask([i, &workload] { workload(i); });
+    }
+    thread_pool_.WaitUntilAllFinished();
+
+    EXPECT_EQ(tree->GetSize(), key_num / 2);
+    std::set<int64_t> keys;
+    for (int64_t key = 0; key < key_num; key += 2) keys.insert(key);
+    EXPECT_TRUE(tree->StructuralIntegrityVerification(0, key_num - 2, &keys, tree->GetRoot()));
+
+    delete tree;
+  }
+}
+
+/**
+ * Looks up shuffled batches of keys, with keys that are missing, repeated and spread over many leaves, and compares
+ * the values found for each key with looking up the key on its own.
+ */
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeTests, FindValuesOfKeysTest) {
+  const int64_t key_num = 10000;
+  auto predicate = [](const int64_t slot) -> bool { return false; };
+  auto *const tree = new BPlusTree<int64_t, int64_t>;
+  tree->SetInnerNodeSizeUpperThreshold(8);
+  tree->SetLeafNodeSizeUpperThreshold(8);
+  tree->SetInnerNodeSizeLowerThreshold(3);
+  tree->SetLeafNodeSizeLowerThreshold(3);
+
+  // Nothing is found in an empty tree
+  std::vector<int64_t> keys{0, 1, 2};
+  tree->FindValuesOfKeys(keys, [](const uint32_t, const int64_t) { ADD_FAILURE(); });
+
+  // Even keys are in the tree, every third of them with a second value
+  for (int64_t key = 0; key < key_num; key += 2) {
+    tree->Insert({key, key}, predicate);
+    if (key % 3 == 0) tree->Insert({key, -key - 1}, predicate);
+  }
+
+  // A dense batch searches leaves again for the keys after the first, a sparse one finds leaves ahead of time
+  for (const int64_t step : {1, 41}) {
+    keys.clear();
+    for (int64_t key = -1; key <= key_num; key += step) keys.push_back(key);
+    for (int64_t key = 0; key < key_num; key += 7 * step) keys.push_back(key);
+    std::default_random_engine generator(globalseed);
+    std::shuffle(keys.begin(), keys.end(), generator);
+
+    std::vector<std::vector<int64_t>> results(keys.size());
+    tree->FindValuesOfKeys(keys, [&results](const uint32_t key_idx, const int64_t value) {
+      results[key_idx].push_back(value);
+    });
+    for (uint32_t i = 0; i < keys.size(); i++) {
+      std::vector<int64_t> expected;
+      tree->FindValueOfKey(keys[i], &expected);
+      std::sort(expected.begin(), expected.end());
+      std::sort(results[i].begin(), results[i].end());
+      EXPECT_EQ(results[i], expected);
+      const bool in_tree = keys[i] >= 0 && keys[i] < key_num && keys[i] % 2 == 0;
+      EXPECT_EQ(results[i].size(), in_tree ? (keys[i] % 3 == 0 ? 2 : 1) : 0);
+    }
+  }
+
+  delete tree;
+}
+
+/**
+ * Bulk loads sorted keys, where every third key has a second value, and verifies the structure of the tree and that
+ * all values can be found. Small node sizes make for a tree of several levels, and every number of keys up to a few
+ * nodes tests a different shape of the last nodes of each level.
+ */
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeTests, BulkLoadTest) {
+  for (int num_keys = 0; num_keys <= 400; num_keys++) {
+    auto *const tree = new BPlusTree<int64_t, int64_t>;
+    tree->SetInnerNodeSizeUpperThreshold(10);
+    tree->SetLeafNodeSizeUpperThreshold(10);
+    tree->SetInnerNodeSizeLowerThreshold(4);
+    tree->SetLeafNodeSizeLowerThreshold(4);
+
+    std::vector<BPlusTree<int64_t, int64_t>::KeyElementPair> elements;
+    for (int64_t key = 0; key < num_keys; key++) {
+      elements.emplace_back(key, key);
+      if (key % 3 == 0) elements.emplace_back(key, -key - 1);
+    }
+    auto it = elements.begin();
+    auto next_element = [&]() -> const BPlusTree<int64_t, int64_t>::KeyElementPair * {
+      return it == elements.end() ? nullptr : &*(it++);
+    };
+    EXPECT_TRUE(tree->BulkLoad(next_element, false));
+    EXPECT_EQ(tree->GetSize(), num_keys);
+    if (num_keys == 0) {
+      EXPECT_EQ(tree->GetRoot(), nullptr);
+      delete tree;
+      continue;
+    }
+
+    std::set<int64_t> keys;
+    for (int64_t key = 0; key < num_keys; key++) keys.insert(key);
+    std::set<int64_t> keys_copy = keys;
+    EXPECT_TRUE(tree->SiblingForwardCheck(&keys_copy));
+    EXPECT_TRUE(tree->SiblingBackwardCheck(&keys_copy));
+    EXPECT_TRUE(tree->StructuralIntegrityVerification(0, num_keys - 1, &keys_copy, tree->GetRoot()));
+    EXPECT_TRUE(keys_copy.empty());
+
+    for (int64_t key = 0; key < num_keys; key++) {
+      std::vector<int64_t> results;
+      tree->FindValueOfKey(key, &results);
+      std::sort(results.begin(), results.end());
+      if (key % 3 == 0) {
+        EXPECT_EQ(results, (std::vector<int64_t>{-key - 1, key}));
+      } else {
+        EXPECT_EQ(results, std::vector<int64_t>{key});
+      }
+    }
+
+    // The bulk loaded tree takes regular inserts and deletes
+    auto predicate = [](const int64_t slot) -> bool { return false; };
+    for (int64_t key = num_keys; key < num_keys + 50; key++) {
+      EXPECT_TRUE(tree->Insert(BPlusTree<int64_t, int64_t>::KeyElementPair(key, key), predicate));
+      EXPECT_TRUE(tree->Insert(BPlusTree<int64_t, int64_t>::KeyElementPair(-key, -key), predicate));
+      keys.insert(key);
+      keys.insert(-key);
+    }
+    for (int64_t key = 1; key < num_keys; key += 3) {
+      EXPECT_TRUE(tree->DeleteElement(BPlusTree<int64_t, int64_t>::KeyElementPair(key, key)));
+      keys.erase(key);
+    }
+    EXPECT_EQ(tree->GetSize(), keys.size());
+    keys_copy = keys;
+    EXPECT_TRUE(tree->SiblingForwardCheck(&keys_copy));
+    EXPECT_TRUE(tree->SiblingBackwardCheck(&keys_copy));
+    EXPECT_TRUE(tree->StructuralIntegrityVerification(*keys.begin(), *keys.rbegin(), &keys_copy, tree->GetRoot()));
+    EXPECT_TRUE(keys_copy.empty());
+
+    delete tree;
+  }
+}
+
+/**
+ * A bulk load that finds the same key twice fails for unique keys and leaves the tree empty.
+ */
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeTests, BulkLoadUniqueTest) {
+  auto *const tree = new BPlusTree<int64_t, int64_t>;
+  std::vector<BPlusTree<int64_t, int64_t>::KeyElementPair> elements;
+  for (int64_t key = 0; key < 1000; key++) elements.emplace_back(key, key);
+  elements.emplace_back(999, 1000);
+
+  auto it = elements.begin();
+  auto next_element = [&]() -> const BPlusTree<int64_t, int64_t>::KeyElementPair * {
+    return it == elements.end() ? nullptr : &*(it++);
+  };
+  EXPECT_FALSE(tree->BulkLoad(next_element, true));
+  EXPECT_EQ(tree->GetSize(), 0);
+  EXPECT_EQ(tree->GetRoot(), nullptr);
+
+  // The tree can still be loaded, and cleared again
+  elements.pop_back();
+  it = elements.begin();
+  EXPECT_TRUE(tree->BulkLoad(next_element, true));
+  EXPECT_EQ(tree->GetSize(), 1000);
+  tree->Clear();
+  EXPECT_EQ(tree->GetSize(), 0);
+  EXPECT_EQ(tree->GetRoot(), nullptr);
+
+  delete tree;
+}
+
+/**
+ * Verifies that the fill factor decides how full bulk loading makes the leaves.
+ */
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeTests, BulkLoadFillFactorTest) {
+  // Fills all leaves at the tested fill factors, 64, 115 and 128 elements per leaf
+  const int64_t num_keys = 64 * 115 * 2 * 5;
+  std::vector<BPlusTree<int64_t, int64_t>::KeyElementPair> elements;
+  for (int64_t key = 0; key < num_keys; key++) elements.emplace_back(key, key);
+
+  for (const int fill_factor : {50, 90, 100}) {
+    auto *const tree = new BPlusTree<int64_t, int64_t>;
+    tree->SetBulkLoadFillFactor(fill_factor);
+    auto it = elements.begin();
+    auto next_element = [&]() -> const BPlusTree<int64_t, int64_t>::KeyElementPair * {
+      return it == elements.end() ? nullptr : &*(it++);
+    };
+    EXPECT_TRUE(tree->BulkLoad(next_element, false));
+
+    // Walk down to the leftmost leaf, then count the leaves through their siblings
+    auto *node = tree->GetRoot();
+    while (node->GetType() != BPlusTree<int64_t, int64_t>::NodeType::LeafType) node = node->GetLowKeyPair().second;
+    int64_t num_leaves = 0;
+    for (; node != nullptr; node = node->GetHighKeyPair().second) num_leaves++;
+    const int64_t leaf_size = tree->GetLeafNodeSizeUpperThreshold() * fill_factor / 100;
+    EXPECT_EQ(num_leaves, num_keys / leaf_size);
+
+    std::set<int64_t> keys;
+    for (int64_t key = 0; key < num_keys; key++) keys.insert(key);
+    EXPECT_TRUE(tree->StructuralIntegrityVerification(0, num_keys - 1, &keys, tree->GetRoot()));
+    EXPECT_TRUE(keys.empty());
+    delete tree;
+  }
+}
+
 }  // namespace noisepage::storage::index
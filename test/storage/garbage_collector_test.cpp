@@ -699,4 +699,90 @@ TEST_F(GarbageCollectorTests, InsertUpdate1) {
     EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
   }
 }
+
+// Run txns on a GC with several workers, and confirm that transactions the GC could not get to show up in its backlog
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, ParallelBacklog) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).SetGCNumWorkers(4).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+    EXPECT_EQ(gc->GetNumWorkers(), 4);
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+
+    // Insert a few tuples, so that their version chains land in different partitions
+    auto *txn1 = txn_manager->BeginTransaction();
+    std::vector<storage::TupleSlot> slots;
+    for (uint32_t i = 0; i < 10; i++) {
+      slots.push_back(tested.table_.Insert(common::ManagedPointer(txn1), *tested.GenerateRandomTuple(&generator_)));
+    }
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // txn1 is still visible to txn0, so it stays in the backlog
+    EXPECT_EQ(std::make_pair(0U, 0U), gc->PerformGarbageCollection());
+    EXPECT_EQ(gc->GetUnlinkBacklog(), 1);
+    EXPECT_EQ(gc->GetDeallocateBacklog(), 0);
+
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Unlink both txns, then deallocate txn1 on the next run
+    EXPECT_EQ(std::make_pair(0U, 2U), gc->PerformGarbageCollection());
+    EXPECT_EQ(gc->GetUnlinkBacklog(), 0);
+    EXPECT_EQ(gc->GetDeallocateBacklog(), 1);
+    EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+    EXPECT_EQ(gc->GetDeallocateBacklog(), 0);
+
+    // The tuples are still there once their version chains are gone
+    auto *txn2 = txn_manager->BeginTransaction();
+    for (const auto &slot : slots) {
+      tested.SelectIntoBuffer(txn2, slot);
+      EXPECT_TRUE(tested.select_result_);
+    }
+    txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+}
+
+// Confirm that a block is marked all-visible once its version chains are gone, and that a write clears the mark
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, AllVisibleBlock) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn0), *insert_tuple);
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+    const auto &visibility = slot.GetBlock()->visibility_;
+    EXPECT_FALSE(visibility.AllVisible());
+
+    // Unlinking the Insert's UndoRecord only begins the mark, the deferred action on the next run finishes it
+    EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+    EXPECT_FALSE(visibility.AllVisible());
+    EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+    EXPECT_TRUE(visibility.AllVisible());
+
+    // A running txn that can still see the old version keeps the update's version chain, and the block unmarked
+    auto *txn1 = txn_manager->BeginTransaction();
+    auto *txn2 = txn_manager->BeginTransaction();
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn2), slot, *tested.GenerateRandomUpdate(&generator_)));
+    EXPECT_FALSE(visibility.AllVisible());
+    txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+    EXPECT_EQ(std::make_pair(0U, 0U), gc->PerformGarbageCollection());
+    EXPECT_FALSE(visibility.AllVisible());
+
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+    EXPECT_EQ(std::make_pair(0U, 2U), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+    EXPECT_TRUE(visibility.AllVisible());
+  }
+}
 }  // namespace noisepage
@@ -241,6 +241,23 @@ TEST_F(HashIndexTests, DefaultInsert) {
     results.clear();
   }
 
+  // a batched scan of a sample of the keys should hit num_threads_ keys each
+  const uint32_t batch_size = 1000;
+  std::vector<byte *> batch_buffers;
+  std::vector<const ProjectedRow *> batch_keys;
+  for (uint32_t i = 0; i < batch_size; i++) {
+    batch_buffers.push_back(
+        common::AllocationUtil::AllocateAligned(default_index_->GetProjectedRowInitializer().ProjectedRowSize()));
+    auto *const batch_key = default_index_->GetProjectedRowInitializer().InitializeRow(batch_buffers.back());
+    *reinterpret_cast<int32_t *>(batch_key->AccessForceNotNull(0)) = i * (num_inserts / batch_size);
+    batch_keys.push_back(batch_key);
+  }
+  std::vector<std::vector<storage::TupleSlot>> batch_results;
+  default_index_->ScanKeyBatch(*scan_txn, batch_keys, &batch_results);
+  EXPECT_EQ(batch_results.size(), batch_size);
+  for (const auto &key_results : batch_results) EXPECT_EQ(key_results.size(), num_threads_);
+  for (auto *const buffer : batch_buffers) delete[] buffer;
+
   txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
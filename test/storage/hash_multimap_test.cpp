@@ -0,0 +1,144 @@
+#include "storage/index/hash_multimap.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "common/hash_util.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage::index {
+
+// std::hash of integers is the identity, which would put all keys into the same partition
+struct KeyHash {
+  std::size_t operator()(const int64_t key) const { return common::HashUtil::Hash(key); }
+};
+
+class HashMultiMapTests : public TerrierTest {
+ public:
+  using MultiMap = HashMultiMap<int64_t, int64_t, KeyHash>;
+
+  const uint32_t num_threads_ = 4;
+  common::WorkerPool thread_pool_{num_threads_, {}};
+
+  static bool NoConflict(const int64_t) { return false; }
+
+  // Values of a key in ascending order
+  static std::vector<int64_t> ValuesOf(const MultiMap &map, const int64_t key) {
+    std::vector<int64_t> values;
+    map.Find(key, [&values](const int64_t value) { values.push_back(value); });
+    std::sort(values.begin(), values.end());
+    return values;
+  }
+
+ protected:
+  void SetUp() override { thread_pool_.Startup(); }
+
+  void TearDown() override { thread_pool_.Shutdown(); }
+};
+
+// Insert and erase many distinct keys, so that partitions grow and buckets are shifted back on erase
+// NOLINTNEXTLINE
+TEST_F(HashMultiMapTests, DistinctKeys) {
+  const int64_t num_keys = 100000;
+  MultiMap map;
+
+  for (int64_t key = 0; key < num_keys; key++) EXPECT_TRUE(map.Insert(key, key, NoConflict));
+  EXPECT_EQ(map.Size(), num_keys);
+  for (int64_t key = 0; key < num_keys; key++) EXPECT_EQ(ValuesOf(map, key), std::vector<int64_t>{key});
+  EXPECT_FALSE(map.Find(num_keys, [](const int64_t) {}));
+
+  // Erase every other key, the remaining ones must still be found
+  for (int64_t key = 0; key < num_keys; key += 2) EXPECT_TRUE(map.Erase(key, key));
+  EXPECT_FALSE(map.Erase(0, 0));
+  EXPECT_FALSE(map.Erase(1, 2));
+  EXPECT_EQ(map.Size(), num_keys / 2);
+  for (int64_t key = 0; key < num_keys; key++) {
+    EXPECT_EQ(map.Find(key, [](const int64_t) {}), key % 2 == 1);
+  }
+}
+
+// Grow and shrink the values of keys across the inline values and several overflow pages
+// NOLINTNEXTLINE
+TEST_F(HashMultiMapTests, DuplicateKeys) {
+  const int64_t num_keys = 10;
+  const int64_t num_values = 3 * MultiMap::OVERFLOW_PAGE_VALUES + MultiMap::INLINE_VALUES + 1;
+  MultiMap map;
+
+  std::vector<int64_t> expected;
+  for (int64_t value = 0; value < num_values; value++) {
+    for (int64_t key = 0; key < num_keys; key++) EXPECT_TRUE(map.Insert(key, value, NoConflict));
+    expected.push_back(value);
+  }
+  EXPECT_EQ(map.Size(), num_keys);
+  for (int64_t key = 0; key < num_keys; key++) EXPECT_EQ(ValuesOf(map, key), expected);
+
+  // The predicate sees every value of the key
+  EXPECT_FALSE(map.Insert(0, num_values, [=](const int64_t value) { return value == num_values - 1; }));
+  EXPECT_EQ(ValuesOf(map, 0), expected);
+
+  // Erase values in random order, the rest of the values stays intact
+  std::default_random_engine generator;
+  std::shuffle(expected.begin(), expected.end(), generator);
+  while (!expected.empty()) {
+    const int64_t value = expected.back();
+    expected.pop_back();
+    for (int64_t key = 0; key < num_keys; key++) EXPECT_TRUE(map.Erase(key, value));
+    std::vector<int64_t> remaining = expected;
+    std::sort(remaining.begin(), remaining.end());
+    EXPECT_EQ(ValuesOf(map, 0), remaining);
+  }
+  EXPECT_EQ(map.Size(), 0);
+  EXPECT_FALSE(map.Find(0, [](const int64_t) {}));
+}
+
+// Look up keys in batches, including keys that are missing
+// NOLINTNEXTLINE
+TEST_F(HashMultiMapTests, FindBatch) {
+  const int64_t num_keys = 1000;
+  MultiMap map;
+  map.Reserve(num_keys);
+  const size_t heap_usage = map.HeapUsage();
+
+  for (int64_t key = 0; key < num_keys; key++) {
+    for (int64_t value = 0; value < key % 4; value++) map.Insert(key, value, NoConflict);
+  }
+  // Reserved space is enough for all keys, and their values fit into their buckets
+  EXPECT_EQ(map.HeapUsage(), heap_usage);
+
+  std::vector<int64_t> keys;
+  for (int64_t key = 0; key < num_keys; key += 3) keys.push_back(key);
+  std::vector<int64_t> num_found(keys.size(), 0);
+  map.FindBatch(keys.data(), static_cast<uint32_t>(keys.size()),
+                [&num_found](const uint32_t idx, const int64_t) { num_found[idx]++; });
+  for (uint32_t i = 0; i < keys.size(); i++) EXPECT_EQ(num_found[i], keys[i] % 4);
+}
+
+// Threads insert and erase values of shared keys, then every thread's last values are checked
+// NOLINTNEXTLINE
+TEST_F(HashMultiMapTests, ConcurrentInsertErase) {
+  const int64_t num_keys = 1000;
+  const int64_t values_per_thread = 20;
+  MultiMap map;
+
+  auto workload = [&](uint32_t worker_id) {
+    for (int64_t key = 0; key < num_keys; key++) {
+      for (int64_t value = 0; value < values_per_thread; value++) {
+        map.Insert(key, worker_id * values_per_thread + value, NoConflict);
+      }
+      // Keep only the first value of this thread
+      for (int64_t value = 1; value < values_per_thread; value++) {
+        EXPECT_TRUE(map.Erase(key, worker_id * values_per_thread + value));
+      }
+    }
+  };
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool_, num_threads_, workload);
+
+  EXPECT_EQ(map.Size(), num_keys);
+  std::vector<int64_t> expected;
+  for (uint32_t worker_id = 0; worker_id < num_threads_; worker_id++) expected.push_back(worker_id * values_per_thread);
+  for (int64_t key = 0; key < num_keys; key++) EXPECT_EQ(ValuesOf(map, key), expected);
+}
+
+}  // namespace noisepage::storage::index
@@ -0,0 +1,235 @@
+#include "storage/write_ahead_log/log_compression.h"
+
+#include <unistd.h>
+
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "replication/replication_messages.h"
+#include "storage/recovery/replication_log_provider.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage {
+
+class LogCompressionTest : public TerrierTest {
+ protected:
+  /** @return bytes that look like serialized records, repeating headers and oids with a few changing values */
+  static std::vector<char> RepetitiveBytes(const uint32_t size) {
+    std::vector<char> bytes(size);
+    for (uint32_t i = 0; i < size; i++) bytes[i] = static_cast<char>(i % 61 < 48 ? i % 7 : i / 61);
+    return bytes;
+  }
+
+  /** @return random bytes, which do not compress */
+  std::vector<char> RandomBytes(const uint32_t size) {
+    std::uniform_int_distribution<int> byte(0, UINT8_MAX);
+    std::vector<char> bytes(size);
+    for (auto &b : bytes) b = static_cast<char>(byte(generator_));
+    return bytes;
+  }
+
+  /** @return the block of the given bytes */
+  static std::vector<char> Encode(const std::vector<char> &bytes) {
+    std::vector<char> block(bytes.size() + sizeof(LogBlockHeader));
+    block.resize(LogCompressor::Get(LogCompressionType::LZ)->EncodeBlock(bytes.data(), bytes.size(), block.data()));
+    return block;
+  }
+
+  /** @return the buffer read back from the block, which is cut short to the given number of stored bytes */
+  static std::vector<char> Decode(const std::vector<char> &block, const uint32_t stored_size) {
+    LogBlockHeader header;
+    std::memcpy(&header, block.data(), sizeof(LogBlockHeader));
+    header.stored_size_ = stored_size;
+    std::vector<char> bytes(common::Constants::LOG_BUFFER_SIZE);
+    bytes.resize(
+        LogCompressor::DecodeBlock(header, block.data() + sizeof(LogBlockHeader), bytes.data(), bytes.size()));
+    return bytes;
+  }
+
+  /** @return the header of the block */
+  static LogBlockHeader Header(const std::vector<char> &block) {
+    LogBlockHeader header;
+    std::memcpy(&header, block.data(), sizeof(LogBlockHeader));
+    return header;
+  }
+
+  std::default_random_engine generator_;
+  const LogCompressor *const lz_ = LogCompressor::Get(LogCompressionType::LZ);
+};
+
+// Tests that compressible and incompressible buffers of any size decompress back into the same bytes
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTest, RoundTripTest) {
+  for (const uint32_t size : {1u, 4u, 15u, 16u, 300u, 1000u, common::Constants::LOG_BUFFER_SIZE}) {
+    for (const auto &bytes : {RepetitiveBytes(size), RandomBytes(size)}) {
+      // Incompressible bytes can grow a little, so give them room
+      std::vector<char> compressed(2 * size + 16);
+      const uint32_t compressed_size = lz_->Compress(bytes.data(), size, compressed.data(), compressed.size());
+      ASSERT_GT(compressed_size, 0u);
+      std::vector<char> decompressed(size);
+      EXPECT_EQ(size, lz_->Decompress(compressed.data(), compressed_size, decompressed.data(), size));
+      EXPECT_EQ(bytes, decompressed);
+
+      const auto block = Encode(bytes);
+      EXPECT_EQ(LogBlockHeader::MAGIC, Header(block).magic_);
+      EXPECT_TRUE(LogCompressor::IsBlock(block.data(), block.size()));
+      EXPECT_EQ(bytes, Decode(block, Header(block).stored_size_));
+    }
+  }
+
+  const auto block = Encode(RepetitiveBytes(common::Constants::LOG_BUFFER_SIZE));
+  EXPECT_EQ(static_cast<uint32_t>(LogCompressionType::LZ), Header(block).codec_);
+  EXPECT_LT(block.size(), common::Constants::LOG_BUFFER_SIZE / 2);
+}
+
+// Tests that a buffer that does not get any smaller is stored as is
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTest, IncompressibleTest) {
+  const auto bytes = RandomBytes(common::Constants::LOG_BUFFER_SIZE);
+  std::vector<char> compressed(bytes.size());
+  EXPECT_EQ(0u, lz_->Compress(bytes.data(), bytes.size(), compressed.data(), compressed.size()));
+
+  const auto block = Encode(bytes);
+  const auto header = Header(block);
+  EXPECT_EQ(static_cast<uint32_t>(LogCompressionType::NONE), header.codec_);
+  EXPECT_EQ(bytes.size(), header.raw_size_);
+  EXPECT_EQ(bytes.size(), header.stored_size_);
+  EXPECT_EQ(0, std::memcmp(bytes.data(), block.data() + sizeof(LogBlockHeader), bytes.size()));
+  EXPECT_EQ(bytes, Decode(block, header.stored_size_));
+}
+
+// Tests that corrupted compressed bytes are rejected instead of being read or written out of bounds
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTest, CorruptInputTest) {
+  std::vector<char> out(64);
+  const auto decompress = [&](const std::vector<uint8_t> &in) {
+    lz_->Decompress(reinterpret_cast<const char *>(in.data()), in.size(), out.data(), out.size());
+  };
+  // 1 literal followed by a back reference of offset 0
+  EXPECT_THROW(decompress({0x10, 'a', 0x00, 0x00}), std::runtime_error);
+  // 1 literal followed by a back reference before the start of the output
+  EXPECT_THROW(decompress({0x10, 'a', 0x02, 0x00}), std::runtime_error);
+  // 2 literals, of which only 1 is there
+  EXPECT_THROW(decompress({0x20, 'a'}), std::runtime_error);
+  // A back reference without its offset
+  EXPECT_THROW(decompress({0x10, 'a', 0x01}), std::runtime_error);
+  // A length that never ends
+  EXPECT_THROW(decompress({0xF0, 0xFF, 0xFF}), std::runtime_error);
+  // A back reference longer than the output
+  EXPECT_THROW(decompress({0x1F, 'a', 0x01, 0x00, 0x80}), std::runtime_error);
+  // More literals than fit in the output
+  EXPECT_THROW(decompress({0xF0, 0x40, 'a'}), std::runtime_error);
+
+  // A block of a valid codec with garbage for its payload
+  auto block = Encode(RepetitiveBytes(1000));
+  std::memset(block.data() + sizeof(LogBlockHeader), 0xFF, block.size() - sizeof(LogBlockHeader));
+  EXPECT_THROW(Decode(block, Header(block).stored_size_), std::runtime_error);
+}
+
+// Tests that a block cut short is rejected, wherever it is cut
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTest, TruncatedBlockTest) {
+  const auto block = Encode(RepetitiveBytes(1000));
+  const uint32_t stored_size = Header(block).stored_size_;
+  ASSERT_EQ(static_cast<uint32_t>(LogCompressionType::LZ), Header(block).codec_);
+  for (uint32_t size = 0; size < stored_size; size++) {
+    EXPECT_THROW(Decode(block, size), std::runtime_error) << "Block cut down to " << size << " bytes";
+  }
+}
+
+// Tests that only headers with the magic of a block and a known codec are read
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTest, BlockHeaderTest) {
+  auto block = Encode(RepetitiveBytes(1000));
+  auto header = Header(block);
+
+  // An uncompressed buffer starts with the size of its first record
+  EXPECT_FALSE(LogCompressor::IsBlock(RepetitiveBytes(1000).data(), 1000));
+  EXPECT_FALSE(LogCompressor::IsBlock(block.data(), 3));
+
+  header.magic_ = 1000;
+  std::vector<char> bytes(common::Constants::LOG_BUFFER_SIZE);
+  EXPECT_THROW(LogCompressor::DecodeBlock(header, block.data() + sizeof(LogBlockHeader), bytes.data(), bytes.size()),
+               std::runtime_error);
+  header = Header(block);
+  header.codec_ = 42;
+  EXPECT_THROW(LogCompressor::DecodeBlock(header, block.data() + sizeof(LogBlockHeader), bytes.data(), bytes.size()),
+               std::runtime_error);
+  header = Header(block);
+  EXPECT_THROW(LogCompressor::DecodeBlock(header, block.data() + sizeof(LogBlockHeader), bytes.data(), 999),
+               std::runtime_error);
+}
+
+// Tests that a log file is read back as blocks without being told its codec, and that its last block ends the log
+// where a crash cut it short
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTest, LogFileTest) {
+  const std::string path = "/tmp/noisepage-log-compression-test." + std::to_string(getpid()) + ".log";
+  const auto first = RepetitiveBytes(1000), second = RandomBytes(500), third = RepetitiveBytes(2000);
+  {
+    BufferedLogWriter out(path.c_str());
+    std::vector<char> scratch(common::Constants::LOG_BUFFER_SIZE + sizeof(LogBlockHeader));
+    for (const auto &bytes : {first, second}) {
+      out.BufferWrite(bytes.data(), bytes.size());
+      out.CompressBuffer(*lz_, scratch.data());
+      EXPECT_TRUE(out.IsBlock());
+      out.FlushBuffer();
+      EXPECT_FALSE(out.IsBlock());
+    }
+    // Only part of the last block made it to the log file
+    const auto block = Encode(third);
+    out.BufferWrite(block.data(), block.size() / 2);
+    out.FlushBuffer();
+    out.Close();
+  }
+
+  BufferedLogReader in(path.c_str());
+  std::vector<char> bytes(first.size() + second.size());
+  EXPECT_TRUE(in.Read(bytes.data(), bytes.size()));
+  EXPECT_EQ(0, std::memcmp(first.data(), bytes.data(), first.size()));
+  EXPECT_EQ(0, std::memcmp(second.data(), bytes.data() + first.size(), second.size()));
+  EXPECT_FALSE(in.HasMore());
+  unlink(path.c_str());
+}
+
+// Tests that a replica decompresses the batches the primary marked as compressed, and that a corrupted batch ends
+// replication instead of failing on the replica's recovery thread
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTest, ReplicationTest) {
+  BufferedLogWriter buffer("/dev/null");
+  std::vector<char> scratch(common::Constants::LOG_BUFFER_SIZE + sizeof(LogBlockHeader));
+  const auto bytes = RepetitiveBytes(1000);
+  buffer.BufferWrite(bytes.data(), bytes.size());
+  buffer.CompressBuffer(*lz_, scratch.data());
+
+  const replication::RecordsBatchMsg sent(replication::ReplicationMessageMetadata(replication::msg_id_t{1}),
+                                          replication::record_batch_id_t{1}, &buffer);
+  ASSERT_TRUE(sent.IsCompressed());
+  for (const auto format :
+       {replication::ReplicationMessageFormat::BINARY, replication::ReplicationMessageFormat::MSGPACK}) {
+    const auto received = replication::BaseReplicationMessage::ParseFromString(sent.Serialize(format));
+    const auto &batch = dynamic_cast<const replication::RecordsBatchMsg &>(*received);
+    EXPECT_TRUE(batch.IsCompressed());
+    EXPECT_EQ(sent.GetContents(), batch.GetContents());
+
+    ReplicationLogProvider provider;
+    provider.AddBatchOfRecords(batch);
+    EXPECT_EQ(ReplicationLogProvider::ReplicationEvent::LOGS, provider.WaitUntilEvent());
+    provider.EndReplication();
+  }
+
+  // Garble the payload of the block, which is at the end of the message
+  std::string corrupted = sent.Serialize();
+  const size_t payload_size = sent.GetContents().size() - sizeof(LogBlockHeader);
+  std::memset(corrupted.data() + corrupted.size() - payload_size, 0xFF, payload_size);
+  const auto received = replication::BaseReplicationMessage::ParseFromString(corrupted);
+  ReplicationLogProvider provider;
+  provider.AddBatchOfRecords(dynamic_cast<const replication::RecordsBatchMsg &>(*received));
+  EXPECT_EQ(ReplicationLogProvider::ReplicationEvent::END, provider.WaitUntilEvent());
+}
+
+}  // namespace noisepage::storage
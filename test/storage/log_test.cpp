@@ -1,3 +1,4 @@
+#include <chrono>  // NOLINT
 #include <future>  // NOLINT
 #include <memory>
 #include <string>
@@ -448,4 +449,45 @@ TEST_F(WriteAheadLoggingTests, ReadOnlyCallbackTest) {
   // DeferredAction
   db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete sql_table; });
 }
+
+// Verify that with group commit, committing txns are persisted and have their callbacks invoked without anyone forcing
+// a flush, and that the commits are persisted in batches.
+TEST_F(WriteAheadLoggingTests, GroupCommitTest) {
+  db_main_ = noisepage::DBMain::Builder()
+                 .SetWalFilePath(LOG_TEST_LOG_FILE_NAME)
+                 .SetUseLogging(true)
+                 .SetUseGC(true)
+                 .SetWalGroupCommitTargetIops(100)
+                 .Build();
+  txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+  log_manager_ = db_main_->GetLogManager();
+
+  const uint32_t num_txns = 100;
+  std::vector<std::promise<bool>> promises(num_txns);
+  std::vector<std::future<bool>> futures;
+  const auto start = std::chrono::steady_clock::now();
+  for (auto &promise : promises) {
+    futures.emplace_back(promise.get_future());
+    auto *const txn = txn_manager_->BeginTransaction();
+    txn_manager_->Commit(txn, TestCommitCallback, &promise);
+  }
+
+  // At 100 persists per second, waiting for all of them one persist at a time would take a second
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+  for (auto &future : futures) {
+    EXPECT_EQ(future.wait_until(deadline), std::future_status::ready);
+  }
+
+  // Every commit was persisted exactly once, in fewer persists than commits. The persists began at least 1 / 100 s
+  // apart, so there can be no more of them than fit in the time it took.
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const uint64_t num_batches = log_manager_->TestGetNumCommitBatches();
+  EXPECT_EQ(num_txns, log_manager_->TestGetNumCommitsPersisted());
+  EXPECT_GE(num_batches, 1u);
+  EXPECT_LT(num_batches, num_txns);
+  EXPECT_LE(num_batches, static_cast<uint64_t>(elapsed / std::chrono::milliseconds(10)) + 1);
+
+  log_manager_->PersistAndStop();
+  for (auto &future : futures) EXPECT_TRUE(future.get());
+}
 }  // namespace noisepage::storage
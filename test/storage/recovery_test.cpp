@@ -1,5 +1,9 @@
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
@@ -9,6 +13,7 @@
 #include "main/db_main.h"
 #include "storage/garbage_collector_thread.h"
 #include "storage/index/index_builder.h"
+#include "storage/recovery/checkpoint_manager.h"
 #include "storage/recovery/disk_log_provider.h"
 #include "storage/recovery/recovery_manager.h"
 #include "storage/sql_table.h"
@@ -24,6 +29,7 @@
 // executions will read old test's data, and the cause of the errors will be hard to identify. Trust me it will drive
 // you nuts...
 #define RECOVERY_TEST_LOG_FILE_NAME "./test_recovery_test.log"
+#define RECOVERY_TEST_CHECKPOINT_FILE_NAME "./test_recovery_test.checkpoint"
 
 namespace noisepage::storage {
 class RecoveryTests : public TerrierTest {
@@ -76,8 +82,12 @@ class RecoveryTests : public TerrierTest {
   }
 
   void TearDown() override {
-    // Delete log file
+    // Delete log and checkpoint files
     unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    for (const auto segment : LogSegments(RECOVERY_TEST_LOG_FILE_NAME)) {
+      unlink(LogSegmentFilePath(RECOVERY_TEST_LOG_FILE_NAME, segment).c_str());
+    }
+    unlink(RECOVERY_TEST_CHECKPOINT_FILE_NAME);
   }
 
   catalog::IndexSchema DummyIndexSchema() {
@@ -185,7 +195,8 @@ class RecoveryTests : public TerrierTest {
     recovery_manager.WaitForRecoveryToFinish();
   }
 
-  void RunTest(const LargeSqlTableTestConfiguration &config) {
+  void RunTest(const LargeSqlTableTestConfiguration &config, const uint32_t replay_threads = 0,
+               const uint32_t num_partitions = 1) {
     // Run workload
     auto *tested =
         new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
@@ -194,7 +205,7 @@ class RecoveryTests : public TerrierTest {
     ShutdownAndRestartSystem();
 
     // Instantiate recovery manager, and recover the tables.
-    DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME};
+    DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME, num_partitions};
     RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
                                      recovery_catalog_,
                                      recovery_txn_manager_,
@@ -202,10 +213,23 @@ class RecoveryTests : public TerrierTest {
                                      DISABLED,
                                      recovery_thread_registry_,
                                      recovery_block_store_};
+    recovery_manager.SetReplayThreads(replay_threads);
     recovery_manager.StartRecovery();
     recovery_manager.WaitForRecoveryToFinish();
 
-    // Check we recovered all the original tables
+    CheckRecoveredTables(tested, recovery_manager);
+    // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use a
+    // DeferredAction
+    db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+  }
+
+  // Maps the tuple slots of the original tables to the recovered ones
+  static const std::unordered_map<TupleSlot, TupleSlot> &RecoveredTupleSlots(const RecoveryManager &recovery_manager) {
+    return recovery_manager.tuple_slot_map_;
+  }
+
+  // Check we recovered all the original tables
+  void CheckRecoveredTables(LargeSqlTableTestObject *tested, const RecoveryManager &recovery_manager) {
     for (auto &database : tested->GetTables()) {
       auto database_oid = database.first;
       for (auto &table_oid : database.second) {
@@ -229,9 +253,6 @@ class RecoveryTests : public TerrierTest {
         recovery_txn_manager_->Commit(recovery_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
       }
     }
-    // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use a
-    // DeferredAction
-    db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
   }
 };
 
@@ -251,6 +272,205 @@ TEST_F(RecoveryTests, SingleTableTest) {
   RecoveryTests::RunTest(config);
 }
 
+// This test runs a workload over several tables and recovers them with parallel log replay. It verifies that the
+// recovered tables are the same as the original tables
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ParallelReplayTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 4);
+}
+
+// This test inserts and updates tuples in multiple tables and databases with the WAL split into several partitions,
+// and checks that merging the log files of the partitions during recovery recovers the original tables
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, PartitionedLogTest) {
+  const uint32_t num_partitions = 4;
+  // Replace the original system with one that writes a partitioned WAL
+  db_main_.reset();
+  unlink(RECOVERY_TEST_LOG_FILE_NAME);
+  db_main_ = noisepage::DBMain::Builder()
+                 .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                 .SetWalNumPartitions(num_partitions)
+                 .SetUseLogging(true)
+                 .SetUseGC(true)
+                 .SetUseGCThread(true)
+                 .SetUseCatalog(true)
+                 .Build();
+  txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+  log_manager_ = db_main_->GetLogManager();
+  block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+  catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+  EXPECT_EQ(log_manager_->GetNumPartitions(), num_partitions);
+
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 0, num_partitions);
+
+  for (uint32_t partition = 1; partition < num_partitions; partition++) {
+    unlink(LogPartitionFilePath(RECOVERY_TEST_LOG_FILE_NAME, partition).c_str());
+  }
+}
+
+// This test crashes the system with the partitions of the WAL ending at uneven points: one partition lost what it wrote
+// since its first persist, while the other one kept everything. Recovery should only replay the transactions that were
+// durable in every partition, which excludes a transaction that updated a row inserted by a lost transaction.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, PartitionedLogCrashTest) {
+  const uint32_t num_partitions = 2;
+  // Replace the original system with one that writes a partitioned WAL
+  db_main_.reset();
+  unlink(RECOVERY_TEST_LOG_FILE_NAME);
+  db_main_ = noisepage::DBMain::Builder()
+                 .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                 .SetWalNumPartitions(num_partitions)
+                 .SetUseLogging(true)
+                 .SetUseGC(true)
+                 .SetUseGCThread(true)
+                 .SetUseCatalog(true)
+                 .Build();
+  txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+  log_manager_ = db_main_->GetLogManager();
+  block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+  catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+  const std::string partition_file_path = LogPartitionFilePath(RECOVERY_TEST_LOG_FILE_NAME, 1);
+  auto namespace_oid = catalog::postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID;
+
+  // Begins a transaction whose records go to the given partition
+  const auto begin_in_partition = [&](const uint32_t partition) {
+    while (true) {
+      auto *txn = txn_manager_->BeginTransaction();
+      if (txn->StartTime().UnderlyingValue() % num_partitions == partition) return txn;
+      txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+  };
+  // Writes the value into the only column of the table, at the given slot or into a new row
+  const auto write = [&](transaction::TransactionContext *txn, catalog::db_oid_t db_oid, catalog::table_oid_t table_oid,
+                         int32_t value, TupleSlot slot) {
+    auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    auto table_ptr = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+    const auto &schema = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid);
+    auto initializer = table_ptr->InitializerForProjectedRow({schema.GetColumn(0).Oid()});
+    auto *redo_record = txn->StageWrite(db_oid, table_oid, initializer);
+    *reinterpret_cast<int32_t *>(redo_record->Delta()->AccessForceNotNull(0)) = value;
+    if (slot == TupleSlot()) return table_ptr->Insert(common::ManagedPointer(txn), redo_record);
+    redo_record->SetTupleSlot(slot);
+    EXPECT_TRUE(table_ptr->Update(common::ManagedPointer(txn), redo_record));
+    return slot;
+  };
+
+  // Create a table with a row in it, and persist it in both partitions
+  auto *txn = txn_manager_->BeginTransaction();
+  auto db_oid = CreateDatabase(txn, catalog_, "testdb");
+  auto table_oid =
+      CreateTable(txn, catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid), namespace_oid, "foo");
+  const auto durable_slot = write(txn, db_oid, table_oid, 0, TupleSlot());
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  log_manager_->ForceFlush();
+  struct stat partition_file;
+  ASSERT_EQ(0, stat(partition_file_path.c_str(), &partition_file));
+
+  // Insert a row in partition 1, then update both rows in partition 0
+  txn = begin_in_partition(1);
+  const auto lost_slot = write(txn, db_oid, table_oid, 1, TupleSlot());
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn = begin_in_partition(0);
+  write(txn, db_oid, table_oid, 2, durable_slot);
+  write(txn, db_oid, table_oid, 2, lost_slot);
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Simulate the system "crashing" with partition 1 losing everything after its first persist, while partition 0 kept
+  // the update that depends on what partition 1 lost
+  db_main_->GetGarbageCollectorThread()->StopGC();
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->FullyPerformGC(
+      db_main_->GetStorageLayer()->GetGarbageCollector(), log_manager_);
+  log_manager_->PersistAndStop();
+  ASSERT_EQ(0, truncate(partition_file_path.c_str(), partition_file.st_size));
+
+  DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME, num_partitions};
+  RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_};
+  recovery_manager.StartRecovery();
+  recovery_manager.WaitForRecoveryToFinish();
+
+  // Only the row inserted before the crash point is recovered, as it was before the update
+  const auto &recovered_slots = RecoveredTupleSlots(recovery_manager);
+  EXPECT_EQ(0, recovered_slots.count(lost_slot));
+  ASSERT_EQ(1, recovered_slots.count(durable_slot));
+  txn = recovery_txn_manager_->BeginTransaction();
+  auto db_catalog = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  ASSERT_TRUE(db_catalog != nullptr);
+  auto recovered_table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+  ASSERT_TRUE(recovered_table != nullptr);
+  auto initializer =
+      recovered_table->InitializerForProjectedRow({db_catalog->GetSchema(common::ManagedPointer(txn), table_oid)
+                                                       .GetColumn(0)
+                                                       .Oid()});
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+  EXPECT_TRUE(recovered_table->Select(common::ManagedPointer(txn), recovered_slots.at(durable_slot), row));
+  EXPECT_EQ(0, *reinterpret_cast<int32_t *>(row->AccessForceNotNull(0)));
+  delete[] buffer;
+  recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // We now "boot up" up the system
+  log_manager_->Start();
+  db_main_->GetGarbageCollectorThread()->StartGC();
+  for (uint32_t partition = 1; partition < num_partitions; partition++) {
+    unlink(LogPartitionFilePath(RECOVERY_TEST_LOG_FILE_NAME, partition).c_str());
+  }
+}
+
+// This test checks that we recover correctly from a WAL whose buffers were compressed
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CompressedLogTest) {
+  // Replace the original system with one that compresses its WAL
+  db_main_.reset();
+  unlink(RECOVERY_TEST_LOG_FILE_NAME);
+  db_main_ = noisepage::DBMain::Builder()
+                 .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                 .SetWalCompression(LogCompressionType::LZ)
+                 .SetUseLogging(true)
+                 .SetUseGC(true)
+                 .SetUseGCThread(true)
+                 .SetUseCatalog(true)
+                 .Build();
+  txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+  log_manager_ = db_main_->GetLogManager();
+  block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+  catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config);
+}
+
 // This test checks that we recover correctly in a high abort rate workload. We achieve the high abort rate by having
 // large transaction lengths (number of updates). Further, to ensure that more aborted transactions flush logs before
 // aborting, we have transactions make large updates (by having high number columns). This will cause RedoBuffers to
@@ -771,4 +991,136 @@ TEST_F(RecoveryTests, DoubleRecoveryTest) {
       [=]() { unlink(secondary_log_file.c_str()); });
 }
 
+// This test takes a checkpoint in the middle of a workload. It then recovers the tables from the checkpoint and the log
+// written after it, and verifies that the recovered tables are the same as the original tables
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CheckpointTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  auto *tested =
+      new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+  tested->SimulateOltp(100, 4);
+
+  // The checkpoint runs concurrently with the rest of the workload
+  CheckpointManager checkpoint_manager(catalog_, txn_manager_, log_manager_);
+  transaction::timestamp_t checkpoint_ts;
+  std::thread checkpoint_thread(
+      [&] { checkpoint_ts = checkpoint_manager.TakeCheckpoint(RECOVERY_TEST_CHECKPOINT_FILE_NAME); });
+  tested->SimulateOltp(100, 4);
+  checkpoint_thread.join();
+  EXPECT_EQ(checkpoint_ts, checkpoint_manager.GetLastCheckpointTimestamp());
+
+  ShutdownAndRestartSystem();
+
+  // Instantiate recovery manager, and recover the tables from the checkpoint and the log tail.
+  DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME};
+  RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_};
+  recovery_manager.UseCheckpoint(RECOVERY_TEST_CHECKPOINT_FILE_NAME);
+  EXPECT_EQ(checkpoint_ts, recovery_manager.GetCheckpointTimestamp());
+  recovery_manager.StartRecovery();
+  recovery_manager.WaitForRecoveryToFinish();
+
+  CheckRecoveredTables(tested, recovery_manager);
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+}
+
+// This test seals the log file into segments while the workload is running. It then recovers the tables from the
+// segments and the log file, and verifies that the recovered tables are the same as the original tables
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, LogRotationTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  auto *tested =
+      new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+
+  // Transactions keep committing while the log file is sealed, so the serializer is in the middle of filling buffers
+  std::thread workload_thread([&] { tested->SimulateOltp(200, 4); });
+  log_manager_->RotateLogFile();
+  log_manager_->RotateLogFile();
+  workload_thread.join();
+  EXPECT_EQ(std::vector<uint64_t>({0, 1}), LogSegments(RECOVERY_TEST_LOG_FILE_NAME));
+
+  ShutdownAndRestartSystem();
+
+  DiskLogProvider log_provider(RECOVERY_TEST_LOG_FILE_NAME);
+  RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_};
+  recovery_manager.StartRecovery();
+  recovery_manager.WaitForRecoveryToFinish();
+
+  CheckRecoveredTables(tested, recovery_manager);
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+}
+
+// This test truncates the log after a checkpoint. Only the segment whose transactions are all covered by the
+// checkpoint is deleted. It then recovers the tables from the checkpoint and what is left of the log, and verifies that
+// the recovered tables are the same as the original tables
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CheckpointTruncationTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  auto *tested =
+      new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+  // The first segment holds the creation of the tables, which recovery replays from the log even with a checkpoint
+  log_manager_->RotateLogFile();
+  tested->SimulateOltp(100, 4);
+
+  CheckpointManager checkpoint_manager(catalog_, txn_manager_, log_manager_);
+  const auto checkpoint_ts = checkpoint_manager.TakeCheckpoint(RECOVERY_TEST_CHECKPOINT_FILE_NAME);
+  // The second segment only holds the workload, which the checkpoint covers
+  EXPECT_EQ(1u, checkpoint_manager.TruncateLog(checkpoint_ts));
+  EXPECT_EQ(std::vector<uint64_t>({0}), LogSegments(RECOVERY_TEST_LOG_FILE_NAME));
+  tested->SimulateOltp(100, 4);
+
+  ShutdownAndRestartSystem();
+
+  // Instantiate recovery manager, and recover the tables from the checkpoint and the log around it.
+  DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME};
+  RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_};
+  recovery_manager.UseCheckpoint(RECOVERY_TEST_CHECKPOINT_FILE_NAME);
+  recovery_manager.StartRecovery();
+  recovery_manager.WaitForRecoveryToFinish();
+
+  CheckRecoveredTables(tested, recovery_manager);
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+}
+
 }  // namespace noisepage::storage
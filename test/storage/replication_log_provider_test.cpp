@@ -0,0 +1,35 @@
+#include "storage/recovery/replication_log_provider.h"
+
+#include <chrono>  // NOLINT
+#include <string>
+
+#include "replication/replication_messages.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage {
+
+// Tests that waiting for an event with a deadline gives up once the deadline passes, so that a replica can replay the
+// transactions it holds back without waiting for more logs, and that events that are available are still returned
+// NOLINTNEXTLINE
+TEST(ReplicationLogProviderTest, WaitUntilDeadlineTest) {
+  ReplicationLogProvider provider;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(ReplicationLogProvider::ReplicationEvent::TIMEOUT,
+            provider.WaitUntilEvent(start + std::chrono::milliseconds(5)));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(5));
+  // A deadline that already passed does not block
+  EXPECT_EQ(ReplicationLogProvider::ReplicationEvent::TIMEOUT, provider.WaitUntilEvent(start));
+
+  BufferedLogWriter buffer("/dev/null");
+  const std::string records = "log records";
+  buffer.BufferWrite(records.data(), records.size());
+  provider.AddBatchOfRecords(replication::RecordsBatchMsg(
+      replication::ReplicationMessageMetadata(replication::msg_id_t{1}), replication::record_batch_id_t{1}, &buffer));
+  EXPECT_EQ(ReplicationLogProvider::ReplicationEvent::LOGS, provider.WaitUntilEvent(start));
+
+  provider.EndReplication();
+  EXPECT_EQ(ReplicationLogProvider::ReplicationEvent::END, provider.WaitUntilEvent(start));
+}
+
+}  // namespace noisepage::storage
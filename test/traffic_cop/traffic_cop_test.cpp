@@ -7,10 +7,14 @@
 #include <utility>
 #include <vector>
 
+#include "catalog/catalog_accessor.h"
 #include "common/settings.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
+#include "network/postgres/postgres_packet_writer.h"
+#include "test_util/manual_packet_util.h"
 #include "test_util/test_harness.h"
+#include "traffic_cop/copy_loader.h"
 
 namespace noisepage::trafficcop {
 
@@ -41,6 +45,59 @@ class TrafficCopTests : public TerrierTest {
     txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
   }
 
+  /**
+   * Load CSV data, split into chunks, into a table with a CopyLoader in its own transaction, which is committed if the
+   * load succeeds and aborted otherwise.
+   */
+  TrafficCopResult CopyIntoTable(const std::string &table_name, const std::vector<std::string> &chunks) {
+    auto *const txn = txn_manager_->BeginTransaction();
+    const auto managed_txn = common::ManagedPointer(txn);
+    const auto db_oid = catalog_->GetDatabaseOid(managed_txn, catalog::DEFAULT_DATABASE);
+    auto accessor = catalog_->GetAccessor(managed_txn, db_oid, DISABLED);
+    const auto table_oid = accessor->GetTableOid(table_name);
+    EXPECT_NE(table_oid, catalog::INVALID_TABLE_OID);
+
+    TrafficCopResult result{ResultType::COMPLETE, 0u};
+    {
+      CopyLoader loader(managed_txn, common::ManagedPointer(accessor), db_oid, table_oid, ',', '"', '"');
+      for (const auto &chunk : chunks) {
+        result = loader.Append(chunk);
+        if (result.type_ != ResultType::COMPLETE) break;
+      }
+      if (result.type_ == ResultType::COMPLETE) result = loader.Finish();
+    }
+
+    if (result.type_ == ResultType::COMPLETE) {
+      txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    } else {
+      txn_manager_->Abort(txn);
+    }
+    return result;
+  }
+
+  /**
+   * Read the messages sent by the server until ReadyForQuery.
+   * @return the type and the body of each message, including the ReadyForQuery
+   */
+  static std::vector<std::pair<network::NetworkMessageType, std::string>> ReadMessages(
+      const common::ManagedPointer<network::NetworkIoWrapper> io_socket) {
+    std::vector<std::pair<network::NetworkMessageType, std::string>> messages;
+    while (messages.empty() || messages.back().first != network::NetworkMessageType::PG_READY_FOR_QUERY) {
+      io_socket->GetReadBuffer()->Reset();
+      if (io_socket->FillReadBuffer() == network::Transition::TERMINATE) {
+        ADD_FAILURE() << "The server closed the connection";
+        break;
+      }
+      while (io_socket->GetReadBuffer()->HasMore()) {
+        const auto type = io_socket->GetReadBuffer()->ReadValue<network::NetworkMessageType>();
+        const auto size = io_socket->GetReadBuffer()->ReadValue<int32_t>();
+        const auto body_size = static_cast<size_t>(size - 4);
+        messages.emplace_back(type, io_socket->GetReadBuffer()->ReadIntoView(body_size).ReadString(body_size));
+      }
+    }
+    return messages;
+  }
+
   std::unique_ptr<DBMain> db_main_;
   uint16_t port_;
   common::ManagedPointer<catalog::Catalog> catalog_;
@@ -210,4 +267,134 @@ TEST_F(TrafficCopTests, AsyncCommitTest) {
   }
 }
 
+/**
+ * An unquoted empty cell is NULL, while a quoted empty cell is the empty string, even when the chunks of data split the
+ * quotes apart
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, CopyLoaderNullAndEmptyStringTest) {
+  StartServer(false);
+  pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                          port_, catalog::DEFAULT_DATABASE));
+  {
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE copy_strings (id INT PRIMARY KEY, data TEXT);");
+    txn1.commit();
+  }
+
+  const auto result = CopyIntoTable("copy_strings", {"1,\n2,\"", "\"\n3,abc\n4,\"\"\"\"\n5,\"\\.\"\n\n6,\"a,\nb\""});
+  ASSERT_EQ(result.type_, ResultType::COMPLETE);
+  EXPECT_EQ(std::get<uint32_t>(result.extra_), 6u);
+
+  pqxx::work txn2(connection);
+  pqxx::result r = txn2.exec("SELECT id, data FROM copy_strings ORDER BY id;");
+  ASSERT_EQ(r.size(), 6);
+  EXPECT_TRUE(r[0][1].is_null());
+  EXPECT_FALSE(r[1][1].is_null());
+  EXPECT_EQ(r[1][1].as<std::string>(), "");
+  EXPECT_EQ(r[2][1].as<std::string>(), "abc");
+  EXPECT_EQ(r[3][1].as<std::string>(), "\"");
+  // A quoted end-of-data marker is data
+  EXPECT_EQ(r[4][1].as<std::string>(), "\\.");
+  EXPECT_EQ(r[5][1].as<std::string>(), "a,\nb");
+  txn2.commit();
+}
+
+/**
+ * A row that cannot be loaded fails the whole COPY, and nothing is left in the table
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, CopyLoaderErrorTest) {
+  StartServer(false);
+  pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                          port_, catalog::DEFAULT_DATABASE));
+  {
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE copy_errors (id INT PRIMARY KEY, val INT NOT NULL);");
+    txn1.commit();
+  }
+
+  const std::vector<std::pair<std::string, common::ErrorCode>> bad_inputs{
+      // A quoted empty cell is not NULL, and not an integer either
+      {"1,2\n2,\"\"\n", common::ErrorCode::ERRCODE_INVALID_TEXT_REPRESENTATION},
+      {"1,2\n2,\n", common::ErrorCode::ERRCODE_NOT_NULL_VIOLATION},
+      {"1,2\n2,99999999999\n", common::ErrorCode::ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE},
+      {"1,2\n2\n", common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT},
+      {"1,2\n2,\"3", common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT},
+      {"1,2\n1,3\n", common::ErrorCode::ERRCODE_UNIQUE_VIOLATION},
+  };
+  for (const auto &[input, code] : bad_inputs) {
+    const auto result = CopyIntoTable("copy_errors", {input});
+    ASSERT_EQ(result.type_, ResultType::ERROR) << input;
+    EXPECT_EQ(std::get<common::ErrorData>(result.extra_).GetCode(), code) << input;
+  }
+
+  pqxx::work txn2(connection);
+  pqxx::result r = txn2.exec("SELECT * FROM copy_errors;");
+  EXPECT_EQ(r.size(), 0);
+  txn2.commit();
+}
+
+/**
+ * COPY FROM STDIN and COPY TO STDOUT over the wire protocol, including a COPY that the client fails
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, CopyProtocolTest) {
+  StartServer(false);
+  pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                          port_, catalog::DEFAULT_DATABASE));
+  {
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE copy_wire (id INT PRIMARY KEY, data TEXT);");
+    txn1.commit();
+  }
+
+  auto io_socket_unique_ptr = network::ManualPacketUtil::StartConnection(port_);
+  ASSERT_NE(io_socket_unique_ptr, nullptr);
+  auto io_socket = common::ManagedPointer(io_socket_unique_ptr);
+  network::PostgresPacketWriter writer(io_socket->GetWriteQueue());
+
+  // COPY FROM, with rows split across CopyData messages
+  writer.WriteSimpleQuery("COPY copy_wire FROM STDIN WITH (FORMAT csv);");
+  io_socket->FlushAllWrites();
+  EXPECT_TRUE(network::ManualPacketUtil::ReadUntilMessageOrClose(io_socket,
+                                                                 network::NetworkMessageType::PG_COPY_IN_RESPONSE));
+  writer.WriteCopyData("1,\n2,\"");
+  writer.WriteCopyData("\"\n3,a\"\"b\n");
+  writer.WriteCopyDone();
+  io_socket->FlushAllWrites();
+  auto messages = ReadMessages(io_socket);
+  ASSERT_EQ(messages.size(), 2);
+  EXPECT_EQ(messages[0].first, network::NetworkMessageType::PG_COMMAND_COMPLETE);
+  EXPECT_EQ(messages[0].second, std::string("COPY 3", 7));
+
+  // COPY FROM that the client gives up on leaves the table unchanged
+  writer.WriteSimpleQuery("COPY copy_wire FROM STDIN WITH (FORMAT csv);");
+  io_socket->FlushAllWrites();
+  EXPECT_TRUE(network::ManualPacketUtil::ReadUntilMessageOrClose(io_socket,
+                                                                 network::NetworkMessageType::PG_COPY_IN_RESPONSE));
+  writer.WriteCopyData("4,d\n");
+  writer.BeginPacket(network::NetworkMessageType::PG_COPY_FAIL_COMMAND).AppendString("client error", true).EndPacket();
+  io_socket->FlushAllWrites();
+  messages = ReadMessages(io_socket);
+  ASSERT_EQ(messages.size(), 2);
+  EXPECT_EQ(messages[0].first, network::NetworkMessageType::PG_ERROR_RESPONSE);
+
+  // COPY TO writes NULL as an empty cell and quotes the empty string
+  writer.WriteSimpleQuery("COPY copy_wire TO STDOUT WITH (FORMAT csv);");
+  io_socket->FlushAllWrites();
+  messages = ReadMessages(io_socket);
+  std::string data;
+  for (const auto &[type, body] : messages) {
+    if (type == network::NetworkMessageType::PG_COPY_DATA) data += body;
+  }
+  EXPECT_EQ(messages.front().first, network::NetworkMessageType::PG_COPY_OUT_RESPONSE);
+  EXPECT_EQ(data, "1,\n2,\"\"\n3,\"a\"\"b\"\n");
+  ASSERT_GE(messages.size(), 3);
+  EXPECT_EQ(messages[messages.size() - 3].first, network::NetworkMessageType::PG_COPY_DONE);
+  EXPECT_EQ(messages[messages.size() - 2].second, std::string("COPY 3", 7));
+
+  network::ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+}
+
 }  // namespace noisepage::trafficcop